@@ -477,9 +477,10 @@ napi_value NapiAudioCapturer::Read(napi_env env, napi_callback_info info)
     };
 
     auto complete = [env, context](napi_value &output) {
-        NapiParamUtils::CreateArrayBuffer(env, context->bytesRead, context->buffer, output);
-        delete [] context->buffer;
-        context->buffer = nullptr;
+        // the array buffer takes over the read buffer instead of copying it
+        if (NapiParamUtils::CreateExternalArrayBuffer(env, context->buffer, context->bytesRead, output) != napi_ok) {
+            context->SignError(NAPI_ERR_SYSTEM);
+        }
     };
 
     return NapiAsyncWork::Enqueue(env, context, "Read", executor, complete);
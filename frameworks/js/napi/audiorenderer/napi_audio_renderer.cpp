@@ -65,6 +65,7 @@ napi_status NapiAudioRenderer::InitNapiAudioRenderer(napi_env env, napi_value &c
         DECLARE_NAPI_FUNCTION("getRendererSamplingRate", GetRendererSamplingRate),
         DECLARE_NAPI_FUNCTION("start", Start),
         DECLARE_NAPI_FUNCTION("write", Write),
+        DECLARE_NAPI_FUNCTION("writeSync", WriteSync),
         DECLARE_NAPI_FUNCTION("getAudioTime", GetAudioTime),
         DECLARE_NAPI_FUNCTION("getAudioTimeSync", GetAudioTimeSync),
         DECLARE_NAPI_FUNCTION("drain", Drain),
@@ -523,6 +524,10 @@ napi_value NapiAudioRenderer::Write(napi_env env, napi_callback_info info)
         context->status = NapiParamUtils::GetArrayBuffer(env, context->data, context->bufferLen, argv[PARAM0]);
         NAPI_CHECK_ARGS_RETURN_VOID(context, context->status == napi_ok, "get buffer failed",
             NAPI_ERR_INVALID_PARAM);
+        // the executor writes from the array buffer in place, keep it alive until the write completes
+        context->status = context->HoldReference(argv[PARAM0]);
+        NAPI_CHECK_ARGS_RETURN_VOID(context, context->status == napi_ok, "hold buffer failed",
+            NAPI_ERR_SYSTEM);
     };
 
     context->GetCbInfo(env, info, inputParser);
@@ -549,18 +554,13 @@ napi_status NapiAudioRenderer::WriteArrayBufferToNative(std::shared_ptr<AudioRen
     CHECK_AND_RETURN_RET_LOG(CheckAudioRendererStatus(napiAudioRenderer, context),
         napi_generic_failure, "context object state is error.");
     size_t bufferLen = context->bufferLen;
-    context->status = napi_generic_failure;
-    auto buffer = std::make_unique<uint8_t[]>(bufferLen);
-    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, napi_generic_failure, "Renderer write buffer allocation failed");
-    if (memcpy_s(buffer.get(), bufferLen, context->data, bufferLen)) {
-        AUDIO_ERR_LOG("Renderer mem copy failed");
-        return napi_generic_failure;
-    }
+    uint8_t *buffer = static_cast<uint8_t *>(context->data);
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, napi_generic_failure, "Renderer write buffer is nullptr");
     int32_t bytesWritten = 0;
     size_t totalBytesWritten = 0;
     size_t minBytes = 4;
     while ((totalBytesWritten < bufferLen) && ((bufferLen - totalBytesWritten) > minBytes)) {
-        bytesWritten = napiAudioRenderer->audioRenderer_->Write(buffer.get() + totalBytesWritten,
+        bytesWritten = napiAudioRenderer->audioRenderer_->Write(buffer + totalBytesWritten,
         bufferLen - totalBytesWritten);
         if (bytesWritten < 0) {
             AUDIO_ERR_LOG("Write length < 0,break.");
@@ -573,6 +573,37 @@ napi_status NapiAudioRenderer::WriteArrayBufferToNative(std::shared_ptr<AudioRen
     return context->status;
 }
 
+napi_value NapiAudioRenderer::WriteSync(napi_env env, napi_callback_info info)
+{
+    napi_value result = nullptr;
+    size_t argc = ARGS_ONE;
+    napi_value args[ARGS_ONE] = {};
+    auto *napiAudioRenderer = GetParamWithSync(env, info, argc, args);
+    CHECK_AND_RETURN_RET_LOG(argc == ARGS_ONE, NapiAudioError::ThrowErrorAndReturn(env, NAPI_ERR_INPUT_INVALID,
+        "mandatory parameters are left unspecified"), "argcCount invaild");
+
+    // the data is written from the array buffer in place, only what fits in the client buffer right now
+    void *data = nullptr;
+    size_t bufferLen = 0;
+    CHECK_AND_RETURN_RET_LOG(NapiParamUtils::GetArrayBuffer(env, data, bufferLen, args[PARAM0]) == napi_ok &&
+        data != nullptr && bufferLen > 0, NapiAudioError::ThrowErrorAndReturn(env, NAPI_ERR_INPUT_INVALID,
+        "incorrect parameter types: The type of buffer must be ArrayBuffer"), "get buffer failed");
+
+    CHECK_AND_RETURN_RET_LOG(napiAudioRenderer != nullptr, result, "napiAudioRenderer is nullptr");
+    CHECK_AND_RETURN_RET_LOG(napiAudioRenderer->audioRenderer_ != nullptr, result, "audioRenderer_ is nullptr");
+    int32_t bytesWritten = napiAudioRenderer->audioRenderer_->WriteNonBlocking(static_cast<uint8_t *>(data),
+        bufferLen);
+    CHECK_AND_RETURN_RET_LOG(bytesWritten != ERR_ILLEGAL_STATE,
+        NapiAudioError::ThrowErrorAndReturn(env, NAPI_ERR_ILLEGAL_STATE), "err illegal state");
+    CHECK_AND_RETURN_RET_LOG(bytesWritten != ERR_NOT_SUPPORTED && bytesWritten != ERR_INCORRECT_MODE,
+        NapiAudioError::ThrowErrorAndReturn(env, NAPI_ERR_UNSUPPORTED), "write sync is not supported");
+    CHECK_AND_RETURN_RET_LOG(bytesWritten >= 0, NapiAudioError::ThrowErrorAndReturn(env, NAPI_ERR_SYSTEM),
+        "WriteNonBlocking failed %{public}d", bytesWritten);
+
+    NapiParamUtils::SetValueInt32(env, bytesWritten, result);
+    return result;
+}
+
 napi_value NapiAudioRenderer::GetAudioTime(napi_env env, napi_callback_info info)
 {
     auto context = std::make_shared<AudioRendererAsyncContext>();
@@ -89,6 +89,7 @@ private:
     static napi_value GetRendererSamplingRate(napi_env env, napi_callback_info info);
     static napi_value Start(napi_env env, napi_callback_info info);
     static napi_value Write(napi_env env, napi_callback_info info);
+    static napi_value WriteSync(napi_env env, napi_callback_info info);
     static napi_value GetAudioTime(napi_env env, napi_callback_info info);
     static napi_value GetAudioTimeSync(napi_env env, napi_callback_info info);
     static napi_value Drain(napi_env env, napi_callback_info info);
@@ -450,4 +450,88 @@ describe("AudioRendererJsUnitTest", function() {
             done();
 	}
     })
+
+    /*
+     * @tc.name:SUB_AUDIO_RENDERER_WRITE_TEST_001
+     * @tc.desc:write success, the buffers are not kept by the app while they are written
+     * @tc.type: FUNC
+     * @tc.require: I7V04L
+     */
+    it('SUB_AUDIO_RENDERER_WRITE_TEST_001', 0, async function (done) {
+        try {
+            let audioRenderer = await audio.createAudioRenderer(audioRendererOptions);
+            let bufferSize = audioRenderer.getBufferSizeSync();
+            await audioRenderer.start();
+            let writes = [];
+            for (let i = 0; i < 4; i++) {
+                writes.push(audioRenderer.write(new ArrayBuffer(bufferSize)));
+            }
+            let results = await Promise.all(writes);
+            console.info(`${TAG}: SUB_AUDIO_RENDERER_WRITE_TEST_001 SUCCESS: ${results}`);
+            for (let written of results) {
+                expect(written).assertEqual(bufferSize);
+            }
+
+            await audioRenderer.stop();
+            await audioRenderer.release();
+            done();
+        } catch (err) {
+            console.error(`${TAG}: SUB_AUDIO_RENDERER_WRITE_TEST_001 ERROR: ${err.message}`);
+            expect(false).assertTrue();
+            done();
+        }
+    })
+
+    /*
+     * @tc.name:SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_001
+     * @tc.desc:writeSync success, only writes what fits without waiting
+     * @tc.type: FUNC
+     * @tc.require: I7V04L
+     */
+    it('SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_001', 0, async function (done) {
+        try {
+            let audioRenderer = await audio.createAudioRenderer(audioRendererOptions);
+            let bufferSize = audioRenderer.getBufferSizeSync();
+            await audioRenderer.start();
+            let buffer = new ArrayBuffer(bufferSize * 16);
+            let data = audioRenderer.writeSync(buffer);
+            console.info(`${TAG}: SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_001 SUCCESS: ${data}`);
+            expect(data).assertLarger(0);
+            expect(data).assertLess(buffer.byteLength);
+
+            await audioRenderer.stop();
+            await audioRenderer.release();
+            done();
+        } catch (err) {
+            console.error(`${TAG}: SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_001 ERROR: ${err.message}`);
+            expect(false).assertTrue();
+            done();
+        }
+    })
+
+    /*
+     * @tc.name:SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_002
+     * @tc.desc:writeSync fail, the renderer is not started or the buffer is missing
+     * @tc.type: FUNC
+     * @tc.require: I7V04L
+     */
+    it('SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_002', 0, async function (done) {
+        let audioRenderer = await audio.createAudioRenderer(audioRendererOptions);
+        try {
+            audioRenderer.writeSync(new ArrayBuffer(audioRenderer.getBufferSizeSync()));
+            expect(false).assertTrue();
+        } catch (err) {
+            console.info(`${TAG}: SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_002 not started: ${err.code}`);
+            expect(err.code).assertEqual(audio.AudioErrors.ERROR_ILLEGAL_STATE);
+        }
+        try {
+            audioRenderer.writeSync();
+            expect(false).assertTrue();
+        } catch (err) {
+            console.info(`${TAG}: SUB_AUDIO_RENDERER_WRITE_SYNC_TEST_002 no buffer: ${err.code}`);
+            expect(err.code).assertEqual(401);
+        }
+        await audioRenderer.release();
+        done();
+    })
 })
@@ -31,9 +31,13 @@ ContextBase::~ContextBase()
             napi_delete_reference(env, callbackRef);
         }
         napi_delete_reference(env, selfRef);
+        if (holdRef != nullptr) {
+            napi_delete_reference(env, holdRef);
+        }
         env = nullptr;
         callbackRef = nullptr;
         selfRef = nullptr;
+        holdRef = nullptr;
     }
 }
 
@@ -72,6 +76,12 @@ void ContextBase::GetCbInfo(napi_env envi, napi_callback_info info, NapiCbInfoPa
     }
 }
 
+napi_status ContextBase::HoldReference(napi_value value)
+{
+    CHECK_AND_RETURN_RET_LOG(holdRef == nullptr, napi_generic_failure, "a value is already held");
+    return napi_create_reference(env, value, 1, &holdRef);
+}
+
 void ContextBase::SignError(int32_t code)
 {
     status = napi_generic_failure;
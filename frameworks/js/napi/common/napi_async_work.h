@@ -40,6 +40,8 @@ struct ContextBase {
         bool sync = false);
     void SignError(int32_t code);
     void SignError(int32_t code, const std::string &errorMessage);
+    // Keeps the value alive until the context is released, eg. an ArrayBuffer used by the executor in place.
+    napi_status HoldReference(napi_value value);
     napi_env env = nullptr;
     napi_value output = nullptr;
     napi_status status = napi_invalid_arg;
@@ -54,6 +56,7 @@ private:
     napi_async_work work = nullptr;
     napi_ref callbackRef = nullptr;
     napi_ref selfRef = nullptr;
+    napi_ref holdRef = nullptr;
 
     NapiAsyncExecute execute = nullptr;
     NapiAsyncComplete complete = nullptr;
@@ -278,6 +278,30 @@ napi_status NapiParamUtils::CreateArrayBuffer(const napi_env &env, const size_t
     return status;
 }
 
+napi_status NapiParamUtils::CreateExternalArrayBuffer(const napi_env &env, uint8_t *&bufferData, size_t bufferLen,
+    napi_value &result)
+{
+    uint8_t *buffer = bufferData;
+    bufferData = nullptr;
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, napi_invalid_arg, "buffer is nullptr");
+    napi_status status = napi_create_external_arraybuffer(env, buffer, bufferLen, FreeExternalBuffer, nullptr,
+        &result);
+    if (status == napi_ok) {
+        return status;
+    }
+    // the finalizer is not registered on failure, fall back to a copy
+    AUDIO_WARNING_LOG("napi_create_external_arraybuffer failed %{public}d, copy the buffer", status);
+    result = nullptr;
+    status = CreateArrayBuffer(env, bufferLen, buffer, result);
+    delete [] buffer;
+    return status;
+}
+
+void NapiParamUtils::FreeExternalBuffer(napi_env env, void *data, void *hint)
+{
+    delete [] static_cast<uint8_t *>(data);
+}
+
 void NapiParamUtils::ConvertDeviceInfoToAudioDeviceDescriptor(sptr<AudioDeviceDescriptor> audioDeviceDescriptor,
     const DeviceInfo &deviceInfo)
 {
@@ -133,6 +133,10 @@ public:
         uint8_t *bufferData, napi_value &result);
     static napi_status CreateArrayBuffer(const napi_env &env, const size_t bufferLen,
         const uint8_t *bufferData, napi_value &result);
+    // Takes over the new[] allocated buffer, bufferData is always reset. Copies it if it can not be taken over.
+    static napi_status CreateExternalArrayBuffer(const napi_env &env, uint8_t *&bufferData, size_t bufferLen,
+        napi_value &result);
+    static void FreeExternalBuffer(napi_env env, void *data, void *hint);
 
     static napi_value GetUndefinedValue(napi_env env);
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "napi_async_work.h"
+#include "napi_param_utils.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const size_t TEST_BUFFER_SIZE = 3840;
+}
+
+class NapiAsyncWorkUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void NapiAsyncWorkUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void NapiAsyncWorkUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void NapiAsyncWorkUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void NapiAsyncWorkUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test ContextBase HoldReference
+ * @tc.number: NapiAsyncWork_001
+ * @tc.desc  : Test a failed reference is not kept, and only one value can be held.
+ */
+HWTEST_F(NapiAsyncWorkUnitTest, NapiAsyncWork_001, TestSize.Level1)
+{
+    ContextBase context;
+    napi_value value = nullptr;
+    EXPECT_NE(context.HoldReference(value), napi_ok);
+    EXPECT_EQ(context.holdRef, nullptr);
+
+    napi_ref heldRef = reinterpret_cast<napi_ref>(&context);
+    context.holdRef = heldRef;
+    EXPECT_EQ(context.HoldReference(value), napi_generic_failure);
+    EXPECT_EQ(context.holdRef, heldRef);
+    context.holdRef = nullptr;
+}
+
+/**
+ * @tc.name  : Test NapiParamUtils CreateExternalArrayBuffer
+ * @tc.number: NapiAsyncWork_002
+ * @tc.desc  : Test the buffer is released and reset when no array buffer can be created.
+ */
+HWTEST_F(NapiAsyncWorkUnitTest, NapiAsyncWork_002, TestSize.Level1)
+{
+    napi_env env = nullptr;
+    uint8_t *buffer = new uint8_t[TEST_BUFFER_SIZE];
+    napi_value result = nullptr;
+    EXPECT_NE(NapiParamUtils::CreateExternalArrayBuffer(env, buffer, TEST_BUFFER_SIZE, result), napi_ok);
+    EXPECT_EQ(buffer, nullptr);
+    EXPECT_EQ(result, nullptr);
+
+    EXPECT_EQ(NapiParamUtils::CreateExternalArrayBuffer(env, buffer, TEST_BUFFER_SIZE, result), napi_invalid_arg);
+    EXPECT_EQ(result, nullptr);
+}
+
+/**
+ * @tc.name  : Test NapiParamUtils FreeExternalBuffer
+ * @tc.number: NapiAsyncWork_003
+ * @tc.desc  : Test the finalizer releases the buffer taken over by the array buffer.
+ */
+HWTEST_F(NapiAsyncWorkUnitTest, NapiAsyncWork_003, TestSize.Level1)
+{
+    uint8_t *buffer = new uint8_t[TEST_BUFFER_SIZE];
+    EXPECT_NO_FATAL_FAILURE(NapiParamUtils::FreeExternalBuffer(nullptr, buffer, nullptr));
+    EXPECT_NO_FATAL_FAILURE(NapiParamUtils::FreeExternalBuffer(nullptr, nullptr, nullptr));
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -62,6 +62,7 @@ void EffectChainManagerFlush(void);
 void EffectChainManagerEffectUpdate(void);
 bool EffectChainManagerSceneCheck(const char *sinkSceneType, const char *sceneType);
 uint32_t EffectChainManagerGetSceneCount(const char *sceneType);
+uint64_t EffectChainManagerGetChainId(const char *sceneType);
 
 #ifdef __cplusplus
 }
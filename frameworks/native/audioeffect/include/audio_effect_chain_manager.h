@@ -22,6 +22,8 @@
 #include <cassert>
 #include <cstdint>
 #include <cstddef>
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -59,6 +61,12 @@ const uint32_t MAX_UINT_VOLUME_NUM = 10000;
 const uint32_t MAX_UINT_DSP_VOLUME = 65535;
 const std::string DEFAULT_SCENE_TYPE = "SCENE_DEFAULT";
 const std::string DEFAULT_PRESET_SCENE = "SCENE_MUSIC";
+const uint32_t EFFECT_CHAIN_TABLE_SCENE_NUM = 9;
+// Scene types the sink applies every period, they are resolved through the precomputed effect chain table.
+const char * const EFFECT_CHAIN_TABLE_SCENES[EFFECT_CHAIN_TABLE_SCENE_NUM] = {
+    "SCENE_DEFAULT", "SCENE_MUSIC", "SCENE_GAME", "SCENE_MOVIE", "SCENE_SPEECH", "SCENE_RING", "SCENE_VOIP",
+    "SCENE_OTHERS", "EFFECT_NONE"
+};
 
 struct SessionEffectInfo {
     std::string sceneMode;
@@ -90,6 +98,18 @@ struct EffectBufferAttr {
     }
 };
 
+struct EffectChainTableEntry {
+    bool isExisted = false;
+    std::shared_ptr<AudioEffectChain> audioEffectChain = nullptr;
+};
+
+// Immutable snapshot of sceneTypeToEffectChainMap_ for the current device, indexed like EFFECT_CHAIN_TABLE_SCENES.
+struct EffectChainTable {
+    DeviceType deviceType = DEVICE_TYPE_SPEAKER;
+    std::string deviceTypeName = "";
+    std::array<EffectChainTableEntry, EFFECT_CHAIN_TABLE_SCENE_NUM> entries;
+};
+
 enum SceneTypeOperation {
     ADD_SCENE_TYPE = 0,
     REMOVE_SCENE_TYPE = 1,
@@ -110,6 +130,10 @@ public:
     bool ExistAudioEffectChain(const std::string &sceneType, const std::string &effectMode,
         const std::string &spatializationEnabled);
     int32_t ApplyAudioEffectChain(const std::string &sceneType, const std::unique_ptr<EffectBufferAttr> &bufferAttr);
+    // Called by the sink every period, it neither allocates nor locks for the scene types of the chain table.
+    int32_t ApplyAudioEffectChain(const char *sceneType, const EffectBufferAttr &bufferAttr);
+    // Scene types with the same non-zero id share one effect chain and must not be applied concurrently.
+    uint64_t GetEffectChainId(const char *sceneType);
     void SetOutputDeviceSink(int32_t device, const std::string &sinkName);
     std::string GetDeviceTypeName();
     bool GetOffloadEnabled();
@@ -162,6 +186,14 @@ private:
     std::shared_ptr<AudioEffectChain> CreateAudioEffectChain(const std::string &sceneType, bool isPriorScene);
     bool CheckIfSpkDsp();
     void CheckAndReleaseCommonEffectChain(const std::string &sceneType);
+    void UpdateEffectChainTable();
+    // Keyed access to sceneTypeToEffectChainMap_, lookups never insert and writes republish the effect chain table.
+    std::shared_ptr<AudioEffectChain> GetEffectChain(const std::string &sceneTypeAndDeviceKey);
+    void SetEffectChain(const std::string &sceneTypeAndDeviceKey,
+        const std::shared_ptr<AudioEffectChain> &audioEffectChain);
+    void EraseEffectChain(const std::string &sceneTypeAndDeviceKey);
+    bool FindEffectChain(const char *sceneType, const EffectChainTable &table,
+        std::shared_ptr<AudioEffectChain> &audioEffectChain);
 #ifdef WINDOW_MANAGER_ENABLE
     int32_t EffectDspRotationUpdate(std::shared_ptr<AudioEffectRotation> audioEffectRotation,
         const uint32_t rotationState);
@@ -187,6 +219,8 @@ private:
     std::string extraSceneType_ = "0";
     bool isInitialized_ = false;
     std::recursive_mutex dynamicMutex_;
+    // Rebuilt under dynamicMutex_ whenever sceneTypeToEffectChainMap_ or deviceType_ changes, read without lock.
+    std::shared_ptr<const EffectChainTable> effectChainTable_ = std::make_shared<const EffectChainTable>();
     std::atomic<bool> spatializationEnabled_ = false;
     bool headTrackingEnabled_ = false;
     bool btOffloadEnabled_ = false;
@@ -248,10 +248,11 @@ void AudioEffectChain::ApplyEffectChain(float *bufIn, float *bufOut, uint32_t fr
     AudioEffectTransInfo replyInfo = {sizeof(int32_t), &replyData};
 #endif
 
+    // the sink may apply scenes sharing this chain from different effect workers, keep the io buffers locked
+    std::lock_guard<std::mutex> lock(reloadMutex_);
     audioBufIn_.frameLength = frameLen;
     audioBufOut_.frameLength = frameLen;
     uint32_t count = 0;
-    std::lock_guard<std::mutex> lock(reloadMutex_);
     for (AudioEffectHandle handle : standByEffectHandles_) {
 #ifdef SENSOR_ENABLE
         if ((!procInfo.btOffloadEnabled) && procInfo.headTrackingEnabled) {
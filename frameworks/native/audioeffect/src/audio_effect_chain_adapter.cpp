@@ -63,13 +63,9 @@ int32_t EffectChainManagerProcess(char *sceneType, BufferAttr *bufferAttr)
 {
     AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
     CHECK_AND_RETURN_RET_LOG(audioEffectChainManager != nullptr, ERR_INVALID_HANDLE, "null audioEffectChainManager");
-    std::string sceneTypeString = "";
-    if (sceneType) {
-        sceneTypeString = sceneType;
-    }
-    auto eBufferAttr = std::make_unique<EffectBufferAttr>(bufferAttr->bufIn, bufferAttr->bufOut, bufferAttr->numChanIn,
-        bufferAttr->frameLen);
-    if (audioEffectChainManager->ApplyAudioEffectChain(sceneTypeString, eBufferAttr) != SUCCESS) {
+    // called for every scene in every sink period, keep it free of heap allocations
+    EffectBufferAttr eBufferAttr(bufferAttr->bufIn, bufferAttr->bufOut, bufferAttr->numChanIn, bufferAttr->frameLen);
+    if (audioEffectChainManager->ApplyAudioEffectChain(sceneType, eBufferAttr) != SUCCESS) {
         return ERROR;
     }
     return SUCCESS;
@@ -364,4 +360,11 @@ uint32_t EffectChainManagerGetSceneCount(const char *sceneType)
     CHECK_AND_RETURN_RET_LOG(audioEffectChainManager != nullptr, false, "null audioEffectChainManager");
     std::string sceneTypeString = sceneType;
     return audioEffectChainManager->GetSceneTypeToChainCount(sceneType);
+}
+
+uint64_t EffectChainManagerGetChainId(const char *sceneType)
+{
+    AudioEffectChainManager *audioEffectChainManager = AudioEffectChainManager::GetInstance();
+    CHECK_AND_RETURN_RET_LOG(audioEffectChainManager != nullptr, 0, "null audioEffectChainManager");
+    return audioEffectChainManager->GetEffectChainId(sceneType);
 }
\ No newline at end of file
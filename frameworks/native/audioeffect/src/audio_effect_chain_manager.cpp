@@ -17,6 +17,9 @@
 #endif
 
 #include "audio_effect_chain_manager.h"
+
+#include <cstring>
+
 #include "audio_effect.h"
 #include "audio_errors.h"
 #include "audio_effect_log.h"
@@ -121,6 +124,7 @@ int32_t AudioEffectChainManager::UpdateDeviceInfo(int32_t device, const std::str
     if (!isInitialized_) {
         deviceType_ = (DeviceType)device;
         deviceSink_ = sinkName;
+        UpdateEffectChainTable();
         AUDIO_INFO_LOG("has not beed initialized");
         return ERROR;
     }
@@ -138,6 +142,7 @@ int32_t AudioEffectChainManager::UpdateDeviceInfo(int32_t device, const std::str
     AUDIO_PRERELEASE_LOGI("delete all chains when device type change");
     DeleteAllChains();
     deviceType_ = (DeviceType)device;
+    UpdateEffectChainTable();
 
     return SUCCESS;
 }
@@ -309,14 +314,14 @@ int32_t AudioEffectChainManager::CreateAudioEffectChainDynamic(const std::string
     std::string defaultSceneTypeAndDeviceKey = DEFAULT_SCENE_TYPE + "_&_" + GetDeviceTypeName();
 
     if (sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
-        if (sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] == nullptr) {
-            sceneTypeToEffectChainMap_.erase(sceneTypeAndDeviceKey);
+        if (GetEffectChain(sceneTypeAndDeviceKey) == nullptr) {
+            EraseEffectChain(sceneTypeAndDeviceKey);
             sceneTypeToEffectChainCountMap_.erase(sceneTypeAndDeviceKey);
             AUDIO_WARNING_LOG("scene type %{public}s has null effect chain", sceneTypeAndDeviceKey.c_str());
         } else {
             sceneTypeToEffectChainCountMap_[sceneTypeAndDeviceKey]++;
-            if (isDefaultEffectChainExisted_ && sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] ==
-                sceneTypeToEffectChainMap_[defaultSceneTypeAndDeviceKey]) {
+            if (isDefaultEffectChainExisted_ && GetEffectChain(sceneTypeAndDeviceKey) ==
+                GetEffectChain(defaultSceneTypeAndDeviceKey)) {
                 defaultEffectChainCount_++;
             }
             AUDIO_INFO_LOG("effect chain already exist, current count: %{public}d, default count: %{public}d",
@@ -327,7 +332,7 @@ int32_t AudioEffectChainManager::CreateAudioEffectChainDynamic(const std::string
     bool isPriorScene = std::find(priorSceneList_.begin(), priorSceneList_.end(), sceneType) != priorSceneList_.end();
     audioEffectChain = CreateAudioEffectChain(sceneType, isPriorScene);
 
-    sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] = audioEffectChain;
+    SetEffectChain(sceneTypeAndDeviceKey, audioEffectChain);
     sceneTypeToEffectChainCountMap_[sceneTypeAndDeviceKey] = 1;
     if (!AUDIO_SUPPORTED_SCENE_MODES.count(EFFECT_DEFAULT)) {
         return ERROR;
@@ -350,7 +355,7 @@ int32_t AudioEffectChainManager::SetAudioEffectChainDynamic(const std::string &s
     CHECK_AND_RETURN_RET_LOG(sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey), ERROR,
         "SceneType [%{public}s] does not exist, failed to set", sceneType.c_str());
 
-    std::shared_ptr<AudioEffectChain> audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+    std::shared_ptr<AudioEffectChain> audioEffectChain = GetEffectChain(sceneTypeAndDeviceKey);
 
     std::string effectChain;
     std::string effectChainKey = sceneType + "_&_" + effectMode + "_&_" + GetDeviceTypeName();
@@ -422,8 +427,8 @@ int32_t AudioEffectChainManager::ReleaseAudioEffectChainDynamic(const std::strin
     } else if (sceneTypeToEffectChainCountMap_.count(sceneTypeAndDeviceKey) &&
         sceneTypeToEffectChainCountMap_[sceneTypeAndDeviceKey] > 1) {
         sceneTypeToEffectChainCountMap_[sceneTypeAndDeviceKey]--;
-        if (sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] ==
-            sceneTypeToEffectChainMap_[defaultSceneTypeAndDeviceKey]) {
+        if (GetEffectChain(sceneTypeAndDeviceKey) ==
+            GetEffectChain(defaultSceneTypeAndDeviceKey)) {
             defaultEffectChainCount_--;
         }
         AUDIO_INFO_LOG("effect chain still exist, current count: %{public}d, default count: %{public}d",
@@ -434,7 +439,7 @@ int32_t AudioEffectChainManager::ReleaseAudioEffectChainDynamic(const std::strin
     sceneTypeToSpecialEffectSet_.erase(sceneType);
     sceneTypeToEffectChainCountMap_.erase(sceneTypeAndDeviceKey);
     CheckAndReleaseCommonEffectChain(sceneType);
-    sceneTypeToEffectChainMap_.erase(sceneTypeAndDeviceKey);
+    EraseEffectChain(sceneTypeAndDeviceKey);
 
     if (debugArmFlag_ && !spkOffloadEnabled_ && CheckIfSpkDsp()) {
         effectHdiInput_[0] = HDI_INIT;
@@ -495,39 +500,110 @@ bool AudioEffectChainManager::ExistAudioEffectChain(const std::string &sceneType
     std::string sceneTypeAndDeviceKey = sceneType + "_&_" + GetDeviceTypeName();
     // if the effectChain exist, see if it is empty
     if (!sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey) ||
-        sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] == nullptr) {
+        GetEffectChain(sceneTypeAndDeviceKey) == nullptr) {
         return false;
     }
-    auto audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+    auto audioEffectChain = GetEffectChain(sceneTypeAndDeviceKey);
     return !audioEffectChain->IsEmptyEffectHandles();
 }
 
 int32_t AudioEffectChainManager::ApplyAudioEffectChain(const std::string &sceneType,
     const std::unique_ptr<EffectBufferAttr> &bufferAttr)
 {
-    std::string sceneTypeAndDeviceKey = sceneType + "_&_" + GetDeviceTypeName();
-    size_t totLen = static_cast<size_t>(bufferAttr->frameLen * bufferAttr->numChans * sizeof(float));
+    CHECK_AND_RETURN_RET_LOG(bufferAttr != nullptr, ERROR, "null bufferAttr");
+    return ApplyAudioEffectChain(sceneType.c_str(), *bufferAttr);
+}
+
+int32_t AudioEffectChainManager::ApplyAudioEffectChain(const char *sceneType, const EffectBufferAttr &bufferAttr)
+{
+    std::shared_ptr<const EffectChainTable> table = std::atomic_load(&effectChainTable_);
+    std::shared_ptr<AudioEffectChain> audioEffectChain = nullptr;
+    bool isExisted = FindEffectChain(sceneType == nullptr ? "" : sceneType, *table, audioEffectChain);
+    size_t totLen = static_cast<size_t>(bufferAttr.frameLen * bufferAttr.numChans * sizeof(float));
 #ifdef DEVICE_FLAG
-    if (!sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
-        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr->bufOut, totLen, bufferAttr->bufIn, totLen) == 0, ERROR,
+    if (!isExisted) {
+        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr.bufOut, totLen, bufferAttr.bufIn, totLen) == 0, ERROR,
             "memcpy error when no effect applied");
         return ERROR;
     }
 #else
-    if (deviceType_ != DEVICE_TYPE_SPEAKER || !sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
-        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr->bufOut, totLen, bufferAttr->bufIn, totLen) == 0, ERROR,
+    if (table->deviceType != DEVICE_TYPE_SPEAKER || !isExisted) {
+        CHECK_AND_RETURN_RET_LOG(memcpy_s(bufferAttr.bufOut, totLen, bufferAttr.bufIn, totLen) == 0, ERROR,
             "memcpy error when no effect applied");
         return SUCCESS;
     }
 #endif
-    auto audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
     if (audioEffectChain != nullptr) {
         AudioEffectProcInfo procInfo = {headTrackingEnabled_, btOffloadEnabled_};
-        audioEffectChain->ApplyEffectChain(bufferAttr->bufIn, bufferAttr->bufOut, bufferAttr->frameLen, procInfo);
+        audioEffectChain->ApplyEffectChain(bufferAttr.bufIn, bufferAttr.bufOut, bufferAttr.frameLen, procInfo);
     }
     return SUCCESS;
 }
 
+uint64_t AudioEffectChainManager::GetEffectChainId(const char *sceneType)
+{
+    CHECK_AND_RETURN_RET(sceneType != nullptr, 0);
+    std::shared_ptr<const EffectChainTable> table = std::atomic_load(&effectChainTable_);
+    std::shared_ptr<AudioEffectChain> audioEffectChain = nullptr;
+    FindEffectChain(sceneType, *table, audioEffectChain);
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(audioEffectChain.get()));
+}
+
+bool AudioEffectChainManager::FindEffectChain(const char *sceneType, const EffectChainTable &table,
+    std::shared_ptr<AudioEffectChain> &audioEffectChain)
+{
+    for (uint32_t i = 0; i < EFFECT_CHAIN_TABLE_SCENE_NUM; i++) {
+        if (strcmp(sceneType, EFFECT_CHAIN_TABLE_SCENES[i]) == 0) {
+            audioEffectChain = table.entries[i].audioEffectChain;
+            return table.entries[i].isExisted;
+        }
+    }
+    // scene types out of the table are rare, look them up in the map instead
+    std::string sceneTypeAndDeviceKey = std::string(sceneType) + "_&_" + table.deviceTypeName;
+    std::lock_guard<std::recursive_mutex> lock(dynamicMutex_);
+    auto chain = sceneTypeToEffectChainMap_.find(sceneTypeAndDeviceKey);
+    if (chain == sceneTypeToEffectChainMap_.end()) {
+        return false;
+    }
+    audioEffectChain = chain->second;
+    return true;
+}
+
+void AudioEffectChainManager::UpdateEffectChainTable()
+{
+    std::shared_ptr<EffectChainTable> table = std::make_shared<EffectChainTable>();
+    table->deviceType = deviceType_;
+    table->deviceTypeName = GetDeviceTypeName();
+    for (uint32_t i = 0; i < EFFECT_CHAIN_TABLE_SCENE_NUM; i++) {
+        auto chain = sceneTypeToEffectChainMap_.find(std::string(EFFECT_CHAIN_TABLE_SCENES[i]) + "_&_" +
+            table->deviceTypeName);
+        if (chain != sceneTypeToEffectChainMap_.end()) {
+            table->entries[i].isExisted = true;
+            table->entries[i].audioEffectChain = chain->second;
+        }
+    }
+    std::atomic_store(&effectChainTable_, std::shared_ptr<const EffectChainTable>(table));
+}
+
+std::shared_ptr<AudioEffectChain> AudioEffectChainManager::GetEffectChain(const std::string &sceneTypeAndDeviceKey)
+{
+    auto chain = sceneTypeToEffectChainMap_.find(sceneTypeAndDeviceKey);
+    return chain == sceneTypeToEffectChainMap_.end() ? nullptr : chain->second;
+}
+
+void AudioEffectChainManager::SetEffectChain(const std::string &sceneTypeAndDeviceKey,
+    const std::shared_ptr<AudioEffectChain> &audioEffectChain)
+{
+    sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] = audioEffectChain;
+    UpdateEffectChainTable();
+}
+
+void AudioEffectChainManager::EraseEffectChain(const std::string &sceneTypeAndDeviceKey)
+{
+    sceneTypeToEffectChainMap_.erase(sceneTypeAndDeviceKey);
+    UpdateEffectChainTable();
+}
+
 void AudioEffectChainManager::Dump()
 {
     AUDIO_INFO_LOG("Dump START");
@@ -581,8 +657,8 @@ int32_t AudioEffectChainManager::EffectApVolumeUpdate(std::shared_ptr<AudioEffec
         }
         std::string sceneTypeAndDeviceKey = it->first + "_&_" + GetDeviceTypeName();
         CHECK_AND_RETURN_RET_LOG(sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey) > 0 &&
-            sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] != nullptr, ERROR, "null audioEffectChain");
-        auto audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+            GetEffectChain(sceneTypeAndDeviceKey) != nullptr, ERROR, "null audioEffectChain");
+        auto audioEffectChain = GetEffectChain(sceneTypeAndDeviceKey);
         if (static_cast<int32_t>(audioEffectChain->GetFinalVolume() * MAX_UINT_VOLUME_NUM) !=
             static_cast<int32_t>(volumeMax * MAX_UINT_VOLUME_NUM)) {
             audioEffectChain->SetFinalVolume(volumeMax);
@@ -676,7 +752,7 @@ int32_t AudioEffectChainManager::EffectApRotationUpdate(std::shared_ptr<AudioEff
             if (!sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
                 return ERROR;
             }
-            auto audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+            auto audioEffectChain = GetEffectChain(sceneTypeAndDeviceKey);
             if (audioEffectChain == nullptr) {
                 return ERROR;
             }
@@ -720,7 +796,7 @@ int32_t AudioEffectChainManager::UpdateMultichannelConfig(const std::string &sce
     uint64_t inputChannelLayout = DEFAULT_NUM_CHANNELLAYOUT;
     ReturnEffectChannelInfo(sceneType, inputChannels, inputChannelLayout);
 
-    auto audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+    auto audioEffectChain = GetEffectChain(sceneTypeAndDeviceKey);
     if (audioEffectChain == nullptr) {
         return ERROR;
     }
@@ -739,7 +815,7 @@ int32_t AudioEffectChainManager::InitAudioEffectChainDynamic(const std::string &
     if (!sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
         return SUCCESS;
     } else {
-        audioEffectChain = sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey];
+        audioEffectChain = GetEffectChain(sceneTypeAndDeviceKey);
     }
     if (audioEffectChain != nullptr) {
         audioEffectChain->InitEffectChain();
@@ -805,8 +881,8 @@ int32_t AudioEffectChainManager::ReturnEffectChannelInfo(const std::string &scen
     for (auto& scenePair : sceneTypeToSessionIDMap_) {
         std::string pairSceneTypeAndDeviceKey = scenePair.first + "_&_" + GetDeviceTypeName();
         if (sceneTypeToEffectChainMap_.count(pairSceneTypeAndDeviceKey) > 0 &&
-            sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] ==
-            sceneTypeToEffectChainMap_[pairSceneTypeAndDeviceKey]) {
+            GetEffectChain(sceneTypeAndDeviceKey) ==
+            GetEffectChain(pairSceneTypeAndDeviceKey)) {
             std::set<std::string> sessions = scenePair.second;
             FindMaxEffectChannels(scenePair.first, sessions, channels, channelLayout);
         }
@@ -1014,8 +1090,8 @@ uint32_t AudioEffectChainManager::GetLatency(const std::string &sessionId)
     }
     std::string sceneTypeAndDeviceKey = sessionIDToEffectInfoMap_[sessionId].sceneType + "_&_" + GetDeviceTypeName();
     CHECK_AND_RETURN_RET(sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey) &&
-        sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] != nullptr, 0);
-    return sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey]->GetLatency();
+        GetEffectChain(sceneTypeAndDeviceKey) != nullptr, 0);
+    return GetEffectChain(sceneTypeAndDeviceKey)->GetLatency();
 }
 
 int32_t AudioEffectChainManager::SetSpatializationSceneType(AudioSpatializationSceneType spatializationSceneType)
@@ -1145,6 +1221,7 @@ void AudioEffectChainManager::ResetInfo()
     hdiSceneType_ = 0;
     hdiEffectMode_ = 0;
     isDefaultEffectChainExisted_ = false;
+    UpdateEffectChainTable();
 }
 
 void AudioEffectChainManager::UpdateRealAudioEffect()
@@ -1161,8 +1238,8 @@ void AudioEffectChainManager::UpdateRealAudioEffect()
     }
     AUDIO_INFO_LOG("newest stream, sessionID: %{public}u, sceneType: %{public}s", maxSessionID, sceneType.c_str());
     std::string key = sceneType + "_&_" + GetDeviceTypeName();
-    if (!sceneType.empty() && sceneTypeToEffectChainMap_.count(key) && sceneTypeToEffectChainMap_[key] != nullptr) {
-        std::shared_ptr<AudioEffectChain> audioEffectChain = sceneTypeToEffectChainMap_[key];
+    if (!sceneType.empty() && sceneTypeToEffectChainMap_.count(key) && GetEffectChain(key) != nullptr) {
+        std::shared_ptr<AudioEffectChain> audioEffectChain = GetEffectChain(key);
         AudioEffectScene currSceneType;
         UpdateCurrSceneType(currSceneType, sceneType);
         audioEffectChain->SetEffectCurrSceneType(currSceneType);
@@ -1184,8 +1261,8 @@ bool AudioEffectChainManager::CheckSceneTypeMatch(const std::string &sinkSceneTy
         std::find(priorSceneList_.begin(), priorSceneList_.end(), sceneType) != priorSceneList_.end())) {
         return true;
     }
-    if (sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] ==
-        sceneTypeToEffectChainMap_[sinkSceneTypeAndDeviceKey]) {
+    if (GetEffectChain(sceneTypeAndDeviceKey) ==
+        GetEffectChain(sinkSceneTypeAndDeviceKey)) {
         return sceneTypeAndDeviceKey == defaultSceneTypeAndDeviceKey;
     }
     return false;
@@ -1258,11 +1335,11 @@ std::shared_ptr<AudioEffectChain> AudioEffectChainManager::CreateAudioEffectChai
 #else
             audioEffectChain = std::make_shared<AudioEffectChain>(DEFAULT_SCENE_TYPE);
 #endif
-            sceneTypeToEffectChainMap_[defaultSceneTypeAndDeviceKey] = audioEffectChain;
+            SetEffectChain(defaultSceneTypeAndDeviceKey, audioEffectChain);
             defaultEffectChainCount_ = 1;
             isDefaultEffectChainExisted_ = true;
         } else {
-            audioEffectChain = sceneTypeToEffectChainMap_[defaultSceneTypeAndDeviceKey];
+            audioEffectChain = GetEffectChain(defaultSceneTypeAndDeviceKey);
             defaultEffectChainCount_++;
             AUDIO_INFO_LOG("max audio effect chain count reached and default effect chain already exist: %{public}d",
                 defaultEffectChainCount_);
@@ -1279,9 +1356,9 @@ void AudioEffectChainManager::CheckAndReleaseCommonEffectChain(const std::string
     if (!isDefaultEffectChainExisted_) {
         return;
     }
-    if (sceneTypeToEffectChainMap_[defaultSceneTypeAndDeviceKey] == sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey]) {
+    if (GetEffectChain(defaultSceneTypeAndDeviceKey) == GetEffectChain(sceneTypeAndDeviceKey)) {
         if (defaultEffectChainCount_ <= 1) {
-            sceneTypeToEffectChainMap_.erase(defaultSceneTypeAndDeviceKey);
+            EraseEffectChain(defaultSceneTypeAndDeviceKey);
             defaultEffectChainCount_= 0;
             isDefaultEffectChainExisted_ = false;
             AUDIO_INFO_LOG("default effect chain is released");
@@ -1431,8 +1508,8 @@ uint32_t AudioEffectChainManager::GetSceneTypeToChainCount(const std::string &sc
 
     if (sceneTypeToEffectChainMap_.count(sceneTypeAndDeviceKey)) {
         if (sceneTypeToEffectChainMap_.count(defaultSceneTypeAndDeviceKey) &&
-            (sceneTypeToEffectChainMap_[sceneTypeAndDeviceKey] ==
-            sceneTypeToEffectChainMap_[defaultSceneTypeAndDeviceKey])) {
+            (GetEffectChain(sceneTypeAndDeviceKey) ==
+            GetEffectChain(defaultSceneTypeAndDeviceKey))) {
             return 0;
         } else {
             return sceneTypeToEffectChainCountMap_[sceneTypeAndDeviceKey];
@@ -477,6 +477,69 @@ HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_004, TestSize.Leve
     AudioEffectChainManager::GetInstance()->ResetInfo();
 }
 
+/**
+* @tc.name   : Test ApplyAudioEffectChain API
+* @tc.number : ApplyAudioEffectChain_005
+* @tc.desc   : Test ApplyAudioEffectChain interface(the effect chain table follows create and release).
+*/
+HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_005, TestSize.Level1)
+{
+    vector<float> bufInVector(10000, 1.0f);
+    vector<float> bufOutVector(10000, 0);
+    int numChans = 2;
+    int frameLen = 960;
+    EffectBufferAttr eBufferAttr(bufInVector.data(), bufOutVector.data(), numChans, frameLen);
+    string sceneType = "SCENE_MOVIE";
+
+    AudioEffectChainManager::GetInstance()->InitAudioEffectChainManager(DEFAULT_EFFECT_CHAINS,
+        DEFAULT_EFFECT_CHAIN_MANAGER_PARAM, DEFAULT_EFFECT_LIBRARY_LIST);
+    AudioEffectChainManager::GetInstance()->CreateAudioEffectChainDynamic(sceneType);
+    int32_t result = AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(sceneType.c_str(), eBufferAttr);
+    EXPECT_EQ(SUCCESS, result);
+
+    AudioEffectChainManager::GetInstance()->ReleaseAudioEffectChainDynamic(sceneType);
+    result = AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(sceneType.c_str(), eBufferAttr);
+    EXPECT_EQ(ERROR, result);
+    EXPECT_EQ(1.0f, bufOutVector[numChans * frameLen - 1]);
+
+    result = AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(nullptr, eBufferAttr);
+    EXPECT_EQ(ERROR, result);
+    AudioEffectChainManager::GetInstance()->ResetInfo();
+}
+
+/**
+* @tc.name   : Test ApplyAudioEffectChain API
+* @tc.number : ApplyAudioEffectChain_006
+* @tc.desc   : Test ApplyAudioEffectChain interface(releasing a scene keeps the table in sync with the map).
+*/
+HWTEST(AudioEffectChainManagerUnitTest, ApplyAudioEffectChain_006, TestSize.Level1)
+{
+    vector<float> bufInVector(10000, 1.0f);
+    vector<float> bufOutVector(10000, 0);
+    int numChans = 2;
+    int frameLen = 960;
+    EffectBufferAttr eBufferAttr(bufInVector.data(), bufOutVector.data(), numChans, frameLen);
+    string sceneType = "SCENE_MOVIE";
+    string otherSceneType = "SCENE_MUSIC";
+
+    AudioEffectChainManager::GetInstance()->InitAudioEffectChainManager(DEFAULT_EFFECT_CHAINS,
+        DEFAULT_EFFECT_CHAIN_MANAGER_PARAM, DEFAULT_EFFECT_LIBRARY_LIST);
+    AudioEffectChainManager::GetInstance()->CreateAudioEffectChainDynamic(sceneType);
+    AudioEffectChainManager::GetInstance()->CreateAudioEffectChainDynamic(otherSceneType);
+    AudioEffectChainManager::GetInstance()->ReleaseAudioEffectChainDynamic(sceneType);
+
+    // the released scene must not be reinserted by lookups, the other one stays in the table
+    int32_t result = AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(sceneType.c_str(), eBufferAttr);
+    EXPECT_EQ(ERROR, result);
+    result = AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(otherSceneType.c_str(), eBufferAttr);
+    EXPECT_EQ(SUCCESS, result);
+
+    AudioEffectChainManager::GetInstance()->ReleaseAudioEffectChainDynamic(otherSceneType);
+    result = AudioEffectChainManager::GetInstance()->ApplyAudioEffectChain(otherSceneType.c_str(), eBufferAttr);
+    EXPECT_EQ(ERROR, result);
+    AudioEffectChainManager::GetInstance()->ResetInfo();
+}
+
 /**
 * @tc.name   : Test SetOutputDeviceSink API
 * @tc.number : SetOutputDeviceSink_001
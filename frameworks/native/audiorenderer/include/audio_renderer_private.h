@@ -84,6 +84,10 @@ public:
     int32_t Enqueue(const BufferDesc &bufDesc) const override;
     int32_t Clear() const override;
     int32_t GetBufQueueState(BufferQueueState &bufState) const override;
+    int32_t SetDirectWriteMode(bool enable) override;
+    int32_t GetDirectWriteBuffer(BufferDesc &bufDesc) override;
+    int32_t CommitDirectWriteBuffer(const BufferDesc &bufDesc) override;
+    int32_t WriteNonBlocking(uint8_t *buffer, size_t bufferSize) override;
     void SetApplicationCachePath(const std::string cachePath) override;
     void SetInterruptMode(InterruptMode mode) override;
     int32_t SetParallelPlayFlag(bool parallelPlayFlag) override;
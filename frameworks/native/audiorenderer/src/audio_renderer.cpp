@@ -68,6 +68,26 @@ static bool IsNeedVerifyPermission(const StreamUsage streamUsage)
 std::mutex AudioRenderer::createRendererMutex_;
 
 AudioRenderer::~AudioRenderer() = default;
+
+int32_t AudioRenderer::SetDirectWriteMode(bool enable)
+{
+    return ERR_NOT_SUPPORTED;
+}
+
+int32_t AudioRenderer::GetDirectWriteBuffer(BufferDesc &bufDesc)
+{
+    return ERR_NOT_SUPPORTED;
+}
+
+int32_t AudioRenderer::CommitDirectWriteBuffer(const BufferDesc &bufDesc)
+{
+    return ERR_NOT_SUPPORTED;
+}
+
+int32_t AudioRenderer::WriteNonBlocking(uint8_t *buffer, size_t bufferSize)
+{
+    return ERR_NOT_SUPPORTED;
+}
 AudioRendererPrivate::~AudioRendererPrivate()
 {
     AUDIO_INFO_LOG("Destruct in");
@@ -1212,6 +1232,54 @@ int32_t AudioRendererPrivate::GetBufQueueState(BufferQueueState &bufState) const
     return audioStream_->GetBufQueueState(bufState);
 }
 
+int32_t AudioRendererPrivate::SetDirectWriteMode(bool enable)
+{
+    AUDIO_INFO_LOG("Direct write mode: %{public}d", enable);
+    std::shared_lock<std::shared_mutex> lock(rendererMutex_);
+    return audioStream_->SetDirectWriteMode(enable);
+}
+
+int32_t AudioRendererPrivate::GetDirectWriteBuffer(BufferDesc &bufDesc)
+{
+    if (!rendererMutex_.try_lock_shared()) {
+        AUDIO_ERR_LOG("In switch stream process, return");
+        return ERR_ILLEGAL_STATE;
+    }
+    int32_t ret = audioStream_->GetDirectWriteBuffer(bufDesc);
+    rendererMutex_.unlock_shared();
+    return ret;
+}
+
+int32_t AudioRendererPrivate::CommitDirectWriteBuffer(const BufferDesc &bufDesc)
+{
+    Trace trace("AudioRenderer::CommitDirectWriteBuffer");
+    MockPcmData(bufDesc.buffer, bufDesc.dataLength);
+    DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(bufDesc.buffer), bufDesc.dataLength);
+    if (!rendererMutex_.try_lock_shared()) {
+        AUDIO_ERR_LOG("In switch stream process, return");
+        return ERR_ILLEGAL_STATE;
+    }
+    int32_t ret = audioStream_->CommitDirectWriteBuffer(bufDesc);
+    rendererMutex_.unlock_shared();
+    return ret;
+}
+
+int32_t AudioRendererPrivate::WriteNonBlocking(uint8_t *buffer, size_t bufferSize)
+{
+    Trace trace("AudioRenderer::WriteNonBlocking");
+    if (!rendererMutex_.try_lock_shared()) {
+        AUDIO_ERR_LOG("In switch stream process, return");
+        return ERR_ILLEGAL_STATE;
+    }
+    MockPcmData(buffer, bufferSize);
+    int32_t size = audioStream_->WriteNonBlocking(buffer, bufferSize);
+    rendererMutex_.unlock_shared();
+    if (size > 0) {
+        DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(buffer), size);
+    }
+    return size;
+}
+
 void AudioRendererPrivate::SetApplicationCachePath(const std::string cachePath)
 {
     cachePath_ = cachePath;
@@ -1424,6 +1492,10 @@ void AudioRendererPrivate::SetSwitchInfo(IAudioStream::SwitchInfo info, std::sha
 
     audioStream->SetSilentModeAndMixWithOthers(info.silentModeAndMixWithOthers);
 
+    if (info.directWriteMode && audioStream->SetDirectWriteMode(true) != SUCCESS) {
+        AUDIO_WARNING_LOG("Direct write mode is not supported by the new stream");
+    }
+
     // set callback
     if ((info.renderPositionCb != nullptr) && (info.frameMarkPosition > 0)) {
         audioStream->SetRendererPositionCallback(info.frameMarkPosition, info.renderPositionCb);
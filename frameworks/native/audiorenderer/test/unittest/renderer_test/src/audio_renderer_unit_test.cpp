@@ -59,6 +59,9 @@ namespace {
     constexpr size_t AVS3METADATA_SIZE = 19824;
     constexpr size_t AUDIOVIVID_FRAME_COUNT = 1024;
 
+    constexpr int32_t DIRECT_WRITE_SPAN_COUNT = 50;
+    constexpr uint8_t DIRECT_WRITE_FILL_VALUE = 0x7f;
+
     static size_t g_reqBufLen = 0;
 } // namespace
 
@@ -7789,5 +7792,160 @@ HWTEST(AudioRendererUnitTest, Audio_Renderer_Direct_VoIP_010, TestSize.Level1)
     bool isReleased = audioRenderer->Release();
     EXPECT_EQ(true, isReleased);
 }
+
+/**
+ * @tc.name  : Test direct write mode switch
+ * @tc.number: Audio_Renderer_DirectWrite_001
+ * @tc.desc  : Test direct write is rejected in callback mode, and Write is rejected in direct write mode.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_DirectWrite_001, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+
+    BufferDesc bufDesc = {};
+    EXPECT_EQ(ERR_INCORRECT_MODE, audioRenderer->GetDirectWriteBuffer(bufDesc));
+    EXPECT_EQ(ERR_INCORRECT_MODE, audioRenderer->CommitDirectWriteBuffer(bufDesc));
+
+    EXPECT_EQ(SUCCESS, audioRenderer->SetRenderMode(RENDER_MODE_CALLBACK));
+    EXPECT_NE(SUCCESS, audioRenderer->SetDirectWriteMode(true));
+    EXPECT_EQ(SUCCESS, audioRenderer->SetRenderMode(RENDER_MODE_NORMAL));
+
+    EXPECT_EQ(SUCCESS, audioRenderer->SetDirectWriteMode(true));
+    EXPECT_EQ(true, audioRenderer->Start());
+    uint8_t buffer[VALUE_HUNDRED] = {};
+    EXPECT_EQ(ERR_INCORRECT_MODE, audioRenderer->Write(buffer, sizeof(buffer)));
+
+    EXPECT_EQ(SUCCESS, audioRenderer->SetDirectWriteMode(false));
+    EXPECT_EQ(ERR_INCORRECT_MODE, audioRenderer->GetDirectWriteBuffer(bufDesc));
+
+    audioRenderer->Stop();
+    audioRenderer->Release();
+}
+
+/**
+ * @tc.name  : Test direct write get and commit
+ * @tc.number: Audio_Renderer_DirectWrite_002
+ * @tc.desc  : Test spans are got and committed in order, and the write position wraps around the shared buffer.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_DirectWrite_002, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+    EXPECT_EQ(SUCCESS, audioRenderer->SetDirectWriteMode(true));
+
+    BufferDesc bufDesc = {};
+    // only a running renderer hands out spans
+    EXPECT_EQ(ERR_ILLEGAL_STATE, audioRenderer->GetDirectWriteBuffer(bufDesc));
+    ASSERT_EQ(true, audioRenderer->Start());
+
+    uint8_t *firstSpan = nullptr;
+    bool isWrapped = false;
+    for (int32_t i = 0; i < DIRECT_WRITE_SPAN_COUNT; i++) {
+        ASSERT_EQ(SUCCESS, audioRenderer->GetDirectWriteBuffer(bufDesc));
+        ASSERT_NE(nullptr, bufDesc.buffer);
+        ASSERT_GT(bufDesc.bufLength, 0);
+        EXPECT_EQ(bufDesc.bufLength, bufDesc.dataLength);
+
+        // the span is handed out again until it is committed
+        BufferDesc againDesc = {};
+        EXPECT_EQ(SUCCESS, audioRenderer->GetDirectWriteBuffer(againDesc));
+        EXPECT_EQ(bufDesc.buffer, againDesc.buffer);
+
+        if (firstSpan == nullptr) {
+            firstSpan = bufDesc.buffer;
+        } else if (bufDesc.buffer == firstSpan) {
+            isWrapped = true;
+        }
+        memset(bufDesc.buffer, DIRECT_WRITE_FILL_VALUE, bufDesc.bufLength);
+        EXPECT_EQ(SUCCESS, audioRenderer->CommitDirectWriteBuffer(bufDesc));
+        // a span is committed only once
+        EXPECT_EQ(ERR_ILLEGAL_STATE, audioRenderer->CommitDirectWriteBuffer(bufDesc));
+    }
+    EXPECT_EQ(true, isWrapped);
+
+    audioRenderer->Stop();
+    audioRenderer->Release();
+}
+
+/**
+ * @tc.name  : Test direct write partial commit
+ * @tc.number: Audio_Renderer_DirectWrite_003
+ * @tc.desc  : Test a short commit fills the rest of the span with silence, and invalid commits keep the span.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_DirectWrite_003, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+    EXPECT_EQ(SUCCESS, audioRenderer->SetDirectWriteMode(true));
+    ASSERT_EQ(true, audioRenderer->Start());
+
+    BufferDesc bufDesc = {};
+    ASSERT_EQ(SUCCESS, audioRenderer->GetDirectWriteBuffer(bufDesc));
+    ASSERT_NE(nullptr, bufDesc.buffer);
+    memset(bufDesc.buffer, DIRECT_WRITE_FILL_VALUE, bufDesc.bufLength);
+
+    BufferDesc invalidDesc = bufDesc;
+    invalidDesc.dataLength = 0;
+    EXPECT_EQ(ERR_INVALID_PARAM, audioRenderer->CommitDirectWriteBuffer(invalidDesc));
+    invalidDesc.dataLength = bufDesc.bufLength + 1;
+    EXPECT_EQ(ERR_INVALID_PARAM, audioRenderer->CommitDirectWriteBuffer(invalidDesc));
+    size_t halfLength = bufDesc.bufLength / 2;
+    invalidDesc.dataLength = halfLength;
+    invalidDesc.buffer = bufDesc.buffer + 1;
+    EXPECT_EQ(ERR_INVALID_PARAM, audioRenderer->CommitDirectWriteBuffer(invalidDesc));
+
+    bufDesc.dataLength = halfLength;
+    EXPECT_EQ(SUCCESS, audioRenderer->CommitDirectWriteBuffer(bufDesc));
+    // the server clears a span after reading it, the padded half is silent in both cases
+    for (size_t i = halfLength; i < bufDesc.bufLength; i++) {
+        ASSERT_EQ(0, bufDesc.buffer[i]);
+    }
+
+    BufferDesc nextDesc = {};
+    EXPECT_EQ(SUCCESS, audioRenderer->GetDirectWriteBuffer(nextDesc));
+    EXPECT_NE(bufDesc.buffer, nextDesc.buffer);
+    EXPECT_EQ(SUCCESS, audioRenderer->CommitDirectWriteBuffer(nextDesc));
+
+    audioRenderer->Stop();
+    audioRenderer->Release();
+}
+
+/**
+ * @tc.name  : Test non-blocking write
+ * @tc.number: Audio_Renderer_WriteNonBlocking_001
+ * @tc.desc  : Test only the data that fits is written, the rest is left for the next write.
+ */
+HWTEST(AudioRendererUnitTest, Audio_Renderer_WriteNonBlocking_001, TestSize.Level1)
+{
+    AudioRendererOptions rendererOptions;
+    AudioRendererUnitTest::InitializeRendererOptions(rendererOptions);
+    unique_ptr<AudioRenderer> audioRenderer = AudioRenderer::Create(rendererOptions);
+    ASSERT_NE(nullptr, audioRenderer);
+
+    size_t bufferSize = 0;
+    ASSERT_EQ(SUCCESS, audioRenderer->GetBufferSize(bufferSize));
+    // much more than the client and the shared buffer can hold
+    std::vector<uint8_t> buffer(bufferSize * DIRECT_WRITE_SPAN_COUNT, 0);
+    EXPECT_EQ(ERR_ILLEGAL_STATE, audioRenderer->WriteNonBlocking(buffer.data(), buffer.size()));
+    EXPECT_EQ(ERR_INVALID_PARAM, audioRenderer->WriteNonBlocking(nullptr, buffer.size()));
+    ASSERT_EQ(true, audioRenderer->Start());
+
+    int32_t bytesWritten = audioRenderer->WriteNonBlocking(buffer.data(), buffer.size());
+    EXPECT_GT(bytesWritten, 0);
+    EXPECT_LT(static_cast<size_t>(bytesWritten), buffer.size());
+    int32_t moreWritten = audioRenderer->WriteNonBlocking(buffer.data() + bytesWritten, buffer.size() - bytesWritten);
+    EXPECT_GE(moreWritten, 0);
+    EXPECT_LE(moreWritten, bytesWritten);
+
+    audioRenderer->Stop();
+    audioRenderer->Release();
+}
 } // namespace AudioStandard
 } // namespace OHOS
@@ -103,6 +103,7 @@ public:
 
         std::optional<int32_t> userSettedPreferredFrameSize = std::nullopt;
         bool silentModeAndMixWithOthers = false;
+        bool directWriteMode = false;
     };
 
     virtual ~IAudioStream() = default;
@@ -172,6 +173,13 @@ public:
     virtual int32_t Enqueue(const BufferDesc &bufDesc) = 0;
     virtual int32_t Clear() = 0;
 
+    // direct write api, the app writes into the shared buffer span in place, only for normal renderer streams.
+    virtual int32_t SetDirectWriteMode(bool enable);
+    virtual int32_t GetDirectWriteBuffer(BufferDesc &bufDesc);
+    virtual int32_t CommitDirectWriteBuffer(const BufferDesc &bufDesc);
+    // writes only what fits in the client buffer without waiting, returns the written size.
+    virtual int32_t WriteNonBlocking(uint8_t *buffer, size_t bufferSize);
+
     virtual int32_t SetLowPowerVolume(float volume) = 0;
     virtual float GetLowPowerVolume() = 0;
     virtual float GetSingleStreamVolume() = 0;
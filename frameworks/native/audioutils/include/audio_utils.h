@@ -82,14 +82,24 @@ public:
 
 class Trace {
 public:
+    // Whether the audio trace tag is on, always false if hitrace is not built in.
+    static bool IsEnabled();
     static void Count(const std::string &value, int64_t count);
+    static void Count(const char *value, int64_t count);
     // Show if data is silent.
     static void CountVolume(const std::string &value, uint8_t data);
+    // Formats the name on the stack only if the tag is on, use it instead of std::to_string on audio threads.
+    // eg: Trace trace = Trace::Format("%s WriteSize:%zu", traceTag_.c_str(), bufferSize);
+    static Trace Format(const char *format, ...) __attribute__((format(printf, 1, 2)));
     Trace(const std::string &value);
+    Trace(const char *value);
+    Trace(const Trace &) = delete;
+    Trace &operator=(const Trace &) = delete;
     void End();
+    // Whether the trace is started and not ended yet, always false if the tag is off.
+    bool IsStarted() const;
     ~Trace();
 private:
-    std::string value_;
     bool isFinished_;
 };
 
@@ -16,6 +16,7 @@
 #define AUDIO_UTILS_C_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <securec.h>
 
 #ifdef __cplusplus
@@ -33,13 +34,15 @@ typedef struct CTrace CTrace;
 
 #define AUTO_NAME(name) AUTO_NAME_LINE(name, __LINE__)
 
-// must use string length less than 256
+// must use string length less than 256, the name is not formatted if the trace tag is off
 #define AUTO_CTRACE(fmt, args...)                                           \
     char AUTO_NAME(str)[SPRINTF_STRING_LEN] = {0};                                     \
-    int AUTO_NAME(ret) = sprintf_s(AUTO_NAME(str), SPRINTF_STRING_LEN, fmt, ##args);              \
+    int AUTO_NAME(ret) = IsCTraceEnabled() ? sprintf_s(AUTO_NAME(str), SPRINTF_STRING_LEN, fmt, ##args) : -1;   \
     AUTO_CLEAR CTrace *AUTO_NAME(tmpCtrace) = (AUTO_NAME(ret) >= 0 ? GetAndStart(AUTO_NAME(str)) : NULL);    \
     (void)AUTO_NAME(tmpCtrace)
 
+bool IsCTraceEnabled(void);
+
 // must call with AUTO_CLEAR
 CTrace *GetAndStart(const char *traceName);
 
@@ -15,43 +15,49 @@
 #ifndef VOLUME_RAMP_H
 #define VOLUME_RAMP_H
 
+#include <atomic>
 #include <cstdint>
 #include <string>
-#include <map>
-#include <mutex>
 #include <cmath>
 #include "audio_info.h"
 
 namespace OHOS {
 namespace AudioStandard {
 
-enum RampDirection {
-    RAMP_UP = 0,
-    RAMP_DOWN = 1,
-};
-
+// The ramp is driven by the frame position of the stream instead of the wall clock, so its gains match the data
+// they are applied to. SetVolumeRampConfig and Terminate may be called from any thread, the other methods are
+// called by the thread that writes the data only. None of them takes a lock.
 class VolumeRamp {
 public:
-    VolumeRamp();
+    VolumeRamp() = default;
     ~VolumeRamp() = default;
-    void SetVolumeRampConfig(float targetVolume, float currStreamVolume, int32_t duration);
-    float GetRampVolume();
+    // duration is in ms, it is converted to frames with sampleRate.
+    void SetVolumeRampConfig(float targetVolume, float currStreamVolume, int32_t duration, uint32_t sampleRate);
+    // Get the volumes at the start and the end of the next frameCount frames and move the ramp forward by them.
+    // Returns false if no ramp is running, e.g. it is terminated or finished before.
+    bool GetRampSpan(uint32_t frameCount, float &volumeStart, float &volumeEnd);
     bool IsActive();
     void Terminate();
 
 private:
-    void SetVolumeCurve(std::vector<float> &volumes);
-    float GetScaledTime(int64_t currentTime);
-    float FindRampVolume(float time);
+    void PublishConfig(float startVolume, float targetVolume, uint64_t durationInFrame, bool isActive);
+    void LoadConfig();
+    float GetRampVolume(uint64_t position);
+
+    // written by SetVolumeRampConfig and Terminate, configSeq_ is odd while they are writing
+    std::atomic<uint32_t> configSeq_ = 0;
+    std::atomic<float> configStartVolume_ = 1.0f;
+    std::atomic<float> configTargetVolume_ = 1.0f;
+    std::atomic<uint64_t> configDurationInFrame_ = 0;
+    std::atomic<bool> configActive_ = false;
 
-    int32_t duration_ = 0;
-    RampDirection rampDirection_ = RAMP_UP;
-    std::mutex curveMapMutex_;
-    std::map<float, float> curvePoints_;
-    int64_t initTime_ = 0;
-    float scale_ = 0.0f;
-    bool isVolumeRampActive_ = false;
-    float rampVolume_ = 0.0f;
+    // owned by the writing thread, except that the atomics are read by IsActive
+    std::atomic<uint32_t> appliedSeq_ = 0;
+    float startVolume_ = 1.0f;
+    float targetVolume_ = 1.0f;
+    uint64_t durationInFrame_ = 0;
+    uint64_t rampPosition_ = 0;
+    std::atomic<bool> isVolumeRampActive_ = false;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -22,6 +22,7 @@
 #include <sstream>
 #include <ostream>
 #include <climits>
+#include <cstdarg>
 #include <string>
 #include "audio_utils_c.h"
 #include "audio_errors.h"
@@ -59,6 +60,7 @@ constexpr size_t FIRST_CHAR = 1;
 constexpr size_t MIN_LEN = 8;
 constexpr size_t HEAD_STR_LEN = 2;
 constexpr size_t TAIL_STR_LEN = 5;
+constexpr size_t TRACE_NAME_LEN_MAX = 256;
 
 const std::set<int32_t> RECORD_ALLOW_BACKGROUND_LIST = {
 #ifdef AUDIO_BUILD_VARIANT_ROOT
@@ -128,6 +130,15 @@ int32_t ClockTime::RelativeSleep(int64_t nanoTime)
     return ret;
 }
 
+bool Trace::IsEnabled()
+{
+#ifdef FEATURE_HITRACE_METER
+    return IsTagEnabled(HITRACE_TAG_ZAUDIO);
+#else
+    return false;
+#endif
+}
+
 void Trace::Count(const std::string &value, int64_t count)
 {
 #ifdef FEATURE_HITRACE_METER
@@ -135,6 +146,15 @@ void Trace::Count(const std::string &value, int64_t count)
 #endif
 }
 
+void Trace::Count(const char *value, int64_t count)
+{
+#ifdef FEATURE_HITRACE_METER
+    if (value != nullptr && IsEnabled()) {
+        CountTrace(HITRACE_TAG_ZAUDIO, value, count);
+    }
+#endif
+}
+
 void Trace::CountVolume(const std::string &value, uint8_t data)
 {
 #ifdef FEATURE_HITRACE_METER
@@ -146,12 +166,39 @@ void Trace::CountVolume(const std::string &value, uint8_t data)
 #endif
 }
 
+Trace Trace::Format(const char *format, ...)
+{
+    if (format == nullptr || !IsEnabled()) {
+        return Trace(static_cast<const char *>(nullptr));
+    }
+    char name[TRACE_NAME_LEN_MAX] = {0};
+    va_list args;
+    va_start(args, format);
+    int32_t ret = vsnprintf_s(name, TRACE_NAME_LEN_MAX, TRACE_NAME_LEN_MAX - 1, format, args);
+    va_end(args);
+    // a truncated name is still worth tracing, the buffer is terminated by vsnprintf_s
+    return Trace(ret >= 0 || name[0] != '\0' ? name : format);
+}
+
 Trace::Trace(const std::string &value)
 {
-    value_ = value;
-    isFinished_ = false;
+    isFinished_ = true;
+#ifdef FEATURE_HITRACE_METER
+    if (IsEnabled()) {
+        StartTrace(HITRACE_TAG_ZAUDIO, value);
+        isFinished_ = false;
+    }
+#endif
+}
+
+Trace::Trace(const char *value)
+{
+    isFinished_ = true;
 #ifdef FEATURE_HITRACE_METER
-    StartTrace(HITRACE_TAG_ZAUDIO, value_);
+    if (value != nullptr && IsEnabled()) {
+        StartTrace(HITRACE_TAG_ZAUDIO, value);
+        isFinished_ = false;
+    }
 #endif
 }
 
@@ -165,6 +212,11 @@ void Trace::End()
 #endif
 }
 
+bool Trace::IsStarted() const
+{
+    return !isFinished_;
+}
+
 Trace::~Trace()
 {
     End();
@@ -1296,6 +1348,11 @@ struct CTrace {
     OHOS::AudioStandard::Trace trace;
 };
 
+bool IsCTraceEnabled(void)
+{
+    return OHOS::AudioStandard::Trace::IsEnabled();
+}
+
 CTrace *GetAndStart(const char *traceName)
 {
     std::unique_ptr<CTrace> cTrace = std::make_unique<CTrace>(traceName);
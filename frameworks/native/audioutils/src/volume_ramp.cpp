@@ -18,123 +18,99 @@
 
 #include "volume_ramp.h"
 #include <cinttypes>
+#include <thread>
 #include "audio_common_log.h"
 
 namespace OHOS {
 namespace AudioStandard {
 using namespace std;
-constexpr float MIN_CURVE_TIME = 0.0f;
-constexpr float MAX_CURVE_TIME = 1.0f;
 constexpr int32_t MS_PER_S = 1000;
-constexpr int32_t NS_PER_MS = 1000000;
-constexpr unsigned long VOLUME_SIZE = 2;
 
-VolumeRamp::VolumeRamp()
+void VolumeRamp::PublishConfig(float startVolume, float targetVolume, uint64_t durationInFrame, bool isActive)
 {
-    initTime_ = -1;
-    isVolumeRampActive_ = false;
-    rampVolume_ = 1.0f;
-}
-
-void VolumeRamp::SetVolumeCurve(vector<float> &volumes)
-{
-    vector<float> times = {0.0f, 1.0f};
-    CHECK_AND_RETURN_LOG(volumes.size() == VOLUME_SIZE, "Array size must 2!");
-
-    std::lock_guard<std::mutex> lock(curveMapMutex_);
-    curvePoints_.clear();
-    for (size_t i = 0; i < times.size(); i++) {
-        curvePoints_.emplace(times[i], volumes[i]);
-    }
-}
-
-void VolumeRamp::SetVolumeRampConfig(float targetVolume, float currStreamVolume, int32_t duration)
-{
-    vector<float> volumes;
-
-    isVolumeRampActive_ = true;
-    initTime_ = -1;
-    duration_ = duration;
-
-    if (currStreamVolume > targetVolume) {
-        volumes.assign({targetVolume, currStreamVolume});
-        rampDirection_ = RAMP_DOWN;
-    } else {
-        volumes.assign({currStreamVolume, targetVolume});
-        rampDirection_ = RAMP_UP;
+    // writers are serialized by turning the sequence odd, the writing thread skips a config while it is odd
+    uint32_t seq = configSeq_.load(memory_order_relaxed);
+    while ((seq & 1) != 0 || !configSeq_.compare_exchange_weak(seq, seq + 1, memory_order_acquire,
+        memory_order_relaxed)) {
+        if ((seq & 1) != 0) {
+            this_thread::yield();
+            seq = configSeq_.load(memory_order_relaxed);
+        }
     }
-    SetVolumeCurve(volumes);
+    atomic_thread_fence(memory_order_release);
+    configStartVolume_.store(startVolume, memory_order_relaxed);
+    configTargetVolume_.store(targetVolume, memory_order_relaxed);
+    configDurationInFrame_.store(durationInFrame, memory_order_relaxed);
+    configActive_.store(isActive, memory_order_relaxed);
+    configSeq_.store(seq + 2, memory_order_release);
 }
 
-static int64_t GetCurrentTimeMS()
+void VolumeRamp::SetVolumeRampConfig(float targetVolume, float currStreamVolume, int32_t duration, uint32_t sampleRate)
 {
-    timespec tm {};
-    clock_gettime(CLOCK_MONOTONIC, &tm);
-    return tm.tv_sec * MS_PER_S + (tm.tv_nsec / NS_PER_MS);
+    CHECK_AND_RETURN_LOG(duration >= 0, "invalid duration %{public}d", duration);
+    uint64_t durationInFrame = static_cast<uint64_t>(duration) * sampleRate / MS_PER_S;
+    PublishConfig(currStreamVolume, targetVolume, durationInFrame, true);
 }
 
-float VolumeRamp::GetRampVolume()
+void VolumeRamp::LoadConfig()
 {
-    if (!isVolumeRampActive_) {
-        return rampVolume_;
+    uint32_t seq = configSeq_.load(memory_order_acquire);
+    if ((seq & 1) != 0 || seq == appliedSeq_.load(memory_order_relaxed)) {
+        return;
     }
-
-    int64_t currentTime = GetCurrentTimeMS();
-
-    if (initTime_ < 0) {
-        initTime_ = currentTime;
-        scale_ = 1.0 / duration_;
+    float startVolume = configStartVolume_.load(memory_order_relaxed);
+    float targetVolume = configTargetVolume_.load(memory_order_relaxed);
+    uint64_t durationInFrame = configDurationInFrame_.load(memory_order_relaxed);
+    bool isActive = configActive_.load(memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    if (configSeq_.load(memory_order_relaxed) != seq) {
+        return; // rewritten while reading, it is picked up for the next span
     }
 
-    float scaledTime = GetScaledTime(currentTime);
-    rampVolume_ = FindRampVolume(scaledTime);
-    return rampVolume_;
+    startVolume_ = startVolume;
+    targetVolume_ = targetVolume;
+    durationInFrame_ = durationInFrame;
+    rampPosition_ = 0;
+    isVolumeRampActive_.store(isActive);
+    appliedSeq_.store(seq);
 }
 
-float VolumeRamp::GetScaledTime(int64_t currentTime)
+float VolumeRamp::GetRampVolume(uint64_t position)
 {
-    float offset = scale_ * (currentTime - initTime_);
-    if (rampDirection_ == RAMP_DOWN) {
-        offset =  1 - offset;
-        if (offset < MIN_CURVE_TIME) {
-            offset = MIN_CURVE_TIME;
-            isVolumeRampActive_ = false;
-        } else if (offset > MAX_CURVE_TIME) {
-            offset = MAX_CURVE_TIME;
-        }
-    } else {
-        if (offset < MIN_CURVE_TIME) {
-            offset = MIN_CURVE_TIME;
-        } else if (offset > MAX_CURVE_TIME) {
-            offset = MAX_CURVE_TIME;
-            isVolumeRampActive_ = false;
-        }
+    if (position >= durationInFrame_) {
+        return targetVolume_;
     }
-
-    return offset;
+    return startVolume_ + (targetVolume_ - startVolume_) * (static_cast<float>(position) / durationInFrame_);
 }
 
-float VolumeRamp::FindRampVolume(float time)
+bool VolumeRamp::GetRampSpan(uint32_t frameCount, float &volumeStart, float &volumeEnd)
 {
-    std::lock_guard<std::mutex> lock(curveMapMutex_);
-    CHECK_AND_RETURN_RET_LOG(!curvePoints_.empty(), 0.0f, "Curve points map is empty");
-
-    auto lowPoint = curvePoints_.begin();
-    auto highPoint = curvePoints_.rbegin();
-
-    float volume = lowPoint->second + ((time - lowPoint->first) / (highPoint->first - lowPoint->first))
-        * (highPoint->second - lowPoint->second);
-    return volume;
+    LoadConfig();
+    if (!isVolumeRampActive_.load()) {
+        return false;
+    }
+    volumeStart = GetRampVolume(rampPosition_);
+    rampPosition_ += frameCount;
+    volumeEnd = GetRampVolume(rampPosition_);
+    if (rampPosition_ >= durationInFrame_) {
+        isVolumeRampActive_.store(false);
+    }
+    return true;
 }
 
 bool VolumeRamp::IsActive()
 {
-    return isVolumeRampActive_;
+    if (isVolumeRampActive_.load()) {
+        return true;
+    }
+    // a new ramp which is not picked up by the writing thread yet
+    return configActive_.load() && configSeq_.load() != appliedSeq_.load();
 }
 
 void VolumeRamp::Terminate()
 {
-    isVolumeRampActive_ = false;
+    PublishConfig(1.0f, 1.0f, 0, false);
+    isVolumeRampActive_.store(false);
 }
 } // namespace AudioStandard
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #include <thread>
 #include <gtest/gtest.h>
 #include "audio_utils.h"
+#include "volume_ramp.h"
 
 using namespace testing::ext;
 using namespace std;
@@ -92,6 +93,36 @@ HWTEST(AudioUtilsUnitTest, Trace_001, TestSize.Level1)
     Trace::Count(value, count);
 }
 
+/**
+* @tc.name  : Test Trace API
+* @tc.type  : FUNC
+* @tc.number: Trace_002
+* @tc.desc  : Test Trace Format interface, the trace is started only if the tag is on and is ended once.
+*/
+HWTEST(AudioUtilsUnitTest, Trace_002, TestSize.Level1)
+{
+    bool isEnabled = Trace::IsEnabled();
+#ifndef FEATURE_HITRACE_METER
+    EXPECT_FALSE(isEnabled);
+#endif
+    Trace trace = Trace::Format("Test WriteSize:%zu", static_cast<size_t>(3840));
+    EXPECT_EQ(isEnabled, trace.IsStarted());
+    trace.End();
+    EXPECT_FALSE(trace.IsStarted());
+    trace.End();
+    EXPECT_FALSE(trace.IsStarted());
+
+    std::string longName(512, 'a'); // longer than the trace name buffer, the truncated name is still traced
+    Trace longTrace = Trace::Format("%s", longName.c_str());
+    EXPECT_EQ(isEnabled, longTrace.IsStarted());
+
+    Trace literalTrace("Test");
+    EXPECT_EQ(isEnabled, literalTrace.IsStarted());
+    Trace nullTrace(static_cast<const char *>(nullptr));
+    EXPECT_FALSE(nullTrace.IsStarted());
+    Trace::Count("Test", 1);
+}
+
 /**
 * @tc.name  : Test PermissionUtil API
 * @tc.type  : FUNC
@@ -1866,5 +1897,64 @@ HWTEST(AudioUtilsUnitTest, testMutilthreadConcurrentGetAndPopInfullqueue001, Tes
         demoDatas[0].Get();
     }
 }
+
+/**
+* @tc.name  : Test VolumeRamp API
+* @tc.type  : FUNC
+* @tc.number: VolumeRamp_001
+* @tc.desc  : Test GetRampSpan, the ramp moves by frames and the spans join each other.
+*/
+HWTEST(AudioUtilsUnitTest, VolumeRamp_001, TestSize.Level1)
+{
+    const uint32_t sampleRate = 48000;
+    const uint32_t spanSizeInFrame = 960; // 20ms
+    VolumeRamp volumeRamp;
+    EXPECT_FALSE(volumeRamp.IsActive());
+
+    volumeRamp.SetVolumeRampConfig(0.0f, 1.0f, 100, sampleRate); // 100ms, 5 spans
+    EXPECT_TRUE(volumeRamp.IsActive());
+
+    float volumeStart = 0.0f;
+    float volumeEnd = 0.0f;
+    float lastVolumeEnd = 1.0f;
+    for (int32_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(volumeRamp.GetRampSpan(spanSizeInFrame, volumeStart, volumeEnd));
+        EXPECT_FLOAT_EQ(lastVolumeEnd, volumeStart);
+        EXPECT_FLOAT_EQ(1.0f - 0.2f * (i + 1), volumeEnd);
+        lastVolumeEnd = volumeEnd;
+    }
+    EXPECT_FLOAT_EQ(0.0f, volumeEnd);
+    EXPECT_FALSE(volumeRamp.IsActive());
+    EXPECT_FALSE(volumeRamp.GetRampSpan(spanSizeInFrame, volumeStart, volumeEnd));
+}
+
+/**
+* @tc.name  : Test VolumeRamp API
+* @tc.type  : FUNC
+* @tc.number: VolumeRamp_002
+* @tc.desc  : Test Terminate and a new config replacing a running ramp.
+*/
+HWTEST(AudioUtilsUnitTest, VolumeRamp_002, TestSize.Level1)
+{
+    const uint32_t sampleRate = 48000;
+    const uint32_t spanSizeInFrame = 960;
+    VolumeRamp volumeRamp;
+    float volumeStart = 0.0f;
+    float volumeEnd = 0.0f;
+
+    volumeRamp.SetVolumeRampConfig(1.0f, 0.0f, 100, sampleRate);
+    EXPECT_TRUE(volumeRamp.GetRampSpan(spanSizeInFrame, volumeStart, volumeEnd));
+    EXPECT_FLOAT_EQ(0.2f, volumeEnd);
+
+    volumeRamp.SetVolumeRampConfig(0.5f, volumeEnd, 0, sampleRate);
+    EXPECT_TRUE(volumeRamp.GetRampSpan(spanSizeInFrame, volumeStart, volumeEnd));
+    EXPECT_FLOAT_EQ(0.5f, volumeEnd);
+    EXPECT_FALSE(volumeRamp.IsActive());
+
+    volumeRamp.SetVolumeRampConfig(1.0f, 0.5f, 100, sampleRate);
+    volumeRamp.Terminate();
+    EXPECT_FALSE(volumeRamp.IsActive());
+    EXPECT_FALSE(volumeRamp.GetRampSpan(spanSizeInFrame, volumeStart, volumeEnd));
+}
 } // namespace AudioStandard
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "BluetoothRenderWriter"
+#endif
+
+#include "bluetooth_render_writer.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "securec.h"
+
+#include "audio_errors.h"
+#include "audio_hdi_log.h"
+#include "audio_schedule.h"
+#include "audio_utils.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const uint32_t INITIAL_TARGET_DEPTH = 2;
+// about 10s of 20ms frames without a retry before the target depth shrinks
+const uint32_t QUIET_FRAMES_TO_SHRINK = 500;
+const int64_t WAIT_FRAME_TIMEOUT_MS = 100;
+const uint64_t US_PER_SECOND = 1000000;
+const uint64_t MS_PER_SECOND = 1000;
+const int64_t NS_PER_US = 1000;
+const char *DEPTH_TRACE_TAG = "A2dpWriterQueueDepth";
+const char *RETRY_TRACE_TAG = "A2dpWriterRetryCount";
+const char *LATENCY_TRACE_TAG = "A2dpWriterLatencyUs";
+const char *DROP_TRACE_TAG = "A2dpWriterDroppedFrames";
+}
+
+BluetoothRenderWriter::BluetoothRenderWriter(WriteFunc writeFunc, int32_t busyCode, uint32_t retryIntervalUs)
+    : writeFunc_(writeFunc), busyCode_(busyCode), retryIntervalUs_(retryIntervalUs)
+{
+}
+
+BluetoothRenderWriter::~BluetoothRenderWriter()
+{
+    Stop();
+}
+
+int32_t BluetoothRenderWriter::Start(uint64_t bytesPerSecond)
+{
+    CHECK_AND_RETURN_RET_LOG(writeFunc_ != nullptr && bytesPerSecond != 0, ERR_INVALID_PARAM, "invalid param");
+    if (running_.load()) {
+        return SUCCESS;
+    }
+    bytesPerSecond_ = bytesPerSecond;
+    primed_ = false;
+    quietFrames_ = 0;
+    targetDepth_.store(INITIAL_TARGET_DEPTH);
+    flushRequested_.store(false);
+    paused_.store(false);
+    running_.store(true);
+    thread_ = std::thread(&BluetoothRenderWriter::WriteLoop, this);
+    pthread_setname_np(thread_.native_handle(), "OS_A2dpWriter");
+    return SUCCESS;
+}
+
+void BluetoothRenderWriter::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        running_.store(false);
+    }
+    dataCv_.notify_all();
+    spaceCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+        DropQueued();
+        BluetoothRenderWriterStats stats = GetStats();
+        AUDIO_INFO_LOG("written %{public}" PRIu64 " retry %{public}" PRIu64 " dropped %{public}" PRIu64
+            " underrun %{public}" PRIu64 " max latency %{public}" PRIu64 "us", stats.writtenFrames, stats.retryCount,
+            stats.droppedFrames, stats.underrunCount, stats.maxLatencyUs);
+    }
+}
+
+bool BluetoothRenderWriter::IsRunning() const
+{
+    return running_.load();
+}
+
+void BluetoothRenderWriter::Flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        flushRequested_.store(true);
+    }
+    dataCv_.notify_all();
+}
+
+void BluetoothRenderWriter::Pause()
+{
+    std::lock_guard<std::mutex> lock(waitMutex_);
+    paused_.store(true);
+}
+
+void BluetoothRenderWriter::Resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        paused_.store(false);
+    }
+    dataCv_.notify_all();
+}
+
+int32_t BluetoothRenderWriter::Enqueue(const char *data, uint64_t len)
+{
+    CHECK_AND_RETURN_RET_LOG(running_.load(), ERR_ILLEGAL_STATE, "writer is not running");
+    CHECK_AND_RETURN_RET_LOG(data != nullptr && len != 0, ERR_INVALID_PARAM, "invalid frame");
+
+    uint64_t writeIndex = writeIndex_.load(std::memory_order_relaxed);
+    auto hasSpace = [this, writeIndex] {
+        return writeIndex - readIndex_.load(std::memory_order_acquire) < BT_WRITER_RING_CAPACITY;
+    };
+    if (!hasSpace()) {
+        // the link is congested for longer than the ring covers, hold the producer back for one frame at most
+        Trace trace("BluetoothRenderWriter::Enqueue::wait");
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        spaceCv_.wait_for(lock, std::chrono::microseconds(GetDurationUs(len)),
+            [this, &hasSpace] { return !running_.load() || hasSpace(); });
+    }
+    CHECK_AND_RETURN_RET_LOG(running_.load(), ERR_ILLEGAL_STATE, "writer is stopped");
+    if (!hasSpace()) {
+        Trace::Count(DROP_TRACE_TAG, ++droppedFrames_);
+        AUDIO_WARNING_LOG("ring is full, drop frame of %{public}" PRIu64 " bytes", len);
+        return ERR_WRITE_FAILED;
+    }
+
+    Slot &slot = slots_[writeIndex % BT_WRITER_RING_CAPACITY];
+    if (slot.data.size() < len) {
+        slot.data.resize(len);
+    }
+    CHECK_AND_RETURN_RET_LOG(memcpy_s(slot.data.data(), slot.data.size(), data, len) == EOK, ERR_WRITE_FAILED,
+        "copy frame failed");
+    slot.len = len;
+    slot.enqueueTime = ClockTime::GetCurNano();
+    queuedBytes_.fetch_add(len);
+    writeIndex_.store(writeIndex + 1, std::memory_order_release);
+    Trace::Count(DEPTH_TRACE_TAG, static_cast<int64_t>(writeIndex + 1 - readIndex_.load()));
+    {
+        // the writer checks the index under the lock before sleeping, so the wake up is not lost
+        std::lock_guard<std::mutex> lock(waitMutex_);
+    }
+    dataCv_.notify_one();
+    return SUCCESS;
+}
+
+uint32_t BluetoothRenderWriter::GetQueuedLatencyMs() const
+{
+    if (bytesPerSecond_ == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(queuedBytes_.load() * MS_PER_SECOND / bytesPerSecond_);
+}
+
+BluetoothRenderWriterStats BluetoothRenderWriter::GetStats() const
+{
+    BluetoothRenderWriterStats stats;
+    stats.writtenFrames = writtenFrames_.load();
+    stats.retryCount = retryCount_.load();
+    stats.droppedFrames = droppedFrames_.load();
+    stats.underrunCount = underrunCount_.load();
+    stats.queueDepth = static_cast<uint32_t>(writeIndex_.load() - readIndex_.load());
+    stats.targetDepth = targetDepth_.load();
+    stats.lastLatencyUs = lastLatencyUs_.load();
+    stats.maxLatencyUs = maxLatencyUs_.load();
+    return stats;
+}
+
+void BluetoothRenderWriter::WriteLoop()
+{
+    ScheduleReportData(getpid(), gettid(), "audio_server");
+    while (running_.load()) {
+        if (flushRequested_.exchange(false)) {
+            DropQueued();
+        }
+        if (paused_.load()) {
+            // primed again on resume, the render restarts from an empty hdi buffer
+            primed_ = false;
+            WaitForResume();
+            continue;
+        }
+        uint64_t readIndex = readIndex_.load(std::memory_order_relaxed);
+        uint64_t depth = writeIndex_.load(std::memory_order_acquire) - readIndex;
+        if (depth == 0 && primed_) {
+            primed_ = false;
+            underrunCount_++;
+        }
+        if (!primed_ && depth < targetDepth_.load() && (WaitForFrame(readIndex + depth) || depth == 0)) {
+            continue;
+        }
+        // the target depth is queued, or the producer paused and the queued frames must not be held back
+        primed_ = true;
+
+        Slot &slot = slots_[readIndex % BT_WRITER_RING_CAPACITY];
+        uint64_t retryCount = retryCount_.load();
+        if (!WriteSlot(slot)) {
+            continue;
+        }
+        OnFrameWritten(slot, retryCount_.load() != retryCount);
+        queuedBytes_.fetch_sub(slot.len);
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            readIndex_.store(readIndex + 1, std::memory_order_release);
+        }
+        spaceCv_.notify_one();
+    }
+    UnscheduleReportData(getpid(), gettid(), "audio_server");
+}
+
+// Returns false if no frame is queued before the timeout.
+bool BluetoothRenderWriter::WaitForFrame(uint64_t writeIndex)
+{
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    return dataCv_.wait_for(lock, std::chrono::milliseconds(WAIT_FRAME_TIMEOUT_MS), [this, writeIndex] {
+        return writeIndex_.load() != writeIndex || !running_.load() || flushRequested_.load();
+    });
+}
+
+void BluetoothRenderWriter::WaitForResume()
+{
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    dataCv_.wait_for(lock, std::chrono::milliseconds(WAIT_FRAME_TIMEOUT_MS), [this] {
+        return !paused_.load() || !running_.load() || flushRequested_.load();
+    });
+}
+
+// Returns false if the frame is abandoned by stop, flush or pause, a paused frame is written again on resume.
+bool BluetoothRenderWriter::WriteSlot(Slot &slot)
+{
+    Trace trace("BluetoothRenderWriter::WriteSlot");
+    uint64_t offset = 0;
+    while (offset < slot.len) {
+        uint64_t writeLen = 0;
+        int32_t ret = writeFunc_(slot.data.data() + offset, slot.len - offset, writeLen);
+        if (ret == busyCode_) {
+            Trace::Count(RETRY_TRACE_TAG, ++retryCount_);
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            if (dataCv_.wait_for(lock, std::chrono::microseconds(retryIntervalUs_),
+                [this] { return !running_.load() || flushRequested_.load() || paused_.load(); })) {
+                return false;
+            }
+            continue;
+        }
+        if (ret != SUCCESS || writeLen == 0 || writeLen > slot.len - offset) {
+            AUDIO_ERR_LOG("A2dp RenderFrame failed ret: %{public}x writeLen: %{public}" PRIu64, ret, writeLen);
+            break;
+        }
+        offset += writeLen;
+    }
+    return true;
+}
+
+void BluetoothRenderWriter::OnFrameWritten(const Slot &slot, bool congested)
+{
+    writtenFrames_++;
+    uint64_t latencyUs = static_cast<uint64_t>((ClockTime::GetCurNano() - slot.enqueueTime) / NS_PER_US);
+    lastLatencyUs_.store(latencyUs);
+    if (latencyUs > maxLatencyUs_.load()) {
+        maxLatencyUs_.store(latencyUs);
+    }
+    Trace::Count(LATENCY_TRACE_TAG, static_cast<int64_t>(latencyUs));
+    Trace::Count(DEPTH_TRACE_TAG, static_cast<int64_t>(writeIndex_.load() - readIndex_.load() - 1));
+
+    uint32_t targetDepth = targetDepth_.load();
+    if (congested) {
+        quietFrames_ = 0;
+        if (targetDepth < BT_WRITER_RING_CAPACITY - 1) {
+            targetDepth_.store(targetDepth + 1);
+        }
+    } else if (++quietFrames_ >= QUIET_FRAMES_TO_SHRINK) {
+        quietFrames_ = 0;
+        if (targetDepth > BT_WRITER_MIN_TARGET_DEPTH) {
+            targetDepth_.store(targetDepth - 1);
+        }
+    }
+}
+
+// Called by the writer thread, or by any thread once the writer thread is joined.
+void BluetoothRenderWriter::DropQueued()
+{
+    uint64_t writeIndex = writeIndex_.load(std::memory_order_acquire);
+    uint64_t readIndex = readIndex_.load(std::memory_order_relaxed);
+    for (; readIndex < writeIndex; readIndex++) {
+        queuedBytes_.fetch_sub(slots_[readIndex % BT_WRITER_RING_CAPACITY].len);
+    }
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        readIndex_.store(writeIndex, std::memory_order_release);
+    }
+    spaceCv_.notify_one();
+    primed_ = false;
+}
+
+uint64_t BluetoothRenderWriter::GetDurationUs(uint64_t len) const
+{
+    return bytesPerSecond_ == 0 ? 0 : len * US_PER_SECOND / bytesPerSecond_;
+}
+} // namespace AudioStandard
+} // namespace OHOS
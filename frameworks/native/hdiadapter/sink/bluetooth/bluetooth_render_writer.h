@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLUETOOTH_RENDER_WRITER_H
+#define BLUETOOTH_RENDER_WRITER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace AudioStandard {
+// frames the ring holds, 8 frames of 20ms covers a congestion of 160ms
+constexpr uint32_t BT_WRITER_RING_CAPACITY = 8;
+constexpr uint32_t BT_WRITER_MIN_TARGET_DEPTH = 1;
+
+struct BluetoothRenderWriterStats {
+    uint64_t writtenFrames = 0;
+    uint64_t retryCount = 0;
+    uint64_t droppedFrames = 0;
+    uint64_t underrunCount = 0;
+    uint32_t queueDepth = 0;
+    uint32_t targetDepth = 0;
+    uint64_t lastLatencyUs = 0;
+    uint64_t maxLatencyUs = 0;
+};
+
+// Writes the frames of the a2dp sink to the hdi on its own thread, so a congested link only stalls this thread
+// and not the thread rendering into the sink. Frames are queued in a bounded single producer single consumer
+// ring. Once the ring runs dry, writing resumes when the target depth is queued again. The target depth grows
+// each time the hdi asks for a retry and shrinks back after a quiet period.
+class BluetoothRenderWriter {
+public:
+    // Writes one frame to the hdi. Returning the busy code means the hdi can not take the frame now.
+    using WriteFunc = std::function<int32_t(char *data, uint64_t len, uint64_t &writeLen)>;
+
+    BluetoothRenderWriter(WriteFunc writeFunc, int32_t busyCode, uint32_t retryIntervalUs);
+    ~BluetoothRenderWriter();
+
+    int32_t Start(uint64_t bytesPerSecond);
+    // Stops the thread and drops the queued frames.
+    void Stop();
+    bool IsRunning() const;
+    // Drops the queued frames, may be called from any thread.
+    void Flush();
+    // Holds the queued frames back from the hdi until Resume, so nothing is written to a paused render.
+    void Pause();
+    void Resume();
+
+    // Called by the single producer. Waits at most the duration of the frame for a free slot, the frame is
+    // dropped if the ring is still full.
+    int32_t Enqueue(const char *data, uint64_t len);
+
+    uint32_t GetQueuedLatencyMs() const;
+    BluetoothRenderWriterStats GetStats() const;
+
+private:
+    struct Slot {
+        std::vector<char> data;
+        uint64_t len = 0;
+        int64_t enqueueTime = 0;
+    };
+
+    void WriteLoop();
+    bool WaitForFrame(uint64_t writeIndex);
+    void WaitForResume();
+    bool WriteSlot(Slot &slot);
+    void OnFrameWritten(const Slot &slot, bool congested);
+    void DropQueued();
+    uint64_t GetDurationUs(uint64_t len) const;
+
+    WriteFunc writeFunc_;
+    int32_t busyCode_ = 0;
+    uint32_t retryIntervalUs_ = 0;
+    uint64_t bytesPerSecond_ = 0;
+
+    std::array<Slot, BT_WRITER_RING_CAPACITY> slots_;
+    std::atomic<uint64_t> writeIndex_ = 0;
+    std::atomic<uint64_t> readIndex_ = 0;
+    std::atomic<uint64_t> queuedBytes_ = 0;
+
+    std::atomic<bool> running_ = false;
+    std::atomic<bool> flushRequested_ = false;
+    std::atomic<bool> paused_ = false;
+    std::thread thread_;
+    // only for sleeping and waking up, the ring itself is lock free
+    std::mutex waitMutex_;
+    std::condition_variable dataCv_;
+    std::condition_variable spaceCv_;
+
+    // owned by the writer thread
+    bool primed_ = false;
+    uint32_t quietFrames_ = 0;
+
+    std::atomic<uint32_t> targetDepth_ = BT_WRITER_MIN_TARGET_DEPTH;
+    std::atomic<uint64_t> writtenFrames_ = 0;
+    std::atomic<uint64_t> retryCount_ = 0;
+    std::atomic<uint64_t> droppedFrames_ = 0;
+    std::atomic<uint64_t> underrunCount_ = 0;
+    std::atomic<uint64_t> lastLatencyUs_ = 0;
+    std::atomic<uint64_t> maxLatencyUs_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // BLUETOOTH_RENDER_WRITER_H
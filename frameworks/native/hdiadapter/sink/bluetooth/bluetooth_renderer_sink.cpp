@@ -41,6 +41,8 @@
 #include "parameters.h"
 #include "media_monitor_manager.h"
 #include "audio_log_utils.h"
+#include "sink_post_processor.h"
+#include "bluetooth_render_writer.h"
 
 using namespace std;
 using namespace OHOS::HDI::Audio_Bluetooth;
@@ -67,7 +69,6 @@ const uint32_t PCM_8_BIT = 8;
 const uint32_t PCM_16_BIT = 16;
 const uint32_t PCM_24_BIT = 24;
 const uint32_t PCM_32_BIT = 32;
-const uint32_t STEREO_CHANNEL_COUNT = 2;
 constexpr uint32_t BIT_TO_BYTES = 8;
 constexpr int64_t STAMP_THRESHOLD_MS = 20;
 const unsigned int BUFFER_CALC_20MS = 20;
@@ -75,7 +76,6 @@ const unsigned int BUFFER_CALC_1000MS = 1000;
 #ifdef FEATURE_POWER_MANAGER
 constexpr int32_t RUNNINGLOCK_LOCK_TIMEOUTMS_LASTING = -1;
 #endif
-const uint16_t GET_MAX_AMPLITUDE_FRAMES_THRESHOLD = 10;
 }
 
 typedef struct {
@@ -143,13 +143,12 @@ private:
     struct HDI::Audio_Bluetooth::AudioRender *audioRender_;
     struct HDI::Audio_Bluetooth::AudioPort audioPort = {};
     void *handle_;
-    bool audioMonoState_ = false;
-    bool audioBalanceState_ = false;
-    float leftBalanceCoef_ = 1.0f;
-    float rightBalanceCoef_ = 1.0f;
     int32_t initCount_ = 0;
     int32_t logMode_ = 0;
     AudioSampleFormat audioSampleFormat_ = SAMPLE_S16LE;
+    SinkPostProcessor postProcessor_;
+    // writes the frames of the normal sink to the hdi off the render thread
+    std::unique_ptr<BluetoothRenderWriter> renderWriter_ = nullptr;
 
     // for device switch
     std::atomic<int32_t> renderEmptyFrameCount_ = 0;
@@ -168,12 +167,6 @@ private:
     uint32_t eachReadFrameSize_ = 0;
     size_t bufferSize_ = 0;
 
-    // for get amplitude
-    float maxAmplitude_ = 0;
-    int64_t lastGetMaxAmplitudeTime_ = 0;
-    int64_t last10FrameStartTime_ = 0;
-    bool startUpdate_ = false;
-    int renderFrameNum_ = 0;
     bool signalDetected_ = false;
     bool latencyMeasEnabled_ = false;
     std::shared_ptr<SignalDetectAgent> signalDetectAgent_ = nullptr;
@@ -185,20 +178,15 @@ private:
 
     int32_t CreateRender(struct HDI::Audio_Bluetooth::AudioPort &renderPort);
     int32_t InitAudioManager();
-    void AdjustStereoToMono(char *data, uint64_t len);
-    void AdjustAudioBalance(char *data, uint64_t len);
     AudioFormat ConvertToHdiFormat(HdiAdapterFormat format);
-    ConvertHdiFormat ConvertToHdiAdapterFormat(AudioFormat format);
     int64_t BytesToNanoTime(size_t lens);
-    void CheckUpdateState(char *frame, uint64_t replyBytes);
     void InitLatencyMeasurement();
     void DeinitLatencyMeasurement();
     void CheckLatencySignal(uint8_t *data, size_t len);
-    void DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const;
+    int32_t WriteToHdi(char *data, uint64_t len, uint64_t &writeLen);
+    uint64_t GetBytesPerSecond();
     FILE *dumpFile_ = nullptr;
     std::string dumpFileName_ = "";
-    mutable int64_t volumeDataCount_ = 0;
-    std::string logUtilsTag_ = "";
 };
 
 BluetoothRendererSinkInner::BluetoothRendererSinkInner(bool isBluetoothLowLatency)
@@ -212,7 +200,6 @@ BluetoothRendererSinkInner::BluetoothRendererSinkInner(bool isBluetoothLowLatenc
 BluetoothRendererSinkInner::~BluetoothRendererSinkInner()
 {
     BluetoothRendererSinkInner::DeInit();
-    AUDIO_INFO_LOG("[%{public}s] volume data counts: %{public}" PRId64, logUtilsTag_.c_str(), volumeDataCount_);
 }
 
 BluetoothRendererSink *BluetoothRendererSink::GetInstance()
@@ -287,6 +274,10 @@ void BluetoothRendererSinkInner::DeInit()
         AUDIO_WARNING_LOG("Sink is still being used, count: %{public}d", initCount_);
         return;
     }
+    if (renderWriter_ != nullptr) {
+        renderWriter_->Stop();
+        renderWriter_ = nullptr;
+    }
     started_ = false;
     rendererInited_ = false;
     if ((audioRender_ != nullptr) && (audioAdapter_ != nullptr)) {
@@ -494,10 +485,14 @@ int32_t BluetoothRendererSinkInner::Init(const IAudioSinkAttr &attr)
     if (isBluetoothLowLatency_) {
         result = PrepareMmapBuffer();
         CHECK_AND_RETURN_RET_LOG(result == 0, ERR_NOT_STARTED, "Prepare mmap buffer failed");
+    } else {
+        renderWriter_ = std::make_unique<BluetoothRenderWriter>(
+            [this](char *data, uint64_t len, uint64_t &writeLen) { return WriteToHdi(data, len, writeLen); },
+            RENDER_FRAME_NUM, RENDER_FRAME_INTERVAL_IN_MICROSECONDS);
     }
 
     logMode_ = system::GetIntParameter("persist.multimedia.audiolog.switch", 0);
-    logUtilsTag_ = "A2dpSink";
+    postProcessor_.SetLogUtilsTag("A2dpSink");
 
     rendererInited_ = true;
     initCount_++;
@@ -510,18 +505,14 @@ int32_t BluetoothRendererSinkInner::RenderFrame(char &data, uint64_t len, uint64
     int32_t ret = SUCCESS;
     CHECK_AND_RETURN_RET_LOG(audioRender_ != nullptr, ERR_INVALID_HANDLE, "Bluetooth Render Handle is nullptr!");
 
-    if (audioMonoState_) { AdjustStereoToMono(&data, len); }
-    if (audioBalanceState_) { AdjustAudioBalance(&data, len); }
+    postProcessor_.Process(&data, len, audioSampleFormat_, attr_.channel);
 
     CheckLatencySignal(reinterpret_cast<uint8_t*>(&data), len);
     DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(&data), len);
-    BufferDesc buffer = { reinterpret_cast<uint8_t*>(&data), len, len };
-    DfxOperation(buffer, audioSampleFormat_, static_cast<AudioChannel>(attr_.channel));
     if (AudioDump::GetInstance().GetVersionType() == BETA_VERSION) {
         Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
             static_cast<void *>(&data), len);
     }
-    CheckUpdateState(&data, len);
     if (suspend_) { return ret; }
 
     Trace trace("BluetoothRendererSinkInner::RenderFrame");
@@ -533,27 +524,26 @@ int32_t BluetoothRendererSinkInner::RenderFrame(char &data, uint64_t len, uint64
         }
         renderEmptyFrameCount_--;
     }
-    while (true) {
-        Trace::CountVolume("BluetoothRendererSinkInner::RenderFrame", static_cast<uint8_t>(data));
-        Trace trace("audioRender_->RenderFrame");
-        int64_t stamp = ClockTime::GetCurNano();
-        ret = audioRender_->RenderFrame(audioRender_, (void*)&data, len, &writeLen);
-        stamp = (ClockTime::GetCurNano() - stamp) / AUDIO_US_PER_SECOND;
-        if (logMode_ || stamp >= STAMP_THRESHOLD_MS) {
-            AUDIO_PRERELEASE_LOGW("A2dp RenderFrame len[%{public}" PRIu64 "] cost[%{public}" PRId64 "]ms " \
-                "writeLen[%{public}" PRIu64 "] returns: %{public}x", len, stamp, writeLen, ret);
-        }
-        if (ret == RENDER_FRAME_NUM) {
-            AUDIO_ERR_LOG("retry render frame...");
-            usleep(RENDER_FRAME_INTERVAL_IN_MICROSECONDS);
-            continue;
-        }
-        if (ret != 0) {
-            AUDIO_ERR_LOG("A2dp RenderFrame failed ret: %{public}x", ret);
-            ret = ERR_WRITE_FAILED;
-        }
+    Trace::CountVolume("BluetoothRendererSinkInner::RenderFrame", static_cast<uint8_t>(data));
+    if (renderWriter_ != nullptr && renderWriter_->IsRunning()) {
+        // a congested link stalls the writer thread, the frame is only queued here
+        ret = renderWriter_->Enqueue(&data, len);
+        writeLen = ret == SUCCESS ? len : 0;
+    } else {
+        while (true) {
+            ret = WriteToHdi(&data, len, writeLen);
+            if (ret == RENDER_FRAME_NUM) {
+                AUDIO_ERR_LOG("retry render frame...");
+                usleep(RENDER_FRAME_INTERVAL_IN_MICROSECONDS);
+                continue;
+            }
+            if (ret != 0) {
+                AUDIO_ERR_LOG("A2dp RenderFrame failed ret: %{public}x", ret);
+                ret = ERR_WRITE_FAILED;
+            }
 
-        break;
+            break;
+        }
     }
 
 #ifdef FEATURE_POWER_MANAGER
@@ -563,75 +553,39 @@ int32_t BluetoothRendererSinkInner::RenderFrame(char &data, uint64_t len, uint64
     return ret;
 }
 
-#ifdef FEATURE_POWER_MANAGER
-void BluetoothRendererSinkInner::UpdateAppsUid()
+int32_t BluetoothRendererSinkInner::WriteToHdi(char *data, uint64_t len, uint64_t &writeLen)
 {
-    if (runningLockManager_) {
-        runningLockManager_->UpdateAppsUidToPowerMgr();
-    } else {
-        AUDIO_ERR_LOG("runningLockManager_ is nullptr");
-    }
-}
-#endif
-
-void BluetoothRendererSinkInner::DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const
-{
-    ChannelVolumes vols = VolumeTools::CountVolumeLevel(buffer, format, channel);
-    if (channel == MONO) {
-        Trace::Count(logUtilsTag_, vols.volStart[0]);
-    } else {
-        Trace::Count(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
+    CHECK_AND_RETURN_RET_LOG(audioRender_ != nullptr, ERR_INVALID_HANDLE, "Bluetooth Render Handle is nullptr!");
+    Trace trace("audioRender_->RenderFrame");
+    int64_t stamp = ClockTime::GetCurNano();
+    int32_t ret = audioRender_->RenderFrame(audioRender_, static_cast<void *>(data), len, &writeLen);
+    stamp = (ClockTime::GetCurNano() - stamp) / AUDIO_US_PER_SECOND;
+    if (logMode_ || stamp >= STAMP_THRESHOLD_MS) {
+        AUDIO_PRERELEASE_LOGW("A2dp RenderFrame len[%{public}" PRIu64 "] cost[%{public}" PRId64 "]ms " \
+            "writeLen[%{public}" PRIu64 "] returns: %{public}x", len, stamp, writeLen, ret);
     }
-    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_);
+    return ret;
 }
 
-ConvertHdiFormat BluetoothRendererSinkInner::ConvertToHdiAdapterFormat(AudioFormat format)
+uint64_t BluetoothRendererSinkInner::GetBytesPerSecond()
 {
-    ConvertHdiFormat hdiFormat;
-    switch (format) {
-        case AUDIO_FORMAT_TYPE_PCM_8_BIT:
-            hdiFormat = SAMPLE_U8_C;
-            break;
-        case AUDIO_FORMAT_TYPE_PCM_16_BIT:
-            hdiFormat = SAMPLE_S16_C;
-            break;
-        case AUDIO_FORMAT_TYPE_PCM_24_BIT:
-            hdiFormat = SAMPLE_S24_C;
-            break;
-        case AUDIO_FORMAT_TYPE_PCM_32_BIT:
-            hdiFormat = SAMPLE_S32_C;
-            break;
-        default:
-            hdiFormat = SAMPLE_S16_C;
-            break;
-    }
-
-    return hdiFormat;
+    return static_cast<uint64_t>(PcmFormatToBits(attr_.format)) * attr_.channel * attr_.sampleRate / PCM_8_BIT;
 }
 
-void BluetoothRendererSinkInner::CheckUpdateState(char *frame, uint64_t replyBytes)
+#ifdef FEATURE_POWER_MANAGER
+void BluetoothRendererSinkInner::UpdateAppsUid()
 {
-    if (startUpdate_) {
-        if (renderFrameNum_ == 0) {
-            last10FrameStartTime_ = ClockTime::GetCurNano();
-        }
-        renderFrameNum_++;
-        maxAmplitude_ = UpdateMaxAmplitude(ConvertToHdiAdapterFormat(attr_.format), frame, replyBytes);
-        if (renderFrameNum_ == GET_MAX_AMPLITUDE_FRAMES_THRESHOLD) {
-            renderFrameNum_ = 0;
-            if (last10FrameStartTime_ > lastGetMaxAmplitudeTime_) {
-                startUpdate_ = false;
-                maxAmplitude_ = 0;
-            }
-        }
+    if (runningLockManager_) {
+        runningLockManager_->UpdateAppsUidToPowerMgr();
+    } else {
+        AUDIO_ERR_LOG("runningLockManager_ is nullptr");
     }
 }
+#endif
 
 float BluetoothRendererSinkInner::GetMaxAmplitude()
 {
-    lastGetMaxAmplitudeTime_ = ClockTime::GetCurNano();
-    startUpdate_ = true;
-    return maxAmplitude_;
+    return postProcessor_.GetMaxAmplitude();
 }
 
 int32_t BluetoothRendererSinkInner::Start(void)
@@ -669,6 +623,9 @@ int32_t BluetoothRendererSinkInner::Start(void)
             int32_t ret = audioRender_->control.Start(reinterpret_cast<AudioHandle>(audioRender_));
             if (!ret) {
                 started_ = true;
+                if (renderWriter_ != nullptr && renderWriter_->Start(GetBytesPerSecond()) != SUCCESS) {
+                    AUDIO_WARNING_LOG("Start render writer failed, write on the render thread");
+                }
                 CHECK_AND_RETURN_RET_LOG(CheckPositionTime() == SUCCESS, ERR_NOT_STARTED, "CheckPositionTime failed!");
                 return SUCCESS;
             } else {
@@ -762,7 +719,7 @@ int32_t BluetoothRendererSinkInner::GetLatency(uint32_t *latency)
 
     uint32_t hdiLatency;
     if (audioRender_->GetLatency(audioRender_, &hdiLatency) == 0) {
-        *latency = hdiLatency;
+        *latency = hdiLatency + (renderWriter_ != nullptr ? renderWriter_->GetQueuedLatencyMs() : 0);
         return SUCCESS;
     } else {
         return ERR_OPERATION_FAILED;
@@ -795,6 +752,9 @@ int32_t BluetoothRendererSinkInner::Stop(void)
     CHECK_AND_RETURN_RET_LOG(audioRender_ != nullptr, ERR_INVALID_HANDLE,
         "Stop failed audioRender_ null");
 
+    if (renderWriter_ != nullptr) {
+        renderWriter_->Stop();
+    }
     if (started_) {
         Trace trace("audioRender_->control.Stop");
         AUDIO_DEBUG_LOG("Stop control before");
@@ -824,11 +784,18 @@ int32_t BluetoothRendererSinkInner::Pause(void)
         "Pause invalid state!");
 
     if (!paused_) {
+        // hold the writer first, so it does not write to the paused render
+        if (renderWriter_ != nullptr) {
+            renderWriter_->Pause();
+        }
         int32_t ret = audioRender_->control.Pause(reinterpret_cast<AudioHandle>(audioRender_));
         if (!ret) {
             paused_ = true;
             return SUCCESS;
         } else {
+            if (renderWriter_ != nullptr) {
+                renderWriter_->Resume();
+            }
             AUDIO_ERR_LOG("Pause failed!");
             return ERR_OPERATION_FAILED;
         }
@@ -851,6 +818,9 @@ int32_t BluetoothRendererSinkInner::Resume(void)
         int32_t ret = audioRender_->control.Resume(reinterpret_cast<AudioHandle>(audioRender_));
         if (!ret) {
             paused_ = false;
+            if (renderWriter_ != nullptr) {
+                renderWriter_->Resume();
+            }
             return SUCCESS;
         } else {
             AUDIO_ERR_LOG("Resume failed!");
@@ -865,6 +835,9 @@ int32_t BluetoothRendererSinkInner::Reset(void)
 {
     AUDIO_INFO_LOG("in");
 
+    if (renderWriter_ != nullptr) {
+        renderWriter_->Flush();
+    }
     if (started_ && audioRender_ != nullptr) {
         int32_t ret = audioRender_->control.Flush(reinterpret_cast<AudioHandle>(audioRender_));
         if (!ret) {
@@ -882,6 +855,9 @@ int32_t BluetoothRendererSinkInner::Flush(void)
 {
     AUDIO_INFO_LOG("in");
 
+    if (renderWriter_ != nullptr) {
+        renderWriter_->Flush();
+    }
     if (started_ && audioRender_ != nullptr) {
         int32_t ret = audioRender_->control.Flush(reinterpret_cast<AudioHandle>(audioRender_));
         if (!ret) {
@@ -909,28 +885,12 @@ int32_t BluetoothRendererSinkInner::RestoreRenderSink(void)
 
 void BluetoothRendererSinkInner::SetAudioMonoState(bool audioMono)
 {
-    audioMonoState_ = audioMono;
+    postProcessor_.SetAudioMonoState(audioMono);
 }
 
 void BluetoothRendererSinkInner::SetAudioBalanceValue(float audioBalance)
 {
-    // reset the balance coefficient value firstly
-    leftBalanceCoef_ = 1.0f;
-    rightBalanceCoef_ = 1.0f;
-
-    if (std::abs(audioBalance) <= std::numeric_limits<float>::epsilon()) {
-        // audioBalance is equal to 0.0f
-        audioBalanceState_ = false;
-    } else {
-        // audioBalance is not equal to 0.0f
-        audioBalanceState_ = true;
-        // calculate the balance coefficient
-        if (audioBalance > 0.0f) {
-            leftBalanceCoef_ -= audioBalance;
-        } else if (audioBalance < 0.0f) {
-            rightBalanceCoef_ += audioBalance;
-        }
-    }
+    postProcessor_.SetAudioBalanceValue(audioBalance);
 }
 
 int32_t BluetoothRendererSinkInner::GetPresentationPosition(uint64_t& frames, int64_t& timeSec, int64_t& timeNanoSec)
@@ -939,73 +899,6 @@ int32_t BluetoothRendererSinkInner::GetPresentationPosition(uint64_t& frames, in
     return ERR_NOT_SUPPORTED;
 }
 
-void BluetoothRendererSinkInner::AdjustStereoToMono(char *data, uint64_t len)
-{
-    // only stereo is surpported now (stereo channel count is 2)
-    CHECK_AND_RETURN_LOG(attr_.channel == STEREO_CHANNEL_COUNT,
-        "AdjustStereoToMono: Unsupported channel number: %{public}d", attr_.channel);
-
-    switch (attr_.format) {
-        case AUDIO_FORMAT_TYPE_PCM_8_BIT: {
-            // this function needs to be further tested for usability
-            AdjustStereoToMonoForPCM8Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case AUDIO_FORMAT_TYPE_PCM_16_BIT: {
-            AdjustStereoToMonoForPCM16Bit(reinterpret_cast<int16_t *>(data), len);
-            break;
-        }
-        case AUDIO_FORMAT_TYPE_PCM_24_BIT: {
-            // this function needs to be further tested for usability
-            AdjustStereoToMonoForPCM24Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case AUDIO_FORMAT_TYPE_PCM_32_BIT: {
-            AdjustStereoToMonoForPCM32Bit(reinterpret_cast<int32_t *>(data), len);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("AdjustStereoToMono: Unsupported audio format: %{public}d",
-                attr_.format);
-            break;
-        }
-    }
-}
-
-void BluetoothRendererSinkInner::AdjustAudioBalance(char *data, uint64_t len)
-{
-    CHECK_AND_RETURN_LOG(attr_.channel == STEREO_CHANNEL_COUNT,
-        "Unsupported channel number: %{public}d", attr_.channel);
-
-    switch (attr_.format) {
-        case AUDIO_FORMAT_TYPE_PCM_8_BIT: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM8Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case AUDIO_FORMAT_TYPE_PCM_16_BIT: {
-            AdjustAudioBalanceForPCM16Bit(reinterpret_cast<int16_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case AUDIO_FORMAT_TYPE_PCM_24_BIT: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM24Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case AUDIO_FORMAT_TYPE_PCM_32_BIT: {
-            AdjustAudioBalanceForPCM32Bit(reinterpret_cast<int32_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("Unsupported audio format: %{public}d",
-                attr_.format);
-            break;
-        }
-    }
-}
-
 void BluetoothRendererSinkInner::ResetOutputRouteForDisconnect(DeviceType device)
 {
     AUDIO_WARNING_LOG("not supported.");
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "SinkPostProcessor"
+#endif
+
+#include "sink_post_processor.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+#include "audio_errors.h"
+#include "audio_hdi_log.h"
+#include "audio_log_utils.h"
+#include "audio_utils.h"
+#include "volume_tools.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const int32_t HALF_FACTOR = 2;
+const uint32_t STEREO_CHANNEL_COUNT = 2;
+const uint16_t GET_MAX_AMPLITUDE_FRAMES_THRESHOLD = 10;
+
+// Same as AdjustStereoToMonoForPCM*Bit, AdjustAudioBalanceForPCM*Bit and CalculateMaxAmplitudeForPCM*Bit
+// in one loop. Returns the max absolute sample after the adjustment.
+template <typename T, bool MONO, bool BALANCE>
+int64_t ProcessStereo(T *data, size_t frameCount, float left, float right)
+{
+    int64_t peak = 0;
+    for (size_t i = 0; i < frameCount; i++) {
+        T *frame = data + i * STEREO_CHANNEL_COUNT;
+        if (MONO) {
+            frame[0] = frame[0] / HALF_FACTOR + frame[1] / HALF_FACTOR;
+            frame[1] = frame[0];
+        }
+        if (BALANCE) {
+            frame[0] *= left;
+            frame[1] *= right;
+        }
+        peak = std::max({peak, std::abs(static_cast<int64_t>(frame[0])), std::abs(static_cast<int64_t>(frame[1]))});
+    }
+    return peak;
+}
+
+template <typename T>
+int64_t GetPeak(const T *data, size_t sampleCount)
+{
+    int64_t peak = 0;
+    for (size_t i = 0; i < sampleCount; i++) {
+        peak = std::max(peak, std::abs(static_cast<int64_t>(data[i])));
+    }
+    return peak;
+}
+
+template <typename T>
+int64_t ProcessSamples(T *data, size_t sampleCount, bool mono, bool balance, float left, float right)
+{
+    size_t frameCount = sampleCount / STEREO_CHANNEL_COUNT;
+    if (mono && balance) {
+        return ProcessStereo<T, true, true>(data, frameCount, left, right);
+    } else if (mono) {
+        return ProcessStereo<T, true, false>(data, frameCount, left, right);
+    } else if (balance) {
+        return ProcessStereo<T, false, true>(data, frameCount, left, right);
+    }
+    return GetPeak(data, sampleCount);
+}
+
+template <typename T>
+float GetAmplitude(int64_t peak, int64_t range)
+{
+    // -min of the type is counted as max
+    return float(std::min(peak, static_cast<int64_t>(std::numeric_limits<T>::max()))) / range;
+}
+} // namespace
+
+SinkPostProcessor::~SinkPostProcessor()
+{
+    if (!logUtilsTag_.empty()) {
+        AUDIO_INFO_LOG("[%{public}s] volume data counts: %{public}" PRId64, logUtilsTag_.c_str(), volumeDataCount_);
+    }
+}
+
+void SinkPostProcessor::SetAudioMonoState(bool audioMono)
+{
+    audioMonoState_ = audioMono;
+}
+
+void SinkPostProcessor::SetAudioBalanceValue(float audioBalance)
+{
+    // reset the balance coefficient value firstly
+    leftBalanceCoef_ = 1.0f;
+    rightBalanceCoef_ = 1.0f;
+
+    if (std::abs(audioBalance - 0.0f) <= std::numeric_limits<float>::epsilon()) {
+        // audioBalance is equal to 0.0f
+        audioBalanceState_ = false;
+    } else {
+        // audioBalance is not equal to 0.0f
+        audioBalanceState_ = true;
+        // calculate the balance coefficient
+        if (audioBalance > 0.0f) {
+            leftBalanceCoef_ -= audioBalance;
+        } else if (audioBalance < 0.0f) {
+            rightBalanceCoef_ += audioBalance;
+        }
+    }
+}
+
+void SinkPostProcessor::SetLogUtilsTag(const std::string &logUtilsTag)
+{
+    logUtilsTag_ = logUtilsTag;
+}
+
+bool SinkPostProcessor::IsAdjustNeeded(uint32_t channel) const
+{
+    if (!audioMonoState_ && !audioBalanceState_) {
+        return false;
+    }
+    // only stereo is surpported now (stereo channel count is 2)
+    CHECK_AND_RETURN_RET_LOG(channel == STEREO_CHANNEL_COUNT, false,
+        "Adjust mono or balance: Unsupported channel number: %{public}d", channel);
+    return true;
+}
+
+// Returns the max amplitude of the data if countAmplitude is set.
+float SinkPostProcessor::RunStages(uint8_t *data, size_t len, AudioSampleFormat format, bool adjust,
+    bool countAmplitude)
+{
+    if (!adjust && !countAmplitude) {
+        return 0;
+    }
+    bool mono = adjust && audioMonoState_;
+    bool balance = adjust && audioBalanceState_;
+    switch (format) {
+        case SAMPLE_S16LE: {
+            int64_t peak = ProcessSamples(reinterpret_cast<int16_t *>(data), len / sizeof(int16_t), mono, balance,
+                leftBalanceCoef_, rightBalanceCoef_);
+            return GetAmplitude<int16_t>(peak, SHRT_MAX);
+        }
+        case SAMPLE_S32LE: {
+            int64_t peak = ProcessSamples(reinterpret_cast<int32_t *>(data), len / sizeof(int32_t), mono, balance,
+                leftBalanceCoef_, rightBalanceCoef_);
+            return GetAmplitude<int32_t>(peak, LONG_MAX);
+        }
+        case SAMPLE_U8:
+            if (mono) {
+                AdjustStereoToMonoForPCM8Bit(reinterpret_cast<int8_t *>(data), len);
+            }
+            if (balance) {
+                // this function needs to be further tested for usability
+                AdjustAudioBalanceForPCM8Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_,
+                    rightBalanceCoef_);
+            }
+            break;
+        case SAMPLE_S24LE:
+            // 24bit is not supported for mono and audio balance
+            break;
+        default:
+            // if the audio format is unsupported, the audio data will not be changed, logged once per format
+            if (format != unsupportedFormat_) {
+                unsupportedFormat_ = format;
+                AUDIO_ERR_LOG("Unsupported audio format: %{public}d", format);
+            }
+            return 0;
+    }
+    return countAmplitude ? UpdateMaxAmplitude(static_cast<ConvertHdiFormat>(format),
+        reinterpret_cast<char *>(data), len) : 0;
+}
+
+void SinkPostProcessor::Process(char *data, uint64_t len, AudioSampleFormat format, uint32_t channel)
+{
+    CHECK_AND_RETURN_LOG(data != nullptr, "data is nullptr");
+    bool adjust = IsAdjustNeeded(channel);
+    bool countAmplitude = startUpdate_;
+    float maxAmplitude = 0;
+    auto stages = [&](uint8_t *block, size_t blockLen) {
+        maxAmplitude = std::max(maxAmplitude, RunStages(block, blockLen, format, adjust, countAmplitude));
+    };
+
+    BufferDesc buffer = { reinterpret_cast<uint8_t *>(data), len, len };
+    ChannelVolumes vols;
+    if (!logUtilsTag_.empty() && VolumeTools::CountVolumeLevel(buffer, format, static_cast<AudioChannel>(channel),
+        stages, vols) == SUCCESS) {
+        if (channel == MONO) {
+            Trace::Count(logUtilsTag_, vols.volStart[0]);
+        } else {
+            Trace::Count(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
+        }
+        AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_);
+    } else {
+        maxAmplitude = RunStages(buffer.buffer, len, format, adjust, countAmplitude);
+    }
+
+    if (countAmplitude) {
+        UpdateAmplitudeState(maxAmplitude);
+    }
+}
+
+void SinkPostProcessor::UpdateAmplitudeState(float maxAmplitude)
+{
+    if (renderFrameNum_ == 0) {
+        last10FrameStartTime_ = ClockTime::GetCurNano();
+    }
+    renderFrameNum_++;
+    maxAmplitude_ = maxAmplitude;
+    if (renderFrameNum_ == GET_MAX_AMPLITUDE_FRAMES_THRESHOLD) {
+        renderFrameNum_ = 0;
+        if (last10FrameStartTime_ > lastGetMaxAmplitudeTime_) {
+            startUpdate_ = false;
+            maxAmplitude_ = 0;
+        }
+    }
+}
+
+float SinkPostProcessor::GetMaxAmplitude()
+{
+    lastGetMaxAmplitudeTime_ = ClockTime::GetCurNano();
+    startUpdate_ = true;
+    return maxAmplitude_;
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SINK_POST_PROCESSOR_H
+#define SINK_POST_PROCESSOR_H
+
+#include <string>
+
+#include "audio_info.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// Post processing of the renderer sinks before a frame is written to the hdi: stereo to mono, audio balance,
+// the max amplitude for GetMaxAmplitude and the volume level for dfx. Enabled stages run in one pass over the
+// frame, block by block together with the volume level counting.
+class SinkPostProcessor {
+public:
+    SinkPostProcessor() = default;
+    ~SinkPostProcessor();
+
+    void SetAudioMonoState(bool audioMono);
+    void SetAudioBalanceValue(float audioBalance);
+
+    // The volume level is counted and reported under the tag once it is set.
+    void SetLogUtilsTag(const std::string &logUtilsTag);
+
+    void Process(char *data, uint64_t len, AudioSampleFormat format, uint32_t channel);
+    float GetMaxAmplitude();
+
+private:
+    bool IsAdjustNeeded(uint32_t channel) const;
+    float RunStages(uint8_t *data, size_t len, AudioSampleFormat format, bool adjust, bool countAmplitude);
+    void UpdateAmplitudeState(float maxAmplitude);
+
+    bool audioMonoState_ = false;
+    bool audioBalanceState_ = false;
+    float leftBalanceCoef_ = 1.0f;
+    float rightBalanceCoef_ = 1.0f;
+    AudioSampleFormat unsupportedFormat_ = INVALID_WIDTH;
+
+    // for get amplitude
+    float maxAmplitude_ = 0;
+    int64_t lastGetMaxAmplitudeTime_ = 0;
+    int64_t last10FrameStartTime_ = 0;
+    bool startUpdate_ = false;
+    int renderFrameNum_ = 0;
+
+    int64_t volumeDataCount_ = 0;
+    std::string logUtilsTag_ = "";
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // SINK_POST_PROCESSOR_H
@@ -38,6 +38,7 @@
 #include "audio_errors.h"
 #include "audio_hdi_log.h"
 #include "audio_utils.h"
+#include "sink_post_processor.h"
 #include "parameters.h"
 
 using namespace std;
@@ -57,7 +58,6 @@ const uint32_t PCM_24_BIT = 24;
 const uint32_t PCM_32_BIT = 32;
 const uint32_t MULTICHANNEL_OUTPUT_STREAM_ID = 61; // 13 + 6 * 8
 const uint32_t STEREO_CHANNEL_COUNT = 2;
-const uint16_t GET_MAX_AMPLITUDE_FRAMES_THRESHOLD = 10;
 
 #ifdef FEATURE_POWER_MANAGER
 constexpr int32_t RUNNINGLOCK_LOCK_TIMEOUTMS_LASTING = -1;
@@ -131,16 +131,7 @@ private:
     std::string halName_;
     struct AudioAdapterDescriptor adapterDesc_ = {};
     struct AudioPort audioPort_ = {};
-    bool audioMonoState_ = false;
-    bool audioBalanceState_ = false;
-    float leftBalanceCoef_ = 1.0f;
-    float rightBalanceCoef_ = 1.0f;
-    // for get amplitude
-    float maxAmplitude_ = 0;
-    int64_t lastGetMaxAmplitudeTime_ = 0;
-    int64_t last10FrameStartTime_ = 0;
-    bool startUpdate_ = false;
-    int renderFrameNum_ = 0;
+    SinkPostProcessor postProcessor_;
 #ifdef FEATURE_POWER_MANAGER
     std::shared_ptr<AudioRunningLockManager<PowerMgr::RunningLock>> runningLockManager_;
 #endif
@@ -154,14 +145,11 @@ private:
     int32_t CreateRender(const struct AudioPort &renderPort);
     int32_t InitAudioManager();
     AudioFormat ConvertToHdiFormat(HdiAdapterFormat format);
-    void AdjustStereoToMono(char *data, uint64_t len);
-    void AdjustAudioBalance(char *data, uint64_t len);
 
     int32_t UpdateUsbAttrs(const std::string &usbInfoStr);
     int32_t InitAdapter();
     int32_t InitRender();
 
-    void CheckUpdateState(char *frame, uint64_t replyBytes);
 
     FILE *dumpFile_ = nullptr;
     DeviceType currentActiveDevice_ = DEVICE_TYPE_NONE;
@@ -259,98 +247,12 @@ std::string MultiChannelRendererSinkInner::GetAudioParameter(const AudioParamKey
 
 void MultiChannelRendererSinkInner::SetAudioMonoState(bool audioMono)
 {
-    audioMonoState_ = audioMono;
+    postProcessor_.SetAudioMonoState(audioMono);
 }
 
 void MultiChannelRendererSinkInner::SetAudioBalanceValue(float audioBalance)
 {
-    // reset the balance coefficient value firstly
-    leftBalanceCoef_ = 1.0f;
-    rightBalanceCoef_ = 1.0f;
-
-    if (std::abs(audioBalance - 0.0f) <= std::numeric_limits<float>::epsilon()) {
-        // audioBalance is equal to 0.0f
-        audioBalanceState_ = false;
-    } else {
-        // audioBalance is not equal to 0.0f
-        audioBalanceState_ = true;
-        // calculate the balance coefficient
-        if (audioBalance > 0.0f) {
-            leftBalanceCoef_ -= audioBalance;
-        } else if (audioBalance < 0.0f) {
-            rightBalanceCoef_ += audioBalance;
-        }
-    }
-}
-
-void MultiChannelRendererSinkInner::AdjustStereoToMono(char *data, uint64_t len)
-{
-    if (attr_.channel != STEREO_CHANNEL_COUNT) {
-        // only stereo is surpported now (stereo channel count is 2)
-        AUDIO_ERR_LOG("AdjustStereoToMono: Unsupported channel number: %{public}d", attr_.channel);
-        return;
-    }
-
-    switch (attr_.format) {
-        case SAMPLE_U8: {
-            // this function needs to be further tested for usability
-            AdjustStereoToMonoForPCM8Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S16: {
-            AdjustStereoToMonoForPCM16Bit(reinterpret_cast<int16_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S24: {
-            // this function needs to be further tested for usability
-            AdjustStereoToMonoForPCM24Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S32: {
-            AdjustStereoToMonoForPCM32Bit(reinterpret_cast<int32_t *>(data), len);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("AdjustStereoToMono: Unsupported audio format: %{public}d", attr_.format);
-            break;
-        }
-    }
-}
-
-void MultiChannelRendererSinkInner::AdjustAudioBalance(char *data, uint64_t len)
-{
-    if (attr_.channel != STEREO_CHANNEL_COUNT) {
-        // only stereo is surpported now (stereo channel count is 2)
-        AUDIO_ERR_LOG("Unsupported channel number: %{public}d", attr_.channel);
-        return;
-    }
-
-    switch (attr_.format) {
-        case SAMPLE_U8: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM8Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S16LE: {
-            AdjustAudioBalanceForPCM16Bit(reinterpret_cast<int16_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S24LE: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM24Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S32LE: {
-            AdjustAudioBalanceForPCM32Bit(reinterpret_cast<int32_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("Unsupported audio format: %{public}d", attr_.format);
-            break;
-        }
-    }
+    postProcessor_.SetAudioBalanceValue(audioBalance);
 }
 
 bool MultiChannelRendererSinkInner::IsInited()
@@ -511,16 +413,9 @@ int32_t MultiChannelRendererSinkInner::RenderFrame(char &data, uint64_t len, uin
         return ERR_INVALID_HANDLE;
     }
 
-    if (audioMonoState_) {
-        AdjustStereoToMono(&data, len);
-    }
-
-    if (audioBalanceState_) {
-        AdjustAudioBalance(&data, len);
-    }
+    postProcessor_.Process(&data, len, static_cast<AudioSampleFormat>(attr_.format), attr_.channel);
 
     DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(&data), len);
-    CheckUpdateState(&data, len);
 
     if (inSwitch_) {
         Trace traceInSwitch("AudioRendererSinkInner::RenderFrame::inSwitch");
@@ -554,29 +449,9 @@ int32_t MultiChannelRendererSinkInner::RenderFrame(char &data, uint64_t len, uin
     return SUCCESS;
 }
 
-void MultiChannelRendererSinkInner::CheckUpdateState(char *frame, uint64_t replyBytes)
-{
-    if (startUpdate_) {
-        if (renderFrameNum_ == 0) {
-            last10FrameStartTime_ = ClockTime::GetCurNano();
-        }
-        renderFrameNum_++;
-        maxAmplitude_ = UpdateMaxAmplitude(static_cast<ConvertHdiFormat>(attr_.format), frame, replyBytes);
-        if (renderFrameNum_ == GET_MAX_AMPLITUDE_FRAMES_THRESHOLD) {
-            renderFrameNum_ = 0;
-            if (last10FrameStartTime_ > lastGetMaxAmplitudeTime_) {
-                startUpdate_ = false;
-                maxAmplitude_ = 0;
-            }
-        }
-    }
-}
-
 float MultiChannelRendererSinkInner::GetMaxAmplitude()
 {
-    lastGetMaxAmplitudeTime_ = ClockTime::GetCurNano();
-    startUpdate_ = true;
-    return maxAmplitude_;
+    return postProcessor_.GetMaxAmplitude();
 }
 
 int32_t MultiChannelRendererSinkInner::Start(void)
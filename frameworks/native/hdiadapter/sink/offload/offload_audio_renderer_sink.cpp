@@ -35,6 +35,7 @@
 #include "audio_errors.h"
 #include "audio_hdi_log.h"
 #include "audio_utils.h"
+#include "sink_post_processor.h"
 #include "media_monitor_manager.h"
 
 using namespace std;
@@ -63,7 +64,6 @@ const uint64_t SECOND_TO_MICROSECOND = 1000000;
 const uint64_t SECOND_TO_MILLISECOND = 1000;
 const uint64_t MICROSECOND_TO_MILLISECOND = 1000;
 const uint32_t BIT_IN_BYTE = 8;
-const uint16_t GET_MAX_AMPLITUDE_FRAMES_THRESHOLD = 10;
 const unsigned int TIME_OUT_SECONDS = 10;
 }
 
@@ -148,16 +148,7 @@ private:
     struct AudioAdapterDescriptor adapterDesc_ = {};
     struct AudioPort audioPort_ = {};
     struct AudioCallbackService callbackServ = {};
-    bool audioMonoState_ = false;
-    bool audioBalanceState_ = false;
-    float leftBalanceCoef_ = 1.0f;
-    float rightBalanceCoef_ = 1.0f;
-    // for get amplitude
-    float maxAmplitude_ = 0;
-    int64_t lastGetMaxAmplitudeTime_ = 0;
-    int64_t last10FrameStartTime_ = 0;
-    bool startUpdate_ = false;
-    int renderFrameNum_ = 0;
+    SinkPostProcessor postProcessor_;
     bool signalDetected_ = false;
     size_t detectedTime_ = 0;
     bool latencyMeasEnabled_ = false;
@@ -167,9 +158,6 @@ private:
     int32_t CreateRender(const struct AudioPort &renderPort);
     int32_t InitAudioManager();
     AudioFormat ConverToHdiFormat(HdiAdapterFormat format);
-    void AdjustStereoToMono(char *data, uint64_t len);
-    void AdjustAudioBalance(char *data, uint64_t len);
-    void CheckUpdateState(char *frame, uint64_t replyBytes);
     void InitLatencyMeasurement();
     void DeinitLatencyMeasurement();
     void CheckLatencySignal(uint8_t *data, size_t len);
@@ -262,92 +250,12 @@ std::string OffloadAudioRendererSinkInner::GetAudioParameter(const AudioParamKey
 
 void OffloadAudioRendererSinkInner::SetAudioMonoState(bool audioMono)
 {
-    audioMonoState_ = audioMono;
+    postProcessor_.SetAudioMonoState(audioMono);
 }
 
 void OffloadAudioRendererSinkInner::SetAudioBalanceValue(float audioBalance)
 {
-    // reset the balance coefficient value firstly
-    leftBalanceCoef_ = 1.0f;
-    rightBalanceCoef_ = 1.0f;
-
-    if (std::abs(audioBalance - 0.0f) <= std::numeric_limits<float>::epsilon()) {
-        // audioBalance is equal to 0.0f
-        audioBalanceState_ = false;
-    } else {
-        // audioBalance is not equal to 0.0f
-        audioBalanceState_ = true;
-        // calculate the balance coefficient
-        if (audioBalance > 0.0f) {
-            leftBalanceCoef_ -= audioBalance;
-        } else if (audioBalance < 0.0f) {
-            rightBalanceCoef_ += audioBalance;
-        }
-    }
-}
-
-void OffloadAudioRendererSinkInner::AdjustStereoToMono(char *data, uint64_t len)
-{
-    // only stereo is surpported now (stereo channel count is 2)
-    CHECK_AND_RETURN_LOG(attr_.channel == STEREO_CHANNEL_COUNT, "Unspport channel number: %{public}d", attr_.channel);
-
-    switch (attr_.format) {
-        case SAMPLE_U8: {
-            // this function needs to be further tested for usability
-            AdjustStereoToMonoForPCM8Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S16LE: {
-            AdjustStereoToMonoForPCM16Bit(reinterpret_cast<int16_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S24LE: {
-            // this function needs to be further tested for usability
-            AdjustStereoToMonoForPCM24Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S32LE: {
-            AdjustStereoToMonoForPCM32Bit(reinterpret_cast<int32_t *>(data), len);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("Unsupported audio format: %{public}d", attr_.format);
-            break;
-        }
-    }
-}
-
-void OffloadAudioRendererSinkInner::AdjustAudioBalance(char *data, uint64_t len)
-{
-    // only stereo is surpported now (stereo channel count is 2)
-    CHECK_AND_RETURN_LOG(attr_.channel == STEREO_CHANNEL_COUNT, "Unspport channel number: %{public}d", attr_.channel);
-
-    switch (attr_.format) {
-        case SAMPLE_U8: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM8Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S16LE: {
-            AdjustAudioBalanceForPCM16Bit(reinterpret_cast<int16_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S24LE: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM24Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S32LE: {
-            AdjustAudioBalanceForPCM32Bit(reinterpret_cast<int32_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("Unsupported audio format: %{public}d", attr_.format);
-            break;
-        }
-    }
+    postProcessor_.SetAudioBalanceValue(audioBalance);
 }
 
 bool OffloadAudioRendererSinkInner::IsInited()
@@ -638,13 +546,7 @@ int32_t OffloadAudioRendererSinkInner::RenderFrame(char &data, uint64_t len, uin
     int32_t ret;
     CHECK_AND_RETURN_RET_LOG(audioRender_ != nullptr, ERR_INVALID_HANDLE, "Audio Render Handle is nullptr!");
 
-    if (audioMonoState_) {
-        AdjustStereoToMono(&data, len);
-    }
-
-    if (audioBalanceState_) {
-        AdjustAudioBalance(&data, len);
-    }
+    postProcessor_.Process(&data, len, static_cast<AudioSampleFormat>(attr_.format), attr_.channel);
 
     Trace::CountVolume("OffloadAudioRendererSinkInner::RenderFrame", static_cast<uint8_t>(data));
     Trace trace("OffloadSink::RenderFrame");
@@ -657,7 +559,6 @@ int32_t OffloadAudioRendererSinkInner::RenderFrame(char &data, uint64_t len, uin
             Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
                 static_cast<void *>(&data), writeLen);
         }
-        CheckUpdateState(&data, len);
     }
 
 #ifdef FEATURE_POWER_MANAGER
@@ -675,29 +576,9 @@ int32_t OffloadAudioRendererSinkInner::RenderFrame(char &data, uint64_t len, uin
     return SUCCESS;
 }
 
-void OffloadAudioRendererSinkInner::CheckUpdateState(char *frame, uint64_t replyBytes)
-{
-    if (startUpdate_) {
-        if (renderFrameNum_ == 0) {
-            last10FrameStartTime_ = ClockTime::GetCurNano();
-        }
-        renderFrameNum_++;
-        maxAmplitude_ = UpdateMaxAmplitude(static_cast<ConvertHdiFormat>(attr_.format), frame, replyBytes);
-        if (renderFrameNum_ == GET_MAX_AMPLITUDE_FRAMES_THRESHOLD) {
-            renderFrameNum_ = 0;
-            if (last10FrameStartTime_ > lastGetMaxAmplitudeTime_) {
-                startUpdate_ = false;
-                maxAmplitude_ = 0;
-            }
-        }
-    }
-}
-
 float OffloadAudioRendererSinkInner::GetMaxAmplitude()
 {
-    lastGetMaxAmplitudeTime_ = ClockTime::GetCurNano();
-    startUpdate_ = true;
-    return maxAmplitude_;
+    return postProcessor_.GetMaxAmplitude();
 }
 
 int32_t OffloadAudioRendererSinkInner::Start(void)
@@ -44,6 +44,7 @@
 #include "media_monitor_manager.h"
 
 #include "audio_log_utils.h"
+#include "sink_post_processor.h"
 
 using namespace std;
 
@@ -81,11 +82,11 @@ const int64_t SECOND_TO_NANOSECOND = 1000000000;
 static int32_t g_paStatus = 1;
 const double INTREVAL = 3.0;
 
-const uint16_t GET_MAX_AMPLITUDE_FRAMES_THRESHOLD = 10;
 const uint32_t DEVICE_PARAM_MAX_LEN = 40;
 
 const std::string VOIP_HAL_NAME = "voip";
 const std::string DIRECT_HAL_NAME = "direct";
+const std::string DIRECT_MIX_HAL_NAME = "direct_mix"; // direct route owned by the in process mixing engine
 const std::string PRIMARY_HAL_NAME = "primary";
 #ifdef FEATURE_POWER_MANAGER
 const std::string PRIMARY_LOCK_NAME_BASE = "AudioBackgroundPlay";
@@ -226,22 +227,11 @@ private:
     const std::string halName_ = "";
     struct AudioAdapterDescriptor adapterDesc_ = {};
     struct AudioPort audioPort_ = {};
-    bool audioMonoState_ = false;
-    bool audioBalanceState_ = false;
-    float leftBalanceCoef_ = 1.0f;
-    float rightBalanceCoef_ = 1.0f;
-    // for get amplitude
-    float maxAmplitude_ = 0;
-    int64_t lastGetMaxAmplitudeTime_ = 0;
-    int64_t last10FrameStartTime_ = 0;
-    bool startUpdate_ = false;
-    int renderFrameNum_ = 0;
+    SinkPostProcessor postProcessor_;
     bool signalDetected_ = false;
     size_t detectedTime_ = 0;
     bool latencyMeasEnabled_ = false;
     std::shared_ptr<SignalDetectAgent> signalDetectAgent_ = nullptr;
-    mutable int64_t volumeDataCount_ = 0;
-    std::string logUtilsTag_ = "";
     time_t startTime = time(nullptr);
 #ifdef FEATURE_POWER_MANAGER
     std::shared_ptr<AudioRunningLockManager<PowerMgr::RunningLock>> runningLockManager_;
@@ -255,18 +245,14 @@ private:
     int32_t CreateRender(const struct AudioPort &renderPort);
     int32_t InitAudioManager();
     AudioFormat ConvertToHdiFormat(HdiAdapterFormat format);
-    void AdjustStereoToMono(char *data, uint64_t len);
-    void AdjustAudioBalance(char *data, uint64_t len);
     void InitLatencyMeasurement();
     void DeinitLatencyMeasurement();
     void CheckLatencySignal(uint8_t *data, size_t len);
-    void DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const;
 
     int32_t UpdateUsbAttrs(const std::string &usbInfoStr);
     int32_t InitAdapter();
     int32_t InitRender();
     void ReleaseRunningLock();
-    void CheckUpdateState(char *frame, uint64_t replyBytes);
 
     int32_t UpdateDPAttrs(const std::string &usbInfoStr);
     bool AttributesCheck(AudioSampleAttributes &attrInfo);
@@ -302,7 +288,6 @@ AudioRendererSinkInner::AudioRendererSinkInner(const std::string &halName)
 AudioRendererSinkInner::~AudioRendererSinkInner()
 {
     AUDIO_WARNING_LOG("~AudioRendererSinkInner");
-    AUDIO_INFO_LOG("[%{public}s] volume data counts: %{public}" PRId64, logUtilsTag_.c_str(), volumeDataCount_);
 }
 
 AudioRendererSink *AudioRendererSink::GetInstance(std::string halName)
@@ -319,6 +304,9 @@ AudioRendererSink *AudioRendererSink::GetInstance(std::string halName)
     } else if (halName == DIRECT_HAL_NAME) {
         static AudioRendererSinkInner audioRendererDirect(halName);
         return &audioRendererDirect;
+    } else if (halName == DIRECT_MIX_HAL_NAME) {
+        static AudioRendererSinkInner audioRendererDirectMix(halName);
+        return &audioRendererDirectMix;
     }
 
     static AudioRendererSinkInner audioRenderer;
@@ -440,28 +428,12 @@ std::string AudioRendererSinkInner::GetAudioParameter(const AudioParamKey key, c
 
 void AudioRendererSinkInner::SetAudioMonoState(bool audioMono)
 {
-    audioMonoState_ = audioMono;
+    postProcessor_.SetAudioMonoState(audioMono);
 }
 
 void AudioRendererSinkInner::SetAudioBalanceValue(float audioBalance)
 {
-    // reset the balance coefficient value firstly
-    leftBalanceCoef_ = 1.0f;
-    rightBalanceCoef_ = 1.0f;
-
-    if (std::abs(audioBalance - 0.0f) <= std::numeric_limits<float>::epsilon()) {
-        // audioBalance is equal to 0.0f
-        audioBalanceState_ = false;
-    } else {
-        // audioBalance is not equal to 0.0f
-        audioBalanceState_ = true;
-        // calculate the balance coefficient
-        if (audioBalance > 0.0f) {
-            leftBalanceCoef_ -= audioBalance;
-        } else if (audioBalance < 0.0f) {
-            rightBalanceCoef_ += audioBalance;
-        }
-    }
+    postProcessor_.SetAudioBalanceValue(audioBalance);
 }
 
 int32_t AudioRendererSinkInner::GetPresentationPosition(uint64_t& frames, int64_t& timeSec, int64_t& timeNanoSec)
@@ -490,70 +462,6 @@ int32_t AudioRendererSinkInner::GetPresentationPosition(uint64_t& frames, int64_
     return ret;
 }
 
-void AudioRendererSinkInner::AdjustStereoToMono(char *data, uint64_t len)
-{
-    // only stereo is surpported now (stereo channel count is 2)
-    CHECK_AND_RETURN_LOG(attr_.channel == STEREO_CHANNEL_COUNT,
-        "AdjustStereoToMono: Unsupported channel number: %{public}d", attr_.channel);
-
-    switch (attr_.format) {
-        case SAMPLE_U8: {
-            AdjustStereoToMonoForPCM8Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S16: {
-            AdjustStereoToMonoForPCM16Bit(reinterpret_cast<int16_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S24: {
-            AdjustStereoToMonoForPCM24Bit(reinterpret_cast<int8_t *>(data), len);
-            break;
-        }
-        case SAMPLE_S32: {
-            AdjustStereoToMonoForPCM32Bit(reinterpret_cast<int32_t *>(data), len);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("AdjustStereoToMono: Unsupported audio format: %{public}d", attr_.format);
-            break;
-        }
-    }
-}
-
-void AudioRendererSinkInner::AdjustAudioBalance(char *data, uint64_t len)
-{
-    // only stereo is surpported now (stereo channel count is 2)
-    CHECK_AND_RETURN_LOG(attr_.channel == STEREO_CHANNEL_COUNT,
-        "AdjustAudioBalance: Unsupported channel number: %{public}d", attr_.channel);
-
-    switch (attr_.format) {
-        case SAMPLE_U8: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM8Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S16LE: {
-            AdjustAudioBalanceForPCM16Bit(reinterpret_cast<int16_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S24LE: {
-            // this function needs to be further tested for usability
-            AdjustAudioBalanceForPCM24Bit(reinterpret_cast<int8_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        case SAMPLE_S32LE: {
-            AdjustAudioBalanceForPCM32Bit(reinterpret_cast<int32_t *>(data), len, leftBalanceCoef_, rightBalanceCoef_);
-            break;
-        }
-        default: {
-            // if the audio format is unsupported, the audio data will not be changed
-            AUDIO_ERR_LOG("AdjustAudioBalance: Unsupported audio format: %{public}d", attr_.format);
-            break;
-        }
-    }
-}
-
 bool AudioRendererSinkInner::IsInited()
 {
     return sinkInited_;
@@ -680,7 +588,7 @@ int32_t AudioRendererSinkInner::CreateRender(const struct AudioPort &renderPort)
     }
     if (halName_ == "dp") {
         param.type = AUDIO_DP;
-    } else if (halName_ == DIRECT_HAL_NAME) {
+    } else if (halName_ == DIRECT_HAL_NAME || halName_ == DIRECT_MIX_HAL_NAME) {
         param.type = AUDIO_DIRECT;
         param.streamId = DIRECT_OUTPUT_STREAM_ID;
     } else if (halName_ == VOIP_HAL_NAME) {
@@ -746,18 +654,13 @@ int32_t AudioRendererSinkInner::RenderFrame(char &data, uint64_t len, uint64_t &
         AUDIO_WARNING_LOG("AudioRendererSinkInner::RenderFrame invalid state! not started");
     }
 
-    if (audioMonoState_) {AdjustStereoToMono(&data, len);}
-
-    if (audioBalanceState_) {AdjustAudioBalance(&data, len);}
+    postProcessor_.Process(&data, len, static_cast<AudioSampleFormat>(attr_.format), attr_.channel);
 
     DumpFileUtil::WriteDumpFile(dumpFile_, static_cast<void *>(&data), len);
-    BufferDesc buffer = { reinterpret_cast<uint8_t*>(&data), len, len };
-    DfxOperation(buffer, static_cast<AudioSampleFormat>(attr_.format), static_cast<AudioChannel>(attr_.channel));
     if (AudioDump::GetInstance().GetVersionType() == BETA_VERSION) {
         Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
             static_cast<void *>(&data), len);
     }
-    CheckUpdateState(&data, len);
 
     if (renderEmptyFrameCount_ > 0) {
         Trace traceEmpty("AudioRendererSinkInner::RenderFrame::renderEmpty");
@@ -791,40 +694,9 @@ int32_t AudioRendererSinkInner::RenderFrame(char &data, uint64_t len, uint64_t &
     return SUCCESS;
 }
 
-void AudioRendererSinkInner::DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const
-{
-    ChannelVolumes vols = VolumeTools::CountVolumeLevel(buffer, format, channel);
-    if (channel == MONO) {
-        Trace::Count(logUtilsTag_, vols.volStart[0]);
-    } else {
-        Trace::Count(logUtilsTag_, (vols.volStart[0] + vols.volStart[1]) / HALF_FACTOR);
-    }
-    AudioLogUtils::ProcessVolumeData(logUtilsTag_, vols, volumeDataCount_);
-}
-
-void AudioRendererSinkInner::CheckUpdateState(char *frame, uint64_t replyBytes)
-{
-    if (startUpdate_) {
-        if (renderFrameNum_ == 0) {
-            last10FrameStartTime_ = ClockTime::GetCurNano();
-        }
-        renderFrameNum_++;
-        maxAmplitude_ = UpdateMaxAmplitude(static_cast<ConvertHdiFormat>(attr_.format), frame, replyBytes);
-        if (renderFrameNum_ == GET_MAX_AMPLITUDE_FRAMES_THRESHOLD) {
-            renderFrameNum_ = 0;
-            if (last10FrameStartTime_ > lastGetMaxAmplitudeTime_) {
-                startUpdate_ = false;
-                maxAmplitude_ = 0;
-            }
-        }
-    }
-}
-
 float AudioRendererSinkInner::GetMaxAmplitude()
 {
-    lastGetMaxAmplitudeTime_ = ClockTime::GetCurNano();
-    startUpdate_ = true;
-    return maxAmplitude_;
+    return postProcessor_.GetMaxAmplitude();
 }
 
 int32_t AudioRendererSinkInner::Start(void)
@@ -854,7 +726,7 @@ int32_t AudioRendererSinkInner::Start(void)
     dumpFileName_ = halName_ + "_audiosink_" + GetTime() + "_" + std::to_string(attr_.sampleRate) + "_"
         + std::to_string(attr_.channel) + "_" + std::to_string(attr_.format) + ".pcm";
     DumpFileUtil::OpenDumpFile(DUMP_SERVER_PARA, dumpFileName_, &dumpFile_);
-    logUtilsTag_ = "AudioSink";
+    postProcessor_.SetLogUtilsTag("AudioSink");
 
     InitLatencyMeasurement();
     if (!started_) {
@@ -1127,7 +999,7 @@ int32_t AudioRendererSinkInner::SetAudioScene(AudioScene audioScene, std::vector
         if (audioScene != currentAudioScene_) {
             struct AudioSceneDescriptor scene;
             scene.scene.id = GetAudioCategory(audioScene);
-            if (halName_ == DIRECT_HAL_NAME) {
+            if (halName_ == DIRECT_HAL_NAME || halName_ == DIRECT_MIX_HAL_NAME) {
                 scene.scene.id = AUDIO_DIRECT;
             } else if (halName_ == VOIP_HAL_NAME) {
                 scene.scene.id = AUDIO_IN_COMMUNICATION;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bluetooth_render_writer_unit_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "audio_errors.h"
+#include "bluetooth_render_writer.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr int32_t HDI_BUSY = -4;
+constexpr uint32_t RETRY_INTERVAL_US = 1000;
+// 48k stereo s16
+constexpr uint64_t BYTES_PER_SECOND = 192000;
+// 20ms
+constexpr uint64_t FRAME_LEN = 3840;
+constexpr int32_t WAIT_TIMEOUT_MS = 2000;
+
+// Simulates a congested a2dp link: the first busyCount writes are refused with the busy code.
+class FakeBluetoothHdi {
+public:
+    int32_t RenderFrame(char *data, uint64_t len, uint64_t &writeLen)
+    {
+        if (alwaysBusy_.load() || busyCount_.load() > 0) {
+            busyCount_--;
+            writeLen = 0;
+            return HDI_BUSY;
+        }
+        writeLen = len;
+        writtenBytes_ += len;
+        return SUCCESS;
+    }
+
+    BluetoothRenderWriter::WriteFunc GetWriteFunc()
+    {
+        return [this](char *data, uint64_t len, uint64_t &writeLen) { return RenderFrame(data, len, writeLen); };
+    }
+
+    atomic<int32_t> busyCount_ = 0;
+    atomic<bool> alwaysBusy_ = false;
+    atomic<uint64_t> writtenBytes_ = 0;
+};
+
+bool WaitUntil(const function<bool()> &condition)
+{
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(WAIT_TIMEOUT_MS);
+    while (!condition()) {
+        if (chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return true;
+}
+} // namespace
+
+void BluetoothRenderWriterUnitTest::SetUpTestCase(void) {}
+void BluetoothRenderWriterUnitTest::TearDownTestCase(void) {}
+void BluetoothRenderWriterUnitTest::SetUp(void) {}
+void BluetoothRenderWriterUnitTest::TearDown(void) {}
+
+/**
+ * @tc.name  : Test BluetoothRenderWriter
+ * @tc.number: BluetoothRenderWriter_001
+ * @tc.desc  : Test Enqueue before Start and Start with invalid param
+ */
+HWTEST_F(BluetoothRenderWriterUnitTest, BluetoothRenderWriter_001, TestSize.Level1)
+{
+    FakeBluetoothHdi hdi;
+    BluetoothRenderWriter writer(hdi.GetWriteFunc(), HDI_BUSY, RETRY_INTERVAL_US);
+    vector<char> frame(FRAME_LEN, 1);
+
+    EXPECT_EQ(ERR_ILLEGAL_STATE, writer.Enqueue(frame.data(), frame.size()));
+    EXPECT_EQ(ERR_INVALID_PARAM, writer.Start(0));
+    EXPECT_FALSE(writer.IsRunning());
+
+    EXPECT_EQ(SUCCESS, writer.Start(BYTES_PER_SECOND));
+    EXPECT_TRUE(writer.IsRunning());
+    EXPECT_EQ(ERR_INVALID_PARAM, writer.Enqueue(nullptr, FRAME_LEN));
+    writer.Stop();
+    EXPECT_FALSE(writer.IsRunning());
+}
+
+/**
+ * @tc.name  : Test BluetoothRenderWriter
+ * @tc.number: BluetoothRenderWriter_002
+ * @tc.desc  : Test frames are written in order once a congestion clears and the target depth grows
+ */
+HWTEST_F(BluetoothRenderWriterUnitTest, BluetoothRenderWriter_002, TestSize.Level1)
+{
+    const int32_t busyCount = 5;
+    const uint32_t frameCount = 4;
+    FakeBluetoothHdi hdi;
+    hdi.busyCount_ = busyCount;
+    vector<char> written;
+    BluetoothRenderWriter writer([&hdi, &written](char *data, uint64_t len, uint64_t &writeLen) {
+        int32_t ret = hdi.RenderFrame(data, len, writeLen);
+        if (ret == SUCCESS) {
+            written.push_back(data[0]);
+        }
+        return ret;
+    }, HDI_BUSY, RETRY_INTERVAL_US);
+    ASSERT_EQ(SUCCESS, writer.Start(BYTES_PER_SECOND));
+    uint32_t initialTargetDepth = writer.GetStats().targetDepth;
+
+    for (uint32_t i = 0; i < frameCount; i++) {
+        vector<char> frame(FRAME_LEN, static_cast<char>(i));
+        EXPECT_EQ(SUCCESS, writer.Enqueue(frame.data(), frame.size()));
+    }
+    EXPECT_TRUE(WaitUntil([&writer, frameCount] { return writer.GetStats().writtenFrames == frameCount; }));
+    writer.Stop();
+
+    BluetoothRenderWriterStats stats = writer.GetStats();
+    EXPECT_EQ(static_cast<uint64_t>(busyCount), stats.retryCount);
+    EXPECT_EQ(0u, stats.droppedFrames);
+    EXPECT_GT(stats.targetDepth, initialTargetDepth);
+    EXPECT_EQ(FRAME_LEN * frameCount, hdi.writtenBytes_.load());
+    ASSERT_EQ(frameCount, written.size());
+    for (uint32_t i = 0; i < frameCount; i++) {
+        EXPECT_EQ(static_cast<char>(i), written[i]);
+    }
+}
+
+/**
+ * @tc.name  : Test BluetoothRenderWriter
+ * @tc.number: BluetoothRenderWriter_003
+ * @tc.desc  : Test a frame is dropped when the link stays congested and the ring is full
+ */
+HWTEST_F(BluetoothRenderWriterUnitTest, BluetoothRenderWriter_003, TestSize.Level1)
+{
+    FakeBluetoothHdi hdi;
+    hdi.alwaysBusy_ = true;
+    BluetoothRenderWriter writer(hdi.GetWriteFunc(), HDI_BUSY, RETRY_INTERVAL_US);
+    ASSERT_EQ(SUCCESS, writer.Start(BYTES_PER_SECOND));
+
+    vector<char> frame(FRAME_LEN, 1);
+    for (uint32_t i = 0; i < BT_WRITER_RING_CAPACITY; i++) {
+        EXPECT_EQ(SUCCESS, writer.Enqueue(frame.data(), frame.size()));
+    }
+    EXPECT_EQ(ERR_WRITE_FAILED, writer.Enqueue(frame.data(), frame.size()));
+
+    BluetoothRenderWriterStats stats = writer.GetStats();
+    EXPECT_EQ(1u, stats.droppedFrames);
+    EXPECT_EQ(BT_WRITER_RING_CAPACITY, stats.queueDepth);
+    // every queued frame is counted in the latency
+    EXPECT_EQ(FRAME_LEN * BT_WRITER_RING_CAPACITY * 1000 / BYTES_PER_SECOND, writer.GetQueuedLatencyMs());
+    writer.Stop();
+    EXPECT_EQ(0u, writer.GetQueuedLatencyMs());
+}
+
+/**
+ * @tc.name  : Test BluetoothRenderWriter
+ * @tc.number: BluetoothRenderWriter_004
+ * @tc.desc  : Test Flush drops the queued frames of a congested link
+ */
+HWTEST_F(BluetoothRenderWriterUnitTest, BluetoothRenderWriter_004, TestSize.Level1)
+{
+    const uint32_t frameCount = 3;
+    FakeBluetoothHdi hdi;
+    hdi.alwaysBusy_ = true;
+    BluetoothRenderWriter writer(hdi.GetWriteFunc(), HDI_BUSY, RETRY_INTERVAL_US);
+    ASSERT_EQ(SUCCESS, writer.Start(BYTES_PER_SECOND));
+
+    vector<char> frame(FRAME_LEN, 1);
+    for (uint32_t i = 0; i < frameCount; i++) {
+        EXPECT_EQ(SUCCESS, writer.Enqueue(frame.data(), frame.size()));
+    }
+    EXPECT_TRUE(WaitUntil([&writer] { return writer.GetStats().retryCount > 0; }));
+
+    writer.Flush();
+    EXPECT_TRUE(WaitUntil([&writer] { return writer.GetStats().queueDepth == 0; }));
+    EXPECT_EQ(0u, writer.GetQueuedLatencyMs());
+    EXPECT_EQ(0u, writer.GetStats().writtenFrames);
+
+    hdi.alwaysBusy_ = false;
+    for (uint32_t i = 0; i < frameCount; i++) {
+        EXPECT_EQ(SUCCESS, writer.Enqueue(frame.data(), frame.size()));
+    }
+    EXPECT_TRUE(WaitUntil([&writer, frameCount] { return writer.GetStats().writtenFrames == frameCount; }));
+    writer.Stop();
+}
+
+/**
+ * @tc.name  : Test BluetoothRenderWriter
+ * @tc.number: BluetoothRenderWriter_005
+ * @tc.desc  : Test Pause holds the queued frames back, also in the middle of a congestion, until Resume
+ */
+HWTEST_F(BluetoothRenderWriterUnitTest, BluetoothRenderWriter_005, TestSize.Level1)
+{
+    const uint32_t frameCount = 3;
+    const int32_t holdTimeMs = 50;
+    FakeBluetoothHdi hdi;
+    BluetoothRenderWriter writer(hdi.GetWriteFunc(), HDI_BUSY, RETRY_INTERVAL_US);
+    ASSERT_EQ(SUCCESS, writer.Start(BYTES_PER_SECOND));
+
+    writer.Pause();
+    vector<char> frame(FRAME_LEN, 1);
+    for (uint32_t i = 0; i < frameCount; i++) {
+        EXPECT_EQ(SUCCESS, writer.Enqueue(frame.data(), frame.size()));
+    }
+    this_thread::sleep_for(chrono::milliseconds(holdTimeMs));
+    EXPECT_EQ(0u, writer.GetStats().writtenFrames);
+    EXPECT_EQ(frameCount, writer.GetStats().queueDepth);
+
+    writer.Resume();
+    EXPECT_TRUE(WaitUntil([&writer, frameCount] { return writer.GetStats().writtenFrames == frameCount; }));
+
+    hdi.alwaysBusy_ = true;
+    for (uint32_t i = 0; i < frameCount; i++) {
+        EXPECT_EQ(SUCCESS, writer.Enqueue(frame.data(), frame.size()));
+    }
+    EXPECT_TRUE(WaitUntil([&writer] { return writer.GetStats().retryCount > 0; }));
+    writer.Pause();
+    hdi.alwaysBusy_ = false;
+    this_thread::sleep_for(chrono::milliseconds(holdTimeMs));
+    EXPECT_EQ(frameCount, writer.GetStats().writtenFrames);
+
+    writer.Resume();
+    EXPECT_TRUE(WaitUntil([&writer, frameCount] { return writer.GetStats().writtenFrames == frameCount * 2; }));
+    EXPECT_EQ(FRAME_LEN * frameCount * 2, hdi.writtenBytes_.load());
+    writer.Stop();
+}
+} // namespace AudioStandard
+} // namespace OHOS
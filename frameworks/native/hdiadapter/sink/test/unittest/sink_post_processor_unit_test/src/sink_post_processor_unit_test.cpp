@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sink_post_processor_unit_test.h"
+
+#include <climits>
+#include <vector>
+
+#include "audio_utils.h"
+#include "sink_post_processor.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr float BALANCE_LEFT = -0.5f;
+constexpr float BALANCE_RIGHT = 0.5f;
+constexpr float AMPLITUDE_EPS = 1e-6f;
+
+template <typename T>
+void Process(SinkPostProcessor &processor, vector<T> &data, AudioSampleFormat format, uint32_t channel = STEREO)
+{
+    processor.Process(reinterpret_cast<char *>(data.data()), data.size() * sizeof(T), format, channel);
+}
+} // namespace
+
+void SinkPostProcessorUnitTest::SetUpTestCase(void) {}
+void SinkPostProcessorUnitTest::TearDownTestCase(void) {}
+void SinkPostProcessorUnitTest::SetUp(void) {}
+void SinkPostProcessorUnitTest::TearDown(void) {}
+
+/**
+ * @tc.name  : Test SinkPostProcessor Process
+ * @tc.number: SinkPostProcessor_001
+ * @tc.desc  : Test stereo to mono for s16 and s32, and data of other channel counts is kept
+ */
+HWTEST_F(SinkPostProcessorUnitTest, SinkPostProcessor_001, TestSize.Level1)
+{
+    SinkPostProcessor processor;
+    processor.SetAudioMonoState(true);
+
+    vector<int16_t> s16 = { 1000, 3000, -2000, 4000 };
+    Process(processor, s16, SAMPLE_S16LE);
+    EXPECT_EQ(s16, (vector<int16_t>{ 2000, 2000, 1000, 1000 }));
+
+    vector<int32_t> s32 = { 100000, 300000, SHRT_MAX * 2, 0 };
+    Process(processor, s32, SAMPLE_S32LE);
+    EXPECT_EQ(s32, (vector<int32_t>{ 200000, 200000, SHRT_MAX, SHRT_MAX }));
+
+    vector<int16_t> mono = { 1000, 3000 };
+    Process(processor, mono, SAMPLE_S16LE, MONO);
+    EXPECT_EQ(mono, (vector<int16_t>{ 1000, 3000 }));
+
+    processor.SetAudioMonoState(false);
+    vector<int16_t> kept = { 1000, 3000 };
+    Process(processor, kept, SAMPLE_S16LE);
+    EXPECT_EQ(kept, (vector<int16_t>{ 1000, 3000 }));
+}
+
+/**
+ * @tc.name  : Test SinkPostProcessor Process
+ * @tc.number: SinkPostProcessor_002
+ * @tc.desc  : Test audio balance to each side for s16 and s32, and mono before balance
+ */
+HWTEST_F(SinkPostProcessorUnitTest, SinkPostProcessor_002, TestSize.Level1)
+{
+    SinkPostProcessor processor;
+    processor.SetAudioBalanceValue(BALANCE_RIGHT);
+    vector<int16_t> s16 = { 1000, 1000, -2000, -2000 };
+    Process(processor, s16, SAMPLE_S16LE);
+    EXPECT_EQ(s16, (vector<int16_t>{ 500, 1000, -1000, -2000 }));
+
+    processor.SetAudioBalanceValue(BALANCE_LEFT);
+    vector<int32_t> s32 = { 200000, 200000 };
+    Process(processor, s32, SAMPLE_S32LE);
+    EXPECT_EQ(s32, (vector<int32_t>{ 200000, 100000 }));
+
+    processor.SetAudioMonoState(true);
+    vector<int16_t> monoBalance = { 1000, 3000 };
+    Process(processor, monoBalance, SAMPLE_S16LE);
+    EXPECT_EQ(monoBalance, (vector<int16_t>{ 2000, 1000 }));
+
+    processor.SetAudioMonoState(false);
+    processor.SetAudioBalanceValue(0.0f);
+    vector<int32_t> kept = { 200000, 200000 };
+    Process(processor, kept, SAMPLE_S32LE);
+    EXPECT_EQ(kept, (vector<int32_t>{ 200000, 200000 }));
+}
+
+/**
+ * @tc.name  : Test SinkPostProcessor GetMaxAmplitude
+ * @tc.number: SinkPostProcessor_003
+ * @tc.desc  : Test the peak for s16 and s32 equals the one of UpdateMaxAmplitude, after the adjustment
+ */
+HWTEST_F(SinkPostProcessorUnitTest, SinkPostProcessor_003, TestSize.Level1)
+{
+    SinkPostProcessor processor;
+    vector<int16_t> s16 = { 1000, -12000, 3000, 500 };
+    Process(processor, s16, SAMPLE_S16LE);
+    // counted only after the first query
+    EXPECT_FLOAT_EQ(0.0f, processor.GetMaxAmplitude());
+
+    vector<int16_t> expected16 = s16;
+    Process(processor, s16, SAMPLE_S16LE);
+    EXPECT_NEAR(UpdateMaxAmplitude(SAMPLE_S16_C, reinterpret_cast<char *>(expected16.data()),
+        expected16.size() * sizeof(int16_t)), processor.GetMaxAmplitude(), AMPLITUDE_EPS);
+
+    vector<int32_t> s32 = { 100000, -INT_MAX, 3000, 500 };
+    vector<int32_t> expected32 = s32;
+    Process(processor, s32, SAMPLE_S32LE);
+    EXPECT_NEAR(UpdateMaxAmplitude(SAMPLE_S32_C, reinterpret_cast<char *>(expected32.data()),
+        expected32.size() * sizeof(int32_t)), processor.GetMaxAmplitude(), AMPLITUDE_EPS);
+
+    // the peak is taken after mono
+    processor.SetAudioMonoState(true);
+    vector<int16_t> mono = { 0, -12000 };
+    Process(processor, mono, SAMPLE_S16LE);
+    EXPECT_NEAR(6000.0f / SHRT_MAX, processor.GetMaxAmplitude(), AMPLITUDE_EPS);
+}
+
+/**
+ * @tc.name  : Test SinkPostProcessor Process
+ * @tc.number: SinkPostProcessor_004
+ * @tc.desc  : Test data of an unsupported format is kept and has no amplitude
+ */
+HWTEST_F(SinkPostProcessorUnitTest, SinkPostProcessor_004, TestSize.Level1)
+{
+    SinkPostProcessor processor;
+    processor.SetAudioMonoState(true);
+    processor.GetMaxAmplitude();
+    vector<float> f32 = { 0.5f, -0.25f };
+    for (int32_t i = 0; i < 2; i++) { // 2 blocks, only the first one is logged
+        Process(processor, f32, SAMPLE_F32LE);
+    }
+    EXPECT_EQ(f32, (vector<float>{ 0.5f, -0.25f }));
+    EXPECT_EQ(SAMPLE_F32LE, processor.unsupportedFormat_);
+    EXPECT_FLOAT_EQ(0.0f, processor.GetMaxAmplitude());
+
+    processor.Process(nullptr, 0, SAMPLE_S16LE, STEREO);
+}
+} // namespace AudioStandard
+} // namespace OHOS
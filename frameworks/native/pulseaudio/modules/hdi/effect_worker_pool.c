@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "EffectWorkerPool"
+#endif
+
+#include <config.h>
+#include <pulse/xmalloc.h>
+#include <pulsecore/atomic.h>
+#include <pulsecore/semaphore.h>
+#include <pulsecore/thread.h>
+
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "audio_hdi_log.h"
+#include "audio_schedule.h"
+#include "audio_utils_c.h"
+#include "effect_worker_pool.h"
+
+#define EFFECT_WORKER_NUM_MAX 3
+#define EFFECT_LANE_NUM_MAX (EFFECT_WORKER_NUM_MAX + 1)
+
+typedef struct EffectJob {
+    char *sceneType;
+    uint64_t chainId;
+    uint32_t lane;
+    BufferAttr bufferAttr;
+} EffectJob;
+
+typedef struct EffectWorker {
+    EffectWorkerPool *pool;
+    uint32_t lane;
+    pa_thread *thread;
+    pa_semaphore *start;
+    pa_semaphore *done;
+} EffectWorker;
+
+struct EffectWorkerPool {
+    EffectJob *jobs;
+    uint32_t jobNum;
+    uint32_t jobNumMax;
+    size_t bufferSize;
+    EffectWorker workers[EFFECT_WORKER_NUM_MAX];
+    uint32_t workerNum;
+    pa_atomic_t quit;
+};
+
+static void ProcessLane(EffectWorkerPool *pool, uint32_t lane)
+{
+    for (uint32_t i = 0; i < pool->jobNum; i++) {
+        EffectJob *job = &pool->jobs[i];
+        if (job->lane != lane) {
+            continue;
+        }
+        AUTO_CTRACE("hdi_sink::EffectChainManagerProcess:%s", job->sceneType);
+        EffectChainManagerProcess(job->sceneType, &job->bufferAttr);
+    }
+}
+
+static void ThreadFuncEffectWorker(void *userdata)
+{
+    // set audio thread priority, the same as the sink threads it works for
+    ScheduleThreadInServer(getpid(), gettid());
+
+    EffectWorker *worker = (EffectWorker *)userdata;
+    pa_assert(worker);
+
+    while (true) {
+        pa_semaphore_wait(worker->start);
+        if (pa_atomic_load(&worker->pool->quit) == 1) {
+            break;
+        }
+        ProcessLane(worker->pool, worker->lane);
+        pa_semaphore_post(worker->done);
+    }
+    UnscheduleThreadInServer(getpid(), gettid());
+}
+
+static uint32_t GetWorkerNum(uint32_t jobNumMax)
+{
+    long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpuNum <= 1 || jobNumMax <= 1) {
+        return 0;
+    }
+    uint32_t workerNum = (uint32_t)(cpuNum - 1);
+    workerNum = workerNum > EFFECT_WORKER_NUM_MAX ? EFFECT_WORKER_NUM_MAX : workerNum;
+    return workerNum > jobNumMax - 1 ? jobNumMax - 1 : workerNum;
+}
+
+EffectWorkerPool *EffectWorkerPoolNew(uint32_t jobNumMax, size_t bufferSize, const BufferAttr *bufferAttr)
+{
+    CHECK_AND_RETURN_RET_LOG(bufferAttr != NULL, NULL, "bufferAttr is null");
+    uint32_t workerNum = GetWorkerNum(jobNumMax);
+    if (workerNum == 0) {
+        AUDIO_INFO_LOG("no spare cpu core, scene effects are processed serially");
+        return NULL;
+    }
+
+    EffectWorkerPool *pool = pa_xnew0(EffectWorkerPool, 1);
+    pool->jobs = pa_xnew0(EffectJob, jobNumMax);
+    pool->jobNumMax = jobNumMax;
+    pool->bufferSize = bufferSize;
+    pa_atomic_store(&pool->quit, 0);
+    for (uint32_t i = 0; i < jobNumMax; i++) {
+        pool->jobs[i].bufferAttr = *bufferAttr;
+        pool->jobs[i].bufferAttr.bufIn = NULL;
+        pool->jobs[i].bufferAttr.bufOut = NULL;
+        pool->jobs[i].bufferAttr.tempBufIn = NULL;
+        pool->jobs[i].bufferAttr.tempBufOut = NULL;
+    }
+
+    for (uint32_t i = 0; i < workerNum; i++) {
+        EffectWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->lane = i + 1; // lane 0 is taken by the sink io thread
+        worker->start = pa_semaphore_new(0);
+        worker->done = pa_semaphore_new(0);
+        if (!(worker->thread = pa_thread_new("OS_EffectWorker", ThreadFuncEffectWorker, worker))) {
+            AUDIO_ERR_LOG("Failed to create effect worker %{public}u", i);
+            pa_semaphore_free(worker->start);
+            pa_semaphore_free(worker->done);
+            break;
+        }
+        pool->workerNum++;
+    }
+    if (pool->workerNum == 0) {
+        EffectWorkerPoolFree(pool);
+        return NULL;
+    }
+    AUDIO_INFO_LOG("effect worker pool created, worker num: %{public}u", pool->workerNum);
+    return pool;
+}
+
+void EffectWorkerPoolFree(EffectWorkerPool *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    pa_atomic_store(&pool->quit, 1);
+    for (uint32_t i = 0; i < pool->workerNum; i++) {
+        EffectWorker *worker = &pool->workers[i];
+        pa_semaphore_post(worker->start);
+        pa_thread_free(worker->thread);
+        pa_semaphore_free(worker->start);
+        pa_semaphore_free(worker->done);
+    }
+    for (uint32_t i = 0; i < pool->jobNumMax; i++) {
+        pa_xfree(pool->jobs[i].bufferAttr.bufIn);
+        pa_xfree(pool->jobs[i].bufferAttr.bufOut);
+    }
+    pa_xfree(pool->jobs);
+    pa_xfree(pool);
+}
+
+BufferAttr *EffectWorkerPoolAddJob(EffectWorkerPool *pool, char *sceneType)
+{
+    CHECK_AND_RETURN_RET_LOG(pool != NULL && pool->jobNum < pool->jobNumMax, NULL, "no free effect job");
+    EffectJob *job = &pool->jobs[pool->jobNum];
+    // buffers are allocated on the first use of a job, so only as many as the concurrent scenes are kept
+    if (job->bufferAttr.bufIn == NULL) {
+        job->bufferAttr.bufIn = (float *)pa_xmalloc0(pool->bufferSize);
+        job->bufferAttr.bufOut = (float *)pa_xmalloc0(pool->bufferSize);
+    }
+    job->sceneType = sceneType;
+    job->chainId = EffectChainManagerGetChainId(sceneType);
+    job->lane = 0;
+    pool->jobNum++;
+    return &job->bufferAttr;
+}
+
+// Jobs on one effect chain stay in one lane, so a shared chain sees its scenes in order and never concurrently.
+static void AssignLanes(EffectWorkerPool *pool, bool *laneUsed)
+{
+    uint32_t laneNum = pool->workerNum + 1;
+    uint32_t nextLane = 0;
+    for (uint32_t i = 0; i < pool->jobNum; i++) {
+        EffectJob *job = &pool->jobs[i];
+        bool isShared = false;
+        for (uint32_t j = 0; j < i && job->chainId != 0; j++) {
+            if (pool->jobs[j].chainId == job->chainId) {
+                job->lane = pool->jobs[j].lane;
+                isShared = true;
+                break;
+            }
+        }
+        if (!isShared) {
+            job->lane = nextLane;
+            nextLane = (nextLane + 1) % laneNum;
+        }
+        laneUsed[job->lane] = true;
+    }
+}
+
+void EffectWorkerPoolRun(EffectWorkerPool *pool)
+{
+    CHECK_AND_RETURN_LOG(pool != NULL, "pool is null");
+    if (pool->jobNum == 0) {
+        return;
+    }
+    AUTO_CTRACE("hdi_sink::EffectWorkerPoolRun:%u", pool->jobNum);
+    bool laneUsed[EFFECT_LANE_NUM_MAX] = {false};
+    AssignLanes(pool, laneUsed);
+    for (uint32_t i = 0; i < pool->workerNum; i++) {
+        if (laneUsed[pool->workers[i].lane]) {
+            pa_semaphore_post(pool->workers[i].start);
+        }
+    }
+    ProcessLane(pool, 0);
+    // join every worker before the results are mixed
+    for (uint32_t i = 0; i < pool->workerNum; i++) {
+        if (laneUsed[pool->workers[i].lane]) {
+            pa_semaphore_wait(pool->workers[i].done);
+        }
+    }
+}
+
+uint32_t EffectWorkerPoolGetJobNum(const EffectWorkerPool *pool)
+{
+    return pool == NULL ? 0 : pool->jobNum;
+}
+
+const BufferAttr *EffectWorkerPoolGetJobResult(const EffectWorkerPool *pool, uint32_t index)
+{
+    CHECK_AND_RETURN_RET_LOG(pool != NULL && index < pool->jobNum, NULL, "invalid job index %{public}u", index);
+    return &pool->jobs[index].bufferAttr;
+}
+
+void EffectWorkerPoolClearJobs(EffectWorkerPool *pool)
+{
+    if (pool != NULL) {
+        pool->jobNum = 0;
+    }
+}
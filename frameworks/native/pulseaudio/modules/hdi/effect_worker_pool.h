@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EFFECT_WORKER_POOL_H
+#define EFFECT_WORKER_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "audio_effect_chain_adapter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Applies the effect chains of independent scenes concurrently within one sink period. Jobs are added and
+// collected by the sink io thread only, which also takes its share of the jobs while the workers run.
+typedef struct EffectWorkerPool EffectWorkerPool;
+
+// Returns NULL if there is no spare cpu core, the sink keeps processing scenes serially in that case.
+EffectWorkerPool *EffectWorkerPoolNew(uint32_t jobNumMax, size_t bufferSize, const BufferAttr *bufferAttr);
+void EffectWorkerPoolFree(EffectWorkerPool *pool);
+
+// Returns the buffer attr of the new job, the caller fills bufIn, numChanIn and frameLen. NULL if the pool is full.
+BufferAttr *EffectWorkerPoolAddJob(EffectWorkerPool *pool, char *sceneType);
+
+// Blocks until the effect chains of all jobs are applied.
+void EffectWorkerPoolRun(EffectWorkerPool *pool);
+
+// Results are kept in the order the jobs were added, so the final mix does not depend on the scheduling.
+uint32_t EffectWorkerPoolGetJobNum(const EffectWorkerPool *pool);
+const BufferAttr *EffectWorkerPoolGetJobResult(const EffectWorkerPool *pool, uint32_t index);
+void EffectWorkerPoolClearJobs(EffectWorkerPool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EFFECT_WORKER_POOL_H
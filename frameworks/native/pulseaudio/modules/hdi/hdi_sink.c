@@ -49,6 +49,7 @@
 #include "audio_utils_c.h"
 #include "audio_hdiadapter_info.h"
 #include "volume_tools_c.h"
+#include "format_converter_c.h"
 #include "renderer_sink_adapter.h"
 #include "audio_effect_chain_adapter.h"
 #include "playback_capturer_adapter.h"
@@ -174,86 +175,22 @@ static void StartMultiChannelHdiIfRunning(struct Userdata *u);
 static void CheckInputChangeToOffload(struct Userdata *u, pa_sink_input *i);
 
 // BEGIN Utility functions
-#define FLOAT_EPS 1e-9f
 #define MEMBLOCKQ_MAXLENGTH (16*1024*16)
-#define OFFSET_BIT_24 3
-#define BIT_DEPTH_TWO 2
-#define BIT_8 8
-#define BIT_16 16
-#define BIT_24 24
-#define BIT_32 32
-static uint32_t Read24Bit(const uint8_t *p)
-{
-    return ((uint32_t) p[BIT_DEPTH_TWO] << BIT_16) | ((uint32_t) p[1] << BIT_8) | ((uint32_t) p[0]);
-}
-
-static void Write24Bit(uint8_t *p, uint32_t u)
-{
-    p[BIT_DEPTH_TWO] = (uint8_t) (u >> BIT_16);
-    p[1] = (uint8_t) (u >> BIT_8);
-    p[0] = (uint8_t) u;
-}
 
-static void ConvertFrom16BitToFloat(unsigned n, const int16_t *a, float *b)
+// Same values as AudioSampleFormat, the sink data that is not integer pcm is float.
+static uint32_t GetConvertFormat(pa_sample_format_t format)
 {
-    for (; n > 0; n--) {
-        *(b++) = *(a++) * (1.0f / (1 << (BIT_16 - 1)));
-    }
-}
-
-static void ConvertFrom24BitToFloat(unsigned n, const uint8_t *a, float *b)
-{
-    for (; n > 0; n--) {
-        int32_t s = Read24Bit(a) << BIT_8;
-        *b = s * (1.0f / (1U << (BIT_32 - 1)));
-        a += OFFSET_BIT_24;
-        b++;
-    }
-}
-
-static void ConvertFrom32BitToFloat(unsigned n, const int32_t *a, float *b)
-{
-    for (; n > 0; n--) {
-        *(b++) = *(a++) * (1.0f / (1U << (BIT_32 - 1)));
-    }
-}
-
-static float CapMax(float v)
-{
-    float value = v;
-    if (v > 1.0f) {
-        value = 1.0f - FLOAT_EPS;
-    } else if (v < -1.0f) {
-        value = -1.0f + FLOAT_EPS;
-    }
-    return value;
-}
-
-static void ConvertFromFloatTo16Bit(unsigned n, const float *a, int16_t *b)
-{
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1 << (BIT_16 - 1));
-        *(b++) = (int16_t) v;
-    }
-}
-
-static void ConvertFromFloatTo24Bit(unsigned n, const float *a, uint8_t *b)
-{
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1U << (BIT_32 - 1));
-        Write24Bit(b, ((int32_t) v) >> BIT_8);
-        b += OFFSET_BIT_24;
-    }
-}
-
-static void ConvertFromFloatTo32Bit(unsigned n, const float *a, int32_t *b)
-{
-    for (; n > 0; n--) {
-        float tmp = *a++;
-        float v = CapMax(tmp) * (1U << (BIT_32 - 1));
-        *(b++) = (int32_t) v;
+    switch (format) {
+        case PA_SAMPLE_U8:
+            return SAMPLE_U8;
+        case PA_SAMPLE_S16LE:
+            return SAMPLE_S16;
+        case PA_SAMPLE_S24LE:
+            return SAMPLE_S24;
+        case PA_SAMPLE_S32LE:
+            return SAMPLE_S32;
+        default:
+            return SAMPLE_F32;
     }
 }
 
@@ -261,26 +198,9 @@ static void ConvertToFloat(pa_sample_format_t format, unsigned n, void *src, flo
 {
     pa_assert(src);
     pa_assert(dst);
-    int32_t ret;
-    switch (format) {
-        case PA_SAMPLE_S16LE:
-            ConvertFrom16BitToFloat(n, src, dst);
-            break;
-        case PA_SAMPLE_S24LE:
-            ConvertFrom24BitToFloat(n, src, dst);
-            break;
-        case PA_SAMPLE_S32LE:
-            ConvertFrom32BitToFloat(n, src, dst);
-            break;
-        default:
-            ret = memcpy_s(dst, n, src, n);
-            if (ret != 0) {
-                float *srcFloat = (float *)src;
-                for (uint32_t i = 0; i < n; i++) {
-                    dst[i] = srcFloat[i];
-                }
-            }
-            break;
+    int32_t ret = ConvertToFloatC(GetConvertFormat(format), n, src, dst);
+    if (ret != 0) {
+        AUDIO_ERR_LOG("ConvertToFloatC failed: %{public}d", ret);
     }
 }
 
@@ -288,26 +208,9 @@ static void ConvertFromFloat(pa_sample_format_t format, unsigned n, float *src,
 {
     pa_assert(src);
     pa_assert(dst);
-    int32_t ret;
-    switch (format) {
-        case PA_SAMPLE_S16LE:
-            ConvertFromFloatTo16Bit(n, src, dst);
-            break;
-        case PA_SAMPLE_S24LE:
-            ConvertFromFloatTo24Bit(n, src, dst);
-            break;
-        case PA_SAMPLE_S32LE:
-            ConvertFromFloatTo32Bit(n, src, dst);
-            break;
-        default:
-            ret = memcpy_s(dst, n, src, n);
-            if (ret != 0) {
-                float *dstFloat = (float *)dst;
-                for (uint32_t i = 0; i < n; i++) {
-                    dstFloat[i] = src[i];
-                }
-            }
-            break;
+    int32_t ret = ConvertFromFloatC(GetConvertFormat(format), n, src, dst);
+    if (ret != 0) {
+        AUDIO_ERR_LOG("ConvertFromFloatC failed: %{public}d", ret);
     }
 }
 
@@ -1735,34 +1638,12 @@ static void UpdateSceneToCountMap(pa_hashmap *sceneMap)
     }
 }
 
-static void SinkRenderPrimaryProcess(pa_sink *si, size_t length, pa_memchunk *chunkIn)
+static void PrimaryEffectProcessSerial(pa_sink *si, size_t length, pa_memchunk *chunkIn, time_t currentTime)
 {
-    if (GetInnerCapturerState()) {
-        pa_memchunk capResult;
-        SinkRenderCapProcess(si, length, &capResult);
-        pa_memblock_unref(capResult.memblock);
-    }
-
     struct Userdata *u;
     pa_assert_se(u = si->userdata);
-
-    size_t memsetInLen = sizeof(float) * DEFAULT_FRAMELEN * IN_CHANNEL_NUM_MAX;
-    size_t memsetOutLen = sizeof(float) * DEFAULT_FRAMELEN * OUT_CHANNEL_NUM_MAX;
-    if (memset_s(u->bufferAttr->tempBufIn, u->processSize, 0, memsetInLen) != EOK) {
-        AUDIO_WARNING_LOG("SinkRenderBufIn memset_s failed");
-    }
-    if (memset_s(u->bufferAttr->tempBufOut, u->processSize, 0, memsetOutLen) != EOK) {
-        AUDIO_WARNING_LOG("SinkRenderBufOut memset_s failed");
-    }
     int32_t bitSize = (int32_t)pa_sample_size_of_format(u->format);
-    chunkIn->memblock = pa_memblock_new(si->core->mempool, length * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
-    time_t currentTime = time(NULL);
-    PrepareSpatializationFading(&u->spatializationFadingState, &u->spatializationFadingCount,
-        &u->actualSpatializationEnabled);
-    g_effectProcessFrameCount++;
     const void *sceneType;
-    UpdateSceneToCountMap(u->sceneToCountMap);
-    // to do update resampler when output device change
     void *state = NULL;
     while ((pa_hashmap_iterate(u->sceneToCountMap, &state, &sceneType))) {
         uint32_t processChannels = DEFAULT_NUM_CHANNEL;
@@ -1785,6 +1666,93 @@ static void SinkRenderPrimaryProcess(pa_sink *si, size_t length, pa_memchunk *ch
         u->bufferAttr->frameLen = frameLen / u->bufferAttr->numChanIn;
         PrimaryEffectProcess(u, chunkIn, sinkSceneType);
     }
+}
+
+// Sink inputs are peeked and converted on the io thread, only the effect chains run on the worker pool.
+static void PrimaryEffectProcessParallel(pa_sink *si, size_t length, pa_memchunk *chunkIn, time_t currentTime)
+{
+    struct Userdata *u;
+    pa_assert_se(u = si->userdata);
+    int32_t bitSize = (int32_t)pa_sample_size_of_format(u->format);
+    const void *sceneType;
+    void *state = NULL;
+    while ((pa_hashmap_iterate(u->sceneToCountMap, &state, &sceneType))) {
+        uint32_t processChannels = DEFAULT_NUM_CHANNEL;
+        uint64_t processChannelLayout = DEFAULT_CHANNELLAYOUT;
+        EffectChainManagerReturnEffectChannelInfo((char *)sceneType, &processChannels, &processChannelLayout);
+        char *sinkSceneType = CheckAndDealEffectZeroVolume(u, currentTime, (char *)sceneType);
+        size_t tmpLength = length * processChannels / DEFAULT_IN_CHANNEL_NUM;
+        chunkIn->index = 0;
+        chunkIn->length = tmpLength;
+        int32_t nSinkInput = SinkRenderPrimaryGetData(si, chunkIn, (char *)sceneType);
+        if (nSinkInput == 0) { continue; }
+        BufferAttr *jobAttr = EffectWorkerPoolAddJob(u->effectWorkerPool, sinkSceneType);
+        if (jobAttr == NULL) { continue; }
+        chunkIn->index = 0;
+        chunkIn->length = tmpLength;
+        void *src = pa_memblock_acquire_chunk(chunkIn);
+        int32_t frameLen = bitSize > 0 ? ((int32_t)tmpLength / bitSize) : 0;
+        ConvertToFloat(u->format, frameLen, src, jobAttr->bufIn);
+        pa_memblock_release(chunkIn->memblock);
+        jobAttr->numChanIn = (int32_t)processChannels;
+        jobAttr->frameLen = frameLen / jobAttr->numChanIn;
+    }
+
+    EffectWorkerPoolRun(u->effectWorkerPool);
+    // mix in the order the scenes were added, so the result is the same as the serial one
+    uint32_t jobNum = EffectWorkerPoolGetJobNum(u->effectWorkerPool);
+    for (uint32_t i = 0; i < jobNum; i++) {
+        const BufferAttr *result = EffectWorkerPoolGetJobResult(u->effectWorkerPool, i);
+        for (int32_t k = 0; k < result->frameLen * result->numChanOut; k++) {
+            u->bufferAttr->tempBufOut[k] += result->bufOut[k];
+        }
+    }
+    EffectWorkerPoolClearJobs(u->effectWorkerPool);
+}
+
+// Sinks that never run a scene effect chain do not pay for the worker threads.
+static void CheckAndCreateEffectWorkerPool(struct Userdata *u)
+{
+    if (u->effectWorkerPoolCreated || pa_hashmap_size(u->sceneToCountMap) == 0) {
+        return;
+    }
+    u->effectWorkerPoolCreated = true;
+    // EFFECT_NONE is never a key of sceneToCountMap, so there is at most one job for each other scene type
+    u->effectWorkerPool = EffectWorkerPoolNew(SCENE_TYPE_NUM - 1, u->processSize, u->bufferAttr);
+}
+
+static void SinkRenderPrimaryProcess(pa_sink *si, size_t length, pa_memchunk *chunkIn)
+{
+    if (GetInnerCapturerState()) {
+        pa_memchunk capResult;
+        SinkRenderCapProcess(si, length, &capResult);
+        pa_memblock_unref(capResult.memblock);
+    }
+
+    struct Userdata *u;
+    pa_assert_se(u = si->userdata);
+
+    size_t memsetInLen = sizeof(float) * DEFAULT_FRAMELEN * IN_CHANNEL_NUM_MAX;
+    size_t memsetOutLen = sizeof(float) * DEFAULT_FRAMELEN * OUT_CHANNEL_NUM_MAX;
+    if (memset_s(u->bufferAttr->tempBufIn, u->processSize, 0, memsetInLen) != EOK) {
+        AUDIO_WARNING_LOG("SinkRenderBufIn memset_s failed");
+    }
+    if (memset_s(u->bufferAttr->tempBufOut, u->processSize, 0, memsetOutLen) != EOK) {
+        AUDIO_WARNING_LOG("SinkRenderBufOut memset_s failed");
+    }
+    chunkIn->memblock = pa_memblock_new(si->core->mempool, length * IN_CHANNEL_NUM_MAX / DEFAULT_IN_CHANNEL_NUM);
+    time_t currentTime = time(NULL);
+    PrepareSpatializationFading(&u->spatializationFadingState, &u->spatializationFadingCount,
+        &u->actualSpatializationEnabled);
+    g_effectProcessFrameCount++;
+    UpdateSceneToCountMap(u->sceneToCountMap);
+    CheckAndCreateEffectWorkerPool(u);
+    // to do update resampler when output device change
+    if (u->effectWorkerPool != NULL) {
+        PrimaryEffectProcessParallel(si, length, chunkIn, currentTime);
+    } else {
+        PrimaryEffectProcessSerial(si, length, chunkIn, currentTime);
+    }
     if (g_effectProcessFrameCount == PRINT_INTERVAL_FRAME_COUNT) { g_effectProcessFrameCount = 0; }
     CheckAndDealSpeakerPaZeroVolume(u, currentTime);
     SinkRenderPrimaryAfterProcess(si, length, chunkIn);
@@ -3726,6 +3694,8 @@ static void PaHdiSinkUserdataInit(struct Userdata *u)
     u->sinkSceneMode = -1;
     u->sinkSceneType = -1;
     u->hdiEffectEnabled = false;
+    u->effectWorkerPool = NULL;
+    u->effectWorkerPoolCreated = false;
 }
 
 static pa_sink *PaHdiSinkInit(struct Userdata *u, pa_modargs *ma, const char *driver)
@@ -4134,6 +4104,8 @@ static void UserdataFree(struct Userdata *u)
 
     UserdataFreeOffload(u);
     UserdataFreeMultiChannel(u);
+    EffectWorkerPoolFree(u->effectWorkerPool);
+    u->effectWorkerPool = NULL;
 
     if (u->primary.msgq) {
         pa_asyncmsgq_unref(u->primary.msgq);
@@ -33,6 +33,7 @@
 #include <pulsecore/memblockq.h>
 
 #include "renderer_sink_adapter.h"
+#include "effect_worker_pool.h"
 
 struct Userdata {
     const char *adapterName;
@@ -76,6 +77,8 @@ struct Userdata {
     bool actualSpatializationEnabled; // the spatialization state that actually applies effect
     bool isFirstStarted;
     pa_hashmap *sceneToCountMap;
+    EffectWorkerPool *effectWorkerPool; // NULL if scene effects are processed serially
+    bool effectWorkerPoolCreated; // the pool is created with the first scene effect chain
     // todo resampler map
     uint64_t lastRecodedLatency;
     uint32_t continuesGetLatencyErrCount;
@@ -19,6 +19,7 @@
 #include <map>
 #include <thread>
 #include <mutex>
+#include <vector>
 
 #include "tone_player.h"
 #include "audio_renderer.h"
@@ -26,6 +27,12 @@
 
 namespace OHOS {
 namespace AudioStandard {
+// One period of the waves of every segment of a tone at a sampling rate. A segment without waves, or whose
+// period did not fit in the cache, has an empty period and is synthesized instead.
+struct ToneWaveTable {
+    std::vector<int16_t> segmentPeriods[TONEINFO_MAX_SEGMENTS + 1];
+};
+
 class TonePlayerImpl : public AudioRendererWriteCallback, public AudioRendererCallback, public TonePlayer,
     public std::enable_shared_from_this<TonePlayerImpl> {
 public:
@@ -76,6 +83,8 @@ private:
     uint32_t currCount_ = 0;  // Current sequence repeat count
     std::shared_ptr<ToneInfo> toneInfo_;  // pointer to active tone Info
     std::shared_ptr<ToneInfo> initialToneInfo_;  // pointer to new active tone Info
+    std::shared_ptr<const ToneWaveTable> waveTable_;  // pre-rendered periods of the active tone
+    std::shared_ptr<const ToneWaveTable> initialWaveTable_;  // pre-rendered periods of the new active tone
     std::vector<int32_t> supportedTones_;
 
     ToneState toneState_ = TONE_IDLE;
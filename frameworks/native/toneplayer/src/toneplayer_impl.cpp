@@ -19,9 +19,11 @@
 #include <sys/time.h>
 #include <utility>
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
 #include <cfloat>
+#include <numeric>
 #include "securec.h"
 #include "audio_common_log.h"
 #include "audio_policy_manager.h"
@@ -37,7 +39,9 @@ constexpr int32_t C1000MS = 1000;
 constexpr int32_t CDOUBLE = 2;
 constexpr int32_t DIGITAMPLITUDE = 800;
 constexpr int32_t AMPLITUDE = 8000;
-constexpr int32_t BIT8 = 8;
+constexpr uint32_t RENDER_CHUNK_SAMPLES = 256;
+// 2MB of s16 samples, enough for the periods of every dtmf and supervisory tone at one sampling rate
+constexpr size_t TONE_CACHE_MAX_SAMPLES = 1024 * 1024;
 
 static const std::vector<ToneType> TONE_TYPE_LIST = {
     TONE_TYPE_DIAL_0,
@@ -53,6 +57,113 @@ static const std::vector<ToneType> TONE_TYPE_LIST = {
     TONE_TYPE_DIAL_S,
     TONE_TYPE_DIAL_P
 };
+
+// Tone configs come from the policy config and never change, so a process asks for them once.
+struct ToneCache {
+    std::mutex cacheMutex;
+    std::vector<int32_t> supportedTones;
+    std::map<ToneType, std::shared_ptr<ToneInfo>> toneConfigs;
+    std::map<std::pair<ToneType, uint32_t>, std::shared_ptr<const ToneWaveTable>> waveTables;
+    size_t cachedSamples = 0;
+};
+
+ToneCache &GetToneCache()
+{
+    static ToneCache toneCache;
+    return toneCache;
+}
+
+std::vector<int32_t> GetSupportedTones()
+{
+    ToneCache &cache = GetToneCache();
+    std::lock_guard<std::mutex> lock(cache.cacheMutex);
+    if (cache.supportedTones.empty()) {
+        cache.supportedTones = AudioPolicyManager::GetInstance().GetSupportedTones();
+    }
+    return cache.supportedTones;
+}
+
+std::shared_ptr<ToneInfo> GetToneConfig(ToneType toneType)
+{
+    ToneCache &cache = GetToneCache();
+    std::lock_guard<std::mutex> lock(cache.cacheMutex);
+    auto iter = cache.toneConfigs.find(toneType);
+    if (iter != cache.toneConfigs.end()) {
+        return iter->second;
+    }
+    std::shared_ptr<ToneInfo> toneInfo = AudioPolicyManager::GetInstance().GetToneConfig(toneType);
+    // an invalid config may come from an unavailable server, ask again next time
+    if (toneInfo != nullptr && toneInfo->segmentCnt != 0) {
+        cache.toneConfigs[toneType] = toneInfo;
+    }
+    return toneInfo;
+}
+
+// Sums the waves of freqs from sample index start on. Every wave is a recursive oscillator
+// y[n] = 2cos(w) * y[n-1] - y[n-2], seeded by sin() once per call so the error never builds up across calls.
+// Waves are truncated to s16 and added with wrap around, the way they were mixed byte by byte before.
+void RenderToneWaves(const uint16_t *freqs, int32_t amplitude, uint32_t samplingRate, uint32_t start,
+    int16_t *samples, uint32_t sampleCnt)
+{
+    double coeffs[TONEINFO_MAX_WAVES + 1];
+    double prev[TONEINFO_MAX_WAVES + 1];
+    double prevPrev[TONEINFO_MAX_WAVES + 1];
+    uint32_t waveCnt = 0;
+    for (; waveCnt <= TONEINFO_MAX_WAVES && freqs[waveCnt] != 0; waveCnt++) {
+        double omega = 2 * M_PI * freqs[waveCnt] / samplingRate; // 2 is a parameter in the sine wave formula
+        coeffs[waveCnt] = 2 * cos(omega); // 2 is a parameter in the oscillator formula
+        prev[waveCnt] = sin(omega * (static_cast<double>(start) - 1));
+        prevPrev[waveCnt] = sin(omega * (static_cast<double>(start) - 2)); // 2 for the sample before prev
+    }
+    for (uint32_t idx = 0; idx < sampleCnt; idx++) {
+        int32_t sum = 0;
+        for (uint32_t i = 0; i < waveCnt; i++) {
+            double value = coeffs[i] * prev[i] - prevPrev[i];
+            prevPrev[i] = prev[i];
+            prev[i] = value;
+            sum += static_cast<int16_t>(amplitude * value);
+        }
+        samples[idx] = static_cast<int16_t>(sum);
+    }
+}
+
+// Waves of integer frequencies repeat after samplingRate / gcd(samplingRate, freqs) samples.
+uint32_t GetTonePeriod(const uint16_t *freqs, uint32_t samplingRate)
+{
+    uint32_t divisor = samplingRate;
+    for (uint32_t i = 0; i <= TONEINFO_MAX_WAVES && freqs[i] != 0; i++) {
+        divisor = std::gcd(divisor, static_cast<uint32_t>(freqs[i]));
+    }
+    return divisor == 0 ? 0 : samplingRate / divisor;
+}
+
+std::shared_ptr<const ToneWaveTable> GetToneWaveTable(ToneType toneType, uint32_t samplingRate,
+    const ToneInfo &toneInfo, int32_t amplitude)
+{
+    ToneCache &cache = GetToneCache();
+    std::lock_guard<std::mutex> lock(cache.cacheMutex);
+    auto key = std::make_pair(toneType, samplingRate);
+    auto iter = cache.waveTables.find(key);
+    if (iter != cache.waveTables.end()) {
+        return iter->second;
+    }
+    std::shared_ptr<ToneWaveTable> waveTable = std::make_shared<ToneWaveTable>();
+    for (uint32_t seg = 0; seg < toneInfo.segmentCnt && seg <= TONEINFO_MAX_SEGMENTS; seg++) {
+        const uint16_t *freqs = toneInfo.segments[seg].waveFreq;
+        uint32_t period = GetTonePeriod(freqs, samplingRate);
+        if (freqs[0] == 0 || period == 0 || cache.cachedSamples + period > TONE_CACHE_MAX_SAMPLES) {
+            continue;
+        }
+        std::vector<int16_t> &samples = waveTable->segmentPeriods[seg];
+        samples.resize(period);
+        RenderToneWaves(freqs, amplitude, samplingRate, 0, samples.data(), period);
+        cache.cachedSamples += period;
+    }
+    cache.waveTables[key] = waveTable;
+    AUDIO_INFO_LOG("Tone %{public}d rendered at %{public}u, cached samples %{public}zu", toneType, samplingRate,
+        cache.cachedSamples);
+    return waveTable;
+}
 }
 
 TonePlayerImpl::TonePlayerImpl(const std::string cachePath, const AudioRendererInfo &rendereInfo)
@@ -69,7 +180,7 @@ TonePlayerImpl::TonePlayerImpl(const std::string cachePath, const AudioRendererI
     // streamUsage::STREAM_USAGE_MEDIA;
     rendererOptions_.rendererInfo.streamUsage = rendereInfo.streamUsage;
     rendererOptions_.rendererInfo.rendererFlags = AUDIO_FLAG_FORCED_NORMAL; // use AUDIO_FLAG_FORCED_NORMAL
-    supportedTones_ = AudioPolicyManager::GetInstance().GetSupportedTones();
+    supportedTones_ = GetSupportedTones();
     toneInfo_ = NULL;
     initialToneInfo_ = NULL;
     samplingRate_ = rendererOptions_.streamInfo.samplingRate;
@@ -165,11 +276,12 @@ bool TonePlayerImpl::LoadTone(ToneType toneType)
     toneType_ = toneType;
     amplitudeType_ = std::count(TONE_TYPE_LIST.begin(), TONE_TYPE_LIST.end(), toneType_) > 0 ?
         DIGITAMPLITUDE : AMPLITUDE;
-    initialToneInfo_ = AudioPolicyManager::GetInstance().GetToneConfig(toneType);
-    if (initialToneInfo_->segmentCnt == 0) {
+    initialToneInfo_ = GetToneConfig(toneType);
+    if (initialToneInfo_ == nullptr || initialToneInfo_->segmentCnt == 0) {
         AUDIO_ERR_LOG("LoadTone failed, calling GetToneConfig returned invalid");
         return result;
     }
+    initialWaveTable_ = GetToneWaveTable(toneType, samplingRate_, *initialToneInfo_, amplitudeType_);
     if (!isRendererInited_) {
         isRendererInited_ = InitAudioRenderer();
         CHECK_AND_RETURN_RET_LOG(isRendererInited_, false, "InitAudioRenderer failed");
@@ -297,37 +409,35 @@ bool TonePlayerImpl::ContinueToneplay(uint32_t reqSample, int8_t *audioBuffer)
 
 int32_t TonePlayerImpl::GetSamples(uint16_t *freqs, int8_t *buffer, uint32_t reqSamples)
 {
-    uint32_t index;
-    uint8_t *data;
-    uint16_t freqVal;
-    float pi = 3.1428f;
-    for (uint32_t i = 0; i <= TONEINFO_MAX_WAVES; i++) {
-        if (freqs[i] == 0) {
-            break;
-        }
-        freqVal = freqs[i];
-        AUDIO_DEBUG_LOG("GetSamples Freq: %{public}d sampleCount_: %{public}d", freqVal, sampleCount_);
-        index = sampleCount_;
-        data = reinterpret_cast<uint8_t*>(buffer);
-        double factor = freqVal * 2 * pi / samplingRate_; // 2 is a parameter in the sine wave formula
-        for (uint32_t idx = 0; idx < reqSamples; idx++) {
-            int16_t sample = amplitudeType_ * sin(factor * index);
-            uint32_t result;
-            if (i == 0) {
-                result = (sample & 0xFF);
-                *data = result & 0xFF;
-                data++;
-                *data = ((sample & 0xFF00) >> BIT8);
-                data++;
-            } else {
-                result = *data + (static_cast<uint16_t>(sample) & 0xFF);
-                *data = result & 0xFF;
-                data++;
-                *data += (result >> BIT8) + ((sample & 0xFF00) >> BIT8);
-                data++;
-            }
-            index++;
+    if (freqs[0] == 0) {
+        sampleCount_ += reqSamples;
+        return 0;
+    }
+    AUDIO_DEBUG_LOG("GetSamples Freq: %{public}d sampleCount_: %{public}d", freqs[0], sampleCount_);
+    size_t bufLen = reqSamples * sizeof(int16_t);
+    // freqs always belong to the current segment, play its pre-rendered period when there is one
+    const std::vector<int16_t> *period = nullptr;
+    if (waveTable_ != nullptr && currSegment_ <= TONEINFO_MAX_SEGMENTS &&
+        !waveTable_->segmentPeriods[currSegment_].empty()) {
+        period = &waveTable_->segmentPeriods[currSegment_];
+    }
+    uint32_t done = 0;
+    while (done < reqSamples) {
+        uint32_t index = sampleCount_ + done;
+        uint32_t cnt = 0;
+        if (period != nullptr) {
+            uint32_t offset = index % period->size();
+            cnt = std::min(reqSamples - done, static_cast<uint32_t>(period->size()) - offset);
+            memcpy_s(buffer + done * sizeof(int16_t), bufLen - done * sizeof(int16_t), period->data() + offset,
+                cnt * sizeof(int16_t));
+        } else {
+            int16_t samples[RENDER_CHUNK_SAMPLES];
+            cnt = std::min(reqSamples - done, RENDER_CHUNK_SAMPLES);
+            RenderToneWaves(freqs, amplitudeType_, samplingRate_, index, samples, cnt);
+            memcpy_s(buffer + done * sizeof(int16_t), bufLen - done * sizeof(int16_t), samples,
+                cnt * sizeof(int16_t));
         }
+        done += cnt;
     }
     sampleCount_ += reqSamples;
     return 0;
@@ -400,6 +510,7 @@ bool TonePlayerImpl::InitToneWaveInfo()
         return false;
     }
     toneInfo_ = initialToneInfo_;
+    waveTable_ = initialWaveTable_;
     maxSample_ = TONEINFO_INF;
 
     // Initialize tone sequencer
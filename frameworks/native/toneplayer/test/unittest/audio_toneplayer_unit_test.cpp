@@ -14,6 +14,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 #include "tone_player_impl.h"
 
 using namespace testing::ext;
@@ -345,5 +347,79 @@ HWTEST(AudioToneplayerUnitTest, Toneplayer_StartTone_004, TestSize.Level1)
     bool releaseRet = toneplayer->Release();
     EXPECT_EQ(true, releaseRet);
 }
+/**
+ * @tc.name  : Test toneplayer GetSamples
+ * @tc.type  : FUNC
+ * @tc.number: Toneplayer_GetSamples_001
+ * @tc.desc  : Test synthesized waves match sin() across calls.
+ */
+HWTEST(AudioToneplayerUnitTest, Toneplayer_GetSamples_001, TestSize.Level1)
+{
+    AudioRendererInfo rendererInfo = {};
+    rendererInfo.contentType = ContentType::CONTENT_TYPE_MUSIC;
+    rendererInfo.streamUsage = StreamUsage::STREAM_USAGE_DTMF;
+    rendererInfo.rendererFlags = 0;
+    std::shared_ptr<TonePlayerImpl> toneplayer = std::make_shared<TonePlayerImpl>("", rendererInfo);
+    ASSERT_NE(nullptr, toneplayer);
+
+    const uint32_t reqSamples = 960; // 960 samples for 20ms at 48k
+    const uint32_t callCnt = 3; // 3 calls to cross call boundaries
+    const double amplitude = 800; // 800 for the dial tone amplitude
+    uint16_t freqs[TONEINFO_MAX_WAVES + 1] = {697, 1209, 0, 0}; // frequencies of dial tone 1
+    std::vector<int16_t> samples(reqSamples * callCnt);
+    toneplayer->amplitudeType_ = static_cast<int32_t>(amplitude);
+    toneplayer->sampleCount_ = 0;
+    for (uint32_t i = 0; i < callCnt; i++) {
+        toneplayer->GetSamples(freqs, reinterpret_cast<int8_t *>(samples.data() + i * reqSamples), reqSamples);
+    }
+    EXPECT_EQ(reqSamples * callCnt, toneplayer->sampleCount_);
+    for (uint32_t n = 0; n < samples.size(); n++) {
+        int32_t expected = 0;
+        for (uint32_t i = 0; freqs[i] != 0; i++) {
+            expected += static_cast<int16_t>(amplitude * sin(2 * M_PI * freqs[i] * n / toneplayer->samplingRate_));
+        }
+        // 2 for truncation of each wave
+        EXPECT_LE(std::abs(expected - samples[n]), 2);
+    }
+}
+
+/**
+ * @tc.name  : Test toneplayer GetSamples
+ * @tc.type  : FUNC
+ * @tc.number: Toneplayer_GetSamples_002
+ * @tc.desc  : Test a pre-rendered period plays the same samples as the synthesizer across its wrap around.
+ */
+HWTEST(AudioToneplayerUnitTest, Toneplayer_GetSamples_002, TestSize.Level1)
+{
+    AudioRendererInfo rendererInfo = {};
+    rendererInfo.contentType = ContentType::CONTENT_TYPE_MUSIC;
+    rendererInfo.streamUsage = StreamUsage::STREAM_USAGE_DTMF;
+    rendererInfo.rendererFlags = 0;
+    std::shared_ptr<TonePlayerImpl> toneplayer = std::make_shared<TonePlayerImpl>("", rendererInfo);
+    ASSERT_NE(nullptr, toneplayer);
+
+    const uint32_t period = 4800; // 350Hz and 440Hz repeat every 4800 samples at 48k
+    const uint32_t reqSamples = 960; // 960 samples for 20ms at 48k
+    const uint32_t startIndex = period - reqSamples / 2; // 2 for starting in the middle of a request
+    uint16_t freqs[TONEINFO_MAX_WAVES + 1] = {350, 440, 0, 0}; // frequencies of the dial tone
+    toneplayer->amplitudeType_ = 8000; // 8000 for the tone amplitude
+    toneplayer->currSegment_ = 0;
+    std::shared_ptr<ToneWaveTable> waveTable = std::make_shared<ToneWaveTable>();
+    waveTable->segmentPeriods[0].resize(period);
+    toneplayer->sampleCount_ = 0;
+    toneplayer->GetSamples(freqs, reinterpret_cast<int8_t *>(waveTable->segmentPeriods[0].data()), period);
+
+    std::vector<int16_t> synthesized(reqSamples);
+    toneplayer->sampleCount_ = startIndex;
+    toneplayer->GetSamples(freqs, reinterpret_cast<int8_t *>(synthesized.data()), reqSamples);
+
+    std::vector<int16_t> played(reqSamples);
+    toneplayer->waveTable_ = waveTable;
+    toneplayer->sampleCount_ = startIndex;
+    toneplayer->GetSamples(freqs, reinterpret_cast<int8_t *>(played.data()), reqSamples);
+    for (uint32_t n = 0; n < reqSamples; n++) {
+        EXPECT_LE(std::abs(synthesized[n] - played[n]), 1);
+    }
+}
 } // namespace AudioStandard
 } // namespace OHOS
\ No newline at end of file
@@ -953,6 +953,57 @@ public:
      */
     virtual bool Unmute(StateChangeCmdType cmdType = CMD_FROM_CLIENT) const {return false;};
 
+    /**
+     * @brief Enables or disables the direct write mode.
+     * In direct write mode the data is written in place into the buffer shared with the audio service, using
+     * {@link GetDirectWriteBuffer} and {@link CommitDirectWriteBuffer} instead of {@link Write}. This saves one copy
+     * and one ipc call per period. It is only supported by normal renderers in RENDER_MODE_NORMAL, without speed
+     * change, channel blend or audio vivid encoding.
+     *
+     * @param enable Indicates whether the direct write mode is enabled.
+     * @return Returns {@link SUCCESS} if the mode is successfully set; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     * @since 12
+     */
+    virtual int32_t SetDirectWriteMode(bool enable);
+
+    /**
+     * @brief Obtains the next writable span of the shared buffer, blocks until the audio service has consumed
+     * enough data. This API should only be used if the direct write mode is enabled.
+     *
+     * @param bufDesc Indicates the buffer descriptor in which data will be filled, bufLength is one span.
+     * @return Returns {@link SUCCESS} if bufDesc is successfully obtained; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     * @since 12
+     */
+    virtual int32_t GetDirectWriteBuffer(BufferDesc &bufDesc);
+
+    /**
+     * @brief Commits the span obtained by {@link GetDirectWriteBuffer} to the audio service. If dataLength is less
+     * than bufLength, the rest of the span is filled with silence.
+     * This API should only be used if the direct write mode is enabled.
+     *
+     * @param bufDesc Indicates the buffer descriptor obtained by {@link GetDirectWriteBuffer}.
+     * @return Returns {@link SUCCESS} if the span is successfully committed; returns an error code
+     * defined in {@link audio_errors.h} otherwise.
+     * @since 12
+     */
+    virtual int32_t CommitDirectWriteBuffer(const BufferDesc &bufDesc);
+
+    /**
+     * @brief Writes only the part of the audio data that fits in the client buffer at once, never waits for the
+     * audio service to consume data. The rest of the data should be written again later.
+     * It is only supported by normal renderers in RENDER_MODE_NORMAL, without speed change, channel blend or
+     * audio vivid encoding.
+     *
+     * @param buffer Indicates the pointer to the buffer which contains the audio data to be written.
+     * @param bufferSize Indicates the size of the buffer which contains audio data to be written, in bytes.
+     * @return Returns the size of the audio data written, ranging from <b>0</b> to <b>bufferSize</b>;
+     * returns an error code defined in {@link audio_errors.h} otherwise.
+     * @since 12
+     */
+    virtual int32_t WriteNonBlocking(uint8_t *buffer, size_t bufferSize);
+
 private:
     static int32_t CreateCheckParam(const AudioRendererOptions &rendererOptions,
         const AppInfo &appInfo);
@@ -68,6 +68,9 @@ public:
     virtual std::vector<sptr<AudioDeviceDescriptor>> GetInputDevice(
         sptr<AudioCapturerFilter> audioCapturerFilter) = 0;
 
+    // The fd is owned by the server side, the caller maps it read only.
+    virtual int32_t GetPolicySnapshot(int32_t &fd, uint64_t &size) = 0;
+
     virtual int32_t SetDeviceActive(InternalDeviceType deviceType, bool active) = 0;
 
     virtual int32_t NotifyCapturerAdded(AudioCapturerInfo capturerInfo, AudioStreamInfo streamInfo,
@@ -42,6 +42,7 @@ private:
     void GetActiveInputDeviceInternal(MessageParcel &data, MessageParcel &reply);
     void GetOutputDeviceInternal(MessageParcel &data, MessageParcel &reply);
     void GetInputDeviceInternal(MessageParcel &data, MessageParcel &reply);
+    void GetPolicySnapshotInternal(MessageParcel &data, MessageParcel &reply);
     void SetRingerModeLegacyInternal(MessageParcel &data, MessageParcel &reply);
     void SetRingerModeInternal(MessageParcel &data, MessageParcel &reply);
     void GetRingerModeInternal(MessageParcel &data, MessageParcel &reply);
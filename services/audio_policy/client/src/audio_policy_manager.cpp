@@ -17,7 +17,11 @@
 #endif
 
 #include "audio_policy_manager.h"
+#include <cinttypes>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "audio_errors.h"
+#include "audio_policy_snapshot.h"
 #include "audio_server_death_recipient.h"
 #include "audio_policy_log.h"
 #include "audio_utils.h"
@@ -40,6 +44,9 @@ std::mutex g_cBDiedMapMutex;
 std::unordered_map<int32_t, std::weak_ptr<AudioRendererPolicyServiceDiedCallback>> AudioPolicyManager::rendererCBMap_;
 sptr<AudioPolicyClientStubImpl> AudioPolicyManager::audioStaticPolicyClientStubCB_;
 std::vector<std::weak_ptr<AudioStreamPolicyServiceDiedCallback>> AudioPolicyManager::audioStreamCBMap_;
+static std::atomic<const PolicySnapshotRegion *> g_policySnapshot = nullptr;
+std::mutex g_policySnapshotMutex;
+static bool g_isPolicySnapshotRequested = false;
 
 inline const sptr<IAudioPolicy> GetAudioPolicyManagerProxy()
 {
@@ -73,6 +80,50 @@ inline const sptr<IAudioPolicy> GetAudioPolicyManagerProxy()
     return gsp;
 }
 
+static const PolicySnapshotRegion *GetPolicySnapshotRegion(const sptr<IAudioPolicy> &gsp)
+{
+    const PolicySnapshotRegion *region = g_policySnapshot.load(std::memory_order_acquire);
+    if (region != nullptr) {
+        return region;
+    }
+    std::lock_guard<std::mutex> lock(g_policySnapshotMutex);
+    // requested once per server life, an old server without the snapshot is not asked on every query
+    if (g_isPolicySnapshotRequested) {
+        return g_policySnapshot.load(std::memory_order_acquire);
+    }
+    g_isPolicySnapshotRequested = true;
+    int32_t fd = -1;
+    uint64_t size = 0;
+    int32_t ret = gsp->GetPolicySnapshot(fd, size);
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, nullptr, "Get policy snapshot failed: %{public}d", ret);
+    if (size < sizeof(PolicySnapshotRegion)) {
+        AUDIO_ERR_LOG("Policy snapshot size %{public}" PRIu64 " is too small", size);
+        close(fd);
+        return nullptr;
+    }
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    CHECK_AND_RETURN_RET_LOG(addr != MAP_FAILED, nullptr, "Map policy snapshot failed");
+    region = static_cast<const PolicySnapshotRegion *>(addr);
+    g_policySnapshot.store(region, std::memory_order_release);
+    return region;
+}
+
+// Returns false if the snapshot can not be used, the caller should query the server then.
+static bool ReadPolicySnapshot(const sptr<IAudioPolicy> &gsp, PolicySnapshotData &data)
+{
+    const PolicySnapshotRegion *region = GetPolicySnapshotRegion(gsp);
+    if (region == nullptr || !PolicySnapshotSeqLock::Read(*region, data)) {
+        return false;
+    }
+    return data.isValid != 0;
+}
+
+static bool IsSnapshotStreamType(AudioStreamType streamType)
+{
+    return streamType >= 0 && streamType <= STREAM_TYPE_MAX;
+}
+
 int32_t AudioPolicyManager::RegisterPolicyCallbackClientFunc(const sptr<IAudioPolicy> &gsp)
 {
     AudioXCollie audioXCollie("AudioPolicyManager::RegisterPolicyCallbackClientFunc", TIME_OUT_SECONDS);
@@ -164,6 +215,12 @@ void AudioPolicyManager::AudioPolicyServerDied(pid_t pid)
         std::lock_guard<std::mutex> lock(g_apProxyMutex);
         g_apProxy = nullptr;
     }
+    {
+        // The old mapping is never unmapped, a reader may still hold it. It is one page per server restart.
+        std::lock_guard<std::mutex> lock(g_policySnapshotMutex);
+        g_policySnapshot.store(nullptr, std::memory_order_release);
+        g_isPolicySnapshotRequested = false;
+    }
     GetInstance().RecoverAudioPolicyCallbackClient();
 
     {
@@ -225,9 +282,13 @@ int32_t AudioPolicyManager::SetRingerMode(AudioRingerMode ringMode)
 
 AudioRingerMode AudioPolicyManager::GetRingerMode()
 {
-    AudioXCollie audioXCollie("AudioPolicyManager::GetRingerMode", TIME_OUT_SECONDS);
     const sptr<IAudioPolicy> gsp = GetAudioPolicyManagerProxy();
     CHECK_AND_RETURN_RET_LOG(gsp != nullptr, RINGER_MODE_NORMAL, "audio policy manager proxy is NULL.");
+    PolicySnapshotData snapshot;
+    if (ReadPolicySnapshot(gsp, snapshot)) {
+        return static_cast<AudioRingerMode>(snapshot.ringerMode);
+    }
+    AudioXCollie audioXCollie("AudioPolicyManager::GetRingerMode", TIME_OUT_SECONDS);
     return gsp->GetRingerMode();
 }
 
@@ -292,6 +353,12 @@ AudioScene AudioPolicyManager::GetAudioScene()
 {
     const sptr<IAudioPolicy> gsp = GetAudioPolicyManagerProxy();
     CHECK_AND_RETURN_RET_LOG(gsp != nullptr, AUDIO_SCENE_DEFAULT, "audio policy manager proxy is NULL.");
+    PolicySnapshotData snapshot;
+    // call scenes are only visible to system callers, the server checks the permission
+    if (ReadPolicySnapshot(gsp, snapshot) && snapshot.audioScene != AUDIO_SCENE_CALL_START &&
+        snapshot.audioScene != AUDIO_SCENE_CALL_END) {
+        return static_cast<AudioScene>(snapshot.audioScene);
+    }
     return gsp->GetAudioScene();
 }
 
@@ -299,6 +366,11 @@ int32_t AudioPolicyManager::GetSystemVolumeLevel(AudioVolumeType volumeType)
 {
     const sptr<IAudioPolicy> gsp = GetAudioPolicyManagerProxy();
     CHECK_AND_RETURN_RET_LOG(gsp != nullptr, -1, "audio policy manager proxy is NULL.");
+    AudioStreamType streamType = volumeType == STREAM_ALL ? STREAM_MUSIC : volumeType;
+    PolicySnapshotData snapshot;
+    if (IsSnapshotStreamType(streamType) && ReadPolicySnapshot(gsp, snapshot)) {
+        return snapshot.volumeLevel[streamType];
+    }
     return gsp->GetSystemVolumeLevel(volumeType);
 }
 
@@ -316,6 +388,13 @@ bool AudioPolicyManager::GetStreamMute(AudioVolumeType volumeType)
 {
     const sptr<IAudioPolicy> gsp = GetAudioPolicyManagerProxy();
     CHECK_AND_RETURN_RET_LOG(gsp != nullptr, false, "audio policy manager proxy is NULL.");
+    AudioStreamType streamType = volumeType == STREAM_ALL ? STREAM_MUSIC : volumeType;
+    PolicySnapshotData snapshot;
+    // ring streams need a permission checked by the server
+    if (IsSnapshotStreamType(streamType) && streamType != STREAM_RING && streamType != STREAM_VOICE_RING &&
+        ReadPolicySnapshot(gsp, snapshot)) {
+        return snapshot.isMute[streamType] != 0;
+    }
     return gsp->GetStreamMute(volumeType);
 }
 
@@ -538,6 +617,10 @@ DeviceType AudioPolicyManager::GetActiveOutputDevice()
 {
     const sptr<IAudioPolicy> gsp = GetAudioPolicyManagerProxy();
     CHECK_AND_RETURN_RET_LOG(gsp != nullptr, DEVICE_TYPE_INVALID, "audio policy manager proxy is NULL.");
+    PolicySnapshotData snapshot;
+    if (ReadPolicySnapshot(gsp, snapshot)) {
+        return static_cast<DeviceType>(snapshot.activeOutputDevice);
+    }
     return gsp->GetActiveOutputDevice();
 }
 
@@ -545,6 +628,10 @@ DeviceType AudioPolicyManager::GetActiveInputDevice()
 {
     const sptr<IAudioPolicy> gsp = GetAudioPolicyManagerProxy();
     CHECK_AND_RETURN_RET_LOG(gsp != nullptr, DEVICE_TYPE_INVALID, "audio policy manager proxy is NULL.");
+    PolicySnapshotData snapshot;
+    if (ReadPolicySnapshot(gsp, snapshot)) {
+        return static_cast<DeviceType>(snapshot.activeInputDevice);
+    }
     return gsp->GetActiveInputDevice();
 }
 
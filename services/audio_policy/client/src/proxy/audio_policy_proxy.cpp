@@ -396,6 +396,28 @@ std::vector<sptr<AudioDeviceDescriptor>> AudioPolicyProxy::GetInputDevice(
     return deviceInfo;
 }
 
+int32_t AudioPolicyProxy::GetPolicySnapshot(int32_t &fd, uint64_t &size)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    bool ret = data.WriteInterfaceToken(GetDescriptor());
+    CHECK_AND_RETURN_RET_LOG(ret, ERR_OPERATION_FAILED, "WriteInterfaceToken failed");
+
+    int32_t error = Remote()->SendRequest(
+        static_cast<uint32_t>(AudioPolicyInterfaceCode::GET_POLICY_SNAPSHOT), data, reply, option);
+    CHECK_AND_RETURN_RET_LOG(error == ERR_NONE, error, "Get policy snapshot failed, error: %d", error);
+
+    int32_t result = reply.ReadInt32();
+    CHECK_AND_RETURN_RET(result == SUCCESS, result);
+    // the read fd is a dup owned by the caller
+    fd = reply.ReadFileDescriptor();
+    size = reply.ReadUint64();
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, ERR_OPERATION_FAILED, "Read snapshot fd failed");
+    return SUCCESS;
+}
+
 int32_t AudioPolicyProxy::SetDeviceActive(InternalDeviceType deviceType, bool active)
 {
     MessageParcel data;
@@ -165,7 +165,8 @@ enum class AudioPolicyInterfaceCode {
     SET_DEFAULT_OUTPUT_DEVICE,
     GET_OUTPUT_DEVICE,
     GET_INPUT_DEVICE,
-    AUDIO_POLICY_MANAGER_CODE_MAX = GET_INPUT_DEVICE,
+    GET_POLICY_SNAPSHOT,
+    AUDIO_POLICY_MANAGER_CODE_MAX = GET_POLICY_SNAPSHOT,
 };
 } // namespace AudioStandard
 } // namespace OHOS
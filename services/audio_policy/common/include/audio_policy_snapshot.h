@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_POLICY_SNAPSHOT_H
+#define AUDIO_POLICY_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "audio_stream_info.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// Bump it whenever PolicySnapshotData changes, clients of another layout fall back to ipc.
+constexpr uint32_t POLICY_SNAPSHOT_LAYOUT_VERSION = 1;
+constexpr size_t POLICY_SNAPSHOT_STREAM_TYPE_NUM = static_cast<size_t>(STREAM_TYPE_MAX) + 1;
+constexpr uint32_t POLICY_SNAPSHOT_READ_RETRY_TIMES = 3;
+
+// The policy state a client may read without ipc. Values are what the getters of the policy server return.
+struct PolicySnapshotData {
+    uint32_t isValid = 0;
+    int32_t volumeLevel[POLICY_SNAPSHOT_STREAM_TYPE_NUM] = {};
+    uint32_t isMute[POLICY_SNAPSHOT_STREAM_TYPE_NUM] = {};
+    int32_t activeOutputDevice = 0;
+    int32_t activeInputDevice = 0;
+    int32_t audioScene = 0;
+    int32_t ringerMode = 0;
+};
+
+constexpr size_t POLICY_SNAPSHOT_WORD_NUM = sizeof(PolicySnapshotData) / sizeof(uint32_t);
+static_assert(sizeof(PolicySnapshotData) % sizeof(uint32_t) == 0, "snapshot data must be made of words");
+
+// Layout of the shared memory. The policy server is the only writer, clients map it read only.
+struct PolicySnapshotRegion {
+    uint32_t layoutVersion;
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> words[POLICY_SNAPSHOT_WORD_NUM];
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "atomics in shared memory must be lock free");
+
+// Sequence lock over the region: the sequence is odd while a write is in progress, a read is retried if the
+// sequence was odd or changed during the copy.
+class PolicySnapshotSeqLock {
+public:
+    static void Init(PolicySnapshotRegion &region)
+    {
+        region.layoutVersion = POLICY_SNAPSHOT_LAYOUT_VERSION;
+        region.sequence.store(0, std::memory_order_relaxed);
+        Write(region, PolicySnapshotData());
+    }
+
+    // Writers must be serialized by the caller.
+    static void Write(PolicySnapshotRegion &region, const PolicySnapshotData &data)
+    {
+        uint32_t words[POLICY_SNAPSHOT_WORD_NUM];
+        memcpy(words, &data, sizeof(words));
+        uint32_t sequence = region.sequence.load(std::memory_order_relaxed);
+        region.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < POLICY_SNAPSHOT_WORD_NUM; i++) {
+            region.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        region.sequence.store(sequence + 2, std::memory_order_release); // 2 for an even sequence
+    }
+
+    // Returns false if the layout does not match or no consistent copy is got within the retry times.
+    static bool Read(const PolicySnapshotRegion &region, PolicySnapshotData &data)
+    {
+        if (region.layoutVersion != POLICY_SNAPSHOT_LAYOUT_VERSION) {
+            return false;
+        }
+        uint32_t words[POLICY_SNAPSHOT_WORD_NUM];
+        for (uint32_t retry = 0; retry < POLICY_SNAPSHOT_READ_RETRY_TIMES; retry++) {
+            uint32_t begin = region.sequence.load(std::memory_order_acquire);
+            if (begin % 2 != 0) {
+                continue;
+            }
+            for (size_t i = 0; i < POLICY_SNAPSHOT_WORD_NUM; i++) {
+                words[i] = region.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (region.sequence.load(std::memory_order_relaxed) == begin) {
+                memcpy(&data, words, sizeof(words));
+                return true;
+            }
+        }
+        return false;
+    }
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_POLICY_SNAPSHOT_H
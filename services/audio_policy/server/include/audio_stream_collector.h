@@ -16,6 +16,9 @@
 #ifndef AUDIO_STREAM_COLLECTOR_H
 #define AUDIO_STREAM_COLLECTOR_H
 
+#include <set>
+#include <unordered_map>
+
 #include "audio_info.h"
 #include "audio_policy_client.h"
 #include "audio_system_manager.h"
@@ -77,7 +80,12 @@ public:
     void ResetCapturerStreamDeviceInfo(const AudioDeviceDescriptor& updatedDesc);
     StreamUsage GetLastestRunningCallStreamUsage();
     std::vector<uint32_t> GetAllRendererSessionIDForUID(int32_t uid);
+    std::vector<uint32_t> GetAllCapturerSessionIDForUID(int32_t uid);
     int32_t ResumeStreamState();
+    // Immutable views shared by all readers until the next change of the streams, prefer them over
+    // GetCurrent*ChangeInfos when the infos are only read.
+    std::shared_ptr<const std::vector<AudioRendererChangeInfo>> GetRendererChangeInfosSnapshot();
+    std::shared_ptr<const std::vector<AudioCapturerChangeInfo>> GetCapturerChangeInfosSnapshot();
 private:
     std::mutex streamsInfoMutex_;
     std::map<std::pair<int32_t, int32_t>, int32_t> rendererStatequeue_;
@@ -85,6 +93,15 @@ private:
     std::vector<std::unique_ptr<AudioRendererChangeInfo>> audioRendererChangeInfos_;
     std::vector<std::unique_ptr<AudioCapturerChangeInfo>> audioCapturerChangeInfos_;
     std::unordered_map<int32_t, std::shared_ptr<AudioClientTracker>> clientTracker_;
+    // Indexes over the change infos above, kept in step with every insert, replace and erase of them
+    std::unordered_map<int32_t, AudioRendererChangeInfo *> rendererSessionIndex_;
+    std::unordered_map<int32_t, AudioCapturerChangeInfo *> capturerSessionIndex_;
+    std::unordered_map<int32_t, std::set<int32_t>> rendererUidIndex_;
+    std::unordered_map<int32_t, std::set<int32_t>> capturerUidIndex_;
+    std::unordered_map<StreamUsage, std::set<int32_t>> rendererUsageIndex_;
+    // Reset on any change, rebuilt by the first reader after it
+    std::shared_ptr<const std::vector<AudioRendererChangeInfo>> rendererSnapshot_;
+    std::shared_ptr<const std::vector<AudioCapturerChangeInfo>> capturerSnapshot_;
     static const std::map<std::pair<ContentType, StreamUsage>, AudioStreamType> streamTypeMap_;
     static std::map<std::pair<ContentType, StreamUsage>, AudioStreamType> CreateStreamMap();
     int32_t AddRendererStream(AudioStreamChangeInfo &streamChangeInfo);
@@ -111,6 +128,12 @@ private:
     bool CheckRendererStateInfoChanged(AudioStreamChangeInfo &streamChangeInfo);
     bool CheckRendererInfoChanged(AudioStreamChangeInfo &streamChangeInfo);
     bool IsCallStreamUsage(StreamUsage usage);
+    void AddRendererIndex(AudioRendererChangeInfo *changeInfo);
+    void RemoveRendererIndex(const AudioRendererChangeInfo *changeInfo);
+    void AddCapturerIndex(AudioCapturerChangeInfo *changeInfo);
+    void RemoveCapturerIndex(const AudioCapturerChangeInfo *changeInfo);
+    AudioRendererChangeInfo *FindRendererChangeInfo(int32_t sessionId);
+    AudioCapturerChangeInfo *FindCapturerChangeInfo(int32_t sessionId);
     AudioSystemManager *audioSystemMgr_;
     std::shared_ptr<AudioPolicyServerHandler> audioPolicyServerHandler_;
     std::shared_ptr<AudioConcurrencyService> audioConcurrencyService_;
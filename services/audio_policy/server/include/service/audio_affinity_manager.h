@@ -43,6 +43,7 @@ public:
 
     std::unique_ptr<AudioDeviceDescriptor> GetRendererDevice(int32_t clientUID);
     std::unique_ptr<AudioDeviceDescriptor> GetCapturerDevice(int32_t clientUID);
+    bool HasSelectRendererDevice(int32_t clientUID);
 
     void AddSelectRendererDevice(int32_t clientUID, const sptr<AudioDeviceDescriptor> &deviceDescriptor);
     void RemoveOfflineRendererDevice(const AudioDeviceDescriptor &updatedDesc);
@@ -182,6 +182,11 @@ public:
 
     AudioScene GetAudioScene(bool hasSystemPermission = true) const;
 
+    // Collects the policy snapshot again if any state in it changed since the last collection.
+    void RefreshPolicySnapshot();
+
+    int32_t GetPolicySnapshot(int32_t &fd, uint64_t &size);
+
     int32_t GetAudioLatencyFromXml() const;
 
     uint32_t GetSinkLatencyFromXml() const;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_CONFIG_CACHE_H
+#define AUDIO_CONFIG_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace OHOS {
+namespace AudioStandard {
+// created by the audio_policy.cfg init job
+static constexpr char AUDIO_CONFIG_CACHE_DIR[] = "/data/service/el1/public/audio_policy/";
+
+// Binary snapshot of a parsed xml config, so the xml is only parsed again when it changes. The file holds a header
+// and an array of fixed size records. It is mapped read only and used only while the format version, the build
+// fingerprint and the hash of the source xml match the header.
+class AudioConfigCache {
+public:
+    // formatVersion is owned by the parser and must be bumped whenever its record layout changes.
+    AudioConfigCache(const std::string &cachePath, const std::string &sourcePath, uint32_t formatVersion);
+    ~AudioConfigCache();
+
+    // Maps the cache. Returns false if it is missing, corrupt or stale.
+    bool Load(uint32_t recordSize);
+
+    // Valid until the cache is destroyed.
+    template <typename T>
+    const T *GetRecords(uint64_t &count) const
+    {
+        count = recordCount_;
+        return reinterpret_cast<const T *>(records_);
+    }
+
+    // Rewrites the cache with the records parsed from the source.
+    template <typename T>
+    bool Store(const std::vector<T> &records)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "records must be trivially copyable");
+        return StoreRecords(records.data(), sizeof(T), records.size());
+    }
+
+private:
+    bool ReadSourceHash();
+    bool StoreRecords(const void *records, uint32_t recordSize, uint64_t recordCount);
+    void Unmap();
+
+    std::string cachePath_;
+    std::string sourcePath_;
+    uint32_t formatVersion_ = 0;
+    // hash of the build fingerprint, an OTA may change the record layout without bumping formatVersion
+    uint64_t buildHash_ = 0;
+
+    bool sourceHashRead_ = false;
+    uint64_t sourceSize_ = 0;
+    uint64_t sourceHash_ = 0;
+
+    void *mapAddr_ = nullptr;
+    size_t mapSize_ = 0;
+    const uint8_t *records_ = nullptr;
+    uint64_t recordCount_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // AUDIO_CONFIG_CACHE_H
@@ -22,6 +22,7 @@
 #include "audio_errors.h"
 #include "audio_info.h"
 #include "audio_policy_log.h"
+#include "audio_config_cache.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -44,6 +45,12 @@ private:
     static std::map<std::string, InterruptForceType> forceMap;
 
     void LoadDefaultConfig(std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap);
+    int32_t ParseConfig(const char *path, std::map<std::pair<AudioFocusType, AudioFocusType>,
+        AudioFocusEntry> &focusMap);
+    bool LoadFromCache(AudioConfigCache &cache,
+        std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap);
+    void StoreToCache(AudioConfigCache &cache,
+        const std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap);
     void ParseFocusChildrenMap(xmlNode *node, const std::string &curStream,
         std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap);
     void ParseFocusMap(xmlNode *node, const std::string &curStream, std::map<std::pair<AudioFocusType, AudioFocusType>,
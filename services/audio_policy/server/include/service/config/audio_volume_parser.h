@@ -25,6 +25,7 @@
 #include "audio_info.h"
 #include "audio_policy_log.h"
 #include "audio_volume_config.h"
+#include "audio_config_cache.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -48,6 +49,9 @@ private:
     void ParseDeviceVolumeInfos(xmlNode *node, std::shared_ptr<StreamVolumeInfo> &streamVolInfo);
     void ParseVolumePoints(xmlNode *node, std::shared_ptr<DeviceVolumeInfo> &deviceVolInfo);
     int32_t ParseVolumeConfig(const char *path, StreamVolumeInfoMap &streamVolumeInfoMap);
+    int32_t LoadVolumeConfig(const char *path, StreamVolumeInfoMap &streamVolumeInfoMap);
+    bool LoadFromCache(AudioConfigCache &cache, StreamVolumeInfoMap &streamVolumeInfoMap);
+    void StoreToCache(AudioConfigCache &cache, const StreamVolumeInfoMap &streamVolumeInfoMap);
     void WriteVolumeConfigErrorEvent();
 };
 } // namespace AudioStandard
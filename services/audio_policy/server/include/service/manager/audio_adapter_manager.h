@@ -180,6 +180,8 @@ public:
 
     void HandleSaveVolume(DeviceType deviceType, AudioStreamType streamType, int32_t volumeLevel);
 
+    void HandleFlushVolume();
+
     void HandleStreamMuteStatus(AudioStreamType streamType, bool mute, StreamUsage streamUsage = STREAM_USAGE_UNKNOWN);
 
     void HandleRingerMode(AudioRingerMode ringerMode);
@@ -244,6 +246,7 @@ private:
     void InitSafeTime(bool isFirstBoot);
     void ConvertSafeTime(void);
     void UpdateSafeVolume();
+    void ScheduleVolumeFlush();
     void CheckAndDealMuteStatus(const DeviceType &deviceType, const AudioStreamType &streamType);
     template<typename T>
     std::vector<uint8_t> TransferTypeToByteArray(const T &t)
@@ -14,6 +14,7 @@
  */
 #ifndef AUDIO_ADAPTER_MANAGER_HANDLER_H
 #define AUDIO_ADAPTER_MANAGER_HANDLER_H
+#include <atomic>
 #include <mutex>
 
 #include "singleton.h"
@@ -41,6 +42,7 @@ public:
         VOLUME_DATABASE_SAVE,
         STREAM_MUTE_STATUS_UPDATE,
         RINGER_MODE_UPDATE,
+        VOLUME_DATABASE_FLUSH,
     };
 
     struct VolumeDataEvent {
@@ -76,6 +78,8 @@ public:
     bool SendStreamMuteStatusUpdate(const AudioStreamType &streamType, const bool &mute,
         const StreamUsage &streamUsage);
     bool SendRingerModeUpdate(const AudioRingerMode &ringerMode);
+    // Flushes the pending volumes after a delay, the volumes saved in the meantime join the same flush.
+    bool SendFlushVolume();
 
 protected:
     void ProcessEvent(const AppExecFwk::InnerEvent::Pointer &event) override;
@@ -86,8 +90,10 @@ private:
     void HandleVolumeDataBaseSave(const AppExecFwk::InnerEvent::Pointer &event);
     void HandleUpdateStreamMuteStatus(const AppExecFwk::InnerEvent::Pointer &event);
     void HandleUpdateRingerMode(const AppExecFwk::InnerEvent::Pointer &event);
+    void HandleVolumeDataBaseFlush(const AppExecFwk::InnerEvent::Pointer &event);
 
     std::mutex runnerMutex_;
+    std::atomic<bool> flushVolumeScheduled_ = false;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -63,6 +63,9 @@ public:
     ErrCode PutIntValue(const std::string &key, int32_t value, std::string tableType = "", bool needNotify = true);
     ErrCode PutLongValue(const std::string &key, int64_t value, std::string tableType = "", bool needNotify = true);
     ErrCode PutBoolValue(const std::string &key, bool value, std::string tableType = "", bool needNotify = true);
+    // Writes all the values with one data share helper.
+    ErrCode PutIntValues(const std::vector<std::pair<std::string, int32_t>> &values, std::string tableType = "",
+        bool needNotify = true);
     bool IsValidKey(const std::string &key);
     sptr<AudioSettingObserver> CreateObserver(const std::string &key, AudioSettingObserver::UpdateFunc &func);
     static void ExecRegisterCb(const sptr<AudioSettingObserver> &observer);
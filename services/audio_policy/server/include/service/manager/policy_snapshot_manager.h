@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POLICY_SNAPSHOT_MANAGER_H
+#define POLICY_SNAPSHOT_MANAGER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "audio_policy_snapshot.h"
+#include "audio_shared_memory.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// Owns the shared memory holding the policy snapshot. Code changing any state in the snapshot calls Invalidate,
+// the snapshot is collected again on the next query of the state, so a missed change never shows up as valid.
+class PolicySnapshotManager {
+public:
+    static PolicySnapshotManager &GetInstance();
+
+    int32_t Init();
+
+    // Cheap and lock free apart from the writer lock, it may be called with any other lock held.
+    void Invalidate();
+
+    // Returns true and the current generation if the snapshot needs to be collected again.
+    bool NeedRefresh(uint64_t &generation);
+
+    // Publishes data collected at the generation, dropped if the state changed while collecting.
+    void Publish(PolicySnapshotData &data, uint64_t generation);
+
+    int32_t GetSnapshotFd(int32_t &fd, uint64_t &size);
+
+private:
+    PolicySnapshotManager() = default;
+
+    std::mutex writeMutex_;
+    std::shared_ptr<AudioSharedMemory> snapshotMemory_ = nullptr;
+    PolicySnapshotRegion *region_ = nullptr;
+    bool isPublishedValid_ = false;
+    std::atomic<uint64_t> generation_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // POLICY_SNAPSHOT_MANAGER_H
@@ -16,6 +16,7 @@
 #define VOLUME_DATA_MAINTAINER_H
 
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <cinttypes>
 
@@ -31,6 +32,15 @@ namespace OHOS {
 namespace AudioStandard {
 constexpr int32_t MAX_SAFE_STATUS = 2;
 
+struct VolumeSaveStats {
+    uint64_t savedCount = 0; // SaveVolume calls
+    uint64_t coalescedCount = 0; // saves replacing a pending value of the same key
+    uint64_t flushedCount = 0; // values written to the database
+    uint64_t flushBatchCount = 0;
+    uint64_t failedCount = 0;
+    size_t pendingCount = 0;
+};
+
 class VolumeDataMaintainer {
 public:
     enum VolumeDataMaintainerStreamType {  // define with Dual framework
@@ -59,7 +69,11 @@ public:
     bool SetFirstBoot(bool fristBoot);
     bool GetFirstBoot(bool &firstBoot);
 
+    // The volume is kept in memory and written to the database by FlushVolume, the latest value of a key wins.
     bool SaveVolume(DeviceType type, AudioStreamType streamType, int32_t volumeLevel);
+    // Writes the pending volumes in one batch. Returns false if they are kept for the next flush.
+    bool FlushVolume();
+    VolumeSaveStats GetVolumeSaveStats();
     bool GetVolume(DeviceType deviceType, AudioStreamType streamType);
     void SetStreamVolume(AudioStreamType streamType, int32_t volumeLevel);
     int32_t GetStreamVolume(AudioStreamType streamType);
@@ -105,6 +119,11 @@ private:
     std::unordered_map<AudioStreamType, bool> muteStatusMap_; // save volume Mutestatus map
     std::unordered_map<AudioStreamType, int32_t> volumeLevelMap_; // save volume map
     bool isSettingsCloneHaveStarted_ = false;
+
+    // guards the pending volumes only, never held across a database call
+    std::mutex pendingVolumeMutex_;
+    std::map<std::string, int32_t> pendingVolumeMap_;
+    VolumeSaveStats volumeSaveStats_;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ST_AUDIO_ROUTE_CACHE_H
+#define ST_AUDIO_ROUTE_CACHE_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "audio_device_info.h"
+#include "audio_info.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// Clients without an app selected device share one bucket, their routes only differ by the other fields.
+constexpr int32_t ROUTE_CACHE_SHARED_UID_BUCKET = -1;
+
+struct AudioRouteCacheKey {
+    StreamUsage streamUsage = STREAM_USAGE_UNKNOWN;
+    int32_t uidBucket = ROUTE_CACHE_SHARED_UID_BUCKET;
+    AudioScene audioScene = AUDIO_SCENE_DEFAULT;
+    AudioRingerMode ringerMode = RINGER_MODE_NORMAL;
+
+    bool operator<(const AudioRouteCacheKey &other) const;
+};
+
+// Memoizes output routes of the router center. Anything the routers read besides the key fields bumps the
+// generation by Invalidate: device connection and state changes, user and app selections, the cast routing role
+// and the default output device of sessions. Entries of an old generation are never returned.
+class AudioRouteCache {
+public:
+    static AudioRouteCache &GetInstance();
+
+    void Invalidate();
+
+    // Read it before fetching the route, a route fetched across an invalidation is not stored.
+    uint64_t GetGeneration() const;
+
+    bool Find(const AudioRouteCacheKey &key, std::vector<std::unique_ptr<AudioDeviceDescriptor>> &descs);
+    void Store(const AudioRouteCacheKey &key, uint64_t generation,
+        const std::vector<std::unique_ptr<AudioDeviceDescriptor>> &descs);
+
+    void Dump(std::string &dumpString);
+
+private:
+    AudioRouteCache() = default;
+
+    std::mutex cacheMutex_;
+    std::map<AudioRouteCacheKey, std::vector<AudioDeviceDescriptor>> routes_;
+    uint64_t routesGeneration_ = 0;
+    std::atomic<uint64_t> generation_ = 0;
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // ST_AUDIO_ROUTE_CACHE_H
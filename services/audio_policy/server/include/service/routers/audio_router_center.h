@@ -105,6 +105,7 @@ private:
     unique_ptr<AudioDeviceDescriptor> FetchCallRenderDevice(StreamUsage streamUsage, int32_t clientUID,
         RouterType &routerType);
     bool HasScoDevice();
+    bool IsRouteCacheable(AudioScene audioScene);
     vector<unique_ptr<AudioDeviceDescriptor>> FetchRingRenderDevices(StreamUsage streamUsage, int32_t clientUID,
         RouterType &routerType);
     void DealRingRenderRouters(std::vector<std::unique_ptr<AudioDeviceDescriptor>> &descs,
@@ -172,6 +172,7 @@ const char *g_audioPolicyCodeStrs[] = {
     "SET_DEFAULT_OUTPUT_DEVICE",
     "GET_OUTPUT_DEVICE",
     "GET_INPUT_DEVICE",
+    "GET_POLICY_SNAPSHOT",
 };
 
 constexpr size_t codeNums = sizeof(g_audioPolicyCodeStrs) / sizeof(const char *);
@@ -1323,6 +1324,9 @@ void AudioPolicyManagerStub::OnMiddleNinRemoteRequest(
         case static_cast<uint32_t>(AudioPolicyInterfaceCode::GET_INPUT_DEVICE):
             GetInputDeviceInternal(data, reply);
             break;
+        case static_cast<uint32_t>(AudioPolicyInterfaceCode::GET_POLICY_SNAPSHOT):
+            GetPolicySnapshotInternal(data, reply);
+            break;
         case static_cast<uint32_t>(AudioPolicyInterfaceCode::IS_SPATIALIZATION_ENABLED_FOR_DEVICE):
             IsSpatializationEnabledForDeviceInternal(data, reply);
             break;
@@ -2131,5 +2135,17 @@ void AudioPolicyManagerStub::GetInputDeviceInternal(MessageParcel &data, Message
     }
 }
 
+void AudioPolicyManagerStub::GetPolicySnapshotInternal(MessageParcel & /* data */, MessageParcel &reply)
+{
+    int32_t fd = -1;
+    uint64_t size = 0;
+    int32_t ret = GetPolicySnapshot(fd, size);
+    reply.WriteInt32(ret);
+    if (ret == SUCCESS) {
+        reply.WriteFileDescriptor(fd);
+        reply.WriteUint64(size);
+    }
+}
+
 } // namespace audio_policy
 } // namespace OHOS
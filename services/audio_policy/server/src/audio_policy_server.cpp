@@ -31,6 +31,7 @@
 #include "parameters.h"
 #include "media_monitor_manager.h"
 #include "client_type_manager.h"
+#include "audio_route_cache.h"
 
 using OHOS::Security::AccessToken::PrivacyKit;
 using OHOS::Security::AccessToken::TokenIdKit;
@@ -594,6 +595,7 @@ int32_t AudioPolicyServer::SetSystemVolumeLevel(AudioStreamType streamType, int3
 
 int32_t AudioPolicyServer::GetSystemVolumeLevel(AudioStreamType streamType)
 {
+    audioPolicyService_.RefreshPolicySnapshot();
     return GetSystemVolumeLevelInternal(streamType);
 }
 
@@ -856,6 +858,7 @@ bool AudioPolicyServer::GetStreamMute(AudioStreamType streamType)
         CHECK_AND_RETURN_RET_LOG(ret, false,
             "GetStreamMute permission denied for stream type : %{public}d", streamType);
     }
+    audioPolicyService_.RefreshPolicySnapshot();
 
     return GetStreamMuteInternal(streamType);
 }
@@ -1043,11 +1046,13 @@ bool AudioPolicyServer::IsDeviceActive(InternalDeviceType deviceType)
 
 InternalDeviceType AudioPolicyServer::GetActiveOutputDevice()
 {
+    audioPolicyService_.RefreshPolicySnapshot();
     return audioPolicyService_.GetActiveOutputDevice();
 }
 
 InternalDeviceType AudioPolicyServer::GetActiveInputDevice()
 {
+    audioPolicyService_.RefreshPolicySnapshot();
     return audioPolicyService_.GetActiveInputDevice();
 }
 
@@ -1238,6 +1243,7 @@ bool AudioPolicyServer::IsMicrophoneMute()
 
 AudioRingerMode AudioPolicyServer::GetRingerMode()
 {
+    audioPolicyService_.RefreshPolicySnapshot();
     return audioPolicyService_.GetRingerMode();
 }
 
@@ -1261,10 +1267,16 @@ int32_t AudioPolicyServer::SetAudioSceneInternal(AudioScene audioScene)
 
 AudioScene AudioPolicyServer::GetAudioScene()
 {
+    audioPolicyService_.RefreshPolicySnapshot();
     bool hasSystemPermission = PermissionUtil::VerifySystemPermission();
     return audioPolicyService_.GetAudioScene(hasSystemPermission);
 }
 
+int32_t AudioPolicyServer::GetPolicySnapshot(int32_t &fd, uint64_t &size)
+{
+    return audioPolicyService_.GetPolicySnapshot(fd, size);
+}
+
 int32_t AudioPolicyServer::SetAudioInterruptCallback(const uint32_t sessionID, const sptr<IRemoteObject> &object,
     uint32_t clientUid, const int32_t zoneID)
 {
@@ -1502,6 +1514,7 @@ void AudioPolicyServer::PolicyDataDump(std::string &dumpString)
 void AudioPolicyServer::AudioDevicesDump(std::string &dumpString)
 {
     audioPolicyService_.DevicesInfoDump(dumpString);
+    AudioRouteCache::GetInstance().Dump(dumpString);
 }
 
 void AudioPolicyServer::AudioModeDump(std::string &dumpString)
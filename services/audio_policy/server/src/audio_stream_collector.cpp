@@ -128,6 +128,7 @@ int32_t AudioStreamCollector::AddRendererStream(AudioStreamChangeInfo &streamCha
     rendererChangeInfo->rendererInfo = streamChangeInfo.audioRendererChangeInfo.rendererInfo;
     rendererChangeInfo->outputDeviceInfo = streamChangeInfo.audioRendererChangeInfo.outputDeviceInfo;
     rendererChangeInfo->channelCount = streamChangeInfo.audioRendererChangeInfo.channelCount;
+    AddRendererIndex(rendererChangeInfo.get());
     audioRendererChangeInfos_.push_back(move(rendererChangeInfo));
 
     CHECK_AND_RETURN_RET_LOG(audioPolicyServerHandler_ != nullptr, ERR_MEMORY_ALLOC_FAILED,
@@ -140,40 +141,31 @@ int32_t AudioStreamCollector::AddRendererStream(AudioStreamChangeInfo &streamCha
 void AudioStreamCollector::GetRendererStreamInfo(AudioStreamChangeInfo &streamChangeInfo,
     AudioRendererChangeInfo &rendererInfo)
 {
-    for (auto it = audioRendererChangeInfos_.begin(); it != audioRendererChangeInfos_.end(); it++) {
-        if ((*it)->clientUID == streamChangeInfo.audioRendererChangeInfo.clientUID &&
-            (*it)->sessionId == streamChangeInfo.audioRendererChangeInfo.sessionId) {
-            rendererInfo.outputDeviceInfo = (*it)->outputDeviceInfo;
-            return;
-        }
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(streamChangeInfo.audioRendererChangeInfo.sessionId);
+    if (changeInfo != nullptr && changeInfo->clientUID == streamChangeInfo.audioRendererChangeInfo.clientUID) {
+        rendererInfo.outputDeviceInfo = changeInfo->outputDeviceInfo;
     }
 }
 
 void AudioStreamCollector::GetCapturerStreamInfo(AudioStreamChangeInfo &streamChangeInfo,
     AudioCapturerChangeInfo &capturerInfo)
 {
-    for (auto it = audioCapturerChangeInfos_.begin(); it != audioCapturerChangeInfos_.end(); it++) {
-        if ((*it)->clientUID == streamChangeInfo.audioCapturerChangeInfo.clientUID &&
-            (*it)->sessionId == streamChangeInfo.audioCapturerChangeInfo.sessionId) {
-            capturerInfo.inputDeviceInfo = (*it)->inputDeviceInfo;
-            return;
-        }
+    AudioCapturerChangeInfo *changeInfo = FindCapturerChangeInfo(streamChangeInfo.audioCapturerChangeInfo.sessionId);
+    if (changeInfo != nullptr && changeInfo->clientUID == streamChangeInfo.audioCapturerChangeInfo.clientUID) {
+        capturerInfo.inputDeviceInfo = changeInfo->inputDeviceInfo;
     }
 }
 
 int32_t AudioStreamCollector::GetPipeType(const int32_t sessionId, AudioPipeType &pipeType)
 {
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    const auto &it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
-        [&sessionId](const std::unique_ptr<AudioRendererChangeInfo> &changeInfo) {
-            return changeInfo->sessionId == sessionId;
-        });
-    if (it == audioRendererChangeInfos_.end()) {
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo == nullptr) {
         AUDIO_WARNING_LOG("invalid session id: %{public}d", sessionId);
         return ERROR;
     }
 
-    pipeType = (*it)->rendererInfo.pipeType;
+    pipeType = changeInfo->rendererInfo.pipeType;
     return SUCCESS;
 }
 
@@ -192,15 +184,12 @@ bool AudioStreamCollector::ExistStreamForPipe(AudioPipeType pipeType)
 int32_t AudioStreamCollector::GetRendererDeviceInfo(const int32_t sessionId, DeviceInfo &outputDeviceInfo)
 {
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    const auto &it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
-        [&sessionId](const std::unique_ptr<AudioRendererChangeInfo> &changeInfo) {
-            return changeInfo->sessionId == sessionId;
-        });
-    if (it == audioRendererChangeInfos_.end()) {
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo == nullptr) {
         AUDIO_WARNING_LOG("invalid session id: %{public}d", sessionId);
         return ERROR;
     }
-    outputDeviceInfo = (*it)->outputDeviceInfo;
+    outputDeviceInfo = changeInfo->outputDeviceInfo;
     return SUCCESS;
 }
 
@@ -228,6 +217,7 @@ int32_t AudioStreamCollector::AddCapturerStream(AudioStreamChangeInfo &streamCha
     capturerChangeInfo->capturerState = streamChangeInfo.audioCapturerChangeInfo.capturerState;
     capturerChangeInfo->capturerInfo = streamChangeInfo.audioCapturerChangeInfo.capturerInfo;
     capturerChangeInfo->inputDeviceInfo = streamChangeInfo.audioCapturerChangeInfo.inputDeviceInfo;
+    AddCapturerIndex(capturerChangeInfo.get());
     audioCapturerChangeInfos_.push_back(move(capturerChangeInfo));
 
     CHECK_AND_RETURN_RET_LOG(audioPolicyServerHandler_ != nullptr, ERR_MEMORY_ALLOC_FAILED,
@@ -295,6 +285,8 @@ void AudioStreamCollector::SetCapturerStreamParam(AudioStreamChangeInfo &streamC
 void AudioStreamCollector::ResetRendererStreamDeviceInfo(const AudioDeviceDescriptor& updatedDesc)
 {
     AUDIO_INFO_LOG("ResetRendererStreamDeviceInfo, deviceType:[%{public}d]", updatedDesc.deviceType_);
+    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
+    rendererSnapshot_ = nullptr;
     for (auto it = audioRendererChangeInfos_.begin(); it != audioRendererChangeInfos_.end(); it++) {
         if ((*it)->outputDeviceInfo.deviceType == updatedDesc.deviceType_ &&
             (*it)->outputDeviceInfo.macAddress == updatedDesc.macAddress_ &&
@@ -309,6 +301,8 @@ void AudioStreamCollector::ResetRendererStreamDeviceInfo(const AudioDeviceDescri
 void AudioStreamCollector::ResetCapturerStreamDeviceInfo(const AudioDeviceDescriptor& updatedDesc)
 {
     AUDIO_INFO_LOG("ResetCapturerStreamDeviceInfo, deviceType:[%{public}d]", updatedDesc.deviceType_);
+    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
+    capturerSnapshot_ = nullptr;
     for (auto it = audioCapturerChangeInfos_.begin(); it != audioCapturerChangeInfos_.end(); it++) {
         if ((*it)->inputDeviceInfo.deviceType == updatedDesc.deviceType_ &&
             (*it)->inputDeviceInfo.macAddress == updatedDesc.macAddress_ &&
@@ -338,21 +332,17 @@ bool AudioStreamCollector::CheckRendererStateInfoChanged(AudioStreamChangeInfo &
 
 bool AudioStreamCollector::CheckRendererInfoChanged(AudioStreamChangeInfo &streamChangeInfo)
 {
-    int32_t sessionId = streamChangeInfo.audioRendererChangeInfo.sessionId;
-    const auto &it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
-        [&sessionId](const std::unique_ptr<AudioRendererChangeInfo> &changeInfo) {
-            return changeInfo->sessionId == sessionId;
-        });
-    if (it == audioRendererChangeInfos_.end()) {
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(streamChangeInfo.audioRendererChangeInfo.sessionId);
+    if (changeInfo == nullptr) {
         return true;
     }
 
     bool changed = false;
-    bool isOffloadAllowed = (*it)->rendererInfo.isOffloadAllowed;
+    bool isOffloadAllowed = changeInfo->rendererInfo.isOffloadAllowed;
     if (isOffloadAllowed != streamChangeInfo.audioRendererChangeInfo.rendererInfo.isOffloadAllowed) {
         changed = true;
     }
-    AudioPipeType pipeType = (*it)->rendererInfo.pipeType;
+    AudioPipeType pipeType = changeInfo->rendererInfo.pipeType;
     if (pipeType != streamChangeInfo.audioRendererChangeInfo.rendererInfo.pipeType) {
         changed = true;
     }
@@ -369,43 +359,47 @@ int32_t AudioStreamCollector::UpdateRendererStream(AudioStreamChangeInfo &stream
     CHECK_AND_RETURN_RET(stateChanged || infoChanged, SUCCESS);
 
     // Update the renderer info in audioRendererChangeInfos_
-    for (auto it = audioRendererChangeInfos_.begin(); it != audioRendererChangeInfos_.end(); it++) {
-        AudioRendererChangeInfo audioRendererChangeInfo = **it;
-        if (audioRendererChangeInfo.clientUID == streamChangeInfo.audioRendererChangeInfo.clientUID &&
-            audioRendererChangeInfo.sessionId == streamChangeInfo.audioRendererChangeInfo.sessionId) {
-            rendererStatequeue_[make_pair(audioRendererChangeInfo.clientUID, audioRendererChangeInfo.sessionId)] =
-                streamChangeInfo.audioRendererChangeInfo.rendererState;
-            streamChangeInfo.audioRendererChangeInfo.rendererInfo.pipeType = (*it)->rendererInfo.pipeType;
-            AUDIO_DEBUG_LOG("update client %{public}d session %{public}d", audioRendererChangeInfo.clientUID,
-                audioRendererChangeInfo.sessionId);
-            unique_ptr<AudioRendererChangeInfo> rendererChangeInfo = make_unique<AudioRendererChangeInfo>();
-            CHECK_AND_RETURN_RET_LOG(rendererChangeInfo != nullptr, ERR_MEMORY_ALLOC_FAILED,
-                "Memory Allocation Failed");
-            SetRendererStreamParam(streamChangeInfo, rendererChangeInfo);
-            rendererChangeInfo->channelCount = (*it)->channelCount;
-            if (rendererChangeInfo->outputDeviceInfo.deviceType == DEVICE_TYPE_INVALID) {
-                streamChangeInfo.audioRendererChangeInfo.outputDeviceInfo = (*it)->outputDeviceInfo;
-                rendererChangeInfo->outputDeviceInfo = (*it)->outputDeviceInfo;
-            }
-            *it = move(rendererChangeInfo);
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(streamChangeInfo.audioRendererChangeInfo.sessionId);
+    if (changeInfo == nullptr || changeInfo->clientUID != streamChangeInfo.audioRendererChangeInfo.clientUID) {
+        AUDIO_INFO_LOG("UpdateRendererStream: Not found clientUid:%{public}d sessionId:%{public}d",
+            streamChangeInfo.audioRendererChangeInfo.clientUID, streamChangeInfo.audioRendererChangeInfo.sessionId);
+        return SUCCESS;
+    }
+    int32_t clientUID = changeInfo->clientUID;
+    int32_t sessionId = changeInfo->sessionId;
+    rendererStatequeue_[make_pair(clientUID, sessionId)] = streamChangeInfo.audioRendererChangeInfo.rendererState;
+    streamChangeInfo.audioRendererChangeInfo.rendererInfo.pipeType = changeInfo->rendererInfo.pipeType;
+    AUDIO_DEBUG_LOG("update client %{public}d session %{public}d", clientUID, sessionId);
+    unique_ptr<AudioRendererChangeInfo> rendererChangeInfo = make_unique<AudioRendererChangeInfo>();
+    CHECK_AND_RETURN_RET_LOG(rendererChangeInfo != nullptr, ERR_MEMORY_ALLOC_FAILED, "Memory Allocation Failed");
+    SetRendererStreamParam(streamChangeInfo, rendererChangeInfo);
+    rendererChangeInfo->channelCount = changeInfo->channelCount;
+    if (rendererChangeInfo->outputDeviceInfo.deviceType == DEVICE_TYPE_INVALID) {
+        streamChangeInfo.audioRendererChangeInfo.outputDeviceInfo = changeInfo->outputDeviceInfo;
+        rendererChangeInfo->outputDeviceInfo = changeInfo->outputDeviceInfo;
+    }
+    // Replaced in place so the indexes keep pointing at it, usage may have changed so reindex
+    RemoveRendererIndex(changeInfo);
+    *changeInfo = move(*rendererChangeInfo);
+    AddRendererIndex(changeInfo);
 
-            if (audioPolicyServerHandler_ != nullptr && stateChanged) {
-                audioPolicyServerHandler_->SendRendererInfoEvent(audioRendererChangeInfos_);
-            }
-            AudioSpatializationService::GetAudioSpatializationService().UpdateRendererInfo(audioRendererChangeInfos_);
+    if (audioPolicyServerHandler_ != nullptr && stateChanged) {
+        audioPolicyServerHandler_->SendRendererInfoEvent(audioRendererChangeInfos_);
+    }
+    AudioSpatializationService::GetAudioSpatializationService().UpdateRendererInfo(audioRendererChangeInfos_);
 
-            if (streamChangeInfo.audioRendererChangeInfo.rendererState == RENDERER_RELEASED) {
-                audioRendererChangeInfos_.erase(it);
-                rendererStatequeue_.erase(make_pair(audioRendererChangeInfo.clientUID,
-                    audioRendererChangeInfo.sessionId));
-                clientTracker_.erase(audioRendererChangeInfo.sessionId);
-            }
-            return SUCCESS;
+    if (streamChangeInfo.audioRendererChangeInfo.rendererState == RENDERER_RELEASED) {
+        RemoveRendererIndex(changeInfo);
+        auto it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
+            [changeInfo](const std::unique_ptr<AudioRendererChangeInfo> &info) {
+                return info.get() == changeInfo;
+            });
+        if (it != audioRendererChangeInfos_.end()) {
+            audioRendererChangeInfos_.erase(it);
         }
+        rendererStatequeue_.erase(make_pair(clientUID, sessionId));
+        clientTracker_.erase(sessionId);
     }
-
-    AUDIO_INFO_LOG("UpdateRendererStream: Not found clientUid:%{public}d sessionId:%{public}d",
-        streamChangeInfo.audioRendererChangeInfo.clientUID, streamChangeInfo.audioRendererChangeInfo.clientUID);
     return SUCCESS;
 }
 
@@ -413,14 +407,12 @@ int32_t AudioStreamCollector::UpdateRendererStream(AudioStreamChangeInfo &stream
 int32_t AudioStreamCollector::UpdateRendererStreamInternal(AudioStreamChangeInfo &streamChangeInfo)
 {
     // Update the renderer internal info in audioRendererChangeInfos_
-    for (auto it = audioRendererChangeInfos_.begin(); it != audioRendererChangeInfos_.end(); it++) {
-        AudioRendererChangeInfo audioRendererChangeInfo = **it;
-        if ((*it)->clientUID == streamChangeInfo.audioRendererChangeInfo.clientUID &&
-            (*it)->sessionId == streamChangeInfo.audioRendererChangeInfo.sessionId) {
-            AUDIO_DEBUG_LOG("update client %{public}d session %{public}d", (*it)->clientUID, (*it)->sessionId);
-            (*it)->prerunningState = streamChangeInfo.audioRendererChangeInfo.prerunningState;
-            return SUCCESS;
-        }
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(streamChangeInfo.audioRendererChangeInfo.sessionId);
+    if (changeInfo != nullptr && changeInfo->clientUID == streamChangeInfo.audioRendererChangeInfo.clientUID) {
+        AUDIO_DEBUG_LOG("update client %{public}d session %{public}d", changeInfo->clientUID, changeInfo->sessionId);
+        changeInfo->prerunningState = streamChangeInfo.audioRendererChangeInfo.prerunningState;
+        rendererSnapshot_ = nullptr;
+        return SUCCESS;
     }
 
     AUDIO_ERR_LOG("Not found clientUid:%{public}d sessionId:%{public}d",
@@ -445,41 +437,45 @@ int32_t AudioStreamCollector::UpdateCapturerStream(AudioStreamChangeInfo &stream
     }
 
     // Update the capturer info in audioCapturerChangeInfos_
-    for (auto it = audioCapturerChangeInfos_.begin(); it != audioCapturerChangeInfos_.end(); it++) {
-        AudioCapturerChangeInfo audioCapturerChangeInfo = **it;
-        if (audioCapturerChangeInfo.clientUID == streamChangeInfo.audioCapturerChangeInfo.clientUID &&
-            audioCapturerChangeInfo.sessionId == streamChangeInfo.audioCapturerChangeInfo.sessionId) {
-            capturerStatequeue_[make_pair(audioCapturerChangeInfo.clientUID, audioCapturerChangeInfo.sessionId)] =
-                streamChangeInfo.audioCapturerChangeInfo.capturerState;
-
-            AUDIO_DEBUG_LOG("Session is updated for client %{public}d session %{public}d",
-                streamChangeInfo.audioCapturerChangeInfo.clientUID,
-                streamChangeInfo.audioCapturerChangeInfo.sessionId);
-
-            unique_ptr<AudioCapturerChangeInfo> capturerChangeInfo = make_unique<AudioCapturerChangeInfo>();
-            CHECK_AND_RETURN_RET_LOG(capturerChangeInfo != nullptr,
-                ERR_MEMORY_ALLOC_FAILED, "CapturerChangeInfo Memory Allocation Failed");
-            SetCapturerStreamParam(streamChangeInfo, capturerChangeInfo);
-            if (capturerChangeInfo->inputDeviceInfo.deviceType == DEVICE_TYPE_INVALID) {
-                streamChangeInfo.audioCapturerChangeInfo.inputDeviceInfo = (*it)->inputDeviceInfo;
-                capturerChangeInfo->inputDeviceInfo = (*it)->inputDeviceInfo;
-            }
-            capturerChangeInfo->appTokenId = (*it)->appTokenId;
-            *it = move(capturerChangeInfo);
-            if (audioPolicyServerHandler_ != nullptr) {
-                audioPolicyServerHandler_->SendCapturerInfoEvent(audioCapturerChangeInfos_);
-            }
-            if (streamChangeInfo.audioCapturerChangeInfo.capturerState ==  CAPTURER_RELEASED) {
-                audioCapturerChangeInfos_.erase(it);
-                capturerStatequeue_.erase(make_pair(audioCapturerChangeInfo.clientUID,
-                    audioCapturerChangeInfo.sessionId));
-                clientTracker_.erase(audioCapturerChangeInfo.sessionId);
-            }
-            return SUCCESS;
+    AudioCapturerChangeInfo *changeInfo = FindCapturerChangeInfo(streamChangeInfo.audioCapturerChangeInfo.sessionId);
+    if (changeInfo == nullptr || changeInfo->clientUID != streamChangeInfo.audioCapturerChangeInfo.clientUID) {
+        AUDIO_DEBUG_LOG("UpdateCapturerStream: clientUI not in audioCapturerChangeInfos_::%{public}d",
+            streamChangeInfo.audioCapturerChangeInfo.clientUID);
+        return SUCCESS;
+    }
+    int32_t clientUID = changeInfo->clientUID;
+    int32_t sessionId = changeInfo->sessionId;
+    capturerStatequeue_[make_pair(clientUID, sessionId)] = streamChangeInfo.audioCapturerChangeInfo.capturerState;
+
+    AUDIO_DEBUG_LOG("Session is updated for client %{public}d session %{public}d", clientUID, sessionId);
+
+    unique_ptr<AudioCapturerChangeInfo> capturerChangeInfo = make_unique<AudioCapturerChangeInfo>();
+    CHECK_AND_RETURN_RET_LOG(capturerChangeInfo != nullptr,
+        ERR_MEMORY_ALLOC_FAILED, "CapturerChangeInfo Memory Allocation Failed");
+    SetCapturerStreamParam(streamChangeInfo, capturerChangeInfo);
+    if (capturerChangeInfo->inputDeviceInfo.deviceType == DEVICE_TYPE_INVALID) {
+        streamChangeInfo.audioCapturerChangeInfo.inputDeviceInfo = changeInfo->inputDeviceInfo;
+        capturerChangeInfo->inputDeviceInfo = changeInfo->inputDeviceInfo;
+    }
+    capturerChangeInfo->appTokenId = changeInfo->appTokenId;
+    RemoveCapturerIndex(changeInfo);
+    *changeInfo = move(*capturerChangeInfo);
+    AddCapturerIndex(changeInfo);
+    if (audioPolicyServerHandler_ != nullptr) {
+        audioPolicyServerHandler_->SendCapturerInfoEvent(audioCapturerChangeInfos_);
+    }
+    if (streamChangeInfo.audioCapturerChangeInfo.capturerState ==  CAPTURER_RELEASED) {
+        RemoveCapturerIndex(changeInfo);
+        auto it = std::find_if(audioCapturerChangeInfos_.begin(), audioCapturerChangeInfos_.end(),
+            [changeInfo](const std::unique_ptr<AudioCapturerChangeInfo> &info) {
+                return info.get() == changeInfo;
+            });
+        if (it != audioCapturerChangeInfos_.end()) {
+            audioCapturerChangeInfos_.erase(it);
         }
+        capturerStatequeue_.erase(make_pair(clientUID, sessionId));
+        clientTracker_.erase(sessionId);
     }
-    AUDIO_DEBUG_LOG("UpdateCapturerStream: clientUI not in audioCapturerChangeInfos_::%{public}d",
-        streamChangeInfo.audioCapturerChangeInfo.clientUID);
     return SUCCESS;
 }
 
@@ -496,6 +492,9 @@ int32_t AudioStreamCollector::UpdateRendererDeviceInfo(DeviceInfo &outputDeviceI
         }
     }
 
+    if (deviceInfoUpdated) {
+        rendererSnapshot_ = nullptr;
+    }
     if (deviceInfoUpdated && audioPolicyServerHandler_ != nullptr) {
         audioPolicyServerHandler_->SendRendererInfoEvent(audioRendererChangeInfos_);
     }
@@ -519,6 +518,9 @@ int32_t AudioStreamCollector::UpdateCapturerDeviceInfo(DeviceInfo &inputDeviceIn
         }
     }
 
+    if (deviceInfoUpdated) {
+        capturerSnapshot_ = nullptr;
+    }
     if (deviceInfoUpdated && audioPolicyServerHandler_ != nullptr) {
         audioPolicyServerHandler_->SendCapturerInfoEvent(audioCapturerChangeInfos_);
     }
@@ -532,13 +534,13 @@ int32_t AudioStreamCollector::UpdateRendererDeviceInfo(int32_t clientUID, int32_
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
     bool deviceInfoUpdated = false;
 
-    for (auto it = audioRendererChangeInfos_.begin(); it != audioRendererChangeInfos_.end(); it++) {
-        if ((*it)->clientUID == clientUID && (*it)->sessionId == sessionId) {
-            AUDIO_DEBUG_LOG("uid %{public}d sessionId %{public}d update device: old %{public}d, new %{public}d",
-                clientUID, sessionId, (*it)->outputDeviceInfo.deviceType, outputDeviceInfo.deviceType);
-            (*it)->outputDeviceInfo = outputDeviceInfo;
-            deviceInfoUpdated = true;
-        }
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo != nullptr && changeInfo->clientUID == clientUID) {
+        AUDIO_DEBUG_LOG("uid %{public}d sessionId %{public}d update device: old %{public}d, new %{public}d",
+            clientUID, sessionId, changeInfo->outputDeviceInfo.deviceType, outputDeviceInfo.deviceType);
+        changeInfo->outputDeviceInfo = outputDeviceInfo;
+        rendererSnapshot_ = nullptr;
+        deviceInfoUpdated = true;
     }
 
     if (deviceInfoUpdated && audioPolicyServerHandler_ != nullptr) {
@@ -555,13 +557,13 @@ int32_t AudioStreamCollector::UpdateRendererPipeInfo(const int32_t sessionId, co
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
     bool pipeTypeUpdated = false;
 
-    for (auto it = audioRendererChangeInfos_.begin(); it != audioRendererChangeInfos_.end(); it++) {
-        if ((*it)->sessionId == sessionId && (*it)->rendererInfo.pipeType != pipeType) {
-            AUDIO_INFO_LOG("sessionId %{public}d update pipeType: old %{public}d, new %{public}d",
-                sessionId, (*it)->rendererInfo.pipeType, pipeType);
-            (*it)->rendererInfo.pipeType = pipeType;
-            pipeTypeUpdated = true;
-        }
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo != nullptr && changeInfo->rendererInfo.pipeType != pipeType) {
+        AUDIO_INFO_LOG("sessionId %{public}d update pipeType: old %{public}d, new %{public}d",
+            sessionId, changeInfo->rendererInfo.pipeType, pipeType);
+        changeInfo->rendererInfo.pipeType = pipeType;
+        rendererSnapshot_ = nullptr;
+        pipeTypeUpdated = true;
     }
 
     if (pipeTypeUpdated && audioPolicyServerHandler_ != nullptr) {
@@ -579,13 +581,13 @@ int32_t AudioStreamCollector::UpdateCapturerDeviceInfo(int32_t clientUID, int32_
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
     bool deviceInfoUpdated = false;
 
-    for (auto it = audioCapturerChangeInfos_.begin(); it != audioCapturerChangeInfos_.end(); it++) {
-        if ((*it)->clientUID == clientUID && (*it)->sessionId == sessionId) {
-            AUDIO_DEBUG_LOG("uid %{public}d sessionId %{public}d update device: old %{public}d, new %{public}d",
-                (*it)->clientUID, (*it)->sessionId, (*it)->inputDeviceInfo.deviceType, inputDeviceInfo.deviceType);
-            (*it)->inputDeviceInfo = inputDeviceInfo;
-            deviceInfoUpdated = true;
-        }
+    AudioCapturerChangeInfo *changeInfo = FindCapturerChangeInfo(sessionId);
+    if (changeInfo != nullptr && changeInfo->clientUID == clientUID) {
+        AUDIO_DEBUG_LOG("uid %{public}d sessionId %{public}d update device: old %{public}d, new %{public}d",
+            clientUID, sessionId, changeInfo->inputDeviceInfo.deviceType, inputDeviceInfo.deviceType);
+        changeInfo->inputDeviceInfo = inputDeviceInfo;
+        capturerSnapshot_ = nullptr;
+        deviceInfoUpdated = true;
     }
 
     if (deviceInfoUpdated && audioPolicyServerHandler_ != nullptr) {
@@ -650,10 +652,9 @@ AudioStreamType AudioStreamCollector::GetStreamType(int32_t sessionId)
 {
     AudioStreamType streamType = STREAM_MUSIC;
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    for (const auto &changeInfo : audioRendererChangeInfos_) {
-        if (changeInfo->sessionId == sessionId) {
-            streamType = GetStreamType(changeInfo->rendererInfo.contentType, changeInfo->rendererInfo.streamUsage);
-        }
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo != nullptr) {
+        streamType = GetStreamType(changeInfo->rendererInfo.contentType, changeInfo->rendererInfo.streamUsage);
     }
     return streamType;
 }
@@ -661,27 +662,21 @@ AudioStreamType AudioStreamCollector::GetStreamType(int32_t sessionId)
 bool AudioStreamCollector::IsOffloadAllowed(const int32_t sessionId)
 {
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    const auto &it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
-        [&sessionId](const std::unique_ptr<AudioRendererChangeInfo> &changeInfo) {
-            return changeInfo->sessionId == sessionId;
-        });
-    if (it == audioRendererChangeInfos_.end()) {
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo == nullptr) {
         AUDIO_WARNING_LOG("invalid session id: %{public}d", sessionId);
         return false;
     }
-    return (*it)->rendererInfo.isOffloadAllowed;
+    return changeInfo->rendererInfo.isOffloadAllowed;
 }
 
 int32_t AudioStreamCollector::GetChannelCount(int32_t sessionId)
 {
     int32_t channelCount = 0;
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    const auto &it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
-        [&sessionId](const std::unique_ptr<AudioRendererChangeInfo> &changeInfo) {
-            return changeInfo->sessionId == sessionId;
-        });
-    if (it != audioRendererChangeInfos_.end()) {
-        channelCount = (*it)->channelCount;
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo != nullptr) {
+        channelCount = changeInfo->channelCount;
     }
     return channelCount;
 }
@@ -689,9 +684,10 @@ int32_t AudioStreamCollector::GetChannelCount(int32_t sessionId)
 int32_t AudioStreamCollector::GetCurrentRendererChangeInfos(
     std::vector<unique_ptr<AudioRendererChangeInfo>> &rendererChangeInfos)
 {
-    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    for (const auto &changeInfo : audioRendererChangeInfos_) {
-        rendererChangeInfos.push_back(make_unique<AudioRendererChangeInfo>(*changeInfo));
+    // Callers own and may modify the result, copy it from the snapshot out of the lock
+    shared_ptr<const vector<AudioRendererChangeInfo>> snapshot = GetRendererChangeInfosSnapshot();
+    for (const auto &changeInfo : *snapshot) {
+        rendererChangeInfos.push_back(make_unique<AudioRendererChangeInfo>(changeInfo));
     }
     AUDIO_DEBUG_LOG("GetCurrentRendererChangeInfos returned");
 
@@ -702,15 +698,43 @@ int32_t AudioStreamCollector::GetCurrentCapturerChangeInfos(
     std::vector<unique_ptr<AudioCapturerChangeInfo>> &capturerChangeInfos)
 {
     AUDIO_DEBUG_LOG("GetCurrentCapturerChangeInfos");
-    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    for (const auto &changeInfo : audioCapturerChangeInfos_) {
-        capturerChangeInfos.push_back(make_unique<AudioCapturerChangeInfo>(*changeInfo));
+    shared_ptr<const vector<AudioCapturerChangeInfo>> snapshot = GetCapturerChangeInfosSnapshot();
+    for (const auto &changeInfo : *snapshot) {
+        capturerChangeInfos.push_back(make_unique<AudioCapturerChangeInfo>(changeInfo));
         AUDIO_DEBUG_LOG("GetCurrentCapturerChangeInfos returned");
     }
 
     return SUCCESS;
 }
 
+shared_ptr<const vector<AudioRendererChangeInfo>> AudioStreamCollector::GetRendererChangeInfosSnapshot()
+{
+    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
+    if (rendererSnapshot_ == nullptr) {
+        auto snapshot = make_shared<vector<AudioRendererChangeInfo>>();
+        snapshot->reserve(audioRendererChangeInfos_.size());
+        for (const auto &changeInfo : audioRendererChangeInfos_) {
+            snapshot->push_back(*changeInfo);
+        }
+        rendererSnapshot_ = move(snapshot);
+    }
+    return rendererSnapshot_;
+}
+
+shared_ptr<const vector<AudioCapturerChangeInfo>> AudioStreamCollector::GetCapturerChangeInfosSnapshot()
+{
+    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
+    if (capturerSnapshot_ == nullptr) {
+        auto snapshot = make_shared<vector<AudioCapturerChangeInfo>>();
+        snapshot->reserve(audioCapturerChangeInfos_.size());
+        for (const auto &changeInfo : audioCapturerChangeInfos_) {
+            snapshot->push_back(*changeInfo);
+        }
+        capturerSnapshot_ = move(snapshot);
+    }
+    return capturerSnapshot_;
+}
+
 void AudioStreamCollector::RegisteredRendererTrackerClientDied(const int32_t uid)
 {
     int32_t sessionID = -1;
@@ -731,6 +755,7 @@ void AudioStreamCollector::RegisteredRendererTrackerClientDied(const int32_t uid
         AudioSpatializationService::GetAudioSpatializationService().UpdateRendererInfo(audioRendererChangeInfos_);
         rendererStatequeue_.erase(make_pair(audioRendererChangeInfo->clientUID,
             audioRendererChangeInfo->sessionId));
+        RemoveRendererIndex(audioRendererChangeInfo.get());
 
         auto temp = audioRendererBegin;
         audioRendererBegin = audioRendererChangeInfos_.erase(temp);
@@ -759,6 +784,7 @@ void AudioStreamCollector::RegisteredCapturerTrackerClientDied(const int32_t uid
         }
         capturerStatequeue_.erase(make_pair(audioCapturerChangeInfo->clientUID,
             audioCapturerChangeInfo->sessionId));
+        RemoveCapturerIndex(audioCapturerChangeInfo.get());
         auto temp = audioCapturerBegin;
         audioCapturerBegin = audioCapturerChangeInfos_.erase(temp);
         if ((sessionID != -1) && clientTracker_.erase(sessionID)) {
@@ -793,12 +819,9 @@ int32_t AudioStreamCollector::GetUid(int32_t sessionId)
 {
     int32_t defaultUid = -1;
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    const auto &it = std::find_if(audioRendererChangeInfos_.begin(), audioRendererChangeInfos_.end(),
-        [&sessionId](const std::unique_ptr<AudioRendererChangeInfo> &changeInfo) {
-            return changeInfo->sessionId == sessionId;
-        });
-    if (it != audioRendererChangeInfos_.end()) {
-        defaultUid = (*it)->createrUID;
+    AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+    if (changeInfo != nullptr) {
+        defaultUid = changeInfo->createrUID;
     }
     return defaultUid;
 }
@@ -826,8 +849,11 @@ int32_t AudioStreamCollector::UpdateStreamState(int32_t clientUid,
     StreamSetStateEventInternal &streamSetStateEventInternal)
 {
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
-    for (const auto &changeInfo : audioRendererChangeInfos_) {
-        if (changeInfo->clientUID == clientUid &&
+    auto uidIter = rendererUidIndex_.find(clientUid);
+    CHECK_AND_RETURN_RET(uidIter != rendererUidIndex_.end(), SUCCESS);
+    for (int32_t sessionId : uidIter->second) {
+        AudioRendererChangeInfo *changeInfo = FindRendererChangeInfo(sessionId);
+        if (changeInfo != nullptr &&
             streamSetStateEventInternal.streamUsage == changeInfo->rendererInfo.streamUsage) {
             AUDIO_INFO_LOG("UpdateStreamState Found matching uid=%{public}d and usage=%{public}d",
                 clientUid, streamSetStateEventInternal.streamUsage);
@@ -1017,6 +1043,7 @@ int32_t AudioStreamCollector::UpdateCapturerInfoMuteStatus(int32_t uid, bool mut
     for (auto it = audioCapturerChangeInfos_.begin(); it != audioCapturerChangeInfos_.end(); it++) {
         if ((*it)->clientUID == uid || uid == 0) {
             (*it)->muted = muteStatus;
+            capturerSnapshot_ = nullptr;
             capturerInfoUpdated = true;
             std::shared_ptr<Media::MediaMonitor::EventBean> bean = std::make_shared<Media::MediaMonitor::EventBean>(
                 Media::MediaMonitor::ModuleId::AUDIO, Media::MediaMonitor::EventId::CAPTURE_MUTE_STATUS_CHANGE,
@@ -1218,6 +1245,16 @@ bool AudioStreamCollector::IsCallStreamUsage(StreamUsage usage)
 StreamUsage AudioStreamCollector::GetLastestRunningCallStreamUsage()
 {
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
+    // Most of the time there is no call stream at all, the buckets tell it without a scan
+    bool hasCallStream = false;
+    for (StreamUsage usage : {STREAM_USAGE_VOICE_COMMUNICATION, STREAM_USAGE_VIDEO_COMMUNICATION,
+        STREAM_USAGE_VOICE_MODEM_COMMUNICATION}) {
+        if (rendererUsageIndex_.count(usage) != 0) {
+            hasCallStream = true;
+            break;
+        }
+    }
+    CHECK_AND_RETURN_RET(hasCallStream, STREAM_USAGE_UNKNOWN);
     for (const auto &changeInfo : audioRendererChangeInfos_) {
         StreamUsage usage = changeInfo->rendererInfo.streamUsage;
         RendererState state = changeInfo->rendererState;
@@ -1233,12 +1270,96 @@ std::vector<uint32_t> AudioStreamCollector::GetAllRendererSessionIDForUID(int32_
 {
     std::lock_guard<std::mutex> lock(streamsInfoMutex_);
     std::vector<uint32_t> sessionIDSet;
-    for (const auto &changeInfo : audioRendererChangeInfos_) {
-        if (changeInfo->clientUID == uid) {
-            sessionIDSet.push_back(changeInfo->sessionId);
-        }
+    auto iter = rendererUidIndex_.find(uid);
+    if (iter != rendererUidIndex_.end()) {
+        sessionIDSet.assign(iter->second.begin(), iter->second.end());
+    }
+    return sessionIDSet;
+}
+
+std::vector<uint32_t> AudioStreamCollector::GetAllCapturerSessionIDForUID(int32_t uid)
+{
+    std::lock_guard<std::mutex> lock(streamsInfoMutex_);
+    std::vector<uint32_t> sessionIDSet;
+    auto iter = capturerUidIndex_.find(uid);
+    if (iter != capturerUidIndex_.end()) {
+        sessionIDSet.assign(iter->second.begin(), iter->second.end());
     }
     return sessionIDSet;
 }
+
+template <typename Key>
+static void EraseFromBucket(std::unordered_map<Key, std::set<int32_t>> &index, Key key, int32_t sessionId)
+{
+    auto iter = index.find(key);
+    if (iter == index.end()) {
+        return;
+    }
+    iter->second.erase(sessionId);
+    if (iter->second.empty()) {
+        index.erase(iter);
+    }
+}
+
+void AudioStreamCollector::AddRendererIndex(AudioRendererChangeInfo *changeInfo)
+{
+    CHECK_AND_RETURN_LOG(changeInfo != nullptr, "changeInfo is nullptr");
+    if (rendererSessionIndex_.count(changeInfo->sessionId) != 0) {
+        AUDIO_WARNING_LOG("renderer session %{public}d is indexed already", changeInfo->sessionId);
+    }
+    rendererSessionIndex_[changeInfo->sessionId] = changeInfo;
+    rendererUidIndex_[changeInfo->clientUID].insert(changeInfo->sessionId);
+    rendererUsageIndex_[changeInfo->rendererInfo.streamUsage].insert(changeInfo->sessionId);
+    rendererSnapshot_ = nullptr;
+}
+
+void AudioStreamCollector::RemoveRendererIndex(const AudioRendererChangeInfo *changeInfo)
+{
+    CHECK_AND_RETURN_LOG(changeInfo != nullptr, "changeInfo is nullptr");
+    rendererSnapshot_ = nullptr;
+    auto iter = rendererSessionIndex_.find(changeInfo->sessionId);
+    // a duplicated session that was indexed over keeps the entries of the live one
+    if (iter == rendererSessionIndex_.end() || iter->second != changeInfo) {
+        return;
+    }
+    rendererSessionIndex_.erase(iter);
+    EraseFromBucket(rendererUidIndex_, changeInfo->clientUID, changeInfo->sessionId);
+    EraseFromBucket(rendererUsageIndex_, changeInfo->rendererInfo.streamUsage, changeInfo->sessionId);
+}
+
+void AudioStreamCollector::AddCapturerIndex(AudioCapturerChangeInfo *changeInfo)
+{
+    CHECK_AND_RETURN_LOG(changeInfo != nullptr, "changeInfo is nullptr");
+    if (capturerSessionIndex_.count(changeInfo->sessionId) != 0) {
+        AUDIO_WARNING_LOG("capturer session %{public}d is indexed already", changeInfo->sessionId);
+    }
+    capturerSessionIndex_[changeInfo->sessionId] = changeInfo;
+    capturerUidIndex_[changeInfo->clientUID].insert(changeInfo->sessionId);
+    capturerSnapshot_ = nullptr;
+}
+
+void AudioStreamCollector::RemoveCapturerIndex(const AudioCapturerChangeInfo *changeInfo)
+{
+    CHECK_AND_RETURN_LOG(changeInfo != nullptr, "changeInfo is nullptr");
+    capturerSnapshot_ = nullptr;
+    auto iter = capturerSessionIndex_.find(changeInfo->sessionId);
+    if (iter == capturerSessionIndex_.end() || iter->second != changeInfo) {
+        return;
+    }
+    capturerSessionIndex_.erase(iter);
+    EraseFromBucket(capturerUidIndex_, changeInfo->clientUID, changeInfo->sessionId);
+}
+
+AudioRendererChangeInfo *AudioStreamCollector::FindRendererChangeInfo(int32_t sessionId)
+{
+    auto iter = rendererSessionIndex_.find(sessionId);
+    return iter == rendererSessionIndex_.end() ? nullptr : iter->second;
+}
+
+AudioCapturerChangeInfo *AudioStreamCollector::FindCapturerChangeInfo(int32_t sessionId)
+{
+    auto iter = capturerSessionIndex_.find(sessionId);
+    return iter == capturerSessionIndex_.end() ? nullptr : iter->second;
+}
 } // namespace AudioStandard
 } // namespace OHOS
@@ -20,6 +20,7 @@
 #include "audio_log.h"
 #include "audio_utils.h"
 #include "audio_affinity_parser.h"
+#include "audio_route_cache.h"
 
 using namespace std;
 
@@ -75,6 +76,12 @@ std::unique_ptr<AudioDeviceDescriptor> AudioAffinityManager::GetRendererDevice(i
     }
 }
 
+bool AudioAffinityManager::HasSelectRendererDevice(int32_t clientUID)
+{
+    std::lock_guard<std::mutex> lock(rendererMapMutex_);
+    return activeRendererDeviceMap_.find(clientUID) != activeRendererDeviceMap_.end();
+}
+
 std::unique_ptr<AudioDeviceDescriptor> AudioAffinityManager::GetCapturerDevice(int32_t clientUID)
 {
     std::lock_guard<std::mutex> lock(capturerMapMutex_);
@@ -110,6 +117,7 @@ void AudioAffinityManager::AddSelectRendererDevice(int32_t clientUID, const sptr
 
     affinityDeviceInfoMap[clientUID] = affinityDeviceInfo;
     activeRendererGroupAffinityMap_[affinityDeviceInfo.groupName] = affinityDeviceInfoMap;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioAffinityManager::AddSelectCapturerDevice(int32_t clientUID, const sptr<AudioDeviceDescriptor> &desc)
@@ -140,6 +148,7 @@ void AudioAffinityManager::DelSelectRendererDevice(int32_t clientUID)
         DelActiveGroupAffinityMap(clientUID, item->second->getType(), item->second->networkId_,
             rendererAffinityDeviceArray_, activeRendererGroupAffinityMap_);
         activeRendererDeviceMap_.erase(item);
+        AudioRouteCache::GetInstance().Invalidate();
     }
 }
 
@@ -166,6 +175,7 @@ void AudioAffinityManager::RemoveOfflineRendererDevice(const AudioDeviceDescript
             DelActiveGroupAffinityMap(item->first, item->second->getType(), item->second->networkId_,
                 rendererAffinityDeviceArray_, activeRendererGroupAffinityMap_);
             item = activeRendererDeviceMap_.erase(item);
+            AudioRouteCache::GetInstance().Invalidate();
         } else {
             item++;
         }
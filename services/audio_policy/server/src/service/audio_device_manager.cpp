@@ -21,6 +21,7 @@
 #include "audio_utils.h"
 #include "audio_errors.h"
 #include "audio_device_parser.h"
+#include "audio_route_cache.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -81,6 +82,7 @@ void AudioDeviceManager::OnXmlParsingCompleted(
     if (publicDevices != devicePrivacyMaps_.end()) {
         publicDeviceList_ = publicDevices->second;
     }
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 bool AudioDeviceManager::DeviceAttrMatch(const shared_ptr<AudioDeviceDescriptor> &devDesc,
@@ -382,6 +384,7 @@ void AudioDeviceManager::AddNewDevice(const sptr<AudioDeviceDescriptor> &deviceD
     RemoveVirtualConnectedDevice(devDesc);
     if (UpdateExistDeviceDescriptor(deviceDescriptor)) {
         AUDIO_INFO_LOG("The device has been added and will not be added again.");
+        AudioRouteCache::GetInstance().Invalidate();
         return;
     }
     AddConnectedDevices(devDesc);
@@ -397,6 +400,7 @@ void AudioDeviceManager::AddNewDevice(const sptr<AudioDeviceDescriptor> &deviceD
         AddCaptureDevices(devDesc);
     }
     UpdateDeviceInfo(devDesc);
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 std::string AudioDeviceManager::GetConnDevicesStr()
@@ -449,6 +453,7 @@ void AudioDeviceManager::RemoveNewDevice(const sptr<AudioDeviceDescriptor> &devD
     RemoveCommunicationDevices(devDesc);
     RemoveMediaDevices(devDesc);
     RemoveCaptureDevices(devDesc);
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 vector<unique_ptr<AudioDeviceDescriptor>> AudioDeviceManager::GetRemoteRenderDevices()
@@ -797,6 +802,7 @@ void AudioDeviceManager::UpdateScoState(const std::string &macAddress, bool isCo
             desc->isScoRealConnected_ = isConnnected;
         }
     }
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 bool AudioDeviceManager::GetScoState()
@@ -830,6 +836,7 @@ void AudioDeviceManager::UpdateDevicesListInfo(const sptr<AudioDeviceDescriptor>
         default:
             break;
     }
+    AudioRouteCache::GetInstance().Invalidate();
     if (!ret) {
         int32_t audioId = d->deviceId_;
         AUDIO_ERR_LOG("cant find type:id %{public}d:%{public}d mac:%{public}s networkid:%{public}s in connected list",
@@ -944,6 +951,7 @@ bool AudioDeviceManager::UpdateExceptionFlag(const shared_ptr<AudioDeviceDescrip
 void AudioDeviceManager::UpdateEarpieceStatus(const bool hasEarPiece)
 {
     hasEarpiece_ = hasEarPiece;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioDeviceManager::AddBtToOtherList(const shared_ptr<AudioDeviceDescriptor> &devDesc)
@@ -1052,6 +1060,7 @@ void AudioDeviceManager::OnReceiveBluetoothEvent(const std::string macAddress, c
             device->deviceName_ = deviceName;
         }
     }
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 bool AudioDeviceManager::IsDeviceConnected(sptr<AudioDeviceDescriptor> &audioDeviceDescriptors)
@@ -1113,6 +1122,8 @@ int32_t AudioDeviceManager::SetDefaultOutputDevice(const DeviceType deviceType,
     const StreamUsage streamUsage, bool isRunning)
 {
     std::lock_guard<std::mutex> lock(selectDefaultOutputDeviceMutex_);
+    // the routers read the selection under this lock, so it is safe to invalidate before the change
+    AudioRouteCache::GetInstance().Invalidate();
     selectedDefaultOutputDeviceInfo_[sessionID] = std::make_pair(deviceType, streamUsage);
     if (!isRunning) {
         AUDIO_INFO_LOG("no need to set default output device since current stream has not started");
@@ -1167,6 +1178,8 @@ int32_t AudioDeviceManager::UpdateDefaultOutputDeviceWhenStarting(const uint32_t
         AUDIO_DEBUG_LOG("no need to update default output device since current stream has not set");
         return SUCCESS;
     }
+    // the routers read the selection under this lock, so it is safe to invalidate before the change
+    AudioRouteCache::GetInstance().Invalidate();
     DeviceType deviceType = selectedDefaultOutputDeviceInfo_[sessionID].first;
     StreamUsage streamUsage = selectedDefaultOutputDeviceInfo_[sessionID].second;
     if (streamUsage == STREAM_USAGE_VOICE_MESSAGE) {
@@ -1207,6 +1220,8 @@ int32_t AudioDeviceManager::UpdateDefaultOutputDeviceWhenStopping(const uint32_t
         AUDIO_DEBUG_LOG("no need to update default output device since current stream has not set");
         return SUCCESS;
     }
+    // the routers read the selection under this lock, so it is safe to invalidate before the change
+    AudioRouteCache::GetInstance().Invalidate();
     StreamUsage streamUsage = selectedDefaultOutputDeviceInfo_[sessionID].second;
     if (streamUsage == STREAM_USAGE_VOICE_MESSAGE) {
         // select media default output device
@@ -35,6 +35,8 @@
 #include "audio_dialog_ability_connection.h"
 #include "media_monitor_manager.h"
 #include "client_type_manager.h"
+#include "policy_snapshot_manager.h"
+#include "audio_route_cache.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -356,6 +358,9 @@ bool AudioPolicyService::Init(void)
         sharedAbsVolumeScene_ = reinterpret_cast<bool *>(policyVolumeMap_->GetBase()) +
             IPolicyProvider::GetVolumeVectorSize() * sizeof(Volume);
     }
+    if (PolicySnapshotManager::GetInstance().Init() != SUCCESS) {
+        AUDIO_WARNING_LOG("Init policy snapshot failed, clients query the policy state by ipc");
+    }
 
     CreateRecoveryThread();
     std::string versionType = OHOS::system::GetParameter("const.logsystem.versiontype", "commercial");
@@ -928,6 +933,7 @@ int32_t AudioPolicyService::SetStreamMute(AudioStreamType streamType, bool mute,
             AUDIO_WARNING_LOG("Set failed for macAddress:[%{public}s]", GetEncryptAddr(activeBTDevice_).c_str());
         } else {
             configInfoPos->second.mute = mute;
+            PolicySnapshotManager::GetInstance().Invalidate();
             audioPolicyManager_.SetAbsVolumeMute(mute);
 #ifdef BLUETOOTH_ENABLE
             // set to avrcp device
@@ -1216,11 +1222,9 @@ int32_t AudioPolicyService::SelectOutputDeviceByFilterInner(sptr<AudioRendererFi
         }
     }
     audioAffinityManager_.AddSelectRendererDevice(audioRendererFilter->uid, selectedDesc[0]);
-    vector<unique_ptr<AudioRendererChangeInfo>> rendererChangeInfos;
-    streamCollector_.GetCurrentRendererChangeInfos(rendererChangeInfos);
-    for (auto &changeInfo : rendererChangeInfos) {
-        if (changeInfo->clientUID == audioRendererFilter->uid && changeInfo->sessionId != 0) {
-            RestoreSession(changeInfo->sessionId, true);
+    for (uint32_t sessionId : streamCollector_.GetAllRendererSessionIDForUID(audioRendererFilter->uid)) {
+        if (sessionId != 0) {
+            RestoreSession(sessionId, true);
         }
     }
     return SUCCESS;
@@ -1559,11 +1563,9 @@ int32_t AudioPolicyService::SelectInputDevice(sptr<AudioCapturerFilter> audioCap
     CHECK_AND_RETURN_RET(res == SUCCESS, res);
     if (audioCapturerFilter->uid != -1) {
         audioAffinityManager_.AddSelectCapturerDevice(audioCapturerFilter->uid, selectedDesc[0]);
-        vector<unique_ptr<AudioCapturerChangeInfo>> capturerChangeInfos;
-        streamCollector_.GetCurrentCapturerChangeInfos(capturerChangeInfos);
-        for (auto &changeInfo : capturerChangeInfos) {
-            if (changeInfo->clientUID == audioCapturerFilter->uid && changeInfo->sessionId != 0) {
-                RestoreSession(changeInfo->sessionId, true);
+        for (uint32_t sessionId : streamCollector_.GetAllCapturerSessionIDForUID(audioCapturerFilter->uid)) {
+            if (sessionId != 0) {
+                RestoreSession(sessionId, true);
             }
         }
         return SUCCESS;
@@ -1703,6 +1705,7 @@ void AudioPolicyService::StoreDistributedRoutingRoleInfo(const sptr<AudioDeviceD
 {
     distributedRoutingInfo_.descriptor = descriptor;
     distributedRoutingInfo_.type = type;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 DistributedRoutingInfo& AudioPolicyService::GetDistributedRoutingRoleInfo()
@@ -2348,6 +2351,7 @@ void AudioPolicyService::FetchOutputDeviceWhenNoRunningStream()
         return;
     }
     currentActiveDevice_ = AudioDeviceDescriptor(*descs.front());
+    PolicySnapshotManager::GetInstance().Invalidate();
     AUDIO_DEBUG_LOG("currentActiveDevice update %{public}d", currentActiveDevice_.deviceType_);
     SetVolumeForSwitchDevice(descs.front()->deviceType_);
     if (descs.front()->deviceType_ == DEVICE_TYPE_BLUETOOTH_A2DP) {
@@ -2367,6 +2371,7 @@ void AudioPolicyService::FetchInputDeviceWhenNoRunningStream()
     if (desc->deviceType_ == DEVICE_TYPE_BLUETOOTH_A2DP || desc->deviceType_ == DEVICE_TYPE_BLUETOOTH_SCO) {
         activeBTDevice_ = desc->macAddress_;
     }
+    PolicySnapshotManager::GetInstance().Invalidate();
     AUDIO_DEBUG_LOG("currentActiveInputDevice update %{public}d", currentActiveInputDevice_.deviceType_);
     OnPreferredInputDeviceUpdated(currentActiveInputDevice_.deviceType_, currentActiveInputDevice_.networkId_);
 }
@@ -2495,6 +2500,7 @@ int32_t AudioPolicyService::HandleDeviceChangeForFetchOutputDevice(unique_ptr<Au
         AUDIO_INFO_LOG("stream %{public}d device not change, no need move device", rendererChangeInfo->sessionId);
         if (!IsSameDevice(desc, currentActiveDevice_)) {
             currentActiveDevice_ = AudioDeviceDescriptor(*desc);
+            PolicySnapshotManager::GetInstance().Invalidate();
             SetVolumeForSwitchDevice(currentActiveDevice_.deviceType_);
             UpdateActiveDeviceRoute(currentActiveDevice_.deviceType_, DeviceFlag::OUTPUT_DEVICES_FLAG);
             OnPreferredOutputDeviceUpdated(currentActiveDevice_);
@@ -2510,6 +2516,7 @@ bool AudioPolicyService::UpdateDevice(unique_ptr<AudioDeviceDescriptor> &desc,
     if (!IsSameDevice(desc, currentActiveDevice_)) {
         WriteOutputRouteChangeEvent(desc, reason);
         currentActiveDevice_ = AudioDeviceDescriptor(*desc);
+        PolicySnapshotManager::GetInstance().Invalidate();
         AUDIO_DEBUG_LOG("currentActiveDevice update %{public}d", currentActiveDevice_.deviceType_);
         return true;
     }
@@ -2805,6 +2812,7 @@ void AudioPolicyService::FetchInputDevice(vector<unique_ptr<AudioCapturerChangeI
             if (!IsSameDevice(desc, currentActiveInputDevice_)) {
                 WriteInputRouteChangeEvent(desc, reason);
                 currentActiveInputDevice_ = AudioDeviceDescriptor(*desc);
+                PolicySnapshotManager::GetInstance().Invalidate();
                 AUDIO_DEBUG_LOG("currentActiveInputDevice update %{public}d", currentActiveInputDevice_.deviceType_);
                 isUpdateActiveDevice = true;
             }
@@ -2831,6 +2839,7 @@ int32_t AudioPolicyService::HandleDeviceChangeForFetchInputDevice(unique_ptr<Aud
         AUDIO_INFO_LOG("stream %{public}d device not change, no need move device", capturerChangeInfo->sessionId);
         if (!IsSameDevice(desc, currentActiveInputDevice_)) {
             currentActiveInputDevice_ = AudioDeviceDescriptor(*desc);
+            PolicySnapshotManager::GetInstance().Invalidate();
             OnPreferredInputDeviceUpdated(currentActiveInputDevice_.deviceType_, currentActiveInputDevice_.networkId_);
             UpdateActiveDeviceRoute(currentActiveInputDevice_.deviceType_, DeviceFlag::INPUT_DEVICES_FLAG);
         }
@@ -3043,6 +3052,7 @@ int32_t AudioPolicyService::SwitchActiveA2dpDevice(const sptr<AudioDeviceDescrip
     AUDIO_INFO_LOG("a2dp device name [%{public}s]", (deviceDescriptor->deviceName_).c_str());
     std::string lastActiveA2dpDevice = activeBTDevice_;
     activeBTDevice_ = deviceDescriptor->macAddress_;
+    PolicySnapshotManager::GetInstance().Invalidate();
     DeviceType lastDevice = audioPolicyManager_.GetActiveDevice();
     audioPolicyManager_.SetActiveDevice(DEVICE_TYPE_BLUETOOTH_A2DP);
 
@@ -3059,6 +3069,7 @@ int32_t AudioPolicyService::SwitchActiveA2dpDevice(const sptr<AudioDeviceDescrip
     result = Bluetooth::AudioA2dpManager::SetActiveA2dpDevice(deviceDescriptor->macAddress_);
     if (result != SUCCESS) {
         activeBTDevice_ = lastActiveA2dpDevice;
+        PolicySnapshotManager::GetInstance().Invalidate();
         audioPolicyManager_.SetActiveDevice(lastDevice);
         AUDIO_ERR_LOG("Active [%{public}s] failed, using original [%{public}s] device",
             GetEncryptAddr(activeBTDevice_).c_str(), GetEncryptAddr(lastActiveA2dpDevice).c_str());
@@ -3489,6 +3500,7 @@ int32_t AudioPolicyService::SetAudioScene(AudioScene audioScene)
 
     lastAudioScene_ = audioScene_;
     audioScene_ = audioScene;
+    PolicySnapshotManager::GetInstance().Invalidate();
     Bluetooth::AudioHfpManager::SetAudioSceneFromPolicy(audioScene_);
     if (lastAudioScene_ != AUDIO_SCENE_DEFAULT && audioScene_ == AUDIO_SCENE_DEFAULT) {
         SetPreferredDevice(AUDIO_CALL_RENDER, new(std::nothrow) AudioDeviceDescriptor());
@@ -3569,6 +3581,32 @@ AudioScene AudioPolicyService::GetAudioScene(bool hasSystemPermission) const
     return audioScene_;
 }
 
+void AudioPolicyService::RefreshPolicySnapshot()
+{
+    PolicySnapshotManager &snapshotManager = PolicySnapshotManager::GetInstance();
+    uint64_t generation = 0;
+    if (!snapshotManager.NeedRefresh(generation)) {
+        return;
+    }
+    PolicySnapshotData data;
+    for (size_t i = 0; i < POLICY_SNAPSHOT_STREAM_TYPE_NUM; i++) {
+        AudioStreamType streamType = static_cast<AudioStreamType>(i);
+        data.volumeLevel[i] = GetSystemVolumeLevel(streamType);
+        data.isMute[i] = GetStreamMute(streamType) ? 1 : 0;
+    }
+    data.activeOutputDevice = GetActiveOutputDevice();
+    data.activeInputDevice = GetActiveInputDevice();
+    data.audioScene = GetAudioScene();
+    data.ringerMode = GetRingerMode();
+    snapshotManager.Publish(data, generation);
+}
+
+int32_t AudioPolicyService::GetPolicySnapshot(int32_t &fd, uint64_t &size)
+{
+    RefreshPolicySnapshot();
+    return PolicySnapshotManager::GetInstance().GetSnapshotFd(fd, size);
+}
+
 AudioScene AudioPolicyService::GetLastAudioScene() const
 {
     return lastAudioScene_;
@@ -3806,6 +3844,7 @@ int32_t AudioPolicyService::HandleLocalDeviceConnected(AudioDeviceDescriptor &up
         if (updatedDesc.deviceType_ == DEVICE_TYPE_BLUETOOTH_A2DP) {
             A2dpDeviceConfigInfo configInfo = {updatedDesc.audioStreamInfo_, false};
             connectedA2dpDeviceMap_.insert(make_pair(updatedDesc.macAddress_, configInfo));
+            PolicySnapshotManager::GetInstance().Invalidate();
         }
     }
 
@@ -3877,6 +3916,7 @@ void AudioPolicyService::UpdateActiveA2dpDeviceWhenDisconnecting(const std::stri
 
     if (connectedA2dpDeviceMap_.size() == 0) {
         activeBTDevice_ = "";
+        PolicySnapshotManager::GetInstance().Invalidate();
         ClosePortAndEraseIOHandle(BLUETOOTH_SPEAKER);
         audioPolicyManager_.SetAbsVolumeScene(false);
         SetSharedAbsVolumeScene(false);
@@ -4677,6 +4717,7 @@ void AudioPolicyService::OnServiceConnected(AudioServiceIndex serviceIndex)
         currentActiveDevice_ = AudioDeviceDescriptor(*outDevice);
         unique_ptr<AudioDeviceDescriptor> inDevice = audioDeviceManager_.GetCaptureDefaultDevice();
         currentActiveInputDevice_ = AudioDeviceDescriptor(*inDevice);
+        PolicySnapshotManager::GetInstance().Invalidate();
         SetVolumeForSwitchDevice(currentActiveDevice_.deviceType_);
         OnPreferredDeviceUpdated(currentActiveDevice_, currentActiveInputDevice_.deviceType_);
         AddEarpiece();
@@ -5694,6 +5735,7 @@ int32_t AudioPolicyService::SetDeviceAbsVolumeSupported(const std::string &macAd
         auto configInfoPos = connectedA2dpDeviceMap_.find(macAddress);
         if (configInfoPos != connectedA2dpDeviceMap_.end()) {
             configInfoPos->second.absVolumeSupport = support;
+            PolicySnapshotManager::GetInstance().Invalidate();
             break;
         }
         CHECK_AND_RETURN_RET_LOG(retryCount != maxRetries, ERROR,
@@ -5966,6 +6008,7 @@ int32_t AudioPolicyService::SetA2dpDeviceVolume(const std::string &macAddress, c
     configInfoPos->second.volumeLevel = sVolumeLevel;
     bool mute = sVolumeLevel == 0 ? true : false;
     configInfoPos->second.mute = mute;
+    PolicySnapshotManager::GetInstance().Invalidate();
     audioPolicyManager_.SetAbsVolumeMute(mute);
     AUDIO_INFO_LOG("success for macaddress:[%{public}s], volume value:[%{public}d]",
         GetEncryptAddr(macAddress).c_str(), sVolumeLevel);
@@ -6217,6 +6260,7 @@ int32_t AudioPolicyService::GetPreferredInputStreamTypeInner(SourceType sourceTy
 void AudioPolicyService::UpdateInputDeviceInfo(DeviceType deviceType)
 {
     AUDIO_DEBUG_LOG("Current input device is %{public}d", currentActiveInputDevice_.deviceType_);
+    DeviceType lastInputDevice = currentActiveInputDevice_.deviceType_;
 
     switch (deviceType) {
         case DEVICE_TYPE_EARPIECE:
@@ -6238,6 +6282,9 @@ void AudioPolicyService::UpdateInputDeviceInfo(DeviceType deviceType)
         default:
             break;
     }
+    if (currentActiveInputDevice_.deviceType_ != lastInputDevice) {
+        PolicySnapshotManager::GetInstance().Invalidate();
+    }
 
     AUDIO_DEBUG_LOG("Input device updated to %{public}d", currentActiveInputDevice_.deviceType_);
 }
@@ -7111,14 +7158,14 @@ void AudioPolicyService::UpdateAudioCapturerMicrophoneDescriptor(DeviceType devT
 
 void AudioPolicyService::RemoveAudioCapturerMicrophoneDescriptor(int32_t uid)
 {
-    vector<unique_ptr<AudioCapturerChangeInfo>> audioCapturerChangeInfos;
-    streamCollector_.GetCurrentCapturerChangeInfos(audioCapturerChangeInfos);
+    shared_ptr<const vector<AudioCapturerChangeInfo>> audioCapturerChangeInfos =
+        streamCollector_.GetCapturerChangeInfosSnapshot();
 
-    for (auto &info : audioCapturerChangeInfos) {
-        if (info->clientUID != uid && info->createrUID != uid) {
+    for (auto &info : *audioCapturerChangeInfos) {
+        if (info.clientUID != uid && info.createrUID != uid) {
             continue;
         }
-        audioCaptureMicrophoneDescriptor_.erase(info->sessionId);
+        audioCaptureMicrophoneDescriptor_.erase(info.sessionId);
     }
 }
 
@@ -7519,17 +7566,17 @@ int32_t AudioPolicyService::HandleA2dpDeviceInOffload(BluetoothOffloadState a2dp
 void AudioPolicyService::GetAllRunningStreamSession(std::vector<int32_t> &allSessions, bool doStop)
 {
 #ifdef BLUETOOTH_ENABLE
-    vector<unique_ptr<AudioRendererChangeInfo>> rendererChangeInfos;
-    streamCollector_.GetCurrentRendererChangeInfos(rendererChangeInfos);
+    shared_ptr<const vector<AudioRendererChangeInfo>> rendererChangeInfos =
+        streamCollector_.GetRendererChangeInfosSnapshot();
     std::vector<int32_t> stopPlayingStream(0);
-    for (auto &changeInfo : rendererChangeInfos) {
-        if (changeInfo->rendererState != RENDERER_RUNNING) {
+    for (auto &changeInfo : *rendererChangeInfos) {
+        if (changeInfo.rendererState != RENDERER_RUNNING) {
             if (doStop) {
-                stopPlayingStream.push_back(changeInfo->sessionId);
+                stopPlayingStream.push_back(changeInfo.sessionId);
             }
             continue;
         }
-        allSessions.push_back(changeInfo->sessionId);
+        allSessions.push_back(changeInfo.sessionId);
     }
     if (doStop && stopPlayingStream.size() > 0) {
         OffloadStopPlaying(stopPlayingStream);
@@ -8390,25 +8437,25 @@ void AudioPolicyService::DeviceVolumeInfosDump(std::string &dumpString, DeviceVo
 void AudioPolicyService::AudioStreamDump(std::string &dumpString)
 {
     dumpString += "\nAudioRenderer stream:\n";
-    vector<unique_ptr<AudioRendererChangeInfo>> audioRendererChangeInfos;
-    streamCollector_.GetCurrentRendererChangeInfos(audioRendererChangeInfos);
+    shared_ptr<const vector<AudioRendererChangeInfo>> audioRendererChangeInfos =
+        streamCollector_.GetRendererChangeInfosSnapshot();
 
-    AppendFormat(dumpString, " - audiorenderer stream size : %zu\n", audioRendererChangeInfos.size());
-    for (auto it = audioRendererChangeInfos.begin(); it != audioRendererChangeInfos.end(); it++) {
-        if ((*it)->rendererInfo.rendererFlags == STREAM_FLAG_NORMAL) {
+    AppendFormat(dumpString, " - audiorenderer stream size : %zu\n", audioRendererChangeInfos->size());
+    for (auto it = audioRendererChangeInfos->begin(); it != audioRendererChangeInfos->end(); it++) {
+        if (it->rendererInfo.rendererFlags == STREAM_FLAG_NORMAL) {
             AppendFormat(dumpString, " - normal AudioCapturer stream:\n");
-        } else if ((*it)->rendererInfo.rendererFlags == STREAM_FLAG_FAST) {
+        } else if (it->rendererInfo.rendererFlags == STREAM_FLAG_FAST) {
             AppendFormat(dumpString, " - fast AudioCapturer stream:\n");
         }
-        AppendFormat(dumpString, " - clientUID : %d\n", (*it)->clientUID);
-        AppendFormat(dumpString, " - streamId : %d\n", (*it)->sessionId);
-        AppendFormat(dumpString, " - deviceType : %d\n", (*it)->outputDeviceInfo.deviceType);
-        AppendFormat(dumpString, " - contentType : %d\n", (*it)->rendererInfo.contentType);
-        AppendFormat(dumpString, " - streamUsage : %d\n", (*it)->rendererInfo.streamUsage);
-        AppendFormat(dumpString, " - samplingRate : %d\n", (*it)->rendererInfo.samplingRate);
-        AudioStreamType streamType = GetStreamType((*it)->sessionId);
+        AppendFormat(dumpString, " - clientUID : %d\n", it->clientUID);
+        AppendFormat(dumpString, " - streamId : %d\n", it->sessionId);
+        AppendFormat(dumpString, " - deviceType : %d\n", it->outputDeviceInfo.deviceType);
+        AppendFormat(dumpString, " - contentType : %d\n", it->rendererInfo.contentType);
+        AppendFormat(dumpString, " - streamUsage : %d\n", it->rendererInfo.streamUsage);
+        AppendFormat(dumpString, " - samplingRate : %d\n", it->rendererInfo.samplingRate);
+        AudioStreamType streamType = GetStreamType(it->sessionId);
         AppendFormat(dumpString, " - volume : %f\n", GetSystemVolumeDb(streamType));
-        AppendFormat(dumpString, " - pipeType : %d\n", (*it)->rendererInfo.pipeType);
+        AppendFormat(dumpString, " - pipeType : %d\n", it->rendererInfo.pipeType);
     }
     GetCapturerStreamDump(dumpString);
 }
@@ -8416,21 +8463,21 @@ void AudioPolicyService::AudioStreamDump(std::string &dumpString)
 void AudioPolicyService::GetCapturerStreamDump(std::string &dumpString)
 {
     dumpString += "\nAudioCapturer stream:\n";
-    vector<unique_ptr<AudioCapturerChangeInfo>> audioCapturerChangeInfos;
-    streamCollector_.GetCurrentCapturerChangeInfos(audioCapturerChangeInfos);
-    AppendFormat(dumpString, " - audiocapturer stream size : %zu\n", audioCapturerChangeInfos.size());
-    for (auto it = audioCapturerChangeInfos.begin(); it != audioCapturerChangeInfos.end(); it++) {
-        if ((*it)->capturerInfo.capturerFlags == STREAM_FLAG_NORMAL) {
+    shared_ptr<const vector<AudioCapturerChangeInfo>> audioCapturerChangeInfos =
+        streamCollector_.GetCapturerChangeInfosSnapshot();
+    AppendFormat(dumpString, " - audiocapturer stream size : %zu\n", audioCapturerChangeInfos->size());
+    for (auto it = audioCapturerChangeInfos->begin(); it != audioCapturerChangeInfos->end(); it++) {
+        if (it->capturerInfo.capturerFlags == STREAM_FLAG_NORMAL) {
             AppendFormat(dumpString, " - normal AudioCapturer stream:\n");
-        } else if ((*it)->capturerInfo.capturerFlags == STREAM_FLAG_FAST) {
+        } else if (it->capturerInfo.capturerFlags == STREAM_FLAG_FAST) {
             AppendFormat(dumpString, " - fast AudioCapturer stream:\n");
         }
-        AppendFormat(dumpString, " - clientUID : %d\n", (*it)->clientUID);
-        AppendFormat(dumpString, " - streamId : %d\n", (*it)->sessionId);
-        AppendFormat(dumpString, " - is muted : %s\n", (*it)->muted ? "true" : "false");
-        AppendFormat(dumpString, " - deviceType : %d\n", (*it)->inputDeviceInfo.deviceType);
-        AppendFormat(dumpString, " - samplingRate : %d\n", (*it)->capturerInfo.samplingRate);
-        AppendFormat(dumpString, " - pipeType : %d\n", (*it)->capturerInfo.pipeType);
+        AppendFormat(dumpString, " - clientUID : %d\n", it->clientUID);
+        AppendFormat(dumpString, " - streamId : %d\n", it->sessionId);
+        AppendFormat(dumpString, " - is muted : %s\n", it->muted ? "true" : "false");
+        AppendFormat(dumpString, " - deviceType : %d\n", it->inputDeviceInfo.deviceType);
+        AppendFormat(dumpString, " - samplingRate : %d\n", it->capturerInfo.samplingRate);
+        AppendFormat(dumpString, " - pipeType : %d\n", it->capturerInfo.pipeType);
     }
 }
 
@@ -8622,12 +8669,14 @@ void AudioPolicyService::DealAudioSceneOutputDevices(const AudioScene &audioScen
             descs = audioRouterCenter_.FetchOutputDevices(STREAM_USAGE_RINGTONE, -1);
             if (!descs.empty()) {
                 currentActiveDevice_.deviceType_ = descs.front()->getType();
+                PolicySnapshotManager::GetInstance().Invalidate();
             }
             break;
         case AUDIO_SCENE_VOICE_RINGING:
             descs = audioRouterCenter_.FetchOutputDevices(STREAM_USAGE_VOICE_RINGTONE, -1);
             if (!descs.empty()) {
                 currentActiveDevice_.deviceType_ = descs.front()->getType();
+                PolicySnapshotManager::GetInstance().Invalidate();
             }
             break;
         default:
@@ -15,6 +15,7 @@
 
 #include "audio_state_manager.h"
 #include "audio_log.h"
+#include "audio_route_cache.h"
 
 using namespace std;
 
@@ -24,32 +25,38 @@ namespace AudioStandard {
 void AudioStateManager::SetPreferredMediaRenderDevice(const sptr<AudioDeviceDescriptor> &deviceDescriptor)
 {
     preferredMediaRenderDevice_ = deviceDescriptor;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioStateManager::SetPreferredCallRenderDevice(const sptr<AudioDeviceDescriptor> &deviceDescriptor)
 {
     preferredCallRenderDevice_ = deviceDescriptor;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioStateManager::SetPreferredCallCaptureDevice(const sptr<AudioDeviceDescriptor> &deviceDescriptor)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     preferredCallCaptureDevice_ = deviceDescriptor;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioStateManager::SetPreferredRingRenderDevice(const sptr<AudioDeviceDescriptor> &deviceDescriptor)
 {
     preferredRingRenderDevice_ = deviceDescriptor;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioStateManager::SetPreferredRecordCaptureDevice(const sptr<AudioDeviceDescriptor> &deviceDescriptor)
 {
     preferredRecordCaptureDevice_ = deviceDescriptor;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 void AudioStateManager::SetPreferredToneRenderDevice(const sptr<AudioDeviceDescriptor> &deviceDescriptor)
 {
     preferredToneRenderDevice_ = deviceDescriptor;
+    AudioRouteCache::GetInstance().Invalidate();
 }
 
 unique_ptr<AudioDeviceDescriptor> AudioStateManager::GetPreferredMediaRenderDevice()
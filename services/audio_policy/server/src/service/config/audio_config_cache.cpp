@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioConfigCache"
+#endif
+
+#include "audio_config_cache.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "audio_policy_log.h"
+#include "audio_utils.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const uint32_t CACHE_MAGIC = 0x43435041; // "APCC"
+// layout of CacheHeader
+const uint32_t CACHE_VERSION = 2;
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+const uint64_t FNV_PRIME = 0x100000001b3;
+const size_t READ_BUFFER_SIZE = 4096;
+const uint64_t MAX_CACHE_SIZE = 4 * 1024 * 1024;
+const char *BUILD_FINGERPRINT_KEY = "const.ohos.fullname";
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t cacheVersion;
+    uint32_t formatVersion;
+    uint32_t recordSize;
+    uint64_t buildHash;
+    uint64_t recordCount;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+    uint64_t recordsHash;
+};
+
+uint64_t HashBytes(uint64_t hash, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool WriteAll(int fd, const void *data, size_t len)
+{
+    const uint8_t *pos = static_cast<const uint8_t *>(data);
+    while (len > 0) {
+        ssize_t written = write(fd, pos, len);
+        if (written <= 0) {
+            return false;
+        }
+        pos += written;
+        len -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+uint64_t GetBuildHash()
+{
+    static const uint64_t buildHash = [] {
+        std::string fingerprint;
+        if (!GetSysPara(BUILD_FINGERPRINT_KEY, fingerprint)) {
+            AUDIO_WARNING_LOG("no build fingerprint");
+        }
+        return HashBytes(FNV_OFFSET_BASIS, reinterpret_cast<const uint8_t *>(fingerprint.data()), fingerprint.size());
+    }();
+    return buildHash;
+}
+} // namespace
+
+AudioConfigCache::AudioConfigCache(const std::string &cachePath, const std::string &sourcePath,
+    uint32_t formatVersion) : cachePath_(cachePath), sourcePath_(sourcePath), formatVersion_(formatVersion),
+    buildHash_(GetBuildHash())
+{
+}
+
+AudioConfigCache::~AudioConfigCache()
+{
+    Unmap();
+}
+
+bool AudioConfigCache::Load(uint32_t recordSize)
+{
+    Unmap();
+    CHECK_AND_RETURN_RET_LOG(recordSize != 0, false, "invalid record size");
+    CHECK_AND_RETURN_RET_LOG(ReadSourceHash(), false, "read source failed");
+
+    int fd = open(cachePath_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        AUDIO_INFO_LOG("no cache for %{public}s", sourcePath_.c_str());
+        return false;
+    }
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CacheHeader)) ||
+        static_cast<uint64_t>(st.st_size) > MAX_CACHE_SIZE) {
+        AUDIO_WARNING_LOG("invalid cache size");
+        close(fd);
+        return false;
+    }
+    size_t mapSize = static_cast<size_t>(st.st_size);
+    void *addr = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    CHECK_AND_RETURN_RET_LOG(addr != MAP_FAILED, false, "mmap cache failed");
+    mapAddr_ = addr;
+    mapSize_ = mapSize;
+
+    const CacheHeader *header = static_cast<const CacheHeader *>(addr);
+    const uint8_t *records = static_cast<const uint8_t *>(addr) + sizeof(CacheHeader);
+    uint64_t recordsLen = mapSize - sizeof(CacheHeader);
+    if (header->magic != CACHE_MAGIC || header->cacheVersion != CACHE_VERSION || header->buildHash != buildHash_ ||
+        header->formatVersion != formatVersion_ || header->recordSize != recordSize ||
+        header->recordCount > recordsLen / recordSize || header->recordCount * recordSize != recordsLen) {
+        AUDIO_INFO_LOG("cache of %{public}s has another version", sourcePath_.c_str());
+        Unmap();
+        return false;
+    }
+    if (header->sourceSize != sourceSize_ || header->sourceHash != sourceHash_) {
+        AUDIO_INFO_LOG("%{public}s changed, cache is stale", sourcePath_.c_str());
+        Unmap();
+        return false;
+    }
+    if (header->recordsHash != HashBytes(FNV_OFFSET_BASIS, records, recordsLen)) {
+        AUDIO_WARNING_LOG("cache of %{public}s is corrupt", sourcePath_.c_str());
+        Unmap();
+        return false;
+    }
+    records_ = records;
+    recordCount_ = header->recordCount;
+    return true;
+}
+
+bool AudioConfigCache::ReadSourceHash()
+{
+    if (sourceHashRead_) {
+        return true;
+    }
+    int fd = open(sourcePath_.c_str(), O_RDONLY | O_CLOEXEC);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, false, "open %{public}s failed", sourcePath_.c_str());
+    uint8_t buffer[READ_BUFFER_SIZE];
+    uint64_t hash = FNV_OFFSET_BASIS;
+    uint64_t size = 0;
+    ssize_t len = 0;
+    while ((len = read(fd, buffer, sizeof(buffer))) > 0) {
+        hash = HashBytes(hash, buffer, static_cast<size_t>(len));
+        size += static_cast<uint64_t>(len);
+    }
+    close(fd);
+    CHECK_AND_RETURN_RET_LOG(len == 0, false, "read %{public}s failed", sourcePath_.c_str());
+    sourceSize_ = size;
+    sourceHash_ = hash;
+    sourceHashRead_ = true;
+    return true;
+}
+
+bool AudioConfigCache::StoreRecords(const void *records, uint32_t recordSize, uint64_t recordCount)
+{
+    CHECK_AND_RETURN_RET_LOG(recordSize != 0 && (records != nullptr || recordCount == 0), false, "invalid records");
+    CHECK_AND_RETURN_RET_LOG(ReadSourceHash(), false, "read source failed");
+    uint64_t recordsLen = recordCount * recordSize;
+    CHECK_AND_RETURN_RET_LOG(recordsLen <= MAX_CACHE_SIZE - sizeof(CacheHeader), false, "too many records");
+
+    CacheHeader header = {};
+    header.magic = CACHE_MAGIC;
+    header.cacheVersion = CACHE_VERSION;
+    header.formatVersion = formatVersion_;
+    header.recordSize = recordSize;
+    header.buildHash = buildHash_;
+    header.recordCount = recordCount;
+    header.sourceSize = sourceSize_;
+    header.sourceHash = sourceHash_;
+    header.recordsHash = HashBytes(FNV_OFFSET_BASIS, static_cast<const uint8_t *>(records), recordsLen);
+
+    // written aside and renamed, so a reader never maps a partly written cache
+    std::string tmpPath = cachePath_ + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, false, "create %{public}s failed", tmpPath.c_str());
+    bool ret = WriteAll(fd, &header, sizeof(header)) && WriteAll(fd, records, recordsLen) && fsync(fd) == 0;
+    close(fd);
+    if (!ret || rename(tmpPath.c_str(), cachePath_.c_str()) != 0) {
+        AUDIO_ERR_LOG("write %{public}s failed", cachePath_.c_str());
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    AUDIO_INFO_LOG("cached %{public}" PRIu64 " records of %{public}s", recordCount, sourcePath_.c_str());
+    return true;
+}
+
+void AudioConfigCache::Unmap()
+{
+    if (mapAddr_ != nullptr) {
+        munmap(mapAddr_, mapSize_);
+    }
+    mapAddr_ = nullptr;
+    mapSize_ = 0;
+    records_ = nullptr;
+    recordCount_ = 0;
+}
+} // namespace AudioStandard
+} // namespace OHOS
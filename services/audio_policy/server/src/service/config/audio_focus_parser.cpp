@@ -21,10 +21,31 @@
 #include "config_policy_utils.h"
 #endif
 
+#include <cinttypes>
+
+#include "audio_config_cache.h"
 #include "media_monitor_manager.h"
 
 namespace OHOS {
 namespace AudioStandard {
+namespace {
+const char *FOCUS_CACHE_FILE = "audio_interrupt_policy_config.cache";
+// bump when FocusCacheRecord changes
+const uint32_t FOCUS_CACHE_VERSION = 1;
+
+struct FocusCacheRecord {
+    int32_t existStreamType;
+    int32_t existSourceType;
+    int32_t existIsPlay;
+    int32_t incomingStreamType;
+    int32_t incomingSourceType;
+    int32_t incomingIsPlay;
+    int32_t forceType;
+    int32_t hintType;
+    int32_t actionOn;
+    int32_t isReject;
+};
+} // namespace
 
 // Initialize stream map with string vs AudioStreamType
 std::map<std::string, AudioFocusType> AudioFocusParser::audioFocusMap = {
@@ -131,14 +152,68 @@ void AudioFocusParser::LoadDefaultConfig(std::map<std::pair<AudioFocusType, Audi
 int32_t AudioFocusParser::LoadConfig(std::map<std::pair<AudioFocusType, AudioFocusType>,
     AudioFocusEntry> &focusMap)
 {
-    xmlDoc *doc = nullptr;
-    xmlNode *rootElement = nullptr;
 #ifdef USE_CONFIG_POLICY
     char buf[MAX_PATH_LEN];
     char *path = GetOneCfgFile(AUDIO_FOCUS_CONFIG_FILE, buf, MAX_PATH_LEN);
 #else
     const char *path = AUDIO_FOCUS_CONFIG_FILE;
 #endif
+    if (path == nullptr || *path == '\0') {
+        return ParseConfig(path, focusMap);
+    }
+    AudioConfigCache cache(std::string(AUDIO_CONFIG_CACHE_DIR) + FOCUS_CACHE_FILE, path, FOCUS_CACHE_VERSION);
+    if (LoadFromCache(cache, focusMap)) {
+        return SUCCESS;
+    }
+    int32_t ret = ParseConfig(path, focusMap);
+    if (ret == SUCCESS) {
+        StoreToCache(cache, focusMap);
+    }
+    return ret;
+}
+
+bool AudioFocusParser::LoadFromCache(AudioConfigCache &cache,
+    std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap)
+{
+    if (!cache.Load(sizeof(FocusCacheRecord))) {
+        return false;
+    }
+    uint64_t count = 0;
+    const FocusCacheRecord *records = cache.GetRecords<FocusCacheRecord>(count);
+    for (uint64_t i = 0; i < count; i++) {
+        const FocusCacheRecord &record = records[i];
+        AudioFocusType existFocus = {static_cast<AudioStreamType>(record.existStreamType),
+            static_cast<SourceType>(record.existSourceType), record.existIsPlay != 0};
+        AudioFocusType incomingFocus = {static_cast<AudioStreamType>(record.incomingStreamType),
+            static_cast<SourceType>(record.incomingSourceType), record.incomingIsPlay != 0};
+        AudioFocusEntry focusEntry = {static_cast<InterruptForceType>(record.forceType),
+            static_cast<InterruptHint>(record.hintType), static_cast<ActionTarget>(record.actionOn),
+            record.isReject != 0};
+        focusMap.emplace(std::make_pair(existFocus, incomingFocus), focusEntry);
+    }
+    AUDIO_INFO_LOG("loaded %{public}" PRIu64 " focus entries from cache", count);
+    return true;
+}
+
+void AudioFocusParser::StoreToCache(AudioConfigCache &cache,
+    const std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap)
+{
+    std::vector<FocusCacheRecord> records;
+    records.reserve(focusMap.size());
+    for (const auto &[focusTypePair, focusEntry] : focusMap) {
+        records.push_back({focusTypePair.first.streamType, focusTypePair.first.sourceType,
+            focusTypePair.first.isPlay, focusTypePair.second.streamType, focusTypePair.second.sourceType,
+            focusTypePair.second.isPlay, focusEntry.forceType, focusEntry.hintType, focusEntry.actionOn,
+            focusEntry.isReject});
+    }
+    cache.Store(records);
+}
+
+int32_t AudioFocusParser::ParseConfig(const char *path,
+    std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusMap)
+{
+    xmlDoc *doc = nullptr;
+    xmlNode *rootElement = nullptr;
     if (path != nullptr && *path != '\0') {
         doc = xmlReadFile(path, nullptr, 0);
     }
@@ -21,10 +21,34 @@
 #include "config_policy_utils.h"
 #endif
 
+#include <cinttypes>
+
+#include "audio_config_cache.h"
 #include "media_monitor_manager.h"
 
 namespace OHOS {
 namespace AudioStandard {
+namespace {
+const char *VOLUME_CACHE_FILE = "audio_volume_config.cache";
+// bump when VolumeCacheRecord changes
+const uint32_t VOLUME_CACHE_VERSION = 1;
+
+enum VolumeCacheRecordKind : int32_t {
+    STREAM_RECORD = 0,
+    DEVICE_RECORD,
+    POINT_RECORD,
+};
+
+// A stream record is followed by its device records, each followed by its point records.
+struct VolumeCacheRecord {
+    int32_t kind;
+    int32_t id; // stream type, device type or index of the point
+    int32_t value0; // min level of a stream or decibel of a point
+    int32_t value1; // max level of a stream
+    int32_t value2; // default level of a stream
+};
+} // namespace
+
 AudioVolumeParser::AudioVolumeParser()
 {
     AUDIO_INFO_LOG("AudioVolumeParser ctor");
@@ -122,18 +146,85 @@ int32_t AudioVolumeParser::LoadConfig(StreamVolumeInfoMap &streamVolumeInfoMap)
     for (int32_t i = MAX_CFG_POLICY_DIRS_CNT - 1; i >= 0; i--) {
         if (cfgFiles->paths[i] && *(cfgFiles->paths[i]) != '\0') {
             AUDIO_INFO_LOG("volume config file path:%{public}s", cfgFiles->paths[i]);
-            ret = ParseVolumeConfig(cfgFiles->paths[i], streamVolumeInfoMap);
+            ret = LoadVolumeConfig(cfgFiles->paths[i], streamVolumeInfoMap);
             break;
         }
     }
     FreeCfgFiles(cfgFiles);
 #else
-    ret = ParseVolumeConfig(AUDIO_VOLUME_CONFIG_FILE, streamVolumeInfoMap);
+    ret = LoadVolumeConfig(AUDIO_VOLUME_CONFIG_FILE, streamVolumeInfoMap);
     AUDIO_INFO_LOG("use default volume config file path:%{public}s", AUDIO_VOLUME_CONFIG_FILE);
 #endif
     return ret;
 }
 
+int32_t AudioVolumeParser::LoadVolumeConfig(const char *path, StreamVolumeInfoMap &streamVolumeInfoMap)
+{
+    AudioConfigCache cache(std::string(AUDIO_CONFIG_CACHE_DIR) + VOLUME_CACHE_FILE, path, VOLUME_CACHE_VERSION);
+    if (LoadFromCache(cache, streamVolumeInfoMap)) {
+        return SUCCESS;
+    }
+    int32_t ret = ParseVolumeConfig(path, streamVolumeInfoMap);
+    if (ret == SUCCESS) {
+        StoreToCache(cache, streamVolumeInfoMap);
+    }
+    return ret;
+}
+
+bool AudioVolumeParser::LoadFromCache(AudioConfigCache &cache, StreamVolumeInfoMap &streamVolumeInfoMap)
+{
+    if (!cache.Load(sizeof(VolumeCacheRecord))) {
+        return false;
+    }
+    uint64_t count = 0;
+    const VolumeCacheRecord *records = cache.GetRecords<VolumeCacheRecord>(count);
+    StreamVolumeInfoMap cachedMap;
+    std::shared_ptr<StreamVolumeInfo> streamVolInfo = nullptr;
+    std::shared_ptr<DeviceVolumeInfo> deviceVolInfo = nullptr;
+    for (uint64_t i = 0; i < count; i++) {
+        const VolumeCacheRecord &record = records[i];
+        if (record.kind == STREAM_RECORD) {
+            streamVolInfo = std::make_shared<StreamVolumeInfo>();
+            streamVolInfo->streamType = static_cast<AudioVolumeType>(record.id);
+            streamVolInfo->minLevel = record.value0;
+            streamVolInfo->maxLevel = record.value1;
+            streamVolInfo->defaultLevel = record.value2;
+            cachedMap[streamVolInfo->streamType] = streamVolInfo;
+            deviceVolInfo = nullptr;
+        } else if (record.kind == DEVICE_RECORD && streamVolInfo != nullptr) {
+            deviceVolInfo = std::make_shared<DeviceVolumeInfo>();
+            deviceVolInfo->deviceType = static_cast<DeviceVolumeType>(record.id);
+            streamVolInfo->deviceVolumeInfos[deviceVolInfo->deviceType] = deviceVolInfo;
+        } else if (record.kind == POINT_RECORD && deviceVolInfo != nullptr) {
+            deviceVolInfo->volumePoints.push_back({static_cast<uint32_t>(record.id), record.value0});
+        } else {
+            AUDIO_ERR_LOG("invalid volume cache record %{public}" PRIu64, i);
+            return false;
+        }
+    }
+    streamVolumeInfoMap.insert(cachedMap.begin(), cachedMap.end());
+    AUDIO_INFO_LOG("loaded %{public}zu stream volume infos from cache", cachedMap.size());
+    return true;
+}
+
+void AudioVolumeParser::StoreToCache(AudioConfigCache &cache, const StreamVolumeInfoMap &streamVolumeInfoMap)
+{
+    std::vector<VolumeCacheRecord> records;
+    for (const auto &[streamType, streamVolInfo] : streamVolumeInfoMap) {
+        CHECK_AND_CONTINUE_LOG(streamVolInfo != nullptr, "stream volume info is nullptr");
+        records.push_back({STREAM_RECORD, streamType, streamVolInfo->minLevel, streamVolInfo->maxLevel,
+            streamVolInfo->defaultLevel});
+        for (const auto &[deviceType, deviceVolInfo] : streamVolInfo->deviceVolumeInfos) {
+            CHECK_AND_CONTINUE_LOG(deviceVolInfo != nullptr, "device volume info is nullptr");
+            records.push_back({DEVICE_RECORD, deviceType, 0, 0, 0});
+            for (const auto &point : deviceVolInfo->volumePoints) {
+                records.push_back({POINT_RECORD, static_cast<int32_t>(point.index), point.dbValue, 0, 0});
+            }
+        }
+    }
+    cache.Store(records);
+}
+
 void AudioVolumeParser::ParseStreamInfos(xmlNode *node, StreamVolumeInfoMap &streamVolumeInfoMap)
 {
     xmlNode *currNode = node;
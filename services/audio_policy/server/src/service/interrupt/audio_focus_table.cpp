@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioFocusTable"
+#endif
+
+#include "audio_focus_table.h"
+
+#include "audio_log.h"
+
+namespace OHOS {
+namespace AudioStandard {
+AudioFocusTable::AudioFocusTable()
+{
+    Clear();
+}
+
+void AudioFocusTable::Build(const std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusCfgMap)
+{
+    Clear();
+    for (const auto &item : focusCfgMap) {
+        CHECK_AND_CONTINUE_LOG(AddType(item.first.first) != INVALID_INDEX &&
+            AddType(item.first.second) != INVALID_INDEX, "focus type pair out of range");
+    }
+
+    entries_.assign(typeCount_ * typeCount_, AudioFocusEntry {});
+    present_.assign(typeCount_ * typeCount_, false);
+    for (const auto &[focusTypePair, focusEntry] : focusCfgMap) {
+        int32_t existIndex = GetTypeIndex(focusTypePair.first);
+        int32_t incomingIndex = GetTypeIndex(focusTypePair.second);
+        if (existIndex == INVALID_INDEX || incomingIndex == INVALID_INDEX) {
+            continue;
+        }
+        size_t pos = static_cast<size_t>(existIndex) * typeCount_ + static_cast<size_t>(incomingIndex);
+        entries_[pos] = focusEntry;
+        present_[pos] = true;
+    }
+    AUDIO_INFO_LOG("focus types: %{public}zu, entries: %{public}zu", typeCount_, focusCfgMap.size());
+}
+
+void AudioFocusTable::Clear()
+{
+    typeIndex_.fill(INVALID_INDEX);
+    typeCount_ = 0;
+    entries_.clear();
+    present_.clear();
+}
+
+const AudioFocusEntry *AudioFocusTable::Find(const AudioFocusType &existFocus,
+    const AudioFocusType &incomingFocus) const
+{
+    int32_t existIndex = GetTypeIndex(existFocus);
+    int32_t incomingIndex = GetTypeIndex(incomingFocus);
+    if (existIndex == INVALID_INDEX || incomingIndex == INVALID_INDEX) {
+        return nullptr;
+    }
+    size_t pos = static_cast<size_t>(existIndex) * typeCount_ + static_cast<size_t>(incomingIndex);
+    return present_[pos] ? &entries_[pos] : nullptr;
+}
+
+size_t AudioFocusTable::GetTypeCount() const
+{
+    return typeCount_;
+}
+
+// Same identity as AudioFocusType::operator<, which only compares the stream type and the source type.
+int32_t AudioFocusTable::GetTypeKey(const AudioFocusType &focusType)
+{
+    int32_t streamKey = static_cast<int32_t>(focusType.streamType) - STREAM_DEFAULT;
+    int32_t sourceKey = static_cast<int32_t>(focusType.sourceType) - SOURCE_TYPE_INVALID;
+    if (streamKey < 0 || streamKey >= STREAM_KEY_COUNT || sourceKey < 0 || sourceKey >= SOURCE_KEY_COUNT) {
+        return INVALID_INDEX;
+    }
+    return streamKey * SOURCE_KEY_COUNT + sourceKey;
+}
+
+int32_t AudioFocusTable::GetTypeIndex(const AudioFocusType &focusType) const
+{
+    int32_t key = GetTypeKey(focusType);
+    return key == INVALID_INDEX ? INVALID_INDEX : typeIndex_[key];
+}
+
+int32_t AudioFocusTable::AddType(const AudioFocusType &focusType)
+{
+    int32_t key = GetTypeKey(focusType);
+    if (key == INVALID_INDEX) {
+        return INVALID_INDEX;
+    }
+    if (typeIndex_[key] == INVALID_INDEX) {
+        typeIndex_[key] = static_cast<int32_t>(typeCount_++);
+    }
+    return typeIndex_[key];
+}
+} // namespace AudioStandard
+} // namespace OHOS
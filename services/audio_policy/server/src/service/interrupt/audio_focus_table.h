@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ST_AUDIO_FOCUS_TABLE_H
+#define ST_AUDIO_FOCUS_TABLE_H
+
+#include <array>
+#include <map>
+#include <vector>
+
+#include "audio_interrupt_info.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// Dense copy of the focus config for the arbitration hot path. Every focus type of the config gets a compact
+// index, and the entry of a (exist, incoming) pair is read from a flat table instead of a map lookup with
+// two key comparisons per node.
+class AudioFocusTable {
+public:
+    AudioFocusTable();
+
+    void Build(const std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> &focusCfgMap);
+    void Clear();
+
+    // Returns nullptr if the pair is not in the config.
+    const AudioFocusEntry *Find(const AudioFocusType &existFocus, const AudioFocusType &incomingFocus) const;
+    size_t GetTypeCount() const;
+
+private:
+    static constexpr int32_t STREAM_KEY_COUNT = STREAM_TYPE_MAX - STREAM_DEFAULT + 1;
+    static constexpr int32_t SOURCE_KEY_COUNT = SOURCE_TYPE_MAX - SOURCE_TYPE_INVALID + 1;
+    static constexpr int32_t INVALID_INDEX = -1;
+
+    static int32_t GetTypeKey(const AudioFocusType &focusType);
+    int32_t GetTypeIndex(const AudioFocusType &focusType) const;
+    int32_t AddType(const AudioFocusType &focusType);
+
+    std::array<int32_t, STREAM_KEY_COUNT * SOURCE_KEY_COUNT> typeIndex_ {};
+    size_t typeCount_ = 0;
+    std::vector<AudioFocusEntry> entries_;
+    std::vector<bool> present_;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // ST_AUDIO_FOCUS_TABLE_H
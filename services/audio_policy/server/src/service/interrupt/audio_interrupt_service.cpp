@@ -114,6 +114,7 @@ void AudioInterruptService::Init(sptr<AudioPolicyServer> server)
     CHECK_AND_RETURN_LOG(!ret, "load fail");
 
     AUDIO_DEBUG_LOG("configuration loaded. mapSize: %{public}zu", focusCfgMap_.size());
+    focusTable_.Build(focusCfgMap_);
 
     policyServer_ = server;
     clientOnFocus_ = 0;
@@ -991,18 +992,21 @@ void AudioInterruptService::ProcessExistInterrupt(std::list<std::pair<AudioInter
 
 void AudioInterruptService::ProcessActiveInterrupt(const int32_t zoneId, const AudioInterrupt &incomingInterrupt)
 {
-    // Use local variable to record target focus info list, can be optimized
     auto targetZoneIt = zonesMap_.find(zoneId);
-    CHECK_AND_RETURN_LOG(targetZoneIt != zonesMap_.end(), "can not find zone id");
-    std::list<std::pair<AudioInterrupt, AudioFocuState>> tmpFocusInfoList {};
-    if (targetZoneIt != zonesMap_.end()) {
-        tmpFocusInfoList = targetZoneIt->second->audioFocusInfoList;
-        targetZoneIt->second->zoneId = zoneId;
-    }
-
-    for (auto iterActive = tmpFocusInfoList.begin(); iterActive != tmpFocusInfoList.end();) {
-        AudioFocusEntry focusEntry =
-            focusCfgMap_[std::make_pair((iterActive->first).audioFocusType, incomingInterrupt.audioFocusType)];
+    CHECK_AND_RETURN_LOG(targetZoneIt != zonesMap_.end() && targetZoneIt->second != nullptr,
+        "can not find zone id");
+    targetZoneIt->second->zoneId = zoneId;
+    // the states are updated in the zone list directly, so the focus change events see the current states
+    auto &focusInfoList = targetZoneIt->second->audioFocusInfoList;
+
+    for (auto iterActive = focusInfoList.begin(); iterActive != focusInfoList.end();) {
+        const AudioFocusEntry *focusEntryPtr =
+            focusTable_.Find((iterActive->first).audioFocusType, incomingInterrupt.audioFocusType);
+        if (focusEntryPtr == nullptr) {
+            ++iterActive;
+            continue;
+        }
+        AudioFocusEntry focusEntry = *focusEntryPtr;
         if (focusEntry.actionOn != CURRENT || IsSameAppInShareMode(incomingInterrupt, iterActive->first) ||
             iterActive->second == PLACEHOLDER || CanMixForSession(incomingInterrupt, iterActive->first, focusEntry)) {
             ++iterActive;
@@ -1021,8 +1025,7 @@ void AudioInterruptService::ProcessActiveInterrupt(const int32_t zoneId, const A
             if (pidIt != targetZoneIt->second->pids.end()) {
                 targetZoneIt->second->pids.erase(pidIt);
             }
-            iterActive = tmpFocusInfoList.erase(iterActive);
-            targetZoneIt->second->audioFocusInfoList = tmpFocusInfoList;
+            iterActive = focusInfoList.erase(iterActive);
             if (sessionService_ != nullptr && sessionService_->IsAudioSessionActivated(pidToRemove)) {
                 HandleLowPriorityEvent(pidToRemove, streamId);
             }
@@ -1032,9 +1035,6 @@ void AudioInterruptService::ProcessActiveInterrupt(const int32_t zoneId, const A
 
         SendActiveInterruptEvent(activeSessionId, interruptEvent, incomingInterrupt);
     }
-
-    targetZoneIt->second->audioFocusInfoList = tmpFocusInfoList;
-    zonesMap_[zoneId] = targetZoneIt->second;
 }
 
 void AudioInterruptService::HandleLowPriorityEvent(const int32_t pid, const uint32_t streamId)
@@ -1152,18 +1152,18 @@ int32_t AudioInterruptService::ProcessFocusEntry(const int32_t zoneId, const Aud
     InterruptEventInternal interruptEvent {INTERRUPT_TYPE_BEGIN, INTERRUPT_FORCE, INTERRUPT_HINT_NONE, 1.0f};
     auto itZone = zonesMap_.find(zoneId);
     CHECK_AND_RETURN_RET_LOG(itZone != zonesMap_.end(), ERROR, "can not find zoneid");
-    std::list<std::pair<AudioInterrupt, AudioFocuState>> audioFocusInfoList {};
-    if (itZone != zonesMap_.end()) { audioFocusInfoList = itZone->second->audioFocusInfoList; }
+    CHECK_AND_RETURN_RET_LOG(itZone->second != nullptr, ERROR, "zone is nullptr");
+    // only read before the incoming interrupt is added
+    const auto &audioFocusInfoList = itZone->second->audioFocusInfoList;
 
     SourceType incomingSourceType = incomingInterrupt.audioFocusType.sourceType;
     std::vector<SourceType> incomingConcurrentSources = incomingInterrupt.currencySources.sourcesTypes;
     for (auto iterActive = audioFocusInfoList.begin(); iterActive != audioFocusInfoList.end(); ++iterActive) {
         if (IsSameAppInShareMode(incomingInterrupt, iterActive->first)) { continue; }
-        std::pair<AudioFocusType, AudioFocusType> audioFocusTypePair =
-            std::make_pair((iterActive->first).audioFocusType, incomingInterrupt.audioFocusType);
-        CHECK_AND_RETURN_RET_LOG(focusCfgMap_.find(audioFocusTypePair) != focusCfgMap_.end(), ERR_INVALID_PARAM,
-            "audio focus type pair is invalid");
-        AudioFocusEntry focusEntry = focusCfgMap_[audioFocusTypePair];
+        const AudioFocusEntry *focusEntryPtr =
+            focusTable_.Find((iterActive->first).audioFocusType, incomingInterrupt.audioFocusType);
+        CHECK_AND_RETURN_RET_LOG(focusEntryPtr != nullptr, ERR_INVALID_PARAM, "audio focus type pair is invalid");
+        const AudioFocusEntry &focusEntry = *focusEntryPtr;
         if (focusEntry.actionOn == CURRENT || iterActive->second == PLACEHOLDER ||
             CanMixForSession(incomingInterrupt, iterActive->first, focusEntry)) {
             continue;
@@ -1358,28 +1358,30 @@ std::list<std::pair<AudioInterrupt, AudioFocuState>> AudioInterruptService::Simu
 {
     std::list<std::pair<AudioInterrupt, AudioFocuState>> newAudioFocuInfoList;
     auto itZone = zonesMap_.find(zoneId);
-    std::list<std::pair<AudioInterrupt, AudioFocuState>> audioFocusInfoList {};
-    if (itZone != zonesMap_.end() && itZone->second != nullptr) {
-        audioFocusInfoList = itZone->second->audioFocusInfoList;
+    if (itZone == zonesMap_.end() || itZone->second == nullptr) {
+        return newAudioFocuInfoList;
     }
+    const auto &audioFocusInfoList = itZone->second->audioFocusInfoList;
 
+    // states changed for the current incoming interrupt, reverted if the incoming one ends up paused
+    std::vector<std::pair<std::list<std::pair<AudioInterrupt, AudioFocuState>>::iterator, AudioFocuState>> changes;
     for (auto iterActive = audioFocusInfoList.begin(); iterActive != audioFocusInfoList.end(); ++iterActive) {
-        AudioInterrupt incoming = iterActive->first;
+        const AudioInterrupt &incoming = iterActive->first;
         AudioFocuState incomingState = ACTIVE;
-        std::list<std::pair<AudioInterrupt, AudioFocuState>> tmpAudioFocuInfoList = newAudioFocuInfoList;
+        changes.clear();
         for (auto iter = newAudioFocuInfoList.begin(); iter != newAudioFocuInfoList.end(); ++iter) {
-            AudioInterrupt inprocessing = iter->first;
+            const AudioInterrupt &inprocessing = iter->first;
             if (iter->second == PAUSE || IsSameAppInShareMode(incoming, inprocessing) || iter->second == PLACEHOLDER) {
                 continue;
             }
-            std::pair<AudioFocusType, AudioFocusType> audioFocusTypePair =
-                std::make_pair(inprocessing.audioFocusType, incoming.audioFocusType);
-            if (focusCfgMap_.find(audioFocusTypePair) == focusCfgMap_.end()) {
+            const AudioFocusEntry *focusEntryPtr = focusTable_.Find(inprocessing.audioFocusType,
+                incoming.audioFocusType);
+            if (focusEntryPtr == nullptr) {
                 AUDIO_WARNING_LOG("focus type is invalid");
                 incomingState = iterActive->second;
                 break;
             }
-            AudioFocusEntry focusEntry = focusCfgMap_[audioFocusTypePair];
+            AudioFocusEntry focusEntry = *focusEntryPtr;
             if (CanMixForSession(incoming, inprocessing, focusEntry)) { continue; }
             UpdateHintTypeForExistingSession(incoming, focusEntry);
             if (GetClientTypeBySessionId((iterActive->first).sessionId) == CLIENT_TYPE_GAME &&
@@ -1390,6 +1392,7 @@ std::list<std::pair<AudioInterrupt, AudioFocuState>> AudioInterruptService::Simu
             auto pos = HINT_STATE_MAP.find(focusEntry.hintType);
             if (pos == HINT_STATE_MAP.end()) { continue; }
             if (focusEntry.actionOn == CURRENT) {
+                changes.emplace_back(iter, iter->second);
                 iter->second = pos->second;
             } else {
                 AudioFocuState newState = pos->second;
@@ -1397,7 +1400,11 @@ std::list<std::pair<AudioInterrupt, AudioFocuState>> AudioInterruptService::Simu
             }
         }
 
-        if (incomingState == PAUSE) { newAudioFocuInfoList = tmpAudioFocuInfoList; }
+        if (incomingState == PAUSE) {
+            for (auto change = changes.rbegin(); change != changes.rend(); ++change) {
+                change->first->second = change->second;
+            }
+        }
         if (iterActive->second == PLACEHOLDER) { incomingState = PLACEHOLDER; }
         newAudioFocuInfoList.emplace_back(std::make_pair(incoming, incomingState));
     }
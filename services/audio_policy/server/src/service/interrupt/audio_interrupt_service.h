@@ -22,6 +22,7 @@
 
 #include "i_audio_interrupt_event_dispatcher.h"
 #include "audio_interrupt_info.h"
+#include "audio_focus_table.h"
 #include "audio_policy_server_handler.h"
 #include "audio_policy_server.h"
 #include "audio_session_service.h"
@@ -224,6 +225,7 @@ private:
     std::shared_ptr<AudioSessionService> sessionService_;
 
     std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> focusCfgMap_ = {};
+    AudioFocusTable focusTable_;
     std::unordered_map<int32_t, std::shared_ptr<AudioInterruptZone>> zonesMap_;
 
     std::map<int32_t, std::shared_ptr<AudioInterruptClient>> interruptClients_;
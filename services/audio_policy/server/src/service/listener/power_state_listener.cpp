@@ -21,6 +21,7 @@
 #include "suspend/sync_sleep_callback_ipc_interface_code.h"
 #include "hibernate/sync_hibernate_callback_ipc_interface_code.h"
 #include "audio_policy_server.h"
+#include "audio_policy_manager_factory.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -83,6 +84,8 @@ PowerStateListener::PowerStateListener(const sptr<AudioPolicyServer> audioPolicy
 
 void PowerStateListener::OnSyncSleep(bool OnForceSleep)
 {
+    // the pending volumes are written before the system sleeps
+    AudioPolicyManagerFactory::GetAudioPolicyManager().HandleFlushVolume();
     CHECK_AND_RETURN_LOG(OnForceSleep, "OnSyncSleep not force sleep");
 
     ControlAudioFocus(true);
@@ -158,6 +161,7 @@ SyncHibernateListener::SyncHibernateListener(const sptr<AudioPolicyServer> audio
 void SyncHibernateListener::OnSyncHibernate()
 {
     AUDIO_INFO_LOG("OnSyncHibernate in hibernate");
+    AudioPolicyManagerFactory::GetAudioPolicyManager().HandleFlushVolume();
     ControlAudioFocus(true);
 }
  
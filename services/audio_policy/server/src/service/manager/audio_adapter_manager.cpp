@@ -24,6 +24,7 @@
 
 #include "audio_volume_parser.h"
 #include "audio_utils.h"
+#include "policy_snapshot_manager.h"
 
 using namespace std;
 
@@ -236,6 +237,7 @@ int32_t AudioAdapterManager::ReInitKVStore()
 
 void AudioAdapterManager::Deinit(void)
 {
+    volumeDataMaintainer_.FlushVolume();
     CHECK_AND_RETURN_LOG(audioServiceAdapter_, "Deinit audio adapter null");
 
     if (handler_ != nullptr) {
@@ -334,6 +336,24 @@ int32_t AudioAdapterManager::SetSystemVolumeLevel(AudioStreamType streamType, in
 void AudioAdapterManager::HandleSaveVolume(DeviceType deviceType, AudioStreamType streamType, int32_t volumeLevel)
 {
     volumeDataMaintainer_.SaveVolume(deviceType, streamType, volumeLevel);
+    ScheduleVolumeFlush();
+}
+
+void AudioAdapterManager::HandleFlushVolume()
+{
+    // the volumes stay pending on failure and are retried after the flush delay
+    if (!volumeDataMaintainer_.FlushVolume() && handler_ != nullptr) {
+        handler_->SendFlushVolume();
+    }
+}
+
+void AudioAdapterManager::ScheduleVolumeFlush()
+{
+    if (handler_ != nullptr) {
+        handler_->SendFlushVolume();
+    } else {
+        volumeDataMaintainer_.FlushVolume();
+    }
 }
 
 void AudioAdapterManager::HandleStreamMuteStatus(AudioStreamType streamType, bool mute, StreamUsage streamUsage)
@@ -668,6 +688,7 @@ int32_t AudioAdapterManager::SetRingerModeInternal(AudioRingerMode ringerMode)
 {
     AUDIO_INFO_LOG("SetRingerMode: %{public}d", ringerMode);
     ringerMode_ = ringerMode;
+    PolicySnapshotManager::GetInstance().Invalidate();
 
     if (handler_ != nullptr) {
         handler_->SendRingerModeUpdate(ringerMode);
@@ -1073,7 +1094,7 @@ void AudioAdapterManager::UpdateSafeVolume()
         case DEVICE_TYPE_USB_ARM_HEADSET:
             if (isWiredBoot_) {
                 volumeDataMaintainer_.SetStreamVolume(STREAM_MUSIC, safeVolume_);
-                volumeDataMaintainer_.SaveVolume(currentActiveDevice_, STREAM_MUSIC, safeVolume_);
+                HandleSaveVolume(currentActiveDevice_, STREAM_MUSIC, safeVolume_);
                 isWiredBoot_ = false;
             }
             break;
@@ -1081,7 +1102,7 @@ void AudioAdapterManager::UpdateSafeVolume()
         case DEVICE_TYPE_BLUETOOTH_A2DP:
             if (isBtBoot_) {
                 volumeDataMaintainer_.SetStreamVolume(STREAM_MUSIC, safeVolume_);
-                volumeDataMaintainer_.SaveVolume(currentActiveDevice_, STREAM_MUSIC, safeVolume_);
+                HandleSaveVolume(currentActiveDevice_, STREAM_MUSIC, safeVolume_);
                 isBtBoot_ = false;
             }
             break;
@@ -1104,7 +1125,7 @@ void AudioAdapterManager::InitVolumeMap(bool isFirstBoot)
         for (auto &streamType: VOLUME_TYPE_LIST) {
             // if GetVolume failed, wirte default value
             if (!volumeDataMaintainer_.GetVolume(deviceType, streamType)) {
-                volumeDataMaintainer_.SaveVolume(deviceType, streamType, volumeLevelMapTemp[streamType]);
+                HandleSaveVolume(deviceType, streamType, volumeLevelMapTemp[streamType]);
             }
         }
     }
@@ -1118,7 +1139,7 @@ void AudioAdapterManager::ResetRemoteCastDeviceVolume()
     for (auto &streamType: VOLUME_TYPE_LIST) {
         AudioStreamType streamAlias = VolumeUtils::GetVolumeTypeFromStreamType(streamType);
         int32_t volumeLevel = GetMaxVolumeLevel(streamAlias);
-        volumeDataMaintainer_.SaveVolume(DEVICE_TYPE_REMOTE_CAST, streamType, volumeLevel);
+        HandleSaveVolume(DEVICE_TYPE_REMOTE_CAST, streamType, volumeLevel);
     }
 }
 
@@ -1147,6 +1168,7 @@ void AudioAdapterManager::InitRingerMode(bool isFirstBoot)
         // if read ringer mode success, data is loaded.
         isLoaded_ = volumeDataMaintainer_.GetRingerMode(ringerMode_);
     }
+    PolicySnapshotManager::GetInstance().Invalidate();
     AudioStreamType streamForVolumeMap = VolumeUtils::GetVolumeTypeFromStreamType(STREAM_RING);
     int32_t volumeLevel =
         volumeDataMaintainer_.GetStreamVolume(STREAM_RING) * ((ringerMode_ != RINGER_MODE_NORMAL) ? 0 : 1);
@@ -1172,7 +1194,7 @@ void AudioAdapterManager::CloneVolumeMap(void)
             }
             int32_t volumeLevel = TransferByteArrayToType<int>(value.Data());
             // clone data to VolumeToShareData
-            volumeDataMaintainer_.SaveVolume(deviceType, streamType, volumeLevel);
+            HandleSaveVolume(deviceType, streamType, volumeLevel);
         }
     }
 
@@ -1778,6 +1800,15 @@ void AudioAdapterManager::SafeVolumeDump(std::string &dumpString)
     AppendFormat(dumpString, "  - SafeStatus: %s\n", status.c_str());
     AppendFormat(dumpString, "  - ActiveBtSafeTime: %lld\n", safeActiveBtTime_);
     AppendFormat(dumpString, "  - ActiveSafeTime: %lld\n", safeActiveTime_);
+
+    VolumeSaveStats stats = volumeDataMaintainer_.GetVolumeSaveStats();
+    dumpString += "VolumeSave info:\n";
+    AppendFormat(dumpString, "  - pending: %zu\n", stats.pendingCount);
+    AppendFormat(dumpString, "  - saved: %llu coalesced: %llu\n", static_cast<unsigned long long>(stats.savedCount),
+        static_cast<unsigned long long>(stats.coalescedCount));
+    AppendFormat(dumpString, "  - flushed: %llu in %llu batches, failed: %llu\n",
+        static_cast<unsigned long long>(stats.flushedCount), static_cast<unsigned long long>(stats.flushBatchCount),
+        static_cast<unsigned long long>(stats.failedCount));
 }
 // LCOV_EXCL_STOP
 } // namespace AudioStandard
@@ -23,6 +23,8 @@ namespace OHOS {
 namespace AudioStandard {
 namespace {
 constexpr int32_t MAX_DELAY_TIME = 4 * 1000;
+// holding a volume key writes the database about twice a second instead of at every step
+constexpr int64_t VOLUME_FLUSH_DELAY_TIME = 500;
 }
 AudioAdapterManagerHandler::AudioAdapterManagerHandler() : AppExecFwk::EventHandler(
     AppExecFwk::EventRunner::Create("OS_APAdapterAsyncRunner"))
@@ -83,6 +85,21 @@ bool AudioAdapterManagerHandler::SendRingerModeUpdate(const AudioRingerMode &rin
     return ret;
 }
 
+bool AudioAdapterManagerHandler::SendFlushVolume()
+{
+    if (flushVolumeScheduled_.exchange(true)) {
+        return true;
+    }
+    lock_guard<mutex> runnerlock(runnerMutex_);
+    bool ret = SendEvent(AppExecFwk::InnerEvent::Get(EventAdapterManagerServerCmd::VOLUME_DATABASE_FLUSH),
+        VOLUME_FLUSH_DELAY_TIME);
+    if (!ret) {
+        flushVolumeScheduled_.store(false);
+    }
+    CHECK_AND_RETURN_RET_LOG(ret, ret, "SendFlushVolume event failed");
+    return ret;
+}
+
 void AudioAdapterManagerHandler::HandleUpdateKvDataEvent(const AppExecFwk::InnerEvent::Pointer &event)
 {
     std::shared_ptr<bool> eventContextObj = event->GetSharedObject<bool>();
@@ -114,6 +131,13 @@ void AudioAdapterManagerHandler::HandleUpdateRingerMode(const AppExecFwk::InnerE
     AudioPolicyManagerFactory::GetAudioPolicyManager().HandleRingerMode(eventContextObj->ringerMode_);
 }
 
+void AudioAdapterManagerHandler::HandleVolumeDataBaseFlush(const AppExecFwk::InnerEvent::Pointer &event)
+{
+    // cleared first, a volume saved during the flush schedules the next one
+    flushVolumeScheduled_.store(false);
+    AudioPolicyManagerFactory::GetAudioPolicyManager().HandleFlushVolume();
+}
+
 void AudioAdapterManagerHandler::ReleaseEventRunner()
 {
     AUDIO_INFO_LOG("release all events");
@@ -138,6 +162,9 @@ void AudioAdapterManagerHandler::ProcessEvent(const AppExecFwk::InnerEvent::Poin
         case RINGER_MODE_UPDATE:
             HandleUpdateRingerMode(event);
             break;
+        case VOLUME_DATABASE_FLUSH:
+            HandleVolumeDataBaseFlush(event);
+            break;
         default:
             break;
     }
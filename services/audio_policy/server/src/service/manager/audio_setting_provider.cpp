@@ -280,6 +280,46 @@ ErrCode AudioSettingProvider::PutStringValue(const std::string &key, const std::
     return ERR_OK;
 }
 
+ErrCode AudioSettingProvider::PutIntValues(const std::vector<std::pair<std::string, int32_t>> &values,
+    std::string tableType, bool needNotify)
+{
+    if (values.empty()) {
+        return ERR_OK;
+    }
+    std::string callingIdentity = IPCSkeleton::ResetCallingIdentity();
+    auto helper = CreateDataShareHelper(tableType);
+    if (helper == nullptr) {
+        IPCSkeleton::SetCallingIdentity(callingIdentity);
+        return ERR_NO_INIT;
+    }
+    size_t failedCount = 0;
+    for (const auto &[key, value] : values) {
+        DataShare::DataShareValueObject keyObj(key);
+        DataShare::DataShareValueObject valueObj(std::to_string(value));
+        DataShare::DataShareValuesBucket bucket;
+        bucket.Put(SETTING_COLUMN_KEYWORD, keyObj);
+        bucket.Put(SETTING_COLUMN_VALUE, valueObj);
+        DataShare::DataSharePredicates predicates;
+        predicates.EqualTo(SETTING_COLUMN_KEYWORD, key);
+        Uri uri(AssembleUri(key, tableType));
+        if (helper->Update(uri, predicates, bucket) <= 0) {
+            AUDIO_DEBUG_LOG("no data exist, insert one row");
+            if (helper->Insert(uri, bucket) <= 0) {
+                AUDIO_ERR_LOG("Put %{public}s failed", key.c_str());
+                failedCount++;
+                continue;
+            }
+        }
+        if (needNotify) {
+            helper->NotifyChange(uri);
+        }
+    }
+    ReleaseDataShareHelper(helper);
+    IPCSkeleton::SetCallingIdentity(callingIdentity);
+    // the other values are written, writing them again with the failed ones is harmless
+    return failedCount == 0 ? ERR_OK : ERR_INVALID_OPERATION;
+}
+
 int32_t AudioSettingProvider::GetCurrentUserId()
 {
     std::vector<int> ids;
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "PolicySnapshotManager"
+#endif
+
+#include "policy_snapshot_manager.h"
+
+#include <sys/mman.h>
+
+#include "ashmem.h"
+#include "audio_errors.h"
+#include "audio_policy_log.h"
+
+namespace OHOS {
+namespace AudioStandard {
+PolicySnapshotManager &PolicySnapshotManager::GetInstance()
+{
+    static PolicySnapshotManager policySnapshotManager;
+    return policySnapshotManager;
+}
+
+int32_t PolicySnapshotManager::Init()
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (snapshotMemory_ != nullptr) {
+        return SUCCESS;
+    }
+    std::shared_ptr<AudioSharedMemory> memory = AudioSharedMemory::CreateFormLocal(sizeof(PolicySnapshotRegion),
+        "PolicySnapshot");
+    CHECK_AND_RETURN_RET_LOG(memory != nullptr && memory->GetBase() != nullptr, ERR_OPERATION_FAILED,
+        "Create shared memory failed");
+    region_ = reinterpret_cast<PolicySnapshotRegion *>(memory->GetBase());
+    PolicySnapshotSeqLock::Init(*region_);
+    // the mapping of policy server stays writable, clients can only map it read only
+    CHECK_AND_RETURN_RET_LOG(AshmemSetProt(memory->GetFd(), PROT_READ) >= 0, ERR_OPERATION_FAILED,
+        "Set shared memory read only failed");
+    snapshotMemory_ = memory;
+    isPublishedValid_ = false;
+    AUDIO_INFO_LOG("Init policy snapshot with size %{public}zu", sizeof(PolicySnapshotRegion));
+    return SUCCESS;
+}
+
+void PolicySnapshotManager::Invalidate()
+{
+    // bumped before the lock, so a publish collected before this change is dropped
+    generation_++;
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (region_ == nullptr || !isPublishedValid_) {
+        return;
+    }
+    PolicySnapshotSeqLock::Write(*region_, PolicySnapshotData());
+    isPublishedValid_ = false;
+}
+
+bool PolicySnapshotManager::NeedRefresh(uint64_t &generation)
+{
+    generation = generation_.load();
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return region_ != nullptr && !isPublishedValid_;
+}
+
+void PolicySnapshotManager::Publish(PolicySnapshotData &data, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (region_ == nullptr || generation != generation_.load()) {
+        return;
+    }
+    data.isValid = 1;
+    PolicySnapshotSeqLock::Write(*region_, data);
+    isPublishedValid_ = true;
+}
+
+int32_t PolicySnapshotManager::GetSnapshotFd(int32_t &fd, uint64_t &size)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_LOG(snapshotMemory_ != nullptr, ERR_ILLEGAL_STATE, "Policy snapshot is not inited");
+    fd = snapshotMemory_->GetFd();
+    size = static_cast<uint64_t>(snapshotMemory_->GetSize());
+    return SUCCESS;
+}
+} // namespace AudioStandard
+} // namespace OHOS
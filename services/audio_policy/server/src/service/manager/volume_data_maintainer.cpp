@@ -20,6 +20,7 @@
 #include "volume_data_maintainer.h"
 #include "system_ability_definition.h"
 #include "audio_policy_manager_factory.h"
+#include "policy_snapshot_manager.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -121,7 +122,6 @@ bool VolumeDataMaintainer::GetFirstBoot(bool &firstBoot)
 
 bool VolumeDataMaintainer::SaveVolume(DeviceType type, AudioStreamType streamType, int32_t volumeLevel)
 {
-    std::lock_guard<std::mutex> lock(volumeForDbMutex_);
     std::string volumeKey = GetVolumeKeyForDataShare(type, streamType);
     if (!volumeKey.compare("")) {
         AUDIO_ERR_LOG("[device %{public}d, streamType %{public}d] is not supported for datashare",
@@ -129,15 +129,55 @@ bool VolumeDataMaintainer::SaveVolume(DeviceType type, AudioStreamType streamTyp
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(pendingVolumeMutex_);
+    volumeSaveStats_.savedCount++;
+    if (!pendingVolumeMap_.insert_or_assign(volumeKey, volumeLevel).second) {
+        volumeSaveStats_.coalescedCount++;
+    }
+    return true;
+}
+
+bool VolumeDataMaintainer::FlushVolume()
+{
+    // held for the whole flush, so GetVolume never reads a value taken out of the pending map but not written yet
+    std::lock_guard<std::mutex> lock(volumeForDbMutex_);
+    std::vector<std::pair<std::string, int32_t>> values;
+    {
+        std::lock_guard<std::mutex> pendingLock(pendingVolumeMutex_);
+        values.assign(pendingVolumeMap_.begin(), pendingVolumeMap_.end());
+        pendingVolumeMap_.clear();
+    }
+    if (values.empty()) {
+        return true;
+    }
+
     AudioSettingProvider& audioSettingProvider = AudioSettingProvider::GetInstance(AUDIO_POLICY_SERVICE_ID);
-    ErrCode ret = audioSettingProvider.PutIntValue(volumeKey, volumeLevel, "system");
+    ErrCode ret = audioSettingProvider.PutIntValues(values, "system");
+
+    std::lock_guard<std::mutex> pendingLock(pendingVolumeMutex_);
     if (ret != SUCCESS) {
-        AUDIO_ERR_LOG("Save Volume To DataBase volumeMap failed");
+        AUDIO_ERR_LOG("Save %{public}zu volumes to database failed: %{public}d", values.size(), ret);
+        volumeSaveStats_.failedCount += values.size();
+        for (const auto &[key, value] : values) {
+            // a value saved during the flush is newer
+            pendingVolumeMap_.emplace(key, value);
+        }
         return false;
     }
+    volumeSaveStats_.flushedCount += values.size();
+    volumeSaveStats_.flushBatchCount++;
+    AUDIO_DEBUG_LOG("Saved %{public}zu volumes to database", values.size());
     return true;
 }
 
+VolumeSaveStats VolumeDataMaintainer::GetVolumeSaveStats()
+{
+    std::lock_guard<std::mutex> lock(pendingVolumeMutex_);
+    VolumeSaveStats stats = volumeSaveStats_;
+    stats.pendingCount = pendingVolumeMap_.size();
+    return stats;
+}
+
 bool VolumeDataMaintainer::GetVolume(DeviceType deviceType, AudioStreamType streamType)
 {
     std::lock_guard<std::mutex> lock(volumeForDbMutex_);
@@ -153,14 +193,25 @@ bool VolumeDataMaintainer::GetVolumeInternal(DeviceType deviceType, AudioStreamT
         return false;
     }
 
-    AudioSettingProvider& audioSettingProvider = AudioSettingProvider::GetInstance(AUDIO_POLICY_SERVICE_ID);
     int32_t volumeValue = 0;
-    ErrCode ret = audioSettingProvider.GetIntValue(volumeKey, volumeValue, "system");
+    ErrCode ret = SUCCESS;
+    std::unique_lock<std::mutex> pendingLock(pendingVolumeMutex_);
+    auto pendingIter = pendingVolumeMap_.find(volumeKey);
+    if (pendingIter != pendingVolumeMap_.end()) {
+        // not written to the database yet
+        volumeValue = pendingIter->second;
+        pendingLock.unlock();
+    } else {
+        pendingLock.unlock();
+        AudioSettingProvider& audioSettingProvider = AudioSettingProvider::GetInstance(AUDIO_POLICY_SERVICE_ID);
+        ret = audioSettingProvider.GetIntValue(volumeKey, volumeValue, "system");
+    }
     if (ret != SUCCESS) {
         AUDIO_ERR_LOG("Get Volume FromDataBase volumeMap failed");
         return false;
     } else {
         volumeLevelMap_[streamType] = volumeValue;
+        PolicySnapshotManager::GetInstance().Invalidate();
         AUDIO_PRERELEASE_LOGI("Get streamType %{public}d Volume FromDataBase volumeMap from datashare %{public}d",
             streamType, volumeValue);
     }
@@ -178,6 +229,7 @@ void VolumeDataMaintainer::SetStreamVolumeInternal(AudioStreamType streamType, i
 {
     AudioStreamType streamForVolumeMap = VolumeUtils::GetVolumeTypeFromStreamType(streamType);
     volumeLevelMap_[streamForVolumeMap] = volumeLevel;
+    PolicySnapshotManager::GetInstance().Invalidate();
 }
 
 int32_t VolumeDataMaintainer::GetStreamVolume(AudioStreamType streamType)
@@ -244,6 +296,7 @@ bool VolumeDataMaintainer::SetStreamMuteStatus(AudioStreamType streamType, bool
     std::lock_guard<std::mutex> lock(volumeMutex_);
     AudioStreamType streamForVolumeMap = VolumeUtils::GetVolumeTypeFromStreamType(streamType);
     muteStatusMap_[streamForVolumeMap] = muteStatus;
+    PolicySnapshotManager::GetInstance().Invalidate();
     return true;
 }
 
@@ -270,6 +323,7 @@ bool VolumeDataMaintainer::GetMuteStatusInternal(DeviceType deviceType, AudioStr
         return false;
     } else {
         muteStatusMap_[streamType] = muteStatus;
+        PolicySnapshotManager::GetInstance().Invalidate();
         AUDIO_DEBUG_LOG("Get MuteStatus From DataBase muteStatus from datashare %{public}d", muteStatus);
     }
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioRouteCache"
+#endif
+
+#include "audio_route_cache.h"
+
+#include <cinttypes>
+#include <tuple>
+
+#include "audio_policy_log.h"
+#include "audio_utils.h"
+
+using namespace std;
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+// keys are bounded by usages, scenes and app selections, the cap only guards against a leak of uid buckets
+constexpr size_t ROUTE_CACHE_MAX_SIZE = 256;
+}
+
+bool AudioRouteCacheKey::operator<(const AudioRouteCacheKey &other) const
+{
+    return tie(streamUsage, uidBucket, audioScene, ringerMode) <
+        tie(other.streamUsage, other.uidBucket, other.audioScene, other.ringerMode);
+}
+
+AudioRouteCache &AudioRouteCache::GetInstance()
+{
+    static AudioRouteCache audioRouteCache;
+    return audioRouteCache;
+}
+
+void AudioRouteCache::Invalidate()
+{
+    generation_++;
+}
+
+uint64_t AudioRouteCache::GetGeneration() const
+{
+    return generation_.load();
+}
+
+bool AudioRouteCache::Find(const AudioRouteCacheKey &key, vector<unique_ptr<AudioDeviceDescriptor>> &descs)
+{
+    lock_guard<mutex> lock(cacheMutex_);
+    uint64_t generation = generation_.load();
+    if (routesGeneration_ != generation) {
+        routes_.clear();
+        routesGeneration_ = generation;
+    }
+    auto iter = routes_.find(key);
+    if (iter == routes_.end()) {
+        missCount_++;
+        return false;
+    }
+    hitCount_++;
+    descs.clear();
+    for (auto &desc : iter->second) {
+        descs.push_back(make_unique<AudioDeviceDescriptor>(desc));
+    }
+    return true;
+}
+
+void AudioRouteCache::Store(const AudioRouteCacheKey &key, uint64_t generation,
+    const vector<unique_ptr<AudioDeviceDescriptor>> &descs)
+{
+    lock_guard<mutex> lock(cacheMutex_);
+    if (generation != generation_.load()) {
+        return;
+    }
+    if (routesGeneration_ != generation || routes_.size() >= ROUTE_CACHE_MAX_SIZE) {
+        routes_.clear();
+        routesGeneration_ = generation;
+    }
+    vector<AudioDeviceDescriptor> &route = routes_[key];
+    route.clear();
+    for (auto &desc : descs) {
+        CHECK_AND_CONTINUE_LOG(desc != nullptr, "desc is null");
+        route.push_back(*desc);
+    }
+}
+
+void AudioRouteCache::Dump(string &dumpString)
+{
+    lock_guard<mutex> lock(cacheMutex_);
+    AppendFormat(dumpString, "Route cache:\n");
+    AppendFormat(dumpString, "  - generation: %" PRIu64 " entries: %zu hit: %" PRIu64 " miss: %" PRIu64 "\n",
+        generation_.load(), routes_.size(), hitCount_, missCount_);
+}
+} // namespace AudioStandard
+} // namespace OHOS
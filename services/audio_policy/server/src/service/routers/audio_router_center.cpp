@@ -18,6 +18,8 @@
 
 #include "audio_router_center.h"
 #include "audio_policy_service.h"
+#include "audio_affinity_manager.h"
+#include "audio_route_cache.h"
 
 using namespace std;
 
@@ -101,14 +103,39 @@ bool AudioRouterCenter::HasScoDevice()
     return false;
 }
 
+bool AudioRouterCenter::IsRouteCacheable(AudioScene audioScene)
+{
+    // Call scenes route media and ring streams after the running call stream, and a refiner may decide anything.
+    if (audioScene == AUDIO_SCENE_PHONE_CALL || audioScene == AUDIO_SCENE_PHONE_CHAT ||
+        audioScene == AUDIO_SCENE_RINGING || audioScene == AUDIO_SCENE_VOICE_RINGING) {
+        return false;
+    }
+    return audioDeviceRefinerCb_ == nullptr;
+}
+
 std::vector<std::unique_ptr<AudioDeviceDescriptor>> AudioRouterCenter::FetchOutputDevices(StreamUsage streamUsage,
     int32_t clientUID)
 {
     vector<unique_ptr<AudioDeviceDescriptor>> descs;
+    AudioScene audioScene = AudioPolicyService::GetAudioPolicyService().GetAudioScene();
+    bool isCacheable = IsRouteCacheable(audioScene);
+    AudioRouteCacheKey cacheKey;
+    uint64_t cacheGeneration = AudioRouteCache::GetInstance().GetGeneration();
+    if (isCacheable) {
+        cacheKey.streamUsage = streamUsage;
+        cacheKey.uidBucket = AudioAffinityManager::GetAudioAffinityManager().HasSelectRendererDevice(clientUID) ?
+            clientUID : ROUTE_CACHE_SHARED_UID_BUCKET;
+        cacheKey.audioScene = audioScene;
+        cacheKey.ringerMode = AudioPolicyService::GetAudioPolicyService().GetRingerMode();
+        if (AudioRouteCache::GetInstance().Find(cacheKey, descs) && !descs.empty()) {
+            AUDIO_DEBUG_LOG("usage:%{public}d uid:%{public}d hit route cache, 1st type:[%{public}d]", streamUsage,
+                clientUID, descs[0]->deviceType_);
+            return descs;
+        }
+    }
     RouterType routerType = ROUTER_TYPE_NONE;
     if (renderConfigMap_[streamUsage] == MEDIA_RENDER_ROUTERS ||
         renderConfigMap_[streamUsage] == TONE_RENDER_ROUTERS) {
-        AudioScene audioScene = AudioPolicyService::GetAudioPolicyService().GetAudioScene();
         unique_ptr<AudioDeviceDescriptor> desc = make_unique<AudioDeviceDescriptor>();
         if (audioScene == AUDIO_SCENE_PHONE_CALL || audioScene == AUDIO_SCENE_PHONE_CHAT ||
             ((audioScene == AUDIO_SCENE_RINGING || audioScene == AUDIO_SCENE_VOICE_RINGING) && HasScoDevice())) {
@@ -148,6 +175,9 @@ std::vector<std::unique_ptr<AudioDeviceDescriptor>> AudioRouterCenter::FetchOutp
     DeviceType type = descs[0]->deviceType_;
     AUDIO_PRERELEASE_LOGI("usage:%{public}d uid:%{public}d size:[%{public}zu], 1st type:[%{public}d], id:[%{public}d],"
         " router:%{public}d ", streamUsage, clientUID, descs.size(), type, audioId_, routerType);
+    if (isCacheable) {
+        AudioRouteCache::GetInstance().Store(cacheKey, cacheGeneration, descs);
+    }
     return descs;
 }
 
@@ -231,6 +261,7 @@ int32_t AudioRouterCenter::SetAudioDeviceRefinerCallback(const sptr<IRemoteObjec
     sptr<IStandardAudioRoutingManagerListener> listener = iface_cast<IStandardAudioRoutingManagerListener>(object);
     if (listener != nullptr) {
         audioDeviceRefinerCb_ = listener;
+        AudioRouteCache::GetInstance().Invalidate();
         return SUCCESS;
     } else {
         return ERROR;
@@ -240,6 +271,7 @@ int32_t AudioRouterCenter::SetAudioDeviceRefinerCallback(const sptr<IRemoteObjec
 int32_t AudioRouterCenter::UnsetAudioDeviceRefinerCallback()
 {
     audioDeviceRefinerCb_ = nullptr;
+    AudioRouteCache::GetInstance().Invalidate();
     return SUCCESS;
 }
 
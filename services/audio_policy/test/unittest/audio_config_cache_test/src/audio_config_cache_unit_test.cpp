@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <unistd.h>
+#include "audio_config_cache.h"
+#include "audio_errors.h"
+#include "audio_focus_parser.h"
+#include "audio_volume_parser.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const std::string TEST_SOURCE_FILE = "/data/local/tmp/audio_config_cache_test.xml";
+const std::string TEST_CACHE_FILE = "/data/local/tmp/audio_config_cache_test.cache";
+const char *FOCUS_CONFIG_PATH = "/system/etc/audio/audio_interrupt_policy_config.xml";
+const char *VOLUME_CONFIG_PATH = "/system/etc/audio/audio_volume_config.xml";
+const int32_t BENCHMARK_ROUNDS = 20;
+
+struct TestRecord {
+    int32_t id;
+    int32_t value;
+};
+
+void WriteSource(const std::string &content)
+{
+    std::ofstream source(TEST_SOURCE_FILE, std::ios::trunc);
+    source << content;
+}
+
+int64_t GetElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+class AudioConfigCacheUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void AudioConfigCacheUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void AudioConfigCacheUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void AudioConfigCacheUnitTest::SetUp(void)
+{
+    unlink(TEST_CACHE_FILE.c_str());
+}
+
+void AudioConfigCacheUnitTest::TearDown(void)
+{
+    unlink(TEST_CACHE_FILE.c_str());
+    unlink(TEST_SOURCE_FILE.c_str());
+}
+
+/**
+ * @tc.name  : Test AudioConfigCache Store and Load
+ * @tc.number: AudioConfigCache_001
+ * @tc.desc  : Test stored records are mapped back as they are.
+ */
+HWTEST_F(AudioConfigCacheUnitTest, AudioConfigCache_001, TestSize.Level1)
+{
+    WriteSource("<config>1</config>");
+    std::vector<TestRecord> records = {{1, 10}, {2, 20}, {3, 30}};
+    {
+        AudioConfigCache cache(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+        EXPECT_FALSE(cache.Load(sizeof(TestRecord)));
+        EXPECT_TRUE(cache.Store(records));
+    }
+
+    AudioConfigCache cache(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+    ASSERT_TRUE(cache.Load(sizeof(TestRecord)));
+    uint64_t count = 0;
+    const TestRecord *cached = cache.GetRecords<TestRecord>(count);
+    ASSERT_EQ(count, records.size());
+    for (uint64_t i = 0; i < count; i++) {
+        EXPECT_EQ(cached[i].id, records[i].id);
+        EXPECT_EQ(cached[i].value, records[i].value);
+    }
+}
+
+/**
+ * @tc.name  : Test AudioConfigCache Load
+ * @tc.number: AudioConfigCache_002
+ * @tc.desc  : Test a cache of another version, record size or source is not loaded.
+ */
+HWTEST_F(AudioConfigCacheUnitTest, AudioConfigCache_002, TestSize.Level1)
+{
+    WriteSource("<config>1</config>");
+    std::vector<TestRecord> records = {{1, 10}};
+    {
+        AudioConfigCache cache(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+        EXPECT_TRUE(cache.Store(records));
+    }
+    AudioConfigCache otherVersion(TEST_CACHE_FILE, TEST_SOURCE_FILE, 2);
+    EXPECT_FALSE(otherVersion.Load(sizeof(TestRecord)));
+    AudioConfigCache otherSize(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+    EXPECT_FALSE(otherSize.Load(sizeof(int32_t)));
+
+    WriteSource("<config>2</config>");
+    AudioConfigCache changedSource(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+    EXPECT_FALSE(changedSource.Load(sizeof(TestRecord)));
+
+    std::ofstream corrupt(TEST_CACHE_FILE, std::ios::in | std::ios::out | std::ios::ate);
+    corrupt << "x";
+    corrupt.close();
+    AudioConfigCache corrupted(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+    EXPECT_FALSE(corrupted.Load(sizeof(TestRecord)));
+}
+
+/**
+ * @tc.name  : Test AudioFocusParser cache
+ * @tc.number: AudioConfigCache_003
+ * @tc.desc  : Test the focus config loaded from the cache equals the parsed one and loads faster.
+ */
+HWTEST_F(AudioConfigCacheUnitTest, AudioConfigCache_003, TestSize.Level1)
+{
+    if (access(FOCUS_CONFIG_PATH, R_OK) != 0) {
+        return;
+    }
+    AudioFocusParser parser;
+    std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> parsedMap;
+    ASSERT_EQ(parser.ParseConfig(FOCUS_CONFIG_PATH, parsedMap), SUCCESS);
+    {
+        AudioConfigCache cache(TEST_CACHE_FILE, FOCUS_CONFIG_PATH, 1);
+        parser.StoreToCache(cache, parsedMap);
+    }
+
+    int64_t parseUs = 0;
+    int64_t cacheUs = 0;
+    std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> cachedMap;
+    for (int32_t i = 0; i < BENCHMARK_ROUNDS; i++) {
+        std::map<std::pair<AudioFocusType, AudioFocusType>, AudioFocusEntry> focusMap;
+        auto start = std::chrono::steady_clock::now();
+        parser.ParseConfig(FOCUS_CONFIG_PATH, focusMap);
+        parseUs += GetElapsedUs(start);
+
+        cachedMap.clear();
+        start = std::chrono::steady_clock::now();
+        AudioConfigCache cache(TEST_CACHE_FILE, FOCUS_CONFIG_PATH, 1);
+        ASSERT_TRUE(parser.LoadFromCache(cache, cachedMap));
+        cacheUs += GetElapsedUs(start);
+    }
+    EXPECT_LT(cacheUs, parseUs);
+
+    ASSERT_EQ(cachedMap.size(), parsedMap.size());
+    for (const auto &[focusTypePair, focusEntry] : parsedMap) {
+        auto iter = cachedMap.find(focusTypePair);
+        ASSERT_NE(iter, cachedMap.end());
+        EXPECT_EQ(iter->second.forceType, focusEntry.forceType);
+        EXPECT_EQ(iter->second.hintType, focusEntry.hintType);
+        EXPECT_EQ(iter->second.actionOn, focusEntry.actionOn);
+        EXPECT_EQ(iter->second.isReject, focusEntry.isReject);
+    }
+}
+
+/**
+ * @tc.name  : Test AudioVolumeParser cache
+ * @tc.number: AudioConfigCache_004
+ * @tc.desc  : Test the volume config loaded from the cache equals the parsed one and loads faster.
+ */
+HWTEST_F(AudioConfigCacheUnitTest, AudioConfigCache_004, TestSize.Level1)
+{
+    if (access(VOLUME_CONFIG_PATH, R_OK) != 0) {
+        return;
+    }
+    AudioVolumeParser parser;
+    StreamVolumeInfoMap parsedMap;
+    ASSERT_EQ(parser.ParseVolumeConfig(VOLUME_CONFIG_PATH, parsedMap), SUCCESS);
+    {
+        AudioConfigCache cache(TEST_CACHE_FILE, VOLUME_CONFIG_PATH, 1);
+        parser.StoreToCache(cache, parsedMap);
+    }
+
+    int64_t parseUs = 0;
+    int64_t cacheUs = 0;
+    StreamVolumeInfoMap cachedMap;
+    for (int32_t i = 0; i < BENCHMARK_ROUNDS; i++) {
+        StreamVolumeInfoMap volumeMap;
+        auto start = std::chrono::steady_clock::now();
+        parser.ParseVolumeConfig(VOLUME_CONFIG_PATH, volumeMap);
+        parseUs += GetElapsedUs(start);
+
+        cachedMap.clear();
+        start = std::chrono::steady_clock::now();
+        AudioConfigCache cache(TEST_CACHE_FILE, VOLUME_CONFIG_PATH, 1);
+        ASSERT_TRUE(parser.LoadFromCache(cache, cachedMap));
+        cacheUs += GetElapsedUs(start);
+    }
+    EXPECT_LT(cacheUs, parseUs);
+
+    ASSERT_EQ(cachedMap.size(), parsedMap.size());
+    for (const auto &[streamType, streamVolInfo] : parsedMap) {
+        ASSERT_NE(cachedMap[streamType], nullptr);
+        EXPECT_EQ(cachedMap[streamType]->maxLevel, streamVolInfo->maxLevel);
+        EXPECT_EQ(cachedMap[streamType]->defaultLevel, streamVolInfo->defaultLevel);
+        auto &cachedDevices = cachedMap[streamType]->deviceVolumeInfos;
+        ASSERT_EQ(cachedDevices.size(), streamVolInfo->deviceVolumeInfos.size());
+        for (const auto &[deviceType, deviceVolInfo] : streamVolInfo->deviceVolumeInfos) {
+            ASSERT_NE(cachedDevices[deviceType], nullptr);
+            ASSERT_EQ(cachedDevices[deviceType]->volumePoints.size(), deviceVolInfo->volumePoints.size());
+            for (size_t i = 0; i < deviceVolInfo->volumePoints.size(); i++) {
+                EXPECT_EQ(cachedDevices[deviceType]->volumePoints[i].index, deviceVolInfo->volumePoints[i].index);
+                EXPECT_EQ(cachedDevices[deviceType]->volumePoints[i].dbValue,
+                    deviceVolInfo->volumePoints[i].dbValue);
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name  : Test AudioConfigCache Load
+ * @tc.number: AudioConfigCache_005
+ * @tc.desc  : Test a cache written by another build is not loaded.
+ */
+HWTEST_F(AudioConfigCacheUnitTest, AudioConfigCache_005, TestSize.Level1)
+{
+    WriteSource("<config>1</config>");
+    std::vector<TestRecord> records = {{1, 10}};
+    {
+        AudioConfigCache cache(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+        EXPECT_TRUE(cache.Store(records));
+    }
+    AudioConfigCache otherBuild(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+    otherBuild.buildHash_++;
+    EXPECT_FALSE(otherBuild.Load(sizeof(TestRecord)));
+
+    AudioConfigCache sameBuild(TEST_CACHE_FILE, TEST_SOURCE_FILE, 1);
+    EXPECT_TRUE(sameBuild.Load(sizeof(TestRecord)));
+}
+} // namespace AudioStandard
+} // namespace OHOS
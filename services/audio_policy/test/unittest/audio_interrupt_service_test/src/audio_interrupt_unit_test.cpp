@@ -15,6 +15,7 @@
 
 #include "audio_interrupt_unit_test.h"
 
+#include <chrono>
 #include <thread>
 #include <memory>
 #include <vector>
@@ -646,5 +647,91 @@ HWTEST(AudioInterruptUnitTest, AudioInterruptService_019, TestSize.Level1)
     );
 }
 
+/**
+* @tc.name  : Test AudioInterruptService.
+* @tc.number: AudioInterruptService_020
+* @tc.desc  : Test the focus table built from the focus config.
+*/
+HWTEST(AudioInterruptUnitTest, AudioInterruptService_020, TestSize.Level1)
+{
+    auto interruptServiceTest = GetTnterruptServiceTest();
+    AudioFocusType music = {STREAM_MUSIC, SOURCE_TYPE_INVALID, true};
+    AudioFocusType voiceCall = {STREAM_VOICE_CALL, SOURCE_TYPE_INVALID, true};
+    AudioFocusType mic = {STREAM_DEFAULT, SOURCE_TYPE_MIC, false};
+    AudioFocusType ring = {STREAM_RING, SOURCE_TYPE_INVALID, true};
+    interruptServiceTest->focusCfgMap_[std::make_pair(music, voiceCall)] =
+        {INTERRUPT_FORCE, INTERRUPT_HINT_PAUSE, CURRENT, false};
+    interruptServiceTest->focusCfgMap_[std::make_pair(voiceCall, mic)] =
+        {INTERRUPT_SHARE, INTERRUPT_HINT_NONE, INCOMING, true};
+    interruptServiceTest->focusTable_.Build(interruptServiceTest->focusCfgMap_);
+    EXPECT_EQ(interruptServiceTest->focusTable_.GetTypeCount(), 3u);
+
+    const AudioFocusEntry *entry = interruptServiceTest->focusTable_.Find(music, voiceCall);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->hintType, INTERRUPT_HINT_PAUSE);
+    EXPECT_EQ(entry->actionOn, CURRENT);
+    entry = interruptServiceTest->focusTable_.Find(voiceCall, mic);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->isReject, true);
+
+    EXPECT_EQ(interruptServiceTest->focusTable_.Find(voiceCall, music), nullptr);
+    EXPECT_EQ(interruptServiceTest->focusTable_.Find(music, ring), nullptr);
+    AudioFocusType invalid = {STREAM_ALL, SOURCE_TYPE_INVALID, true};
+    EXPECT_EQ(interruptServiceTest->focusTable_.Find(invalid, music), nullptr);
+
+    interruptServiceTest->focusTable_.Clear();
+    EXPECT_EQ(interruptServiceTest->focusTable_.Find(music, voiceCall), nullptr);
+}
+
+/**
+* @tc.name  : Test AudioInterruptService.
+* @tc.number: AudioInterruptService_021
+* @tc.desc  : Test ProcessActiveInterrupt with 100 active interrupts stays within its time bound.
+*/
+HWTEST(AudioInterruptUnitTest, AudioInterruptService_021, TestSize.Level1)
+{
+    const int32_t activeCount = 100;
+    const int32_t rounds = 100;
+    const int64_t maxAverageUs = 10000; // 100us per active interrupt, far above a table lookup and its event
+    auto interruptServiceTest = GetTnterruptServiceTest();
+    AudioFocusType music = {STREAM_MUSIC, SOURCE_TYPE_INVALID, true};
+    AudioFocusType voiceCall = {STREAM_VOICE_CALL, SOURCE_TYPE_INVALID, true};
+    interruptServiceTest->focusCfgMap_[std::make_pair(music, voiceCall)] =
+        {INTERRUPT_FORCE, INTERRUPT_HINT_PAUSE, CURRENT, false};
+    interruptServiceTest->focusTable_.Build(interruptServiceTest->focusCfgMap_);
+
+    auto audioInterruptZone = std::make_shared<AudioInterruptZone>();
+    for (int32_t i = 0; i < activeCount; i++) {
+        AudioInterrupt audioInterrupt;
+        audioInterrupt.audioFocusType = music;
+        audioInterrupt.pid = i + 1;
+        audioInterrupt.sessionId = static_cast<uint32_t>(i + 1);
+        audioInterruptZone->audioFocusInfoList.emplace_back(audioInterrupt, ACTIVE);
+    }
+    interruptServiceTest->zonesMap_[0] = audioInterruptZone;
+
+    AudioInterrupt incoming;
+    incoming.audioFocusType = voiceCall;
+    incoming.pid = activeCount + 1;
+    incoming.sessionId = static_cast<uint32_t>(activeCount + 1);
+
+    int64_t totalUs = 0;
+    for (int32_t round = 0; round < rounds; round++) {
+        for (auto &focusInfo : audioInterruptZone->audioFocusInfoList) {
+            focusInfo.second = ACTIVE;
+        }
+        auto start = std::chrono::steady_clock::now();
+        interruptServiceTest->ProcessActiveInterrupt(0, incoming);
+        totalUs += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    EXPECT_LT(totalUs / rounds, maxAverageUs);
+
+    EXPECT_EQ(audioInterruptZone->audioFocusInfoList.size(), static_cast<size_t>(activeCount));
+    for (const auto &focusInfo : audioInterruptZone->audioFocusInfoList) {
+        EXPECT_EQ(focusInfo.second, PAUSE);
+    }
+}
+
 } // namespace AudioStandard
 } // namespace OHOS
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include "audio_errors.h"
+#include "audio_policy_service.h"
+#include "audio_policy_snapshot.h"
+#include "policy_snapshot_manager.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+class AudioPolicySnapshotUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void AudioPolicySnapshotUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void AudioPolicySnapshotUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void AudioPolicySnapshotUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void AudioPolicySnapshotUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test PolicySnapshotSeqLock Read
+ * @tc.number: PolicySnapshot_001
+ * @tc.desc  : Test written data is read back as it is.
+ */
+HWTEST_F(AudioPolicySnapshotUnitTest, PolicySnapshot_001, TestSize.Level1)
+{
+    PolicySnapshotRegion region;
+    PolicySnapshotSeqLock::Init(region);
+    PolicySnapshotData data;
+    data.isValid = 1;
+    data.volumeLevel[STREAM_MUSIC] = 5; // 5 for a volume level
+    data.isMute[STREAM_ALARM] = 1;
+    data.activeOutputDevice = DEVICE_TYPE_SPEAKER;
+    data.activeInputDevice = DEVICE_TYPE_MIC;
+    data.audioScene = AUDIO_SCENE_RINGING;
+    data.ringerMode = RINGER_MODE_VIBRATE;
+    PolicySnapshotSeqLock::Write(region, data);
+
+    PolicySnapshotData readData;
+    EXPECT_TRUE(PolicySnapshotSeqLock::Read(region, readData));
+    EXPECT_EQ(0, memcmp(&data, &readData, sizeof(data)));
+    EXPECT_EQ(0, region.sequence.load() % 2);
+}
+
+/**
+ * @tc.name  : Test PolicySnapshotSeqLock Read
+ * @tc.number: PolicySnapshot_002
+ * @tc.desc  : Test read fails while a write is in progress or the layout does not match.
+ */
+HWTEST_F(AudioPolicySnapshotUnitTest, PolicySnapshot_002, TestSize.Level1)
+{
+    PolicySnapshotRegion region;
+    PolicySnapshotSeqLock::Init(region);
+    PolicySnapshotData readData;
+    EXPECT_TRUE(PolicySnapshotSeqLock::Read(region, readData));
+    EXPECT_EQ(0, readData.isValid);
+
+    region.sequence.fetch_add(1);
+    EXPECT_FALSE(PolicySnapshotSeqLock::Read(region, readData));
+    region.sequence.fetch_add(1);
+    EXPECT_TRUE(PolicySnapshotSeqLock::Read(region, readData));
+
+    region.layoutVersion = POLICY_SNAPSHOT_LAYOUT_VERSION + 1;
+    EXPECT_FALSE(PolicySnapshotSeqLock::Read(region, readData));
+}
+
+/**
+ * @tc.name  : Test PolicySnapshotManager Publish
+ * @tc.number: PolicySnapshot_003
+ * @tc.desc  : Test published data is seen through a read only mapping, and invalidated or stale data is not.
+ */
+HWTEST_F(AudioPolicySnapshotUnitTest, PolicySnapshot_003, TestSize.Level1)
+{
+    PolicySnapshotManager &manager = PolicySnapshotManager::GetInstance();
+    ASSERT_EQ(SUCCESS, manager.Init());
+    int32_t fd = -1;
+    uint64_t size = 0;
+    ASSERT_EQ(SUCCESS, manager.GetSnapshotFd(fd, size));
+    ASSERT_GE(size, sizeof(PolicySnapshotRegion));
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ASSERT_NE(MAP_FAILED, addr);
+    const PolicySnapshotRegion *region = static_cast<const PolicySnapshotRegion *>(addr);
+
+    uint64_t generation = 0;
+    manager.Invalidate();
+    EXPECT_TRUE(manager.NeedRefresh(generation));
+    PolicySnapshotData data;
+    data.ringerMode = RINGER_MODE_SILENT;
+    manager.Publish(data, generation);
+    EXPECT_FALSE(manager.NeedRefresh(generation));
+    PolicySnapshotData readData;
+    EXPECT_TRUE(PolicySnapshotSeqLock::Read(*region, readData));
+    EXPECT_EQ(1, readData.isValid);
+    EXPECT_EQ(RINGER_MODE_SILENT, readData.ringerMode);
+
+    manager.Invalidate();
+    EXPECT_TRUE(PolicySnapshotSeqLock::Read(*region, readData));
+    EXPECT_EQ(0, readData.isValid);
+
+    // state changed while collecting, the collected data must be dropped
+    EXPECT_TRUE(manager.NeedRefresh(generation));
+    manager.Invalidate();
+    manager.Publish(data, generation);
+    EXPECT_TRUE(manager.NeedRefresh(generation));
+    EXPECT_TRUE(PolicySnapshotSeqLock::Read(*region, readData));
+    EXPECT_EQ(0, readData.isValid);
+    munmap(addr, size);
+}
+
+/**
+ * @tc.name  : Test AudioPolicyService UpdateInputDeviceInfo
+ * @tc.number: PolicySnapshot_004
+ * @tc.desc  : Test a change of the active input device invalidates the snapshot, and an unchanged one does not.
+ */
+HWTEST_F(AudioPolicySnapshotUnitTest, PolicySnapshot_004, TestSize.Level1)
+{
+    PolicySnapshotManager &manager = PolicySnapshotManager::GetInstance();
+    ASSERT_EQ(SUCCESS, manager.Init());
+    AudioPolicyService &service = AudioPolicyService::GetAudioPolicyService();
+    service.UpdateInputDeviceInfo(DEVICE_TYPE_SPEAKER);
+
+    uint64_t generation = 0;
+    manager.NeedRefresh(generation);
+    PolicySnapshotData data;
+    manager.Publish(data, generation);
+    EXPECT_FALSE(manager.NeedRefresh(generation));
+
+    service.UpdateInputDeviceInfo(DEVICE_TYPE_EARPIECE);
+    EXPECT_FALSE(manager.NeedRefresh(generation));
+
+    service.UpdateInputDeviceInfo(DEVICE_TYPE_WIRED_HEADSET);
+    EXPECT_TRUE(manager.NeedRefresh(generation));
+    manager.Publish(data, generation);
+    EXPECT_FALSE(manager.NeedRefresh(generation));
+
+    service.UpdateInputDeviceInfo(DEVICE_TYPE_SPEAKER);
+    EXPECT_TRUE(manager.NeedRefresh(generation));
+}
+} // namespace AudioStandard
+} // namespace OHOS
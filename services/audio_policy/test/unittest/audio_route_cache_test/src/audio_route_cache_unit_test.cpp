@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "audio_affinity_manager.h"
+#include "audio_device_manager.h"
+#include "audio_errors.h"
+#include "audio_route_cache.h"
+#include "audio_state_manager.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const int32_t TEST_CLIENT_UID = 20010041;
+const uint32_t TEST_SESSION_ID = 100001;
+const uint32_t OTHER_SESSION_ID = 100002;
+
+AudioRouteCacheKey GetTestKey()
+{
+    AudioRouteCacheKey key;
+    key.streamUsage = STREAM_USAGE_MUSIC;
+    return key;
+}
+
+sptr<AudioDeviceDescriptor> GetTestDevice()
+{
+    sptr<AudioDeviceDescriptor> desc = new(std::nothrow) AudioDeviceDescriptor(DEVICE_TYPE_WIRED_HEADSET,
+        OUTPUT_DEVICE);
+    desc->networkId_ = LOCAL_NETWORK_ID;
+    desc->macAddress_ = "00:00:00:00:00:01";
+    return desc;
+}
+
+// Stores a route at the current generation, so the next Find only misses if it was invalidated.
+void StoreTestRoute()
+{
+    AudioRouteCache &cache = AudioRouteCache::GetInstance();
+    std::vector<std::unique_ptr<AudioDeviceDescriptor>> descs;
+    descs.push_back(std::make_unique<AudioDeviceDescriptor>(DEVICE_TYPE_SPEAKER, OUTPUT_DEVICE));
+    cache.Store(GetTestKey(), cache.GetGeneration(), descs);
+}
+
+bool IsTestRouteCached()
+{
+    std::vector<std::unique_ptr<AudioDeviceDescriptor>> descs;
+    return AudioRouteCache::GetInstance().Find(GetTestKey(), descs);
+}
+} // namespace
+
+class AudioRouteCacheUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void AudioRouteCacheUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void AudioRouteCacheUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void AudioRouteCacheUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void AudioRouteCacheUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test AudioRouteCache Find
+ * @tc.number: AudioRouteCache_001
+ * @tc.desc  : Test a stored route is found, and a route fetched across an invalidation is not stored.
+ */
+HWTEST_F(AudioRouteCacheUnitTest, AudioRouteCache_001, TestSize.Level1)
+{
+    AudioRouteCache &cache = AudioRouteCache::GetInstance();
+    StoreTestRoute();
+    std::vector<std::unique_ptr<AudioDeviceDescriptor>> descs;
+    ASSERT_TRUE(cache.Find(GetTestKey(), descs));
+    ASSERT_EQ(1, descs.size());
+    EXPECT_EQ(DEVICE_TYPE_SPEAKER, descs[0]->deviceType_);
+
+    AudioRouteCacheKey otherKey = GetTestKey();
+    otherKey.audioScene = AUDIO_SCENE_RINGING;
+    EXPECT_FALSE(cache.Find(otherKey, descs));
+
+    uint64_t generation = cache.GetGeneration();
+    cache.Invalidate();
+    EXPECT_FALSE(IsTestRouteCached());
+    cache.Store(GetTestKey(), generation, descs);
+    EXPECT_FALSE(IsTestRouteCached());
+}
+
+/**
+ * @tc.name  : Test AudioRouteCache Invalidate
+ * @tc.number: AudioRouteCache_002
+ * @tc.desc  : Test adding and removing a device invalidates the cached routes.
+ */
+HWTEST_F(AudioRouteCacheUnitTest, AudioRouteCache_002, TestSize.Level1)
+{
+    AudioDeviceManager &deviceManager = AudioDeviceManager::GetAudioDeviceManager();
+    sptr<AudioDeviceDescriptor> desc = GetTestDevice();
+    ASSERT_NE(nullptr, desc);
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    deviceManager.AddNewDevice(desc);
+    EXPECT_FALSE(IsTestRouteCached());
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    deviceManager.RemoveNewDevice(desc);
+    EXPECT_FALSE(IsTestRouteCached());
+}
+
+/**
+ * @tc.name  : Test AudioRouteCache Invalidate
+ * @tc.number: AudioRouteCache_003
+ * @tc.desc  : Test changing a preferred device invalidates the cached routes.
+ */
+HWTEST_F(AudioRouteCacheUnitTest, AudioRouteCache_003, TestSize.Level1)
+{
+    AudioStateManager &stateManager = AudioStateManager::GetAudioStateManager();
+    sptr<AudioDeviceDescriptor> desc = GetTestDevice();
+    ASSERT_NE(nullptr, desc);
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    stateManager.SetPreferredMediaRenderDevice(desc);
+    EXPECT_FALSE(IsTestRouteCached());
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    stateManager.SetPreferredMediaRenderDevice(new(std::nothrow) AudioDeviceDescriptor());
+    EXPECT_FALSE(IsTestRouteCached());
+}
+
+/**
+ * @tc.name  : Test AudioRouteCache Invalidate
+ * @tc.number: AudioRouteCache_004
+ * @tc.desc  : Test selecting and releasing an app selected renderer device invalidates the cached routes.
+ */
+HWTEST_F(AudioRouteCacheUnitTest, AudioRouteCache_004, TestSize.Level1)
+{
+    AudioAffinityManager &affinityManager = AudioAffinityManager::GetAudioAffinityManager();
+    sptr<AudioDeviceDescriptor> desc = GetTestDevice();
+    ASSERT_NE(nullptr, desc);
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    affinityManager.AddSelectRendererDevice(TEST_CLIENT_UID, desc);
+    EXPECT_TRUE(affinityManager.HasSelectRendererDevice(TEST_CLIENT_UID));
+    EXPECT_FALSE(IsTestRouteCached());
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    affinityManager.DelSelectRendererDevice(TEST_CLIENT_UID);
+    EXPECT_FALSE(affinityManager.HasSelectRendererDevice(TEST_CLIENT_UID));
+    EXPECT_FALSE(IsTestRouteCached());
+}
+
+/**
+ * @tc.name  : Test AudioRouteCache Invalidate
+ * @tc.number: AudioRouteCache_005
+ * @tc.desc  : Test only a session with a default output device invalidates the routes on set, start and stop.
+ */
+HWTEST_F(AudioRouteCacheUnitTest, AudioRouteCache_005, TestSize.Level1)
+{
+    AudioDeviceManager &deviceManager = AudioDeviceManager::GetAudioDeviceManager();
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    deviceManager.UpdateDefaultOutputDeviceWhenStarting(OTHER_SESSION_ID);
+    deviceManager.UpdateDefaultOutputDeviceWhenStopping(OTHER_SESSION_ID);
+    EXPECT_TRUE(IsTestRouteCached());
+
+    deviceManager.SetDefaultOutputDevice(DEVICE_TYPE_SPEAKER, TEST_SESSION_ID, STREAM_USAGE_VOICE_COMMUNICATION,
+        false);
+    EXPECT_FALSE(IsTestRouteCached());
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    deviceManager.UpdateDefaultOutputDeviceWhenStarting(TEST_SESSION_ID);
+    EXPECT_FALSE(IsTestRouteCached());
+
+    StoreTestRoute();
+    ASSERT_TRUE(IsTestRouteCached());
+    deviceManager.UpdateDefaultOutputDeviceWhenStopping(TEST_SESSION_ID);
+    EXPECT_FALSE(IsTestRouteCached());
+}
+} // namespace AudioStandard
+} // namespace OHOS
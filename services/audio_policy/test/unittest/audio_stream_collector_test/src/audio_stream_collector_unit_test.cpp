@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "audio_errors.h"
+#include "audio_stream_collector.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const int32_t TEST_UID_A = 20010041;
+const int32_t TEST_UID_B = 20010042;
+const int32_t TEST_SESSION_BASE = 100001;
+
+AudioStreamChangeInfo GetRendererInfo(int32_t uid, int32_t sessionId, StreamUsage usage, RendererState state)
+{
+    AudioStreamChangeInfo streamChangeInfo;
+    streamChangeInfo.audioRendererChangeInfo.clientUID = uid;
+    streamChangeInfo.audioRendererChangeInfo.createrUID = uid;
+    streamChangeInfo.audioRendererChangeInfo.sessionId = sessionId;
+    streamChangeInfo.audioRendererChangeInfo.rendererState = state;
+    streamChangeInfo.audioRendererChangeInfo.rendererInfo.streamUsage = usage;
+    return streamChangeInfo;
+}
+
+AudioStreamChangeInfo GetCapturerInfo(int32_t uid, int32_t sessionId, CapturerState state)
+{
+    AudioStreamChangeInfo streamChangeInfo;
+    streamChangeInfo.audioCapturerChangeInfo.clientUID = uid;
+    streamChangeInfo.audioCapturerChangeInfo.createrUID = uid;
+    streamChangeInfo.audioCapturerChangeInfo.sessionId = sessionId;
+    streamChangeInfo.audioCapturerChangeInfo.capturerState = state;
+    streamChangeInfo.audioCapturerChangeInfo.capturerInfo.sourceType = SOURCE_TYPE_MIC;
+    return streamChangeInfo;
+}
+
+// The tracker object is left out, the stream is added before the tracker is cast.
+void AddStream(AudioStreamCollector &collector, AudioMode mode, AudioStreamChangeInfo streamChangeInfo)
+{
+    collector.RegisterTracker(mode, streamChangeInfo, nullptr);
+}
+
+void UpdateStream(AudioStreamCollector &collector, AudioMode mode, AudioStreamChangeInfo streamChangeInfo)
+{
+    collector.UpdateTracker(mode, streamChangeInfo);
+}
+
+template <typename Key>
+size_t GetBucketSize(const std::unordered_map<Key, std::set<int32_t>> &index)
+{
+    size_t size = 0;
+    for (const auto &[key, sessions] : index) {
+        size += sessions.size();
+    }
+    return size;
+}
+
+template <typename Key>
+bool IsIndexed(const std::unordered_map<Key, std::set<int32_t>> &index, Key key, int32_t sessionId)
+{
+    auto iter = index.find(key);
+    return iter != index.end() && iter->second.count(sessionId) != 0;
+}
+
+// Every change info is indexed by its own session, uid and usage, and nothing else is.
+void ExpectIndexesConsistent(AudioStreamCollector &collector)
+{
+    std::lock_guard<std::mutex> lock(collector.streamsInfoMutex_);
+    ASSERT_EQ(collector.audioRendererChangeInfos_.size(), collector.rendererSessionIndex_.size());
+    EXPECT_EQ(collector.audioRendererChangeInfos_.size(), GetBucketSize(collector.rendererUsageIndex_));
+    EXPECT_EQ(collector.audioRendererChangeInfos_.size(), GetBucketSize(collector.rendererUidIndex_));
+    for (const auto &info : collector.audioRendererChangeInfos_) {
+        auto iter = collector.rendererSessionIndex_.find(info->sessionId);
+        ASSERT_NE(collector.rendererSessionIndex_.end(), iter);
+        EXPECT_EQ(info.get(), iter->second);
+        EXPECT_TRUE(IsIndexed(collector.rendererUidIndex_, info->clientUID, info->sessionId));
+        EXPECT_TRUE(IsIndexed(collector.rendererUsageIndex_, info->rendererInfo.streamUsage, info->sessionId));
+    }
+
+    ASSERT_EQ(collector.audioCapturerChangeInfos_.size(), collector.capturerSessionIndex_.size());
+    EXPECT_EQ(collector.audioCapturerChangeInfos_.size(), GetBucketSize(collector.capturerUidIndex_));
+    for (const auto &info : collector.audioCapturerChangeInfos_) {
+        auto iter = collector.capturerSessionIndex_.find(info->sessionId);
+        ASSERT_NE(collector.capturerSessionIndex_.end(), iter);
+        EXPECT_EQ(info.get(), iter->second);
+        EXPECT_TRUE(IsIndexed(collector.capturerUidIndex_, info->clientUID, info->sessionId));
+    }
+}
+} // namespace
+
+class AudioStreamCollectorUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void AudioStreamCollectorUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void AudioStreamCollectorUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void AudioStreamCollectorUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void AudioStreamCollectorUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test AudioStreamCollector indexes
+ * @tc.number: AudioStreamCollector_001
+ * @tc.desc  : Test the renderer indexes follow the stream list when streams are added, updated and released.
+ */
+HWTEST_F(AudioStreamCollectorUnitTest, AudioStreamCollector_001, TestSize.Level1)
+{
+    AudioStreamCollector collector;
+    AudioMode mode = AUDIO_MODE_PLAYBACK;
+    AddStream(collector, mode, GetRendererInfo(TEST_UID_A, TEST_SESSION_BASE, STREAM_USAGE_MUSIC, RENDERER_PREPARED));
+    AddStream(collector, mode, GetRendererInfo(TEST_UID_A, TEST_SESSION_BASE + 1, STREAM_USAGE_ALARM,
+        RENDERER_PREPARED));
+    AddStream(collector, mode, GetRendererInfo(TEST_UID_B, TEST_SESSION_BASE + 2, STREAM_USAGE_MUSIC,
+        RENDERER_PREPARED));
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(2, collector.GetAllRendererSessionIDForUID(TEST_UID_A).size());
+    EXPECT_EQ(TEST_UID_B, collector.GetUid(TEST_SESSION_BASE + 2));
+
+    // the usage changes with the state, the session moves to the new usage bucket
+    UpdateStream(collector, mode, GetRendererInfo(TEST_UID_A, TEST_SESSION_BASE, STREAM_USAGE_MOVIE,
+        RENDERER_RUNNING));
+    ExpectIndexesConsistent(collector);
+    EXPECT_FALSE(IsIndexed(collector.rendererUsageIndex_, STREAM_USAGE_MUSIC, TEST_SESSION_BASE));
+    EXPECT_TRUE(IsIndexed(collector.rendererUsageIndex_, STREAM_USAGE_MOVIE, TEST_SESSION_BASE));
+
+    // an update from another uid does not touch the stream
+    UpdateStream(collector, mode, GetRendererInfo(TEST_UID_B, TEST_SESSION_BASE + 1, STREAM_USAGE_MUSIC,
+        RENDERER_RUNNING));
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(TEST_UID_A, collector.GetUid(TEST_SESSION_BASE + 1));
+
+    UpdateStream(collector, mode, GetRendererInfo(TEST_UID_A, TEST_SESSION_BASE, STREAM_USAGE_MOVIE,
+        RENDERER_RELEASED));
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(2, collector.audioRendererChangeInfos_.size());
+    EXPECT_EQ(1, collector.GetAllRendererSessionIDForUID(TEST_UID_A).size());
+    EXPECT_EQ(-1, collector.GetUid(TEST_SESSION_BASE));
+}
+
+/**
+ * @tc.name  : Test AudioStreamCollector indexes
+ * @tc.number: AudioStreamCollector_002
+ * @tc.desc  : Test the capturer indexes follow the stream list when streams are added, updated and released.
+ */
+HWTEST_F(AudioStreamCollectorUnitTest, AudioStreamCollector_002, TestSize.Level1)
+{
+    AudioStreamCollector collector;
+    AudioMode mode = AUDIO_MODE_RECORD;
+    AddStream(collector, mode, GetCapturerInfo(TEST_UID_A, TEST_SESSION_BASE, CAPTURER_PREPARED));
+    AddStream(collector, mode, GetCapturerInfo(TEST_UID_B, TEST_SESSION_BASE + 1, CAPTURER_PREPARED));
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(1, collector.GetAllCapturerSessionIDForUID(TEST_UID_A).size());
+
+    UpdateStream(collector, mode, GetCapturerInfo(TEST_UID_A, TEST_SESSION_BASE, CAPTURER_RUNNING));
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(2, collector.audioCapturerChangeInfos_.size());
+
+    UpdateStream(collector, mode, GetCapturerInfo(TEST_UID_A, TEST_SESSION_BASE, CAPTURER_RELEASED));
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(1, collector.audioCapturerChangeInfos_.size());
+    EXPECT_TRUE(collector.GetAllCapturerSessionIDForUID(TEST_UID_A).empty());
+    EXPECT_EQ(1, collector.GetAllCapturerSessionIDForUID(TEST_UID_B).size());
+}
+
+/**
+ * @tc.name  : Test AudioStreamCollector indexes
+ * @tc.number: AudioStreamCollector_003
+ * @tc.desc  : Test the indexes drop all streams of a died client and keep the others.
+ */
+HWTEST_F(AudioStreamCollectorUnitTest, AudioStreamCollector_003, TestSize.Level1)
+{
+    AudioStreamCollector collector;
+    AddStream(collector, AUDIO_MODE_PLAYBACK, GetRendererInfo(TEST_UID_A, TEST_SESSION_BASE, STREAM_USAGE_MUSIC,
+        RENDERER_RUNNING));
+    AddStream(collector, AUDIO_MODE_PLAYBACK, GetRendererInfo(TEST_UID_A, TEST_SESSION_BASE + 1,
+        STREAM_USAGE_MUSIC, RENDERER_RUNNING));
+    AddStream(collector, AUDIO_MODE_PLAYBACK, GetRendererInfo(TEST_UID_B, TEST_SESSION_BASE + 2,
+        STREAM_USAGE_MUSIC, RENDERER_RUNNING));
+    AddStream(collector, AUDIO_MODE_RECORD, GetCapturerInfo(TEST_UID_A, TEST_SESSION_BASE + 3, CAPTURER_RUNNING));
+    AddStream(collector, AUDIO_MODE_RECORD, GetCapturerInfo(TEST_UID_B, TEST_SESSION_BASE + 4, CAPTURER_RUNNING));
+    ExpectIndexesConsistent(collector);
+
+    collector.RegisteredTrackerClientDied(TEST_UID_A);
+    ExpectIndexesConsistent(collector);
+    EXPECT_EQ(1, collector.audioRendererChangeInfos_.size());
+    EXPECT_EQ(1, collector.audioCapturerChangeInfos_.size());
+    EXPECT_TRUE(collector.GetAllRendererSessionIDForUID(TEST_UID_A).empty());
+    EXPECT_TRUE(collector.GetAllCapturerSessionIDForUID(TEST_UID_A).empty());
+    EXPECT_EQ(1, GetBucketSize(collector.rendererUsageIndex_));
+
+    std::shared_ptr<const std::vector<AudioRendererChangeInfo>> snapshot =
+        collector.GetRendererChangeInfosSnapshot();
+    ASSERT_NE(nullptr, snapshot);
+    ASSERT_EQ(1, snapshot->size());
+    EXPECT_EQ(TEST_SESSION_BASE + 2, (*snapshot)[0].sessionId);
+}
+} // namespace AudioStandard
+} // namespace OHOS
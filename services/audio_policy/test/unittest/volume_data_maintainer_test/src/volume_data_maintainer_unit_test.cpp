@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "audio_adapter_manager.h"
+#include "audio_errors.h"
+#include "audio_setting_provider.h"
+#include "volume_data_maintainer.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const int32_t TEST_VOLUME_LOW = 3;
+const int32_t TEST_VOLUME_HIGH = 9;
+}
+
+class VolumeDataMaintainerUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+    // makes every database write fail, the data share helper can not be created without the remote object
+    void BreakDataBase();
+    void RestoreDataBase();
+
+    VolumeDataMaintainer &maintainer_ = VolumeDataMaintainer::GetVolumeDataMaintainer();
+    sptr<IRemoteObject> remoteObj_ = nullptr;
+};
+
+void VolumeDataMaintainerUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void VolumeDataMaintainerUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void VolumeDataMaintainerUnitTest::SetUp(void)
+{
+    std::lock_guard<std::mutex> lock(maintainer_.pendingVolumeMutex_);
+    maintainer_.pendingVolumeMap_.clear();
+    maintainer_.volumeSaveStats_ = {};
+}
+
+void VolumeDataMaintainerUnitTest::TearDown(void)
+{
+    std::lock_guard<std::mutex> lock(maintainer_.pendingVolumeMutex_);
+    maintainer_.pendingVolumeMap_.clear();
+    maintainer_.volumeSaveStats_ = {};
+}
+
+void VolumeDataMaintainerUnitTest::BreakDataBase()
+{
+    AudioSettingProvider::GetInstance(AUDIO_POLICY_SERVICE_ID);
+    remoteObj_ = AudioSettingProvider::remoteObj_;
+    AudioSettingProvider::remoteObj_ = nullptr;
+}
+
+void VolumeDataMaintainerUnitTest::RestoreDataBase()
+{
+    AudioSettingProvider::remoteObj_ = remoteObj_;
+    remoteObj_ = nullptr;
+}
+
+/**
+ * @tc.name  : Test VolumeDataMaintainer SaveVolume
+ * @tc.number: VolumeDataMaintainer_001
+ * @tc.desc  : Test saves of the same key coalesce into the latest value, and other keys are kept apart.
+ */
+HWTEST_F(VolumeDataMaintainerUnitTest, VolumeDataMaintainer_001, TestSize.Level1)
+{
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_LOW));
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_HIGH));
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_RING, TEST_VOLUME_LOW));
+
+    VolumeSaveStats stats = maintainer_.GetVolumeSaveStats();
+    EXPECT_EQ(stats.savedCount, 3u);
+    EXPECT_EQ(stats.coalescedCount, 1u);
+    EXPECT_EQ(stats.pendingCount, 2u);
+
+    std::string musicKey = VolumeDataMaintainer::GetVolumeKeyForDataShare(DEVICE_TYPE_SPEAKER, STREAM_MUSIC);
+    ASSERT_NE(maintainer_.pendingVolumeMap_.find(musicKey), maintainer_.pendingVolumeMap_.end());
+    EXPECT_EQ(maintainer_.pendingVolumeMap_[musicKey], TEST_VOLUME_HIGH);
+}
+
+/**
+ * @tc.name  : Test VolumeDataMaintainer GetVolume
+ * @tc.number: VolumeDataMaintainer_002
+ * @tc.desc  : Test a pending volume is read before the database, even if the database can not be read.
+ */
+HWTEST_F(VolumeDataMaintainerUnitTest, VolumeDataMaintainer_002, TestSize.Level1)
+{
+    BreakDataBase();
+    EXPECT_FALSE(maintainer_.GetVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC));
+
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_HIGH));
+    EXPECT_TRUE(maintainer_.GetVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC));
+    EXPECT_EQ(maintainer_.GetStreamVolume(STREAM_MUSIC), TEST_VOLUME_HIGH);
+
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_LOW));
+    EXPECT_TRUE(maintainer_.GetVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC));
+    EXPECT_EQ(maintainer_.GetStreamVolume(STREAM_MUSIC), TEST_VOLUME_LOW);
+    RestoreDataBase();
+}
+
+/**
+ * @tc.name  : Test VolumeDataMaintainer FlushVolume
+ * @tc.number: VolumeDataMaintainer_003
+ * @tc.desc  : Test failed volumes stay pending for the retry, and a value saved meanwhile is not overwritten.
+ */
+HWTEST_F(VolumeDataMaintainerUnitTest, VolumeDataMaintainer_003, TestSize.Level1)
+{
+    EXPECT_TRUE(maintainer_.FlushVolume());
+
+    BreakDataBase();
+    EXPECT_EQ(AudioSettingProvider::GetInstance(AUDIO_POLICY_SERVICE_ID).PutIntValues({{"test_key", 1}}, "system"),
+        ERR_NO_INIT);
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_LOW));
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_RING, TEST_VOLUME_LOW));
+    EXPECT_FALSE(maintainer_.FlushVolume());
+
+    VolumeSaveStats stats = maintainer_.GetVolumeSaveStats();
+    EXPECT_EQ(stats.failedCount, 2u);
+    EXPECT_EQ(stats.flushedCount, 0u);
+    EXPECT_EQ(stats.pendingCount, 2u);
+    EXPECT_TRUE(maintainer_.GetVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC));
+    EXPECT_EQ(maintainer_.GetStreamVolume(STREAM_MUSIC), TEST_VOLUME_LOW);
+
+    // a newer value is saved while the flush fails
+    std::string musicKey = VolumeDataMaintainer::GetVolumeKeyForDataShare(DEVICE_TYPE_SPEAKER, STREAM_MUSIC);
+    std::vector<std::pair<std::string, int32_t>> values;
+    {
+        std::lock_guard<std::mutex> lock(maintainer_.pendingVolumeMutex_);
+        values.assign(maintainer_.pendingVolumeMap_.begin(), maintainer_.pendingVolumeMap_.end());
+        maintainer_.pendingVolumeMap_.clear();
+    }
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_HIGH));
+    {
+        std::lock_guard<std::mutex> lock(maintainer_.pendingVolumeMutex_);
+        maintainer_.pendingVolumeMap_.insert(values.begin(), values.end());
+    }
+    EXPECT_FALSE(maintainer_.FlushVolume());
+    EXPECT_EQ(maintainer_.pendingVolumeMap_[musicKey], TEST_VOLUME_HIGH);
+    EXPECT_EQ(maintainer_.GetVolumeSaveStats().pendingCount, 2u);
+    RestoreDataBase();
+}
+
+/**
+ * @tc.name  : Test AudioAdapterManager HandleFlushVolume
+ * @tc.number: VolumeDataMaintainer_004
+ * @tc.desc  : Test a failed flush schedules the next one, and a successful flush does not.
+ */
+HWTEST_F(VolumeDataMaintainerUnitTest, VolumeDataMaintainer_004, TestSize.Level1)
+{
+    AudioAdapterManager &adapterManager = static_cast<AudioAdapterManager &>(AudioAdapterManager::GetInstance());
+    std::shared_ptr<AudioAdapterManagerHandler> handler = adapterManager.handler_;
+    adapterManager.handler_ = std::make_shared<AudioAdapterManagerHandler>();
+
+    adapterManager.HandleFlushVolume();
+    EXPECT_FALSE(adapterManager.handler_->flushVolumeScheduled_.load());
+
+    BreakDataBase();
+    EXPECT_TRUE(maintainer_.SaveVolume(DEVICE_TYPE_SPEAKER, STREAM_MUSIC, TEST_VOLUME_LOW));
+    adapterManager.HandleFlushVolume();
+    EXPECT_TRUE(adapterManager.handler_->flushVolumeScheduled_.load());
+    EXPECT_EQ(maintainer_.GetVolumeSaveStats().pendingCount, 1u);
+
+    // the test volume is never written to the database
+    adapterManager.handler_->RemoveAllEvents();
+    adapterManager.handler_->ReleaseEventRunner();
+    adapterManager.handler_ = handler;
+    RestoreDataBase();
+}
+} // namespace AudioStandard
+} // namespace OHOS
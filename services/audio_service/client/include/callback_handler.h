@@ -31,7 +31,10 @@ public:
 class CallbackHandler {
 public:
     virtual ~CallbackHandler() = default;
-    static std::shared_ptr<CallbackHandler> GetInstance(std::shared_ptr<IHandler> iHandler);
+    // Handlers of a process share one event runner thread, events of each handler are still handled in order.
+    // Set isIndependent for a stream whose callbacks must not wait behind the callbacks of other streams.
+    static std::shared_ptr<CallbackHandler> GetInstance(std::shared_ptr<IHandler> iHandler,
+        bool isIndependent = false);
 
     virtual void SendCallbackEvent(uint32_t code, int64_t data) = 0;
 
@@ -99,6 +99,11 @@ public:
     int32_t Enqueue(const BufferDesc &bufDesc) override;
     int32_t Clear() override;
 
+    int32_t SetDirectWriteMode(bool enable) override;
+    int32_t GetDirectWriteBuffer(BufferDesc &bufDesc) override;
+    int32_t CommitDirectWriteBuffer(const BufferDesc &bufDesc) override;
+    int32_t WriteNonBlocking(uint8_t *buffer, size_t bufferSize) override;
+
     int32_t SetLowPowerVolume(float volume) override;
     float GetLowPowerVolume() override;
     int32_t SetOffloadMode(int32_t state, bool isAppBack) override;
@@ -209,6 +214,12 @@ private:
     int32_t DrainRingCache();
 
     int32_t WriteCacheData(bool isDrain = false);
+    int32_t WaitForWritableSpan(uint64_t &curWriteIndex, BufferDesc &desc);
+    int32_t PublishWrittenSpan(BufferDesc &desc, uint64_t curWriteIndex);
+    void SetSpanVolume(uint64_t curWriteIndex);
+    bool IsDirectWriteSupported() const;
+    size_t GetNonBlockingWritableSize();
+    void ExitStandByIfNeeded();
 
     void InitCallbackBuffer(uint64_t bufferDurationInUs);
     void WriteCallbackFunc();
@@ -323,9 +334,15 @@ private:
     std::shared_ptr<OHAudioBuffer> clientBuffer_ = nullptr;
 
     // buffer handle
-    std::unique_ptr<AudioRingCache> ringCache_ = nullptr;
+    std::unique_ptr<AudioSpscRingCache> ringCache_ = nullptr;
     std::mutex writeMutex_; // used for prevent multi thread call write
 
+    // direct write mode, the span handed to the app is guarded by writeMutex_
+    std::atomic<bool> directWriteMode_ = false;
+    bool directSpanAcquired_ = false;
+    uint64_t directSpanWriteIndex_ = 0;
+    BufferDesc directSpanDesc_ = {};
+
     // Mark reach and period reach callback
     int64_t totalBytesWritten_ = 0;
     std::mutex markReachMutex_;
@@ -18,6 +18,7 @@
 
 #include "audio_process_in_client.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cinttypes>
 #include <condition_variable>
@@ -140,6 +141,7 @@ private:
 
     void UpdateHandleInfo(bool isAysnc = true, bool resetReadWritePos = false);
     int64_t GetPredictNextHandleTime(uint64_t posInFrame, bool isIndependent = false);
+    int64_t GetWriteBeforeDuration();
     bool PrepareNext(uint64_t curHandPos, int64_t &wakeUpTime);
     bool ClientPrepareNextLoop(uint64_t curWritePos, int64_t &wakeUpTime);
     bool PrepareNextIndependent(uint64_t curWritePos, int64_t &wakeUpTime);
@@ -169,6 +171,7 @@ private:
     static constexpr int64_t MAX_WRITE_COST_DURATION_NANO = 5000000; // 5ms
     static constexpr int64_t MAX_READ_COST_DURATION_NANO = 5000000; // 5ms
     static constexpr int64_t WRITE_BEFORE_DURATION_NANO = 2000000; // 2ms
+    static constexpr int64_t MIN_WRITE_BEFORE_DURATION_NANO = 1000000; // 1ms
     static constexpr int64_t RECORD_RESYNC_SLEEP_NANO = 2000000; // 2ms
     static constexpr int64_t RECORD_HANDLE_DELAY_NANO = 3000000; // 3ms
     static constexpr size_t MAX_TIMES = 4; // 4 times spanSizeInFrame_
@@ -1212,6 +1215,17 @@ int64_t AudioProcessInClientInner::GetPredictNextHandleTime(uint64_t posInFrame,
     return nextHandleTime;
 }
 
+// The client wakes up before the server handle time by the time of one write, plus the prediction error of the
+// time model once it is trusted.
+int64_t AudioProcessInClientInner::GetWriteBeforeDuration()
+{
+    int64_t errorBound = handleTimeModel_.GetErrorBoundNano();
+    if (errorBound < 0) {
+        return WRITE_BEFORE_DURATION_NANO;
+    }
+    return std::min(MIN_WRITE_BEFORE_DURATION_NANO + errorBound, WRITE_BEFORE_DURATION_NANO);
+}
+
 bool AudioProcessInClientInner::PrepareNext(uint64_t curHandPos, int64_t &wakeUpTime)
 {
     Trace trace("AudioProcessInClient::PrepareNext " + std::to_string(curHandPos));
@@ -1219,7 +1233,7 @@ bool AudioProcessInClientInner::PrepareNext(uint64_t curHandPos, int64_t &wakeUp
     if (processConfig_.audioMode == AUDIO_MODE_RECORD) {
         handleModifyTime = RECORD_HANDLE_DELAY_NANO;
     } else {
-        handleModifyTime = -WRITE_BEFORE_DURATION_NANO;
+        handleModifyTime = -GetWriteBeforeDuration();
     }
 
     int64_t nextServerHandleTime = GetPredictNextHandleTime(curHandPos) + handleModifyTime;
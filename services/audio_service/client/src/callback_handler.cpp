@@ -17,6 +17,9 @@
 #endif
 
 #include "callback_handler.h"
+
+#include <mutex>
+
 #include "event_handler.h"
 #include "event_runner.h"
 #include "audio_service_log.h"
@@ -24,9 +27,27 @@
 namespace OHOS {
 namespace AudioStandard {
 using namespace std;
+namespace {
+const char *CALLBACK_RUNNER_NAME = "OS_AudioStateCB";
+
+// The runner lives as long as one handler holds it, its thread exits with the last stream of the process.
+shared_ptr<AppExecFwk::EventRunner> GetSharedEventRunner()
+{
+    static mutex runnerMutex;
+    static weak_ptr<AppExecFwk::EventRunner> sharedRunner;
+    lock_guard<mutex> lock(runnerMutex);
+    shared_ptr<AppExecFwk::EventRunner> runner = sharedRunner.lock();
+    if (runner == nullptr) {
+        runner = AppExecFwk::EventRunner::Create(CALLBACK_RUNNER_NAME);
+        sharedRunner = runner;
+    }
+    return runner;
+}
+}
+
 class CallbackHandlerInner : public CallbackHandler, public AppExecFwk::EventHandler {
 public:
-    explicit CallbackHandlerInner(std::shared_ptr<IHandler> iHandler);
+    CallbackHandlerInner(std::shared_ptr<IHandler> iHandler, std::shared_ptr<AppExecFwk::EventRunner> runner);
     ~CallbackHandlerInner();
 
     void SendCallbackEvent(uint32_t eventCode, int64_t data) override;
@@ -40,13 +61,16 @@ private:
     std::weak_ptr<IHandler> iHandler_;
 };
 
-std::shared_ptr<CallbackHandler> CallbackHandler::GetInstance(std::shared_ptr<IHandler> iHandler)
+std::shared_ptr<CallbackHandler> CallbackHandler::GetInstance(std::shared_ptr<IHandler> iHandler,
+    bool isIndependent)
 {
-    return std::make_shared<CallbackHandlerInner>(iHandler);
+    std::shared_ptr<AppExecFwk::EventRunner> runner = isIndependent ?
+        AppExecFwk::EventRunner::Create(CALLBACK_RUNNER_NAME) : GetSharedEventRunner();
+    return std::make_shared<CallbackHandlerInner>(iHandler, runner);
 }
 
-CallbackHandlerInner::CallbackHandlerInner(std::shared_ptr<IHandler> iHandler)
-    : AppExecFwk::EventHandler(AppExecFwk::EventRunner::Create("OS_AudioStateCB"))
+CallbackHandlerInner::CallbackHandlerInner(std::shared_ptr<IHandler> iHandler,
+    std::shared_ptr<AppExecFwk::EventRunner> runner) : AppExecFwk::EventHandler(runner)
 {
     iHandler_ = iHandler;
 }
@@ -48,6 +48,7 @@
 #include "ipc_stream_listener_impl.h"
 #include "ipc_stream_listener_stub.h"
 #include "callback_handler.h"
+#include "futex_tool.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -58,6 +59,7 @@ static const int32_t OPERATION_TIMEOUT_IN_MS = 1000; // 1000ms
 static const int32_t LOGLITMITTIMES = 20;
 const uint64_t AUDIO_US_PER_MS = 1000;
 const uint64_t AUDIO_US_PER_S = 1000000;
+const int64_t AUDIO_NS_PER_MS = 1000000;
 const uint64_t DEFAULT_BUF_DURATION_IN_USEC = 20000; // 20ms
 const uint64_t MAX_BUF_DURATION_IN_USEC = 2000000; // 2S
 const int64_t INVALID_FRAME_SIZE = -1;
@@ -200,6 +202,7 @@ public:
     void SendCapturerPeriodReachedEvent(int64_t capturerPeriodSize);
 
     void HandleCapturerPositionChanges(size_t bytesRead);
+    void WakeUpReader();
     void HandleStateChangeEvent(int64_t data);
     void HandleCapturerMarkReachedEvent(int64_t capturerMarkPosition);
     void HandleCapturerPeriodReachedEvent(int64_t capturerPeriodNumber);
@@ -298,10 +301,6 @@ private:
     Operation notifiedOperation_ = MAX_OPERATION_CODE;
     int64_t notifiedResult_ = 0;
 
-    // read data
-    std::mutex readDataMutex_;
-    std::condition_variable readDataCV_;
-
     uint32_t overflowCount_ = 0;
     // ipc stream related
     AudioProcessConfig clientConfig_;
@@ -380,15 +379,15 @@ int32_t CapturerInClientInner::OnOperationHandled(Operation operation, int64_t r
     // read/write operation may print many log, use debug.
     if (operation == UPDATE_STREAM) {
         AUDIO_DEBUG_LOG("OnOperationHandled() UPDATE_STREAM result:%{public}" PRId64".", result);
-        // notify write if blocked
-        readDataCV_.notify_all();
+        // server wakes the reader with the futex, this is kept for servers that still send it.
+        WakeUpReader();
         return SUCCESS;
     }
 
     if (operation == BUFFER_OVERFLOW) {
         AUDIO_WARNING_LOG("recv overflow %{public}d", overflowCount_);
         // in plan next: do more to reduce overflow
-        readDataCV_.notify_all();
+        WakeUpReader();
         return SUCCESS;
     }
 
@@ -405,6 +404,13 @@ int32_t CapturerInClientInner::OnOperationHandled(Operation operation, int64_t r
     return SUCCESS;
 }
 
+void CapturerInClientInner::WakeUpReader()
+{
+    if (clientBuffer_ != nullptr) {
+        FutexTool::FutexWake(clientBuffer_->GetFutex());
+    }
+}
+
 void CapturerInClientInner::SetClientID(int32_t clientPid, int32_t clientUid, uint32_t appTokenId, uint64_t fullTokenId)
 {
     AUDIO_INFO_LOG("PID:%{public}d UID:%{public}d.", clientPid, clientUid);
@@ -684,7 +690,9 @@ void CapturerInClientInner::SafeSendCallbackEvent(uint32_t eventCode, int64_t da
 void CapturerInClientInner::InitCallbackHandler()
 {
     if (callbackHandler_ == nullptr) {
-        callbackHandler_ = CallbackHandler::GetInstance(shared_from_this());
+        // voip streams keep their own callback thread
+        callbackHandler_ = CallbackHandler::GetInstance(shared_from_this(),
+            capturerInfo_.sourceType == SOURCE_TYPE_VOICE_COMMUNICATION);
     }
 }
 
@@ -1374,6 +1382,7 @@ bool CapturerInClientInner::PauseAudioStream(StateChangeCmdType cmdType)
 
     state_ = PAUSED;
     statusLock.unlock();
+    WakeUpReader();
 
     // waiting for review: use send event to clent with cmdType | call OnStateChange | call HiSysEventWrite
     int64_t param = -1;
@@ -1427,6 +1436,7 @@ bool CapturerInClientInner::StopAudioStream()
 
     state_ = STOPPED;
     statusLock.unlock();
+    WakeUpReader();
 
     SafeSendCallbackEvent(STATE_CHANGE_EVENT, state_);
 
@@ -1464,6 +1474,11 @@ bool CapturerInClientInner::ReleaseAudioStream(bool releaseRunner)
         }
     }
 
+    // wake up the blocked reader
+    if (clientBuffer_ != nullptr) {
+        FutexTool::FutexWake(clientBuffer_->GetFutex(), IS_PRE_EXIT);
+    }
+
     // clear write callback
     if (capturerMode_ == CAPTURE_MODE_CALLBACK) {
         cbThreadReleased_ = true; // stop loop
@@ -1471,7 +1486,6 @@ bool CapturerInClientInner::ReleaseAudioStream(bool releaseRunner)
             cbBufferQueue_.PushNoWait({nullptr, 0, 0});
         }
         cbThreadCv_.notify_all();
-        readDataCV_.notify_all();
         if (callbackLoop_.joinable()) {
             callbackLoop_.join();
         }
@@ -1609,14 +1623,12 @@ int32_t CapturerInClientInner::HandleCapturerRead(size_t &readSize, size_t &user
             if (!isBlockingRead) {
                 return readSize; // Return buffer immediately
             }
-            // wait for server read some data
-            std::unique_lock<std::mutex> readLock(readDataMutex_);
-            bool isTimeout = !readDataCV_.wait_for(readLock,
-                std::chrono::milliseconds(OPERATION_TIMEOUT_IN_MS), [this] {
-                    return clientBuffer_->GetCurWriteFrame() > clientBuffer_->GetCurReadFrame() || state_ != RUNNING;
-            });
+            // wait for server read some data, server wakes the futex after each span is written.
+            FutexCode futexRes = FutexTool::FutexWait(clientBuffer_->GetFutex(),
+                static_cast<int64_t>(OPERATION_TIMEOUT_IN_MS) * AUDIO_NS_PER_MS);
             CHECK_AND_RETURN_RET_LOG(state_ == RUNNING, ERR_ILLEGAL_STATE, "State is not running");
-            CHECK_AND_RETURN_RET_LOG(isTimeout == false, ERROR, "Wait timeout");
+            CHECK_AND_RETURN_RET_LOG(futexRes != FUTEX_TIMEOUT, ERROR, "Wait timeout");
+            CHECK_AND_RETURN_RET_LOG(futexRes != FUTEX_PRE_EXIT, ERR_ILLEGAL_STATE, "Wait pre exit");
         }
     }
     return readSize;
@@ -136,6 +136,30 @@ const std::string IAudioStream::GetEffectSceneName(const StreamUsage &streamUsag
     return supportedEffectConfig.postProcessNew.stream.back().scene;
 }
 
+int32_t IAudioStream::SetDirectWriteMode(bool enable)
+{
+    AUDIO_ERR_LOG("SetDirectWriteMode is not supported");
+    return ERR_NOT_SUPPORTED;
+}
+
+int32_t IAudioStream::GetDirectWriteBuffer(BufferDesc &bufDesc)
+{
+    AUDIO_ERR_LOG("GetDirectWriteBuffer is not supported");
+    return ERR_NOT_SUPPORTED;
+}
+
+int32_t IAudioStream::CommitDirectWriteBuffer(const BufferDesc &bufDesc)
+{
+    AUDIO_ERR_LOG("CommitDirectWriteBuffer is not supported");
+    return ERR_NOT_SUPPORTED;
+}
+
+int32_t IAudioStream::WriteNonBlocking(uint8_t *buffer, size_t bufferSize)
+{
+    AUDIO_ERR_LOG("WriteNonBlocking is not supported");
+    return ERR_NOT_SUPPORTED;
+}
+
 int32_t IAudioStream::GetByteSizePerFrame(const AudioStreamParams &params, size_t &result)
 {
     result = 0;
@@ -89,6 +89,7 @@ static constexpr int32_t ONE_MINUTE = 60;
 static const int32_t MEDIA_SERVICE_UID = 1013;
 const int32_t CONTINUE_DOWN_BARRIER = 5;
 const float DOWN_BARRIER_VOLUME = 0.31f;
+static constexpr int32_t VOLUME_SHIFT_NUMBER = 16; // 1 >> 16 = 65536, max volume
 } // namespace
 
 static AppExecFwk::BundleInfo gBundleInfo_;
@@ -429,7 +430,9 @@ void RendererInClientInner::SafeSendCallbackEvent(uint32_t eventCode, int64_t da
 void RendererInClientInner::InitCallbackHandler()
 {
     if (callbackHandler_ == nullptr) {
-        callbackHandler_ = CallbackHandler::GetInstance(shared_from_this());
+        // voip direct streams keep their own callback thread
+        callbackHandler_ = CallbackHandler::GetInstance(shared_from_this(),
+            rendererInfo_.rendererFlags == AUDIO_FLAG_VOIP_DIRECT);
     }
 }
 
@@ -438,6 +441,8 @@ int32_t RendererInClientInner::DeinitIpcStream()
 {
     Trace trace("RendererInClientInner::DeinitIpcStream");
     ipcStream_->Release();
+    // the spsc cache is only touched with writeMutex_ held, a write may still be running
+    std::lock_guard<std::mutex> lock(writeMutex_);
     ringCache_->ResetBuffer();
     return SUCCESS;
 }
@@ -512,7 +517,8 @@ int32_t RendererInClientInner::InitCacheBuffer(size_t targetSize)
     cacheSizeInByte_ = targetSize;
 
     if (ringCache_ == nullptr) {
-        ringCache_ = AudioRingCache::Create(cacheSizeInByte_);
+        // The cache is filled and drained by the write thread with writeMutex_ held, no need for another lock.
+        ringCache_ = AudioSpscRingCache::Create(cacheSizeInByte_);
     } else {
         OptResult result = ringCache_->ReConfig(cacheSizeInByte_, false); // false --> clear buffer
         if (result.ret != OPERATION_SUCCESS) {
@@ -1088,7 +1094,7 @@ int32_t RendererInClientInner::GetBufQueueState(BufferQueueState &bufState)
 
 int32_t RendererInClientInner::Enqueue(const BufferDesc &bufDesc)
 {
-    Trace trace("RendererInClientInner::Enqueue " + std::to_string(bufDesc.bufLength));
+    Trace trace = Trace::Format("RendererInClientInner::Enqueue %zu", bufDesc.bufLength);
     if (renderMode_ != RENDER_MODE_CALLBACK) {
         AUDIO_ERR_LOG("Enqueue is not supported. Render mode is not callback.");
         return ERR_INCORRECT_MODE;
@@ -1569,6 +1575,7 @@ int32_t RendererInClientInner::Write(uint8_t *pcmBuffer, size_t pcmBufferSize, u
 {
     CHECK_AND_RETURN_RET_LOG(renderMode_ != RENDER_MODE_CALLBACK, ERR_INCORRECT_MODE,
         "Write with callback is not supported");
+    CHECK_AND_RETURN_RET_LOG(!directWriteMode_, ERR_INCORRECT_MODE, "Write in direct write mode is not supported");
     int32_t ret = WriteInner(pcmBuffer, pcmBufferSize, metaBuffer, metaBufferSize);
     return ret <= 0 ? ret : static_cast<int32_t>(pcmBufferSize);
 }
@@ -1577,6 +1584,7 @@ int32_t RendererInClientInner::Write(uint8_t *buffer, size_t bufferSize)
 {
     CHECK_AND_RETURN_RET_LOG(renderMode_ != RENDER_MODE_CALLBACK, ERR_INCORRECT_MODE,
         "Write with callback is not supported");
+    CHECK_AND_RETURN_RET_LOG(!directWriteMode_, ERR_INCORRECT_MODE, "Write in direct write mode is not supported");
     return WriteInner(buffer, bufferSize);
 }
 
@@ -1611,7 +1619,7 @@ bool RendererInClientInner::ProcessSpeed(uint8_t *&buffer, size_t &bufferSize, b
 int32_t RendererInClientInner::WriteInner(uint8_t *pcmBuffer, size_t pcmBufferSize, uint8_t *metaBuffer,
     size_t metaBufferSize)
 {
-    Trace trace("RendererInClient::Write with meta " + std::to_string(pcmBufferSize));
+    Trace trace = Trace::Format("RendererInClient::Write with meta %zu", pcmBufferSize);
     CHECK_AND_RETURN_RET_LOG(curStreamParams_.encoding == ENCODING_AUDIOVIVID, ERR_NOT_SUPPORTED,
         "Write: Write not supported. encoding doesnot match.");
     BufferDesc bufDesc = {pcmBuffer, pcmBufferSize, pcmBufferSize, metaBuffer, metaBufferSize};
@@ -1688,7 +1696,7 @@ int32_t RendererInClientInner::WriteRingCache(uint8_t *buffer, size_t bufferSize
 int32_t RendererInClientInner::WriteInner(uint8_t *buffer, size_t bufferSize)
 {
     // eg: RendererInClient::sessionId:100001 WriteSize:3840
-    Trace trace(traceTag_+ " WriteSize:" + std::to_string(bufferSize));
+    Trace trace = Trace::Format("%s WriteSize:%zu", traceTag_.c_str(), bufferSize);
     CHECK_AND_RETURN_RET_LOG(buffer != nullptr && bufferSize < MAX_WRITE_SIZE && bufferSize > 0, ERR_INVALID_PARAM,
         "invalid size is %{public}zu", bufferSize);
     Trace::CountVolume(traceTag_, *buffer);
@@ -1698,12 +1706,8 @@ int32_t RendererInClientInner::WriteInner(uint8_t *buffer, size_t bufferSize)
         return ERR_INVALID_PARAM;
     }
     
-    if (clientBuffer_->GetStreamStatus()->load() == STREAM_STAND_BY) {
-        Trace trace2(traceTag_+ " call start to exit stand-by");
-        CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERROR, "ipcStream is not inited!");
-        int32_t ret = ipcStream_->Start();
-        AUDIO_INFO_LOG("%{public}u call start to exit stand-by ret %{public}u", sessionId_, ret);
-    }
+    CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERROR, "ipcStream is not inited!");
+    ExitStandByIfNeeded();
     std::lock_guard<std::mutex> lock(writeMutex_);
 
     size_t oriBufferSize = bufferSize;
@@ -1727,6 +1731,15 @@ int32_t RendererInClientInner::WriteInner(uint8_t *buffer, size_t bufferSize)
     return WriteRingCache(buffer, bufferSize, speedCached, oriBufferSize);
 }
 
+void RendererInClientInner::ExitStandByIfNeeded()
+{
+    if (clientBuffer_->GetStreamStatus()->load() == STREAM_STAND_BY) {
+        Trace trace(traceTag_+ " call start to exit stand-by");
+        int32_t ret = ipcStream_->Start();
+        AUDIO_INFO_LOG("%{public}u call start to exit stand-by ret %{public}u", sessionId_, ret);
+    }
+}
+
 void RendererInClientInner::ResetFramePosition()
 {
     Trace trace("RendererInClientInner::ResetFramePosition");
@@ -1776,6 +1789,18 @@ int32_t RendererInClientInner::WriteCacheData(bool isDrain)
     }
     size_t targetSize = isDrain ? std::min(result.size, clientSpanSizeInByte_) : clientSpanSizeInByte_;
 
+    BufferDesc desc = {};
+    uint64_t curWriteIndex = 0;
+    int32_t ret = WaitForWritableSpan(curWriteIndex, desc);
+    CHECK_AND_RETURN_RET(ret == SUCCESS, ret);
+    result = ringCache_->Dequeue({desc.buffer, targetSize});
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, ERROR, "ringCache Dequeue failed %{public}d", result.ret);
+
+    return PublishWrittenSpan(desc, curWriteIndex);
+}
+
+int32_t RendererInClientInner::WaitForWritableSpan(uint64_t &curWriteIndex, BufferDesc &desc)
+{
     int32_t sizeInFrame = clientBuffer_->GetAvailableDataFrames();
     CHECK_AND_RETURN_RET_LOG(sizeInFrame >= 0, ERROR, "GetAvailableDataFrames invalid, %{public}d", sizeInFrame);
 
@@ -1796,33 +1821,188 @@ int32_t RendererInClientInner::WriteCacheData(bool isDrain)
         AUDIO_ERR_LOG("failed: sizeInFrame is:%{public}d, futexRes:%{public}d", sizeInFrame, futexRes);
         return ERROR;
     }
-    BufferDesc desc = {};
-    uint64_t curWriteIndex = clientBuffer_->GetCurWriteFrame();
+    curWriteIndex = clientBuffer_->GetCurWriteFrame();
     int32_t ret = clientBuffer_->GetWriteBuffer(curWriteIndex, desc);
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERROR, "GetWriteBuffer failed %{public}d", ret);
-    result = ringCache_->Dequeue({desc.buffer, targetSize});
-    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, ERROR, "ringCache Dequeue failed %{public}d", result.ret);
+    return SUCCESS;
+}
 
+int32_t RendererInClientInner::PublishWrittenSpan(BufferDesc &desc, uint64_t curWriteIndex)
+{
     // volume process in client
-    if (volumeRamp_.IsActive()) {
-        // do not call SetVolume here.
-        clientVolume_ = volumeRamp_.GetRampVolume();
-        AUDIO_INFO_LOG("clientVolume_:%{public}f", clientVolume_);
-        Trace traceVolume("RendererInClientInner::WriteCacheData:Ramp:clientVolume_:" + std::to_string(clientVolume_));
-        CHECK_AND_RETURN_RET_LOG(clientBuffer_ != nullptr, ERR_OPERATION_FAILED, "buffer is not inited");
-        clientBuffer_->SetStreamVolume(clientVolume_);
-    }
+    SetSpanVolume(curWriteIndex);
 
     DumpFileUtil::WriteDumpFile(dumpOutFd_, static_cast<void *>(desc.buffer), desc.bufLength);
     DfxOperation(desc, clientConfig_.streamInfo.format, clientConfig_.streamInfo.channels);
     clientBuffer_->SetCurWriteFrame(curWriteIndex + spanSizeInFrame_);
 
-    CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERR_OPERATION_FAILED, "WriteCacheData failed, null ipcStream_.");
-    ipcStream_->UpdatePosition(); // notiify server update position
+    // The server pulls the data by curWriteFrame, the ipc is only needed while it asks for it, e.g. before the
+    // stream is filled or after drain.
+    if (clientBuffer_->IsPositionUpdateNeeded()) {
+        CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERR_OPERATION_FAILED, "WriteCacheData failed, null ipcStream_.");
+        ipcStream_->UpdatePosition(); // notiify server update position
+    }
     HandleRendererPositionChanges(desc.bufLength);
     return SUCCESS;
 }
 
+void RendererInClientInner::SetSpanVolume(uint64_t curWriteIndex)
+{
+    SpanInfo *spanInfo = clientBuffer_->GetSpanInfo(curWriteIndex);
+    CHECK_AND_RETURN_LOG(spanInfo != nullptr, "GetSpanInfo failed, curWriteIndex %{public}" PRIu64, curWriteIndex);
+    // unity means the span has no ramp, the server applies the stream volume to it
+    spanInfo->volumeStart = 1 << VOLUME_SHIFT_NUMBER;
+    spanInfo->volumeEnd = 1 << VOLUME_SHIFT_NUMBER;
+    float rampStart = 0.0f;
+    float rampEnd = 0.0f;
+    if (!volumeRamp_.IsActive() || !volumeRamp_.GetRampSpan(spanSizeInFrame_, rampStart, rampEnd)) {
+        return;
+    }
+    // do not call SetVolume here.
+    Trace traceVolume = Trace::Format("RendererInClientInner::WriteCacheData:Ramp:%f~%f", rampStart, rampEnd);
+    spanInfo->volumeStart = static_cast<int32_t>(rampStart * (1 << VOLUME_SHIFT_NUMBER));
+    spanInfo->volumeEnd = static_cast<int32_t>(rampEnd * (1 << VOLUME_SHIFT_NUMBER));
+    clientVolume_ = rampEnd;
+    if (!volumeRamp_.IsActive()) {
+        // spans after the ramp are played with the target volume
+        AUDIO_INFO_LOG("volume ramp done, clientVolume_:%{public}f", clientVolume_);
+        clientBuffer_->SetStreamVolume(clientVolume_);
+    }
+}
+
+bool RendererInClientInner::IsDirectWriteSupported() const
+{
+    return renderMode_ == RENDER_MODE_NORMAL && curStreamParams_.encoding != ENCODING_AUDIOVIVID && !isBlendSet_ &&
+        isEqual(speed_, 1.0f);
+}
+
+int32_t RendererInClientInner::SetDirectWriteMode(bool enable)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (!enable) {
+        directWriteMode_ = false;
+        directSpanAcquired_ = false;
+        return SUCCESS;
+    }
+    CHECK_AND_RETURN_RET_LOG(IsDirectWriteSupported(), ERR_NOT_SUPPORTED,
+        "Direct write is not supported with callback mode, audio vivid, speed or channel blend");
+    CHECK_AND_RETURN_RET_LOG(ringCache_ != nullptr, ERR_ILLEGAL_STATE, "ring cache is not inited");
+    OptResult result = ringCache_->GetReadableSize();
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS && result.size == 0, ERR_ILLEGAL_STATE,
+        "Data written before is not drained, size:%{public}zu", result.size);
+    directWriteMode_ = true;
+    return SUCCESS;
+}
+
+int32_t RendererInClientInner::GetDirectWriteBuffer(BufferDesc &bufDesc)
+{
+    Trace trace("RendererInClientInner::GetDirectWriteBuffer");
+    CHECK_AND_RETURN_RET_LOG(directWriteMode_, ERR_INCORRECT_MODE, "Direct write mode is not enabled");
+    CHECK_AND_RETURN_RET_LOG(IsDirectWriteSupported(), ERR_NOT_SUPPORTED, "Direct write is not supported any more");
+    CHECK_AND_RETURN_RET_LOG(gServerProxy_ != nullptr, ERROR, "server is died");
+    CHECK_AND_RETURN_RET_LOG(clientBuffer_ != nullptr && clientBuffer_->GetStreamStatus() != nullptr,
+        ERR_ILLEGAL_STATE, "buffer is not inited");
+    CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERROR, "ipcStream is not inited!");
+    ExitStandByIfNeeded();
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_PRELOG(state_ == RUNNING, ERR_ILLEGAL_STATE,
+        "GetDirectWriteBuffer: Illegal state:%{public}u sessionid: %{public}u", state_.load(), sessionId_);
+    // The span is handed out again until it is committed, unless the position is reset by flush.
+    if (directSpanAcquired_ && clientBuffer_->GetCurWriteFrame() == directSpanWriteIndex_) {
+        bufDesc = directSpanDesc_;
+        return SUCCESS;
+    }
+    directSpanAcquired_ = false;
+
+    BufferDesc desc = {};
+    uint64_t curWriteIndex = 0;
+    int32_t ret = WaitForWritableSpan(curWriteIndex, desc);
+    CHECK_AND_RETURN_RET(ret == SUCCESS, ret);
+    desc.dataLength = desc.bufLength;
+    directSpanDesc_ = desc;
+    directSpanWriteIndex_ = curWriteIndex;
+    directSpanAcquired_ = true;
+    bufDesc = desc;
+    return SUCCESS;
+}
+
+int32_t RendererInClientInner::CommitDirectWriteBuffer(const BufferDesc &bufDesc)
+{
+    Trace trace("RendererInClientInner::CommitDirectWriteBuffer");
+    CHECK_AND_RETURN_RET_LOG(directWriteMode_, ERR_INCORRECT_MODE, "Direct write mode is not enabled");
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_LOG(directSpanAcquired_, ERR_ILLEGAL_STATE, "No buffer is got by GetDirectWriteBuffer");
+    CHECK_AND_RETURN_RET_LOG(bufDesc.buffer == directSpanDesc_.buffer && bufDesc.dataLength > 0 &&
+        bufDesc.dataLength <= directSpanDesc_.bufLength, ERR_INVALID_PARAM, "Invalid buffer desc");
+    directSpanAcquired_ = false;
+    CHECK_AND_RETURN_RET_PRELOG(state_ == RUNNING, ERR_ILLEGAL_STATE,
+        "CommitDirectWriteBuffer: Illegal state:%{public}u sessionid: %{public}u", state_.load(), sessionId_);
+    CHECK_AND_RETURN_RET_LOG(clientBuffer_->GetCurWriteFrame() == directSpanWriteIndex_, ERR_ILLEGAL_STATE,
+        "Write position is reset, the buffer is dropped");
+
+    BufferDesc desc = directSpanDesc_;
+    if (bufDesc.dataLength < desc.bufLength) {
+        int32_t ret = memset_s(desc.buffer + bufDesc.dataLength, desc.bufLength - bufDesc.dataLength, 0,
+            desc.bufLength - bufDesc.dataLength);
+        CHECK_AND_RETURN_RET_LOG(ret == EOK, ERR_OPERATION_FAILED, "Fill silence failed, ret %{public}d.", ret);
+    }
+    Trace::CountVolume(traceTag_, *desc.buffer);
+    WriteMuteDataSysEvent(desc.buffer, bufDesc.dataLength);
+    FirstFrameProcess();
+
+    return PublishWrittenSpan(desc, directSpanWriteIndex_);
+}
+
+size_t RendererInClientInner::GetNonBlockingWritableSize()
+{
+    OptResult readable = ringCache_->GetReadableSize();
+    OptResult writable = ringCache_->GetWritableSize();
+    int32_t sizeInFrame = clientBuffer_->GetAvailableDataFrames();
+    if (readable.ret != OPERATION_SUCCESS || writable.ret != OPERATION_SUCCESS || sizeInFrame < 0 ||
+        spanSizeInFrame_ == 0) {
+        return 0;
+    }
+    // Each span moved from the ring cache needs a free span in the shared buffer, or WriteRingCache would wait.
+    size_t freeSpans = static_cast<uint32_t>(sizeInFrame) / spanSizeInFrame_;
+    size_t spanLimit = (freeSpans + 1) * clientSpanSizeInByte_ - 1;
+    if (spanLimit <= readable.size) {
+        return 0;
+    }
+    size_t writableSize = std::min(spanLimit - readable.size, writable.size + freeSpans * clientSpanSizeInByte_);
+    return writableSize - writableSize % sizePerFrameInByte_;
+}
+
+int32_t RendererInClientInner::WriteNonBlocking(uint8_t *buffer, size_t bufferSize)
+{
+    Trace trace = Trace::Format("%s WriteNonBlocking:%zu", traceTag_.c_str(), bufferSize);
+    CHECK_AND_RETURN_RET_LOG(renderMode_ != RENDER_MODE_CALLBACK, ERR_INCORRECT_MODE,
+        "Write with callback is not supported");
+    CHECK_AND_RETURN_RET_LOG(!directWriteMode_, ERR_INCORRECT_MODE, "Write in direct write mode is not supported");
+    CHECK_AND_RETURN_RET_LOG(IsDirectWriteSupported(), ERR_NOT_SUPPORTED,
+        "Non-blocking write is not supported with audio vivid, speed or channel blend");
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr && bufferSize < MAX_WRITE_SIZE && bufferSize > 0, ERR_INVALID_PARAM,
+        "invalid size is %{public}zu", bufferSize);
+    CHECK_AND_RETURN_RET_LOG(gServerProxy_ != nullptr, ERROR, "server is died");
+    CHECK_AND_RETURN_RET_LOG(clientBuffer_ != nullptr && clientBuffer_->GetStreamStatus() != nullptr &&
+        ringCache_ != nullptr, ERR_ILLEGAL_STATE, "buffer is not inited");
+    CHECK_AND_RETURN_RET_LOG(ipcStream_ != nullptr, ERROR, "ipcStream is not inited!");
+    ExitStandByIfNeeded();
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    CHECK_AND_RETURN_RET_PRELOG(state_ == RUNNING, ERR_ILLEGAL_STATE,
+        "WriteNonBlocking: Illegal state:%{public}u sessionid: %{public}u", state_.load(), sessionId_);
+    size_t writeSize = std::min(bufferSize, GetNonBlockingWritableSize());
+    if (writeSize < sizePerFrameInByte_) {
+        return 0;
+    }
+    Trace::CountVolume(traceTag_, *buffer);
+    WriteMuteDataSysEvent(buffer, writeSize);
+    FirstFrameProcess();
+    return WriteRingCache(buffer, writeSize, false, writeSize);
+}
+
 void RendererInClientInner::DfxOperation(BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel) const
 {
     ChannelVolumes vols = VolumeTools::CountVolumeLevel(buffer, format, channel);
@@ -2094,7 +2274,7 @@ int32_t RendererInClientInner::SetVolumeWithRamp(float volume, int32_t duration)
         return SUCCESS;
     }
 
-    volumeRamp_.SetVolumeRampConfig(volume, clientVolume_, duration);
+    volumeRamp_.SetVolumeRampConfig(volume, clientVolume_, duration, clientConfig_.streamInfo.samplingRate);
     return SUCCESS;
 }
 
@@ -2132,6 +2312,7 @@ void RendererInClientInner::GetStreamSwitchInfo(IAudioStream::SwitchInfo& info)
     info.clientUid = clientUid_;
     info.volume = clientVolume_;
     info.silentModeAndMixWithOthers = silentModeAndMixWithOthers_;
+    info.directWriteMode = directWriteMode_;
 
     info.frameMarkPosition = static_cast<uint64_t>(rendererMarkPosition_);
     info.renderPositionCb = rendererPositionCallback_;
@@ -90,6 +90,63 @@ private:
     size_t writeIndex_ = 0;
     size_t readIndex_ = 0;
 };
+// A range of the cache, the tail part is only used when the range wraps around the end of the cache.
+struct RingCacheView {
+    BufferWrap head;
+    BufferWrap tail;
+};
+
+/**
+ * Single producer single consumer ring cache with the same operations as AudioRingCache, plus in place views.
+ * The indexes only grow and the storage size is a power of two, so no lock and no rebase is needed. The storage is
+ * cacheSize rounded up to the next power of two, which costs up to twice cacheSize and at most MAX_CACHE_SIZE (16M),
+ * e.g. a 4 span cache of 3840 bytes takes 16k instead of 15k. Use it for small caches like the client write cache.
+ * Enqueue, GetWritableSize, GetWriteView and CommitWrite must be called by one thread, Dequeue, GetReadableSize,
+ * GetReadView and CommitRead by one thread, they may be the same thread. ReConfig and ResetBuffer must not run
+ * together with any other operation.
+*/
+class AudioSpscRingCache {
+public:
+    static std::unique_ptr<AudioSpscRingCache> Create(size_t cacheSize);
+    AudioSpscRingCache(size_t cacheSize);
+    ~AudioSpscRingCache();
+
+    OptResult ReConfig(size_t cacheSize, bool copyRemained = true);
+
+    // This operation will reset inner read/write index, the data is dropped.
+    void ResetBuffer();
+
+    size_t GetCahceSize();
+
+    OptResult GetWritableSize();
+    OptResult GetReadableSize();
+    OptResult Enqueue(const BufferWrap &buffer);
+    OptResult Dequeue(const BufferWrap &buffer);
+
+    // Get all writable space in place, fill it and call CommitWrite with the size filled.
+    OptResult GetWriteView(RingCacheView &view);
+    OptResult CommitWrite(size_t size);
+
+    // Get all readable data in place, consume it and call CommitRead with the size consumed.
+    OptResult GetReadView(RingCacheView &view);
+    OptResult CommitRead(size_t size);
+
+private:
+    bool Init();
+    RingCacheView GetView(uint64_t index, size_t size) const;
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<uint8_t[]> cacheBuffer_;
+    size_t cacheSize_ = 0; // the size user can use, not larger than the storage size
+    size_t storageSize_ = 0; // power of two
+    size_t indexMask_ = 0;
+
+    // The producer only writes writeIndex_ and the consumer only writes readIndex_, keep them in two cache lines.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> writeIndex_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> readIndex_ = 0;
+};
 } // namespace AudioStandard
 } // namespace OHOS
 #endif // AUDIO_RING_CACHE_H
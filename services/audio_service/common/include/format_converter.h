@@ -21,10 +21,66 @@
 
 namespace OHOS {
 namespace AudioStandard {
+// Planar buffers keep the channels one after another, each channel takes the samples of all frames.
+struct FormatConvertConfig {
+    AudioSampleFormat srcFormat = SAMPLE_S16LE;
+    AudioSampleFormat dstFormat = SAMPLE_S16LE;
+    uint32_t srcChannels = STEREO;
+    uint32_t dstChannels = STEREO;
+    bool isSrcPlanar = false;
+    bool isDstPlanar = false;
+    // AudioChannelLayout of the channels, the default layout of the channel count is used if it is unknown.
+    uint64_t srcChannelLayout = CH_LAYOUT_UNKNOWN;
+    uint64_t dstChannelLayout = CH_LAYOUT_UNKNOWN;
+};
+
+using ToFloatFunc = void (*)(const uint8_t *src, float *dst, size_t count, float gain);
+using FromFloatFunc = void (*)(const float *src, uint8_t *dst, size_t count);
+
 class FormatConverter {
 public:
     static int32_t S16MonoToS16Stereo(const BufferDesc &srcDesc, const BufferDesc &dstDesc);
     static int32_t S16StereoToS16Mono(const BufferDesc &srcDesc, const BufferDesc &dstDesc);
+
+    // U8, S16LE, S24LE, S32LE and F32LE with 1 to 16 channels are supported.
+    static bool IsFormatSupported(AudioSampleFormat format);
+    static size_t GetSampleSize(AudioSampleFormat format);
+
+    // Name of the kernel selected at runtime: "neon", "avx2" or "scalar".
+    static const char *GetKernelName();
+
+    // Converts count samples to float in [-1.0, 1.0] with the gain applied in the same pass, and back with clamping.
+    static int32_t ToFloat(AudioSampleFormat format, const uint8_t *src, float *dst, size_t count, float gain = 1.0f);
+    static int32_t FromFloat(AudioSampleFormat format, const float *src, uint8_t *dst, size_t count);
+
+    // Selects the kernels for one stream configuration, call it again only if the configuration changes.
+    int32_t Init(const FormatConvertConfig &config);
+
+    // Converts all frames of srcDesc.bufLength into dstDesc, dstDesc must be large enough for them. Channels are
+    // duplicated from mono, or else mixed by speaker position: a channel missing in the destination goes to its
+    // front side at -3dB, a center channel to both front sides at -3dB, LFE is dropped, and each destination
+    // channel is normalized so the mix can not clip. New channels of an up mix keep silent.
+    int32_t Process(const BufferDesc &srcDesc, const BufferDesc &dstDesc, float gain = 1.0f) const;
+
+private:
+    enum ConvertMode : int32_t {
+        CONVERT_COPY = 0, // same format and layout, a copy if no gain
+        CONVERT_SAMPLES, // same channels and layout, sample by sample
+        CONVERT_FRAMES, // channels or layout changed, frame by frame through the float block
+    };
+
+    int32_t ProcessSamples(const uint8_t *src, uint8_t *dst, size_t sampleCount, float gain) const;
+    void ProcessFrames(const uint8_t *src, uint8_t *dst, size_t frameCount, float gain) const;
+    void BuildMixMatrix();
+    void MapChannels(const float *src, float *dst, size_t frameCount) const;
+
+    FormatConvertConfig config_;
+    ConvertMode mode_ = CONVERT_COPY;
+    ToFloatFunc toFloat_ = nullptr;
+    FromFloatFunc fromFloat_ = nullptr;
+    size_t srcFrameSize_ = 0;
+    size_t dstFrameSize_ = 0;
+    float mixMatrix_[CHANNEL_16][CHANNEL_16] = {}; // [dst channel][src channel]
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FORMAT_CONVERTER_C_H
+#define FORMAT_CONVERTER_C_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// format should be same with AudioStandard::AudioSampleFormat in audio_stream_info.h, count is in samples.
+int32_t ConvertToFloatC(uint32_t format, size_t count, const void *src, float *dst);
+int32_t ConvertFromFloatC(uint32_t format, size_t count, const float *src, void *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORMAT_CONVERTER_C_H
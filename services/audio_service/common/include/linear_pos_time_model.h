@@ -20,6 +20,8 @@
 
 namespace OHOS {
 namespace AudioStandard {
+// Maps frame positions to time. Each UpdataFrameStamp feeds a second order loop that tracks the real frame rate
+// and phase of the device clock, so predictions do not slide when the clock drifts from the nominal rate.
 class LinearPosTimeModel {
 public:
     LinearPosTimeModel();
@@ -36,18 +38,32 @@ public:
 
     int64_t GetTimeOfPos(uint64_t posInFrame);
 
+    // Returns the bound of the prediction error in nanoseconds (three sigma of the recent errors), or -1 before
+    // enough stamps are seen to trust the model.
+    int64_t GetErrorBoundNano();
+
+    double GetDriftPpm();
+
     virtual ~LinearPosTimeModel() = default;
 private:
     bool IsReasonable(uint64_t frame, int64_t nanoTime);
+    int64_t GetDeltaTime(int64_t deltaFrame);
+    void TrackStamp(uint64_t frame, int64_t nanoTime);
 
 private:
     bool isConfiged = false;
     int32_t sampleRate_ = 0;
-    int64_t nanoTimePerFrame_ = 0;
+    double nominalNanoTimePerFrame_ = 0;
+    // estimated by the loop
+    double nanoTimePerFrame_ = 0;
     uint64_t spanCountInFrame_ = 0;
 
     uint64_t stampFrame_ = 0;
     int64_t stampNanoTime_ = 0;
+
+    // for the confidence of the model
+    double errorVariance_ = 0;
+    uint32_t trackedCount_ = 0;
 };
 } // namespace AudioStandard
 } // namespace OHOS
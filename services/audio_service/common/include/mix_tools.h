@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MIX_TOOLS_H
+#define MIX_TOOLS_H
+
+#include <array>
+#include <vector>
+
+#include "audio_info.h"
+#include "format_converter.h"
+
+namespace OHOS {
+namespace AudioStandard {
+// Initialized converters of the sources that are mixed through the FormatConverter, keyed by their config. Keep it
+// with the mix buffer, a converter is set up on the first span of a source config and reused by the next ones.
+class MixConverters {
+public:
+    // Returns nullptr if the config is not supported. Once all slots are used the oldest one is replaced.
+    const FormatConverter *Get(const FormatConvertConfig &config);
+
+private:
+    static constexpr size_t MAX_CONVERTERS = 8;
+    struct Entry {
+        FormatConvertConfig config;
+        FormatConverter converter;
+    };
+
+    std::array<Entry, MAX_CONVERTERS> entries_;
+    size_t count_ = 0;
+    size_t next_ = 0;
+};
+
+class MixTools {
+public:
+    // S16LE, S24LE, S32LE and F32LE with 1 to 16 channels are supported, both for source and destination.
+    static bool IsFormatSupported(AudioSampleFormat format);
+    static bool IsStreamInfoSupported(const AudioStreamInfo &streamInfo);
+
+    // Name of the kernel selected at runtime: "neon", "avx2", "sse2" or "scalar".
+    static const char *GetKernelName();
+
+    // Mix all source spans into dstData.bufferDesc. Each source must hold the same number of frames as the
+    // destination, sources with a different channel count are mapped by the FormatConverter mix matrix.
+    // The gain of each source ramps linearly from volumeStart to volumeEnd (1 << 16 is unity) over the span.
+    // mixBuffer is the float accumulator, size it to one destination span when the stream is configured, it is
+    // never resized here as Mix runs on the real time thread. converters keeps the converted sources set up between
+    // calls, use one per mix buffer.
+    static int32_t Mix(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData,
+        std::vector<float> &mixBuffer, MixConverters &converters);
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // MIX_TOOLS_H
@@ -81,6 +81,9 @@ struct BasicBufferInfo {
     std::atomic<float> streamVolume;
     std::atomic<float> duckFactor;
     std::atomic<float> muteFactor;
+
+    // Set by the server when a write must be notified with an ipc call, otherwise the client only moves curWriteFrame.
+    std::atomic<bool> needPositionUpdate;
 };
 
 enum SpanStatus : uint32_t {
@@ -149,6 +152,9 @@ public:
     float GetMuteFactor();
     bool SetMuteFactor(float muteFactor);
 
+    bool IsPositionUpdateNeeded();
+    void SetPositionUpdateNeeded(bool needed);
+
     int32_t GetAvailableDataFrames();
 
     int32_t ResetCurReadWritePos(uint64_t readFrame, uint64_t writeFrame);
@@ -15,6 +15,8 @@
 
 #ifndef VOLUME_TOOLS_H
 #define VOLUME_TOOLS_H
+#include <functional>
+
 #include "audio_info.h"
 
 namespace OHOS {
@@ -51,6 +53,14 @@ public:
 
     // will count volume for each channel, vol sum will be kept in volStart
     static ChannelVolumes CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel);
+
+    // Same as CountVolumeLevel, and calls preprocess on each block of whole frames right before the block is
+    // counted, len is in bytes. Fails without calling preprocess if the buffer can not be counted.
+    static int32_t CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel,
+        const std::function<void(uint8_t *block, size_t len)> &preprocess, ChannelVolumes &volLevel);
+
+    // Name of the kernel selected at runtime: "neon", "avx2" or "scalar".
+    static const char *GetKernelName();
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -13,7 +13,7 @@
  * limitations under the License.
  */
 #include "audio_common_converter.h"
-#include <cmath>
+#include "format_converter.h"
 
 namespace OHOS {
 namespace AudioStandard {
@@ -130,37 +130,33 @@ void AudioCommonConverter::ConvertBufferTo16Bit(const uint8_t *buffer, int32_t f
     }
 }
 
+// samplePerFrame is the byte size of one sample here.
+static AudioSampleFormat GetFormatOfSampleSize(uint32_t samplePerFrame)
+{
+    switch (samplePerFrame) {
+        case sizeof(uint8_t):
+            return SAMPLE_U8;
+        case sizeof(int16_t):
+            return SAMPLE_S16LE;
+        case AUDIO_24BIT_LENGTH:
+            return SAMPLE_S24LE;
+        default:
+            return SAMPLE_S32LE;
+    }
+}
+
 void AudioCommonConverter::ConvertBufferToFloat(const uint8_t *buffer, uint32_t samplePerFrame,
                                                 std::vector<float> &floatBuffer, float volume)
 {
-    uint32_t convertValue = samplePerFrame * BYTES_ALIGNMENT_SIZE - 1;
-    for (uint32_t i = 0; i < floatBuffer.size(); i++) {
-        int32_t sampleValue = 0;
-        if (samplePerFrame == AUDIO_24BIT_LENGTH) {
-            sampleValue = ((buffer[i * samplePerFrame + AUDIO_NUMBER_2] & 0xff) << AUDIO_SAMPLE_24BIT_LENGTH) |
-                          ((buffer[i * samplePerFrame + 1] & 0xff) << AUDIO_SAMPLE_16BIT_LENGTH) |
-                          ((buffer[i * samplePerFrame] & 0xff) << BYTES_ALIGNMENT_SIZE);
-            floatBuffer[i] = sampleValue * volume * (1.0f / AUDIO_SAMPLE_32BIT_VALUE);
-            continue;
-        }
-        for (uint32_t j = 0; j < samplePerFrame; j++) {
-            sampleValue |= (buffer[i * samplePerFrame + j] & 0xff) << (j * BYTES_ALIGNMENT_SIZE);
-        }
-        floatBuffer[i] = sampleValue * volume * (1.0f / (1U << convertValue));
-    }
+    FormatConverter::ToFloat(GetFormatOfSampleSize(samplePerFrame), buffer, floatBuffer.data(), floatBuffer.size(),
+        volume);
 }
 
 void AudioCommonConverter::ConvertFloatToAudioBuffer(const std::vector<float> &floatBuffer, uint8_t *buffer,
                                                      uint32_t samplePerFrame)
 {
-    uint32_t convertValue = samplePerFrame * BYTES_ALIGNMENT_SIZE - 1;
-    for (uint32_t i = 0; i < floatBuffer.size(); i++) {
-        int32_t sampleValue = static_cast<int32_t>(floatBuffer[i] * std::pow(AUDIO_NUMBER_2, convertValue));
-        for (uint32_t j = 0; j < samplePerFrame; j++) {
-            uint8_t tempValue = (sampleValue >> (BYTES_ALIGNMENT_SIZE * j)) & 0xff;
-            buffer[samplePerFrame * i + j] = tempValue;
-        }
-    }
+    FormatConverter::FromFloat(GetFormatOfSampleSize(samplePerFrame), floatBuffer.data(), buffer,
+        floatBuffer.size());
 }
 } // namespace AudioStandard
 } // namespace OHOS
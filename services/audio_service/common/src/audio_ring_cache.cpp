@@ -17,6 +17,10 @@
 #endif
 
 #include "audio_ring_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+
 #include "audio_service_log.h"
 
 #include "securec.h"
@@ -26,6 +30,15 @@ namespace AudioStandard {
 namespace {
 static const size_t MAX_CACHE_SIZE = 16 * 1024 * 1024; // 16M
 static const size_t BASE_INDEX_FENCE = SIZE_MAX - 2 * MAX_CACHE_SIZE;
+
+size_t RoundUpToPowerOfTwo(size_t size)
+{
+    size_t result = 1;
+    while (result < size) {
+        result <<= 1;
+    }
+    return result;
+}
 }
 AudioRingCache::AudioRingCache(size_t cacheSize) : cacheTotalSize_(cacheSize)
 {
@@ -322,5 +335,209 @@ OptResult AudioRingCache::Dequeue(const BufferWrap &buffer)
     result = {OPERATION_SUCCESS, buffer.dataSize};
     return result;
 }
+
+std::unique_ptr<AudioSpscRingCache> AudioSpscRingCache::Create(size_t cacheSize)
+{
+    if (cacheSize > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("Create failed: size too large:%{public}zu", cacheSize);
+        return nullptr;
+    }
+    std::unique_ptr<AudioSpscRingCache> ringCache = std::make_unique<AudioSpscRingCache>(cacheSize);
+    if (ringCache->Init() != true) {
+        AUDIO_ERR_LOG("Create failed: Init failed");
+        return nullptr;
+    }
+    return ringCache;
+}
+
+AudioSpscRingCache::AudioSpscRingCache(size_t cacheSize) : cacheSize_(cacheSize)
+{
+    AUDIO_INFO_LOG("AudioSpscRingCache() with cacheSize:%{public}zu", cacheSize);
+}
+
+AudioSpscRingCache::~AudioSpscRingCache()
+{
+    AUDIO_DEBUG_LOG("~AudioSpscRingCache()");
+}
+
+bool AudioSpscRingCache::Init()
+{
+    if (cacheSize_ > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("Init failed: size too large:%{public}zu", cacheSize_);
+        return false;
+    }
+    storageSize_ = RoundUpToPowerOfTwo(cacheSize_);
+    indexMask_ = storageSize_ - 1;
+    writeIndex_.store(0);
+    readIndex_.store(0);
+    // value initialized, no need to clear
+    cacheBuffer_ = std::make_unique<uint8_t[]>(storageSize_);
+    if (cacheBuffer_ == nullptr) {
+        AUDIO_ERR_LOG("Init failed, get memory failed size is:%{public}zu", storageSize_);
+        return false;
+    }
+    return true;
+}
+
+OptResult AudioSpscRingCache::ReConfig(size_t cacheSize, bool copyRemained)
+{
+    AUDIO_INFO_LOG("ReConfig with cacheSize:%{public}zu", cacheSize);
+    if (cacheSize > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("ReConfig failed: size too large:%{public}zu", cacheSize);
+        return {INDEX_OUT_OF_RANGE, cacheSize};
+    }
+    if (!copyRemained) {
+        cacheSize_ = cacheSize;
+        return Init() ? OptResult {OPERATION_SUCCESS, cacheSize} : OptResult {OPERATION_FAILED, cacheSize};
+    }
+    OptResult result = GetReadableSize();
+    if (result.ret != OPERATION_SUCCESS || result.size > cacheSize) {
+        AUDIO_ERR_LOG("ReConfig in copyRemained failed ret:%{public}d size :%{public}zu", result.ret, cacheSize);
+        return {result.ret == OPERATION_SUCCESS ? INVALID_OPERATION : result.ret, result.size};
+    }
+    size_t remained = result.size;
+    std::unique_ptr<uint8_t[]> temp = std::make_unique<uint8_t[]>(remained);
+    result = Dequeue({temp.get(), remained});
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result,
+        "ReConfig dequeue failed ret:%{public}d", result.ret);
+    cacheSize_ = cacheSize;
+    if (!Init()) {
+        return {OPERATION_FAILED, cacheSize};
+    }
+    if (remained == 0) {
+        return {OPERATION_SUCCESS, 0};
+    }
+    return Enqueue({temp.get(), remained});
+}
+
+void AudioSpscRingCache::ResetBuffer()
+{
+    writeIndex_.store(0);
+    readIndex_.store(0);
+}
+
+size_t AudioSpscRingCache::GetCahceSize()
+{
+    return cacheSize_;
+}
+
+RingCacheView AudioSpscRingCache::GetView(uint64_t index, size_t size) const
+{
+    size_t offset = static_cast<size_t>(index & indexMask_);
+    size_t headSize = std::min(size, storageSize_ - offset);
+    return {{cacheBuffer_.get() + offset, headSize}, {cacheBuffer_.get(), size - headSize}};
+}
+
+// Called by the producer, writeIndex_ is only changed by itself.
+OptResult AudioSpscRingCache::GetWritableSize()
+{
+    uint64_t writeIndex = writeIndex_.load(std::memory_order_relaxed);
+    uint64_t readIndex = readIndex_.load(std::memory_order_acquire);
+    if (writeIndex < readIndex || writeIndex - readIndex > cacheSize_) {
+        AUDIO_ERR_LOG("GetWritableSize failed: writeIndex_[%{public}" PRIu64"] readIndex_[%{public}" PRIu64"]",
+            writeIndex, readIndex);
+        return {INVALID_STATUS, 0};
+    }
+    return {OPERATION_SUCCESS, cacheSize_ - static_cast<size_t>(writeIndex - readIndex)};
+}
+
+// Called by the consumer, readIndex_ is only changed by itself.
+OptResult AudioSpscRingCache::GetReadableSize()
+{
+    uint64_t readIndex = readIndex_.load(std::memory_order_relaxed);
+    uint64_t writeIndex = writeIndex_.load(std::memory_order_acquire);
+    if (writeIndex < readIndex || writeIndex - readIndex > cacheSize_) {
+        AUDIO_ERR_LOG("GetReadableSize failed: writeIndex_[%{public}" PRIu64"] readIndex_[%{public}" PRIu64"]",
+            writeIndex, readIndex);
+        return {INVALID_STATUS, 0};
+    }
+    return {OPERATION_SUCCESS, static_cast<size_t>(writeIndex - readIndex)};
+}
+
+OptResult AudioSpscRingCache::Enqueue(const BufferWrap &buffer)
+{
+    if (buffer.dataPtr == nullptr || buffer.dataSize > MAX_CACHE_SIZE || buffer.dataSize == 0) {
+        AUDIO_ERR_LOG("Enqueue failed: BufferWrap is null or size %{public}zu is too large", buffer.dataSize);
+        return {INVALID_PARAMS, 0};
+    }
+    RingCacheView view;
+    OptResult result = GetWriteView(view);
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "Enqueue failed to get writeable size.");
+    if (buffer.dataSize > result.size) {
+        AUDIO_WARNING_LOG("Enqueue find buffer not enough, writableSize:%{public}zu , enqueue size:%{public}zu",
+            result.size, buffer.dataSize);
+        return {INDEX_OUT_OF_RANGE, result.size};
+    }
+    size_t headSize = std::min(buffer.dataSize, view.head.dataSize);
+    if (memcpy_s(view.head.dataPtr, view.head.dataSize, buffer.dataPtr, headSize) != EOK ||
+        (buffer.dataSize > headSize &&
+        memcpy_s(view.tail.dataPtr, view.tail.dataSize, buffer.dataPtr + headSize, buffer.dataSize - headSize) != EOK)) {
+        AUDIO_ERR_LOG("Enqueue memcpy_s failed, size:%{public}zu", buffer.dataSize);
+        return {OPERATION_FAILED, result.size};
+    }
+    writeIndex_.store(writeIndex_.load(std::memory_order_relaxed) + buffer.dataSize, std::memory_order_release);
+    return {OPERATION_SUCCESS, buffer.dataSize};
+}
+
+OptResult AudioSpscRingCache::Dequeue(const BufferWrap &buffer)
+{
+    if (buffer.dataPtr == nullptr || buffer.dataSize > MAX_CACHE_SIZE) {
+        AUDIO_ERR_LOG("Dequeue failed: BufferWrap is null or size %{public}zu is too large", buffer.dataSize);
+        return {INVALID_PARAMS, 0};
+    }
+    RingCacheView view;
+    OptResult result = GetReadView(view);
+    CHECK_AND_RETURN_RET_LOG(result.ret == OPERATION_SUCCESS, result, "Dequeue failed to get readable size.");
+    if (buffer.dataSize > result.size) {
+        AUDIO_WARNING_LOG("Dequeue find buffer not enough, readableSize:%{public}zu , Dequeue size:%{public}zu",
+            result.size, buffer.dataSize);
+        return {INVALID_OPERATION, result.size};
+    }
+    size_t headSize = std::min(buffer.dataSize, view.head.dataSize);
+    if (memcpy_s(buffer.dataPtr, buffer.dataSize, view.head.dataPtr, headSize) != EOK ||
+        (buffer.dataSize > headSize && memcpy_s(buffer.dataPtr + headSize, buffer.dataSize - headSize,
+        view.tail.dataPtr, buffer.dataSize - headSize) != EOK)) {
+        AUDIO_ERR_LOG("Dequeue memcpy_s failed, size:%{public}zu", buffer.dataSize);
+        return {OPERATION_FAILED, result.size};
+    }
+    readIndex_.store(readIndex_.load(std::memory_order_relaxed) + buffer.dataSize, std::memory_order_release);
+    return {OPERATION_SUCCESS, buffer.dataSize};
+}
+
+OptResult AudioSpscRingCache::GetWriteView(RingCacheView &view)
+{
+    OptResult result = GetWritableSize();
+    CHECK_AND_RETURN_RET(result.ret == OPERATION_SUCCESS, result);
+    view = GetView(writeIndex_.load(std::memory_order_relaxed), result.size);
+    return result;
+}
+
+OptResult AudioSpscRingCache::CommitWrite(size_t size)
+{
+    OptResult result = GetWritableSize();
+    CHECK_AND_RETURN_RET(result.ret == OPERATION_SUCCESS, result);
+    CHECK_AND_RETURN_RET_LOG(size <= result.size, OptResult({INDEX_OUT_OF_RANGE, result.size}),
+        "CommitWrite size %{public}zu is larger than writable size %{public}zu", size, result.size);
+    writeIndex_.store(writeIndex_.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    return {OPERATION_SUCCESS, size};
+}
+
+OptResult AudioSpscRingCache::GetReadView(RingCacheView &view)
+{
+    OptResult result = GetReadableSize();
+    CHECK_AND_RETURN_RET(result.ret == OPERATION_SUCCESS, result);
+    view = GetView(readIndex_.load(std::memory_order_relaxed), result.size);
+    return result;
+}
+
+OptResult AudioSpscRingCache::CommitRead(size_t size)
+{
+    OptResult result = GetReadableSize();
+    CHECK_AND_RETURN_RET(result.ret == OPERATION_SUCCESS, result);
+    CHECK_AND_RETURN_RET_LOG(size <= result.size, OptResult({INVALID_OPERATION, result.size}),
+        "CommitRead size %{public}zu is larger than readable size %{public}zu", size, result.size);
+    readIndex_.store(readIndex_.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    return {OPERATION_SUCCESS, size};
+}
 } // namespace AudioStandard
 } // namespace OHOS
@@ -12,12 +12,481 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifndef LOG_TAG
+#define LOG_TAG "FormatConverter"
+#endif
 
 #include "format_converter.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <iterator>
 #include <string>
 
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FORMAT_CONVERTER_NEON
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FORMAT_CONVERTER_X86
+#endif
+
+#include "securec.h"
+
+#include "audio_errors.h"
+#include "audio_service_log.h"
+#include "format_converter_c.h"
+#include "volume_tools.h"
+
 namespace OHOS {
 namespace AudioStandard {
+namespace {
+static constexpr float U8_SCALE = 128.0f; // 1 << 7
+static constexpr float U8_MAX_FLOAT = 255.0f;
+static constexpr float S16_SCALE = 32768.0f; // 1 << 15
+static constexpr float S16_MAX_FLOAT = 32767.0f;
+static constexpr float S32_SCALE = 2147483648.0f; // 1 << 31
+static constexpr float S32_MAX_FLOAT = 2147483520.0f; // the largest float below 1 << 31
+static constexpr float UNITY_GAIN = 1.0f;
+static constexpr float UNITY_GAIN_EPSILON = 1e-6f;
+static constexpr int32_t U8_ZERO = 0x80;
+static constexpr size_t S24_BYTE_SIZE = 3;
+static constexpr uint32_t SHIFT_EIGHT = 8;
+static constexpr uint32_t SHIFT_SIXTEEN = 16;
+static constexpr uint32_t SHIFT_TWENTY_FOUR = 24;
+static constexpr size_t INDEX_TWO = 2;
+static constexpr size_t FORMAT_NUM = SAMPLE_F32LE + 1;
+static constexpr size_t CONVERT_BLOCK_FRAMES = 64; // two float blocks of 16 channels take 8KB of stack
+
+struct ConvertKernel {
+    const char *name;
+    ToFloatFunc toFloat[FORMAT_NUM];
+    FromFloatFunc fromFloat[FORMAT_NUM];
+};
+
+inline float Clamp(float value, float minValue, float maxValue)
+{
+    return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+}
+
+// S24 samples are handled in the S32 range, the 24 bits are placed in the high bytes.
+inline int32_t ReadS24AsS32(const uint8_t *p)
+{
+    uint32_t value = (static_cast<uint32_t>(p[0]) << SHIFT_EIGHT) | (static_cast<uint32_t>(p[1]) << SHIFT_SIXTEEN) |
+        (static_cast<uint32_t>(p[INDEX_TWO]) << SHIFT_TWENTY_FOUR);
+    return static_cast<int32_t>(value);
+}
+
+inline void WriteS32AsS24(uint8_t *p, int32_t value)
+{
+    uint32_t u = static_cast<uint32_t>(value);
+    p[0] = static_cast<uint8_t>(u >> SHIFT_EIGHT);
+    p[1] = static_cast<uint8_t>(u >> SHIFT_SIXTEEN);
+    p[INDEX_TWO] = static_cast<uint8_t>(u >> SHIFT_TWENTY_FOUR);
+}
+
+void U8ToFloatScalar(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const float scale = gain / U8_SCALE;
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<float>(static_cast<int32_t>(src[i]) - U8_ZERO) * scale;
+    }
+}
+
+void S16ToFloatScalar(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const int16_t *in = reinterpret_cast<const int16_t *>(src);
+    const float scale = gain / S16_SCALE;
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<float>(in[i]) * scale;
+    }
+}
+
+void S24ToFloatScalar(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const float scale = gain / S32_SCALE;
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<float>(ReadS24AsS32(src + i * S24_BYTE_SIZE)) * scale;
+    }
+}
+
+void S32ToFloatScalar(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const int32_t *in = reinterpret_cast<const int32_t *>(src);
+    const float scale = gain / S32_SCALE;
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<float>(in[i]) * scale;
+    }
+}
+
+void F32ToFloatScalar(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = in[i] * gain;
+    }
+}
+
+void FloatToU8Scalar(const float *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<uint8_t>(Clamp(src[i] * U8_SCALE + U8_SCALE, 0.0f, U8_MAX_FLOAT));
+    }
+}
+
+void FloatToS16Scalar(const float *src, uint8_t *dst, size_t count)
+{
+    int16_t *out = reinterpret_cast<int16_t *>(dst);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = static_cast<int16_t>(Clamp(src[i] * S16_SCALE, -S16_SCALE, S16_MAX_FLOAT));
+    }
+}
+
+void FloatToS24Scalar(const float *src, uint8_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        WriteS32AsS24(dst + i * S24_BYTE_SIZE,
+            static_cast<int32_t>(Clamp(src[i] * S32_SCALE, -S32_SCALE, S32_MAX_FLOAT)));
+    }
+}
+
+void FloatToS32Scalar(const float *src, uint8_t *dst, size_t count)
+{
+    int32_t *out = reinterpret_cast<int32_t *>(dst);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = static_cast<int32_t>(Clamp(src[i] * S32_SCALE, -S32_SCALE, S32_MAX_FLOAT));
+    }
+}
+
+// Float keeps its headroom, it is not clamped.
+void FloatToF32Scalar(const float *src, uint8_t *dst, size_t count)
+{
+    float *out = reinterpret_cast<float *>(dst);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = src[i];
+    }
+}
+
+const ConvertKernel SCALAR_KERNEL = {
+    "scalar",
+    { U8ToFloatScalar, S16ToFloatScalar, S24ToFloatScalar, S32ToFloatScalar, F32ToFloatScalar },
+    { FloatToU8Scalar, FloatToS16Scalar, FloatToS24Scalar, FloatToS32Scalar, FloatToF32Scalar }
+};
+
+#ifdef FORMAT_CONVERTER_NEON
+static constexpr size_t NEON_STEP = 8; // two float32x4_t per loop
+static constexpr size_t NEON_HALF_STEP = 4;
+static constexpr size_t NEON_S24_STEP = 16; // one vld3q_u8 per loop
+static constexpr size_t NEON_QUARTER_STEP_2 = 8;
+static constexpr size_t NEON_QUARTER_STEP_3 = 12;
+
+void S16ToFloatNeon(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const int16_t *in = reinterpret_cast<const int16_t *>(src);
+    const float scale = gain / S16_SCALE;
+    size_t i = 0;
+    for (; i + NEON_STEP <= count; i += NEON_STEP) {
+        int16x8_t value = vld1q_s16(in + i);
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(value))), scale));
+        vst1q_f32(dst + i + NEON_HALF_STEP, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(value))), scale));
+    }
+    S16ToFloatScalar(src + i * sizeof(int16_t), dst + i, count - i, gain);
+}
+
+void S24ToFloatNeon(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const float scale = gain / S32_SCALE;
+    size_t i = 0;
+    for (; i + NEON_S24_STEP <= count; i += NEON_S24_STEP) {
+        // deinterleave the 3 bytes of 16 samples, then zip them back as b0 << 8 | b1 << 16 | b2 << 24
+        uint8x16x3_t bytes = vld3q_u8(src + i * S24_BYTE_SIZE);
+        uint8x16x2_t low = vzipq_u8(vdupq_n_u8(0), bytes.val[0]);
+        uint8x16x2_t high = vzipq_u8(bytes.val[1], bytes.val[INDEX_TWO]);
+        uint16x8x2_t first = vzipq_u16(vreinterpretq_u16_u8(low.val[0]), vreinterpretq_u16_u8(high.val[0]));
+        uint16x8x2_t second = vzipq_u16(vreinterpretq_u16_u8(low.val[1]), vreinterpretq_u16_u8(high.val[1]));
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(first.val[0])), scale));
+        vst1q_f32(dst + i + NEON_HALF_STEP, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(first.val[1])), scale));
+        vst1q_f32(dst + i + NEON_QUARTER_STEP_2,
+            vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(second.val[0])), scale));
+        vst1q_f32(dst + i + NEON_QUARTER_STEP_3,
+            vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u16(second.val[1])), scale));
+    }
+    S24ToFloatScalar(src + i * S24_BYTE_SIZE, dst + i, count - i, gain);
+}
+
+void S32ToFloatNeon(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const int32_t *in = reinterpret_cast<const int32_t *>(src);
+    const float scale = gain / S32_SCALE;
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(in + i)), scale));
+    }
+    S32ToFloatScalar(src + i * sizeof(int32_t), dst + i, count - i, gain);
+}
+
+void F32ToFloatNeon(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(in + i), gain));
+    }
+    F32ToFloatScalar(src + i * sizeof(float), dst + i, count - i, gain);
+}
+
+void FloatToS16Neon(const float *src, uint8_t *dst, size_t count)
+{
+    int16_t *out = reinterpret_cast<int16_t *>(dst);
+    size_t i = 0;
+    for (; i + NEON_STEP <= count; i += NEON_STEP) {
+        // vcvtq_s32_f32 and vqmovn_s32 saturate, no clamping is needed
+        int32x4_t low = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src + i), S16_SCALE));
+        int32x4_t high = vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + NEON_HALF_STEP), S16_SCALE));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+    FloatToS16Scalar(src + i, dst + i * sizeof(int16_t), count - i);
+}
+
+inline int32x4_t FloatToS32x4Neon(const float *src)
+{
+    return vcvtq_s32_f32(vmulq_n_f32(vld1q_f32(src), S32_SCALE));
+}
+
+void FloatToS24Neon(const float *src, uint8_t *dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + NEON_S24_STEP <= count; i += NEON_S24_STEP) {
+        // keep the high 3 bytes of the s32 samples, then interleave them with vst3q_u8
+        uint16x8x2_t first = vuzpq_u16(vreinterpretq_u16_s32(FloatToS32x4Neon(src + i)),
+            vreinterpretq_u16_s32(FloatToS32x4Neon(src + i + NEON_HALF_STEP)));
+        uint16x8x2_t second = vuzpq_u16(vreinterpretq_u16_s32(FloatToS32x4Neon(src + i + NEON_QUARTER_STEP_2)),
+            vreinterpretq_u16_s32(FloatToS32x4Neon(src + i + NEON_QUARTER_STEP_3)));
+        uint8x16x2_t low = vuzpq_u8(vreinterpretq_u8_u16(first.val[0]), vreinterpretq_u8_u16(second.val[0]));
+        uint8x16x2_t high = vuzpq_u8(vreinterpretq_u8_u16(first.val[1]), vreinterpretq_u8_u16(second.val[1]));
+        uint8x16x3_t bytes = { { low.val[1], high.val[0], high.val[1] } };
+        vst3q_u8(dst + i * S24_BYTE_SIZE, bytes);
+    }
+    FloatToS24Scalar(src + i, dst + i * S24_BYTE_SIZE, count - i);
+}
+
+void FloatToS32Neon(const float *src, uint8_t *dst, size_t count)
+{
+    int32_t *out = reinterpret_cast<int32_t *>(dst);
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        vst1q_s32(out + i, FloatToS32x4Neon(src + i));
+    }
+    FloatToS32Scalar(src + i, dst + i * sizeof(int32_t), count - i);
+}
+
+const ConvertKernel NEON_KERNEL = {
+    "neon",
+    { U8ToFloatScalar, S16ToFloatNeon, S24ToFloatNeon, S32ToFloatNeon, F32ToFloatNeon },
+    { FloatToU8Scalar, FloatToS16Neon, FloatToS24Neon, FloatToS32Neon, FloatToF32Scalar }
+};
+#endif // FORMAT_CONVERTER_NEON
+
+#ifdef FORMAT_CONVERTER_X86
+static constexpr size_t AVX_STEP = 8; // one __m256 per loop
+static constexpr size_t AVX_S24_LANE_BYTES = 12; // 4 samples in each 128 bit lane
+static constexpr size_t AVX_S24_READ_MARGIN = 2; // the 16 byte loads of the last lane read 4 bytes ahead
+static constexpr int32_t AVX_HIGH_LANE = 1;
+
+__attribute__((target("avx2"))) void S16ToFloatAvx2(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const int16_t *in = reinterpret_cast<const int16_t *>(src);
+    const __m256 scale = _mm256_set1_ps(gain / S16_SCALE);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(value)), scale));
+    }
+    S16ToFloatScalar(src + i * sizeof(int16_t), dst + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void S24ToFloatAvx2(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const __m256 scale = _mm256_set1_ps(gain / S32_SCALE);
+    // place the 3 bytes of each sample in the high bytes of an s32, -1 clears the low byte
+    const __m256i shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    size_t i = 0;
+    for (; i + AVX_STEP + AVX_S24_READ_MARGIN <= count; i += AVX_STEP) {
+        const uint8_t *in = src + i * S24_BYTE_SIZE;
+        __m256i value = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + AVX_S24_LANE_BYTES)), AVX_HIGH_LANE);
+        value = _mm256_shuffle_epi8(value, shuffle);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(value), scale));
+    }
+    S24ToFloatScalar(src + i * S24_BYTE_SIZE, dst + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void S32ToFloatAvx2(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const int32_t *in = reinterpret_cast<const int32_t *>(src);
+    const __m256 scale = _mm256_set1_ps(gain / S32_SCALE);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(value), scale));
+    }
+    S32ToFloatScalar(src + i * sizeof(int32_t), dst + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void F32ToFloatAvx2(const uint8_t *src, float *dst, size_t count, float gain)
+{
+    const float *in = reinterpret_cast<const float *>(src);
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), gainVec));
+    }
+    F32ToFloatScalar(src + i * sizeof(float), dst + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void FloatToS16Avx2(const float *src, uint8_t *dst, size_t count)
+{
+    int16_t *out = reinterpret_cast<int16_t *>(dst);
+    const __m256 scale = _mm256_set1_ps(S16_SCALE);
+    const __m256 minValue = _mm256_set1_ps(-S16_SCALE);
+    const __m256 maxValue = _mm256_set1_ps(S16_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m256 value = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), maxValue),
+            minValue);
+        __m256i value32 = _mm256_cvttps_epi32(value);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+            _mm_packs_epi32(_mm256_castsi256_si128(value32), _mm256_extracti128_si256(value32, AVX_HIGH_LANE)));
+    }
+    FloatToS16Scalar(src + i, dst + i * sizeof(int16_t), count - i);
+}
+
+__attribute__((target("avx2"))) inline __m256i FloatToS32x8Avx2(const float *src)
+{
+    const __m256 scale = _mm256_set1_ps(S32_SCALE);
+    const __m256 minValue = _mm256_set1_ps(-S32_SCALE);
+    const __m256 maxValue = _mm256_set1_ps(S32_MAX_FLOAT);
+    return _mm256_cvttps_epi32(_mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(src), scale), maxValue),
+        minValue));
+}
+
+__attribute__((target("avx2"))) void FloatToS24Avx2(const float *src, uint8_t *dst, size_t count)
+{
+    // keep the high 3 bytes of each s32 sample, packed to the low 12 bytes of each lane
+    const __m256i shuffle = _mm256_setr_epi8(1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1,
+        1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1);
+    size_t i = 0;
+    // the 16 byte stores write 4 bytes ahead, they are overwritten by the next store
+    for (; i + AVX_STEP + AVX_S24_READ_MARGIN <= count; i += AVX_STEP) {
+        uint8_t *out = dst + i * S24_BYTE_SIZE;
+        __m256i value = _mm256_shuffle_epi8(FloatToS32x8Avx2(src + i), shuffle);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(value));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + AVX_S24_LANE_BYTES),
+            _mm256_extracti128_si256(value, AVX_HIGH_LANE));
+    }
+    FloatToS24Scalar(src + i, dst + i * S24_BYTE_SIZE, count - i);
+}
+
+__attribute__((target("avx2"))) void FloatToS32Avx2(const float *src, uint8_t *dst, size_t count)
+{
+    int32_t *out = reinterpret_cast<int32_t *>(dst);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), FloatToS32x8Avx2(src + i));
+    }
+    FloatToS32Scalar(src + i, dst + i * sizeof(int32_t), count - i);
+}
+
+const ConvertKernel AVX2_KERNEL = {
+    "avx2",
+    { U8ToFloatScalar, S16ToFloatAvx2, S24ToFloatAvx2, S32ToFloatAvx2, F32ToFloatAvx2 },
+    { FloatToU8Scalar, FloatToS16Avx2, FloatToS24Avx2, FloatToS32Avx2, FloatToF32Scalar }
+};
+#endif // FORMAT_CONVERTER_X86
+
+const ConvertKernel &SelectKernel()
+{
+#if defined(FORMAT_CONVERTER_NEON)
+    return NEON_KERNEL;
+#elif defined(FORMAT_CONVERTER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return AVX2_KERNEL;
+    }
+    return SCALAR_KERNEL;
+#else
+    return SCALAR_KERNEL;
+#endif
+}
+
+// Selected once, FormatConverter::Init then picks the functions of one format pair from it.
+const ConvertKernel &GetKernel()
+{
+    static const ConvertKernel &kernel = SelectKernel();
+    return kernel;
+}
+
+static constexpr float MINUS_3DB_GAIN = 0.70710678f; // 1 / sqrt(2)
+static constexpr uint64_t LEFT_CHANNELS = FRONT_LEFT | BACK_LEFT | FRONT_LEFT_OF_CENTER | SIDE_LEFT | TOP_FRONT_LEFT |
+    TOP_BACK_LEFT | STEREO_LEFT | WIDE_LEFT | SURROUND_DIRECT_LEFT | TOP_SIDE_LEFT | BOTTOM_FRONT_LEFT;
+static constexpr uint64_t RIGHT_CHANNELS = FRONT_RIGHT | BACK_RIGHT | FRONT_RIGHT_OF_CENTER | SIDE_RIGHT |
+    TOP_FRONT_RIGHT | TOP_BACK_RIGHT | STEREO_RIGHT | WIDE_RIGHT | SURROUND_DIRECT_RIGHT | TOP_SIDE_RIGHT |
+    BOTTOM_FRONT_RIGHT;
+static constexpr uint64_t LFE_CHANNELS = LOW_FREQUENCY | LOW_FREQUENCY_2;
+
+uint64_t GetDefaultChannelLayout(uint32_t channels)
+{
+    switch (channels) {
+        case MONO:
+            return CH_LAYOUT_MONO;
+        case STEREO:
+            return CH_LAYOUT_STEREO;
+        case CHANNEL_3:
+            return CH_LAYOUT_SURROUND;
+        case CHANNEL_4:
+            return CH_LAYOUT_QUAD;
+        case CHANNEL_5:
+            return CH_LAYOUT_5POINT0;
+        case CHANNEL_6:
+            return CH_LAYOUT_5POINT1;
+        case CHANNEL_7:
+            return CH_LAYOUT_6POINT1;
+        case CHANNEL_8:
+            return CH_LAYOUT_7POINT1;
+        case CHANNEL_10:
+            return CH_LAYOUT_5POINT1POINT4;
+        case CHANNEL_12:
+            return CH_LAYOUT_7POINT1POINT4;
+        case CHANNEL_14:
+            return CH_LAYOUT_9POINT1POINT4;
+        case CHANNEL_16:
+            return CH_LAYOUT_9POINT1POINT6;
+        default:
+            return CH_LAYOUT_UNKNOWN;
+    }
+}
+
+// Returns CH_LAYOUT_UNKNOWN if neither the given layout nor a default one matches the channel count.
+uint64_t GetChannelLayout(uint64_t layout, uint32_t channels)
+{
+    if (layout != CH_LAYOUT_UNKNOWN && static_cast<uint32_t>(__builtin_popcountll(layout)) == channels) {
+        return layout;
+    }
+    return GetDefaultChannelLayout(channels);
+}
+
+// Interleaved channels follow the bit order of the layout.
+int32_t GetChannelIndex(uint64_t layout, uint64_t channel)
+{
+    if ((layout & channel) == 0) {
+        return -1;
+    }
+    return __builtin_popcountll(layout & (channel - 1));
+}
+} // namespace
+
 int32_t FormatConverter::S16MonoToS16Stereo(const BufferDesc &srcDesc, const BufferDesc &dstDesc)
 {
     size_t half = 2; // mono(1) -> stereo(2)
@@ -49,5 +518,265 @@ int32_t FormatConverter::S16StereoToS16Mono(const BufferDesc &srcDesc, const Buf
     }
     return 0;
 }
+
+bool FormatConverter::IsFormatSupported(AudioSampleFormat format)
+{
+    return GetSampleSize(format) != 0;
+}
+
+size_t FormatConverter::GetSampleSize(AudioSampleFormat format)
+{
+    switch (format) {
+        case SAMPLE_U8:
+            return sizeof(uint8_t);
+        case SAMPLE_S16LE:
+            return sizeof(int16_t);
+        case SAMPLE_S24LE:
+            return S24_BYTE_SIZE;
+        case SAMPLE_S32LE:
+            return sizeof(int32_t);
+        case SAMPLE_F32LE:
+            return sizeof(float);
+        default:
+            return 0;
+    }
+}
+
+const char *FormatConverter::GetKernelName()
+{
+    return GetKernel().name;
+}
+
+int32_t FormatConverter::ToFloat(AudioSampleFormat format, const uint8_t *src, float *dst, size_t count, float gain)
+{
+    CHECK_AND_RETURN_RET_LOG(IsFormatSupported(format), ERR_NOT_SUPPORTED, "format %{public}d not supported", format);
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ERR_INVALID_PARAM, "buffer is null");
+    GetKernel().toFloat[format](src, dst, count, gain);
+    return SUCCESS;
+}
+
+int32_t FormatConverter::FromFloat(AudioSampleFormat format, const float *src, uint8_t *dst, size_t count)
+{
+    CHECK_AND_RETURN_RET_LOG(IsFormatSupported(format), ERR_NOT_SUPPORTED, "format %{public}d not supported", format);
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ERR_INVALID_PARAM, "buffer is null");
+    GetKernel().fromFloat[format](src, dst, count);
+    return SUCCESS;
+}
+
+int32_t FormatConverter::Init(const FormatConvertConfig &config)
+{
+    CHECK_AND_RETURN_RET_LOG(IsFormatSupported(config.srcFormat) && IsFormatSupported(config.dstFormat),
+        ERR_NOT_SUPPORTED, "format %{public}d -> %{public}d not supported", config.srcFormat, config.dstFormat);
+    CHECK_AND_RETURN_RET_LOG(config.srcChannels >= MONO && config.srcChannels <= CHANNEL_MAX &&
+        config.dstChannels >= MONO && config.dstChannels <= CHANNEL_MAX, ERR_NOT_SUPPORTED,
+        "channels %{public}u -> %{public}u not supported", config.srcChannels, config.dstChannels);
+    config_ = config;
+    // one channel is the same in both layouts
+    config_.isSrcPlanar = config.isSrcPlanar && config.srcChannels > MONO;
+    config_.isDstPlanar = config.isDstPlanar && config.dstChannels > MONO;
+
+    const ConvertKernel &kernel = GetKernel();
+    toFloat_ = kernel.toFloat[config_.srcFormat];
+    fromFloat_ = kernel.fromFloat[config_.dstFormat];
+    srcFrameSize_ = GetSampleSize(config_.srcFormat) * config_.srcChannels;
+    dstFrameSize_ = GetSampleSize(config_.dstFormat) * config_.dstChannels;
+    if (config_.srcChannels != config_.dstChannels) {
+        BuildMixMatrix();
+    }
+    if (config_.srcChannels != config_.dstChannels || config_.isSrcPlanar != config_.isDstPlanar) {
+        mode_ = CONVERT_FRAMES;
+    } else {
+        mode_ = config_.srcFormat == config_.dstFormat ? CONVERT_COPY : CONVERT_SAMPLES;
+    }
+    return SUCCESS;
+}
+
+int32_t FormatConverter::Process(const BufferDesc &srcDesc, const BufferDesc &dstDesc, float gain) const
+{
+    CHECK_AND_RETURN_RET_LOG(toFloat_ != nullptr && fromFloat_ != nullptr, ERR_ILLEGAL_STATE, "not inited");
+    CHECK_AND_RETURN_RET_LOG(srcDesc.buffer != nullptr && dstDesc.buffer != nullptr, ERR_INVALID_PARAM,
+        "buffer is null");
+    size_t frameCount = srcDesc.bufLength / srcFrameSize_;
+    CHECK_AND_RETURN_RET_LOG(dstDesc.bufLength >= frameCount * dstFrameSize_, ERR_INVALID_PARAM,
+        "dst length %{public}zu is less than %{public}zu frames", dstDesc.bufLength, frameCount);
+
+    bool isUnityGain = IsVolumeSame(gain, UNITY_GAIN, UNITY_GAIN_EPSILON);
+    switch (mode_) {
+        case CONVERT_COPY:
+            if (isUnityGain) {
+                int32_t ret = memcpy_s(dstDesc.buffer, dstDesc.bufLength, srcDesc.buffer, frameCount * srcFrameSize_);
+                CHECK_AND_RETURN_RET_LOG(ret == EOK, ERR_OPERATION_FAILED, "memcpy_s failed: %{public}d", ret);
+                return SUCCESS;
+            }
+            return ProcessSamples(srcDesc.buffer, dstDesc.buffer, frameCount * config_.srcChannels, gain);
+        case CONVERT_SAMPLES:
+            return ProcessSamples(srcDesc.buffer, dstDesc.buffer, frameCount * config_.srcChannels, gain);
+        default:
+            ProcessFrames(srcDesc.buffer, dstDesc.buffer, frameCount, gain);
+            return SUCCESS;
+    }
+}
+
+int32_t FormatConverter::ProcessSamples(const uint8_t *src, uint8_t *dst, size_t sampleCount, float gain) const
+{
+    // one pass if either side is float, else through a float block on the stack
+    if (config_.dstFormat == SAMPLE_F32LE) {
+        toFloat_(src, reinterpret_cast<float *>(dst), sampleCount, gain);
+        return SUCCESS;
+    }
+    if (config_.srcFormat == SAMPLE_F32LE && IsVolumeSame(gain, UNITY_GAIN, UNITY_GAIN_EPSILON)) {
+        fromFloat_(reinterpret_cast<const float *>(src), dst, sampleCount);
+        return SUCCESS;
+    }
+    float block[CONVERT_BLOCK_FRAMES * CHANNEL_MAX];
+    size_t srcSampleSize = GetSampleSize(config_.srcFormat);
+    size_t dstSampleSize = GetSampleSize(config_.dstFormat);
+    for (size_t done = 0; done < sampleCount;) {
+        size_t count = std::min(sampleCount - done, CONVERT_BLOCK_FRAMES * CHANNEL_MAX);
+        toFloat_(src + done * srcSampleSize, block, count, gain);
+        fromFloat_(block, dst + done * dstSampleSize, count);
+        done += count;
+    }
+    return SUCCESS;
+}
+
+void FormatConverter::ProcessFrames(const uint8_t *src, uint8_t *dst, size_t frameCount, float gain) const
+{
+    float in[CONVERT_BLOCK_FRAMES * CHANNEL_MAX];
+    float out[CONVERT_BLOCK_FRAMES * CHANNEL_MAX];
+    size_t srcChannels = config_.srcChannels;
+    size_t dstChannels = config_.dstChannels;
+    size_t srcSampleSize = srcFrameSize_ / srcChannels;
+    size_t dstSampleSize = dstFrameSize_ / dstChannels;
+    for (size_t done = 0; done < frameCount;) {
+        size_t count = std::min(frameCount - done, CONVERT_BLOCK_FRAMES);
+        if (config_.isSrcPlanar) {
+            // out is free until the channels are mapped, use it for one plane
+            for (size_t ch = 0; ch < srcChannels; ch++) {
+                toFloat_(src + (ch * frameCount + done) * srcSampleSize, out, count, gain);
+                for (size_t frame = 0; frame < count; frame++) {
+                    in[frame * srcChannels + ch] = out[frame];
+                }
+            }
+        } else {
+            toFloat_(src + done * srcFrameSize_, in, count * srcChannels, gain);
+        }
+
+        const float *mapped = in;
+        if (srcChannels != dstChannels) {
+            MapChannels(in, out, count);
+            mapped = out;
+        }
+
+        if (config_.isDstPlanar) {
+            float *plane = mapped == in ? out : in;
+            for (size_t ch = 0; ch < dstChannels; ch++) {
+                for (size_t frame = 0; frame < count; frame++) {
+                    plane[frame] = mapped[frame * dstChannels + ch];
+                }
+                fromFloat_(plane, dst + (ch * frameCount + done) * dstSampleSize, count);
+            }
+        } else {
+            fromFloat_(mapped, dst + done * dstFrameSize_, count * dstChannels);
+        }
+        done += count;
+    }
+}
+
+void FormatConverter::BuildMixMatrix()
+{
+    size_t srcChannels = config_.srcChannels;
+    size_t dstChannels = config_.dstChannels;
+    for (auto &row : mixMatrix_) {
+        std::fill(std::begin(row), std::end(row), 0.0f);
+    }
+    uint64_t srcLayout = GetChannelLayout(config_.srcChannelLayout, config_.srcChannels);
+    uint64_t dstLayout = GetChannelLayout(config_.dstChannelLayout, config_.dstChannels);
+    if (srcLayout == CH_LAYOUT_UNKNOWN || dstLayout == CH_LAYOUT_UNKNOWN) {
+        // positions unknown, fold in channel order
+        for (size_t ch = 0; ch < srcChannels; ch++) {
+            mixMatrix_[ch % dstChannels][ch] = 1.0f;
+        }
+    } else {
+        int32_t left = GetChannelIndex(dstLayout, FRONT_LEFT);
+        int32_t right = GetChannelIndex(dstLayout, FRONT_RIGHT);
+        int32_t center = GetChannelIndex(dstLayout, FRONT_CENTER);
+        size_t ch = 0;
+        for (uint64_t remain = srcLayout; remain != 0; remain &= remain - 1, ch++) {
+            uint64_t channel = remain & (~remain + 1);
+            int32_t same = GetChannelIndex(dstLayout, channel);
+            if (same >= 0) {
+                mixMatrix_[same][ch] = 1.0f;
+            } else if ((channel & LFE_CHANNELS) != 0) {
+                continue;
+            } else if ((channel & LEFT_CHANNELS) != 0 || (channel & RIGHT_CHANNELS) != 0) {
+                int32_t side = (channel & LEFT_CHANNELS) != 0 ? left : right;
+                side = side >= 0 ? side : center;
+                CHECK_AND_CONTINUE_LOG(side >= 0, "no channel for %{public}" PRIu64, channel);
+                mixMatrix_[side][ch] = MINUS_3DB_GAIN;
+            } else if (left >= 0 && right >= 0) {
+                mixMatrix_[left][ch] = MINUS_3DB_GAIN;
+                mixMatrix_[right][ch] = MINUS_3DB_GAIN;
+            } else if (center >= 0) {
+                mixMatrix_[center][ch] = MINUS_3DB_GAIN;
+            }
+        }
+    }
+    for (size_t dst = 0; dst < dstChannels; dst++) {
+        float sum = 0.0f;
+        for (size_t src = 0; src < srcChannels; src++) {
+            sum += mixMatrix_[dst][src];
+        }
+        for (size_t src = 0; sum > 1.0f && src < srcChannels; src++) {
+            mixMatrix_[dst][src] /= sum;
+        }
+    }
+}
+
+// Interleaved float frames, mono is duplicated, other channels go through the mix matrix.
+void FormatConverter::MapChannels(const float *src, float *dst, size_t frameCount) const
+{
+    size_t srcChannels = config_.srcChannels;
+    size_t dstChannels = config_.dstChannels;
+    if (srcChannels == 1) {
+        for (size_t frame = 0; frame < frameCount; frame++) {
+            std::fill(dst + frame * dstChannels, dst + (frame + 1) * dstChannels, src[frame]);
+        }
+        return;
+    }
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        const float *srcFrame = src + frame * srcChannels;
+        float *dstFrame = dst + frame * dstChannels;
+        for (size_t ch = 0; ch < dstChannels; ch++) {
+            const float *gains = mixMatrix_[ch];
+            float sum = 0.0f;
+            for (size_t in = 0; in < srcChannels; in++) {
+                sum += srcFrame[in] * gains[in];
+            }
+            dstFrame[ch] = sum;
+        }
+    }
+}
 } // namespace AudioStandard
 } // namespace OHOS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+using namespace OHOS::AudioStandard;
+
+int32_t ConvertToFloatC(uint32_t format, size_t count, const void *src, float *dst)
+{
+    return FormatConverter::ToFloat(static_cast<AudioSampleFormat>(format), static_cast<const uint8_t *>(src), dst,
+        count);
+}
+
+int32_t ConvertFromFloatC(uint32_t format, size_t count, const float *src, void *dst)
+{
+    return FormatConverter::FromFloat(static_cast<AudioSampleFormat>(format), src, static_cast<uint8_t *>(dst),
+        count);
+}
+
+#ifdef __cplusplus
+}
+#endif
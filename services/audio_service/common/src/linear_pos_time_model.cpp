@@ -18,7 +18,9 @@
 
 #include "linear_pos_time_model.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
 
 #include "audio_errors.h"
 #include "audio_service_log.h"
@@ -29,6 +31,15 @@ namespace {
     static constexpr int64_t NANO_COUNT_PER_SECOND = 1000000000;
     static constexpr int32_t MAX_SUPPORT_SAMPLE_RETE = 384000;
     static constexpr int64_t REASONABLE_BOUND_IN_NANO = 10000000; // 10ms
+    // gains of the tracking loop, the rate is corrected against at least one second of frames
+    static constexpr double PHASE_GAIN = 0.5;
+    static constexpr double RATE_GAIN = 0.1;
+    static constexpr double MAX_DRIFT_PPM = 1000.0;
+    static constexpr double PPM_PER_ONE = 1000000.0;
+    static constexpr double ERROR_VARIANCE_WEIGHT = 0.125;
+    static constexpr double ERROR_BOUND_SIGMA = 3.0;
+    static constexpr uint32_t MIN_TRACKED_COUNT = 8;
+    static constexpr int64_t MIN_RATE_ERROR_BOUND_IN_NANO = 1000000; // 1ms
 }
 LinearPosTimeModel::LinearPosTimeModel()
 {
@@ -44,7 +55,8 @@ bool LinearPosTimeModel::ConfigSampleRate(int32_t sampleRate)
         AUDIO_ERR_LOG("Invalid sample rate!");
         return false;
     } else {
-        nanoTimePerFrame_ = NANO_COUNT_PER_SECOND / sampleRate;
+        nominalNanoTimePerFrame_ = static_cast<double>(NANO_COUNT_PER_SECOND) / sampleRate;
+        nanoTimePerFrame_ = nominalNanoTimePerFrame_;
     }
     isConfiged = true;
     return true;
@@ -55,6 +67,9 @@ void LinearPosTimeModel::ResetFrameStamp(uint64_t frame, int64_t nanoTime)
     AUDIO_INFO_LOG("Reset frame:%{public}" PRIu64" with time:%{public}" PRId64".", frame, nanoTime);
     stampFrame_ = frame;
     stampNanoTime_ = nanoTime;
+    // the estimated rate still holds for the same clock, only the confidence is rebuilt
+    errorVariance_ = 0;
+    trackedCount_ = 0;
     return;
 }
 
@@ -70,7 +85,7 @@ bool LinearPosTimeModel::IsReasonable(uint64_t frame, int64_t nanoTime)
     } else {
         deltaFrame = -static_cast<int64_t>(stampFrame_ - frame);
     }
-    reasonableDeltaTime = stampNanoTime_ + deltaFrame * NANO_COUNT_PER_SECOND / (int64_t)sampleRate_;
+    reasonableDeltaTime = stampNanoTime_ + GetDeltaTime(deltaFrame);
 
     // note: compare it with current time?
     if (nanoTime <= (reasonableDeltaTime + REASONABLE_BOUND_IN_NANO) &&
@@ -84,8 +99,7 @@ bool LinearPosTimeModel::UpdataFrameStamp(uint64_t frame, int64_t nanoTime)
 {
     if (IsReasonable(frame, nanoTime)) {
         AUDIO_DEBUG_LOG("Updata frame:%{public}" PRIu64" with time:%{public}" PRId64".", frame, nanoTime);
-        stampFrame_ = frame;
-        stampNanoTime_ = nanoTime;
+        TrackStamp(frame, nanoTime);
         return true;
     }
     AUDIO_WARNING_LOG("Unreasonable pos-time[ %{public}" PRIu64" %{public}" PRId64"] "
@@ -109,6 +123,57 @@ void LinearPosTimeModel::SetSpanCount(uint64_t spanCountInFrame)
     return;
 }
 
+int64_t LinearPosTimeModel::GetDeltaTime(int64_t deltaFrame)
+{
+    return static_cast<int64_t>(deltaFrame * nanoTimePerFrame_);
+}
+
+void LinearPosTimeModel::TrackStamp(uint64_t frame, int64_t nanoTime)
+{
+    if (!isConfiged || frame <= stampFrame_) {
+        stampFrame_ = frame;
+        stampNanoTime_ = nanoTime;
+        return;
+    }
+    int64_t deltaFrame = static_cast<int64_t>(frame - stampFrame_);
+    int64_t predictTime = stampNanoTime_ + GetDeltaTime(deltaFrame);
+    double error = static_cast<double>(nanoTime - predictTime);
+
+    // a single late stamp should not bend the rate
+    double rateError = error;
+    int64_t errorBound = GetErrorBoundNano();
+    if (errorBound >= 0) {
+        double rateErrorBound = static_cast<double>(std::max(errorBound, MIN_RATE_ERROR_BOUND_IN_NANO));
+        rateError = std::clamp(error, -rateErrorBound, rateErrorBound);
+    }
+    double rateWindow = static_cast<double>(std::max(deltaFrame, static_cast<int64_t>(sampleRate_)));
+    double maxDrift = nominalNanoTimePerFrame_ * MAX_DRIFT_PPM / PPM_PER_ONE;
+    nanoTimePerFrame_ = std::clamp(nanoTimePerFrame_ + RATE_GAIN * rateError / rateWindow,
+        nominalNanoTimePerFrame_ - maxDrift, nominalNanoTimePerFrame_ + maxDrift);
+
+    stampFrame_ = frame;
+    stampNanoTime_ = predictTime + static_cast<int64_t>(PHASE_GAIN * error);
+
+    errorVariance_ += (error * error - errorVariance_) * ERROR_VARIANCE_WEIGHT;
+    if (trackedCount_ < MIN_TRACKED_COUNT) {
+        trackedCount_++;
+    }
+}
+
+int64_t LinearPosTimeModel::GetErrorBoundNano()
+{
+    if (trackedCount_ < MIN_TRACKED_COUNT) {
+        return -1;
+    }
+    return static_cast<int64_t>(ERROR_BOUND_SIGMA * std::sqrt(errorVariance_));
+}
+
+double LinearPosTimeModel::GetDriftPpm()
+{
+    CHECK_AND_RETURN_RET(isConfiged && nanoTimePerFrame_ > 0, 0);
+    return (nominalNanoTimePerFrame_ / nanoTimePerFrame_ - 1) * PPM_PER_ONE;
+}
+
 int64_t LinearPosTimeModel::GetTimeOfPos(uint64_t posInFrame)
 {
     int64_t deltaFrame = 0;
@@ -120,14 +185,14 @@ int64_t LinearPosTimeModel::GetTimeOfPos(uint64_t posInFrame)
                 " large, stampFrame: %{public}" PRIu64"", posInFrame, stampFrame_);
         }
         deltaFrame = static_cast<int64_t>(posInFrame - stampFrame_);
-        return stampNanoTime_ + deltaFrame * NANO_COUNT_PER_SECOND / (int64_t)sampleRate_;
+        return stampNanoTime_ + GetDeltaTime(deltaFrame);
     } else {
         if (stampFrame_ - posInFrame >= (uint64_t)sampleRate_) {
             AUDIO_WARNING_LOG("posInFrame %{public}" PRIu64" is too"
                 " small, stampFrame: %{public}" PRIu64"", posInFrame, stampFrame_);
         }
         deltaFrame = static_cast<int64_t>(stampFrame_ - posInFrame);
-        return stampNanoTime_ - deltaFrame * NANO_COUNT_PER_SECOND / (int64_t)sampleRate_;
+        return stampNanoTime_ - GetDeltaTime(deltaFrame);
     }
     return invalidTime;
 }
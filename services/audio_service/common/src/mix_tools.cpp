@@ -0,0 +1,569 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "MixTools"
+#endif
+
+#include "mix_tools.h"
+
+#include <algorithm>
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MIX_TOOLS_NEON
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MIX_TOOLS_X86
+#endif
+
+#include "audio_errors.h"
+#include "audio_service_log.h"
+#include "format_converter.h"
+#include "volume_tools.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+static constexpr float S16_SCALE = 32768.0f; // 1 << 15
+static constexpr float S32_SCALE = 2147483648.0f; // 1 << 31
+static constexpr float S16_MAX_FLOAT = 32767.0f;
+static constexpr float S32_MAX_FLOAT = 2147483520.0f; // the largest float below 1 << 31
+static constexpr float F32_MAX = 1.0f;
+static constexpr size_t MIX_BLOCK_FRAMES = 64; // one float block of 16 channels takes 4KB of stack
+
+// Accumulate count samples of src into acc, each sample is normalized and multiplied by gain on the way.
+using AccumulateS16Func = void (*)(const int16_t *src, float *acc, size_t count, float gain);
+using AccumulateS32Func = void (*)(const int32_t *src, float *acc, size_t count, float gain);
+using AccumulateF32Func = void (*)(const float *src, float *acc, size_t count, float gain);
+// Saturate the normalized accumulator into the destination format.
+using StoreS16Func = void (*)(const float *acc, int16_t *dst, size_t count);
+using StoreS32Func = void (*)(const float *acc, int32_t *dst, size_t count);
+using StoreF32Func = void (*)(const float *acc, float *dst, size_t count);
+
+struct MixKernel {
+    const char *name;
+    AccumulateS16Func accumulateS16;
+    AccumulateS32Func accumulateS32;
+    AccumulateF32Func accumulateF32;
+    StoreS16Func storeS16;
+    StoreS32Func storeS32;
+    StoreF32Func storeF32;
+};
+
+inline float Clamp(float value, float minValue, float maxValue)
+{
+    return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+}
+
+void AccumulateS16Scalar(const int16_t *src, float *acc, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; i++) {
+        acc[i] += static_cast<float>(src[i]) * gain;
+    }
+}
+
+void AccumulateS32Scalar(const int32_t *src, float *acc, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; i++) {
+        acc[i] += static_cast<float>(src[i]) * gain;
+    }
+}
+
+void AccumulateF32Scalar(const float *src, float *acc, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; i++) {
+        acc[i] += src[i] * gain;
+    }
+}
+
+void StoreS16Scalar(const float *acc, int16_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<int16_t>(Clamp(acc[i] * S16_SCALE, -S16_SCALE, S16_MAX_FLOAT));
+    }
+}
+
+void StoreS32Scalar(const float *acc, int32_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<int32_t>(Clamp(acc[i] * S32_SCALE, -S32_SCALE, S32_MAX_FLOAT));
+    }
+}
+
+void StoreF32Scalar(const float *acc, float *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = Clamp(acc[i], -F32_MAX, F32_MAX);
+    }
+}
+
+const MixKernel SCALAR_KERNEL = {
+    "scalar",
+    AccumulateS16Scalar, AccumulateS32Scalar, AccumulateF32Scalar,
+    StoreS16Scalar, StoreS32Scalar, StoreF32Scalar
+};
+
+#ifdef MIX_TOOLS_NEON
+static constexpr size_t NEON_STEP = 8; // two float32x4_t per loop
+static constexpr size_t NEON_HALF_STEP = 4;
+
+void AccumulateS16Neon(const int16_t *src, float *acc, size_t count, float gain)
+{
+    size_t i = 0;
+    for (; i + NEON_STEP <= count; i += NEON_STEP) {
+        int16x8_t in = vld1q_s16(src + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(in)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(in)));
+        vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), lo, gain));
+        vst1q_f32(acc + i + NEON_HALF_STEP, vmlaq_n_f32(vld1q_f32(acc + i + NEON_HALF_STEP), hi, gain));
+    }
+    AccumulateS16Scalar(src + i, acc + i, count - i, gain);
+}
+
+void AccumulateS32Neon(const int32_t *src, float *acc, size_t count, float gain)
+{
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        float32x4_t in = vcvtq_f32_s32(vld1q_s32(src + i));
+        vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), in, gain));
+    }
+    AccumulateS32Scalar(src + i, acc + i, count - i, gain);
+}
+
+void AccumulateF32Neon(const float *src, float *acc, size_t count, float gain)
+{
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), vld1q_f32(src + i), gain));
+    }
+    AccumulateF32Scalar(src + i, acc + i, count - i, gain);
+}
+
+void StoreS16Neon(const float *acc, int16_t *dst, size_t count)
+{
+    const float32x4_t minValue = vdupq_n_f32(-S16_SCALE);
+    const float32x4_t maxValue = vdupq_n_f32(S16_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + NEON_STEP <= count; i += NEON_STEP) {
+        float32x4_t lo = vmaxq_f32(vminq_f32(vmulq_n_f32(vld1q_f32(acc + i), S16_SCALE), maxValue), minValue);
+        float32x4_t hi = vmaxq_f32(vminq_f32(vmulq_n_f32(vld1q_f32(acc + i + NEON_HALF_STEP), S16_SCALE),
+            maxValue), minValue);
+        vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)), vqmovn_s32(vcvtq_s32_f32(hi))));
+    }
+    StoreS16Scalar(acc + i, dst + i, count - i);
+}
+
+void StoreS32Neon(const float *acc, int32_t *dst, size_t count)
+{
+    const float32x4_t minValue = vdupq_n_f32(-S32_SCALE);
+    const float32x4_t maxValue = vdupq_n_f32(S32_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        float32x4_t value = vmaxq_f32(vminq_f32(vmulq_n_f32(vld1q_f32(acc + i), S32_SCALE), maxValue), minValue);
+        vst1q_s32(dst + i, vcvtq_s32_f32(value));
+    }
+    StoreS32Scalar(acc + i, dst + i, count - i);
+}
+
+void StoreF32Neon(const float *acc, float *dst, size_t count)
+{
+    const float32x4_t minValue = vdupq_n_f32(-F32_MAX);
+    const float32x4_t maxValue = vdupq_n_f32(F32_MAX);
+    size_t i = 0;
+    for (; i + NEON_HALF_STEP <= count; i += NEON_HALF_STEP) {
+        vst1q_f32(dst + i, vmaxq_f32(vminq_f32(vld1q_f32(acc + i), maxValue), minValue));
+    }
+    StoreF32Scalar(acc + i, dst + i, count - i);
+}
+
+const MixKernel NEON_KERNEL = {
+    "neon",
+    AccumulateS16Neon, AccumulateS32Neon, AccumulateF32Neon,
+    StoreS16Neon, StoreS32Neon, StoreF32Neon
+};
+#endif // MIX_TOOLS_NEON
+
+#ifdef MIX_TOOLS_X86
+static constexpr size_t SSE_STEP = 8; // two __m128 per loop
+static constexpr size_t SSE_HALF_STEP = 4;
+static constexpr int32_t SIGN_EXTEND_SHIFT = 16;
+
+__attribute__((target("sse2"))) void AccumulateS16Sse2(const int16_t *src, float *acc, size_t count, float gain)
+{
+    const __m128 gainVec = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + SSE_STEP <= count; i += SSE_STEP) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), SIGN_EXTEND_SHIFT));
+        __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), SIGN_EXTEND_SHIFT));
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(lo, gainVec)));
+        _mm_storeu_ps(acc + i + SSE_HALF_STEP,
+            _mm_add_ps(_mm_loadu_ps(acc + i + SSE_HALF_STEP), _mm_mul_ps(hi, gainVec)));
+    }
+    AccumulateS16Scalar(src + i, acc + i, count - i, gain);
+}
+
+__attribute__((target("sse2"))) void AccumulateS32Sse2(const int32_t *src, float *acc, size_t count, float gain)
+{
+    const __m128 gainVec = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + SSE_HALF_STEP <= count; i += SSE_HALF_STEP) {
+        __m128 in = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(in, gainVec)));
+    }
+    AccumulateS32Scalar(src + i, acc + i, count - i, gain);
+}
+
+__attribute__((target("sse2"))) void AccumulateF32Sse2(const float *src, float *acc, size_t count, float gain)
+{
+    const __m128 gainVec = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + SSE_HALF_STEP <= count; i += SSE_HALF_STEP) {
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), gainVec)));
+    }
+    AccumulateF32Scalar(src + i, acc + i, count - i, gain);
+}
+
+__attribute__((target("sse2"))) void StoreS16Sse2(const float *acc, int16_t *dst, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(S16_SCALE);
+    const __m128 minValue = _mm_set1_ps(-S16_SCALE);
+    const __m128 maxValue = _mm_set1_ps(S16_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + SSE_STEP <= count; i += SSE_STEP) {
+        __m128 lo = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(acc + i), scale), maxValue), minValue);
+        __m128 hi = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(acc + i + SSE_HALF_STEP), scale), maxValue),
+            minValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+            _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi)));
+    }
+    StoreS16Scalar(acc + i, dst + i, count - i);
+}
+
+__attribute__((target("sse2"))) void StoreS32Sse2(const float *acc, int32_t *dst, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(S32_SCALE);
+    const __m128 minValue = _mm_set1_ps(-S32_SCALE);
+    const __m128 maxValue = _mm_set1_ps(S32_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + SSE_HALF_STEP <= count; i += SSE_HALF_STEP) {
+        __m128 value = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(acc + i), scale), maxValue), minValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_cvttps_epi32(value));
+    }
+    StoreS32Scalar(acc + i, dst + i, count - i);
+}
+
+__attribute__((target("sse2"))) void StoreF32Sse2(const float *acc, float *dst, size_t count)
+{
+    const __m128 minValue = _mm_set1_ps(-F32_MAX);
+    const __m128 maxValue = _mm_set1_ps(F32_MAX);
+    size_t i = 0;
+    for (; i + SSE_HALF_STEP <= count; i += SSE_HALF_STEP) {
+        _mm_storeu_ps(dst + i, _mm_max_ps(_mm_min_ps(_mm_loadu_ps(acc + i), maxValue), minValue));
+    }
+    StoreF32Scalar(acc + i, dst + i, count - i);
+}
+
+const MixKernel SSE2_KERNEL = {
+    "sse2",
+    AccumulateS16Sse2, AccumulateS32Sse2, AccumulateF32Sse2,
+    StoreS16Sse2, StoreS32Sse2, StoreF32Sse2
+};
+
+static constexpr size_t AVX_STEP = 8; // one __m256 per loop
+
+__attribute__((target("avx2"))) void AccumulateS16Avx2(const int16_t *src, float *acc, size_t count, float gain)
+{
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m256 value = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(in));
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(value, gainVec)));
+    }
+    AccumulateS16Scalar(src + i, acc + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void AccumulateS32Avx2(const int32_t *src, float *acc, size_t count, float gain)
+{
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m256 value = _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)));
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(value, gainVec)));
+    }
+    AccumulateS32Scalar(src + i, acc + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void AccumulateF32Avx2(const float *src, float *acc, size_t count, float gain)
+{
+    const __m256 gainVec = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        _mm256_storeu_ps(acc + i,
+            _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), gainVec)));
+    }
+    AccumulateF32Scalar(src + i, acc + i, count - i, gain);
+}
+
+__attribute__((target("avx2"))) void StoreS16Avx2(const float *acc, int16_t *dst, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(S16_SCALE);
+    const __m256 minValue = _mm256_set1_ps(-S16_SCALE);
+    const __m256 maxValue = _mm256_set1_ps(S16_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m256 value = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(acc + i), scale), maxValue),
+            minValue);
+        __m256i value32 = _mm256_cvttps_epi32(value);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+            _mm_packs_epi32(_mm256_castsi256_si128(value32), _mm256_extracti128_si256(value32, 1)));
+    }
+    StoreS16Scalar(acc + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) void StoreS32Avx2(const float *acc, int32_t *dst, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(S32_SCALE);
+    const __m256 minValue = _mm256_set1_ps(-S32_SCALE);
+    const __m256 maxValue = _mm256_set1_ps(S32_MAX_FLOAT);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        __m256 value = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(acc + i), scale), maxValue),
+            minValue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvttps_epi32(value));
+    }
+    StoreS32Scalar(acc + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2"))) void StoreF32Avx2(const float *acc, float *dst, size_t count)
+{
+    const __m256 minValue = _mm256_set1_ps(-F32_MAX);
+    const __m256 maxValue = _mm256_set1_ps(F32_MAX);
+    size_t i = 0;
+    for (; i + AVX_STEP <= count; i += AVX_STEP) {
+        _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(acc + i), maxValue), minValue));
+    }
+    StoreF32Scalar(acc + i, dst + i, count - i);
+}
+
+const MixKernel AVX2_KERNEL = {
+    "avx2",
+    AccumulateS16Avx2, AccumulateS32Avx2, AccumulateF32Avx2,
+    StoreS16Avx2, StoreS32Avx2, StoreF32Avx2
+};
+#endif // MIX_TOOLS_X86
+
+const MixKernel &SelectKernel()
+{
+#if defined(MIX_TOOLS_NEON)
+    return NEON_KERNEL;
+#elif defined(MIX_TOOLS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return AVX2_KERNEL;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SSE2_KERNEL;
+    }
+    return SCALAR_KERNEL;
+#else
+    return SCALAR_KERNEL;
+#endif
+}
+
+// Selected once, the function pointers are then used by every mix call.
+const MixKernel &GetKernel()
+{
+    static const MixKernel &kernel = SelectKernel();
+    return kernel;
+}
+
+// Normalized gain of the fused accumulate kernels, vol is in [0, 1].
+float GetSampleGain(AudioSampleFormat format, float vol)
+{
+    switch (format) {
+        case SAMPLE_S16LE:
+            return vol / S16_SCALE;
+        case SAMPLE_S32LE:
+            return vol / S32_SCALE;
+        default:
+            return vol;
+    }
+}
+
+// S16, S32 and F32 sources with the destination channels and a constant volume are accumulated in one pass.
+bool CanAccumulateVector(const AudioStreamData &srcData, size_t dstChannels)
+{
+    AudioSampleFormat format = srcData.streamInfo.format;
+    return static_cast<size_t>(srcData.streamInfo.channels) == dstChannels &&
+        srcData.volumeStart == srcData.volumeEnd &&
+        (format == SAMPLE_S16LE || format == SAMPLE_S32LE || format == SAMPLE_F32LE);
+}
+
+bool IsSameConfig(const FormatConvertConfig &lhs, const FormatConvertConfig &rhs)
+{
+    return lhs.srcFormat == rhs.srcFormat && lhs.dstFormat == rhs.dstFormat && lhs.srcChannels == rhs.srcChannels &&
+        lhs.dstChannels == rhs.dstChannels && lhs.isSrcPlanar == rhs.isSrcPlanar &&
+        lhs.isDstPlanar == rhs.isDstPlanar && lhs.srcChannelLayout == rhs.srcChannelLayout &&
+        lhs.dstChannelLayout == rhs.dstChannelLayout;
+}
+
+// Ramps, S24 and channel mapping go through the FormatConverter, one block of frames at a time.
+void AccumulateConverted(const AudioStreamData &srcData, const AudioStreamInfo &dstInfo, float *acc,
+    size_t frameCount, float gainStart, float gainEnd, MixConverters &converters)
+{
+    size_t dstChannels = static_cast<size_t>(dstInfo.channels);
+    FormatConvertConfig config = {srcData.streamInfo.format, SAMPLE_F32LE,
+        static_cast<uint32_t>(srcData.streamInfo.channels), static_cast<uint32_t>(dstChannels), false, false};
+    config.srcChannelLayout = srcData.streamInfo.channelLayout;
+    config.dstChannelLayout = dstInfo.channelLayout;
+    const FormatConverter *converter = converters.Get(config);
+    CHECK_AND_RETURN_LOG(converter != nullptr, "no converter for format %{public}d", config.srcFormat);
+
+    float block[MIX_BLOCK_FRAMES * CHANNEL_MAX];
+    size_t srcFrameSize = FormatConverter::GetSampleSize(config.srcFormat) * config.srcChannels;
+    float gainStep = frameCount > 1 ? (gainEnd - gainStart) / static_cast<float>(frameCount - 1) : 0.0f;
+    for (size_t done = 0; done < frameCount;) {
+        size_t count = std::min(frameCount - done, MIX_BLOCK_FRAMES);
+        BufferDesc srcDesc = {srcData.bufferDesc.buffer + done * srcFrameSize, count * srcFrameSize,
+            count * srcFrameSize};
+        BufferDesc blockDesc = {reinterpret_cast<uint8_t *>(block), sizeof(block), sizeof(block)};
+        int32_t ret = converter->Process(srcDesc, blockDesc);
+        CHECK_AND_RETURN_LOG(ret == SUCCESS, "convert failed: %{public}d", ret);
+        float *accBlock = acc + done * dstChannels;
+        for (size_t frame = 0; frame < count; frame++) {
+            float gain = gainStart + gainStep * static_cast<float>(done + frame);
+            for (size_t ch = 0; ch < dstChannels; ch++) {
+                accBlock[frame * dstChannels + ch] += block[frame * dstChannels + ch] * gain;
+            }
+        }
+        done += count;
+    }
+}
+
+void AccumulateVector(const MixKernel &kernel, const AudioStreamData &srcData, float *acc, size_t count, float gain)
+{
+    const uint8_t *src = srcData.bufferDesc.buffer;
+    switch (srcData.streamInfo.format) {
+        case SAMPLE_S16LE:
+            kernel.accumulateS16(reinterpret_cast<const int16_t *>(src), acc, count, gain);
+            break;
+        case SAMPLE_S32LE:
+            kernel.accumulateS32(reinterpret_cast<const int32_t *>(src), acc, count, gain);
+            break;
+        default:
+            kernel.accumulateF32(reinterpret_cast<const float *>(src), acc, count, gain);
+            break;
+    }
+}
+
+void StoreMixed(const MixKernel &kernel, const float *acc, const AudioStreamData &dstData, size_t count)
+{
+    uint8_t *dst = dstData.bufferDesc.buffer;
+    switch (dstData.streamInfo.format) {
+        case SAMPLE_S16LE:
+            kernel.storeS16(acc, reinterpret_cast<int16_t *>(dst), count);
+            break;
+        case SAMPLE_S32LE:
+            kernel.storeS32(acc, reinterpret_cast<int32_t *>(dst), count);
+            break;
+        case SAMPLE_F32LE:
+            kernel.storeF32(acc, reinterpret_cast<float *>(dst), count);
+            break;
+        default:
+            FormatConverter::FromFloat(SAMPLE_S24LE, acc, dst, count);
+            break;
+    }
+}
+} // namespace
+
+const FormatConverter *MixConverters::Get(const FormatConvertConfig &config)
+{
+    for (size_t i = 0; i < count_; i++) {
+        if (IsSameConfig(entries_[i].config, config)) {
+            return &entries_[i].converter;
+        }
+    }
+    size_t index = count_ < MAX_CONVERTERS ? count_ : next_;
+    int32_t ret = entries_[index].converter.Init(config);
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, nullptr, "init converter failed: %{public}d", ret);
+    entries_[index].config = config;
+    if (count_ < MAX_CONVERTERS) {
+        count_++;
+    } else {
+        next_ = (next_ + 1) % MAX_CONVERTERS;
+    }
+    return &entries_[index].converter;
+}
+
+bool MixTools::IsFormatSupported(AudioSampleFormat format)
+{
+    return format != SAMPLE_U8 && FormatConverter::IsFormatSupported(format);
+}
+
+bool MixTools::IsStreamInfoSupported(const AudioStreamInfo &streamInfo)
+{
+    return IsFormatSupported(streamInfo.format) && streamInfo.channels >= MONO &&
+        static_cast<size_t>(streamInfo.channels) <= CHANNEL_MAX;
+}
+
+const char *MixTools::GetKernelName()
+{
+    return GetKernel().name;
+}
+
+int32_t MixTools::Mix(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData,
+    std::vector<float> &mixBuffer, MixConverters &converters)
+{
+    CHECK_AND_RETURN_RET_LOG(IsStreamInfoSupported(dstData.streamInfo) && dstData.bufferDesc.buffer != nullptr,
+        ERR_INVALID_PARAM, "Mix failed, dst format %{public}d channels %{public}d not supported",
+        dstData.streamInfo.format, dstData.streamInfo.channels);
+    size_t dstChannels = static_cast<size_t>(dstData.streamInfo.channels);
+    size_t frameCount = dstData.bufferDesc.dataLength /
+        (FormatConverter::GetSampleSize(dstData.streamInfo.format) * dstChannels);
+    size_t sampleCount = frameCount * dstChannels;
+    CHECK_AND_RETURN_RET_LOG(mixBuffer.size() >= sampleCount, ERR_INVALID_PARAM,
+        "mix buffer of %{public}zu samples is less than %{public}zu", mixBuffer.size(), sampleCount);
+    float *acc = mixBuffer.data();
+    std::fill(acc, acc + sampleCount, 0.0f);
+
+    const MixKernel &kernel = GetKernel();
+    for (const AudioStreamData &srcData : srcDataList) {
+        CHECK_AND_CONTINUE_LOG(IsStreamInfoSupported(srcData.streamInfo) && srcData.bufferDesc.buffer != nullptr,
+            "Skip src with format %{public}d channels %{public}d", srcData.streamInfo.format,
+            srcData.streamInfo.channels);
+        size_t srcChannels = static_cast<size_t>(srcData.streamInfo.channels);
+        size_t srcFrameCount = srcData.bufferDesc.dataLength /
+            (FormatConverter::GetSampleSize(srcData.streamInfo.format) * srcChannels);
+        CHECK_AND_CONTINUE_LOG(srcFrameCount == frameCount, "Skip src with %{public}zu frames, dst has %{public}zu",
+            srcFrameCount, frameCount);
+        if (srcData.volumeStart == 0 && srcData.volumeEnd == 0) {
+            continue;
+        }
+        float volumeStart = static_cast<float>(srcData.volumeStart) / INT32_VOLUME_MAX;
+        float volumeEnd = static_cast<float>(srcData.volumeEnd) / INT32_VOLUME_MAX;
+        if (CanAccumulateVector(srcData, dstChannels)) {
+            AccumulateVector(kernel, srcData, acc, sampleCount, GetSampleGain(srcData.streamInfo.format, volumeStart));
+        } else {
+            AccumulateConverted(srcData, dstData.streamInfo, acc, frameCount, volumeStart, volumeEnd, converters);
+        }
+    }
+
+    StoreMixed(kernel, acc, dstData, sampleCount);
+    return SUCCESS;
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -283,6 +283,7 @@ int32_t OHAudioBuffer::Init(int dataFd, int infoFd)
         basicBufferInfo_->spanSizeInFrame = spanSizeInFrame_;
         basicBufferInfo_->byteSizePerFrame = byteSizePerFrame_;
         basicBufferInfo_->streamStatus.store(STREAM_INVALID);
+        basicBufferInfo_->needPositionUpdate.store(true);
 
         for (uint32_t i = 0; i < spanConut_; i++) {
             spanInfoList_[i].spanStatus.store(SPAN_INVALID);
@@ -514,6 +515,18 @@ void OHAudioBuffer::SetHandleInfo(uint64_t frames, int64_t nanoTime)
     basicBufferInfo_->handleTime.store(nanoTime);
 }
 
+bool OHAudioBuffer::IsPositionUpdateNeeded()
+{
+    CHECK_AND_RETURN_RET_LOG(basicBufferInfo_ != nullptr, true, "buffer is not inited!");
+    return basicBufferInfo_->needPositionUpdate.load();
+}
+
+void OHAudioBuffer::SetPositionUpdateNeeded(bool needed)
+{
+    CHECK_AND_RETURN_LOG(basicBufferInfo_ != nullptr, "buffer is not inited!");
+    basicBufferInfo_->needPositionUpdate.store(needed);
+}
+
 int32_t OHAudioBuffer::GetAvailableDataFrames()
 {
     int32_t result = -1; // failed
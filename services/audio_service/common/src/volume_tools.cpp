@@ -16,8 +16,17 @@
 #define LOG_TAG "VolumeTools"
 #endif
 
+#include <algorithm>
 #include <cmath>
 
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define VOLUME_TOOLS_NEON
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VOLUME_TOOLS_X86
+#endif
+
 #include "volume_tools.h"
 #include "volume_tools_c.h"
 #include "audio_errors.h"
@@ -144,310 +153,741 @@ inline int32_t VolumeFlatten(int32_t vol)
     return vol < INT32_VOLUME_MIN ? 0 : (vol > INT32_VOLUME_MAX ? INT32_VOLUME_MAX : vol);
 }
 
-void ProcessOneFrame(uint8_t *ptr, AudioSampleFormat format, int32_t vol)
+namespace {
+// Per format sample access, the scalar templates below are instantiated once for each format so that the format
+// switch is done once per call instead of once per sample.
+struct U8Sample {
+    using SumType = int64_t;
+    static constexpr size_t SIZE = 1;
+    static inline void Scale(uint8_t *ptr, int32_t vol)
+    {
+        int64_t temp = ((static_cast<int64_t>(*ptr) - UINT8_SHIFT) * vol) >> VOLUME_SHIFT;
+        temp = temp < INT8_MIN ? INT8_MIN : (temp > INT8_MAX ? INT8_MAX : temp);
+        *ptr = static_cast<uint8_t>(temp + UINT8_SHIFT);
+    }
+    static inline SumType Abs(const uint8_t *ptr)
+    {
+        return *ptr >= UINT8_SHIFT ? *ptr - UINT8_SHIFT : UINT8_SHIFT - *ptr;
+    }
+};
+
+struct S16Sample {
+    using SumType = int64_t;
+    static constexpr size_t SIZE = sizeof(int16_t);
+    static inline void Scale(uint8_t *ptr, int32_t vol)
+    {
+        int16_t *raw16 = reinterpret_cast<int16_t *>(ptr);
+        int64_t temp = (*raw16 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT;
+        *raw16 = temp > INT16_MAX ? INT16_MAX : (temp < INT16_MIN ? INT16_MIN : temp);
+    }
+    static inline SumType Abs(const uint8_t *ptr)
+    {
+        int64_t sample = *reinterpret_cast<const int16_t *>(ptr);
+        return sample >= 0 ? sample : -sample;
+    }
+};
+
+struct S24Sample {
+    using SumType = int64_t;
+    static constexpr size_t SIZE = 3; // 3 bytes for 24bit
+    static inline int32_t Read(const uint8_t *ptr)
+    {
+        // shift to the high bytes and back to keep the sign
+        return static_cast<int32_t>(ReadInt24LE(ptr) << INT24_SHIFT) >> INT24_SHIFT;
+    }
+    static inline void Scale(uint8_t *ptr, int32_t vol)
+    {
+        int64_t temp = static_cast<int32_t>(ReadInt24LE(ptr) << INT24_SHIFT) * static_cast<int64_t>(vol) >>
+            VOLUME_SHIFT;
+        WriteInt24LE(ptr, (static_cast<uint32_t>(temp) >> INT24_SHIFT));
+    }
+    static inline SumType Abs(const uint8_t *ptr)
+    {
+        int64_t sample = Read(ptr);
+        return sample >= 0 ? sample : -sample;
+    }
+};
+
+struct S32Sample {
+    using SumType = int64_t;
+    static constexpr size_t SIZE = sizeof(int32_t);
+    static inline void Scale(uint8_t *ptr, int32_t vol)
+    {
+        int32_t *raw32 = reinterpret_cast<int32_t *>(ptr);
+        // int32_t * int16_t, max result is int48_t
+        int64_t temp = (*raw32 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT;
+        *raw32 = temp > INT32_MAX ? INT32_MAX : (temp < INT32_MIN ? INT32_MIN : temp);
+    }
+    static inline SumType Abs(const uint8_t *ptr)
+    {
+        int64_t sample = *reinterpret_cast<const int32_t *>(ptr);
+        return sample >= 0 ? sample : -sample;
+    }
+};
+
+struct F32Sample {
+    using SumType = double;
+    static constexpr size_t SIZE = sizeof(float);
+    static inline void Scale(uint8_t *ptr, int32_t vol)
+    {
+        float *rawFloat = reinterpret_cast<float *>(ptr);
+        *rawFloat = *rawFloat * (static_cast<float>(vol) / INT32_VOLUME_MAX);
+    }
+    static inline SumType Abs(const uint8_t *ptr)
+    {
+        float sample = *reinterpret_cast<const float *>(ptr);
+        return sample >= 0 ? sample : -sample;
+    }
+};
+
+static constexpr int64_t VOLUME_ROUND_HALF = 1 << (VOLUME_SHIFT - 1);
+static constexpr int64_t HALF = 2;
+
+// Linear ramp of each channel in 16.16 fixed point, it is advanced frame by frame so that a buffer can be processed
+// in several blocks.
+struct VolumeRamp {
+    size_t channel = 0;
+    bool isConstant = true; // same volume on all channels and all frames
+    int32_t constVol = INT32_VOLUME_MAX;
+    int64_t vol[CHANNEL_MAX] = {};
+    int64_t step[CHANNEL_MAX] = {};
+};
+
+VolumeRamp InitVolumeRamp(const ChannelVolumes &vols, size_t frameSize)
 {
-    int64_t temp = 0;
-    int16_t *raw16 = nullptr;
-    int32_t *raw32 = nullptr;
-    float *rawFloat = nullptr;
-    switch (format) {
-        case SAMPLE_U8:
-            temp = *ptr - UINT8_SHIFT;
-            temp = (temp * vol) >> VOLUME_SHIFT;
-            temp = temp < INT8_MIN ? INT8_MIN : (temp > INT8_MAX ? INT8_MAX : temp);
-            *ptr = static_cast<uint8_t>(temp + UINT8_SHIFT);
-            break;
-        case SAMPLE_S16LE:
-            raw16 = reinterpret_cast<int16_t *>(ptr);
-            temp = (*raw16 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT;
-            *raw16 = temp > INT16_MAX ? INT16_MAX : (temp < INT16_MIN ? INT16_MIN : temp);
-            break;
-        case SAMPLE_S24LE:
-            temp = static_cast<int32_t>(ReadInt24LE(ptr) << INT24_SHIFT) * static_cast<int64_t>(vol) >> VOLUME_SHIFT;
-            WriteInt24LE(ptr, (static_cast<uint32_t>(temp) >> INT24_SHIFT));
-            break;
-        case SAMPLE_S32LE:
-            raw32 = reinterpret_cast<int32_t *>(ptr);
-            // int32_t * int16_t, max result is int48_t
-            temp = (*raw32 * static_cast<int64_t>(vol)) >> VOLUME_SHIFT;
-            *raw32 = temp > INT32_MAX ? INT32_MAX : (temp < INT32_MIN ? INT32_MIN : temp);
-            break;
-        case SAMPLE_F32LE:
-            rawFloat = reinterpret_cast<float *>(ptr);
-            *rawFloat = *rawFloat * (static_cast<float>(vol) / INT32_VOLUME_MAX);
-            break;
-        default:
-            AUDIO_ERR_LOG("ProcessOneFrame with invalid format");
-            break;
+    VolumeRamp ramp;
+    ramp.channel = vols.channel;
+    ramp.constVol = vols.volStart[0];
+    for (size_t channelIdx = 0; channelIdx < ramp.channel; channelIdx++) {
+        int32_t volStart = vols.volStart[channelIdx];
+        int32_t volEnd = vols.volEnd[channelIdx];
+        if (volStart != ramp.constVol || volEnd != ramp.constVol) {
+            ramp.isConstant = false;
+        }
+        // rounded to nearest, so that the first frame gets volStart and the last frame gets volEnd
+        int64_t stepCount = static_cast<int64_t>(frameSize - MIN_FRAME_SIZE);
+        int64_t delta = static_cast<int64_t>(volEnd - volStart) << VOLUME_SHIFT;
+        ramp.vol[channelIdx] = (static_cast<int64_t>(volStart) << VOLUME_SHIFT) + VOLUME_ROUND_HALF;
+        ramp.step[channelIdx] = (delta + (delta >= 0 ? stepCount / HALF : -stepCount / HALF)) / stepCount;
     }
+    return ramp;
 }
 
-// |---------frame1--------|---------frame2--------|---------frame3--------|
-// |ch1-ch2-ch3-ch4-ch5-ch6|ch1-ch2-ch3-ch4-ch5-ch6|ch1-ch2-ch3-ch4-ch5-ch6|
-int32_t VolumeTools::Process(const BufferDesc &buffer, AudioSampleFormat format, ChannelVolumes vols)
+template <typename Sample>
+void ScaleConstantScalar(uint8_t *data, size_t sampleCount, int32_t vol)
 {
-    // parms check
-    if (format > SAMPLE_F32LE || !IsVolumeValid(vols)) {
-        AUDIO_ERR_LOG("Process failed with invalid params");
-        return ERR_INVALID_PARAM;
+    for (size_t i = 0; i < sampleCount; i++) {
+        Sample::Scale(data + i * Sample::SIZE, vol);
     }
-    size_t byteSizePerData = GetByteSize(format);
-    size_t byteSizePerFrame = byteSizePerData * vols.channel;
-    if (buffer.buffer == nullptr || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("Process failed with invalid buffer, size is %{public}zu", buffer.bufLength);
-        return ERR_INVALID_PARAM;
+}
+
+template <typename Sample>
+void ScaleRampScalar(uint8_t *data, size_t frameCount, VolumeRamp &ramp)
+{
+    size_t channel = ramp.channel;
+    for (size_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+            int32_t vol = VolumeFlatten(static_cast<int32_t>(ramp.vol[channelIdx] >> VOLUME_SHIFT));
+            Sample::Scale(data, vol);
+            ramp.vol[channelIdx] += ramp.step[channelIdx];
+            data += Sample::SIZE;
+        }
     }
+}
 
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE) {
-        AUDIO_ERR_LOG("Process failed with invalid frameSize, size is %{public}zu", frameSize);
-        return ERR_INVALID_PARAM;
+template <typename Sample>
+void SumAbsScalar(const uint8_t *data, size_t frameCount, size_t channel, typename Sample::SumType *sums)
+{
+    for (size_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
+            sums[channelIdx] += Sample::Abs(data);
+            data += Sample::SIZE;
+        }
+    }
+}
+
+// The sum kernels add |sample i| into lanes[i % LEVEL_LANE_COUNT]. As the channel count divides LEVEL_LANE_COUNT for
+// the common layouts, each lane then holds a single channel.
+static constexpr size_t LEVEL_LANE_COUNT = 16;
+// 32 bit lane sums are flushed before they can overflow, 65535 * 32768 < UINT32_MAX.
+static constexpr size_t LEVEL_FLUSH_BLOCKS = 65535;
+// float lane sums are flushed often to keep the precision.
+static constexpr size_t LEVEL_FLUSH_FLOAT_BLOCKS = 256;
+// frames processed and counted at a time by the block wise passes
+static constexpr size_t LEVEL_BLOCK_FRAMES = 256;
+
+using ScaleS16Func = void (*)(int16_t *data, size_t count, int32_t vol);
+using ScaleS32Func = void (*)(int32_t *data, size_t count, int32_t vol);
+using ScaleF32Func = void (*)(float *data, size_t count, int32_t vol);
+using SumAbsS16Func = void (*)(const int16_t *data, size_t count, int64_t *lanes);
+using SumAbsS32Func = void (*)(const int32_t *data, size_t count, int64_t *lanes);
+using SumAbsF32Func = void (*)(const float *data, size_t count, double *lanes);
+
+struct VolumeKernel {
+    const char *name;
+    ScaleS16Func scaleS16;
+    ScaleS32Func scaleS32;
+    ScaleF32Func scaleF32;
+    SumAbsS16Func sumAbsS16;
+    SumAbsS32Func sumAbsS32;
+    SumAbsF32Func sumAbsF32;
+};
+
+void ScaleS16Scalar(int16_t *data, size_t count, int32_t vol)
+{
+    ScaleConstantScalar<S16Sample>(reinterpret_cast<uint8_t *>(data), count, vol);
+}
+
+void ScaleS32Scalar(int32_t *data, size_t count, int32_t vol)
+{
+    ScaleConstantScalar<S32Sample>(reinterpret_cast<uint8_t *>(data), count, vol);
+}
+
+void ScaleF32Scalar(float *data, size_t count, int32_t vol)
+{
+    ScaleConstantScalar<F32Sample>(reinterpret_cast<uint8_t *>(data), count, vol);
+}
+
+template <typename T, typename SumType>
+void SumAbsLanesScalar(const T *data, size_t count, SumType *lanes)
+{
+    for (size_t i = 0; i < count; i++) {
+        SumType sample = data[i];
+        lanes[i % LEVEL_LANE_COUNT] += sample >= 0 ? sample : -sample;
+    }
+}
+
+void SumAbsS16Scalar(const int16_t *data, size_t count, int64_t *lanes)
+{
+    SumAbsLanesScalar(data, count, lanes);
+}
+
+void SumAbsS32Scalar(const int32_t *data, size_t count, int64_t *lanes)
+{
+    SumAbsLanesScalar(data, count, lanes);
+}
+
+void SumAbsF32Scalar(const float *data, size_t count, double *lanes)
+{
+    SumAbsLanesScalar(data, count, lanes);
+}
+
+const VolumeKernel SCALAR_KERNEL = {
+    "scalar",
+    ScaleS16Scalar, ScaleS32Scalar, ScaleF32Scalar,
+    SumAbsS16Scalar, SumAbsS32Scalar, SumAbsF32Scalar
+};
+
+#ifdef VOLUME_TOOLS_NEON
+static constexpr size_t NEON_S16_STEP = 8;
+static constexpr size_t NEON_S32_STEP = 4;
+static constexpr size_t NEON_F32_STEP = 4;
+static constexpr size_t NEON_LANE_GROUP = 4; // uint32x4_t, float32x4_t
+static constexpr size_t NEON_LANE_PAIR = 2; // uint64x2_t
+
+void ScaleS16Neon(int16_t *data, size_t count, int32_t vol)
+{
+    size_t i = 0;
+    // |sample * vol| <= 1 << 31, the product fits in int32 as vol <= 1 << 16
+    for (; i + NEON_S16_STEP <= count; i += NEON_S16_STEP) {
+        int16x8_t in = vld1q_s16(data + i);
+        int32x4_t lo = vmulq_n_s32(vmovl_s16(vget_low_s16(in)), vol);
+        int32x4_t hi = vmulq_n_s32(vmovl_s16(vget_high_s16(in)), vol);
+        vst1q_s16(data + i, vcombine_s16(vqshrn_n_s32(lo, VOLUME_SHIFT), vqshrn_n_s32(hi, VOLUME_SHIFT)));
+    }
+    ScaleS16Scalar(data + i, count - i, vol);
+}
+
+void ScaleS32Neon(int32_t *data, size_t count, int32_t vol)
+{
+    size_t i = 0;
+    const int32x2_t volVec = vdup_n_s32(vol);
+    for (; i + NEON_S32_STEP <= count; i += NEON_S32_STEP) {
+        int32x4_t in = vld1q_s32(data + i);
+        int64x2_t lo = vmull_s32(vget_low_s32(in), volVec);
+        int64x2_t hi = vmull_s32(vget_high_s32(in), volVec);
+        vst1q_s32(data + i, vcombine_s32(vqshrn_n_s64(lo, VOLUME_SHIFT), vqshrn_n_s64(hi, VOLUME_SHIFT)));
+    }
+    ScaleS32Scalar(data + i, count - i, vol);
+}
+
+void ScaleF32Neon(float *data, size_t count, int32_t vol)
+{
+    size_t i = 0;
+    const float gain = static_cast<float>(vol) / INT32_VOLUME_MAX;
+    for (; i + NEON_F32_STEP <= count; i += NEON_F32_STEP) {
+        vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), gain));
+    }
+    ScaleF32Scalar(data + i, count - i, vol);
+}
+
+void SumAbsS16Neon(const int16_t *data, size_t count, int64_t *lanes)
+{
+    size_t i = 0;
+    while (i + LEVEL_LANE_COUNT <= count) {
+        uint32x4_t acc[LEVEL_LANE_COUNT / NEON_LANE_GROUP] = {vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0),
+            vdupq_n_u32(0)};
+        for (size_t block = 0; block < LEVEL_FLUSH_BLOCKS && i + LEVEL_LANE_COUNT <= count; block++) {
+            // vabsq_s16(INT16_MIN) stays 0x8000, which is 32768 as unsigned
+            uint16x8_t lo = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(data + i)));
+            uint16x8_t hi = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(data + i + NEON_S16_STEP)));
+            acc[0] = vaddw_u16(acc[0], vget_low_u16(lo));
+            acc[1] = vaddw_u16(acc[1], vget_high_u16(lo));
+            acc[2] = vaddw_u16(acc[2], vget_low_u16(hi)); // 2 for lanes 8~11
+            acc[3] = vaddw_u16(acc[3], vget_high_u16(hi)); // 3 for lanes 12~15
+            i += LEVEL_LANE_COUNT;
+        }
+        uint32_t sums[LEVEL_LANE_COUNT];
+        for (size_t group = 0; group < LEVEL_LANE_COUNT / NEON_LANE_GROUP; group++) {
+            vst1q_u32(sums + group * NEON_LANE_GROUP, acc[group]);
+        }
+        for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+            lanes[lane] += sums[lane];
+        }
     }
+    SumAbsS16Scalar(data + i, count - i, lanes);
+}
 
-    float volStep[CHANNEL_MAX] = {};
-    for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
-        if (vols.volEnd[channelIdx] == vols.volStart[channelIdx]) {
-            volStep[channelIdx] = 0.0;
-        } else {
-            volStep[channelIdx] = (static_cast<float>(vols.volEnd[channelIdx] - vols.volStart[channelIdx])) /
-                (frameSize - MIN_FRAME_SIZE);
+void SumAbsS32Neon(const int32_t *data, size_t count, int64_t *lanes)
+{
+    size_t i = 0;
+    uint64x2_t acc[LEVEL_LANE_COUNT / NEON_LANE_PAIR];
+    for (size_t pair = 0; pair < LEVEL_LANE_COUNT / NEON_LANE_PAIR; pair++) {
+        acc[pair] = vdupq_n_u64(0);
+    }
+    for (; i + LEVEL_LANE_COUNT <= count; i += LEVEL_LANE_COUNT) {
+        for (size_t group = 0; group < LEVEL_LANE_COUNT / NEON_LANE_GROUP; group++) {
+            // vabsq_s32(INT32_MIN) stays 0x80000000, which is 1 << 31 as unsigned
+            uint32x4_t in = vreinterpretq_u32_s32(vabsq_s32(vld1q_s32(data + i + group * NEON_LANE_GROUP)));
+            acc[group * NEON_LANE_PAIR] = vaddw_u32(acc[group * NEON_LANE_PAIR], vget_low_u32(in));
+            acc[group * NEON_LANE_PAIR + 1] = vaddw_u32(acc[group * NEON_LANE_PAIR + 1], vget_high_u32(in));
         }
     }
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < vols.channel; channelIdx++) {
-            int32_t vol = volStep[channelIdx] * frameIndex + vols.volStart[channelIdx];
-            vol = VolumeFlatten(vol);
-            uint8_t *samplePtr = buffer.buffer + frameIndex * byteSizePerFrame + channelIdx * byteSizePerData;
-            ProcessOneFrame(samplePtr, format, vol);
+    uint64_t sums[LEVEL_LANE_COUNT];
+    for (size_t pair = 0; pair < LEVEL_LANE_COUNT / NEON_LANE_PAIR; pair++) {
+        vst1q_u64(sums + pair * NEON_LANE_PAIR, acc[pair]);
+    }
+    for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+        lanes[lane] += static_cast<int64_t>(sums[lane]);
+    }
+    SumAbsS32Scalar(data + i, count - i, lanes);
+}
+
+void SumAbsF32Neon(const float *data, size_t count, double *lanes)
+{
+    size_t i = 0;
+    while (i + LEVEL_LANE_COUNT <= count) {
+        float32x4_t acc[LEVEL_LANE_COUNT / NEON_LANE_GROUP] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f),
+            vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+        for (size_t block = 0; block < LEVEL_FLUSH_FLOAT_BLOCKS && i + LEVEL_LANE_COUNT <= count; block++) {
+            for (size_t group = 0; group < LEVEL_LANE_COUNT / NEON_LANE_GROUP; group++) {
+                acc[group] = vaddq_f32(acc[group], vabsq_f32(vld1q_f32(data + i + group * NEON_LANE_GROUP)));
+            }
+            i += LEVEL_LANE_COUNT;
+        }
+        float sums[LEVEL_LANE_COUNT];
+        for (size_t group = 0; group < LEVEL_LANE_COUNT / NEON_LANE_GROUP; group++) {
+            vst1q_f32(sums + group * NEON_LANE_GROUP, acc[group]);
+        }
+        for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+            lanes[lane] += sums[lane];
         }
     }
+    SumAbsF32Scalar(data + i, count - i, lanes);
+}
 
-    return SUCCESS;
+const VolumeKernel NEON_KERNEL = {
+    "neon",
+    ScaleS16Neon, ScaleS32Neon, ScaleF32Neon,
+    SumAbsS16Neon, SumAbsS32Neon, SumAbsF32Neon
+};
+#endif // VOLUME_TOOLS_NEON
+
+#ifdef VOLUME_TOOLS_X86
+static constexpr size_t AVX_S16_STEP = 16; // one __m256i per loop
+static constexpr size_t AVX_S32_STEP = 8;
+static constexpr size_t AVX_F32_STEP = 8;
+static constexpr int32_t AVX_ODD_LANES = 0xAA; // blend mask of lanes 1, 3, 5, 7
+static constexpr int32_t AVX_PACK_ORDER = 0xD8; // 0, 2, 1, 3 of 64 bit lanes, undo the per 128 bit packing
+static constexpr uint32_t AVX_HIGH_DWORD_SHIFT = 32;
+static constexpr size_t AVX_S64_STEP = 4; // 4 uint64 lanes in one __m256i
+
+__attribute__((target("avx2"))) void ScaleS16Avx2(int16_t *data, size_t count, int32_t vol)
+{
+    const __m256i volVec = _mm256_set1_epi32(vol);
+    size_t i = 0;
+    // |sample * vol| <= 1 << 31, the product fits in int32 as vol <= 1 << 16
+    for (; i + AVX_S16_STEP <= count; i += AVX_S16_STEP) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + AVX_S32_STEP));
+        __m256i loVal = _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_cvtepi16_epi32(lo), volVec), VOLUME_SHIFT);
+        __m256i hiVal = _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_cvtepi16_epi32(hi), volVec), VOLUME_SHIFT);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(loVal, hiVal), AVX_PACK_ORDER);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), packed);
+    }
+    ScaleS16Scalar(data + i, count - i, vol);
 }
 
-double VolumeTools::GetVolDb(AudioSampleFormat format, int32_t vol)
+__attribute__((target("avx2"))) void ScaleS32Avx2(int32_t *data, size_t count, int32_t vol)
 {
-    double volume = static_cast<double>(vol);
+    const __m256i volVec = _mm256_set1_epi32(vol);
+    size_t i = 0;
+    for (; i + AVX_S32_STEP <= count; i += AVX_S32_STEP) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        // even and odd lanes as 64 bit products, the low 32 bits of the shifted product are the result
+        __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(in, volVec), VOLUME_SHIFT);
+        __m256i odd = _mm256_srli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(in, AVX_HIGH_DWORD_SHIFT), volVec),
+            VOLUME_SHIFT);
+        __m256i out = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, AVX_HIGH_DWORD_SHIFT), AVX_ODD_LANES);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), out);
+    }
+    ScaleS32Scalar(data + i, count - i, vol);
+}
+
+__attribute__((target("avx2"))) void ScaleF32Avx2(float *data, size_t count, int32_t vol)
+{
+    const __m256 gainVec = _mm256_set1_ps(static_cast<float>(vol) / INT32_VOLUME_MAX);
+    size_t i = 0;
+    for (; i + AVX_F32_STEP <= count; i += AVX_F32_STEP) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), gainVec));
+    }
+    ScaleF32Scalar(data + i, count - i, vol);
+}
+
+__attribute__((target("avx2"))) void SumAbsS16Avx2(const int16_t *data, size_t count, int64_t *lanes)
+{
+    size_t i = 0;
+    while (i + LEVEL_LANE_COUNT <= count) {
+        __m256i accLo = _mm256_setzero_si256();
+        __m256i accHi = _mm256_setzero_si256();
+        for (size_t block = 0; block < LEVEL_FLUSH_BLOCKS && i + LEVEL_LANE_COUNT <= count; block++) {
+            // _mm256_abs_epi16(INT16_MIN) stays 0x8000, which is 32768 as unsigned
+            __m256i in = _mm256_abs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+            accLo = _mm256_add_epi32(accLo, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(in)));
+            accHi = _mm256_add_epi32(accHi, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(in, 1)));
+            i += LEVEL_LANE_COUNT;
+        }
+        uint32_t sums[LEVEL_LANE_COUNT];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), accLo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums + AVX_S32_STEP), accHi);
+        for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+            lanes[lane] += sums[lane];
+        }
+    }
+    SumAbsS16Scalar(data + i, count - i, lanes);
+}
+
+__attribute__((target("avx2"))) void SumAbsS32Avx2(const int32_t *data, size_t count, int64_t *lanes)
+{
+    __m256i acc[LEVEL_LANE_COUNT / AVX_S64_STEP] = {_mm256_setzero_si256(), _mm256_setzero_si256(),
+        _mm256_setzero_si256(), _mm256_setzero_si256()};
+    size_t i = 0;
+    for (; i + LEVEL_LANE_COUNT <= count; i += LEVEL_LANE_COUNT) {
+        // _mm256_abs_epi32(INT32_MIN) stays 0x80000000, which is 1 << 31 as unsigned
+        __m256i lo = _mm256_abs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+        __m256i hi = _mm256_abs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i +
+            AVX_S32_STEP)));
+        acc[0] = _mm256_add_epi64(acc[0], _mm256_cvtepu32_epi64(_mm256_castsi256_si128(lo)));
+        acc[1] = _mm256_add_epi64(acc[1], _mm256_cvtepu32_epi64(_mm256_extracti128_si256(lo, 1)));
+        acc[2] = _mm256_add_epi64(acc[2], _mm256_cvtepu32_epi64(_mm256_castsi256_si128(hi))); // 2 for lanes 8~11
+        acc[3] = _mm256_add_epi64(acc[3], _mm256_cvtepu32_epi64(_mm256_extracti128_si256(hi, 1))); // lanes 12~15
+    }
+    int64_t sums[LEVEL_LANE_COUNT];
+    for (size_t group = 0; group < LEVEL_LANE_COUNT / AVX_S64_STEP; group++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums + group * AVX_S64_STEP), acc[group]);
+    }
+    for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+        lanes[lane] += sums[lane];
+    }
+    SumAbsS32Scalar(data + i, count - i, lanes);
+}
+
+__attribute__((target("avx2"))) void SumAbsF32Avx2(const float *data, size_t count, double *lanes)
+{
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(INT32_MAX));
+    size_t i = 0;
+    while (i + LEVEL_LANE_COUNT <= count) {
+        __m256 accLo = _mm256_setzero_ps();
+        __m256 accHi = _mm256_setzero_ps();
+        for (size_t block = 0; block < LEVEL_FLUSH_FLOAT_BLOCKS && i + LEVEL_LANE_COUNT <= count; block++) {
+            accLo = _mm256_add_ps(accLo, _mm256_and_ps(_mm256_loadu_ps(data + i), absMask));
+            accHi = _mm256_add_ps(accHi, _mm256_and_ps(_mm256_loadu_ps(data + i + AVX_F32_STEP), absMask));
+            i += LEVEL_LANE_COUNT;
+        }
+        float sums[LEVEL_LANE_COUNT];
+        _mm256_storeu_ps(sums, accLo);
+        _mm256_storeu_ps(sums + AVX_F32_STEP, accHi);
+        for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+            lanes[lane] += sums[lane];
+        }
+    }
+    SumAbsF32Scalar(data + i, count - i, lanes);
+}
+
+const VolumeKernel AVX2_KERNEL = {
+    "avx2",
+    ScaleS16Avx2, ScaleS32Avx2, ScaleF32Avx2,
+    SumAbsS16Avx2, SumAbsS32Avx2, SumAbsF32Avx2
+};
+#endif // VOLUME_TOOLS_X86
+
+const VolumeKernel &SelectKernel()
+{
+#if defined(VOLUME_TOOLS_NEON)
+    return NEON_KERNEL;
+#elif defined(VOLUME_TOOLS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return AVX2_KERNEL;
+    }
+    return SCALAR_KERNEL;
+#else
+    return SCALAR_KERNEL;
+#endif
+}
+
+// Selected once, the function pointers are then used by every call.
+const VolumeKernel &GetKernel()
+{
+    static const VolumeKernel &kernel = SelectKernel();
+    return kernel;
+}
+
+void ScaleConstant(uint8_t *data, size_t sampleCount, AudioSampleFormat format, int32_t vol)
+{
+    const VolumeKernel &kernel = GetKernel();
     switch (format) {
         case SAMPLE_U8:
-            volume = volume / INT8_MAX;
+            ScaleConstantScalar<U8Sample>(data, sampleCount, vol);
             break;
         case SAMPLE_S16LE:
-            volume = volume / INT16_MAX;
+            kernel.scaleS16(reinterpret_cast<int16_t *>(data), sampleCount, vol);
             break;
         case SAMPLE_S24LE:
-            volume = volume / INT24_MAX_VALUE;
+            ScaleConstantScalar<S24Sample>(data, sampleCount, vol);
             break;
         case SAMPLE_S32LE:
-            volume = volume / INT32_MAX;
+            kernel.scaleS32(reinterpret_cast<int32_t *>(data), sampleCount, vol);
             break;
         case SAMPLE_F32LE:
-            volume = volume / INT32_MAX;
+            kernel.scaleF32(reinterpret_cast<float *>(data), sampleCount, vol);
             break;
         default:
             break;
     }
-    return std::log10(volume);
 }
 
-static void CountU8Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+void ScaleRamp(uint8_t *data, size_t frameCount, AudioSampleFormat format, VolumeRamp &ramp)
 {
-    size_t byteSizePerData = 1; // 1 for unsigned 8bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
-    }
-
-    // reset maps
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] = 0;
-        volMaps.volEnd[index] = 0;
-    }
-    uint8_t *raw8 = buffer.buffer;
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volMaps.volStart[channelIdx] += (*raw8 >= UINT8_SHIFT ? *raw8 - UINT8_SHIFT : UINT8_SHIFT - *raw8);
-            raw8++;
-        }
-    }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] /= static_cast<int32_t>(frameSize);
+    switch (format) {
+        case SAMPLE_U8:
+            ScaleRampScalar<U8Sample>(data, frameCount, ramp);
+            break;
+        case SAMPLE_S16LE:
+            ScaleRampScalar<S16Sample>(data, frameCount, ramp);
+            break;
+        case SAMPLE_S24LE:
+            ScaleRampScalar<S24Sample>(data, frameCount, ramp);
+            break;
+        case SAMPLE_S32LE:
+            ScaleRampScalar<S32Sample>(data, frameCount, ramp);
+            break;
+        case SAMPLE_F32LE:
+            ScaleRampScalar<F32Sample>(data, frameCount, ramp);
+            break;
+        default:
+            break;
     }
-    return;
 }
 
-static void CountS16Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+void ApplyVolume(uint8_t *data, size_t frameCount, AudioSampleFormat format, VolumeRamp &ramp)
 {
-    size_t byteSizePerData = 2; // 2 for signed 16bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
+    if (!ramp.isConstant) {
+        ScaleRamp(data, frameCount, format, ramp);
+    } else if (ramp.constVol != INT32_VOLUME_MAX) {
+        // unity volume keeps every sample unchanged
+        ScaleConstant(data, frameCount * ramp.channel, format, ramp.constVol);
     }
+}
 
-    // reset maps
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] = 0;
-        volMaps.volEnd[index] = 0;
-    }
-    int16_t *raw16 = reinterpret_cast<int16_t *>(buffer.buffer);
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volMaps.volStart[channelIdx] += (*raw16 >= 0 ? *raw16: (-*raw16));
-            raw16++;
-        }
-    }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] /= static_cast<int32_t>(frameSize);
+template <typename SumType>
+void FoldLanes(const SumType *lanes, size_t channel, SumType *sums)
+{
+    for (size_t lane = 0; lane < LEVEL_LANE_COUNT; lane++) {
+        sums[lane % channel] += lanes[lane];
     }
-    return;
 }
 
-static void CountS24Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+// Add |sample| of each channel into sums, which holds CHANNEL_MAX entries.
+void SumAbs(const uint8_t *data, size_t frameCount, AudioSampleFormat format, size_t channel, int64_t *sums,
+    double *floatSums)
 {
-    size_t byteSizePerData = 3; // 3 for 24bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
+    const VolumeKernel &kernel = GetKernel();
+    bool useLanes = LEVEL_LANE_COUNT % channel == 0;
+    size_t sampleCount = frameCount * channel;
+    int64_t lanes[LEVEL_LANE_COUNT] = {};
+    double floatLanes[LEVEL_LANE_COUNT] = {};
+    switch (format) {
+        case SAMPLE_U8:
+            SumAbsScalar<U8Sample>(data, frameCount, channel, sums);
+            break;
+        case SAMPLE_S16LE:
+            if (!useLanes) {
+                SumAbsScalar<S16Sample>(data, frameCount, channel, sums);
+                break;
+            }
+            kernel.sumAbsS16(reinterpret_cast<const int16_t *>(data), sampleCount, lanes);
+            FoldLanes(lanes, channel, sums);
+            break;
+        case SAMPLE_S24LE:
+            SumAbsScalar<S24Sample>(data, frameCount, channel, sums);
+            break;
+        case SAMPLE_S32LE:
+            if (!useLanes) {
+                SumAbsScalar<S32Sample>(data, frameCount, channel, sums);
+                break;
+            }
+            kernel.sumAbsS32(reinterpret_cast<const int32_t *>(data), sampleCount, lanes);
+            FoldLanes(lanes, channel, sums);
+            break;
+        case SAMPLE_F32LE:
+            if (!useLanes) {
+                SumAbsScalar<F32Sample>(data, frameCount, channel, floatSums);
+                break;
+            }
+            kernel.sumAbsF32(reinterpret_cast<const float *>(data), sampleCount, floatLanes);
+            FoldLanes(floatLanes, channel, floatSums);
+            break;
+        default:
+            break;
     }
+}
 
-    // reset maps
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] = 0;
-        volMaps.volEnd[index] = 0;
-    }
-    uint8_t *raw8 = buffer.buffer;
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            int32_t sample = static_cast<int32_t>(ReadInt24LE(raw8));
-            volMaps.volStart[channelIdx] += (sample >= 0 ? sample: (-sample));
-            raw8 += byteSizePerData;
-        }
-    }
+void SetVolumeLevel(AudioSampleFormat format, size_t frameSize, const int64_t *sums, const double *floatSums,
+    ChannelVolumes &volMaps)
+{
     // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volMaps.volStart[index] /= static_cast<int32_t>(frameSize);
+    for (size_t index = 0; index < volMaps.channel; index++) {
+        volMaps.volStart[index] = format == SAMPLE_F32LE ? static_cast<int32_t>(floatSums[index] / frameSize) :
+            static_cast<int32_t>(sums[index] / static_cast<int64_t>(frameSize));
+        volMaps.volEnd[index] = 0;
     }
-    return;
 }
 
-static void CountS32Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+// Returns the frame count, or 0 if the buffer can not be processed.
+size_t GetFrameSize(const BufferDesc &buffer, AudioSampleFormat format, size_t channel)
 {
-    size_t byteSizePerData = 4; // 4 for signed 32bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
+    size_t byteSizePerFrame = GetByteSize(format) * channel;
     if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
         AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
+        return 0;
     }
     size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
+    if (frameSize <= MIN_FRAME_SIZE) {
         AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
+        return 0;
     }
+    return frameSize;
+}
+} // namespace
 
-    // reset maps
-    int64_t volSums[CHANNEL_MAX] = {0};
-    for (size_t index = 0; index < CHANNEL_MAX; index++) {
-        volSums[index] = 0;
-    }
-    int32_t *raw32 = reinterpret_cast<int32_t *>(buffer.buffer);
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volSums[channelIdx] += (*raw32 >= 0 ? *raw32: (-*raw32));
-            raw32++;
-        }
-    }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volSums[index] /= static_cast<int32_t>(frameSize);
-        volMaps.volStart[index] = volSums[index];
-    }
-    return;
+const char *VolumeTools::GetKernelName()
+{
+    return GetKernel().name;
 }
 
-static void CountF32Volume(const BufferDesc &buffer, AudioChannel channel, ChannelVolumes &volMaps)
+// |---------frame1--------|---------frame2--------|---------frame3--------|
+// |ch1-ch2-ch3-ch4-ch5-ch6|ch1-ch2-ch3-ch4-ch5-ch6|ch1-ch2-ch3-ch4-ch5-ch6|
+int32_t VolumeTools::Process(const BufferDesc &buffer, AudioSampleFormat format, ChannelVolumes vols)
 {
-    size_t byteSizePerData = 4; // 4 for 32bit
-    size_t byteSizePerFrame = byteSizePerData * channel;
-    if (buffer.buffer == nullptr || byteSizePerFrame == 0 || buffer.bufLength % byteSizePerFrame != 0) {
-        AUDIO_ERR_LOG("invalid buffer, size is %{public}zu", buffer.bufLength);
-        return;
-    }
-    size_t frameSize = buffer.bufLength / byteSizePerFrame;
-    if (frameSize <= MIN_FRAME_SIZE || frameSize >= MAX_FRAME_SIZE) {
-        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
-        return;
+    // parms check
+    if (format > SAMPLE_F32LE || !IsVolumeValid(vols)) {
+        AUDIO_ERR_LOG("Process failed with invalid params");
+        return ERR_INVALID_PARAM;
     }
+    size_t frameSize = GetFrameSize(buffer, format, vols.channel);
+    CHECK_AND_RETURN_RET_LOG(frameSize != 0, ERR_INVALID_PARAM, "Process failed with invalid buffer");
 
-    // reset maps
-    double volSums[CHANNEL_MAX] = {0};
-    for (size_t index = 0; index < CHANNEL_MAX; index++) {
-        volSums[index] = 0.0;
-    }
-    float *raw32 = reinterpret_cast<float *>(buffer.buffer);
-    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex++) {
-        for (size_t channelIdx = 0; channelIdx < channel; channelIdx++) {
-            volSums[channelIdx] += (*raw32 >= 0 ? *raw32: (-*raw32));
-            raw32++;
-        }
-    }
-    // Calculate the average value
-    for (size_t index = 0; index < channel; index++) {
-        volSums[index] /= frameSize;
-        volMaps.volStart[index] = static_cast<int32_t>(volSums[index]);
-    }
-    return;
+    VolumeRamp ramp = InitVolumeRamp(vols, frameSize);
+    ApplyVolume(buffer.buffer, frameSize, format, ramp);
+    return SUCCESS;
 }
 
-ChannelVolumes VolumeTools::CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel)
+double VolumeTools::GetVolDb(AudioSampleFormat format, int32_t vol)
 {
-    ChannelVolumes channelVols = {};
-    channelVols.channel = channel;
-    if (format > SAMPLE_F32LE || channel > CHANNEL_16) {
-        AUDIO_ERR_LOG("failed with invalid params");
-        return channelVols;
-    }
+    double volume = static_cast<double>(vol);
     switch (format) {
         case SAMPLE_U8:
-            CountU8Volume(buffer, channel, channelVols);
+            volume = volume / INT8_MAX;
             break;
         case SAMPLE_S16LE:
-            CountS16Volume(buffer, channel, channelVols);
+            volume = volume / INT16_MAX;
             break;
         case SAMPLE_S24LE:
-            CountS24Volume(buffer, channel, channelVols);
+            volume = volume / INT24_MAX_VALUE;
             break;
         case SAMPLE_S32LE:
-            CountS32Volume(buffer, channel, channelVols);
+            volume = volume / INT32_MAX;
             break;
         case SAMPLE_F32LE:
-            CountF32Volume(buffer, channel, channelVols);
+            volume = volume / INT32_MAX;
             break;
         default:
             break;
     }
+    return std::log10(volume);
+}
+
+ChannelVolumes VolumeTools::CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel)
+{
+    ChannelVolumes channelVols = {};
+    channelVols.channel = channel;
+    if (format > SAMPLE_F32LE || channel > CHANNEL_16 || channel < MONO) {
+        AUDIO_ERR_LOG("failed with invalid params");
+        return channelVols;
+    }
+    size_t frameSize = GetFrameSize(buffer, format, channel);
+    if (frameSize == 0) {
+        return channelVols;
+    }
+    if (frameSize >= MAX_FRAME_SIZE) {
+        AUDIO_ERR_LOG("invalid frameSize, size is %{public}zu", frameSize);
+        return channelVols;
+    }
 
+    int64_t sums[CHANNEL_MAX] = {};
+    double floatSums[CHANNEL_MAX] = {};
+    SumAbs(buffer.buffer, frameSize, format, channel, sums, floatSums);
+    SetVolumeLevel(format, frameSize, sums, floatSums, channelVols);
     return channelVols;
 }
+
+int32_t VolumeTools::CountVolumeLevel(const BufferDesc &buffer, AudioSampleFormat format, AudioChannel channel,
+    const std::function<void(uint8_t *block, size_t len)> &preprocess, ChannelVolumes &volLevel)
+{
+    volLevel = {};
+    volLevel.channel = channel;
+    if (format > SAMPLE_F32LE || channel > CHANNEL_16 || channel < MONO || preprocess == nullptr) {
+        AUDIO_ERR_LOG("failed with invalid params");
+        return ERR_INVALID_PARAM;
+    }
+    size_t frameSize = GetFrameSize(buffer, format, channel);
+    CHECK_AND_RETURN_RET_LOG(frameSize != 0 && frameSize < MAX_FRAME_SIZE, ERR_INVALID_PARAM,
+        "failed with invalid buffer");
+
+    // Each block is counted right after it is preprocessed, while it is still in the cache.
+    size_t byteSizePerFrame = GetByteSize(format) * channel;
+    int64_t sums[CHANNEL_MAX] = {};
+    double floatSums[CHANNEL_MAX] = {};
+    for (size_t frameIndex = 0; frameIndex < frameSize; frameIndex += LEVEL_BLOCK_FRAMES) {
+        size_t blockFrames = std::min(LEVEL_BLOCK_FRAMES, frameSize - frameIndex);
+        uint8_t *block = buffer.buffer + frameIndex * byteSizePerFrame;
+        preprocess(block, blockFrames * byteSizePerFrame);
+        SumAbs(block, blockFrames, format, channel, sums, floatSums);
+    }
+    SetVolumeLevel(format, frameSize, sums, floatSums, volLevel);
+    return SUCCESS;
+}
 } // namespace AudioStandard
 } // namespace OHOS
 
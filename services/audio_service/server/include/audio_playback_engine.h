@@ -14,17 +14,23 @@
  */
 #ifndef AUDIO_PLAYBACK_ENGINE_H
 #define AUDIO_PLAYBACK_ENGINE_H
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
 #include "i_audio_engine.h"
 #include "i_renderer_stream.h"
 #include "audio_renderer_sink.h"
 #include "audio_thread_task.h"
+#include "mix_tools.h"
 
 namespace OHOS {
 namespace AudioStandard {
 class AudioPlaybackEngine : public IAudioEngine {
 public:
     AudioPlaybackEngine();
+    // The sink is not owned by the engine, it is used instead of the hdi sink, e.g. AudioRendererFileSink.
+    explicit AudioPlaybackEngine(IAudioRendererSink *sink);
     virtual ~AudioPlaybackEngine() override;
     virtual int32_t AddRenderer(const std::shared_ptr<IRendererStream> &stream);
     virtual void RemoveRenderer(const std::shared_ptr<IRendererStream> &stream);
@@ -37,13 +43,53 @@ public:
 
     virtual bool IsPlaybackEngineRunning() const noexcept override;
 
+    // The engine does not enter standby while any running stream is added, late data is waited for instead.
+    void SetRendererRunning(const std::shared_ptr<IRendererStream> &stream, bool isRunning);
+    size_t GetRendererCount();
+    AudioStreamInfo GetSinkStreamInfo() const noexcept;
+
 protected:
-    virtual void MixStreams() {}
+    virtual void MixStreams();
+
+private:
+    int32_t StartInner();
+    int32_t InitSink();
+    void DeInitSink();
+    void StandbySleep();
+    void EnterStandby();
+    void ReturnPeekedBuffers();
 
 protected:
     IAudioRendererSink *renderSink_;
     std::unique_ptr<AudioThreadTask> playbackThread_;
     std::vector<std::shared_ptr<IRendererStream>> streams_;
+
+private:
+    bool isSinkInjected_ = false;
+    bool isVoip_ = false;
+    DeviceInfo device_;
+    AudioStreamInfo sinkStreamInfo_;
+    size_t spanSizeInFrame_ = 0;
+    std::atomic<bool> isStart_ = false;
+    std::set<uint32_t> runningStreams_;
+    std::atomic<size_t> runningCount_ = 0;
+
+    std::mutex streamMutex_; // guard streams_ and runningStreams_
+    std::mutex startMutex_; // guard the sink and its config, taken by the playback thread for each period
+
+    // Only used in the playback thread, they keep their capacity so that mixing does not allocate per period.
+    std::vector<std::shared_ptr<IRendererStream>> mixingStreams_;
+    std::vector<std::vector<char>> peekBuffers_;
+    std::vector<int32_t> peekIndexes_;
+    std::vector<AudioStreamData> mixDataList_;
+    std::vector<int32_t> appsUid_;
+    std::vector<float> mixBuffer_;
+    MixConverters mixConverters_;
+    std::vector<char> sinkBuffer_;
+
+    uint64_t writeCount_ = 0;
+    int64_t fwkSyncTime_ = 0;
+    uint32_t idleCount_ = 0;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -87,6 +87,8 @@ private:
     void RecordSourceDump(std::string &dumpString);
     void HDFModulesDump(std::string &dumpString);
     void PolicyHandlerDump(std::string &dumpString);
+    void PaLockDump(std::string &dumpString);
+    void StreamPoolDump(std::string &dumpString);
     void ArgDataDump(std::string &dumpString, std::queue<std::u16string>& argQue);
     void ServerDataDump(std::string &dumpString);
     void InitDumpFuncMap();
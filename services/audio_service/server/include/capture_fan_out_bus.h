@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CAPTURE_FAN_OUT_BUS_H
+#define CAPTURE_FAN_OUT_BUS_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "audio_info.h"
+#include "audio_ring_cache.h"
+
+namespace OHOS {
+namespace AudioStandard {
+struct CaptureFanOutKey {
+    SourceType sourceType = SOURCE_TYPE_INVALID;
+    AudioSamplingRate samplingRate = SAMPLE_RATE_8000;
+    AudioSampleFormat format = INVALID_WIDTH;
+    AudioChannel channels = MONO;
+    size_t spanSizeInBytes = 0;
+    // Capture privacy and the source output mute of the sound server apply per app, only one app's streams share.
+    int32_t appUid = -1;
+    uint32_t appTokenId = 0;
+
+    bool operator<(const CaptureFanOutKey &other) const;
+};
+
+class ICaptureSubscriber {
+public:
+    // Called on the publisher's read thread with one span of captured data, a silent one if the subscriber is muted.
+    virtual void OnCaptureSpan(const BufferDesc &span) = 0;
+    virtual bool IsCaptureMuted() = 0;
+    virtual ~ICaptureSubscriber() = default;
+};
+
+// Capturers recording the same source with the same stream info get identical data from the sound server. The bus
+// lets the first started one of them cache and split the data into spans once, every subscriber then gets a copy
+// of the same span. The other subscribers only drain their own streams.
+class CaptureFanOutBus {
+public:
+    static CaptureFanOutBus &GetInstance();
+
+    static bool IsSourceShareable(SourceType sourceType);
+
+    int32_t Subscribe(const CaptureFanOutKey &key, std::shared_ptr<ICaptureSubscriber> subscriber);
+    void Unsubscribe(const CaptureFanOutKey &key, const ICaptureSubscriber *subscriber);
+
+    // Returns false if the caller is not the publisher of the key, its data should be dropped then.
+    bool Publish(const CaptureFanOutKey &key, const ICaptureSubscriber *publisher, const BufferDesc &data);
+
+    size_t GetSubscriberCount(const CaptureFanOutKey &key);
+
+private:
+    struct FanOutGroup {
+        std::vector<std::pair<const ICaptureSubscriber *, std::weak_ptr<ICaptureSubscriber>>> subscribers;
+        std::unique_ptr<AudioRingCache> ringCache = nullptr;
+        std::unique_ptr<uint8_t []> spanBuffer = nullptr;
+        std::unique_ptr<uint8_t []> silentBuffer = nullptr;
+    };
+
+    CaptureFanOutBus() = default;
+    void DeliverSpans(FanOutGroup &group, size_t spanSizeInBytes,
+        const std::vector<std::shared_ptr<ICaptureSubscriber>> &subscribers);
+
+    std::mutex busMutex_;
+    std::map<CaptureFanOutKey, FanOutGroup> groups_;
+};
+} // namespace AudioStandard
+} // namespace OHOS
+#endif // CAPTURE_FAN_OUT_BUS_H
@@ -21,16 +21,19 @@
 #include "i_stream_listener.h"
 #include "oh_audio_buffer.h"
 #include "audio_ring_cache.h"
+#include "capture_fan_out_bus.h"
 
 namespace OHOS {
 namespace AudioStandard {
-class CapturerInServer : public IStatusCallback, public IReadCallback,
+class CapturerInServer : public IStatusCallback, public IReadCallback, public ICaptureSubscriber,
     public std::enable_shared_from_this<CapturerInServer> {
 public:
     CapturerInServer(AudioProcessConfig processConfig, std::weak_ptr<IStreamListener> streamListener);
     virtual ~CapturerInServer();
     void OnStatusUpdate(IOperation operation) override;
     int32_t OnReadData(size_t length) override;
+    void OnCaptureSpan(const BufferDesc &span) override;
+    bool IsCaptureMuted() override;
 
     int32_t ResolveBuffer(std::shared_ptr<OHAudioBuffer> &buffer);
     int32_t GetSessionId(uint32_t &sessionId);
@@ -60,8 +63,12 @@ public:
 
 private:
     int32_t InitCacheBuffer(size_t targetSize);
-    bool IsReadDataOverFlow(size_t length, uint64_t currentWriteFrame,
-        std::shared_ptr<IStreamListener> stateListener);
+    bool IsServerBufferFull();
+    bool IsReadDataOverFlow(size_t length);
+    void PublishSpan(uint64_t currentWriteFrame, const BufferDesc &dstBuffer);
+    void ReadSharedData(size_t length);
+    void JoinFanOutBus();
+    void LeaveFanOutBus();
 
     std::mutex statusLock_;
     std::condition_variable statusCv_;
@@ -93,6 +100,8 @@ private:
     FILE *dumpS2C_ = nullptr; // server to client dump file
     std::string dumpFileName_ = "";
     std::atomic<bool> muteFlag_ = false;
+    CaptureFanOutKey fanOutKey_;
+    std::atomic<bool> isFanOutJoined_ = false;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -59,6 +59,8 @@ public:
     virtual int32_t Peek(std::vector<char> *audioBuffer, int32_t &index) = 0;
     virtual int32_t ReturnIndex(int32_t index) = 0;
     virtual AudioProcessConfig GetAudioProcessConfig() const noexcept = 0;
+    // Format of the buffers returned by Peek, which may differ from the client stream info.
+    virtual AudioStreamInfo GetOutputStreamInfo() const noexcept = 0;
     virtual int32_t SetClientVolume(float clientVolume) = 0;
 };
 } // namespace AudioStandard
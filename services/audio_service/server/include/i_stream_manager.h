@@ -28,6 +28,7 @@ enum ManagerType : int32_t {
     DIRECT_PLAYBACK,
     VOIP_PLAYBACK,
     RECORDER,
+    MIX_PLAYBACK, // several direct streams mixed in process by AudioPlaybackEngine
 };
 
 class IStreamManager {
@@ -48,6 +49,7 @@ public:
     virtual int32_t GetStreamCount() const noexcept = 0;
     virtual int32_t CreateCapturer(AudioProcessConfig processConfig, std::shared_ptr<ICapturerStream> &stream) = 0;
     virtual int32_t ReleaseCapturer(uint32_t streamIndex_) = 0;
+    virtual void DumpStreamPool(std::string &dumpString) {}
 };
 } // namespace AudioStandard
 } // namespace OHOS
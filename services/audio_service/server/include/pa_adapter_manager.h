@@ -16,8 +16,12 @@
 #ifndef PA_ADAPTER_MANAGER_H
 #define PA_ADAPTER_MANAGER_H
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 #include <pulse/pulseaudio.h>
 #include <pulse/thread-mainloop.h>
 #include "audio_timer.h"
@@ -56,9 +60,38 @@ static std::map<AudioChannelSet, pa_channel_position> chSetToPaPositionMap = {
     {LOW_FREQUENCY_2, PA_CHANNEL_POSITION_LFE},
 };
 
+// One pa context with its own threaded mainloop. Streams are spread over several of them, so a stream blocking the
+// lock of its mainloop does not stall the data callbacks of the streams on the other mainloops.
+struct PaContextShard {
+    uint32_t index = 0;
+    pa_threaded_mainloop *mainLoop = nullptr;
+    pa_mainloop_api *api = nullptr;
+    pa_context *context = nullptr;
+    bool isContextConnected = false;
+    bool isMainLoopStarted = false;
+    uint32_t streamCount = 0;
+};
+
+// Corked streams pre-connected for one kind of short sound, a renderer of the same kind takes one instead of
+// waiting for a new stream to get ready.
+struct PaStreamPoolKey {
+    StreamUsage streamUsage = STREAM_USAGE_UNKNOWN;
+    AudioSamplingRate samplingRate = SAMPLE_RATE_8000;
+    AudioSampleFormat format = INVALID_WIDTH;
+    AudioChannel channels = MONO;
+
+    bool operator<(const PaStreamPoolKey &other) const;
+};
+
+struct PooledPaStream {
+    pa_stream *paStream = nullptr;
+    PaContextShard *shard = nullptr;
+};
+
 class PaAdapterManager : public IStreamManager {
 public:
     PaAdapterManager(ManagerType type);
+    ~PaAdapterManager();
 
     int32_t CreateRender(AudioProcessConfig processConfig, std::shared_ptr<IRendererStream> &stream) override;
     int32_t ReleaseRender(uint32_t streamIndex_) override;
@@ -70,6 +103,10 @@ public:
     int32_t CreateCapturer(AudioProcessConfig processConfig, std::shared_ptr<ICapturerStream> &stream) override;
     int32_t ReleaseCapturer(uint32_t streamIndex_) override;
     uint32_t ConvertChLayoutToPaChMap(const uint64_t &channelLayout, pa_channel_map &paMap);
+    void DumpStreamPool(std::string &dumpString) override;
+
+    // the metrics live in the library of the stream managers, so they are dumped from here
+    static void DumpLockMetrics(std::string &dumpString);
 
 private:
     // audio channel index
@@ -82,23 +119,31 @@ private:
     static const uint8_t CHANNEL7_IDX = 6;
     static const uint8_t CHANNEL8_IDX = 7;
 
-    int32_t ResetPaContext();
-    int32_t InitPaContext();
-    int32_t HandleMainLoopStart();
-    pa_stream *InitPaStream(AudioProcessConfig processConfig, uint32_t sessionId, bool isRecording);
+    PaContextShard *AttachShard(uint32_t sessionId);
+    PaContextShard *SelectShard();
+    void DetachShard(uint32_t sessionId);
+    uint32_t GetShardNumMax();
+    const std::string GetMainLoopName(uint32_t shardIndex);
+    int32_t ResetPaContext(PaContextShard &shard);
+    int32_t InitPaContext(PaContextShard &shard);
+    int32_t HandleMainLoopStart(PaContextShard &shard);
+    pa_stream *InitPaStream(AudioProcessConfig processConfig, uint32_t sessionId, bool isRecording,
+        PaContextShard &shard);
     bool IsEffectNone(StreamUsage streamUsage);
     int32_t SetPaProplist(pa_proplist *propList, pa_channel_map &map, AudioProcessConfig &processConfig,
         const std::string &streamName, uint32_t sessionId);
-    std::shared_ptr<IRendererStream> CreateRendererStream(AudioProcessConfig processConfig, pa_stream *paStream);
-    std::shared_ptr<ICapturerStream> CreateCapturerStream(AudioProcessConfig processConfig, pa_stream *paStream);
-    int32_t ConnectStreamToPA(pa_stream *paStream, pa_sample_spec sampleSpec,
+    std::shared_ptr<IRendererStream> CreateRendererStream(AudioProcessConfig processConfig, pa_stream *paStream,
+        pa_threaded_mainloop *mainLoop);
+    std::shared_ptr<ICapturerStream> CreateCapturerStream(AudioProcessConfig processConfig, pa_stream *paStream,
+        pa_threaded_mainloop *mainLoop);
+    int32_t ConnectStreamToPA(pa_threaded_mainloop *mainLoop, pa_stream *paStream, pa_sample_spec sampleSpec,
         SourceType source, const std::string &deviceName = "");
-    void ReleasePaStream(pa_stream *paStream);
+    void ReleasePaStream(pa_threaded_mainloop *mainLoop, pa_stream *paStream);
     int32_t ConnectRendererStreamToPA(pa_stream *paStream, pa_sample_spec sampleSpec);
     int32_t ConnectCapturerStreamToPA(pa_stream *paStream, pa_sample_spec sampleSpec,
         SourceType source, const std::string &deviceName);
 
-    int32_t SetStreamAudioEnhanceMode(pa_stream *paStream, AudioEnhanceMode mode);
+    int32_t SetStreamAudioEnhanceMode(pa_threaded_mainloop *mainLoop, pa_stream *paStream, AudioEnhanceMode mode);
     const std::string GetEnhanceModeName(AudioEnhanceMode mode);
     const std::string GetEnhanceSceneName(SourceType sourceType);
 
@@ -107,6 +152,8 @@ private:
     static void PAContextStateCb(pa_context *context, void *userdata);
 
     static void PAStreamUpdateStreamIndexSuccessCb(pa_stream *stream, int32_t success, void *userdata);
+    static void PAStreamRetagTimeoutCb(pa_mainloop_api *api, pa_time_event *event, const struct timeval *tv,
+        void *userdata);
 
     const std::string GetStreamName(AudioStreamType audioType);
     pa_sample_spec ConvertToPAAudioParams(AudioProcessConfig processConfig);
@@ -118,19 +165,34 @@ private:
     bool CheckHighResolution(const AudioProcessConfig &processConfig);
     void SetRecordProplist(pa_proplist *propList, AudioProcessConfig &processConfig);
 
+    bool IsStreamPoolable(const AudioProcessConfig &processConfig);
+    pa_stream *TakePooledStream(AudioProcessConfig processConfig, uint32_t sessionId, PaContextShard *&shard);
+    void ReleasePooledStream(const PooledPaStream &pooled);
+    void StartStreamPoolRefill(const AudioProcessConfig &processConfig);
+    void RefillStreamPool(AudioProcessConfig processConfig);
+    bool RetagPooledStream(const PooledPaStream &pooled, AudioProcessConfig &processConfig, uint32_t sessionId);
+    void StopStreamPool();
+
     std::mutex paElementsMutex_;
-    pa_threaded_mainloop *mainLoop_;
-    pa_mainloop_api *api_;
-    pa_context *context_;
+    std::vector<std::unique_ptr<PaContextShard>> shards_;
+    std::map<uint32_t, PaContextShard *> streamShardMap_;
     std::mutex streamMapMutex_;
     std::map<int32_t, std::shared_ptr<IRendererStream>> rendererStreamMap_;
     std::map<int32_t, std::shared_ptr<ICapturerStream>> capturerStreamMap_;
-    bool isContextConnected_;
-    bool isMainLoopStarted_;
     ManagerType managerType_ = PLAYBACK;
     bool waitConnect_ = true;
     uint32_t highResolutionIndex_ = 0;
     bool isHighResolutionExist_ = false;
+
+    std::mutex streamPoolMutex_;
+    std::map<PaStreamPoolKey, std::vector<PooledPaStream>> streamPool_;
+    uint32_t streamPoolSize_ = 0;
+    std::atomic<bool> isStreamPoolRefilling_ = false;
+    std::atomic<bool> isStreamPoolStopped_ = false;
+    // joined before the next refill starts and when the manager is destroyed, it never outlives the manager
+    std::thread streamPoolRefillThread_;
+    std::atomic<uint64_t> streamPoolHitCount_ = 0;
+    std::atomic<uint64_t> streamPoolMissCount_ = 0;
 };
 } // namespace AudioStandard
 } // namespace OHOS
@@ -16,17 +16,142 @@
 #ifndef PA_ADAPTER_TOOLS_H
 #define PA_ADAPTER_TOOLS_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <pulse/pulseaudio.h>
 #include <pulse/thread-mainloop.h>
+#include "securec.h"
 
 namespace OHOS {
 namespace AudioStandard {
+static const size_t PA_LOCK_STATS_NUM_MAX = 16;
+static const size_t PA_LOCK_STATS_NAME_LEN = 32;
+static const int64_t PA_LOCK_SLOW_WAIT_NS = 5000000; // 5ms, one fourth of a render period
+
+// Lock metrics of one threaded mainloop. Hold time includes the time spent in pa_threaded_mainloop_wait, which
+// releases the lock, so a long hold on a connecting stream is expected.
+struct PaLockStats {
+    std::atomic<bool> isUsed = false;
+    std::atomic<pa_threaded_mainloop *> mainloop = nullptr;
+    char name[PA_LOCK_STATS_NAME_LEN] = {0};
+    std::atomic<uint64_t> lockCount = 0;
+    std::atomic<uint64_t> slowWaitCount = 0;
+    std::atomic<int64_t> totalWaitNs = 0;
+    std::atomic<int64_t> maxWaitNs = 0;
+    std::atomic<int64_t> totalHoldNs = 0;
+    std::atomic<int64_t> maxHoldNs = 0;
+};
+
+// Only mainloops registered by the stream managers are tracked, the lookup is a short lock free scan. Tracking is
+// off unless persist.multimedia.audio.palockmetrics is 1, the guard then costs no more than the plain lock.
+class PaLockMetrics {
+public:
+    static bool IsEnabled()
+    {
+        return GetEnabledFlag().load(std::memory_order_relaxed);
+    }
+
+    static void SetEnabled(bool isEnabled)
+    {
+        GetEnabledFlag().store(isEnabled, std::memory_order_relaxed);
+    }
+
+    static void Register(pa_threaded_mainloop *mainloop, const char *name)
+    {
+        for (PaLockStats &stats : GetStatsList()) {
+            bool expected = false;
+            if (!stats.isUsed.compare_exchange_strong(expected, true)) {
+                continue;
+            }
+            ResetStats(stats);
+            if (name != nullptr) {
+                strncpy_s(stats.name, PA_LOCK_STATS_NAME_LEN, name, PA_LOCK_STATS_NAME_LEN - 1);
+            }
+            stats.mainloop.store(mainloop);
+            return;
+        }
+    }
+
+    static void Unregister(pa_threaded_mainloop *mainloop)
+    {
+        PaLockStats *stats = Find(mainloop);
+        if (stats != nullptr) {
+            stats->mainloop.store(nullptr);
+            stats->isUsed.store(false);
+        }
+    }
+
+    static PaLockStats *Find(pa_threaded_mainloop *mainloop)
+    {
+        if (mainloop == nullptr) {
+            return nullptr;
+        }
+        for (PaLockStats &stats : GetStatsList()) {
+            if (stats.mainloop.load(std::memory_order_relaxed) == mainloop) {
+                return &stats;
+            }
+        }
+        return nullptr;
+    }
+
+    static void Record(PaLockStats &stats, int64_t waitNs, int64_t holdNs)
+    {
+        stats.lockCount.fetch_add(1, std::memory_order_relaxed);
+        stats.totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+        stats.totalHoldNs.fetch_add(holdNs, std::memory_order_relaxed);
+        if (waitNs > PA_LOCK_SLOW_WAIT_NS) {
+            stats.slowWaitCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        UpdateMax(stats.maxWaitNs, waitNs);
+        UpdateMax(stats.maxHoldNs, holdNs);
+    }
+
+    static std::array<PaLockStats, PA_LOCK_STATS_NUM_MAX> &GetStatsList()
+    {
+        static std::array<PaLockStats, PA_LOCK_STATS_NUM_MAX> statsList;
+        return statsList;
+    }
+
+private:
+    static std::atomic<bool> &GetEnabledFlag()
+    {
+        static std::atomic<bool> isEnabled = false;
+        return isEnabled;
+    }
+
+    static void ResetStats(PaLockStats &stats)
+    {
+        memset_s(stats.name, PA_LOCK_STATS_NAME_LEN, 0, PA_LOCK_STATS_NAME_LEN);
+        stats.lockCount = 0;
+        stats.slowWaitCount = 0;
+        stats.totalWaitNs = 0;
+        stats.maxWaitNs = 0;
+        stats.totalHoldNs = 0;
+        stats.maxHoldNs = 0;
+    }
+
+    static void UpdateMax(std::atomic<int64_t> &maxValue, int64_t value)
+    {
+        int64_t current = maxValue.load(std::memory_order_relaxed);
+        while (value > current && !maxValue.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+};
+
 // PaLockGuard is used to auto-call unlock.
 class PaLockGuard {
 public:
-    PaLockGuard(pa_threaded_mainloop *mainloop) : mainloop_(mainloop)
+    PaLockGuard(pa_threaded_mainloop *mainloop) : mainloop_(mainloop),
+        stats_(PaLockMetrics::IsEnabled() ? PaLockMetrics::Find(mainloop) : nullptr)
     {
+        if (stats_ == nullptr) {
+            pa_threaded_mainloop_lock(mainloop_);
+            return;
+        }
+        auto waitStart = std::chrono::steady_clock::now();
         pa_threaded_mainloop_lock(mainloop_);
+        lockedTime_ = std::chrono::steady_clock::now();
+        waitNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(lockedTime_ - waitStart).count();
     }
 
     ~PaLockGuard()
@@ -39,11 +164,19 @@ public:
         if (!isUnlocked_) {
             pa_threaded_mainloop_unlock(mainloop_);
             isUnlocked_ = true;
+            if (stats_ != nullptr) {
+                int64_t holdNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - lockedTime_).count();
+                PaLockMetrics::Record(*stats_, waitNs_, holdNs);
+            }
         }
     }
 private:
     bool isUnlocked_ = false;
     pa_threaded_mainloop *mainloop_ = nullptr;
+    PaLockStats *stats_ = nullptr;
+    std::chrono::steady_clock::time_point lockedTime_;
+    int64_t waitNs_ = 0;
 };
 } // namespace AudioStandard
 } // namespace OHOS
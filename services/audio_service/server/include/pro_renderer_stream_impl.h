@@ -71,6 +71,7 @@ public:
     int32_t UpdateMaxLength(uint32_t maxLength) override;
 
     AudioProcessConfig GetAudioProcessConfig() const noexcept override;
+    AudioStreamInfo GetOutputStreamInfo() const noexcept override;
     int32_t Peek(std::vector<char> *audioBuffer, int32_t &index) override;
     int32_t ReturnIndex(int32_t index) override;
     int32_t SetClientVolume(float clientVolume) override;
@@ -79,6 +79,7 @@ public:
     int32_t UpdateWriteIndex();
     BufferDesc DequeueBuffer(size_t length);
     void VolumeHandle(BufferDesc &desc);
+    bool GetSpanRampVolume(float &volumeStart, float &volumeEnd);
     int32_t WriteData();
     void WriteEmptyData();
     int32_t DrainAudioBuffer();
@@ -108,6 +109,7 @@ public:
 private:
     void OnStatusUpdateSub(IOperation operation);
     bool IsHighResolution() const noexcept;
+    static bool IsDirectMixEnabled();
     void DoFadingOut(BufferDesc& bufferDesc);
     void WriteMuteDataSysEvent(uint8_t *buffer, size_t bufferSize);
     void ReportDataToResSched(bool isSilent);
@@ -38,6 +38,7 @@
 #include "i_audio_capturer_source.h"
 #include "i_stream_manager.h"
 #include "linear_pos_time_model.h"
+#include "mix_tools.h"
 #include "policy_handler.h"
 #include "media_monitor_manager.h"
 #include "audio_log_utils.h"
@@ -180,9 +181,8 @@ private:
     void RecordReSyncPosition();
     void InitAudiobuffer(bool resetReadWritePos);
     void ProcessData(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData);
-    void ProcessSingleData(const AudioStreamData &srcData, const AudioStreamData &dstData);
     void HandleZeroVolumeCheckEvent();
-    void HandleRendererDataParams(const AudioStreamData &srcData, const AudioStreamData &dstData);
+    void HandleRendererDataParams(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData);
     int32_t HandleCapturerDataParams(const BufferDesc &writeBuf, const BufferDesc &readBuf,
         const BufferDesc &convertedBuffer);
     void ZeroVolumeCheck(const int32_t vol);
@@ -298,6 +298,8 @@ private:
     uint32_t dstTotalSizeInframe_ = 0;
     uint32_t dstSpanSizeInframe_ = 0;
     uint32_t dstByteSizePerFrame_ = 0;
+    std::vector<float> mixBuffer_; // float accumulator of one dst span, used by ProcessData
+    MixConverters mixConverters_; // converters of the sources mixed by ProcessData
     std::shared_ptr<OHAudioBuffer> dstAudioBuffer_ = nullptr;
 
     std::atomic<EndpointStatus> endpointStatus_ = INVALID;
@@ -412,7 +414,7 @@ void MockCallbacks::OnStatusUpdate(IOperation operation)
 
 int32_t MockCallbacks::OnWriteData(size_t length)
 {
-    Trace trace("DupStream::OnWriteData length " + std::to_string(length));
+    Trace trace = Trace::Format("DupStream::OnWriteData length %zu", length);
     return SUCCESS;
 }
 
@@ -846,6 +848,7 @@ int32_t AudioEndpointInner::PrepareDeviceBuffer(const DeviceInfo &deviceInfo)
     }
 
     dstAudioBuffer_->GetStreamStatus()->store(StreamStatus::STREAM_IDEL);
+    mixBuffer_.resize(static_cast<size_t>(dstSpanSizeInframe_) * dstStreamInfo_.channels);
 
     // clear data buffer
     ret = memset_s(dstAudioBuffer_->GetDataBase(), dstAudioBuffer_->GetDataSize(), 0, dstAudioBuffer_->GetDataSize());
@@ -1388,35 +1391,18 @@ void AudioEndpointInner::MixToDupStream(const std::vector<AudioStreamData> &srcD
 
 void AudioEndpointInner::ProcessData(const std::vector<AudioStreamData> &srcDataList, const AudioStreamData &dstData)
 {
-    size_t srcListSize = srcDataList.size();
+    int32_t ret = MixTools::Mix(srcDataList, dstData, mixBuffer_, mixConverters_);
+    CHECK_AND_RETURN_LOG(ret == SUCCESS, "ProcessData failed, streamInfo are not support");
 
-    for (size_t i = 0; i < srcListSize; i++) {
-        if (srcDataList[i].streamInfo.format != SAMPLE_S16LE || srcDataList[i].streamInfo.channels != STEREO ||
-            srcDataList[i].bufferDesc.bufLength != dstData.bufferDesc.bufLength ||
-            srcDataList[i].bufferDesc.dataLength != dstData.bufferDesc.dataLength) {
-            AUDIO_ERR_LOG("ProcessData failed, streamInfo are different");
-            return;
-        }
-    }
-
-    // Assum using the same format and same size
-    CHECK_AND_RETURN_LOG(dstData.streamInfo.format == SAMPLE_S16LE && dstData.streamInfo.channels == STEREO,
-        "ProcessData failed, streamInfo are not support");
-
-    size_t dataLength = dstData.bufferDesc.dataLength;
-    dataLength /= 2; // SAMPLE_S16LE--> 2 byte
-    int16_t *dstPtr = reinterpret_cast<int16_t *>(dstData.bufferDesc.buffer);
-    for (size_t offset = 0; dataLength > 0; dataLength--) {
-        int32_t sum = 0;
-        for (size_t i = 0; i < srcListSize; i++) {
-            int32_t vol = srcDataList[i].volumeStart; // change to modify volume of each channel
-            int16_t *srcPtr = reinterpret_cast<int16_t *>(srcDataList[i].bufferDesc.buffer) + offset;
-            sum += (*srcPtr * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER; // 1/65536
-            ZeroVolumeCheck(vol);
+    // The device only stops when every stream stays at zero volume for the whole span.
+    bool isAllZero = true;
+    for (const AudioStreamData &srcData : srcDataList) {
+        if (srcData.volumeStart != 0 || srcData.volumeEnd != 0) {
+            isAllZero = false;
+            break;
         }
-        offset++;
-        *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
     }
+    ZeroVolumeCheck(isAllZero ? 0 : (1 << VOLUME_SHIFT_NUMBER));
     HandleZeroVolumeCheckEvent();
 }
 
@@ -1437,46 +1423,15 @@ void AudioEndpointInner::HandleZeroVolumeCheckEvent()
 }
 
 
-void AudioEndpointInner::HandleRendererDataParams(const AudioStreamData &srcData, const AudioStreamData &dstData)
-{
-    if (srcData.streamInfo.encoding != dstData.streamInfo.encoding) {
-        AUDIO_ERR_LOG("Different encoding formats");
-        return;
-    }
-    if (srcData.streamInfo.format == SAMPLE_S16LE && srcData.streamInfo.channels == STEREO) {
-        return ProcessSingleData(srcData, dstData);
-    }
-    if (srcData.streamInfo.format == SAMPLE_S16LE && srcData.streamInfo.channels == MONO) {
-        CHECK_AND_RETURN_LOG(processList_.size() > 0 && processList_[0] != nullptr, "No avaliable process");
-        BufferDesc &convertedBuffer = processList_[0]->GetConvertedBuffer();
-        int32_t ret = FormatConverter::S16MonoToS16Stereo(srcData.bufferDesc, convertedBuffer);
-        CHECK_AND_RETURN_LOG(ret == SUCCESS, "Convert channel from mono to stereo failed");
-        AudioStreamData dataAfterProcess = srcData;
-        dataAfterProcess.bufferDesc = convertedBuffer;
-        ProcessSingleData(dataAfterProcess, dstData);
-        ret = memset_s(static_cast<void *>(convertedBuffer.buffer), convertedBuffer.bufLength, 0,
-            convertedBuffer.bufLength);
-        CHECK_AND_RETURN_LOG(ret == EOK, "memset converted buffer to 0 failed");
-    }
-}
-
-void AudioEndpointInner::ProcessSingleData(const AudioStreamData &srcData, const AudioStreamData &dstData)
+void AudioEndpointInner::HandleRendererDataParams(const std::vector<AudioStreamData> &srcDataList,
+    const AudioStreamData &dstData)
 {
-    CHECK_AND_RETURN_LOG(dstData.streamInfo.format == SAMPLE_S16LE && dstData.streamInfo.channels == STEREO,
-        "ProcessData failed, streamInfo are not support");
-
-    size_t dataLength = dstData.bufferDesc.dataLength;
-    dataLength /= 2; // SAMPLE_S16LE--> 2 byte
-    int16_t *dstPtr = reinterpret_cast<int16_t *>(dstData.bufferDesc.buffer);
-    for (size_t offset = 0; dataLength > 0; dataLength--) {
-        int32_t vol = srcData.volumeStart; // change to modify volume of each channel
-        int16_t *srcPtr = reinterpret_cast<int16_t *>(srcData.bufferDesc.buffer) + offset;
-        int32_t sum = (*srcPtr * static_cast<int64_t>(vol)) >> VOLUME_SHIFT_NUMBER; // 1/65536
-        ZeroVolumeCheck(vol);
-        offset++;
-        *dstPtr++ = sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+    for (const AudioStreamData &srcData : srcDataList) {
+        CHECK_AND_RETURN_LOG(srcData.streamInfo.encoding == dstData.streamInfo.encoding,
+            "Different encoding formats");
     }
-    HandleZeroVolumeCheckEvent();
+    // format and channel conversion is done inside the mixer
+    ProcessData(srcDataList, dstData);
 }
 
 void AudioEndpointInner::ZeroVolumeCheck(const int32_t vol)
@@ -1508,7 +1463,7 @@ void AudioEndpointInner::GetAllReadyProcessData(std::vector<AudioStreamData> &au
 {
     for (size_t i = 0; i < processBufferList_.size(); i++) {
         uint64_t curRead = processBufferList_[i]->GetCurReadFrame();
-        Trace trace("AudioEndpoint::ReadProcessData->" + std::to_string(curRead));
+        Trace trace = Trace::Format("AudioEndpoint::ReadProcessData->%" PRIu64, curRead);
         SpanInfo *curReadSpan = processBufferList_[i]->GetSpanInfo(curRead);
         CHECK_AND_CONTINUE_LOG(curReadSpan != nullptr, "GetSpanInfo failed, can not get client curReadSpan");
         AudioStreamData streamData;
@@ -1522,10 +1477,11 @@ void AudioEndpointInner::GetAllReadyProcessData(std::vector<AudioStreamData> &au
             !PolicyHandler::GetInstance().IsAbsVolumeSupported()) &&
             PolicyHandler::GetInstance().GetSharedVolume(volumeType, deviceType, vol)) {
             streamData.volumeStart = vol.isMute ? 0 : static_cast<int32_t>(curReadSpan->volumeStart * vol.volumeFloat);
+            streamData.volumeEnd = vol.isMute ? 0 : static_cast<int32_t>(curReadSpan->volumeEnd * vol.volumeFloat);
         } else {
             streamData.volumeStart = curReadSpan->volumeStart;
+            streamData.volumeEnd = curReadSpan->volumeEnd;
         }
-        streamData.volumeEnd = curReadSpan->volumeEnd;
         streamData.streamInfo = processList_[i]->GetStreamInfo();
         streamData.isInnerCaped = processList_[i]->GetInnerCapState();
         SpanStatus targetStatus = SpanStatus::SPAN_WRITE_DONE;
@@ -1567,14 +1523,14 @@ bool AudioEndpointInner::ProcessToEndpointDataHandle(uint64_t curWritePos)
     dstStreamData.volumeStart = curWriteSpan->volumeStart;
     dstStreamData.volumeEnd = curWriteSpan->volumeEnd;
 
-    Trace trace("AudioEndpoint::WriteDstBuffer=>" + std::to_string(curWritePos));
+    Trace trace = Trace::Format("AudioEndpoint::WriteDstBuffer=>%" PRIu64, curWritePos);
     // do write work
     if (audioDataList.size() == 0) {
         memset_s(dstStreamData.bufferDesc.buffer, dstStreamData.bufferDesc.bufLength, 0,
             dstStreamData.bufferDesc.bufLength);
     } else {
         if (endpointType_ == TYPE_VOIP_MMAP && audioDataList.size() == 1) {
-            HandleRendererDataParams(audioDataList[0], dstStreamData);
+            HandleRendererDataParams(audioDataList, dstStreamData);
         } else {
             ProcessData(audioDataList, dstStreamData);
         }
@@ -1700,7 +1656,7 @@ bool AudioEndpointInner::RecordPrepareNextLoop(uint64_t curReadPos, int64_t &wak
 bool AudioEndpointInner::PrepareNextLoop(uint64_t curWritePos, int64_t &wakeUpTime)
 {
     uint64_t nextHandlePos = curWritePos + dstSpanSizeInframe_;
-    Trace prepareTrace("AudioEndpoint::PrepareNextLoop " + std::to_string(nextHandlePos));
+    Trace prepareTrace = Trace::Format("AudioEndpoint::PrepareNextLoop %" PRIu64, nextHandlePos);
     int64_t nextHdiReadTime = GetPredictNextReadTime(nextHandlePos);
     int64_t predictWakeupTime = nextHdiReadTime - serverAheadReadTime_;
     if (predictWakeupTime <= ClockTime::GetCurNano()) {
@@ -1766,8 +1722,8 @@ bool AudioEndpointInner::GetDeviceHandleInfo(uint64_t &frames, int64_t &nanoTime
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, false, "Call adapter GetMmapHandlePosition failed: %{public}d", ret);
     trace.End();
     nanoTime = timeNanoSec + timeSec * AUDIO_NS_PER_SECOND;
-    Trace infoTrace("AudioEndpoint::GetDeviceHandleInfo frames=>" + std::to_string(frames) + " " +
-        std::to_string(nanoTime) + " at " + std::to_string(ClockTime::GetCurNano()));
+    Trace infoTrace = Trace::Format("AudioEndpoint::GetDeviceHandleInfo frames=>%" PRIu64 " %" PRId64 " at %" PRId64,
+        frames, nanoTime, ClockTime::GetCurNano());
     nanoTime += DELTA_TO_REAL_READ_START_TIME; // global delay in server
     return true;
 }
@@ -1872,7 +1828,7 @@ int32_t AudioEndpointInner::WriteToSpecialProcBuf(const std::shared_ptr<OHAudioB
 {
     CHECK_AND_RETURN_RET_LOG(procBuf != nullptr, ERR_INVALID_HANDLE, "process buffer is null.");
     uint64_t curWritePos = procBuf->GetCurWriteFrame();
-    Trace trace("AudioEndpoint::WriteProcessData-<" + std::to_string(curWritePos));
+    Trace trace = Trace::Format("AudioEndpoint::WriteProcessData-<%" PRIu64, curWritePos);
 
     int32_t writeAbleSize = procBuf->GetAvailableDataFrames();
     if (writeAbleSize <= 0 || static_cast<uint32_t>(writeAbleSize) <= dstSpanSizeInframe_) {
@@ -1963,7 +1919,7 @@ void AudioEndpointInner::WriteToProcessBuffers(const BufferDesc &readBuf)
 
 int32_t AudioEndpointInner::ReadFromEndpoint(uint64_t curReadPos)
 {
-    Trace trace("AudioEndpoint::ReadDstBuffer=<" + std::to_string(curReadPos));
+    Trace trace = Trace::Format("AudioEndpoint::ReadDstBuffer=<%" PRIu64, curReadPos);
     AUDIO_DEBUG_LOG("ReadFromEndpoint enter, dstAudioBuffer curReadPos %{public}" PRIu64".", curReadPos);
     CHECK_AND_RETURN_RET_LOG(dstAudioBuffer_ != nullptr, ERR_INVALID_HANDLE,
         "dst audio buffer is null.");
@@ -12,61 +12,397 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifndef LOG_TAG
+#define LOG_TAG "AudioPlaybackEngine"
+#endif
+
 #include <algorithm>
 #include "audio_playback_engine.h"
 #include "audio_errors.h"
+#include "audio_service_log.h"
+#include "audio_utils.h"
+
 namespace OHOS {
 namespace AudioStandard {
+namespace {
+constexpr int64_t PERIOD_NS = 20000000; // 20ms
+constexpr int64_t DELTA_TIME = 4000000; // 4ms
+constexpr int64_t LOCK_RETRY_NS = 1000000; // 1ms
+constexpr int32_t PERIOD_MS = 20; // 20ms
+constexpr int32_t VOLUME_SHIFT_NUMBER = 16; // 1 >> 16 = 65536, max volume
+constexpr uint32_t IDLE_STANDBY_COUNT = 50; // 50 * 20ms, standby after 1s without any running stream
+constexpr int16_t HDI_STEREO_CHANNEL_LAYOUT = 3;
+constexpr int16_t HDI_MONO_CHANNEL_LAYOUT = 4;
+const std::string THREAD_NAME = "OS_MixPlayback";
+// not the "direct" sink of NoneMixEngine, the two never share one hdi render
+const std::string DIRECT_MIX_SINK_NAME = "direct_mix";
+const char *SINK_ADAPTER_NAME = "primary";
+
+HdiAdapterFormat GetHdiFormat(AudioSampleFormat format)
+{
+    switch (format) {
+        case SAMPLE_S24LE:
+            return HdiAdapterFormat::SAMPLE_S24;
+        case SAMPLE_S32LE:
+            return HdiAdapterFormat::SAMPLE_S32;
+        case SAMPLE_F32LE:
+            return HdiAdapterFormat::SAMPLE_F32;
+        default:
+            return HdiAdapterFormat::SAMPLE_S16;
+    }
+}
+
+size_t GetFormatByteSize(AudioSampleFormat format)
+{
+    switch (format) {
+        case SAMPLE_S24LE:
+            return 3; // 3 bytes for s24
+        case SAMPLE_S32LE:
+        case SAMPLE_F32LE:
+            return sizeof(int32_t);
+        default:
+            return sizeof(int16_t);
+    }
+}
+} // namespace
+
 AudioPlaybackEngine::AudioPlaybackEngine()
     : renderSink_(nullptr), playbackThread_(nullptr), streams_(0) {}
 
-AudioPlaybackEngine::~AudioPlaybackEngine() {}
+AudioPlaybackEngine::AudioPlaybackEngine(IAudioRendererSink *sink)
+    : renderSink_(sink), playbackThread_(nullptr), streams_(0), isSinkInjected_(sink != nullptr) {}
+
+AudioPlaybackEngine::~AudioPlaybackEngine()
+{
+    if (playbackThread_) {
+        playbackThread_->Stop();
+        playbackThread_ = nullptr;
+    }
+    if (isStart_ && renderSink_ != nullptr) {
+        renderSink_->Stop();
+    }
+    isStart_ = false;
+    if (spanSizeInFrame_ != 0) {
+        DeInitSink();
+    }
+}
 
 int32_t AudioPlaybackEngine::Init(const DeviceInfo &type, bool isVoip)
 {
-    return SUCCESS;
+    std::lock_guard<std::mutex> lock(startMutex_);
+    if (spanSizeInFrame_ == 0 || (type.deviceType == device_.deviceType && isVoip == isVoip_)) {
+        device_ = type;
+        isVoip_ = isVoip;
+        return SUCCESS;
+    }
+    AUDIO_INFO_LOG("device changed from %{public}d to %{public}d", device_.deviceType, type.deviceType);
+    // the playback thread renders to the sink, it is stopped before the sink is released
+    bool isStarted = isStart_;
+    if (playbackThread_) {
+        playbackThread_->Stop();
+        playbackThread_ = nullptr;
+    }
+    if (isStart_ && renderSink_ != nullptr) {
+        renderSink_->Stop();
+    }
+    isStart_ = false;
+    DeInitSink();
+    device_ = type;
+    isVoip_ = isVoip;
+
+    // the attached streams keep the sink config, they go on playing on the new device
+    int32_t ret = InitSink();
+    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "init sink on the new device failed: %{public}d", ret);
+    return isStarted ? StartInner() : SUCCESS;
 }
 
 int32_t AudioPlaybackEngine::AddRenderer(const std::shared_ptr<IRendererStream> &stream)
 {
+    CHECK_AND_RETURN_RET_LOG(stream != nullptr, ERR_INVALID_PARAM, "stream is null");
+    AudioStreamInfo streamInfo = stream->GetOutputStreamInfo();
+    CHECK_AND_RETURN_RET_LOG(MixTools::IsStreamInfoSupported(streamInfo), ERR_NOT_SUPPORTED,
+        "format %{public}d channels %{public}d can not be mixed", streamInfo.format, streamInfo.channels);
+    {
+        std::lock_guard<std::mutex> startLock(startMutex_);
+        if (spanSizeInFrame_ == 0) {
+            // the first stream decides the sink config, later streams are converted to it while mixing
+            sinkStreamInfo_ = streamInfo;
+            int32_t ret = InitSink();
+            CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "init sink failed: %{public}d", ret);
+        }
+        CHECK_AND_RETURN_RET_LOG(streamInfo.samplingRate == sinkStreamInfo_.samplingRate, ERR_NOT_SUPPORTED,
+            "rate %{public}d differs from sink rate %{public}d", streamInfo.samplingRate,
+            sinkStreamInfo_.samplingRate);
+    }
+
+    std::lock_guard<std::mutex> lock(streamMutex_);
     auto it = std::find(streams_.begin(), streams_.end(), stream);
     if (it == streams_.end()) {
         streams_.emplace_back(stream);
+        AUDIO_INFO_LOG("add stream %{public}u, count %{public}zu", stream->GetStreamIndex(), streams_.size());
     }
     return SUCCESS;
 }
 
 void AudioPlaybackEngine::RemoveRenderer(const std::shared_ptr<IRendererStream> &stream)
 {
+    std::lock_guard<std::mutex> lock(streamMutex_);
     auto it = std::find(streams_.begin(), streams_.end(), stream);
     if (it != streams_.end()) {
         streams_.erase(it);
+        AUDIO_INFO_LOG("remove stream, count %{public}zu", streams_.size());
     }
+    if (stream != nullptr) {
+        runningStreams_.erase(stream->GetStreamIndex());
+        runningCount_ = runningStreams_.size();
+    }
+}
+
+void AudioPlaybackEngine::SetRendererRunning(const std::shared_ptr<IRendererStream> &stream, bool isRunning)
+{
+    CHECK_AND_RETURN_LOG(stream != nullptr, "stream is null");
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    if (isRunning) {
+        runningStreams_.insert(stream->GetStreamIndex());
+    } else {
+        runningStreams_.erase(stream->GetStreamIndex());
+    }
+    runningCount_ = runningStreams_.size();
+}
+
+size_t AudioPlaybackEngine::GetRendererCount()
+{
+    std::lock_guard<std::mutex> lock(streamMutex_);
+    return streams_.size();
+}
+
+AudioStreamInfo AudioPlaybackEngine::GetSinkStreamInfo() const noexcept
+{
+    return sinkStreamInfo_;
 }
 
 int32_t AudioPlaybackEngine::Start()
 {
+    std::lock_guard<std::mutex> lock(startMutex_);
+    return StartInner();
+}
+
+int32_t AudioPlaybackEngine::StartInner()
+{
+    CHECK_AND_RETURN_RET_LOG(renderSink_ != nullptr && spanSizeInFrame_ != 0, ERR_ILLEGAL_STATE,
+        "sink not inited, add a renderer first");
+    int32_t ret = SUCCESS;
+    if (!isStart_) {
+        ret = renderSink_->Start();
+        CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "sink start failed: %{public}d", ret);
+        fwkSyncTime_ = ClockTime::GetCurNano();
+        writeCount_ = 0;
+        idleCount_ = 0;
+        isStart_ = true;
+    }
+    if (!playbackThread_) {
+        playbackThread_ = std::make_unique<AudioThreadTask>(THREAD_NAME);
+        playbackThread_->RegisterJob([this] { this->MixStreams(); });
+    }
+    if (!playbackThread_->CheckThreadIsRunning()) {
+        playbackThread_->Start();
+    }
+    AUDIO_INFO_LOG("started with %{public}zu streams", GetRendererCount());
     return SUCCESS;
 }
 
 int32_t AudioPlaybackEngine::Stop()
 {
-    return SUCCESS;
+    std::lock_guard<std::mutex> lock(startMutex_);
+    if (playbackThread_) {
+        playbackThread_->Stop();
+        playbackThread_ = nullptr;
+    }
+    int32_t ret = SUCCESS;
+    if (isStart_ && renderSink_ != nullptr) {
+        ret = renderSink_->Stop();
+    }
+    isStart_ = false;
+    return ret;
 }
 
 int32_t AudioPlaybackEngine::Pause()
 {
-    return SUCCESS;
+    std::lock_guard<std::mutex> lock(startMutex_);
+    if (playbackThread_) {
+        playbackThread_->Pause();
+    }
+    int32_t ret = SUCCESS;
+    if (isStart_ && renderSink_ != nullptr) {
+        ret = renderSink_->Stop();
+    }
+    isStart_ = false;
+    return ret;
 }
 
 int32_t AudioPlaybackEngine::Flush()
 {
+    std::lock_guard<std::mutex> lock(startMutex_);
+    if (renderSink_ != nullptr && spanSizeInFrame_ != 0) {
+        return renderSink_->Flush();
+    }
     return SUCCESS;
 }
 
 bool AudioPlaybackEngine::IsPlaybackEngineRunning() const noexcept
 {
-    return false;
+    return isStart_;
+}
+
+int32_t AudioPlaybackEngine::InitSink()
+{
+    if (!isSinkInjected_) {
+        renderSink_ = AudioRendererSink::GetInstance(DIRECT_MIX_SINK_NAME);
+    }
+    CHECK_AND_RETURN_RET_LOG(renderSink_ != nullptr, ERR_INVALID_HANDLE, "null sink");
+    IAudioSinkAttr attr = {};
+    attr.adapterName = SINK_ADAPTER_NAME;
+    attr.sampleRate = sinkStreamInfo_.samplingRate;
+    attr.channel = sinkStreamInfo_.channels;
+    attr.format = GetHdiFormat(sinkStreamInfo_.format);
+    attr.channelLayout = sinkStreamInfo_.channels >= STEREO ? HDI_STEREO_CHANNEL_LAYOUT : HDI_MONO_CHANNEL_LAYOUT;
+    attr.deviceType = device_.deviceType;
+    attr.volume = 1.0f;
+    attr.openMicSpeaker = 1;
+    AUDIO_INFO_LOG("rate:%{public}u format:%{public}d channel:%{public}u", attr.sampleRate, attr.format,
+        attr.channel);
+    if (!renderSink_->IsInited()) {
+        int32_t ret = renderSink_->Init(attr);
+        CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "sink init failed: %{public}d", ret);
+    }
+    float volume = 1.0f;
+    renderSink_->SetVolume(volume, volume);
+
+    spanSizeInFrame_ = static_cast<size_t>(sinkStreamInfo_.samplingRate) * PERIOD_MS / MILLISECOND_PER_SECOND;
+    size_t sampleCount = spanSizeInFrame_ * sinkStreamInfo_.channels;
+    mixBuffer_.resize(sampleCount);
+    sinkBuffer_.resize(sampleCount * GetFormatByteSize(sinkStreamInfo_.format));
+    return SUCCESS;
+}
+
+void AudioPlaybackEngine::DeInitSink()
+{
+    // an injected sink is released by its owner
+    if (!isSinkInjected_ && renderSink_ != nullptr && renderSink_->IsInited()) {
+        renderSink_->DeInit();
+        renderSink_ = nullptr;
+    }
+    spanSizeInFrame_ = 0;
+}
+
+void AudioPlaybackEngine::MixStreams()
+{
+    // Init, Start, Stop and Pause wait for this thread while holding startMutex_, so never block on it here
+    std::unique_lock<std::mutex> startLock(startMutex_, std::try_to_lock);
+    if (!startLock.owns_lock()) {
+        ClockTime::RelativeSleep(LOCK_RETRY_NS);
+        return;
+    }
+    if (renderSink_ == nullptr || spanSizeInFrame_ == 0) {
+        startLock.unlock();
+        ClockTime::RelativeSleep(PERIOD_NS);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        mixingStreams_.assign(streams_.begin(), streams_.end());
+    }
+    size_t streamCount = mixingStreams_.size();
+    if (peekBuffers_.size() < streamCount) {
+        peekBuffers_.resize(streamCount);
+        peekIndexes_.resize(streamCount);
+    }
+    mixDataList_.clear();
+    appsUid_.clear();
+    for (size_t i = 0; i < streamCount; i++) {
+        peekIndexes_[i] = -1;
+        int32_t ret = mixingStreams_[i]->Peek(&peekBuffers_[i], peekIndexes_[i]);
+        if (ret != SUCCESS || peekIndexes_[i] < 0 || peekBuffers_[i].empty()) {
+            continue;
+        }
+        AudioStreamData streamData = {};
+        streamData.streamInfo = mixingStreams_[i]->GetOutputStreamInfo();
+        streamData.bufferDesc = {reinterpret_cast<uint8_t *>(peekBuffers_[i].data()), peekBuffers_[i].size(),
+            peekBuffers_[i].size(), nullptr, 0};
+        // stream volume is already applied by the stream itself
+        streamData.volumeStart = 1 << VOLUME_SHIFT_NUMBER;
+        streamData.volumeEnd = 1 << VOLUME_SHIFT_NUMBER;
+        mixDataList_.push_back(streamData);
+        appsUid_.push_back(mixingStreams_[i]->GetAudioProcessConfig().appInfo.appUid);
+    }
+    writeCount_++;
+
+    if (mixDataList_.empty()) {
+        ReturnPeekedBuffers();
+        // a running stream that is late is waited for, only an engine without running streams stands by
+        if (runningCount_ > 0) {
+            idleCount_ = 0;
+        } else if (++idleCount_ >= IDLE_STANDBY_COUNT) {
+            EnterStandby();
+            return;
+        }
+        startLock.unlock();
+        StandbySleep();
+        return;
+    }
+    idleCount_ = 0;
+
+    Trace trace("AudioPlaybackEngine::MixStreams");
+    AudioStreamData dstData = {};
+    dstData.streamInfo = sinkStreamInfo_;
+    dstData.bufferDesc = {reinterpret_cast<uint8_t *>(sinkBuffer_.data()), sinkBuffer_.size(), sinkBuffer_.size(),
+        nullptr, 0};
+    int32_t ret = MixTools::Mix(mixDataList_, dstData, mixBuffer_, mixConverters_);
+    ReturnPeekedBuffers();
+    if (ret == SUCCESS) {
+        uint64_t written = 0;
+        renderSink_->RenderFrame(*sinkBuffer_.data(), sinkBuffer_.size(), written);
+        renderSink_->UpdateAppsUid(appsUid_);
+    }
+    startLock.unlock();
+    StandbySleep();
+}
+
+void AudioPlaybackEngine::ReturnPeekedBuffers()
+{
+    for (size_t i = 0; i < mixingStreams_.size(); i++) {
+        if (peekIndexes_[i] >= 0) {
+            mixingStreams_[i]->ReturnIndex(peekIndexes_[i]);
+            peekIndexes_[i] = -1;
+        }
+    }
+    // do not keep released streams alive until the next period
+    mixingStreams_.clear();
+}
+
+// Called by MixStreams with startMutex_ held.
+void AudioPlaybackEngine::EnterStandby()
+{
+    idleCount_ = 0;
+    if (runningCount_ > 0) {
+        // a stream was started meanwhile
+        StandbySleep();
+        return;
+    }
+    AUDIO_INFO_LOG("no running stream for %{public}u periods, enter standby", IDLE_STANDBY_COUNT);
+    if (playbackThread_ && playbackThread_->CheckThreadIsRunning()) {
+        playbackThread_->PauseAsync();
+    }
+    if (isStart_ && renderSink_ != nullptr) {
+        renderSink_->Stop();
+    }
+    isStart_ = false;
+}
+
+void AudioPlaybackEngine::StandbySleep()
+{
+    int64_t writeTime = fwkSyncTime_ + static_cast<int64_t>(writeCount_) * PERIOD_NS + DELTA_TIME;
+    ClockTime::AbsoluteSleep(writeTime);
 }
 } // namespace AudioStandard
 } // namespace OHOS
@@ -1213,6 +1213,14 @@ void AudioServer::SetAudioMonoState(bool audioMono)
         AUDIO_WARNING_LOG("direct = null");
     }
 
+    // Set mono for audio_renderer_sink (direct_mix)
+    IAudioRendererSink *directMixRenderSink = AudioRendererSink::GetInstance("direct_mix");
+    if (directMixRenderSink != nullptr) {
+        directMixRenderSink->SetAudioMonoState(audioMono);
+    } else {
+        AUDIO_WARNING_LOG("direct_mix = null");
+    }
+
     // Set mono for audio_renderer_sink (voip)
     IAudioRendererSink *voipRenderSink = AudioRendererSink::GetInstance("voip");
     if (voipRenderSink != nullptr) {
@@ -1262,6 +1270,14 @@ void AudioServer::SetAudioBalanceValue(float audioBalance)
         AUDIO_WARNING_LOG("direct = null");
     }
 
+    // Set balance for audio_renderer_sink (direct_mix)
+    IAudioRendererSink *directMixRenderSink = AudioRendererSink::GetInstance("direct_mix");
+    if (directMixRenderSink != nullptr) {
+        directMixRenderSink->SetAudioBalanceValue(audioBalance);
+    } else {
+        AUDIO_WARNING_LOG("direct_mix = null");
+    }
+
     // Set balance for audio_renderer_sink (voip)
     IAudioRendererSink *voipRenderSink = AudioRendererSink::GetInstance("voip");
     if (voipRenderSink != nullptr) {
@@ -19,6 +19,7 @@
 #include "audio_server_dump.h"
 #include "audio_utils.h"
 #include "audio_service.h"
+#include "pa_adapter_manager.h"
 #include "pa_adapter_tools.h"
 
 using namespace std;
@@ -48,6 +49,8 @@ void AudioServerDump::InitDumpFuncMap()
     dumpFuncMap[u"-r"] = &AudioServerDump::RecordSourceDump;
     dumpFuncMap[u"-m"] = &AudioServerDump::HDFModulesDump;
     dumpFuncMap[u"-ep"] = &AudioServerDump::PolicyHandlerDump;
+    dumpFuncMap[u"-pl"] = &AudioServerDump::PaLockDump;
+    dumpFuncMap[u"-sp"] = &AudioServerDump::StreamPoolDump;
 }
 
 void AudioServerDump::ResetPAAudioDump()
@@ -167,6 +170,8 @@ void AudioServerDump::ServerDataDump(string &dumpString)
     RecordSourceDump(dumpString);
     HDFModulesDump(dumpString);
     PolicyHandlerDump(dumpString);
+    PaLockDump(dumpString);
+    StreamPoolDump(dumpString);
 }
 
 void AudioServerDump::ArgDataDump(std::string &dumpString, std::queue<std::u16string>& argQue)
@@ -202,6 +207,8 @@ void AudioServerDump::HelpInfoDump(string &dumpString)
     AppendFormat(dumpString, "  -r\t\t\t|dump pa record streams\n");
     AppendFormat(dumpString, "  -m\t\t\t|dump hdf input modules\n");
     AppendFormat(dumpString, "  -ep\t\t\t|dump policyhandler info\n");
+    AppendFormat(dumpString, "  -pl\t\t\t|dump pa mainloop lock metrics\n");
+    AppendFormat(dumpString, "  -sp\t\t\t|dump pa stream pool\n");
 }
 
 void AudioServerDump::AudioDataDump(string &dumpString, std::queue<std::u16string>& argQue)
@@ -512,5 +519,18 @@ void AudioServerDump::PolicyHandlerDump(std::string &dumpString)
     AUDIO_INFO_LOG("PolicyHandlerDump");
     AudioService::GetInstance()->Dump(dumpString);
 }
+
+void AudioServerDump::PaLockDump(std::string &dumpString)
+{
+    AUDIO_INFO_LOG("PaLockDump");
+    PaAdapterManager::DumpLockMetrics(dumpString);
+}
+
+void AudioServerDump::StreamPoolDump(std::string &dumpString)
+{
+    AUDIO_INFO_LOG("StreamPoolDump");
+    dumpString += "PA Stream Pool\n";
+    IStreamManager::GetPlaybackManager(PLAYBACK).DumpStreamPool(dumpString);
+}
 } // namespace AudioStandard
 } // namespace OHOS
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOG_TAG
+#define LOG_TAG "CaptureFanOutBus"
+#endif
+
+#include "capture_fan_out_bus.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "audio_errors.h"
+#include "audio_service_log.h"
+#include "audio_utils.h"
+
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+    static const size_t FAN_OUT_CACHE_SPAN_NUM = 2;
+}
+
+bool CaptureFanOutKey::operator<(const CaptureFanOutKey &other) const
+{
+    return std::tie(sourceType, samplingRate, format, channels, spanSizeInBytes, appUid, appTokenId) <
+        std::tie(other.sourceType, other.samplingRate, other.format, other.channels, other.spanSizeInBytes,
+        other.appUid, other.appTokenId);
+}
+
+CaptureFanOutBus &CaptureFanOutBus::GetInstance()
+{
+    static CaptureFanOutBus captureFanOutBus;
+    return captureFanOutBus;
+}
+
+bool CaptureFanOutBus::IsSourceShareable(SourceType sourceType)
+{
+    // Inner-cap streams have their own filters and wakeup or call sources are exclusive, they are never shared.
+    switch (sourceType) {
+        case SOURCE_TYPE_MIC:
+        case SOURCE_TYPE_VOICE_RECOGNITION:
+        case SOURCE_TYPE_VOICE_MESSAGE:
+        case SOURCE_TYPE_VOICE_TRANSCRIPTION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int32_t CaptureFanOutBus::Subscribe(const CaptureFanOutKey &key, std::shared_ptr<ICaptureSubscriber> subscriber)
+{
+    CHECK_AND_RETURN_RET_LOG(subscriber != nullptr, ERR_INVALID_PARAM, "subscriber is null");
+    CHECK_AND_RETURN_RET_LOG(IsSourceShareable(key.sourceType) && key.spanSizeInBytes != 0, ERR_INVALID_PARAM,
+        "source %{public}d span size %{public}zu can not be shared", key.sourceType, key.spanSizeInBytes);
+
+    std::lock_guard<std::mutex> lock(busMutex_);
+    FanOutGroup &group = groups_[key];
+    auto iter = std::find_if(group.subscribers.begin(), group.subscribers.end(),
+        [&subscriber](const auto &item) { return item.first == subscriber.get(); });
+    if (iter != group.subscribers.end()) {
+        return SUCCESS;
+    }
+    if (group.ringCache == nullptr) {
+        group.ringCache = AudioRingCache::Create(FAN_OUT_CACHE_SPAN_NUM * key.spanSizeInBytes);
+        group.spanBuffer = std::make_unique<uint8_t []>(key.spanSizeInBytes);
+        group.silentBuffer = std::make_unique<uint8_t []>(key.spanSizeInBytes); // value initialized to zero
+        CHECK_AND_RETURN_RET_LOG(group.ringCache != nullptr, ERR_OPERATION_FAILED, "Create ring cache failed");
+    }
+    group.subscribers.emplace_back(subscriber.get(), subscriber);
+    AUDIO_INFO_LOG("source %{public}d rate %{public}d subscriber num %{public}zu", key.sourceType,
+        key.samplingRate, group.subscribers.size());
+    return SUCCESS;
+}
+
+void CaptureFanOutBus::Unsubscribe(const CaptureFanOutKey &key, const ICaptureSubscriber *subscriber)
+{
+    std::lock_guard<std::mutex> lock(busMutex_);
+    auto groupIter = groups_.find(key);
+    if (groupIter == groups_.end()) {
+        return;
+    }
+    FanOutGroup &group = groupIter->second;
+    bool isPublisher = !group.subscribers.empty() && group.subscribers.front().first == subscriber;
+    group.subscribers.erase(std::remove_if(group.subscribers.begin(), group.subscribers.end(),
+        [subscriber](const auto &item) { return item.first == subscriber; }), group.subscribers.end());
+    if (group.subscribers.empty()) {
+        groups_.erase(groupIter);
+        return;
+    }
+    if (isPublisher) {
+        // data cached from the old publisher's stream is not continuous with the next publisher's stream
+        group.ringCache->ResetBuffer();
+    }
+    AUDIO_INFO_LOG("source %{public}d rate %{public}d subscriber num %{public}zu", key.sourceType,
+        key.samplingRate, group.subscribers.size());
+}
+
+bool CaptureFanOutBus::Publish(const CaptureFanOutKey &key, const ICaptureSubscriber *publisher,
+    const BufferDesc &data)
+{
+    // declared before the lock, a subscriber released on the way must not unsubscribe while the lock is held
+    std::vector<std::shared_ptr<ICaptureSubscriber>> subscribers;
+    std::lock_guard<std::mutex> lock(busMutex_);
+    auto groupIter = groups_.find(key);
+    if (groupIter == groups_.end() || groupIter->second.subscribers.front().first != publisher) {
+        return false;
+    }
+    FanOutGroup &group = groupIter->second;
+    for (auto &item : group.subscribers) {
+        std::shared_ptr<ICaptureSubscriber> subscriber = item.second.lock();
+        if (subscriber != nullptr) {
+            subscribers.push_back(subscriber);
+        }
+    }
+    Trace trace = Trace::Format("CaptureFanOutBus::Publish:%zu", subscribers.size());
+    size_t offset = 0;
+    while (data.buffer != nullptr && offset < data.bufLength) {
+        OptResult result = group.ringCache->GetWritableSize();
+        CHECK_AND_BREAK_LOG(result.ret == OPERATION_SUCCESS && result.size != 0, "ring cache is not writable");
+        size_t enqueueSize = std::min(result.size, data.bufLength - offset);
+        group.ringCache->Enqueue({data.buffer + offset, enqueueSize});
+        offset += enqueueSize;
+        DeliverSpans(group, key.spanSizeInBytes, subscribers);
+    }
+    return true;
+}
+
+void CaptureFanOutBus::DeliverSpans(FanOutGroup &group, size_t spanSizeInBytes,
+    const std::vector<std::shared_ptr<ICaptureSubscriber>> &subscribers)
+{
+    OptResult result = group.ringCache->GetReadableSize();
+    while (result.ret == OPERATION_SUCCESS && result.size >= spanSizeInBytes) {
+        group.ringCache->Dequeue({group.spanBuffer.get(), spanSizeInBytes});
+        BufferDesc span = {group.spanBuffer.get(), spanSizeInBytes, spanSizeInBytes};
+        BufferDesc silentSpan = {group.silentBuffer.get(), spanSizeInBytes, spanSizeInBytes};
+        for (auto &subscriber : subscribers) {
+            // the mute state is checked per span, a muted subscriber never sees the data of the others
+            subscriber->OnCaptureSpan(subscriber->IsCaptureMuted() ? silentSpan : span);
+        }
+        result = group.ringCache->GetReadableSize();
+    }
+}
+
+size_t CaptureFanOutBus::GetSubscriberCount(const CaptureFanOutKey &key)
+{
+    std::lock_guard<std::mutex> lock(busMutex_);
+    auto groupIter = groups_.find(key);
+    return groupIter == groups_.end() ? 0 : groupIter->second.subscribers.size();
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -24,6 +24,7 @@
 #include "audio_service_log.h"
 #include "audio_service.h"
 #include "audio_process_config.h"
+#include "futex_tool.h"
 #include "i_stream_manager.h"
 #include "playback_capturer_manager.h"
 #include "media_monitor_manager.h"
@@ -128,6 +129,9 @@ int32_t CapturerInServer::Init()
     streamIndex_ = stream_->GetStreamIndex();
     ret = ConfigServerBuffer();
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ERR_OPERATION_FAILED, "ConfigServerBuffer failed: %{public}d", ret);
+    fanOutKey_ = {processConfig_.capturerInfo.sourceType, processConfig_.streamInfo.samplingRate,
+        processConfig_.streamInfo.format, processConfig_.streamInfo.channels, spanSizeInBytes_,
+        processConfig_.appInfo.appUid, processConfig_.appInfo.appTokenId};
     stream_->RegisterStatusCallback(shared_from_this());
     stream_->RegisterReadCallback(shared_from_this());
 
@@ -159,6 +163,7 @@ void CapturerInServer::OnStatusUpdate(IOperation operation)
             break;
         case OPERATION_STARTED:
             status_ = I_STATUS_STARTED;
+            JoinFanOutBus();
             stateListener->OnOperationHandled(START_STREAM, 0);
             break;
         case OPERATION_PAUSED:
@@ -192,36 +197,61 @@ BufferDesc CapturerInServer::DequeueBuffer(size_t length)
     return stream_->DequeueBuffer(length);
 }
 
-bool CapturerInServer::IsReadDataOverFlow(size_t length, uint64_t currentWriteFrame,
-    std::shared_ptr<IStreamListener> stateListener)
+bool CapturerInServer::IsServerBufferFull()
 {
-    if (audioServerBuffer_->GetAvailableDataFrames() <= static_cast<int32_t>(spanSizeInFrame_)) {
-        if (overFlowLogFlag_ == 0) {
-            AUDIO_INFO_LOG("OverFlow!!!");
-        } else if (overFlowLogFlag_ == OVERFLOW_LOG_LOOP_COUNT) {
-            overFlowLogFlag_ = 0;
-        }
-        overFlowLogFlag_++;
-        BufferDesc dstBuffer = stream_->DequeueBuffer(length);
-        stream_->EnqueueBuffer(dstBuffer);
-        stateListener->OnOperationHandled(UPDATE_STREAM, currentWriteFrame);
-        return true;
+    if (audioServerBuffer_->GetAvailableDataFrames() > static_cast<int32_t>(spanSizeInFrame_)) {
+        return false;
+    }
+    if (overFlowLogFlag_ == 0) {
+        AUDIO_INFO_LOG("OverFlow!!!");
+    } else if (overFlowLogFlag_ == OVERFLOW_LOG_LOOP_COUNT) {
+        overFlowLogFlag_ = 0;
+    }
+    overFlowLogFlag_++;
+    // the reader may be waiting with a stale futex value, wake it to drain the buffer
+    FutexTool::FutexWake(audioServerBuffer_->GetFutex());
+    return true;
+}
+
+bool CapturerInServer::IsReadDataOverFlow(size_t length)
+{
+    if (!IsServerBufferFull()) {
+        return false;
     }
-    return false;
+    BufferDesc dstBuffer = stream_->DequeueBuffer(length);
+    stream_->EnqueueBuffer(dstBuffer);
+    return true;
+}
+
+void CapturerInServer::PublishSpan(uint64_t currentWriteFrame, const BufferDesc &dstBuffer)
+{
+    DumpFileUtil::WriteDumpFile(dumpS2C_, static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength);
+    if (AudioDump::GetInstance().GetVersionType() == BETA_VERSION) {
+        Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
+            static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength);
+    }
+
+    uint64_t nextWriteFrame = currentWriteFrame + spanSizeInFrame_;
+    audioServerBuffer_->SetCurWriteFrame(nextWriteFrame);
+    audioServerBuffer_->SetHandleInfo(currentWriteFrame, ClockTime::GetCurNano());
+    // readers wait on the futex of the shared buffer, no ipc is needed per span.
+    FutexTool::FutexWake(audioServerBuffer_->GetFutex());
 }
 
 void CapturerInServer::ReadData(size_t length)
 {
     CHECK_AND_RETURN_LOG(length >= spanSizeInBytes_,
         "Length %{public}zu is less than spanSizeInBytes %{public}zu", length, spanSizeInBytes_);
-    std::shared_ptr<IStreamListener> stateListener = streamListener_.lock();
-    CHECK_AND_RETURN_LOG(stateListener != nullptr, "IStreamListener is nullptr");
+    if (isFanOutJoined_) {
+        ReadSharedData(length);
+        return;
+    }
 
     uint64_t currentWriteFrame = audioServerBuffer_->GetCurWriteFrame();
-    if (IsReadDataOverFlow(length, currentWriteFrame, stateListener)) {
+    if (IsReadDataOverFlow(length)) {
         return;
     }
-    Trace trace("CapturerInServer::ReadData:" + std::to_string(currentWriteFrame));
+    Trace trace = Trace::Format("CapturerInServer::ReadData:%" PRIu64, currentWriteFrame);
     OptResult result = ringCache_->GetWritableSize();
     CHECK_AND_RETURN_LOG(result.ret == OPERATION_SUCCESS, "RingCache write invalid size %{public}zu", result.size);
     BufferDesc srcBuffer = stream_->DequeueBuffer(result.size);
@@ -245,23 +275,64 @@ void CapturerInServer::ReadData(size_t length)
         memset_s(static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength, 0, dstBuffer.bufLength);
     }
     ringCache_->Dequeue({dstBuffer.buffer, dstBuffer.bufLength});
-    DumpFileUtil::WriteDumpFile(dumpS2C_, static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength);
-    if (AudioDump::GetInstance().GetVersionType() == BETA_VERSION) {
-        Media::MediaMonitor::MediaMonitorManager::GetInstance().WriteAudioBuffer(dumpFileName_,
-            static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength);
-    }
+    PublishSpan(currentWriteFrame, dstBuffer);
 
-    uint64_t nextWriteFrame = currentWriteFrame + spanSizeInFrame_;
-    audioServerBuffer_->SetCurWriteFrame(nextWriteFrame);
-    audioServerBuffer_->SetHandleInfo(currentWriteFrame, ClockTime::GetCurNano());
+    stream_->EnqueueBuffer(srcBuffer);
+}
 
+void CapturerInServer::ReadSharedData(size_t length)
+{
+    // Only the publisher of the bus copies its data, the bus calls OnCaptureSpan of every subscriber. The other
+    // subscribers get the same data from the bus and just drain their own stream.
+    BufferDesc srcBuffer = stream_->DequeueBuffer(length);
+    CaptureFanOutBus::GetInstance().Publish(fanOutKey_, this, srcBuffer);
     stream_->EnqueueBuffer(srcBuffer);
-    stateListener->OnOperationHandled(UPDATE_STREAM, currentWriteFrame);
+}
+
+void CapturerInServer::OnCaptureSpan(const BufferDesc &span)
+{
+    CHECK_AND_RETURN_LOG(span.bufLength == spanSizeInBytes_, "invalid span size %{public}zu", span.bufLength);
+    if (IsServerBufferFull()) {
+        return;
+    }
+    uint64_t currentWriteFrame = audioServerBuffer_->GetCurWriteFrame();
+    Trace trace = Trace::Format("CapturerInServer::OnCaptureSpan:%" PRIu64, currentWriteFrame);
+    BufferDesc dstBuffer = {nullptr, 0, 0};
+    if (audioServerBuffer_->GetWriteBuffer(currentWriteFrame, dstBuffer) < 0) {
+        return;
+    }
+    // the bus hands a silent span to muted subscribers
+    memcpy_s(static_cast<void *>(dstBuffer.buffer), dstBuffer.bufLength, span.buffer, span.bufLength);
+    PublishSpan(currentWriteFrame, dstBuffer);
+}
+
+bool CapturerInServer::IsCaptureMuted()
+{
+    return muteFlag_;
+}
+
+void CapturerInServer::JoinFanOutBus()
+{
+    if (!CaptureFanOutBus::IsSourceShareable(processConfig_.capturerInfo.sourceType) || isFanOutJoined_) {
+        return;
+    }
+    int32_t ret = CaptureFanOutBus::GetInstance().Subscribe(fanOutKey_, shared_from_this());
+    CHECK_AND_RETURN_LOG(ret == SUCCESS, "Subscribe capture fan out bus failed: %{public}d", ret);
+    isFanOutJoined_ = true;
+}
+
+void CapturerInServer::LeaveFanOutBus()
+{
+    if (!isFanOutJoined_) {
+        return;
+    }
+    isFanOutJoined_ = false;
+    CaptureFanOutBus::GetInstance().Unsubscribe(fanOutKey_, this);
 }
 
 int32_t CapturerInServer::OnReadData(size_t length)
 {
-    Trace trace("CapturerInServer::OnReadData:" + std::to_string(length));
+    Trace trace = Trace::Format("CapturerInServer::OnReadData:%zu", length);
     ReadData(length);
     return SUCCESS;
 }
@@ -331,6 +402,7 @@ int32_t CapturerInServer::Pause()
         uint32_t tokenId = processConfig_.appInfo.appTokenId;
         PermissionUtil::NotifyPrivacy(tokenId, AUDIO_PERMISSION_STOP);
     }
+    LeaveFanOutBus();
     status_ = I_STATUS_PAUSING;
     int ret = stream_->Pause();
     CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "Pause stream failed, reason: %{public}d", ret);
@@ -386,6 +458,7 @@ int32_t CapturerInServer::Stop()
         return ERR_ILLEGAL_STATE;
     }
     status_ = I_STATUS_STOPPING;
+    LeaveFanOutBus();
 
     if (needCheckBackground_) {
         uint32_t tokenId = processConfig_.appInfo.appTokenId;
@@ -408,6 +481,7 @@ int32_t CapturerInServer::Release()
         }
     }
     AUDIO_INFO_LOG("Start release capturer");
+    LeaveFanOutBus();
     int32_t ret = IStreamManager::GetRecorderManager().ReleaseCapturer(streamIndex_);
     if (ret < 0) {
         AUDIO_ERR_LOG("Release stream failed, reason: %{public}d", ret);
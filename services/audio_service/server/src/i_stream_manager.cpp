@@ -24,6 +24,9 @@ IStreamManager &IStreamManager::GetPlaybackManager(ManagerType managerType)
         case DIRECT_PLAYBACK:
             static ProAudioStreamManager directManager(DIRECT_PLAYBACK);
             return directManager;
+        case MIX_PLAYBACK:
+            static ProAudioStreamManager mixManager(MIX_PLAYBACK);
+            return mixManager;
         case VOIP_PLAYBACK:
             static ProAudioStreamManager voipManager(VOIP_PLAYBACK);
             return voipManager;
@@ -19,6 +19,12 @@
 #include "pa_adapter_manager.h"
 #include <sstream>
 #include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+#include <tuple>
+#include <unistd.h>
 #include "audio_service_log.h"
 #include "audio_errors.h"
 #include "audio_schedule.h"
@@ -36,6 +42,22 @@ const uint64_t BUF_LENGTH_IN_MSEC = 20;
 static const uint32_t PA_RECORD_MAX_LENGTH_NORMAL = 4;
 static const uint32_t PA_RECORD_MAX_LENGTH_WAKEUP = 30;
 static const int32_t CONNECT_STREAM_TIMEOUT_IN_SEC = 8; // 8S
+static const uint32_t PA_CONTEXT_SHARD_NUM_MAX = 4;
+static const uint32_t PA_STREAM_NUM_PER_SHARD = 8; // a new mainloop is only added when every one holds this many
+static const int32_t PA_STREAM_POOL_SIZE_DEFAULT = 2;
+static const int32_t PA_STREAM_POOL_SIZE_MAX = 8;
+static const size_t PA_STREAM_POOL_KEY_NUM_MAX = 4;
+static const uint32_t PA_POOLED_STREAM_SESSION_ID = 0;
+static const int32_t PA_STREAM_RETAG_TIMEOUT_IN_SEC = 1;
+
+// Filled by PAStreamUpdateStreamIndexSuccessCb, or by PAStreamRetagTimeoutCb if no reply comes in time, while the
+// caller waits on the mainloop.
+struct PaStreamRetagResult {
+    pa_threaded_mainloop *mainLoop = nullptr;
+    bool isSuccess = false;
+    bool isTimeout = false;
+};
+
 static const std::unordered_map<AudioStreamType, std::string> STREAM_TYPE_ENUM_STRING_MAP = {
     {STREAM_VOICE_CALL, "voice_call"},
     {STREAM_MUSIC, "music"},
@@ -86,19 +108,25 @@ static bool IsEnhanceMode(SourceType sourceType)
 PaAdapterManager::PaAdapterManager(ManagerType type)
 {
     AUDIO_INFO_LOG("Constructor with type:%{public}d", type);
-    mainLoop_ = nullptr;
-    api_ = nullptr;
-    context_ = nullptr;
-    isContextConnected_ = false;
-    isMainLoopStarted_ = false;
     managerType_ = type;
+    if (managerType_ == PLAYBACK) {
+        int32_t poolSize = PA_STREAM_POOL_SIZE_DEFAULT;
+        GetSysPara("persist.multimedia.audio.streampoolsize", poolSize);
+        streamPoolSize_ = static_cast<uint32_t>(std::clamp(poolSize, 0, PA_STREAM_POOL_SIZE_MAX));
+    }
+    int32_t lockMetricsFlag = 0;
+    GetSysPara("persist.multimedia.audio.palockmetrics", lockMetricsFlag);
+    PaLockMetrics::SetEnabled(lockMetricsFlag == 1);
+}
+
+PaAdapterManager::~PaAdapterManager()
+{
+    StopStreamPool();
 }
 
 int32_t PaAdapterManager::CreateRender(AudioProcessConfig processConfig, std::shared_ptr<IRendererStream> &stream)
 {
     AUDIO_DEBUG_LOG("Create renderer start");
-    int32_t ret = InitPaContext();
-    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "Failed to init pa context");
     uint32_t sessionId = 0;
     if (processConfig.originalSessionId < MIN_SESSIONID || processConfig.originalSessionId > MAX_SESSIONID) {
         sessionId = PolicyHandler::GetInstance().GenerateSessionId(processConfig.appInfo.appUid);
@@ -106,17 +134,37 @@ int32_t PaAdapterManager::CreateRender(AudioProcessConfig processConfig, std::sh
         sessionId = processConfig.originalSessionId;
     }
     AUDIO_DEBUG_LOG("Create [%{public}d] type renderer:[%{public}u]", managerType_, sessionId);
-
-    // PaAdapterManager is solely responsible for creating paStream objects
-    // while the PaRendererStreamImpl has full authority over the subsequent management of the paStream
-    pa_stream *paStream = InitPaStream(processConfig, sessionId, false);
-    CHECK_AND_RETURN_RET_LOG(paStream != nullptr, ERR_OPERATION_FAILED, "Failed to init render");
-    std::shared_ptr<IRendererStream> rendererStream = CreateRendererStream(processConfig, paStream);
-    CHECK_AND_RETURN_RET_LOG(rendererStream != nullptr, ERR_DEVICE_INIT, "Failed to init pa stream");
+    bool isPoolable = IsStreamPoolable(processConfig);
+    PaContextShard *shard = nullptr;
+    pa_stream *paStream = isPoolable ? TakePooledStream(processConfig, sessionId, shard) : nullptr;
+    if (paStream == nullptr) {
+        shard = AttachShard(sessionId);
+        CHECK_AND_RETURN_RET_LOG(shard != nullptr, ERR_DEVICE_INIT, "Failed to init pa context");
+
+        // PaAdapterManager is solely responsible for creating paStream objects
+        // while the PaRendererStreamImpl has full authority over the subsequent management of the paStream
+        paStream = InitPaStream(processConfig, sessionId, false, *shard);
+        if (paStream == nullptr) {
+            AUDIO_ERR_LOG("Failed to init render");
+            DetachShard(sessionId);
+            return ERR_OPERATION_FAILED;
+        }
+    }
+    std::shared_ptr<IRendererStream> rendererStream = CreateRendererStream(processConfig, paStream, shard->mainLoop);
+    if (rendererStream == nullptr) {
+        AUDIO_ERR_LOG("Failed to init pa stream");
+        DetachShard(sessionId);
+        return ERR_DEVICE_INIT;
+    }
     rendererStream->SetStreamIndex(sessionId);
-    std::lock_guard<std::mutex> lock(streamMapMutex_);
-    rendererStreamMap_[sessionId] = rendererStream;
+    {
+        std::lock_guard<std::mutex> lock(streamMapMutex_);
+        rendererStreamMap_[sessionId] = rendererStream;
+    }
     stream = rendererStream;
+    if (isPoolable) {
+        StartStreamPoolRefill(processConfig);
+    }
     return SUCCESS;
 }
 
@@ -134,6 +182,7 @@ int32_t PaAdapterManager::ReleaseRender(uint32_t streamIndex)
     rendererStreamMap_.erase(streamIndex);
     lock.unlock();
 
+    DetachShard(streamIndex);
     if (currentRender->Release() < 0) {
         AUDIO_WARNING_LOG("Release stream %{public}d failed", streamIndex);
         return ERR_OPERATION_FAILED;
@@ -204,8 +253,6 @@ int32_t PaAdapterManager::CreateCapturer(AudioProcessConfig processConfig, std::
 {
     AUDIO_DEBUG_LOG("Create capturer start");
     CHECK_AND_RETURN_RET_LOG(managerType_ == RECORDER, ERROR, "Invalid managerType:%{public}d", managerType_);
-    int32_t ret = InitPaContext();
-    CHECK_AND_RETURN_RET_LOG(ret == SUCCESS, ret, "Failed to init pa context");
     uint32_t sessionId = 0;
     if (processConfig.originalSessionId < MIN_SESSIONID || processConfig.originalSessionId > MAX_SESSIONID) {
         sessionId = PolicyHandler::GetInstance().GenerateSessionId(processConfig.appInfo.appUid);
@@ -213,12 +260,23 @@ int32_t PaAdapterManager::CreateCapturer(AudioProcessConfig processConfig, std::
         sessionId = processConfig.originalSessionId;
     }
 
+    PaContextShard *shard = AttachShard(sessionId);
+    CHECK_AND_RETURN_RET_LOG(shard != nullptr, ERR_DEVICE_INIT, "Failed to init pa context");
+
     // PaAdapterManager is solely responsible for creating paStream objects
     // while the PaCapturerStreamImpl has full authority over the subsequent management of the paStream
-    pa_stream *paStream = InitPaStream(processConfig, sessionId, true);
-    CHECK_AND_RETURN_RET_LOG(paStream != nullptr, ERR_OPERATION_FAILED, "Failed to init capture");
-    std::shared_ptr<ICapturerStream> capturerStream = CreateCapturerStream(processConfig, paStream);
-    CHECK_AND_RETURN_RET_LOG(capturerStream != nullptr, ERR_DEVICE_INIT, "Failed to init pa stream");
+    pa_stream *paStream = InitPaStream(processConfig, sessionId, true, *shard);
+    if (paStream == nullptr) {
+        AUDIO_ERR_LOG("Failed to init capture");
+        DetachShard(sessionId);
+        return ERR_OPERATION_FAILED;
+    }
+    std::shared_ptr<ICapturerStream> capturerStream = CreateCapturerStream(processConfig, paStream, shard->mainLoop);
+    if (capturerStream == nullptr) {
+        AUDIO_ERR_LOG("Failed to init pa stream");
+        DetachShard(sessionId);
+        return ERR_DEVICE_INIT;
+    }
     capturerStream->SetStreamIndex(sessionId);
     std::lock_guard<std::mutex> lock(streamMapMutex_);
     capturerStreamMap_[sessionId] = capturerStream;
@@ -243,61 +301,350 @@ int32_t PaAdapterManager::ReleaseCapturer(uint32_t streamIndex)
 
     capturerStreamMap_[streamIndex] = nullptr;
     capturerStreamMap_.erase(streamIndex);
+    DetachShard(streamIndex);
     if (capturerStreamMap_.size() == 0) {
         AUDIO_INFO_LOG("Release the last stream");
     }
     return SUCCESS;
 }
 
-int32_t PaAdapterManager::ResetPaContext()
+void PaAdapterManager::DumpLockMetrics(std::string &dumpString)
 {
-    AUDIO_DEBUG_LOG("Enter ResetPaContext");
-    if (context_) {
-        pa_context_set_state_callback(context_, nullptr, nullptr);
-        if (isContextConnected_ == true) {
-            PaLockGuard lock(mainLoop_);
-            pa_context_disconnect(context_);
-            pa_context_unref(context_);
-            isContextConnected_ = false;
-            context_ = nullptr;
+    dumpString += "PA Mainloop Lock Metrics\n";
+    if (!PaLockMetrics::IsEnabled()) {
+        dumpString += "  - off, set persist.multimedia.audio.palockmetrics to 1 and restart audio_server\n";
+        return;
+    }
+    for (const PaLockStats &stats : PaLockMetrics::GetStatsList()) {
+        if (stats.mainloop.load() == nullptr) {
+            continue;
         }
+        uint64_t lockCount = stats.lockCount.load();
+        int64_t avgWaitNs = lockCount == 0 ? 0 : stats.totalWaitNs.load() / static_cast<int64_t>(lockCount);
+        int64_t avgHoldNs = lockCount == 0 ? 0 : stats.totalHoldNs.load() / static_cast<int64_t>(lockCount);
+        AppendFormat(dumpString, "  - %s: lock count %" PRIu64 ", slow wait count %" PRIu64 "\n", stats.name,
+            lockCount, stats.slowWaitCount.load());
+        AppendFormat(dumpString, "    wait avg %" PRId64 "ns max %" PRId64 "ns, hold avg %" PRId64 "ns max %" PRId64
+            "ns\n", avgWaitNs, stats.maxWaitNs.load(), avgHoldNs, stats.maxHoldNs.load());
     }
+}
 
-    if (mainLoop_) {
-        pa_threaded_mainloop_free(mainLoop_);
-        isMainLoopStarted_  = false;
-        mainLoop_ = nullptr;
+PaContextShard *PaAdapterManager::AttachShard(uint32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(paElementsMutex_);
+    PaContextShard *target = SelectShard();
+    CHECK_AND_RETURN_RET(target != nullptr, nullptr);
+    streamShardMap_[sessionId] = target;
+    return target;
+}
+
+PaContextShard *PaAdapterManager::SelectShard()
+{
+    PaContextShard *target = nullptr;
+    for (auto &shard : shards_) {
+        if (target == nullptr || shard->streamCount < target->streamCount) {
+            target = shard.get();
+        }
+    }
+    if (target == nullptr || (target->streamCount >= PA_STREAM_NUM_PER_SHARD && shards_.size() < GetShardNumMax())) {
+        auto shard = std::make_unique<PaContextShard>();
+        shard->index = shards_.size();
+        if (InitPaContext(*shard) == SUCCESS) {
+            AUDIO_INFO_LOG("Add pa context shard %{public}u", shard->index);
+            target = shard.get();
+            shards_.push_back(std::move(shard));
+        } else {
+            ResetPaContext(*shard);
+            // the existing shards are still usable if an extra one fails
+            CHECK_AND_RETURN_RET_LOG(target != nullptr, nullptr, "Failed to init pa context");
+        }
     }
+    target->streamCount++;
+    return target;
+}
 
-    api_ = nullptr;
-    return SUCCESS;
+void PaAdapterManager::DetachShard(uint32_t sessionId)
+{
+    std::lock_guard<std::mutex> lock(paElementsMutex_);
+    auto iter = streamShardMap_.find(sessionId);
+    if (iter == streamShardMap_.end()) {
+        return;
+    }
+    if (iter->second->streamCount > 0) {
+        iter->second->streamCount--;
+    }
+    streamShardMap_.erase(iter);
 }
 
-int32_t PaAdapterManager::InitPaContext()
+bool PaStreamPoolKey::operator<(const PaStreamPoolKey &other) const
 {
-    AUDIO_DEBUG_LOG("Enter InitPaContext");
+    return std::tie(streamUsage, samplingRate, format, channels) <
+        std::tie(other.streamUsage, other.samplingRate, other.format, other.channels);
+}
+
+bool PaAdapterManager::IsStreamPoolable(const AudioProcessConfig &processConfig)
+{
+    if (managerType_ != PLAYBACK || streamPoolSize_ == 0 || processConfig.audioMode != AUDIO_MODE_PLAYBACK) {
+        return false;
+    }
+    const AudioStreamInfo &streamInfo = processConfig.streamInfo;
+    if (streamInfo.channelLayout != 0 && streamInfo.channelLayout != defaultChCountToLayoutMap[streamInfo.channels]) {
+        return false;
+    }
+    // short sounds whose startup time is noticeable, all of them go without effect chain
+    switch (processConfig.rendererInfo.streamUsage) {
+        case STREAM_USAGE_SYSTEM:
+        case STREAM_USAGE_NOTIFICATION:
+        case STREAM_USAGE_DTMF:
+        case STREAM_USAGE_ENFORCED_TONE:
+        case STREAM_USAGE_NAVIGATION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+pa_stream *PaAdapterManager::TakePooledStream(AudioProcessConfig processConfig, uint32_t sessionId,
+    PaContextShard *&shard)
+{
+    PaStreamPoolKey key = {processConfig.rendererInfo.streamUsage, processConfig.streamInfo.samplingRate,
+        processConfig.streamInfo.format, processConfig.streamInfo.channels};
+    PooledPaStream pooled;
+    {
+        std::lock_guard<std::mutex> lock(streamPoolMutex_);
+        auto iter = streamPool_.find(key);
+        if (iter == streamPool_.end() || iter->second.empty()) {
+            streamPoolMissCount_++;
+            return nullptr;
+        }
+        pooled = iter->second.back();
+        iter->second.pop_back();
+    }
+
+    PaLockGuard palock(pooled.shard->mainLoop);
+    if (pa_stream_get_state(pooled.paStream) != PA_STREAM_READY) {
+        AUDIO_WARNING_LOG("Pooled stream is not ready, drop it");
+        palock.Unlock();
+        ReleasePooledStream(pooled);
+        streamPoolMissCount_++;
+        return nullptr;
+    }
+    if (!RetagPooledStream(pooled, processConfig, sessionId)) {
+        palock.Unlock();
+        ReleasePooledStream(pooled);
+        streamPoolMissCount_++;
+        return nullptr;
+    }
+    palock.Unlock();
+
+    {
+        std::lock_guard<std::mutex> lock(paElementsMutex_);
+        streamShardMap_[sessionId] = pooled.shard;
+    }
+    streamPoolHitCount_++;
+    shard = pooled.shard;
+    AUDIO_INFO_LOG("Renderer %{public}u takes a pooled stream", sessionId);
+    return pooled.paStream;
+}
+
+bool PaAdapterManager::RetagPooledStream(const PooledPaStream &pooled, AudioProcessConfig &processConfig,
+    uint32_t sessionId)
+{
+    pa_proplist *propList = pa_proplist_new();
+    pa_channel_map map;
+    if (propList == nullptr || SetPaProplist(propList, map, processConfig,
+        GetStreamName(processConfig.streamType), sessionId) != SUCCESS) {
+        AUDIO_ERR_LOG("Set proplist of pooled stream failed");
+        if (propList != nullptr) {
+            pa_proplist_free(propList);
+        }
+        return false;
+    }
+    // re-tag the stream with the session and client of the renderer, the sink modules pick it up in their
+    // proplist changed hooks. Wait for it, the renderer must not start under the tags of the pool.
+    PaStreamRetagResult result = {pooled.shard->mainLoop, false};
+    pa_operation *operation = pa_stream_proplist_update(pooled.paStream, PA_UPDATE_REPLACE, propList,
+        PAStreamUpdateStreamIndexSuccessCb, reinterpret_cast<void *>(&result));
+    pa_proplist_free(propList);
+    CHECK_AND_RETURN_RET_LOG(operation != nullptr, false, "Update proplist of pooled stream failed");
+    // the timer wakes the wait below if the reply never comes, the renderer then gets a new stream
+    pa_time_event *timer = pa_context_rttime_new(pooled.shard->context,
+        pa_rtclock_now() + PA_STREAM_RETAG_TIMEOUT_IN_SEC * PA_USEC_PER_SEC, PAStreamRetagTimeoutCb,
+        reinterpret_cast<void *>(&result));
+    while (timer != nullptr && !result.isTimeout && pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
+        pa_threaded_mainloop_wait(pooled.shard->mainLoop);
+    }
+    if (timer != nullptr) {
+        pooled.shard->api->time_free(timer);
+    }
+    if (pa_operation_get_state(operation) == PA_OPERATION_RUNNING) {
+        // the callback must not touch result once this function returns
+        AUDIO_WARNING_LOG("Retag pooled stream for %{public}u timed out", sessionId);
+        pa_operation_cancel(operation);
+    }
+    pa_operation_unref(operation);
+    CHECK_AND_RETURN_RET_LOG(result.isSuccess, false, "Retag pooled stream for %{public}u failed", sessionId);
+    return true;
+}
+
+void PaAdapterManager::ReleasePooledStream(const PooledPaStream &pooled)
+{
+    ReleasePaStream(pooled.shard->mainLoop, pooled.paStream);
     std::lock_guard<std::mutex> lock(paElementsMutex_);
-    if (context_ != nullptr) {
-        AUDIO_INFO_LOG("Context is not null, return");
-        return SUCCESS;
+    if (pooled.shard->streamCount > 0) {
+        pooled.shard->streamCount--;
+    }
+}
+
+void PaAdapterManager::StartStreamPoolRefill(const AudioProcessConfig &processConfig)
+{
+    if (isStreamPoolStopped_ || isStreamPoolRefilling_.exchange(true)) {
+        return;
+    }
+    // only the caller that flipped the flag gets here, the previous refill has already returned
+    if (streamPoolRefillThread_.joinable()) {
+        streamPoolRefillThread_.join();
+    }
+    // the pooled streams belong to audio server until they are taken
+    AudioProcessConfig poolConfig = processConfig;
+    poolConfig.appInfo.appUid = static_cast<int32_t>(getuid());
+    poolConfig.appInfo.appPid = getpid();
+    streamPoolRefillThread_ = std::thread([this, poolConfig] () {
+        RefillStreamPool(poolConfig);
+        isStreamPoolRefilling_ = false;
+    });
+}
+
+void PaAdapterManager::StopStreamPool()
+{
+    isStreamPoolStopped_ = true;
+    if (streamPoolRefillThread_.joinable()) {
+        streamPoolRefillThread_.join();
+    }
+    std::map<PaStreamPoolKey, std::vector<PooledPaStream>> streamPool;
+    {
+        std::lock_guard<std::mutex> lock(streamPoolMutex_);
+        streamPool.swap(streamPool_);
+    }
+    for (const auto &[key, pooledStreams] : streamPool) {
+        for (const PooledPaStream &pooled : pooledStreams) {
+            ReleasePooledStream(pooled);
+        }
+    }
+}
+
+void PaAdapterManager::RefillStreamPool(AudioProcessConfig processConfig)
+{
+    PaStreamPoolKey key = {processConfig.rendererInfo.streamUsage, processConfig.streamInfo.samplingRate,
+        processConfig.streamInfo.format, processConfig.streamInfo.channels};
+    while (!isStreamPoolStopped_) {
+        {
+            std::lock_guard<std::mutex> lock(streamPoolMutex_);
+            auto iter = streamPool_.find(key);
+            if (iter == streamPool_.end() && streamPool_.size() >= PA_STREAM_POOL_KEY_NUM_MAX) {
+                AUDIO_INFO_LOG("Stream pool is full of other keys");
+                return;
+            }
+            if (iter != streamPool_.end() && iter->second.size() >= streamPoolSize_) {
+                return;
+            }
+        }
+        PaContextShard *shard = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(paElementsMutex_);
+            shard = SelectShard();
+        }
+        CHECK_AND_RETURN_LOG(shard != nullptr, "Failed to init pa context");
+        pa_stream *paStream = InitPaStream(processConfig, PA_POOLED_STREAM_SESSION_ID, false, *shard);
+        if (paStream == nullptr) {
+            std::lock_guard<std::mutex> lock(paElementsMutex_);
+            shard->streamCount--;
+            AUDIO_ERR_LOG("Failed to init pooled stream");
+            return;
+        }
+        std::lock_guard<std::mutex> lock(streamPoolMutex_);
+        streamPool_[key].push_back({paStream, shard});
     }
-    mainLoop_ = pa_threaded_mainloop_new();
-    CHECK_AND_RETURN_RET_LOG(mainLoop_ != nullptr, ERR_DEVICE_INIT, "Failed to init pa mainLoop");
-    api_ = pa_threaded_mainloop_get_api(mainLoop_);
+}
+
+void PaAdapterManager::DumpStreamPool(std::string &dumpString)
+{
+    std::lock_guard<std::mutex> lock(streamPoolMutex_);
+    AppendFormat(dumpString, "  - [%d] type pool size %u, hit count %" PRIu64 ", miss count %" PRIu64 "\n",
+        managerType_, streamPoolSize_, streamPoolHitCount_.load(), streamPoolMissCount_.load());
+    for (const auto &[key, pooledStreams] : streamPool_) {
+        AppendFormat(dumpString, "    usage %d rate %d format %d channels %d: %zu pooled\n", key.streamUsage,
+            key.samplingRate, key.format, key.channels, pooledStreams.size());
+    }
+}
+
+uint32_t PaAdapterManager::GetShardNumMax()
+{
+    // dup and dual streams are few, keep them on one mainloop
+    if (managerType_ != PLAYBACK && managerType_ != RECORDER) {
+        return 1;
+    }
+    long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpuNum <= 1) {
+        return 1;
+    }
+    return std::min(static_cast<uint32_t>(cpuNum), PA_CONTEXT_SHARD_NUM_MAX);
+}
+
+const std::string PaAdapterManager::GetMainLoopName(uint32_t shardIndex)
+{
+    std::string name = "";
     if (managerType_ == PLAYBACK) {
-        pa_threaded_mainloop_set_name(mainLoop_, "OS_RendererML");
+        name = "OS_RendererML";
     } else if (managerType_ == DUP_PLAYBACK) {
-        pa_threaded_mainloop_set_name(mainLoop_, "OS_DRendererML");
+        name = "OS_DRendererML";
     } else if (managerType_ == DUAL_PLAYBACK) {
-        pa_threaded_mainloop_set_name(mainLoop_, "OS_DualRendererML");
+        name = "OS_DualRendererML";
     } else if (managerType_ == RECORDER) {
-        pa_threaded_mainloop_set_name(mainLoop_, "OS_CapturerML");
+        name = "OS_CapturerML";
     } else {
         AUDIO_ERR_LOG("Not supported managerType:%{public}d", managerType_);
     }
-    if (api_ == nullptr) {
+    // the first mainloop keeps the name without index
+    return shardIndex == 0 ? name : name + std::to_string(shardIndex);
+}
+
+int32_t PaAdapterManager::ResetPaContext(PaContextShard &shard)
+{
+    AUDIO_DEBUG_LOG("Enter ResetPaContext");
+    if (shard.context) {
+        pa_context_set_state_callback(shard.context, nullptr, nullptr);
+        if (shard.isContextConnected == true) {
+            PaLockGuard lock(shard.mainLoop);
+            pa_context_disconnect(shard.context);
+            pa_context_unref(shard.context);
+            shard.isContextConnected = false;
+            shard.context = nullptr;
+        }
+    }
+
+    if (shard.mainLoop) {
+        PaLockMetrics::Unregister(shard.mainLoop);
+        pa_threaded_mainloop_free(shard.mainLoop);
+        shard.isMainLoopStarted  = false;
+        shard.mainLoop = nullptr;
+    }
+
+    shard.api = nullptr;
+    return SUCCESS;
+}
+
+int32_t PaAdapterManager::InitPaContext(PaContextShard &shard)
+{
+    AUDIO_DEBUG_LOG("Enter InitPaContext");
+    shard.mainLoop = pa_threaded_mainloop_new();
+    CHECK_AND_RETURN_RET_LOG(shard.mainLoop != nullptr, ERR_DEVICE_INIT, "Failed to init pa mainLoop");
+    shard.api = pa_threaded_mainloop_get_api(shard.mainLoop);
+    const std::string mainLoopName = GetMainLoopName(shard.index);
+    pa_threaded_mainloop_set_name(shard.mainLoop, mainLoopName.c_str());
+    PaLockMetrics::Register(shard.mainLoop, mainLoopName.c_str());
+    if (shard.api == nullptr) {
         AUDIO_ERR_LOG("Get api from mainLoop failed");
-        pa_threaded_mainloop_free(mainLoop_);
         return ERR_DEVICE_INIT;
     }
 
@@ -306,48 +653,47 @@ int32_t PaAdapterManager::InitPaContext()
     std::string packageName = "";
     ss >> packageName;
 
-    context_ = pa_context_new(api_, packageName.c_str());
-    if (context_ == nullptr) {
+    shard.context = pa_context_new(shard.api, packageName.c_str());
+    if (shard.context == nullptr) {
         AUDIO_ERR_LOG("New context failed");
-        pa_threaded_mainloop_free(mainLoop_);
         return ERR_DEVICE_INIT;
     }
 
-    pa_context_set_state_callback(context_, PAContextStateCb, mainLoop_);
-    if (pa_context_connect(context_, nullptr, PA_CONTEXT_NOFAIL, nullptr) < 0) {
-        int error = pa_context_errno(context_);
+    pa_context_set_state_callback(shard.context, PAContextStateCb, shard.mainLoop);
+    if (pa_context_connect(shard.context, nullptr, PA_CONTEXT_NOFAIL, nullptr) < 0) {
+        int error = pa_context_errno(shard.context);
         AUDIO_ERR_LOG("Context connect error: %{public}s", pa_strerror(error));
         return ERR_DEVICE_INIT;
     }
-    isContextConnected_ = true;
-    CHECK_AND_RETURN_RET_LOG(HandleMainLoopStart() == SUCCESS, ERR_DEVICE_INIT, "Failed to start pa mainLoop");
+    shard.isContextConnected = true;
+    CHECK_AND_RETURN_RET_LOG(HandleMainLoopStart(shard) == SUCCESS, ERR_DEVICE_INIT, "Failed to start pa mainLoop");
 
     return SUCCESS;
 }
 
-int32_t PaAdapterManager::HandleMainLoopStart()
+int32_t PaAdapterManager::HandleMainLoopStart(PaContextShard &shard)
 {
-    PaLockGuard lock(mainLoop_);
-    if (pa_threaded_mainloop_start(mainLoop_) < 0) {
+    PaLockGuard lock(shard.mainLoop);
+    if (pa_threaded_mainloop_start(shard.mainLoop) < 0) {
         return ERR_DEVICE_INIT;
     }
-    isMainLoopStarted_ = true;
+    shard.isMainLoopStarted = true;
 
     while (true) {
-        pa_context_state_t state = pa_context_get_state(context_);
+        pa_context_state_t state = pa_context_get_state(shard.context);
         if (state == PA_CONTEXT_READY) {
             AUDIO_INFO_LOG("pa context is ready");
             break;
         }
 
         if (!PA_CONTEXT_IS_GOOD(state)) {
-            int error = pa_context_errno(context_);
+            int error = pa_context_errno(shard.context);
             AUDIO_ERR_LOG("Context bad state error: %{public}s", pa_strerror(error));
             lock.Unlock();
-            ResetPaContext();
+            ResetPaContext(shard);
             return ERR_DEVICE_INIT;
         }
-        pa_threaded_mainloop_wait(mainLoop_);
+        pa_threaded_mainloop_wait(shard.mainLoop);
     }
     return SUCCESS;
 }
@@ -381,12 +727,13 @@ int32_t PaAdapterManager::GetDeviceNameForConnect(AudioProcessConfig processConf
     return SUCCESS;
 }
 
-pa_stream *PaAdapterManager::InitPaStream(AudioProcessConfig processConfig, uint32_t sessionId, bool isRecording)
+pa_stream *PaAdapterManager::InitPaStream(AudioProcessConfig processConfig, uint32_t sessionId, bool isRecording,
+    PaContextShard &shard)
 {
     AUDIO_DEBUG_LOG("Enter InitPaStream");
     std::lock_guard<std::mutex> lock(paElementsMutex_);
-    PaLockGuard palock(mainLoop_);
-    if (CheckReturnIfinvalid(mainLoop_ && context_, ERR_ILLEGAL_STATE) < 0) {
+    PaLockGuard palock(shard.mainLoop);
+    if (CheckReturnIfinvalid(shard.mainLoop && shard.context, ERR_ILLEGAL_STATE) < 0) {
         AUDIO_ERR_LOG("CheckReturnIfinvalid failed");
         return nullptr;
     }
@@ -403,48 +750,49 @@ pa_stream *PaAdapterManager::InitPaStream(AudioProcessConfig processConfig, uint
     CHECK_AND_RETURN_RET_LOG(SetPaProplist(propList, map, processConfig, streamName, sessionId) == 0, nullptr,
         "set pa proplist failed");
 
-    pa_stream *paStream = pa_stream_new_with_proplist(context_, streamName.c_str(), &sampleSpec,
+    pa_stream *paStream = pa_stream_new_with_proplist(shard.context, streamName.c_str(), &sampleSpec,
         isRecording ? nullptr : &map, propList);
     if (!paStream) {
-        int32_t error = pa_context_errno(context_);
+        int32_t error = pa_context_errno(shard.context);
         AUDIO_ERR_LOG("pa_stream_new_with_proplist failed, error: %{public}d", error);
         pa_proplist_free(propList);
         return nullptr;
     }
 
     pa_proplist_free(propList);
-    pa_stream_set_state_callback(paStream, PAStreamStateCb, reinterpret_cast<void *>(this));
+    pa_stream_set_state_callback(paStream, PAStreamStateCb, reinterpret_cast<void *>(shard.mainLoop));
     palock.Unlock();
 
     std::string deviceName;
     int32_t errorCode = GetDeviceNameForConnect(processConfig, sessionId, deviceName);
     if (errorCode != SUCCESS) {
         AUDIO_ERR_LOG("getdevicename err: %{public}d", errorCode);
-        ReleasePaStream(paStream);
+        ReleasePaStream(shard.mainLoop, paStream);
         return nullptr;
     }
 
-    int32_t ret = ConnectStreamToPA(paStream, sampleSpec, processConfig.capturerInfo.sourceType, deviceName);
+    int32_t ret = ConnectStreamToPA(shard.mainLoop, paStream, sampleSpec, processConfig.capturerInfo.sourceType,
+        deviceName);
     if (ret < 0) {
         AUDIO_ERR_LOG("ConnectStreamToPA Failed");
-        ReleasePaStream(paStream);
+        ReleasePaStream(shard.mainLoop, paStream);
         return nullptr;
     }
     return paStream;
 }
 
-void PaAdapterManager::ReleasePaStream(pa_stream *paStream)
+void PaAdapterManager::ReleasePaStream(pa_threaded_mainloop *mainLoop, pa_stream *paStream)
 {
     if (!paStream) {
         AUDIO_INFO_LOG("paStream is nullptr. No need to release.");
         return;
     }
-    if (!mainLoop_) {
-        AUDIO_ERR_LOG("mainLoop_ is nullptr!");
+    if (!mainLoop) {
+        AUDIO_ERR_LOG("mainLoop is nullptr!");
         return;
     }
 
-    PaLockGuard palock(mainLoop_);
+    PaLockGuard palock(mainLoop);
     pa_stream_set_state_callback(paStream, nullptr, nullptr);
 
     pa_stream_state_t state = pa_stream_get_state(paStream);
@@ -575,13 +923,13 @@ int32_t PaAdapterManager::SetPaProplist(pa_proplist *propList, pa_channel_map &m
 }
 
 std::shared_ptr<IRendererStream> PaAdapterManager::CreateRendererStream(AudioProcessConfig processConfig,
-    pa_stream *paStream)
+    pa_stream *paStream, pa_threaded_mainloop *mainLoop)
 {
     std::lock_guard<std::mutex> lock(paElementsMutex_);
     std::shared_ptr<PaRendererStreamImpl> rendererStream =
-        std::make_shared<PaRendererStreamImpl>(paStream, processConfig, mainLoop_);
+        std::make_shared<PaRendererStreamImpl>(paStream, processConfig, mainLoop);
     if (rendererStream->InitParams() != SUCCESS) {
-        int32_t error = pa_context_errno(context_);
+        int32_t error = pa_context_errno(pa_stream_get_context(paStream));
         AUDIO_ERR_LOG("Create rendererStream Failed, error: %{public}d", error);
         return nullptr;
     }
@@ -589,28 +937,28 @@ std::shared_ptr<IRendererStream> PaAdapterManager::CreateRendererStream(AudioPro
 }
 
 std::shared_ptr<ICapturerStream> PaAdapterManager::CreateCapturerStream(AudioProcessConfig processConfig,
-    pa_stream *paStream)
+    pa_stream *paStream, pa_threaded_mainloop *mainLoop)
 {
     std::lock_guard<std::mutex> lock(paElementsMutex_);
     std::shared_ptr<PaCapturerStreamImpl> capturerStream =
-        std::make_shared<PaCapturerStreamImpl>(paStream, processConfig, mainLoop_);
+        std::make_shared<PaCapturerStreamImpl>(paStream, processConfig, mainLoop);
     if (capturerStream->InitParams() != SUCCESS) {
-        int32_t error = pa_context_errno(context_);
+        int32_t error = pa_context_errno(pa_stream_get_context(paStream));
         AUDIO_ERR_LOG("Create capturerStream Failed, error: %{public}d", error);
         return nullptr;
     }
     return capturerStream;
 }
 
-int32_t PaAdapterManager::ConnectStreamToPA(pa_stream *paStream, pa_sample_spec sampleSpec,
-    SourceType source, const std::string &deviceName)
+int32_t PaAdapterManager::ConnectStreamToPA(pa_threaded_mainloop *mainLoop, pa_stream *paStream,
+    pa_sample_spec sampleSpec, SourceType source, const std::string &deviceName)
 {
     AUDIO_DEBUG_LOG("Enter PaAdapterManager::ConnectStreamToPA");
-    if (CheckReturnIfinvalid(mainLoop_ && context_ && paStream, ERROR) < 0) {
+    if (CheckReturnIfinvalid(mainLoop && paStream, ERROR) < 0) {
         return ERR_ILLEGAL_STATE;
     }
 
-    PaLockGuard lock(mainLoop_);
+    PaLockGuard lock(mainLoop);
     int32_t XcollieFlag = 1; // flag 1 generate log file
     if (managerType_ == PLAYBACK || managerType_ == DUP_PLAYBACK || managerType_ == DUAL_PLAYBACK) {
         int32_t rendererRet = ConnectRendererStreamToPA(paStream, sampleSpec);
@@ -628,17 +976,17 @@ int32_t PaAdapterManager::ConnectStreamToPA(pa_stream *paStream, pa_sample_spec
             break;
         }
         if (!PA_STREAM_IS_GOOD(state)) {
-            int32_t error = pa_context_errno(context_);
+            int32_t error = pa_context_errno(pa_stream_get_context(paStream));
             AUDIO_ERR_LOG("connection to stream error: %{public}d", error);
             return ERR_INVALID_OPERATION;
         }
         AudioXCollie audioXCollie("PaAdapterManager::ConnectStreamToPA", CONNECT_STREAM_TIMEOUT_IN_SEC,
-            [this](void *) {
+            [this, mainLoop](void *) {
                 AUDIO_ERR_LOG("ConnectStreamToPA timeout, trigger signal");
                 waitConnect_ = false;
-                pa_threaded_mainloop_signal(this->mainLoop_, 0);
+                pa_threaded_mainloop_signal(mainLoop, 0);
             }, nullptr, XcollieFlag);
-        pa_threaded_mainloop_wait(mainLoop_);
+        pa_threaded_mainloop_wait(mainLoop);
     }
     return SUCCESS;
 }
@@ -672,7 +1020,7 @@ int32_t PaAdapterManager::ConnectRendererStreamToPA(pa_stream *paStream, pa_samp
     int32_t result = pa_stream_connect_playback(paStream, sinkName, &bufferAttr, static_cast<pa_stream_flags_t>(flags),
         nullptr, nullptr);
     if (result < 0) {
-        int32_t error = pa_context_errno(context_);
+        int32_t error = pa_context_errno(pa_stream_get_context(paStream));
         AUDIO_ERR_LOG("connection to stream error: %{public}d -- %{public}s,result:%{public}d", error,
             pa_strerror(error), result);
         return ERR_INVALID_OPERATION;
@@ -697,7 +1045,7 @@ int32_t PaAdapterManager::ConnectCapturerStreamToPA(pa_stream *paStream, pa_samp
         PA_STREAM_VARIABLE_RATE));
     // PA_STREAM_ADJUST_LATENCY exist, return peek length from server;
     if (result < 0) {
-        int32_t error = pa_context_errno(context_);
+        int32_t error = pa_context_errno(pa_stream_get_context(paStream));
         AUDIO_ERR_LOG("connection to stream error: %{public}d -- %{public}s,result:%{public}d", error,
             pa_strerror(error), result);
         return ERR_INVALID_OPERATION;
@@ -705,9 +1053,10 @@ int32_t PaAdapterManager::ConnectCapturerStreamToPA(pa_stream *paStream, pa_samp
     return SUCCESS;
 }
 
-int32_t PaAdapterManager::SetStreamAudioEnhanceMode(pa_stream *paStream, AudioEnhanceMode mode)
+int32_t PaAdapterManager::SetStreamAudioEnhanceMode(pa_threaded_mainloop *mainLoop, pa_stream *paStream,
+    AudioEnhanceMode mode)
 {
-    PaLockGuard lock(mainLoop_);
+    PaLockGuard lock(mainLoop);
     pa_proplist *propList = pa_proplist_new();
     if (propList == nullptr) {
         AUDIO_ERR_LOG("pa_proplist_new failed.");
@@ -749,7 +1098,20 @@ const std::string PaAdapterManager::GetEnhanceModeName(AudioEnhanceMode mode)
 
 void PaAdapterManager::PAStreamUpdateStreamIndexSuccessCb(pa_stream *stream, int32_t success, void *userdata)
 {
-    AUDIO_DEBUG_LOG("PAStreamUpdateStreamIndexSuccessCb in");
+    AUDIO_DEBUG_LOG("PAStreamUpdateStreamIndexSuccessCb in, success: %{public}d", success);
+    PaStreamRetagResult *result = reinterpret_cast<PaStreamRetagResult *>(userdata);
+    CHECK_AND_RETURN_LOG(result != nullptr, "result is null");
+    result->isSuccess = (success == 1);
+    pa_threaded_mainloop_signal(result->mainLoop, 0);
+}
+
+void PaAdapterManager::PAStreamRetagTimeoutCb(pa_mainloop_api *api, pa_time_event *event, const struct timeval *tv,
+    void *userdata)
+{
+    PaStreamRetagResult *result = reinterpret_cast<PaStreamRetagResult *>(userdata);
+    CHECK_AND_RETURN_LOG(result != nullptr, "result is null");
+    result->isTimeout = true;
+    pa_threaded_mainloop_signal(result->mainLoop, 0);
 }
 
 void PaAdapterManager::PAContextStateCb(pa_context *context, void *userdata)
@@ -782,13 +1144,13 @@ void PaAdapterManager::PAStreamStateCb(pa_stream *stream, void *userdata)
         AUDIO_ERR_LOG("PAStreamStateCb: userdata is null");
         return;
     }
-    PaAdapterManager *adapterManger = reinterpret_cast<PaAdapterManager *>(userdata);
+    pa_threaded_mainloop *mainLoop = reinterpret_cast<pa_threaded_mainloop *>(userdata);
     AUDIO_INFO_LOG("Current Stream State: %{public}d", pa_stream_get_state(stream));
     switch (pa_stream_get_state(stream)) {
         case PA_STREAM_READY:
         case PA_STREAM_FAILED:
         case PA_STREAM_TERMINATED:
-            pa_threaded_mainloop_signal(adapterManger->mainLoop_, 0);
+            pa_threaded_mainloop_signal(mainLoop, 0);
             break;
         case PA_STREAM_UNCONNECTED:
         case PA_STREAM_CREATING:
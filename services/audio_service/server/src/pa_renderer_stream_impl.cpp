@@ -641,8 +641,8 @@ BufferDesc PaRendererStreamImpl::DequeueBuffer(size_t length)
 
 int32_t PaRendererStreamImpl::EnqueueBuffer(const BufferDesc &bufferDesc)
 {
-    Trace trace("PaRendererStreamImpl::EnqueueBuffer " + std::to_string(bufferDesc.bufLength) + " totalBytesWritten" +
-        std::to_string(totalBytesWritten_));
+    Trace trace = Trace::Format("PaRendererStreamImpl::EnqueueBuffer %zu totalBytesWritten%zu", bufferDesc.bufLength,
+        totalBytesWritten_);
     int32_t error = 0;
     if (offloadEnable_) {
         error = OffloadUpdatePolicyInWrite();
@@ -689,8 +689,8 @@ void PaRendererStreamImpl::PAStreamWriteCb(pa_stream *stream, size_t length, voi
     auto streamImpl = paRendererStreamWeakPtr.lock();
     CHECK_AND_RETURN_LOG(streamImpl, "PAStreamWriteCb: userdata is null");
 
-    Trace trace("PaRendererStreamImpl::PAStreamWriteCb sink-input:" + std::to_string(streamImpl->sinkInputIndex_) +
-        " length:" + std::to_string(length));
+    Trace trace = Trace::Format("PaRendererStreamImpl::PAStreamWriteCb sink-input:%u length:%zu",
+        streamImpl->sinkInputIndex_, length);
     std::shared_ptr<IWriteCallback> writeCallback = streamImpl->writeCallback_.lock();
     if (writeCallback != nullptr) {
         writeCallback->OnWriteData(length);
@@ -1188,6 +1188,11 @@ AudioProcessConfig PaRendererStreamImpl::GetAudioProcessConfig() const noexcept
     return processConfig_;
 }
 
+AudioStreamInfo PaRendererStreamImpl::GetOutputStreamInfo() const noexcept
+{
+    return processConfig_.streamInfo;
+}
+
 int32_t PaRendererStreamImpl::Peek(std::vector<char> *audioBuffer, int32_t &index)
 {
     return SUCCESS;
@@ -32,8 +32,13 @@ namespace AudioStandard {
 using namespace std;
 
 ProAudioStreamManager::ProAudioStreamManager(ManagerType type)
-    : managerType_(type), playbackEngine_(std::make_unique<NoneMixEngine>())
+    : managerType_(type)
 {
+    if (managerType_ == MIX_PLAYBACK) {
+        playbackEngine_ = std::make_unique<AudioPlaybackEngine>();
+    } else {
+        playbackEngine_ = std::make_unique<NoneMixEngine>();
+    }
     AUDIO_DEBUG_LOG("ProAudioStreamManager");
 }
 
@@ -83,6 +88,9 @@ int32_t ProAudioStreamManager::StartRender(uint32_t streamIndex)
     int32_t result = currentRender->Start();
     CHECK_AND_RETURN_RET_LOG(result == SUCCESS, result, "Failed to start rendererStream");
     if (playbackEngine_) {
+        if (managerType_ == MIX_PLAYBACK) {
+            playbackEngine_->SetRendererRunning(currentRender, true);
+        }
         playbackEngine_->Start();
     }
     return SUCCESS;
@@ -99,7 +107,10 @@ int32_t ProAudioStreamManager::StopRender(uint32_t streamIndex)
         return SUCCESS;
     }
     rendererStreamMap_[streamIndex]->Stop();
-    if (playbackEngine_) {
+    // the mixing engine is shared by all streams, it enters standby by itself when no stream is running
+    if (playbackEngine_ && managerType_ == MIX_PLAYBACK) {
+        playbackEngine_->SetRendererRunning(rendererStreamMap_[streamIndex], false);
+    } else if (playbackEngine_) {
         playbackEngine_->Stop();
     }
     return SUCCESS;
@@ -116,7 +127,9 @@ int32_t ProAudioStreamManager::PauseRender(uint32_t streamIndex)
         return SUCCESS;
     }
     rendererStreamMap_[streamIndex]->Pause();
-    if (playbackEngine_) {
+    if (playbackEngine_ && managerType_ == MIX_PLAYBACK) {
+        playbackEngine_->SetRendererRunning(rendererStreamMap_[streamIndex], false);
+    } else if (playbackEngine_) {
         playbackEngine_->Pause();
     }
     return SUCCESS;
@@ -127,6 +140,7 @@ int32_t ProAudioStreamManager::ReleaseRender(uint32_t streamIndex)
     Trace trace("ProAudioStreamManager::ReleaseRender");
     AUDIO_DEBUG_LOG("Release renderer start");
     std::shared_ptr<IRendererStream> currentRender;
+    bool isLastStream = false;
     {
         std::lock_guard<std::mutex> lock(streamMapMutex_);
         auto it = rendererStreamMap_.find(streamIndex);
@@ -137,9 +151,12 @@ int32_t ProAudioStreamManager::ReleaseRender(uint32_t streamIndex)
         currentRender = rendererStreamMap_[streamIndex];
         rendererStreamMap_[streamIndex] = nullptr;
         rendererStreamMap_.erase(streamIndex);
+        isLastStream = rendererStreamMap_.empty();
     }
     if (playbackEngine_) {
-        playbackEngine_->Stop();
+        if (managerType_ != MIX_PLAYBACK || isLastStream) {
+            playbackEngine_->Stop();
+        }
         playbackEngine_->RemoveRenderer(currentRender);
     }
     if (currentRender->Release() < 0) {
@@ -185,7 +202,8 @@ std::shared_ptr<IRendererStream> ProAudioStreamManager::CreateRendererStream(Aud
 {
     Trace trace("ProAudioStreamManager::CreateRendererStream");
     std::lock_guard<std::mutex> lock(paElementsMutex_);
-    bool isDirectStream = managerType_ == DIRECT_PLAYBACK; // direct stream (high resolution) or direct VoIP stream
+    // direct stream (high resolution) or direct VoIP stream, mixed streams are rendered to the direct sink too
+    bool isDirectStream = managerType_ == DIRECT_PLAYBACK || managerType_ == MIX_PLAYBACK;
     std::shared_ptr<ProRendererStreamImpl> rendererStream =
         std::make_shared<ProRendererStreamImpl>(processConfig, isDirectStream);
     if (rendererStream->InitParams() != SUCCESS) {
@@ -508,6 +508,13 @@ AudioProcessConfig ProRendererStreamImpl::GetAudioProcessConfig() const noexcept
     return processConfig_;
 }
 
+AudioStreamInfo ProRendererStreamImpl::GetOutputStreamInfo() const noexcept
+{
+    // Peek returns resampled and down mixed data
+    AudioChannel channels = processConfig_.streamInfo.channels >= STEREO_CHANNEL_COUNT ? STEREO : MONO;
+    return AudioStreamInfo(static_cast<AudioSamplingRate>(desSamplingRate_), ENCODING_PCM, desFormat_, channels);
+}
+
 bool ProRendererStreamImpl::GetAudioTime(uint64_t &framePos, int64_t &sec, int64_t &nanoSec)
 {
     GetStreamFramesWritten(framePos);
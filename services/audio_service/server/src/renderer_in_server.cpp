@@ -137,8 +137,9 @@ int32_t RendererInServer::Init()
 {
     if (IsHighResolution()) {
         Trace trace("current stream marked as high resolution");
-        managerType_ = DIRECT_PLAYBACK;
-        AUDIO_INFO_LOG("current stream marked as high resolution");
+        // with mixing enabled all high resolution streams share the direct route instead of the first one only
+        managerType_ = IsDirectMixEnabled() ? MIX_PLAYBACK : DIRECT_PLAYBACK;
+        AUDIO_INFO_LOG("current stream marked as high resolution, manager type:%{public}d", managerType_);
     }
 
     if (processConfig_.rendererInfo.rendererFlags == AUDIO_FLAG_VOIP_DIRECT) {
@@ -151,7 +152,8 @@ int32_t RendererInServer::Init()
     }
 
     int32_t ret = IStreamManager::GetPlaybackManager(managerType_).CreateRender(processConfig_, stream_);
-    if (ret != SUCCESS && (managerType_ == DIRECT_PLAYBACK || managerType_ == VOIP_PLAYBACK)) {
+    if (ret != SUCCESS && (managerType_ == DIRECT_PLAYBACK || managerType_ == VOIP_PLAYBACK ||
+        managerType_ == MIX_PLAYBACK)) {
         Trace trace("high resolution create failed use normal replace");
         managerType_ = PLAYBACK;
         ret = IStreamManager::GetPlaybackManager(managerType_).CreateRender(processConfig_, stream_);
@@ -246,6 +248,7 @@ void RendererInServer::OnStatusUpdateExt(IOperation operation, std::shared_ptr<I
         stateListener->OnOperationHandled(DRAIN_STREAM, 0);
     }
     afterDrain = true;
+    audioServerBuffer_->SetPositionUpdateNeeded(true);
 }
 
 void RendererInServer::OnStatusUpdateSub(IOperation operation)
@@ -263,6 +266,7 @@ void RendererInServer::OnStatusUpdateSub(IOperation operation)
             if (audioServerBuffer_->GetAvailableDataFrames() == static_cast<int32_t>(4 * spanSizeInFrame_)) {
                 AUDIO_INFO_LOG("Buffer is empty");
                 needForceWrite_ = 0;
+                audioServerBuffer_->SetPositionUpdateNeeded(true);
             } else {
                 AUDIO_INFO_LOG("Buffer is not empty");
                 WriteData();
@@ -288,12 +292,12 @@ void RendererInServer::OnStatusUpdateSub(IOperation operation)
 
 void RendererInServer::StandByCheck()
 {
-    Trace trace(traceTag_ + " StandByCheck:standByCounter_:" + std::to_string(standByCounter_.load()));
+    Trace trace = Trace::Format("%s StandByCheck:standByCounter_:%u", traceTag_.c_str(), standByCounter_.load());
     AUDIO_INFO_LOG("sessionId:%{public}u standByCounter_:%{public}u standByEnable_:%{public}s ", streamIndex_,
         standByCounter_.load(), (standByEnable_ ? "true" : "false"));
 
     // direct standBy need not in here
-    if (managerType_ == DIRECT_PLAYBACK || managerType_ == VOIP_PLAYBACK) {
+    if (managerType_ == DIRECT_PLAYBACK || managerType_ == VOIP_PLAYBACK || managerType_ == MIX_PLAYBACK) {
         return;
     }
 
@@ -415,35 +419,36 @@ void RendererInServer::VolumeHandle(BufferDesc &desc)
         AUDIO_WARNING_LOG("buffer in not inited");
         return;
     }
-    float applyVolume = 0.0f;
-    if (muteFlag_) {
-        applyVolume = 0.0f;
-    } else {
-        applyVolume = audioServerBuffer_->GetStreamVolume();
-    }
+    float volumeFactor = muteFlag_ ? 0.0f : 1.0f;
     float duckVolume = audioServerBuffer_->GetDuckFactor();
     float muteVolume = audioServerBuffer_->GetMuteFactor();
     if (!IsVolumeSame(MAX_FLOAT_VOLUME, lowPowerVolume_, AUDIO_VOLOMUE_EPSILON)) {
-        applyVolume *= lowPowerVolume_;
+        volumeFactor *= lowPowerVolume_;
     }
     if (!IsVolumeSame(MAX_FLOAT_VOLUME, duckVolume, AUDIO_VOLOMUE_EPSILON)) {
-        applyVolume *= duckVolume;
+        volumeFactor *= duckVolume;
     }
     if (!IsVolumeSame(MAX_FLOAT_VOLUME, muteVolume, AUDIO_VOLOMUE_EPSILON)) {
-        applyVolume *= muteVolume;
+        volumeFactor *= muteVolume;
     }
 
     if (silentModeAndMixWithOthers_) {
-        applyVolume = 0.0f;
+        volumeFactor = 0.0f;
     }
 
+    // a volume ramp of the client comes with the span, it replaces the stream volume for this span
+    float rampStart = 0.0f;
+    float rampEnd = 0.0f;
+    bool isRampSpan = GetSpanRampVolume(rampStart, rampEnd);
+    float applyVolume = (isRampSpan ? rampEnd : audioServerBuffer_->GetStreamVolume()) * volumeFactor;
+    float startVolume = isRampSpan ? rampStart * volumeFactor : oldAppliedVolume_;
+
     //in plan: put system volume handle here
     if (!IsVolumeSame(MAX_FLOAT_VOLUME, applyVolume, AUDIO_VOLOMUE_EPSILON) ||
-        !IsVolumeSame(oldAppliedVolume_, applyVolume, AUDIO_VOLOMUE_EPSILON)) {
-        Trace traceVol("RendererInServer::VolumeTools::Process " + std::to_string(oldAppliedVolume_) + "~" +
-            std::to_string(applyVolume));
+        !IsVolumeSame(startVolume, applyVolume, AUDIO_VOLOMUE_EPSILON)) {
+        Trace traceVol = Trace::Format("RendererInServer::VolumeTools::Process %f~%f", startVolume, applyVolume);
         AudioChannel channel = processConfig_.streamInfo.channels;
-        ChannelVolumes mapVols = VolumeTools::GetChannelVolumes(channel, oldAppliedVolume_, applyVolume);
+        ChannelVolumes mapVols = VolumeTools::GetChannelVolumes(channel, startVolume, applyVolume);
         int32_t volRet = VolumeTools::Process(desc, processConfig_.streamInfo.format, mapVols);
         oldAppliedVolume_ = applyVolume;
         if (volRet != SUCCESS) {
@@ -452,13 +457,27 @@ void RendererInServer::VolumeHandle(BufferDesc &desc)
     }
 }
 
+bool RendererInServer::GetSpanRampVolume(float &volumeStart, float &volumeEnd)
+{
+    SpanInfo *spanInfo = audioServerBuffer_->GetSpanInfo(audioServerBuffer_->GetCurReadFrame());
+    CHECK_AND_RETURN_RET(spanInfo != nullptr, false);
+    int32_t unity = 1 << VOLUME_SHIFT_NUMBER;
+    if (spanInfo->volumeStart == unity && spanInfo->volumeEnd == unity) {
+        return false;
+    }
+    volumeStart = static_cast<float>(spanInfo->volumeStart) / unity;
+    volumeEnd = static_cast<float>(spanInfo->volumeEnd) / unity;
+    return true;
+}
+
 int32_t RendererInServer::WriteData()
 {
     uint64_t currentReadFrame = audioServerBuffer_->GetCurReadFrame();
     uint64_t currentWriteFrame = audioServerBuffer_->GetCurWriteFrame();
-    Trace trace1(traceTag_ + " WriteData"); // RendererInServer::sessionid:100001 WriteData
+    Trace trace1 = Trace::Format("%s WriteData", traceTag_.c_str()); // RendererInServer::sessionid:100001 WriteData
     if (currentReadFrame + spanSizeInFrame_ > currentWriteFrame) {
-        Trace trace2(traceTag_ + " near underrun"); // RendererInServer::sessionid:100001 near underrun
+        // RendererInServer::sessionid:100001 near underrun
+        Trace trace2 = Trace::Format("%s near underrun", traceTag_.c_str());
         FutexTool::FutexWake(audioServerBuffer_->GetFutex());
         return ERR_OPERATION_FAILED;
     }
@@ -529,7 +548,7 @@ void RendererInServer::WriteEmptyData()
 
 int32_t RendererInServer::OnWriteData(size_t length)
 {
-    Trace trace("RendererInServer::OnWriteData length " + std::to_string(length));
+    Trace trace = Trace::Format("RendererInServer::OnWriteData length %zu", length);
     bool mayNeedForceWrite = false;
     if (writeLock_.try_lock()) {
         // length unit is bytes, using spanSizeInByte_
@@ -547,6 +566,7 @@ int32_t RendererInServer::OnWriteData(size_t length)
         AUDIO_DEBUG_LOG("Server need force write to recycle callback");
         needForceWrite_ =
             writableSize / spanSizeInByte_ > 3 ? 0 : 3 - writableSize / spanSizeInByte_; // 3 is maxlength - 1
+        audioServerBuffer_->SetPositionUpdateNeeded(true);
     }
 
     uint64_t currentReadFrame = audioServerBuffer_->GetCurReadFrame();
@@ -565,7 +585,11 @@ int32_t RendererInServer::UpdateWriteIndex()
 {
     Trace trace("RendererInServer::UpdateWriteIndex");
     if (managerType_ != PLAYBACK) {
+        // The engine may be in standby, every write of these streams is notified.
         IStreamManager::GetPlaybackManager(managerType_).TriggerStartIfNecessary();
+    } else {
+        // Clear before checking, so that a request raised by the callbacks meanwhile is kept.
+        audioServerBuffer_->SetPositionUpdateNeeded(false);
     }
     if (needForceWrite_ < 3 && stream_->GetWritableSize() >= spanSizeInByte_) { // 3 is maxlength - 1
         if (writeLock_.try_lock()) {
@@ -584,6 +608,11 @@ int32_t RendererInServer::UpdateWriteIndex()
             writeLock_.unlock();
         }
     }
+
+    // Once the stream is filled, the sink callback pulls the data and the client only publishes curWriteFrame.
+    if (needForceWrite_ < 3 || afterDrain) { // 3 is maxlength - 1
+        audioServerBuffer_->SetPositionUpdateNeeded(true);
+    }
     return SUCCESS;
 }
 
@@ -614,6 +643,7 @@ int32_t RendererInServer::Start()
         return IStreamManager::GetPlaybackManager(managerType_).StartRender(streamIndex_);
     }
     needForceWrite_ = 0;
+    audioServerBuffer_->SetPositionUpdateNeeded(true);
     std::unique_lock<std::mutex> lock(statusLock_);
     if (status_ != I_STATUS_IDLE && status_ != I_STATUS_PAUSED && status_ != I_STATUS_STOPPED) {
         AUDIO_ERR_LOG("RendererInServer::Start failed, Illegal state: %{public}u", status_);
@@ -1024,7 +1054,7 @@ void StreamCallbacks::OnStatusUpdate(IOperation operation)
 
 int32_t StreamCallbacks::OnWriteData(size_t length)
 {
-    Trace trace("DupStream::OnWriteData length " + std::to_string(length));
+    Trace trace = Trace::Format("DupStream::OnWriteData length %zu", length);
     return SUCCESS;
 }
 
@@ -1098,7 +1128,18 @@ int32_t RendererInServer::UpdateSpatializationState(bool spatializationEnabled,
 
 int32_t RendererInServer::GetStreamManagerType() const noexcept
 {
-    return managerType_ == DIRECT_PLAYBACK ? AUDIO_DIRECT_MANAGER_TYPE : AUDIO_NORMAL_MANAGER_TYPE;
+    return (managerType_ == DIRECT_PLAYBACK || managerType_ == MIX_PLAYBACK) ? AUDIO_DIRECT_MANAGER_TYPE :
+        AUDIO_NORMAL_MANAGER_TYPE;
+}
+
+bool RendererInServer::IsDirectMixEnabled()
+{
+    static const bool isDirectMixEnabled = [] {
+        int32_t directMixFlag = 0;
+        GetSysPara("persist.multimedia.audio.directmix", directMixFlag);
+        return directMixFlag == 1;
+    }();
+    return isDirectMixEnabled;
 }
 
 bool RendererInServer::IsHighResolution() const noexcept
@@ -1124,7 +1165,7 @@ bool RendererInServer::IsHighResolution() const noexcept
         AUDIO_INFO_LOG("sample rate over 192k");
         return false;
     }
-    if (IStreamManager::GetPlaybackManager(DIRECT_PLAYBACK).GetStreamCount() > 0) {
+    if (!IsDirectMixEnabled() && IStreamManager::GetPlaybackManager(DIRECT_PLAYBACK).GetStreamCount() > 0) {
         AUDIO_INFO_LOG("high resolution exist.");
         return false;
     }
@@ -1218,6 +1259,8 @@ static std::string GetManagerTypeStr(ManagerType type)
             return "Direct";
         case VOIP_PLAYBACK:
             return "Voip";
+        case MIX_PLAYBACK:
+            return "Direct Mix";
         case RECORDER:
             return "Recorder";
         default:
@@ -1228,7 +1271,7 @@ static std::string GetManagerTypeStr(ManagerType type)
 
 bool RendererInServer::Dump(std::string &dumpString)
 {
-    if (managerType_ != DIRECT_PLAYBACK && managerType_ != VOIP_PLAYBACK) {
+    if (managerType_ != DIRECT_PLAYBACK && managerType_ != VOIP_PLAYBACK && managerType_ != MIX_PLAYBACK) {
         return false;
     }
     // dump audio stream info
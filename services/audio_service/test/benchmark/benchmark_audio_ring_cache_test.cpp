@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "audio_ring_cache.h"
+using namespace std;
+using namespace OHOS::AudioStandard;
+
+namespace {
+    const size_t SPAN_SIZE = 3840; // 20ms of 48k stereo s16
+    const size_t WRITE_SIZE = 1024; // app write size, not aligned to the span
+    const size_t CACHE_SIZE = SPAN_SIZE * 4;
+    const int64_t THREAD_SPAN_COUNT = 10000;
+
+    // The loop of RendererInClientInner::WriteRingCache: check, enqueue, check, dequeue a span when it is full.
+    template <typename RingCache>
+    void RingCacheWriteLoop(benchmark::State &state)
+    {
+        unique_ptr<RingCache> ringCache = RingCache::Create(CACHE_SIZE);
+        if (ringCache == nullptr) {
+            state.SkipWithError("create ring cache failed.");
+            return;
+        }
+        vector<uint8_t> writeBuffer(WRITE_SIZE, 1);
+        vector<uint8_t> spanBuffer(SPAN_SIZE, 0);
+        for (auto _ : state) {
+            OptResult result = ringCache->GetWritableSize();
+            if (result.size >= WRITE_SIZE) {
+                ringCache->Enqueue({writeBuffer.data(), WRITE_SIZE});
+            }
+            result = ringCache->GetReadableSize();
+            if (result.size >= SPAN_SIZE) {
+                ringCache->Dequeue({spanBuffer.data(), SPAN_SIZE});
+            }
+            benchmark::DoNotOptimize(spanBuffer.data());
+        }
+        state.SetBytesProcessed(state.iterations() * WRITE_SIZE);
+    }
+
+    // One producer thread and one consumer thread move THREAD_SPAN_COUNT spans.
+    template <typename RingCache>
+    void RingCacheTwoThreads(benchmark::State &state)
+    {
+        for (auto _ : state) {
+            unique_ptr<RingCache> ringCache = RingCache::Create(CACHE_SIZE);
+            if (ringCache == nullptr) {
+                state.SkipWithError("create ring cache failed.");
+                return;
+            }
+            thread consumer([&ringCache]() {
+                vector<uint8_t> spanBuffer(SPAN_SIZE, 0);
+                int64_t count = 0;
+                while (count < THREAD_SPAN_COUNT) {
+                    if (ringCache->GetReadableSize().size < SPAN_SIZE) {
+                        this_thread::yield();
+                        continue;
+                    }
+                    ringCache->Dequeue({spanBuffer.data(), SPAN_SIZE});
+                    count++;
+                }
+            });
+            vector<uint8_t> writeBuffer(SPAN_SIZE, 1);
+            int64_t count = 0;
+            while (count < THREAD_SPAN_COUNT) {
+                if (ringCache->GetWritableSize().size < SPAN_SIZE) {
+                    this_thread::yield();
+                    continue;
+                }
+                ringCache->Enqueue({writeBuffer.data(), SPAN_SIZE});
+                count++;
+            }
+            consumer.join();
+        }
+        state.SetBytesProcessed(state.iterations() * THREAD_SPAN_COUNT * SPAN_SIZE);
+    }
+
+    void RingCacheWriteLoopLocked(benchmark::State &state)
+    {
+        RingCacheWriteLoop<AudioRingCache>(state);
+    }
+
+    void RingCacheWriteLoopSpsc(benchmark::State &state)
+    {
+        RingCacheWriteLoop<AudioSpscRingCache>(state);
+    }
+
+    void RingCacheTwoThreadsLocked(benchmark::State &state)
+    {
+        RingCacheTwoThreads<AudioRingCache>(state);
+    }
+
+    void RingCacheTwoThreadsSpsc(benchmark::State &state)
+    {
+        RingCacheTwoThreads<AudioSpscRingCache>(state);
+    }
+}
+
+BENCHMARK(RingCacheWriteLoopLocked);
+BENCHMARK(RingCacheWriteLoopSpsc);
+BENCHMARK(RingCacheTwoThreadsLocked)->UseRealTime();
+BENCHMARK(RingCacheTwoThreadsSpsc)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "audio_errors.h"
+#include "format_converter.h"
+using namespace std;
+using namespace OHOS::AudioStandard;
+
+namespace {
+    const size_t FRAME_COUNT = 960; // 20ms of 48k
+    const size_t MAX_SAMPLE_SIZE = 4; // s32 and f32
+
+    // Args: src format, dst format, src channels, dst channels, src planar, dst planar
+    void FormatConvert(benchmark::State &state)
+    {
+        FormatConvertConfig config;
+        config.srcFormat = static_cast<AudioSampleFormat>(state.range(0));
+        config.dstFormat = static_cast<AudioSampleFormat>(state.range(1)); // 1: dst format
+        config.srcChannels = static_cast<uint32_t>(state.range(2)); // 2: src channels
+        config.dstChannels = static_cast<uint32_t>(state.range(3)); // 3: dst channels
+        config.isSrcPlanar = state.range(4) != 0; // 4: src planar
+        config.isDstPlanar = state.range(5) != 0; // 5: dst planar
+        FormatConverter converter;
+        if (converter.Init(config) != SUCCESS) {
+            state.SkipWithError("init format converter failed.");
+            return;
+        }
+        vector<uint8_t> src(FRAME_COUNT * config.srcChannels * FormatConverter::GetSampleSize(config.srcFormat), 1);
+        vector<uint8_t> dst(FRAME_COUNT * config.dstChannels * MAX_SAMPLE_SIZE, 0);
+        BufferDesc srcDesc = {src.data(), src.size(), src.size()};
+        BufferDesc dstDesc = {dst.data(), dst.size(), dst.size()};
+        for (auto _ : state) {
+            converter.Process(srcDesc, dstDesc, 0.5f); // 0.5: not unity, the gain is applied
+            benchmark::DoNotOptimize(dst.data());
+        }
+        state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+        state.SetBytesProcessed(state.iterations() * src.size());
+        state.SetLabel(FormatConverter::GetKernelName());
+    }
+
+    // Every pair of U8, S16LE, S24LE, S32LE and F32LE on stereo.
+    void FormatPairs(benchmark::internal::Benchmark *bench)
+    {
+        for (int64_t srcFormat = SAMPLE_U8; srcFormat <= SAMPLE_F32LE; srcFormat++) {
+            for (int64_t dstFormat = SAMPLE_U8; dstFormat <= SAMPLE_F32LE; dstFormat++) {
+                bench->Args({srcFormat, dstFormat, STEREO, STEREO, 0, 0});
+            }
+        }
+    }
+
+    // Up and down mix, and interleave and deinterleave of the formats used by the sinks.
+    void LayoutCases(benchmark::internal::Benchmark *bench)
+    {
+        bench->Args({SAMPLE_S16LE, SAMPLE_S16LE, MONO, STEREO, 0, 0});
+        bench->Args({SAMPLE_S16LE, SAMPLE_S16LE, STEREO, MONO, 0, 0});
+        bench->Args({SAMPLE_S16LE, SAMPLE_F32LE, STEREO, CHANNEL_6, 0, 0});
+        bench->Args({SAMPLE_F32LE, SAMPLE_S16LE, CHANNEL_6, STEREO, 0, 0});
+        bench->Args({SAMPLE_S32LE, SAMPLE_F32LE, STEREO, STEREO, 0, 1});
+        bench->Args({SAMPLE_F32LE, SAMPLE_S32LE, STEREO, STEREO, 1, 0});
+        bench->Args({SAMPLE_S24LE, SAMPLE_F32LE, CHANNEL_8, CHANNEL_8, 0, 1});
+    }
+}
+
+BENCHMARK(FormatConvert)->Apply(FormatPairs);
+BENCHMARK(FormatConvert)->Apply(LayoutCases);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "audio_playback_engine.h"
+#include "audio_renderer_file_sink.h"
+#include "pro_renderer_stream_impl.h"
+#include "audio_errors.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+constexpr uint32_t FIRST_STREAM_ID = 10;
+constexpr uint32_t SECOND_STREAM_ID = 11;
+constexpr int32_t PLAYBACK_TIME_MS = 200;
+constexpr int32_t STANDBY_WAIT_MS = 1500; // longer than the 1s the engine waits before standby
+constexpr int16_t FIRST_SAMPLE_VALUE = 1000;
+constexpr int16_t SECOND_SAMPLE_VALUE = 2000;
+constexpr int32_t S16_TO_S32_SHIFT = 16;
+const char *MIX_FILE_PATH = "/data/local/tmp/audio_playback_engine_test.pcm";
+} // namespace
+
+class FakeWriteCallback : public IWriteCallback {
+public:
+    FakeWriteCallback(const std::shared_ptr<IRendererStream> &stream, int16_t sampleValue)
+        : stream_(stream), sampleValue_(sampleValue) {}
+
+    int32_t OnWriteData(size_t length) override
+    {
+        std::shared_ptr<IRendererStream> stream = stream_.lock();
+        if (stream == nullptr || !hasData_) {
+            return ERR_WRITE_BUFFER;
+        }
+        buffer_.resize(length / sizeof(int16_t), sampleValue_);
+        BufferDesc bufferDesc = {reinterpret_cast<uint8_t *>(buffer_.data()), length, length};
+        return stream->EnqueueBuffer(bufferDesc);
+    }
+
+    void SetHasData(bool hasData)
+    {
+        hasData_ = hasData;
+    }
+
+private:
+    std::weak_ptr<IRendererStream> stream_;
+    int16_t sampleValue_ = 0;
+    std::atomic<bool> hasData_ = true;
+    std::vector<int16_t> buffer_;
+};
+
+class AudioPlaybackEngineUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+protected:
+    std::shared_ptr<ProRendererStreamImpl> CreateStream(uint32_t streamId, AudioSamplingRate rate, bool isDirect,
+        int16_t sampleValue = 0);
+
+protected:
+    IAudioRendererSink *fileSink_ = nullptr;
+    std::unique_ptr<AudioPlaybackEngine> playbackEngine_;
+    std::vector<std::shared_ptr<FakeWriteCallback>> writeCallbacks_;
+};
+
+void AudioPlaybackEngineUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void AudioPlaybackEngineUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void AudioPlaybackEngineUnitTest::SetUp(void)
+{
+    fileSink_ = AudioRendererFileSink::GetInstance();
+    IAudioSinkAttr attr = {};
+    attr.filePath = MIX_FILE_PATH;
+    fileSink_->Init(attr);
+    playbackEngine_ = std::make_unique<AudioPlaybackEngine>(fileSink_);
+    DeviceInfo deviceInfo;
+    deviceInfo.deviceType = DEVICE_TYPE_USB_HEADSET;
+    playbackEngine_->Init(deviceInfo, false);
+}
+
+void AudioPlaybackEngineUnitTest::TearDown(void)
+{
+    if (playbackEngine_) {
+        playbackEngine_->Stop();
+        playbackEngine_ = nullptr;
+    }
+    writeCallbacks_.clear();
+    fileSink_->DeInit();
+    std::remove(MIX_FILE_PATH);
+}
+
+std::shared_ptr<ProRendererStreamImpl> AudioPlaybackEngineUnitTest::CreateStream(uint32_t streamId,
+    AudioSamplingRate rate, bool isDirect, int16_t sampleValue)
+{
+    AudioProcessConfig config;
+    config.appInfo.appUid = static_cast<int32_t>(streamId);
+    config.appInfo.appPid = static_cast<int32_t>(streamId);
+    config.streamInfo.format = SAMPLE_S16LE;
+    config.streamInfo.samplingRate = rate;
+    config.streamInfo.channels = STEREO;
+    config.streamInfo.channelLayout = AudioChannelLayout::CH_LAYOUT_STEREO;
+    config.audioMode = AudioMode::AUDIO_MODE_PLAYBACK;
+    config.streamType = AudioStreamType::STREAM_MUSIC;
+    config.deviceType = DEVICE_TYPE_USB_HEADSET;
+    std::shared_ptr<ProRendererStreamImpl> rendererStream = std::make_shared<ProRendererStreamImpl>(config, isDirect);
+    if (rendererStream->InitParams() != SUCCESS) {
+        return nullptr;
+    }
+    rendererStream->SetStreamIndex(streamId);
+    std::shared_ptr<FakeWriteCallback> writeCallback = std::make_shared<FakeWriteCallback>(rendererStream, sampleValue);
+    rendererStream->RegisterWriteCallback(writeCallback);
+    writeCallbacks_.push_back(writeCallback);
+    return rendererStream;
+}
+
+/**
+ * @tc.name  : Test AudioPlaybackEngine AddRenderer
+ * @tc.type  : FUNC
+ * @tc.number: AudioPlaybackEngine_001
+ * @tc.desc  : Test the first stream decides the sink config and streams with another rate are rejected
+ */
+HWTEST_F(AudioPlaybackEngineUnitTest, AudioPlaybackEngine_001, TestSize.Level1)
+{
+    std::shared_ptr<ProRendererStreamImpl> firstStream = CreateStream(FIRST_STREAM_ID, SAMPLE_RATE_48000, true);
+    ASSERT_NE(nullptr, firstStream);
+    EXPECT_EQ(SUCCESS, playbackEngine_->AddRenderer(firstStream));
+    EXPECT_EQ(SUCCESS, playbackEngine_->AddRenderer(firstStream));
+    EXPECT_EQ(1, playbackEngine_->GetRendererCount());
+
+    AudioStreamInfo sinkStreamInfo = playbackEngine_->GetSinkStreamInfo();
+    EXPECT_EQ(SAMPLE_RATE_48000, sinkStreamInfo.samplingRate);
+    EXPECT_EQ(SAMPLE_S32LE, sinkStreamInfo.format);
+    EXPECT_EQ(STEREO, sinkStreamInfo.channels);
+
+    // a 16k stream is not resampled by the stream and can not be mixed into the 48k sink
+    std::shared_ptr<ProRendererStreamImpl> voipStream = CreateStream(SECOND_STREAM_ID, SAMPLE_RATE_16000, false);
+    ASSERT_NE(nullptr, voipStream);
+    EXPECT_EQ(ERR_NOT_SUPPORTED, playbackEngine_->AddRenderer(voipStream));
+    EXPECT_EQ(1, playbackEngine_->GetRendererCount());
+
+    playbackEngine_->RemoveRenderer(firstStream);
+    EXPECT_EQ(0, playbackEngine_->GetRendererCount());
+    EXPECT_EQ(SUCCESS, firstStream->Release());
+    EXPECT_EQ(SUCCESS, voipStream->Release());
+}
+
+/**
+ * @tc.name  : Test AudioPlaybackEngine mix
+ * @tc.type  : FUNC
+ * @tc.number: AudioPlaybackEngine_002
+ * @tc.desc  : Test two streams are mixed sample by sample into the sink format
+ */
+HWTEST_F(AudioPlaybackEngineUnitTest, AudioPlaybackEngine_002, TestSize.Level1)
+{
+    EXPECT_EQ(ERR_ILLEGAL_STATE, playbackEngine_->Start());
+
+    std::shared_ptr<ProRendererStreamImpl> firstStream =
+        CreateStream(FIRST_STREAM_ID, SAMPLE_RATE_48000, true, FIRST_SAMPLE_VALUE);
+    std::shared_ptr<ProRendererStreamImpl> secondStream =
+        CreateStream(SECOND_STREAM_ID, SAMPLE_RATE_48000, true, SECOND_SAMPLE_VALUE);
+    ASSERT_NE(nullptr, firstStream);
+    ASSERT_NE(nullptr, secondStream);
+    EXPECT_EQ(SUCCESS, playbackEngine_->AddRenderer(firstStream));
+    EXPECT_EQ(SUCCESS, playbackEngine_->AddRenderer(secondStream));
+    EXPECT_EQ(2, playbackEngine_->GetRendererCount());
+
+    EXPECT_EQ(SUCCESS, firstStream->Start());
+    EXPECT_EQ(SUCCESS, secondStream->Start());
+    playbackEngine_->SetRendererRunning(firstStream, true);
+    playbackEngine_->SetRendererRunning(secondStream, true);
+    EXPECT_EQ(SUCCESS, playbackEngine_->Start());
+    EXPECT_TRUE(playbackEngine_->IsPlaybackEngineRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(PLAYBACK_TIME_MS));
+    EXPECT_EQ(SUCCESS, playbackEngine_->Stop());
+    EXPECT_FALSE(playbackEngine_->IsPlaybackEngineRunning());
+
+    FILE *file = std::fopen(MIX_FILE_PATH, "rb");
+    ASSERT_NE(nullptr, file);
+    std::vector<int32_t> samples;
+    int32_t sample = 0;
+    while (std::fread(&sample, sizeof(sample), 1, file) == 1) {
+        samples.push_back(sample);
+    }
+    std::fclose(file);
+    // 48k stereo s32, 20ms per span
+    constexpr size_t spanSampleCount = 960 * 2;
+    ASSERT_GT(samples.size(), 0);
+    EXPECT_EQ(0, samples.size() % spanSampleCount);
+
+    // s16 data is written to the s32 sink, a period may hold one stream only while the other is not ready
+    const int32_t firstOnly = static_cast<int32_t>(FIRST_SAMPLE_VALUE) << S16_TO_S32_SHIFT;
+    const int32_t secondOnly = static_cast<int32_t>(SECOND_SAMPLE_VALUE) << S16_TO_S32_SHIFT;
+    const int32_t mixed = firstOnly + secondOnly;
+    size_t mixedCount = 0;
+    for (int32_t value : samples) {
+        EXPECT_TRUE(value == mixed || value == firstOnly || value == secondOnly) << "unexpected sample " << value;
+        mixedCount += (value == mixed) ? 1 : 0;
+    }
+    EXPECT_GT(mixedCount, 0);
+
+    playbackEngine_->RemoveRenderer(firstStream);
+    playbackEngine_->RemoveRenderer(secondStream);
+    EXPECT_EQ(SUCCESS, firstStream->Release());
+    EXPECT_EQ(SUCCESS, secondStream->Release());
+}
+
+/**
+ * @tc.name  : Test AudioPlaybackEngine standby
+ * @tc.type  : FUNC
+ * @tc.number: AudioPlaybackEngine_003
+ * @tc.desc  : Test the engine waits for a running stream without data and enters standby once none is running
+ */
+HWTEST_F(AudioPlaybackEngineUnitTest, AudioPlaybackEngine_003, TestSize.Level1)
+{
+    std::shared_ptr<ProRendererStreamImpl> stream =
+        CreateStream(FIRST_STREAM_ID, SAMPLE_RATE_48000, true, FIRST_SAMPLE_VALUE);
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(1, writeCallbacks_.size());
+    EXPECT_EQ(SUCCESS, playbackEngine_->AddRenderer(stream));
+    EXPECT_EQ(SUCCESS, stream->Start());
+    writeCallbacks_[0]->SetHasData(false);
+
+    playbackEngine_->SetRendererRunning(stream, true);
+    EXPECT_EQ(SUCCESS, playbackEngine_->Start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(STANDBY_WAIT_MS));
+    EXPECT_TRUE(playbackEngine_->IsPlaybackEngineRunning());
+
+    playbackEngine_->SetRendererRunning(stream, false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(STANDBY_WAIT_MS));
+    EXPECT_FALSE(playbackEngine_->IsPlaybackEngineRunning());
+
+    // starting a stream again resumes the engine from standby
+    writeCallbacks_[0]->SetHasData(true);
+    playbackEngine_->SetRendererRunning(stream, true);
+    EXPECT_EQ(SUCCESS, playbackEngine_->Start());
+    EXPECT_TRUE(playbackEngine_->IsPlaybackEngineRunning());
+
+    EXPECT_EQ(SUCCESS, playbackEngine_->Stop());
+    playbackEngine_->RemoveRenderer(stream);
+    EXPECT_EQ(SUCCESS, stream->Release());
+}
+
+/**
+ * @tc.name  : Test AudioPlaybackEngine Init
+ * @tc.type  : FUNC
+ * @tc.number: AudioPlaybackEngine_004
+ * @tc.desc  : Test a device change while playing re-inits the sink and keeps the attached streams playing
+ */
+HWTEST_F(AudioPlaybackEngineUnitTest, AudioPlaybackEngine_004, TestSize.Level1)
+{
+    std::shared_ptr<ProRendererStreamImpl> stream =
+        CreateStream(FIRST_STREAM_ID, SAMPLE_RATE_48000, true, FIRST_SAMPLE_VALUE);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(SUCCESS, playbackEngine_->AddRenderer(stream));
+    EXPECT_EQ(SUCCESS, stream->Start());
+    playbackEngine_->SetRendererRunning(stream, true);
+    EXPECT_EQ(SUCCESS, playbackEngine_->Start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(PLAYBACK_TIME_MS));
+
+    DeviceInfo deviceInfo;
+    deviceInfo.deviceType = DEVICE_TYPE_SPEAKER;
+    EXPECT_EQ(SUCCESS, playbackEngine_->Init(deviceInfo, false));
+    EXPECT_TRUE(playbackEngine_->IsPlaybackEngineRunning());
+    EXPECT_EQ(SAMPLE_RATE_48000, playbackEngine_->GetSinkStreamInfo().samplingRate);
+    std::this_thread::sleep_for(std::chrono::milliseconds(PLAYBACK_TIME_MS));
+
+    // a stopped engine stays stopped on a device change and can be started again
+    EXPECT_EQ(SUCCESS, playbackEngine_->Stop());
+    deviceInfo.deviceType = DEVICE_TYPE_USB_HEADSET;
+    EXPECT_EQ(SUCCESS, playbackEngine_->Init(deviceInfo, false));
+    EXPECT_FALSE(playbackEngine_->IsPlaybackEngineRunning());
+    EXPECT_EQ(SUCCESS, playbackEngine_->Start());
+    EXPECT_TRUE(playbackEngine_->IsPlaybackEngineRunning());
+
+    EXPECT_EQ(SUCCESS, playbackEngine_->Stop());
+    playbackEngine_->RemoveRenderer(stream);
+    EXPECT_EQ(SUCCESS, stream->Release());
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -18,8 +18,12 @@
 #include "audio_info.h"
 #include "audio_ring_cache.h"
 #include "audio_process_config.h"
+#include "format_converter.h"
 #include "linear_pos_time_model.h"
+#include "mix_tools.h"
 #include "oh_audio_buffer.h"
+#include "volume_tools.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 
 using namespace testing::ext;
@@ -132,6 +136,48 @@ HWTEST(AudioServiceCommonUnitTest, LinearPosTimeModel_002, TestSize.Level1)
     EXPECT_NE(retPos, retPosCal2);
 }
 
+/**
+* @tc.name  : Test LinearPosTimeModel API
+* @tc.type  : FUNC
+* @tc.number: LinearPosTimeModel_003
+* @tc.desc  : Test LinearPosTimeModel tracks a device clock drifting from the nominal sample rate.
+*/
+HWTEST(AudioServiceCommonUnitTest, LinearPosTimeModel_003, TestSize.Level1)
+{
+    int32_t sampleRate = static_cast<int32_t>(AudioSamplingRate::SAMPLE_RATE_48000);
+    double driftPpm = 200.0; // the device plays 200ppm faster than the nominal rate
+    double realNanoPerFrame = static_cast<double>(NANO_COUNT_PER_SECOND) / (sampleRate * (1 + driftPpm / 1000000));
+    uint64_t spanSizeInFrame = 960; // 20ms
+    int64_t startTime = 1000000000;
+    auto realTimeOf = [&](uint64_t frame) { return startTime + static_cast<int64_t>(frame * realNanoPerFrame); };
+
+    LinearPosTimeModel model;
+    EXPECT_TRUE(model.ConfigSampleRate(sampleRate));
+    model.ResetFrameStamp(0, startTime);
+    EXPECT_EQ(-1, model.GetErrorBoundNano());
+
+    uint64_t frame = 0;
+    int32_t updateCount = 1000; // 20s
+    for (int32_t i = 0; i < updateCount; i++) {
+        frame += spanSizeInFrame;
+        EXPECT_TRUE(model.UpdataFrameStamp(frame, realTimeOf(frame)));
+    }
+
+    EXPECT_NEAR(driftPpm, model.GetDriftPpm(), 10.0);
+    int64_t errorBound = model.GetErrorBoundNano();
+    EXPECT_GE(errorBound, 0);
+    EXPECT_LT(errorBound, 100000); // 100us
+
+    // the nominal rate would be 4ms late one second ahead, the tracked rate stays within 1ms
+    uint64_t farFrame = frame + static_cast<uint64_t>(sampleRate);
+    EXPECT_LT(std::abs(model.GetTimeOfPos(farFrame) - realTimeOf(farFrame)), 1000000);
+
+    // reset keeps the rate but rebuilds the confidence
+    model.ResetFrameStamp(frame, realTimeOf(frame));
+    EXPECT_EQ(-1, model.GetErrorBoundNano());
+    EXPECT_NEAR(driftPpm, model.GetDriftPpm(), 10.0);
+}
+
 /**
 * @tc.name  : Test OHAudioBuffer API
 * @tc.type  : FUNC
@@ -347,6 +393,36 @@ HWTEST(AudioServiceCommonUnitTest, OHAudioBuffer_008, TestSize.Level1)
     EXPECT_NE(nullptr, oHAudioBuffer);
 }
 
+/**
+* @tc.name  : Test OHAudioBuffer API
+* @tc.type  : FUNC
+* @tc.number: OHAudioBuffer_009
+* @tc.desc  : Test OHAudioBuffer position update request.
+*/
+HWTEST(AudioServiceCommonUnitTest, OHAudioBuffer_009, TestSize.Level1)
+{
+    uint32_t spanSizeInFrame = 960;
+    uint32_t totalSizeInFrame = spanSizeInFrame * 4;
+    uint32_t byteSizePerFrame = 4;
+    std::shared_ptr<OHAudioBuffer> buffer = OHAudioBuffer::CreateFromLocal(totalSizeInFrame, spanSizeInFrame,
+        byteSizePerFrame);
+    ASSERT_NE(nullptr, buffer);
+
+    // The server asks for the ipc notification until the stream is filled.
+    EXPECT_EQ(true, buffer->IsPositionUpdateNeeded());
+    buffer->SetPositionUpdateNeeded(false);
+    EXPECT_EQ(false, buffer->IsPositionUpdateNeeded());
+
+    // The client side shares the same flag.
+    MessageParcel parcel;
+    EXPECT_EQ(SUCCESS, OHAudioBuffer::WriteToParcel(buffer, parcel));
+    std::shared_ptr<OHAudioBuffer> clientBuffer = OHAudioBuffer::ReadFromParcel(parcel);
+    ASSERT_NE(nullptr, clientBuffer);
+    EXPECT_EQ(false, clientBuffer->IsPositionUpdateNeeded());
+    buffer->SetPositionUpdateNeeded(true);
+    EXPECT_EQ(true, clientBuffer->IsPositionUpdateNeeded());
+}
+
 /**
 * @tc.name  : Test AudioRingCache API
 * @tc.type  : FUNC
@@ -674,5 +750,560 @@ HWTEST(AudioServiceCommonUnitTest, AudioRingCache_008, TestSize.Level1)
         EXPECT_EQ(writeBuffer[index], readBuffer[index]);
     }
 }
+
+/**
+* @tc.name  : Test AudioRingCache API
+* @tc.type  : FUNC
+* @tc.number: AudioRingCache_009
+* @tc.desc  : Test spsc ring cache keeps the locked cache behavior across the end of the cache.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioRingCache_009, TestSize.Level1)
+{
+    size_t cacheSize = 480; // not a power of two
+    std::unique_ptr<AudioSpscRingCache> ringCache = AudioSpscRingCache::Create(cacheSize);
+    ASSERT_NE(ringCache, nullptr);
+    EXPECT_EQ(ringCache->GetCahceSize(), cacheSize);
+
+    size_t tempSize = 1920;
+    std::unique_ptr<uint8_t[]> writeBuffer = std::make_unique<uint8_t[]>(tempSize);
+    std::unique_ptr<uint8_t[]> readBuffer = std::make_unique<uint8_t[]>(tempSize);
+    for (size_t index = 0; index < tempSize; index++) {
+        writeBuffer[index] = index % UINT8_MAX;
+    }
+
+    size_t spanSize = 320; // 480 * 2 /3
+    for (size_t offset = 0; offset < tempSize; offset += spanSize) {
+        OptResult result = ringCache->Enqueue({writeBuffer.get() + offset, spanSize});
+        EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+        result = ringCache->GetWritableSize();
+        EXPECT_EQ(result.size, cacheSize - spanSize);
+        result = ringCache->Enqueue({writeBuffer.get(), cacheSize});
+        EXPECT_EQ(result.ret, INDEX_OUT_OF_RANGE);
+
+        result = ringCache->Dequeue({readBuffer.get() + offset, spanSize});
+        EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+        result = ringCache->Dequeue({readBuffer.get(), 1});
+        EXPECT_EQ(result.ret, INVALID_OPERATION);
+    }
+    for (size_t index = 0; index < tempSize; index++) {
+        EXPECT_EQ(writeBuffer[index], readBuffer[index]);
+    }
+}
+
+/**
+* @tc.name  : Test AudioRingCache API
+* @tc.type  : FUNC
+* @tc.number: AudioRingCache_010
+* @tc.desc  : Test spsc ring cache views, the view is split in two parts at the end of the cache.
+*/
+HWTEST(AudioServiceCommonUnitTest, AudioRingCache_010, TestSize.Level1)
+{
+    size_t cacheSize = 512;
+    std::unique_ptr<AudioSpscRingCache> ringCache = AudioSpscRingCache::Create(cacheSize);
+    ASSERT_NE(ringCache, nullptr);
+
+    size_t spanSize = 384;
+    std::vector<uint8_t> data(spanSize, 0);
+    OptResult result = ringCache->Enqueue({data.data(), spanSize});
+    EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+    result = ringCache->Dequeue({data.data(), spanSize});
+    EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+
+    RingCacheView view;
+    result = ringCache->GetWriteView(view);
+    EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+    EXPECT_EQ(result.size, cacheSize);
+    EXPECT_EQ(view.head.dataSize, cacheSize - spanSize);
+    EXPECT_EQ(view.tail.dataSize, spanSize);
+    for (size_t index = 0; index < view.head.dataSize; index++) {
+        view.head.dataPtr[index] = index % UINT8_MAX;
+    }
+    for (size_t index = 0; index < view.tail.dataSize; index++) {
+        view.tail.dataPtr[index] = (view.head.dataSize + index) % UINT8_MAX;
+    }
+    EXPECT_EQ(ringCache->CommitWrite(cacheSize + 1).ret, INDEX_OUT_OF_RANGE);
+    EXPECT_EQ(ringCache->CommitWrite(cacheSize).ret, OPERATION_SUCCESS);
+
+    std::vector<uint8_t> readBuffer(cacheSize, 0);
+    result = ringCache->Dequeue({readBuffer.data(), cacheSize});
+    EXPECT_EQ(result.ret, OPERATION_SUCCESS);
+    for (size_t index = 0; index < cacheSize; index++) {
+        EXPECT_EQ(readBuffer[index], index % UINT8_MAX);
+    }
+
+    result = ringCache->GetReadView(view);
+    EXPECT_EQ(result.size, 0);
+    EXPECT_EQ(ringCache->CommitRead(1).ret, INVALID_OPERATION);
+}
+
+/**
+* @tc.name  : Test MixTools API
+* @tc.type  : FUNC
+* @tc.number: MixTools_001
+* @tc.desc  : Test single s16 stereo stream with unity volume is copied without loss.
+*/
+HWTEST(AudioServiceCommonUnitTest, MixTools_001, TestSize.Level1)
+{
+    size_t frameCount = 241; // odd count to cover the scalar tail
+    size_t sampleCount = frameCount * STEREO;
+    std::vector<int16_t> srcBuffer(sampleCount);
+    std::vector<int16_t> dstBuffer(sampleCount);
+    for (size_t index = 0; index < sampleCount; index++) {
+        srcBuffer[index] = static_cast<int16_t>(index * 271 - 32768); // 271 for spreading the range
+    }
+    AudioStreamData srcData = {};
+    srcData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, STEREO};
+    srcData.bufferDesc = {reinterpret_cast<uint8_t *>(srcBuffer.data()), sampleCount * sizeof(int16_t),
+        sampleCount * sizeof(int16_t), nullptr, 0};
+    srcData.volumeStart = 1 << 16; // 65536 for unity
+    srcData.volumeEnd = 1 << 16;
+    AudioStreamData dstData = srcData;
+    dstData.bufferDesc.buffer = reinterpret_cast<uint8_t *>(dstBuffer.data());
+
+    MixConverters converters;
+    std::vector<float> mixBuffer(sampleCount);
+    EXPECT_EQ(SUCCESS, MixTools::Mix({srcData}, dstData, mixBuffer, converters));
+    for (size_t index = 0; index < sampleCount; index++) {
+        EXPECT_EQ(srcBuffer[index], dstBuffer[index]);
+    }
+}
+
+/**
+* @tc.name  : Test MixTools API
+* @tc.type  : FUNC
+* @tc.number: MixTools_002
+* @tc.desc  : Test mixing f32 ramp, s16 mono and s32 stereo streams into s16 stereo with saturation.
+*/
+HWTEST(AudioServiceCommonUnitTest, MixTools_002, TestSize.Level1)
+{
+    size_t frameCount = 64;
+    std::vector<float> floatBuffer(frameCount * STEREO, 0.5f);
+    std::vector<int16_t> monoBuffer(frameCount, 30000); // 30000 for overflow after mixing
+    std::vector<int32_t> s32Buffer(frameCount * STEREO, 1 << 28); // 1 << 28 for 0.125
+    std::vector<int16_t> dstBuffer(frameCount * STEREO);
+
+    AudioStreamData floatData = {};
+    floatData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_F32LE, STEREO};
+    floatData.bufferDesc = {reinterpret_cast<uint8_t *>(floatBuffer.data()), floatBuffer.size() * sizeof(float),
+        floatBuffer.size() * sizeof(float), nullptr, 0};
+    floatData.volumeStart = 0;
+    floatData.volumeEnd = 1 << 16; // 65536 for unity
+    AudioStreamData monoData = {};
+    monoData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, MONO};
+    monoData.bufferDesc = {reinterpret_cast<uint8_t *>(monoBuffer.data()), monoBuffer.size() * sizeof(int16_t),
+        monoBuffer.size() * sizeof(int16_t), nullptr, 0};
+    monoData.volumeStart = 1 << 15; // 32768 for half volume
+    monoData.volumeEnd = 1 << 15;
+    AudioStreamData s32Data = {};
+    s32Data.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S32LE, STEREO};
+    s32Data.bufferDesc = {reinterpret_cast<uint8_t *>(s32Buffer.data()), s32Buffer.size() * sizeof(int32_t),
+        s32Buffer.size() * sizeof(int32_t), nullptr, 0};
+    s32Data.volumeStart = 1 << 16;
+    s32Data.volumeEnd = 1 << 16;
+    AudioStreamData dstData = {};
+    dstData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, STEREO};
+    dstData.bufferDesc = {reinterpret_cast<uint8_t *>(dstBuffer.data()), dstBuffer.size() * sizeof(int16_t),
+        dstBuffer.size() * sizeof(int16_t), nullptr, 0};
+
+    MixConverters converters;
+    std::vector<float> mixBuffer(dstBuffer.size());
+    EXPECT_EQ(SUCCESS, MixTools::Mix({floatData, monoData, s32Data}, dstData, mixBuffer, converters));
+    // first frame: 0 + 15000 + 4096, last frame: 16384 + 15000 + 4096 saturated
+    EXPECT_NEAR(dstBuffer[0], 19096, 1);
+    EXPECT_NEAR(dstBuffer[1], 19096, 1);
+    EXPECT_EQ(dstBuffer[frameCount * STEREO - 1], INT16_MAX);
+    for (size_t index = STEREO; index < dstBuffer.size(); index++) {
+        EXPECT_GE(dstBuffer[index], dstBuffer[index - STEREO]);
+    }
+}
+
+/**
+* @tc.name  : Test MixTools API
+* @tc.type  : FUNC
+* @tc.number: MixTools_003
+* @tc.desc  : Test s24 destination and invalid params.
+*/
+HWTEST(AudioServiceCommonUnitTest, MixTools_003, TestSize.Level1)
+{
+    EXPECT_TRUE(MixTools::IsFormatSupported(SAMPLE_S24LE));
+    EXPECT_FALSE(MixTools::IsFormatSupported(SAMPLE_U8));
+    EXPECT_NE(MixTools::GetKernelName(), nullptr);
+
+    size_t frameCount = 16;
+    std::vector<int16_t> srcBuffer(frameCount * CHANNEL_6, -16384); // -16384 for -0.5
+    std::vector<uint8_t> dstBuffer(frameCount * CHANNEL_6 * 3); // 3 bytes for s24
+    AudioStreamData srcData = {};
+    srcData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, CHANNEL_6};
+    srcData.bufferDesc = {reinterpret_cast<uint8_t *>(srcBuffer.data()), srcBuffer.size() * sizeof(int16_t),
+        srcBuffer.size() * sizeof(int16_t), nullptr, 0};
+    srcData.volumeStart = 1 << 16;
+    srcData.volumeEnd = 1 << 16;
+    AudioStreamData dstData = {};
+    dstData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S24LE, CHANNEL_6};
+    dstData.bufferDesc = {dstBuffer.data(), dstBuffer.size(), dstBuffer.size(), nullptr, 0};
+
+    MixConverters converters;
+    std::vector<float> mixBuffer(srcBuffer.size());
+    EXPECT_EQ(SUCCESS, MixTools::Mix({srcData}, dstData, mixBuffer, converters));
+    EXPECT_EQ(dstBuffer[0], 0x00);
+    EXPECT_EQ(dstBuffer[1], 0x00);
+    EXPECT_EQ(dstBuffer[2], 0xc0); // 0xc00000 for -0.5 in s24
+
+    dstData.streamInfo.format = SAMPLE_U8;
+    EXPECT_EQ(ERR_INVALID_PARAM, MixTools::Mix({srcData}, dstData, mixBuffer, converters));
+
+    // the mix buffer is never resized on the mix thread
+    dstData.streamInfo.format = SAMPLE_S24LE;
+    mixBuffer.resize(srcBuffer.size() - 1);
+    EXPECT_EQ(ERR_INVALID_PARAM, MixTools::Mix({srcData}, dstData, mixBuffer, converters));
+}
+
+/**
+* @tc.name  : Test MixTools API
+* @tc.type  : FUNC
+* @tc.number: MixTools_004
+* @tc.desc  : Test a full scale 5.1 stream is down mixed to stereo without clipping, center on both sides.
+*/
+HWTEST(AudioServiceCommonUnitTest, MixTools_004, TestSize.Level1)
+{
+    size_t frameCount = 16;
+    std::vector<int16_t> surround(frameCount * CHANNEL_6, INT16_MAX);
+    for (size_t frame = frameCount / 2; frame < frameCount; frame++) {
+        // FL, FR, FC, LFE, SL, SR: center only in the second half
+        std::fill(surround.begin() + frame * CHANNEL_6, surround.begin() + (frame + 1) * CHANNEL_6, 0);
+        surround[frame * CHANNEL_6 + 2] = 16384; // 2: FC, 16384 for 0.5
+    }
+    std::vector<int16_t> dstBuffer(frameCount * STEREO);
+    AudioStreamData srcData = {};
+    srcData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, CHANNEL_6, CH_LAYOUT_5POINT1};
+    srcData.bufferDesc = {reinterpret_cast<uint8_t *>(surround.data()), surround.size() * sizeof(int16_t),
+        surround.size() * sizeof(int16_t), nullptr, 0};
+    srcData.volumeStart = 1 << 16; // 65536 for unity
+    srcData.volumeEnd = 1 << 16;
+    AudioStreamData dstData = {};
+    dstData.streamInfo = {SAMPLE_RATE_48000, ENCODING_PCM, SAMPLE_S16LE, STEREO};
+    dstData.bufferDesc = {reinterpret_cast<uint8_t *>(dstBuffer.data()), dstBuffer.size() * sizeof(int16_t),
+        dstBuffer.size() * sizeof(int16_t), nullptr, 0};
+
+    MixConverters converters;
+    std::vector<float> mixBuffer(dstBuffer.size());
+    EXPECT_EQ(SUCCESS, MixTools::Mix({srcData}, dstData, mixBuffer, converters));
+    for (size_t frame = 0; frame < frameCount / 2; frame++) {
+        EXPECT_NEAR(dstBuffer[frame * STEREO], INT16_MAX, 2); // 2: rounding of the normalized matrix
+        EXPECT_NEAR(dstBuffer[frame * STEREO + 1], INT16_MAX, 2);
+    }
+    for (size_t frame = frameCount / 2; frame < frameCount; frame++) {
+        EXPECT_GT(dstBuffer[frame * STEREO], 0);
+        EXPECT_EQ(dstBuffer[frame * STEREO], dstBuffer[frame * STEREO + 1]);
+    }
+}
+
+/**
+* @tc.name  : Test MixConverters API
+* @tc.type  : FUNC
+* @tc.number: MixTools_005
+* @tc.desc  : Test a converter is reused for the same source config and set up again for another one.
+*/
+HWTEST(AudioServiceCommonUnitTest, MixTools_005, TestSize.Level1)
+{
+    MixConverters converters;
+    FormatConvertConfig monoConfig = {SAMPLE_S16LE, SAMPLE_F32LE, MONO, STEREO, false, false};
+    FormatConvertConfig surroundConfig = {SAMPLE_S24LE, SAMPLE_F32LE, CHANNEL_6, STEREO, false, false};
+    const FormatConverter *monoConverter = converters.Get(monoConfig);
+    ASSERT_NE(monoConverter, nullptr);
+    const FormatConverter *surroundConverter = converters.Get(surroundConfig);
+    ASSERT_NE(surroundConverter, nullptr);
+    EXPECT_NE(monoConverter, surroundConverter);
+    EXPECT_EQ(converters.Get(monoConfig), monoConverter);
+    EXPECT_EQ(converters.Get(surroundConfig), surroundConverter);
+
+    surroundConfig.srcChannelLayout = CH_LAYOUT_5POINT1;
+    EXPECT_NE(converters.Get(surroundConfig), surroundConverter);
+    EXPECT_EQ(converters.Get(monoConfig), monoConverter);
+
+    FormatConvertConfig invalidConfig = {SAMPLE_S16LE, SAMPLE_F32LE, 0, STEREO, false, false};
+    EXPECT_EQ(converters.Get(invalidConfig), nullptr);
+}
+
+/**
+* @tc.name  : Test VolumeTools API
+* @tc.type  : FUNC
+* @tc.number: VolumeTools_001
+* @tc.desc  : Test constant volume on s16, s32 and f32, including the values at the limits.
+*/
+HWTEST(AudioServiceCommonUnitTest, VolumeTools_001, TestSize.Level1)
+{
+    EXPECT_NE(VolumeTools::GetKernelName(), nullptr);
+    size_t frameCount = 33; // not a multiple of any vector size
+    ChannelVolumes vols = VolumeTools::GetChannelVolumes(STEREO, 1 << 15, 1 << 15); // 1 << 15 for half volume
+
+    std::vector<int16_t> buffer16(frameCount * STEREO, INT16_MIN);
+    buffer16[1] = INT16_MAX;
+    BufferDesc desc16 = {reinterpret_cast<uint8_t *>(buffer16.data()), buffer16.size() * sizeof(int16_t),
+        buffer16.size() * sizeof(int16_t)};
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(desc16, SAMPLE_S16LE, vols));
+    EXPECT_EQ(buffer16[0], INT16_MIN / 2); // 2 for half volume
+    EXPECT_EQ(buffer16[1], INT16_MAX / 2); // 2 for half volume
+    EXPECT_EQ(buffer16.back(), INT16_MIN / 2); // 2 for half volume
+
+    std::vector<int32_t> buffer32(frameCount * STEREO, INT32_MIN);
+    buffer32[1] = -3; // -3 * 0.5 is floored to -2
+    BufferDesc desc32 = {reinterpret_cast<uint8_t *>(buffer32.data()), buffer32.size() * sizeof(int32_t),
+        buffer32.size() * sizeof(int32_t)};
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(desc32, SAMPLE_S32LE, vols));
+    EXPECT_EQ(buffer32[0], INT32_MIN / 2); // 2 for half volume
+    EXPECT_EQ(buffer32[1], -2);
+    EXPECT_EQ(buffer32.back(), INT32_MIN / 2); // 2 for half volume
+
+    std::vector<float> bufferF32(frameCount * STEREO, -0.5f);
+    BufferDesc descF32 = {reinterpret_cast<uint8_t *>(bufferF32.data()), bufferF32.size() * sizeof(float),
+        bufferF32.size() * sizeof(float)};
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(descF32, SAMPLE_F32LE, vols));
+    EXPECT_FLOAT_EQ(bufferF32[0], -0.25f);
+    EXPECT_FLOAT_EQ(bufferF32.back(), -0.25f);
+
+    desc16.bufLength -= sizeof(int16_t);
+    EXPECT_EQ(ERR_INVALID_PARAM, VolumeTools::Process(desc16, SAMPLE_S16LE, vols));
+}
+
+/**
+* @tc.name  : Test VolumeTools API
+* @tc.type  : FUNC
+* @tc.number: VolumeTools_002
+* @tc.desc  : Test volume ramp reaches the start and end volume, and s24 keeps the sign.
+*/
+HWTEST(AudioServiceCommonUnitTest, VolumeTools_002, TestSize.Level1)
+{
+    size_t frameCount = 480;
+    std::vector<int16_t> buffer16(frameCount * STEREO, 10000);
+    BufferDesc desc16 = {reinterpret_cast<uint8_t *>(buffer16.data()), buffer16.size() * sizeof(int16_t),
+        buffer16.size() * sizeof(int16_t)};
+    ChannelVolumes vols = VolumeTools::GetChannelVolumes(STEREO, 0, 1 << 16); // 1 << 16 for max volume
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(desc16, SAMPLE_S16LE, vols));
+    EXPECT_EQ(buffer16[0], 0);
+    EXPECT_EQ(buffer16[1], 0);
+    EXPECT_EQ(buffer16[buffer16.size() - STEREO], 10000);
+    EXPECT_EQ(buffer16.back(), 10000);
+    for (size_t index = STEREO; index < buffer16.size(); index++) {
+        EXPECT_GE(buffer16[index], buffer16[index - STEREO]);
+    }
+
+    // -2 in s24 at half volume is -1
+    std::vector<uint8_t> buffer24 = {0xfe, 0xff, 0xff, 0xfe, 0xff, 0xff};
+    BufferDesc desc24 = {buffer24.data(), buffer24.size(), buffer24.size()};
+    vols = VolumeTools::GetChannelVolumes(MONO, 1 << 15, 1 << 15); // 1 << 15 for half volume
+    EXPECT_EQ(SUCCESS, VolumeTools::Process(desc24, SAMPLE_S24LE, vols));
+    EXPECT_EQ(buffer24[0], 0xff);
+    EXPECT_EQ(buffer24[2], 0xff); // 2 for the sign byte
+    ChannelVolumes level = VolumeTools::CountVolumeLevel(desc24, SAMPLE_S24LE, MONO);
+    EXPECT_EQ(level.volStart[0], 1);
+}
+
+/**
+* @tc.name  : Test VolumeTools API
+* @tc.type  : FUNC
+* @tc.number: VolumeTools_003
+* @tc.desc  : Test CountVolumeLevel with preprocess counts the preprocessed data in whole frame blocks.
+*/
+HWTEST(AudioServiceCommonUnitTest, VolumeTools_003, TestSize.Level1)
+{
+    size_t frameCount = 1000; // not a multiple of the block size
+    std::vector<int16_t> buffer(frameCount * STEREO);
+    for (size_t index = 0; index < buffer.size(); index++) {
+        buffer[index] = static_cast<int16_t>((index * 7919) % 65536); // 7919 is prime, spread all values
+    }
+    std::vector<int16_t> expectBuffer = buffer;
+    for (auto &sample : expectBuffer) {
+        sample /= 2; // 2 for halving each sample
+    }
+    BufferDesc expectDesc = {reinterpret_cast<uint8_t *>(expectBuffer.data()),
+        expectBuffer.size() * sizeof(int16_t), expectBuffer.size() * sizeof(int16_t)};
+    ChannelVolumes expectLevel = VolumeTools::CountVolumeLevel(expectDesc, SAMPLE_S16LE, STEREO);
+
+    size_t preprocessedLen = 0;
+    auto preprocess = [&preprocessedLen](uint8_t *block, size_t len) {
+        EXPECT_EQ(0, len % (STEREO * sizeof(int16_t)));
+        int16_t *samples = reinterpret_cast<int16_t *>(block);
+        for (size_t index = 0; index < len / sizeof(int16_t); index++) {
+            samples[index] /= 2; // 2 for halving each sample
+        }
+        preprocessedLen += len;
+    };
+    BufferDesc desc = {reinterpret_cast<uint8_t *>(buffer.data()), buffer.size() * sizeof(int16_t),
+        buffer.size() * sizeof(int16_t)};
+    ChannelVolumes level = {};
+    EXPECT_EQ(SUCCESS, VolumeTools::CountVolumeLevel(desc, SAMPLE_S16LE, STEREO, preprocess, level));
+    EXPECT_EQ(preprocessedLen, desc.bufLength);
+    EXPECT_EQ(buffer, expectBuffer);
+    for (size_t channel = 0; channel < STEREO; channel++) {
+        EXPECT_GT(level.volStart[channel], 0);
+        EXPECT_EQ(level.volStart[channel], expectLevel.volStart[channel]);
+    }
+
+    BufferDesc oddDesc = {desc.buffer, desc.bufLength - 1, desc.bufLength - 1};
+    preprocessedLen = 0;
+    EXPECT_EQ(ERR_INVALID_PARAM, VolumeTools::CountVolumeLevel(oddDesc, SAMPLE_S16LE, STEREO, preprocess, level));
+    EXPECT_EQ(0, preprocessedLen);
+}
+
+/**
+* @tc.name  : Test FormatConverter API
+* @tc.type  : FUNC
+* @tc.number: FormatConverter_001
+* @tc.desc  : Test S16 and S24 go through float and S32 and come back unchanged, with lengths not aligned to simd.
+*/
+HWTEST(AudioServiceCommonUnitTest, FormatConverter_001, TestSize.Level1)
+{
+    size_t frameCount = 37;
+    std::vector<int16_t> s16(frameCount * STEREO);
+    for (size_t index = 0; index < s16.size(); index++) {
+        s16[index] = static_cast<int16_t>((index * 7919) % 65536); // 7919 is prime, spread all values
+    }
+    std::vector<float> f32(s16.size());
+    std::vector<int16_t> s16Back(s16.size());
+    BufferDesc s16Desc = {reinterpret_cast<uint8_t *>(s16.data()), s16.size() * sizeof(int16_t), 0};
+    BufferDesc f32Desc = {reinterpret_cast<uint8_t *>(f32.data()), f32.size() * sizeof(float), 0};
+    BufferDesc s16BackDesc = {reinterpret_cast<uint8_t *>(s16Back.data()), s16Back.size() * sizeof(int16_t), 0};
+
+    FormatConverter toFloat;
+    EXPECT_EQ(SUCCESS, toFloat.Init({SAMPLE_S16LE, SAMPLE_F32LE, STEREO, STEREO, false, false}));
+    EXPECT_EQ(SUCCESS, toFloat.Process(s16Desc, f32Desc));
+    FormatConverter fromFloat;
+    EXPECT_EQ(SUCCESS, fromFloat.Init({SAMPLE_F32LE, SAMPLE_S16LE, STEREO, STEREO, false, false}));
+    EXPECT_EQ(SUCCESS, fromFloat.Process(f32Desc, s16BackDesc));
+    EXPECT_EQ(s16, s16Back);
+
+    size_t s24Size = 3; // bytes of one s24 sample
+    std::vector<uint8_t> s24(frameCount * s24Size);
+    for (size_t index = 0; index < s24.size(); index++) {
+        s24[index] = static_cast<uint8_t>(index * 31); // 31 is prime
+    }
+    std::vector<int32_t> s32(frameCount);
+    std::vector<uint8_t> s24Back(s24.size());
+    BufferDesc s24Desc = {s24.data(), s24.size(), 0};
+    BufferDesc s32Desc = {reinterpret_cast<uint8_t *>(s32.data()), s32.size() * sizeof(int32_t), 0};
+    BufferDesc s24BackDesc = {s24Back.data(), s24Back.size(), 0};
+    FormatConverter toS32;
+    EXPECT_EQ(SUCCESS, toS32.Init({SAMPLE_S24LE, SAMPLE_S32LE, MONO, MONO, false, false}));
+    EXPECT_EQ(SUCCESS, toS32.Process(s24Desc, s32Desc));
+    for (size_t index = 0; index < frameCount; index++) {
+        uint32_t expect = (static_cast<uint32_t>(s24[index * s24Size]) << 8) | // 8: lowest byte of s24
+            (static_cast<uint32_t>(s24[index * s24Size + 1]) << 16) | // 16: middle byte of s24
+            (static_cast<uint32_t>(s24[index * s24Size + 2]) << 24); // 2, 24: highest byte of s24
+        EXPECT_EQ(static_cast<uint32_t>(s32[index]), expect);
+    }
+    FormatConverter toS24;
+    EXPECT_EQ(SUCCESS, toS24.Init({SAMPLE_S32LE, SAMPLE_S24LE, MONO, MONO, false, false}));
+    EXPECT_EQ(SUCCESS, toS24.Process(s32Desc, s24BackDesc));
+    EXPECT_EQ(s24, s24Back);
+}
+
+/**
+* @tc.name  : Test FormatConverter API
+* @tc.type  : FUNC
+* @tc.number: FormatConverter_002
+* @tc.desc  : Test channel mapping and planar layout.
+*/
+HWTEST(AudioServiceCommonUnitTest, FormatConverter_002, TestSize.Level1)
+{
+    size_t frameCount = 100; // more than one block of frames
+    std::vector<int16_t> stereo(frameCount * STEREO);
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        stereo[frame * STEREO] = static_cast<int16_t>(frame * 2); // 2: left is twice the frame index
+        stereo[frame * STEREO + 1] = static_cast<int16_t>(frame * 4); // 4: right is four times the frame index
+    }
+    BufferDesc stereoDesc = {reinterpret_cast<uint8_t *>(stereo.data()), stereo.size() * sizeof(int16_t), 0};
+
+    std::vector<int16_t> mono(frameCount);
+    BufferDesc monoDesc = {reinterpret_cast<uint8_t *>(mono.data()), mono.size() * sizeof(int16_t), 0};
+    FormatConverter downMix;
+    EXPECT_EQ(SUCCESS, downMix.Init({SAMPLE_S16LE, SAMPLE_S16LE, STEREO, MONO, false, false}));
+    EXPECT_EQ(SUCCESS, downMix.Process(stereoDesc, monoDesc));
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        EXPECT_EQ(mono[frame], static_cast<int16_t>(frame * 3)); // 3: the average of left and right
+    }
+
+    std::vector<float> quad(frameCount * CHANNEL_4);
+    BufferDesc quadDesc = {reinterpret_cast<uint8_t *>(quad.data()), quad.size() * sizeof(float), 0};
+    FormatConverter upMix;
+    EXPECT_EQ(SUCCESS, upMix.Init({SAMPLE_S16LE, SAMPLE_F32LE, MONO, CHANNEL_4, false, false}));
+    EXPECT_EQ(SUCCESS, upMix.Process(monoDesc, quadDesc));
+    for (size_t index = 0; index < quad.size(); index++) {
+        EXPECT_FLOAT_EQ(quad[index], mono[index / CHANNEL_4] / 32768.0f); // 32768: 1 << 15
+    }
+
+    std::vector<int16_t> planar(stereo.size());
+    BufferDesc planarDesc = {reinterpret_cast<uint8_t *>(planar.data()), planar.size() * sizeof(int16_t), 0};
+    FormatConverter deinterleave;
+    EXPECT_EQ(SUCCESS, deinterleave.Init({SAMPLE_S16LE, SAMPLE_S16LE, STEREO, STEREO, false, true}));
+    EXPECT_EQ(SUCCESS, deinterleave.Process(stereoDesc, planarDesc));
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        EXPECT_EQ(planar[frame], stereo[frame * STEREO]);
+        EXPECT_EQ(planar[frameCount + frame], stereo[frame * STEREO + 1]);
+    }
+
+    BufferDesc shortDesc = {monoDesc.buffer, monoDesc.bufLength - 1, 0};
+    EXPECT_EQ(ERR_INVALID_PARAM, deinterleave.Process(stereoDesc, shortDesc));
+}
+
+/**
+* @tc.name  : Test FormatConverter API
+* @tc.type  : FUNC
+* @tc.number: FormatConverter_003
+* @tc.desc  : Test the gain is applied in the conversion and integer samples are clamped.
+*/
+HWTEST(AudioServiceCommonUnitTest, FormatConverter_003, TestSize.Level1)
+{
+    std::vector<float> f32 = {0.75f, -0.75f, 0.25f, -0.25f, 0.0f, 0.5f, -0.5f, 0.125f, 0.75f};
+    std::vector<int16_t> s16(f32.size());
+    BufferDesc f32Desc = {reinterpret_cast<uint8_t *>(f32.data()), f32.size() * sizeof(float), 0};
+    BufferDesc s16Desc = {reinterpret_cast<uint8_t *>(s16.data()), s16.size() * sizeof(int16_t), 0};
+    FormatConverter converter;
+    EXPECT_EQ(ERR_ILLEGAL_STATE, converter.Process(f32Desc, s16Desc));
+    EXPECT_EQ(ERR_NOT_SUPPORTED, converter.Init({INVALID_WIDTH, SAMPLE_S16LE, MONO, MONO, false, false}));
+    EXPECT_EQ(SUCCESS, converter.Init({SAMPLE_F32LE, SAMPLE_S16LE, MONO, MONO, false, false}));
+    float gain = 2.0f;
+    EXPECT_EQ(SUCCESS, converter.Process(f32Desc, s16Desc, gain));
+    for (size_t index = 0; index < f32.size(); index++) {
+        float expect = std::clamp(f32[index] * gain * 32768.0f, -32768.0f, 32767.0f); // 32768: 1 << 15
+        EXPECT_EQ(s16[index], static_cast<int16_t>(expect));
+    }
+    EXPECT_NE(nullptr, FormatConverter::GetKernelName());
+}
+
+/**
+* @tc.name  : Test FormatConverter API
+* @tc.type  : FUNC
+* @tc.number: FormatConverter_004
+* @tc.desc  : Test 5.1 is down mixed to stereo by speaker position and does not clip.
+*/
+HWTEST(AudioServiceCommonUnitTest, FormatConverter_004, TestSize.Level1)
+{
+    // FL, FR, FC, LFE, SL, SR of CH_LAYOUT_5POINT1
+    std::vector<float> surround = {
+        0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, // center only
+        0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, // lfe only
+        0.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.0f, // side left only
+        1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, // all channels at full scale
+    };
+    size_t frameCount = surround.size() / CHANNEL_6;
+    std::vector<float> stereo(frameCount * STEREO);
+    BufferDesc surroundDesc = {reinterpret_cast<uint8_t *>(surround.data()), surround.size() * sizeof(float), 0};
+    BufferDesc stereoDesc = {reinterpret_cast<uint8_t *>(stereo.data()), stereo.size() * sizeof(float), 0};
+    FormatConverter downMix;
+    FormatConvertConfig config = {SAMPLE_F32LE, SAMPLE_F32LE, CHANNEL_6, STEREO, false, false};
+    config.srcChannelLayout = CH_LAYOUT_5POINT1;
+    EXPECT_EQ(SUCCESS, downMix.Init(config));
+    EXPECT_EQ(SUCCESS, downMix.Process(surroundDesc, stereoDesc));
+
+    EXPECT_GT(stereo[0], 0.0f);
+    EXPECT_FLOAT_EQ(stereo[0], stereo[1]);
+    EXPECT_FLOAT_EQ(stereo[2], 0.0f); // 2: left of the lfe frame
+    EXPECT_FLOAT_EQ(stereo[3], 0.0f); // 3: right of the lfe frame
+    EXPECT_GT(stereo[4], 0.0f); // 4: left of the side left frame
+    EXPECT_FLOAT_EQ(stereo[5], 0.0f); // 5: right of the side left frame
+    EXPECT_NEAR(stereo[6], 1.0f, 1e-6f); // 6: left of the full scale frame
+    EXPECT_NEAR(stereo[7], 1.0f, 1e-6f); // 7: right of the full scale frame
+}
 } // namespace AudioStandard
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "callback_handler.h"
+#include "event_handler.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const uint32_t EVENT_COUNT = 20;
+const int32_t WAIT_TIMEOUT_MS = 2000;
+
+class TestHandler : public IHandler {
+public:
+    void OnHandle(uint32_t code, int64_t data) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        codes_.push_back(code);
+        threadIds_.push_back(std::this_thread::get_id());
+        cv_.notify_all();
+    }
+
+    bool WaitForEvents(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS),
+            [this, count] { return codes_.size() >= count; });
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<uint32_t> codes_;
+    std::vector<std::thread::id> threadIds_;
+};
+
+std::shared_ptr<AppExecFwk::EventRunner> GetRunner(const std::shared_ptr<CallbackHandler> &callbackHandler)
+{
+    std::shared_ptr<AppExecFwk::EventHandler> eventHandler =
+        std::dynamic_pointer_cast<AppExecFwk::EventHandler>(callbackHandler);
+    return eventHandler == nullptr ? nullptr : eventHandler->GetEventRunner();
+}
+} // namespace
+
+class CallbackHandlerUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void CallbackHandlerUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void CallbackHandlerUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void CallbackHandlerUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void CallbackHandlerUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test CallbackHandler GetInstance
+ * @tc.number: CallbackHandler_001
+ * @tc.desc  : Test two handlers share one runner thread and each handles its own events in order.
+ */
+HWTEST_F(CallbackHandlerUnitTest, CallbackHandler_001, TestSize.Level1)
+{
+    std::shared_ptr<TestHandler> first = std::make_shared<TestHandler>();
+    std::shared_ptr<TestHandler> second = std::make_shared<TestHandler>();
+    std::shared_ptr<CallbackHandler> firstHandler = CallbackHandler::GetInstance(first);
+    std::shared_ptr<CallbackHandler> secondHandler = CallbackHandler::GetInstance(second);
+    ASSERT_NE(nullptr, firstHandler);
+    ASSERT_NE(nullptr, secondHandler);
+    ASSERT_NE(nullptr, GetRunner(firstHandler));
+    EXPECT_EQ(GetRunner(firstHandler), GetRunner(secondHandler));
+
+    for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+        firstHandler->SendCallbackEvent(i, 0);
+        secondHandler->SendCallbackEvent(EVENT_COUNT - i, 0);
+    }
+    ASSERT_TRUE(first->WaitForEvents(EVENT_COUNT));
+    ASSERT_TRUE(second->WaitForEvents(EVENT_COUNT));
+
+    std::lock_guard<std::mutex> firstLock(first->mutex_);
+    std::lock_guard<std::mutex> secondLock(second->mutex_);
+    for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+        EXPECT_EQ(i, first->codes_[i]);
+        EXPECT_EQ(EVENT_COUNT - i, second->codes_[i]);
+        EXPECT_EQ(first->threadIds_[0], first->threadIds_[i]);
+        EXPECT_EQ(first->threadIds_[0], second->threadIds_[i]);
+    }
+    firstHandler->ReleaseEventRunner();
+    secondHandler->ReleaseEventRunner();
+}
+
+/**
+ * @tc.name  : Test CallbackHandler GetInstance
+ * @tc.number: CallbackHandler_002
+ * @tc.desc  : Test an independent handler gets its own runner thread, and a released handler leaves the
+ *             shared runner to the others.
+ */
+HWTEST_F(CallbackHandlerUnitTest, CallbackHandler_002, TestSize.Level1)
+{
+    std::shared_ptr<TestHandler> shared = std::make_shared<TestHandler>();
+    std::shared_ptr<TestHandler> independent = std::make_shared<TestHandler>();
+    std::shared_ptr<TestHandler> released = std::make_shared<TestHandler>();
+    std::shared_ptr<CallbackHandler> sharedHandler = CallbackHandler::GetInstance(shared);
+    std::shared_ptr<CallbackHandler> independentHandler = CallbackHandler::GetInstance(independent, true);
+    std::shared_ptr<CallbackHandler> releasedHandler = CallbackHandler::GetInstance(released);
+    ASSERT_NE(nullptr, GetRunner(independentHandler));
+    EXPECT_NE(GetRunner(sharedHandler), GetRunner(independentHandler));
+    EXPECT_EQ(GetRunner(sharedHandler), GetRunner(releasedHandler));
+
+    releasedHandler->ReleaseEventRunner();
+    EXPECT_EQ(nullptr, GetRunner(releasedHandler));
+    EXPECT_NE(nullptr, GetRunner(sharedHandler));
+
+    sharedHandler->SendCallbackEvent(1, 0);
+    independentHandler->SendCallbackEvent(1, 0);
+    ASSERT_TRUE(shared->WaitForEvents(1));
+    ASSERT_TRUE(independent->WaitForEvents(1));
+    std::lock_guard<std::mutex> sharedLock(shared->mutex_);
+    std::lock_guard<std::mutex> independentLock(independent->mutex_);
+    EXPECT_NE(shared->threadIds_[0], independent->threadIds_[0]);
+    sharedHandler->ReleaseEventRunner();
+    independentHandler->ReleaseEventRunner();
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "capture_fan_out_bus.h"
+#include "audio_errors.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const size_t TEST_SPAN_SIZE = 64;
+const int32_t TEST_APP_UID = 20010001;
+const uint32_t TEST_APP_TOKEN_ID = 537000001;
+}
+
+class TestCaptureSubscriber : public ICaptureSubscriber {
+public:
+    void OnCaptureSpan(const BufferDesc &span) override
+    {
+        spans_.emplace_back(span.buffer, span.buffer + span.bufLength);
+    }
+
+    bool IsCaptureMuted() override
+    {
+        return isMuted_;
+    }
+
+    std::vector<std::vector<uint8_t>> spans_;
+    bool isMuted_ = false;
+};
+
+class CaptureFanOutBusUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+protected:
+    CaptureFanOutKey key_ = {SOURCE_TYPE_MIC, SAMPLE_RATE_48000, SAMPLE_S16LE, STEREO, TEST_SPAN_SIZE, TEST_APP_UID,
+        TEST_APP_TOKEN_ID};
+};
+
+void CaptureFanOutBusUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void CaptureFanOutBusUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void CaptureFanOutBusUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void CaptureFanOutBusUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test CaptureFanOutBus Publish
+ * @tc.number: CaptureFanOutBus_001
+ * @tc.desc  : Test the first subscriber publishes spans to every subscriber, data of the others is dropped.
+ */
+HWTEST_F(CaptureFanOutBusUnitTest, CaptureFanOutBus_001, TestSize.Level1)
+{
+    auto publisher = std::make_shared<TestCaptureSubscriber>();
+    auto follower = std::make_shared<TestCaptureSubscriber>();
+    CaptureFanOutBus &bus = CaptureFanOutBus::GetInstance();
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, publisher));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, follower));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, follower));
+    EXPECT_EQ(2, bus.GetSubscriberCount(key_));
+
+    // one and a half span, then the other half, chunks of the sound server are not span aligned
+    std::vector<uint8_t> data(TEST_SPAN_SIZE * 2);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    size_t firstSize = TEST_SPAN_SIZE + TEST_SPAN_SIZE / 2;
+    EXPECT_FALSE(bus.Publish(key_, follower.get(), {data.data(), data.size(), data.size()}));
+    EXPECT_TRUE(bus.Publish(key_, publisher.get(), {data.data(), firstSize, firstSize}));
+    EXPECT_EQ(1, publisher->spans_.size());
+    EXPECT_EQ(1, follower->spans_.size());
+    EXPECT_TRUE(bus.Publish(key_, publisher.get(), {data.data() + firstSize, data.size() - firstSize,
+        data.size() - firstSize}));
+    ASSERT_EQ(2, follower->spans_.size());
+    EXPECT_EQ(publisher->spans_, follower->spans_);
+    EXPECT_TRUE(std::equal(data.begin() + TEST_SPAN_SIZE, data.end(), follower->spans_[1].begin()));
+
+    bus.Unsubscribe(key_, publisher.get());
+    bus.Unsubscribe(key_, follower.get());
+    EXPECT_EQ(0, bus.GetSubscriberCount(key_));
+}
+
+/**
+ * @tc.name  : Test CaptureFanOutBus Unsubscribe
+ * @tc.number: CaptureFanOutBus_002
+ * @tc.desc  : Test the next subscriber takes over when the publisher leaves, and keys are not mixed.
+ */
+HWTEST_F(CaptureFanOutBusUnitTest, CaptureFanOutBus_002, TestSize.Level1)
+{
+    auto publisher = std::make_shared<TestCaptureSubscriber>();
+    auto follower = std::make_shared<TestCaptureSubscriber>();
+    auto other = std::make_shared<TestCaptureSubscriber>();
+    CaptureFanOutKey otherKey = key_;
+    otherKey.samplingRate = SAMPLE_RATE_16000;
+    CaptureFanOutBus &bus = CaptureFanOutBus::GetInstance();
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, publisher));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, follower));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(otherKey, other));
+
+    std::vector<uint8_t> data(TEST_SPAN_SIZE, 1);
+    bus.Unsubscribe(key_, publisher.get());
+    EXPECT_TRUE(bus.Publish(key_, follower.get(), {data.data(), data.size(), data.size()}));
+    EXPECT_EQ(0, publisher->spans_.size());
+    EXPECT_EQ(1, follower->spans_.size());
+    EXPECT_EQ(0, other->spans_.size());
+
+    EXPECT_EQ(1, bus.GetSubscriberCount(key_));
+    bus.Unsubscribe(key_, follower.get());
+    bus.Unsubscribe(otherKey, other.get());
+    EXPECT_EQ(0, bus.GetSubscriberCount(otherKey));
+
+    CaptureFanOutKey innerCapKey = key_;
+    innerCapKey.sourceType = SOURCE_TYPE_PLAYBACK_CAPTURE;
+    EXPECT_EQ(ERR_INVALID_PARAM, bus.Subscribe(innerCapKey, other));
+}
+
+/**
+ * @tc.name  : Test CaptureFanOutBus mute
+ * @tc.number: CaptureFanOutBus_003
+ * @tc.desc  : Test a muted follower gets silence while the publisher keeps its data, and the reverse.
+ */
+HWTEST_F(CaptureFanOutBusUnitTest, CaptureFanOutBus_003, TestSize.Level1)
+{
+    auto publisher = std::make_shared<TestCaptureSubscriber>();
+    auto follower = std::make_shared<TestCaptureSubscriber>();
+    CaptureFanOutBus &bus = CaptureFanOutBus::GetInstance();
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, publisher));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, follower));
+
+    std::vector<uint8_t> data(TEST_SPAN_SIZE, 1);
+    std::vector<uint8_t> silence(TEST_SPAN_SIZE, 0);
+    follower->isMuted_ = true;
+    EXPECT_TRUE(bus.Publish(key_, publisher.get(), {data.data(), data.size(), data.size()}));
+    ASSERT_EQ(1, publisher->spans_.size());
+    ASSERT_EQ(1, follower->spans_.size());
+    EXPECT_EQ(data, publisher->spans_[0]);
+    EXPECT_EQ(silence, follower->spans_[0]);
+
+    follower->isMuted_ = false;
+    publisher->isMuted_ = true;
+    EXPECT_TRUE(bus.Publish(key_, publisher.get(), {data.data(), data.size(), data.size()}));
+    ASSERT_EQ(2, follower->spans_.size());
+    EXPECT_EQ(silence, publisher->spans_[1]);
+    EXPECT_EQ(data, follower->spans_[1]);
+
+    bus.Unsubscribe(key_, publisher.get());
+    bus.Unsubscribe(key_, follower.get());
+}
+
+/**
+ * @tc.name  : Test CaptureFanOutBus app isolation
+ * @tc.number: CaptureFanOutBus_004
+ * @tc.desc  : Test streams of another app never get the data of the publisher.
+ */
+HWTEST_F(CaptureFanOutBusUnitTest, CaptureFanOutBus_004, TestSize.Level1)
+{
+    auto publisher = std::make_shared<TestCaptureSubscriber>();
+    auto otherApp = std::make_shared<TestCaptureSubscriber>();
+    auto otherToken = std::make_shared<TestCaptureSubscriber>();
+    CaptureFanOutKey otherAppKey = key_;
+    otherAppKey.appUid = TEST_APP_UID + 1;
+    CaptureFanOutKey otherTokenKey = key_;
+    otherTokenKey.appTokenId = TEST_APP_TOKEN_ID + 1;
+    CaptureFanOutBus &bus = CaptureFanOutBus::GetInstance();
+    EXPECT_EQ(SUCCESS, bus.Subscribe(key_, publisher));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(otherAppKey, otherApp));
+    EXPECT_EQ(SUCCESS, bus.Subscribe(otherTokenKey, otherToken));
+    EXPECT_EQ(1, bus.GetSubscriberCount(key_));
+
+    std::vector<uint8_t> data(TEST_SPAN_SIZE, 1);
+    EXPECT_TRUE(bus.Publish(key_, publisher.get(), {data.data(), data.size(), data.size()}));
+    EXPECT_EQ(1, publisher->spans_.size());
+    EXPECT_EQ(0, otherApp->spans_.size());
+    EXPECT_EQ(0, otherToken->spans_.size());
+
+    bus.Unsubscribe(key_, publisher.get());
+    bus.Unsubscribe(otherAppKey, otherApp.get());
+    bus.Unsubscribe(otherTokenKey, otherToken.get());
+}
+} // namespace AudioStandard
+} // namespace OHOS
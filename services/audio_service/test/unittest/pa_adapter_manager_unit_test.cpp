@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include "pa_adapter_manager.h"
+#include "audio_errors.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const uint32_t FIRST_SESSION_ID = MIN_SESSIONID + 1000;
+const uint32_t SECOND_SESSION_ID = MIN_SESSIONID + 1001;
+const int32_t REFILL_WAIT_MS = 3000;
+const int32_t REFILL_POLL_MS = 20;
+
+AudioProcessConfig GetPoolableConfig(uint32_t sessionId)
+{
+    AudioProcessConfig config;
+    config.audioMode = AUDIO_MODE_PLAYBACK;
+    config.originalSessionId = sessionId;
+    config.streamType = STREAM_NOTIFICATION;
+    config.rendererInfo.streamUsage = STREAM_USAGE_NOTIFICATION;
+    config.streamInfo.samplingRate = SAMPLE_RATE_48000;
+    config.streamInfo.format = SAMPLE_S16LE;
+    config.streamInfo.channels = STEREO;
+    config.streamInfo.channelLayout = CH_LAYOUT_STEREO;
+    return config;
+}
+
+bool WaitDump(PaAdapterManager &manager, const std::string &expected)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(REFILL_WAIT_MS)) {
+        std::string dumpString;
+        manager.DumpStreamPool(dumpString);
+        if (dumpString.find(expected) != std::string::npos) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(REFILL_POLL_MS));
+    }
+    return false;
+}
+} // namespace
+
+class PaAdapterManagerUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void PaAdapterManagerUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void PaAdapterManagerUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void PaAdapterManagerUnitTest::SetUp(void)
+{
+    // input testcase setup step，setup invoked before each testcases
+}
+
+void PaAdapterManagerUnitTest::TearDown(void)
+{
+    // input testcase teardown step，teardown invoked after each testcases
+}
+
+/**
+ * @tc.name  : Test PaAdapterManager stream pool
+ * @tc.number: PaAdapterManager_StreamPool_001
+ * @tc.desc  : Test the first short sound misses and refills the pool, the next one takes and re-tags a pooled
+ *             stream. A failed re-tag counts as a miss, so the hit count shows the re-tag succeeded.
+ */
+HWTEST_F(PaAdapterManagerUnitTest, PaAdapterManager_StreamPool_001, TestSize.Level1)
+{
+    auto manager = std::make_unique<PaAdapterManager>(PLAYBACK);
+    std::shared_ptr<IRendererStream> firstStream = nullptr;
+    ASSERT_EQ(SUCCESS, manager->CreateRender(GetPoolableConfig(FIRST_SESSION_ID), firstStream));
+    ASSERT_NE(nullptr, firstStream);
+    EXPECT_TRUE(WaitDump(*manager, "hit count 0, miss count 1"));
+    EXPECT_TRUE(WaitDump(*manager, "2 pooled"));
+
+    std::shared_ptr<IRendererStream> secondStream = nullptr;
+    ASSERT_EQ(SUCCESS, manager->CreateRender(GetPoolableConfig(SECOND_SESSION_ID), secondStream));
+    ASSERT_NE(nullptr, secondStream);
+    EXPECT_EQ(SECOND_SESSION_ID, secondStream->GetStreamIndex());
+    EXPECT_TRUE(WaitDump(*manager, "hit count 1, miss count 1"));
+    // the taken stream is replaced in the background
+    EXPECT_TRUE(WaitDump(*manager, "2 pooled"));
+
+    EXPECT_EQ(SUCCESS, manager->StartRender(SECOND_SESSION_ID));
+    EXPECT_EQ(SUCCESS, manager->StopRender(SECOND_SESSION_ID));
+    EXPECT_EQ(SUCCESS, manager->ReleaseRender(SECOND_SESSION_ID));
+    EXPECT_EQ(SUCCESS, manager->ReleaseRender(FIRST_SESSION_ID));
+}
+
+/**
+ * @tc.name  : Test PaAdapterManager stream pool
+ * @tc.number: PaAdapterManager_StreamPool_002
+ * @tc.desc  : Test other usages and layouts never touch the pool.
+ */
+HWTEST_F(PaAdapterManagerUnitTest, PaAdapterManager_StreamPool_002, TestSize.Level1)
+{
+    auto manager = std::make_unique<PaAdapterManager>(PLAYBACK);
+    AudioProcessConfig musicConfig = GetPoolableConfig(FIRST_SESSION_ID);
+    musicConfig.streamType = STREAM_MUSIC;
+    musicConfig.rendererInfo.streamUsage = STREAM_USAGE_MUSIC;
+    std::shared_ptr<IRendererStream> stream = nullptr;
+    ASSERT_EQ(SUCCESS, manager->CreateRender(musicConfig, stream));
+    EXPECT_EQ(SUCCESS, manager->ReleaseRender(FIRST_SESSION_ID));
+
+    AudioProcessConfig layoutConfig = GetPoolableConfig(SECOND_SESSION_ID);
+    layoutConfig.streamInfo.channelLayout = CH_LAYOUT_MONO;
+    ASSERT_EQ(SUCCESS, manager->CreateRender(layoutConfig, stream));
+    EXPECT_EQ(SUCCESS, manager->ReleaseRender(SECOND_SESSION_ID));
+
+    std::string dumpString;
+    manager->DumpStreamPool(dumpString);
+    EXPECT_NE(std::string::npos, dumpString.find("hit count 0, miss count 0"));
+    EXPECT_EQ(std::string::npos, dumpString.find("pooled"));
+}
+
+/**
+ * @tc.name  : Test PaAdapterManager stream pool
+ * @tc.number: PaAdapterManager_StreamPool_003
+ * @tc.desc  : Test the manager can be destroyed while a refill is running, the refill thread is joined.
+ */
+HWTEST_F(PaAdapterManagerUnitTest, PaAdapterManager_StreamPool_003, TestSize.Level1)
+{
+    auto manager = std::make_unique<PaAdapterManager>(PLAYBACK);
+    std::shared_ptr<IRendererStream> stream = nullptr;
+    ASSERT_EQ(SUCCESS, manager->CreateRender(GetPoolableConfig(FIRST_SESSION_ID), stream));
+    EXPECT_EQ(SUCCESS, manager->ReleaseRender(FIRST_SESSION_ID));
+    stream = nullptr;
+    manager = nullptr;
+    EXPECT_EQ(nullptr, manager);
+}
+} // namespace AudioStandard
+} // namespace OHOS
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include "pa_adapter_tools.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace AudioStandard {
+namespace {
+const int64_t FAST_WAIT_NS = 1000;
+const int64_t FAST_HOLD_NS = 2000;
+const int32_t GUARD_LOCK_TIMES = 3;
+} // namespace
+
+class PaAdapterToolsUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+
+protected:
+    pa_threaded_mainloop *mainloop_ = nullptr;
+};
+
+void PaAdapterToolsUnitTest::SetUpTestCase(void)
+{
+    // input testsuit setup step，setup invoked before all testcases
+}
+
+void PaAdapterToolsUnitTest::TearDownTestCase(void)
+{
+    // input testsuit teardown step，teardown invoked after all testcases
+}
+
+void PaAdapterToolsUnitTest::SetUp(void)
+{
+    mainloop_ = pa_threaded_mainloop_new();
+}
+
+void PaAdapterToolsUnitTest::TearDown(void)
+{
+    PaLockMetrics::Unregister(mainloop_);
+    PaLockMetrics::SetEnabled(false);
+    pa_threaded_mainloop_free(mainloop_);
+    mainloop_ = nullptr;
+}
+
+/**
+ * @tc.name  : Test PaLockMetrics Register
+ * @tc.number: PaLockMetrics_001
+ * @tc.desc  : Test a registered mainloop is found with its name, a long name is cut, and unregister frees the slot.
+ */
+HWTEST_F(PaAdapterToolsUnitTest, PaLockMetrics_001, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, mainloop_);
+    EXPECT_EQ(nullptr, PaLockMetrics::Find(mainloop_));
+    EXPECT_EQ(nullptr, PaLockMetrics::Find(nullptr));
+
+    std::string longName(PA_LOCK_STATS_NAME_LEN * 2, 'a');
+    PaLockMetrics::Register(mainloop_, longName.c_str());
+    PaLockStats *stats = PaLockMetrics::Find(mainloop_);
+    ASSERT_NE(nullptr, stats);
+    EXPECT_EQ(longName.substr(0, PA_LOCK_STATS_NAME_LEN - 1), std::string(stats->name));
+    EXPECT_EQ(0, stats->lockCount.load());
+
+    PaLockMetrics::Unregister(mainloop_);
+    EXPECT_EQ(nullptr, PaLockMetrics::Find(mainloop_));
+    EXPECT_FALSE(stats->isUsed.load());
+}
+
+/**
+ * @tc.name  : Test PaLockMetrics Record
+ * @tc.number: PaLockMetrics_002
+ * @tc.desc  : Test the counts, totals and maximums, and that only waits over the threshold are slow.
+ */
+HWTEST_F(PaAdapterToolsUnitTest, PaLockMetrics_002, TestSize.Level1)
+{
+    PaLockMetrics::Register(mainloop_, "TestLoop");
+    PaLockStats *stats = PaLockMetrics::Find(mainloop_);
+    ASSERT_NE(nullptr, stats);
+
+    PaLockMetrics::Record(*stats, FAST_WAIT_NS, FAST_HOLD_NS);
+    PaLockMetrics::Record(*stats, PA_LOCK_SLOW_WAIT_NS + 1, FAST_HOLD_NS / 2);
+    EXPECT_EQ(2, stats->lockCount.load());
+    EXPECT_EQ(1, stats->slowWaitCount.load());
+    EXPECT_EQ(FAST_WAIT_NS + PA_LOCK_SLOW_WAIT_NS + 1, stats->totalWaitNs.load());
+    EXPECT_EQ(PA_LOCK_SLOW_WAIT_NS + 1, stats->maxWaitNs.load());
+    EXPECT_EQ(FAST_HOLD_NS + FAST_HOLD_NS / 2, stats->totalHoldNs.load());
+    EXPECT_EQ(FAST_HOLD_NS, stats->maxHoldNs.load());
+
+    // a slot taken again starts from zero
+    PaLockMetrics::Unregister(mainloop_);
+    PaLockMetrics::Register(mainloop_, "TestLoop");
+    stats = PaLockMetrics::Find(mainloop_);
+    ASSERT_NE(nullptr, stats);
+    EXPECT_EQ(0, stats->lockCount.load());
+    EXPECT_EQ(0, stats->maxWaitNs.load());
+}
+
+/**
+ * @tc.name  : Test PaLockGuard
+ * @tc.number: PaLockGuard_001
+ * @tc.desc  : Test the guard records a lock only while the metrics are enabled, and unlocks once.
+ */
+HWTEST_F(PaAdapterToolsUnitTest, PaLockGuard_001, TestSize.Level1)
+{
+    PaLockMetrics::Register(mainloop_, "TestLoop");
+    PaLockStats *stats = PaLockMetrics::Find(mainloop_);
+    ASSERT_NE(nullptr, stats);
+
+    PaLockMetrics::SetEnabled(false);
+    {
+        PaLockGuard lock(mainloop_);
+    }
+    EXPECT_EQ(0, stats->lockCount.load());
+
+    PaLockMetrics::SetEnabled(true);
+    EXPECT_TRUE(PaLockMetrics::IsEnabled());
+    for (int32_t i = 0; i < GUARD_LOCK_TIMES; i++) {
+        PaLockGuard lock(mainloop_);
+        lock.Unlock();
+        lock.Unlock();
+    }
+    EXPECT_EQ(GUARD_LOCK_TIMES, stats->lockCount.load());
+    EXPECT_GE(stats->totalHoldNs.load(), 0);
+}
+} // namespace AudioStandard
+} // namespace OHOS